@@ -57,10 +57,10 @@ INTERNAL void zint_test_az_set_fail(const int id, const int at) {
 }
 
 /* TODO: put these in "aztec.h" (& rename existing "aztec.h" to "aztec_tabs.h" */
-#define AZ_FAIL_ID_LIST_INIT    1
-#define AZ_FAIL_ID_CPY          2
-#define AZ_FAIL_ID_ADD_CHK      3
-#define AZ_FAIL_ID_LIST_ADD_CHK 4
+#define AZ_FAIL_ID_LIST_INIT     1
+#define AZ_FAIL_ID_ARENA_INIT    2
+#define AZ_FAIL_ID_ARENA_ADD_CHK 3
+#define AZ_FAIL_ID_LIST_ADD_CHK  4
 
 #define az_malloc(id, sz)       (az_fail_at > 0 && az_fail_id == (id) && --az_fail_at == 0 ? NULL : malloc(sz))
 #define az_realloc(id, ptr, sz) (az_fail_at > 0 && az_fail_id == (id) && --az_fail_at == 0 ? NULL : realloc(ptr, sz))
@@ -445,21 +445,25 @@ static int az_count_initial_puncts(const unsigned char source[], const int lengt
 
 /* Optimized encoding stuff - see `az_binary_string()` */
 
+/* Tokens are kept in an arena shared by all states, each token linking back to the previous token output by its
+   state, so that states sharing a prefix share its tokens and copying a state is just a struct copy */
 struct az_token {
     short value;
     short count; /* If negative, bit count of simple (not binary shift) token, else byte count */
+    int previous; /* Index into arena of previous token, 0 if none */
 };
 
-struct az_token_list {
-    struct az_token *tokens;
-    unsigned short used;
-    unsigned short size; /* Capacity */
+struct az_token_arena {
+    struct az_token *tokens; /* 1st entry not used so that index 0 can mean none */
+    int used;
+    int size; /* Capacity */
 };
 
 /* Represents all information about a sequence necessary to generate the current output */
 struct az_state {
-    /* The list of tokens output. If in B/S mode, this does *not* yet include the token for those bytes */
-    struct az_token_list tokens;
+    /* Index into arena of last token output, 0 if none. If in B/S mode, this does *not* yet include the token for
+       those bytes */
+    int tokens;
     short mode; /* The current mode of the encoding, or the mode to return to if in B/S mode */
     short byteCount; /* If non-zero, the number of most recent bytes that should be output in B/S mode */
     unsigned short bitCount; /* The total number of bits generated (including B/S) */
@@ -469,15 +473,18 @@ struct az_state_list {
     struct az_state* states;
     unsigned short used;
     unsigned short size;
+    struct az_token_arena *arena;
 };
 
 #define AZ_MIN_STATES_SIZE 4
 #define AZ_MIN_TOKENS_SIZE 32
 
 /* Initialize a state list */
-static int az_state_list_init(struct az_state_list *list, const unsigned short initial_size) {
+static int az_state_list_init(struct az_state_list *list, const unsigned short initial_size,
+            struct az_token_arena *arena) {
     const unsigned short size = initial_size < AZ_MIN_STATES_SIZE ? AZ_MIN_STATES_SIZE : initial_size;
 
+    list->arena = arena;
     if (!(list->states = (struct az_state *) az_malloc(AZ_FAIL_ID_LIST_INIT, sizeof(struct az_state) * size))) {
         list->used = list->size = 0;
         return 0;
@@ -487,44 +494,43 @@ static int az_state_list_init(struct az_state_list *list, const unsigned short i
     return 1;
 }
 
-/* Copy a state `src` to `dst` */
-static int az_state_cpy(const struct az_state *src, struct az_state *dst) {
-    const unsigned short size = src->tokens.size < AZ_MIN_TOKENS_SIZE ? AZ_MIN_TOKENS_SIZE : src->tokens.size;
+/* Initialize token arena, sized for `length` input chars */
+static int az_arena_init(struct az_token_arena *arena, const int length) {
+    const int size = length * 4 < AZ_MIN_TOKENS_SIZE ? AZ_MIN_TOKENS_SIZE : length * 4;
 
-    *dst = *src;
-    if (!(dst->tokens.tokens = (struct az_token *) az_malloc(AZ_FAIL_ID_CPY, sizeof(struct az_token) * size))) {
+    if (!(arena->tokens = (struct az_token *) az_malloc(AZ_FAIL_ID_ARENA_INIT, sizeof(struct az_token) * size))) {
+        arena->used = arena->size = 0;
         return 0;
     }
-    if (src->tokens.used) {
-        memcpy(dst->tokens.tokens, src->tokens.tokens, sizeof(struct az_token) * src->tokens.used);
-    }
-    dst->tokens.size = size;
+    arena->size = size;
+    arena->used = 1; /* Skip 1st */
     return 1;
 }
 
-/* Free `state`, i.e. free its token list */
-static void az_state_free(struct az_state *state) {
-    if (state->tokens.tokens) {
-        free(state->tokens.tokens);
-        state->tokens.tokens = NULL;
+/* Free token arena - returns 0 for convenience */
+static int az_arena_free(struct az_token_arena *arena) {
+    if (arena->tokens) {
+        free(arena->tokens);
+        arena->tokens = NULL;
     }
+    arena->used = arena->size = 0;
+    return 0;
 }
 
-/* Check that there's enough room for `extra` more tokens in `state` */
-static int az_tokens_add_chk(struct az_state *state, const int extra) {
+/* Check that there's enough room for `extra` more tokens in the arena */
+static int az_arena_add_chk(struct az_token_arena *arena, const int extra) {
     assert(extra > 0 && extra < AZ_MIN_TOKENS_SIZE);
-    assert(state->tokens.tokens); /* Always called only after a successful `az_state_cpy()` */
-    if (state->tokens.used >= state->tokens.size - extra) { /* Compare this way to avoid possible overflow */
+    if (arena->used > arena->size - extra) {
         struct az_token *tokens;
-        const unsigned short size = state->tokens.size * 2;
-        if (size <= state->tokens.size /* Overflow */
-                || !(tokens = (struct az_token *) az_realloc(AZ_FAIL_ID_ADD_CHK, state->tokens.tokens,
+        const int size = arena->size > INT_MAX / 2 ? 0 : arena->size * 2;
+        if (size <= arena->size /* Overflow */
+                || !(tokens = (struct az_token *) az_realloc(AZ_FAIL_ID_ARENA_ADD_CHK, arena->tokens,
                                                                 sizeof(struct az_token) * size))) {
             return 0;
         }
-        assert(size > state->tokens.used + extra);
-        state->tokens.tokens = tokens;
-        state->tokens.size = size;
+        assert(size >= arena->used + extra);
+        arena->tokens = tokens;
+        arena->size = size;
     }
     return 1;
 }
@@ -545,15 +551,9 @@ static int az_state_list_add_chk(struct az_state_list *list) {
     return 1;
 }
 
-/* Free all states (including their tokens) of state list `list` - returns 0 for convenience */
+/* Free the states of state list `list` - returns 0 for convenience */
 static int az_state_list_free(struct az_state_list *list) {
-    int i;
     if (list->states) {
-        for (i = 0; i < list->used; i++) {
-            if (list->states[i].tokens.tokens) {
-                free(list->states[i].tokens.tokens);
-            }
-        }
         free(list->states);
         list->states = NULL;
     }
@@ -561,12 +561,27 @@ static int az_state_list_free(struct az_state_list *list) {
     return 0;
 }
 
+/* Add a new state to `list` copied from `state`, checking there's room for `extra` more tokens */
+static struct az_state *az_state_list_add(struct az_state_list *list, const struct az_state *state,
+            const int extra) {
+    struct az_state *new_state;
+
+    if (!az_state_list_add_chk(list) || !az_arena_add_chk(list->arena, extra)) {
+        return NULL;
+    }
+    new_state = list->states + list->used++;
+    *new_state = *state;
+    return new_state;
+}
+
 #define AZ_FNC1_VAL 32          /* Pseudo-value for FNC1 - converted to 0 on setting token value */
 
-/* Shorthand to add a token to state `s` */
-#define AZ_ADD_TOKEN(s, v, c) \
-    (s)->tokens.tokens[(s)->tokens.used].value = (v); \
-    (s)->tokens.tokens[(s)->tokens.used++].count = (c)
+/* Shorthand to add a token to state `s` of state list `l` */
+#define AZ_ADD_TOKEN(l, s, v, c) \
+    (l)->arena->tokens[(l)->arena->used].value = (v); \
+    (l)->arena->tokens[(l)->arena->used].count = (c); \
+    (l)->arena->tokens[(l)->arena->used].previous = (s)->tokens; \
+    (s)->tokens = (l)->arena->used++
 
 /* Add a new state to `list` from `state`, with a latch if modes differ, and then a char, or 2 if `value2` set */
 static int az_LatchMaybeAndAppend(const struct az_state *state, const int from, const int mode, const int value,
@@ -576,29 +591,25 @@ static int az_LatchMaybeAndAppend(const struct az_state *state, const int from,
     int bitCount = state->bitCount;
     struct az_state *new_state;
 
-    if (!az_state_list_add_chk(list)) {
-        return 0;
-    }
-    new_state = list->states + list->used++;
-    if (!az_state_cpy(state, new_state) || !az_tokens_add_chk(new_state, 4 /*extra*/)) {
+    if (!(new_state = az_state_list_add(list, state, 4 /*extra*/))) {
         return 0;
     }
     /* End B/S if any */
     if (state->byteCount != 0) {
-        AZ_ADD_TOKEN(new_state, from - state->byteCount, state->byteCount);
+        AZ_ADD_TOKEN(list, new_state, from - state->byteCount, state->byteCount);
         new_state->byteCount = 0;
     }
 
     /* Latch if necessary */
     if (mode != state->mode) {
-        AZ_ADD_TOKEN(new_state, AztecLatch[state->mode][mode], -AztecLatchNum[state->mode][mode]);
+        AZ_ADD_TOKEN(list, new_state, AztecLatch[state->mode][mode], -AztecLatchNum[state->mode][mode]);
         bitCount += AztecLatchNum[state->mode][mode];
     }
     if (val == AZ_FNC1_VAL) { /* FNC1 */
         latchModeBitCount += 3;
         val = 0;
     }
-    AZ_ADD_TOKEN(new_state, val, -latchModeBitCount);
+    AZ_ADD_TOKEN(list, new_state, val, -latchModeBitCount);
     bitCount += latchModeBitCount;
     if (value2 != -1) {
         latchModeBitCount = mode == AZ_D ? 4 : 5;
@@ -607,7 +618,7 @@ static int az_LatchMaybeAndAppend(const struct az_state *state, const int from,
             latchModeBitCount += 3;
             val = 0;
         }
-        AZ_ADD_TOKEN(new_state, val, -latchModeBitCount);
+        AZ_ADD_TOKEN(list, new_state, val, -latchModeBitCount);
         bitCount += latchModeBitCount;
     }
     new_state->mode = mode;
@@ -625,26 +636,22 @@ static int az_ShiftAndAppend(const struct az_state *state, const int from, const
 
     assert(state->mode != mode);
 
-    if (!az_state_list_add_chk(list)) {
-        return 0;
-    }
-    new_state = list->states + list->used++;
-    if (!az_state_cpy(state, new_state) || !az_tokens_add_chk(new_state, 3 /*extra*/)) {
+    if (!(new_state = az_state_list_add(list, state, 3 /*extra*/))) {
         return 0;
     }
     /* End B/S if any */
     if (state->byteCount != 0) {
-        AZ_ADD_TOKEN(new_state, from - state->byteCount, state->byteCount);
+        AZ_ADD_TOKEN(list, new_state, from - state->byteCount, state->byteCount);
         new_state->byteCount = 0;
     }
 
     /* Shifts exist only to AZ_U and AZ_P, both with tokens size 5 */
-    AZ_ADD_TOKEN(new_state, AztecShift[state->mode][mode], -thisModeBitCount);
+    AZ_ADD_TOKEN(list, new_state, AztecShift[state->mode][mode], -thisModeBitCount);
     if (val == AZ_FNC1_VAL) { /* FNC1 */
         val = 0;
         bitCount += 3;
     }
-    AZ_ADD_TOKEN(new_state, val, -bitCount);
+    AZ_ADD_TOKEN(list, new_state, val, -bitCount);
     new_state->mode = state->mode;
     new_state->bitCount = state->bitCount + thisModeBitCount + bitCount;
     return 1;
@@ -663,28 +670,24 @@ static int az_DigitLatchShiftAndAppend(const struct az_state *state, const int f
     assert(shiftMode == AZ_P || shiftMode == AZ_U);
     assert(state->mode != AZ_U || shiftMode != AZ_U);
 
-    if (!az_state_list_add_chk(list)) {
-        return 0;
-    }
-    new_state = list->states + list->used++;
-    if (!az_state_cpy(state, new_state) || !az_tokens_add_chk(new_state, 4 /*extra*/)) {
+    if (!(new_state = az_state_list_add(list, state, 4 /*extra*/))) {
         return 0;
     }
     /* End B/S if any */
     if (state->byteCount != 0) {
-        AZ_ADD_TOKEN(new_state, from - state->byteCount, state->byteCount);
+        AZ_ADD_TOKEN(list, new_state, from - state->byteCount, state->byteCount);
         new_state->byteCount = 0;
     }
 
     /* Latch to AZ_D */
-    AZ_ADD_TOKEN(new_state, AztecLatch[state->mode][AZ_D], -AztecLatchNum[state->mode][AZ_D]);
+    AZ_ADD_TOKEN(list, new_state, AztecLatch[state->mode][AZ_D], -AztecLatchNum[state->mode][AZ_D]);
     /* P/S or U/S */
-    AZ_ADD_TOKEN(new_state, AztecShift[AZ_D][shiftMode], -4);
+    AZ_ADD_TOKEN(list, new_state, AztecShift[AZ_D][shiftMode], -4);
     if (val == AZ_FNC1_VAL) { /* FNC1 */
         valBitCount += 3;
         val = 0;
     }
-    AZ_ADD_TOKEN(new_state, val, -valBitCount);
+    AZ_ADD_TOKEN(list, new_state, val, -valBitCount);
     new_state->mode = AZ_D;
     new_state->bitCount = bitCount + valBitCount;
     return 1;
@@ -698,17 +701,13 @@ static int az_AddByteShiftChar(const struct az_state *state, const int from, con
     const int deltaBitCount = state->byteCount == 0 || state->byteCount == 31 ? 18 : state->byteCount == 62 ? 9 : 8;
     struct az_state *new_state;
 
-    if (!az_state_list_add_chk(list)) {
-        return 0;
-    }
-    new_state = list->states + list->used++;
-    if (!az_state_cpy(state, new_state) || !az_tokens_add_chk(new_state, 3 /*extra*/)) {
+    if (!(new_state = az_state_list_add(list, state, 3 /*extra*/))) {
         return 0;
     }
 
     if (state->mode == AZ_P || state->mode == AZ_D) {
         assert(state->byteCount == 0);
-        AZ_ADD_TOKEN(new_state, AztecLatch[mode][AZ_U], -AztecLatchNum[mode][AZ_U]);
+        AZ_ADD_TOKEN(list, new_state, AztecLatch[mode][AZ_U], -AztecLatchNum[mode][AZ_U]);
         bitCount += AztecLatchNum[mode][AZ_U];
         mode = AZ_U;
     }
@@ -717,7 +716,7 @@ static int az_AddByteShiftChar(const struct az_state *state, const int from, con
     new_state->bitCount = bitCount + deltaBitCount;
     if (new_state->byteCount == 2047 + 31) {
         /* The string is as long as it's allowed to be - end it */
-        AZ_ADD_TOKEN(new_state, from + 1 - new_state->byteCount, new_state->byteCount);
+        AZ_ADD_TOKEN(list, new_state, from + 1 - new_state->byteCount, new_state->byteCount);
         new_state->byteCount = 0;
     }
     if (from2 != -1) {
@@ -727,7 +726,7 @@ static int az_AddByteShiftChar(const struct az_state *state, const int from, con
         new_state->bitCount += deltaBitCount2;
         if (new_state->byteCount == 2047 + 31) {
             /* The string is as long as it's allowed to be - end it */
-            AZ_ADD_TOKEN(new_state, from2 + 1 - new_state->byteCount, new_state->byteCount);
+            AZ_ADD_TOKEN(list, new_state, from2 + 1 - new_state->byteCount, new_state->byteCount);
             new_state->byteCount = 0;
         }
     }
@@ -735,18 +734,17 @@ static int az_AddByteShiftChar(const struct az_state *state, const int from, con
 }
 
 /* Set the state `ret_state` identical to `state`, but no longer in B/S mode */
-static int az_EndByteShift(const struct az_state *state, struct az_state *ret_state, const int from) {
+static int az_EndByteShift(const struct az_state *state, struct az_state *ret_state, const int from,
+            struct az_state_list *list) {
 
-    if (!az_state_cpy(state, ret_state)) {
-        return 0;
-    }
+    *ret_state = *state;
     if (state->byteCount == 0) {
         return 1;
     }
-    if (!az_tokens_add_chk(ret_state, 1 /*extra*/)) {
+    if (!az_arena_add_chk(list->arena, 1 /*extra*/)) {
         return 0;
     }
-    AZ_ADD_TOKEN(ret_state, from - state->byteCount, state->byteCount);
+    AZ_ADD_TOKEN(list, ret_state, from - state->byteCount, state->byteCount);
     ret_state->byteCount = 0;
     return 1;
 }
@@ -791,60 +789,116 @@ static void az_dump_list(const struct az_state_list *list, const char *prefix) {
     static char spaces[50 + 1] = "                                                  ";
     const int pl = (int) strlen(prefix);
     int i;
-    fprintf(stderr, "%sSize %d\n", prefix, (int) list->used);
+    fprintf(stderr, "%sSize %d, Arena %d\n", prefix, (int) list->used, list->arena->used);
     for (i = 0; i < list->used; i++) {
         const struct az_state *state = list->states + i;
-        fprintf(stderr, "%.*s %d: mode %d, Size(tokens) %d, bitCount %d, byteCount %d\n",
-                pl, spaces, i, state->mode, state->tokens.used, state->bitCount, state->byteCount);
+        fprintf(stderr, "%.*s %d: mode %d, tokens %d, bitCount %d, byteCount %d\n",
+                pl, spaces, i, state->mode, state->tokens, state->bitCount, state->byteCount);
     }
 }
 #endif
 
-/* Iterate through states, removing those that are sub-optimal */
-static void az_SimplifyStates(struct az_state_list *list) {
+#define AZ_RMAP_SET(i)  (rmap[(i) >> 3] |= 1 << ((i) & 0x7))
+#define AZ_RMAP_GET(i)  (rmap[(i) >> 3] & (1 << ((i) & 0x7)))
+
+/* Iterate through states, removing those that are sub-optimal. Returns 0 on scratch arena failure, 1 otherwise */
+static int az_SimplifyStates(struct az_state_list *list) {
     int i, j;
     const int rmap_size = (list->used + 7) >> 3;
     unsigned char *rmap = (unsigned char *) z_alloca(rmap_size); /* Map of entries removed */
+    int best[AZ_NUM_MODES]; /* Per-mode index of best state not in B/S mode */
     const struct az_state *new_state, *old_state;
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0;
+    }
+
     memset(rmap, 0, rmap_size);
 
     az_dump_list(list, " SS in  ");
 
+    /* States not in B/S mode with the same mode are ordered by bit count alone, so first keep only the best of each
+       (the last of equals, as below), leaving few for the pairwise comparisons */
+    for (i = 0; i < AZ_NUM_MODES; i++) {
+        best[i] = -1;
+    }
+    for (i = 0; i < list->used; i++) {
+        new_state = list->states + i;
+        if (new_state->byteCount == 0) {
+            const int b = best[new_state->mode];
+            if (b == -1) {
+                best[new_state->mode] = i;
+            } else if (new_state->bitCount <= list->states[b].bitCount) {
+                AZ_RMAP_SET(b);
+                best[new_state->mode] = i;
+            } else {
+                AZ_RMAP_SET(i);
+            }
+        }
+    }
+
     for (i = 0; i < list->used; i++) {
-        if (!(rmap[i >> 3] & (1 << (i & 0x7)))) {
+        if (!AZ_RMAP_GET(i)) {
             new_state = list->states + i;
             for (j = i + 1; j < list->used; j++) {
-                if (!(rmap[j >> 3] & (1 << (j & 0x7)))) {
+                if (!AZ_RMAP_GET(j)) {
                     old_state = list->states + j;
                     if (az_IsBetterThanOrEqualTo(old_state, new_state)) {
-                        rmap[i >> 3] |= 1 << (i & 0x7);
+                        AZ_RMAP_SET(i);
                         break;
                     }
                     if (az_IsBetterThanOrEqualTo(new_state, old_state)) {
-                        rmap[j >> 3] |= 1 << (j & 0x7);
+                        AZ_RMAP_SET(j);
                     }
                 }
             }
         }
     }
-    for (i = list->used - 1; i >= 0; i--) {
-        if (rmap[i >> 3] & (1 << (i & 0x7))) {
-            const int k = i + 1;
-            /* Remove consecutive entries in one go */
-            for (j = i - 1; j >= 0 && (rmap[j >> 3] & (1 << (j & 0x7))); j--) {
-                az_state_free(list->states + j + 1);
-            }
-            az_state_free(list->states + j + 1);
-            if (k < list->used) {
-                memmove(list->states + j + 1, list->states + k, sizeof(struct az_state) * (list->used - k));
+    for (i = 0, j = 0; i < list->used; i++) {
+        if (!AZ_RMAP_GET(i)) {
+            if (j != i) {
+                list->states[j] = list->states[i];
             }
-            list->used -= i - j;
-            i = j + 1;
+            j++;
         }
     }
+    list->used = j;
 
     az_dump_list(list, " SS out ");
+
+    return 1;
+}
+
+/* Reclaim the arena tokens added since `start` by states that have since been removed. As each state's new tokens
+   are contiguous and surviving states retain their order, they can be shifted down in place */
+static void az_arena_compact(struct az_state_list *list, const int start) {
+    struct az_token *tokens = list->arena->tokens;
+    int dst = start;
+    int i;
+
+    for (i = 0; i < list->used; i++) {
+        struct az_state *state = list->states + i;
+        if (state->tokens >= start) {
+            int first = state->tokens;
+            while (tokens[first].previous >= start) {
+                first = tokens[first].previous;
+            }
+            assert(first >= dst);
+            if (first != dst) {
+                const int delta = first - dst;
+                int k;
+                for (k = first; k <= state->tokens; k++) {
+                    tokens[k - delta] = tokens[k];
+                    if (tokens[k - delta].previous >= start) {
+                        tokens[k - delta].previous -= delta;
+                    }
+                }
+                state->tokens -= delta;
+            }
+            dst = state->tokens + 1;
+        }
+    }
+    list->arena->used = dst;
 }
 
 /* Return a set of states for a Punct double - see `az_UpdateStateForChar()` below */
@@ -929,79 +983,86 @@ static int az_UpdateStateForChar(const struct az_state *state, const unsigned ch
     return 1;
 }
 
-/* Update a set of states for a Punct double - see `az_UpdateStateListForChar()` below */
-static int az_UpdateStateListForPair(struct az_state_list *list, const int from, const int pairCode) {
+/* Update a set of states for a Punct double into `ret_list` - see `az_UpdateStateListForChar()` below */
+static int az_UpdateStateListForPair(const struct az_state_list *list, struct az_state_list *ret_list,
+            const int from, const int pairCode) {
+    const int start = ret_list->arena->used;
     int i;
-    struct az_state_list s_ret_list;
-    struct az_state_list *ret_list = &s_ret_list;
-    if (!az_state_list_init(ret_list, list->size)) {
-        return 0;
-    }
+
+    ret_list->used = 0;
     for (i = 0; i < list->used; i++) {
         if (!az_UpdateStateForPair(list->states + i, from, pairCode, ret_list)) {
-            return az_state_list_free(ret_list); /* Returns 0 */
+            return 0;
         }
     }
-    az_SimplifyStates(ret_list);
-
-    (void) az_state_list_free(list);
-    list->states = ret_list->states;
-    list->size = ret_list->size;
-    list->used = ret_list->used;
+    if (!az_SimplifyStates(ret_list)) {
+        return 0;
+    }
+    az_arena_compact(ret_list, start);
 
     return 1;
 }
 
-/* Update a set of states for a new character by updating each state for the new character, merging the results,
-   and then removing the non-optimal states */
-static int az_UpdateStateListForChar(struct az_state_list *list, const unsigned char *source, const int from,
-            const int fnc1_if_gs) {
+/* Update a set of states for a new character by updating each state for the new character, merging the results
+   into `ret_list`, and then removing the non-optimal states */
+static int az_UpdateStateListForChar(const struct az_state_list *list, struct az_state_list *ret_list,
+            const unsigned char *source, const int from, const int fnc1_if_gs) {
+    const int start = ret_list->arena->used;
     int i;
-    struct az_state_list s_ret_list;
-    struct az_state_list *ret_list = &s_ret_list;
-    if (!az_state_list_init(ret_list, list->size)) {
-        return 0;
-    }
+
+    ret_list->used = 0;
     for (i = 0; i < list->used; i++) {
         if (!az_UpdateStateForChar(list->states + i, source, from, fnc1_if_gs, ret_list)) {
-            return az_state_list_free(ret_list); /* Returns 0 */
+            return 0;
         }
     }
     if (ret_list->used > 1) {
-        az_SimplifyStates(ret_list);
+        if (!az_SimplifyStates(ret_list)) {
+            return 0;
+        }
+        az_arena_compact(ret_list, start);
     }
 
-    (void) az_state_list_free(list);
-    list->states = ret_list->states;
-    list->size = ret_list->size;
-    list->used = ret_list->used;
-
     return 1;
 }
 
+/* Free the token arena and both state lists - returns 0 for convenience */
+static int az_binary_string_free(struct az_token_arena *arena, struct az_state_list *list,
+            struct az_state_list *ret_list) {
+    (void) az_arena_free(arena);
+    (void) az_state_list_free(list);
+    return az_state_list_free(ret_list);
+}
+
 /* Default, optimized encodation algorithm by Frank Yellin and Rustam Abdullaev, adapted from ZXing via zxing-cpp's
    `HighLevelEncoder::Encode()` & slightly improved */
 /* Copyright 2013 ZXing authors */ /* ZXing */
 /* Copyright 2016 Huy Cuong Nguyen */ /* zxing-cpp */
 /* SPDX-License-Identifier: Apache-2.0 */
 /* Note that a bitstream that is encoded to be shortest based on mode choices may not be so after bit-stuffing */
-static int az_binary_string(const unsigned char source[], const int length, int bp,
-            char binary_string[AZTEC_MAP_POSN_MAX + 1], const char *fncs, const char initial_mode,
-            char *p_current_mode) {
-    struct az_state_list s_state_list;
-    struct az_state_list *list = &s_state_list;
+static int az_binary_string(const unsigned char source[], const int length, struct z_bitstream *bs,
+            const char *fncs, const char initial_mode, char *p_current_mode) {
+    struct az_token_arena s_arena;
+    struct az_token_arena *arena = &s_arena;
+    struct az_state_list s_state_lists[2];
+    struct az_state_list *list = s_state_lists, *ret_list = s_state_lists + 1, *tmp_list;
     struct az_state stateEnd;
+    struct az_token *tokens;
     int minStateIdx = -1;
     int minBitCount = INT_MAX;
-    int i;
+    int i, previous;
 #ifndef NDEBUG
-    const int entry_bp = bp;
+    const int entry_bp = bs->bp;
 #endif
 
     assert(length < USHRT_MAX);
-    if (!az_state_list_init(list, (unsigned short) length)) {
+    ret_list->states = NULL;
+    if (!az_state_list_init(list, (unsigned short) length, arena)) {
         return 0;
     }
+    if (!az_arena_init(arena, length) || !az_state_list_init(ret_list, (unsigned short) length, arena)) {
+        return az_binary_string_free(arena, list, ret_list); /* Returns 0 */
+    }
     memset(list->states, 0, sizeof(struct az_state));
     list->states[list->used++].mode = initial_mode;
 
@@ -1012,15 +1073,18 @@ static int az_binary_string(const unsigned char source[], const int length, int
         if (AZ_DOUBLE_PUNCT(source, length, i)) {
             /* (CR LF) -> 2, (. SP) -> 3, (, SP) -> 4, (: SP) -> 5 */
             const int pairCode = source[i] == '\r' ? 2 : 3 + 7 - ((source[i] & 0x0F) >> 1);
-            if (!az_UpdateStateListForPair(list, i, pairCode)) {
-                return az_state_list_free(list); /* Returns 0 */
+            if (!az_UpdateStateListForPair(list, ret_list, i, pairCode)) {
+                return az_binary_string_free(arena, list, ret_list); /* Returns 0 */
             }
             i++;
         } else {
-            if (!az_UpdateStateListForChar(list, source, i, fncs[i])) {
-                return az_state_list_free(list); /* Returns 0 */
+            if (!az_UpdateStateListForChar(list, ret_list, source, i, fncs[i])) {
+                return az_binary_string_free(arena, list, ret_list); /* Returns 0 */
             }
         }
+        tmp_list = list;
+        list = ret_list;
+        ret_list = tmp_list;
     }
     az_dump_list(list, "End ");
 
@@ -1032,47 +1096,54 @@ static int az_binary_string(const unsigned char source[], const int length, int
     }
     assert(minStateIdx >= 0);
 
-    if (!az_EndByteShift(list->states + minStateIdx, &stateEnd, length)) {
-        az_state_free(&stateEnd);
-        return az_state_list_free(list); /* Returns 0 */
+    if (!az_EndByteShift(list->states + minStateIdx, &stateEnd, length, list)) {
+        return az_binary_string_free(arena, list, ret_list); /* Returns 0 */
     }
 
     if (stateEnd.bitCount > AZTEC_BIN_CAPACITY) {
-        az_state_free(&stateEnd);
-        (void) az_state_list_free(list);
+        (void) az_binary_string_free(arena, list, ret_list);
         return stateEnd.bitCount;
     }
 
-    for (i = 0; i < stateEnd.tokens.used; i++) {
-        const struct az_token *const token = stateEnd.tokens.tokens + i;
+    /* Reverse the token chain in place so that it can be output first to last */
+    tokens = arena->tokens;
+    previous = 0;
+    for (i = stateEnd.tokens; i; ) {
+        const int next = tokens[i].previous;
+        tokens[i].previous = previous;
+        previous = i;
+        i = next;
+    }
+
+    for (i = previous; i; i = tokens[i].previous) {
+        const struct az_token *const token = tokens + i;
         const int count = token->count;
         if (count < 0) {
-            bp = z_bin_append_posn(token->value, -count, binary_string, bp);
+            z_bs_append(bs, token->value, -count);
         } else {
             int j;
             for (j = 0; j < count; j++) {
                 if (j == 0 || (j == 31 && count <= 62)) {
-                    bp = z_bin_append_posn(31, 5, binary_string, bp); /* B/S */
+                    z_bs_append(bs, 31, 5); /* B/S */
                     if (count > 62) {
-                        bp = z_bin_append_posn(count - 31, 16, binary_string, bp);
+                        z_bs_append(bs, count - 31, 16);
                     } else if (j == 0) {
-                        bp = z_bin_append_posn(count <= 31 ? count : 31, 5, binary_string, bp);
+                        z_bs_append(bs, count <= 31 ? count : 31, 5);
                     } else {
-                        bp = z_bin_append_posn(count - 31, 5, binary_string, bp);
+                        z_bs_append(bs, count - 31, 5);
                     }
                 }
-                bp = z_bin_append_posn(source[token->value + j], 8, binary_string, bp);
+                z_bs_append(bs, source[token->value + j], 8);
             }
         }
     }
-    assert(bp - entry_bp == stateEnd.bitCount);
+    assert(bs->bp - entry_bp == stateEnd.bitCount);
 
     *p_current_mode = stateEnd.mode;
 
-    az_state_free(&stateEnd);
-    (void) az_state_list_free(list);
+    (void) az_binary_string_free(arena, list, ret_list);
 
-    return bp;
+    return bs->bp;
 }
 
 /* Calculate the binary size */
@@ -1169,8 +1240,8 @@ static int az_text_size(const char *modes, const unsigned char *source, const in
 }
 
 /* Determine encoding modes and encode */
-static int az_text_process(unsigned char *source, const int length, int bp, char *binary_string, const char *fncs,
-            const int eci, const int fast_encode, char *p_current_mode, int *data_length, const int debug) {
+static int az_text_process(unsigned char *source, const int length, struct z_bitstream *bs, const char *fncs,
+            const int eci, const int fast_encode, char *p_current_mode, const int debug) {
     int i, j;
     int reduced_length = 0; /* Suppress gcc-14 warning -Wmaybe-uninitialized */
     char *modes = (char *) z_alloca(length + 1);
@@ -1180,7 +1251,7 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
     int eci_latch = 0;
     char current_mode = p_current_mode ? *p_current_mode : AZ_U;
     const char initial_mode = current_mode;
-    const int initial_bp = bp;
+    const int initial_bp = bs->bp;
     const int all_byte_only_or_uld = length > 1 ? az_all_byte_only_or_uld(source, length) : -1; /* -1 if not */
     const int debug_print = debug & ZINT_DEBUG_PRINT;
 #ifdef ZINT_TEST
@@ -1189,37 +1260,40 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
     const int debug_skip_all = 0;
 #endif
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (eci) {
         const int flg = 1 + (eci >= 10) + (eci >= 100) + (eci >= 1000) + (eci >= 10000) + (eci >= 100000);
         if (initial_mode != AZ_P) {
             /* See if it's worthwhile latching to AZ_P */
             if ((eci_latch = az_count_initial_puncts(source, length) >= flg + (initial_mode == AZ_D))) {
-                bp = z_bin_append_posn(AztecLatch[(int) initial_mode][AZ_P], AztecLatchNum[(int) initial_mode][AZ_P],
-                                        binary_string, bp);
+                z_bs_append(bs, AztecLatch[(int) initial_mode][AZ_P], AztecLatchNum[(int) initial_mode][AZ_P]);
                 current_mode = AZ_P;
             } else {
-                bp = z_bin_append_posn(0, initial_mode == AZ_D ? 4 : 5, binary_string, bp); /* P/S */
+                z_bs_append(bs, 0, initial_mode == AZ_D ? 4 : 5); /* P/S */
             }
         }
-        bp = z_bin_append_posn(flg, 5 + 3, binary_string, bp); /* FLG(n) */
+        z_bs_append(bs, flg, 5 + 3); /* FLG(n) */
         if (flg == 1) {
-            bp = z_bin_append_posn(2 + eci, 4, binary_string, bp);
+            z_bs_append(bs, 2 + eci, 4);
         } else if (flg == 2) {
-            bp = z_bin_append_posn(((2 + eci / 10) << 4) + 2 + eci % 10, 8, binary_string, bp);
+            z_bs_append(bs, ((2 + eci / 10) << 4) + 2 + eci % 10, 8);
         } else if (flg == 3) {
-            bp = z_bin_append_posn(2 + eci / 100, 4, binary_string, bp);
-            bp = z_bin_append_posn(((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8, binary_string, bp);
+            z_bs_append(bs, 2 + eci / 100, 4);
+            z_bs_append(bs, ((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8);
         } else if (flg == 4) {
-            bp = z_bin_append_posn(((2 + eci / 1000) << 4) + 2 + eci % 1000 / 100, 8, binary_string, bp);
-            bp = z_bin_append_posn(((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8, binary_string, bp);
+            z_bs_append(bs, ((2 + eci / 1000) << 4) + 2 + eci % 1000 / 100, 8);
+            z_bs_append(bs, ((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8);
         } else if (flg == 5) {
-            bp = z_bin_append_posn(2 + eci / 10000, 4, binary_string, bp);
-            bp = z_bin_append_posn(((2 + eci % 10000 / 1000) << 4) + 2 + eci % 1000 / 100, 8, binary_string, bp);
-            bp = z_bin_append_posn(((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8, binary_string, bp);
+            z_bs_append(bs, 2 + eci / 10000, 4);
+            z_bs_append(bs, ((2 + eci % 10000 / 1000) << 4) + 2 + eci % 1000 / 100, 8);
+            z_bs_append(bs, ((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8);
         } else {
-            bp = z_bin_append_posn(((2 + eci / 100000) << 4) + 2 + eci % 100000 / 10000, 8, binary_string, bp);
-            bp = z_bin_append_posn(((2 + eci % 10000 / 1000) << 4) + 2 + eci % 1000 / 100, 8, binary_string, bp);
-            bp = z_bin_append_posn(((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8, binary_string, bp);
+            z_bs_append(bs, ((2 + eci / 100000) << 4) + 2 + eci % 100000 / 10000, 8);
+            z_bs_append(bs, ((2 + eci % 10000 / 1000) << 4) + 2 + eci % 1000 / 100, 8);
+            z_bs_append(bs, ((2 + eci % 100 / 10) << 4) + 2 + eci % 10, 8);
         }
     }
 
@@ -1229,7 +1303,7 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
     } else if (fast_encode) {
         reduced_length = az_text_modes(modes, source, length, fncs, current_mode, debug_print);
     } else {
-        bp = az_binary_string(source, length, bp, binary_string, fncs, current_mode, &current_mode);
+        const int bp = az_binary_string(source, length, bs, fncs, current_mode, &current_mode);
         if (bp == 0 || bp > AZTEC_BIN_CAPACITY) {
             return bp == 0 ? ZINT_ERROR_MEMORY : ZINT_ERROR_TOO_LONG;
         }
@@ -1239,7 +1313,7 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
 
     if (!size) {
         size = az_text_size(modes, source, reduced_length, fncs, eci, initial_mode, eci_latch, byte_counts);
-        if (size == 0 || bp + size > AZTEC_BIN_CAPACITY) {
+        if (size == 0 || bs->bp + size > AZTEC_BIN_CAPACITY) {
             return ZINT_ERROR_TOO_LONG;
         }
 
@@ -1250,8 +1324,8 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
                 const int mask_mode = AZ_MASK(modes[i]);
                 if (current_mode != mask_mode) {
                     assert(current_mode != AZ_B); /* Suppress clang-tidy-22 clang-analyzer-security.ArrayBound */
-                    bp = z_bin_append_posn(AztecLatch[(int) current_mode][mask_mode],
-                                            AztecLatchNum[(int) current_mode][mask_mode], binary_string, bp);
+                    z_bs_append(bs, AztecLatch[(int) current_mode][mask_mode],
+                                AztecLatchNum[(int) current_mode][mask_mode]);
                     if (mask_mode == AZ_B && (current_mode == AZ_P || current_mode == AZ_D)) {
                         current_mode = AZ_U;
                         current_mode_set = 1;
@@ -1259,13 +1333,13 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
                 }
                 if (modes[i] & AZ_PS) {
                     assert(mask_mode != AZ_P);
-                    bp = z_bin_append_posn(0, 4 + (mask_mode != AZ_D), binary_string, bp); /* P/S */
+                    z_bs_append(bs, 0, 4 + (mask_mode != AZ_D)); /* P/S */
                 } else if (modes[i] & AZ_US) {
                     assert(mask_mode == AZ_L || mask_mode == AZ_D);
                     if (mask_mode == AZ_L) {
-                        bp = z_bin_append_posn(28, 5, binary_string, bp); /* U/S */
+                        z_bs_append(bs, 28, 5); /* U/S */
                     } else {
-                        bp = z_bin_append_posn(15, 4, binary_string, bp); /* U/S */
+                        z_bs_append(bs, 15, 4); /* U/S */
                     }
                 }
 
@@ -1279,35 +1353,35 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
                     if (count > 2047) { /* Max 11-bit number */
                         big_batch = count > 2078 ? 2078 : count;
                         /* Put 00000 followed by 11-bit number of bytes less 31 */
-                        bp = z_bin_append_posn(big_batch - 31, 16, binary_string, bp);
+                        z_bs_append(bs, big_batch - 31, 16);
                         for (j = 0; j < big_batch; j++) {
-                            bp = z_bin_append_posn(source[i++], 8, binary_string, bp);
+                            z_bs_append(bs, source[i++], 8);
                         }
                         count -= big_batch;
                     }
                     if (count) {
                         if (big_batch) {
-                            bp = z_bin_append_posn(31, 5, binary_string, bp); /* B/S */
+                            z_bs_append(bs, 31, 5); /* B/S */
                         }
                         if (count > 62) {
                             assert(count <= 2078);
                             /* Put 00000 followed by 11-bit number of bytes less 31 */
-                            bp = z_bin_append_posn(count - 31, 16, binary_string, bp);
+                            z_bs_append(bs, count - 31, 16);
                         } else {
                             if (count > 31) {
                                 /* 2 5-bit B/Ss beats 1 11-bit */
-                                bp = z_bin_append_posn(31, 5, binary_string, bp); /* 5-bit byte count */
+                                z_bs_append(bs, 31, 5); /* 5-bit byte count */
                                 for (j = 0; j < 31; j++) {
-                                    bp = z_bin_append_posn(source[i++], 8, binary_string, bp);
+                                    z_bs_append(bs, source[i++], 8);
                                 }
-                                bp = z_bin_append_posn(31, 5, binary_string, bp); /* B/S */
+                                z_bs_append(bs, 31, 5); /* B/S */
                                 count -= 31;
                             }
                             /* Put 5-bit number of bytes */
-                            bp = z_bin_append_posn(count, 5, binary_string, bp);
+                            z_bs_append(bs, count, 5);
                         }
                         for (j = 0; j < count; j++) {
-                            bp = z_bin_append_posn(source[i++], 8, binary_string, bp);
+                            z_bs_append(bs, source[i++], 8);
                         }
                     }
                     i--;
@@ -1321,31 +1395,30 @@ static int az_text_process(unsigned char *source, const int length, int bp, char
 
             if (modes[i] == AZ_P || (modes[i] & AZ_PS)) {
                 if (fncs[i] && source[i] == '\x1D') {
-                    bp = z_bin_append_posn(0, 5 + 3, binary_string, bp); /* FLG(0) = FNC1 */
+                    z_bs_append(bs, 0, 5 + 3); /* FLG(0) = FNC1 */
                 } else {
-                    bp = z_bin_append_posn(AztecChar[AZ_P][source[i]], 5, binary_string, bp);
+                    z_bs_append(bs, AztecChar[AZ_P][source[i]], 5);
                 }
             } else {
                 const int char_mode = (modes[i] & AZ_US) ? AZ_U : modes[i];
                 assert(char_mode != AZ_B); /* Suppress clang-tidy-22 clang-analyzer-security.ArrayBound */
-                bp = z_bin_append_posn(AztecChar[char_mode][source[i]], 4 + (modes[i] != AZ_D), binary_string, bp);
+                z_bs_append(bs, AztecChar[char_mode][source[i]], 4 + (modes[i] != AZ_D));
             }
         }
     }
 
-    *data_length = bp;
     if (p_current_mode) {
         *p_current_mode = current_mode;
     }
 
-    assert(size == bp - initial_bp);
+    assert(size == bs->bp - initial_bp);
 
     return 0;
 }
 
 /* Call `az_text_process()` for each segment */
-static int az_text_process_segs(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count, int bp,
-            char binary_string[], const int gs1, int *data_length) {
+static int az_text_process_segs(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count,
+            struct z_bitstream *bs, const int gs1) {
     int i;
     char current_mode = AZ_U;
     int have_extra_escapes = 0;
@@ -1365,14 +1438,14 @@ static int az_text_process_segs(struct zint_symbol *symbol, struct zint_seg segs
             if (position_fnc1 == 4) {
                 if (z_islower(source[0])) {
                     current_mode = AZ_L;
-                    bp = z_bin_append_posn(28, 5, binary_string, bp); /* L/L */
+                    z_bs_append(bs, 28, 5); /* L/L */
                 }
-                bp = z_bin_append_posn(AztecChar[(int) current_mode][source[0]], 5, binary_string, bp);
+                z_bs_append(bs, AztecChar[(int) current_mode][source[0]], 5);
             } else if (position_fnc1 == 5) {
                 current_mode = AZ_D;
-                bp = z_bin_append_posn(30, 5, binary_string, bp); /* D/L */
-                bp = z_bin_append_posn(AztecChar[AZ_D][source[0]], 4, binary_string, bp);
-                bp = z_bin_append_posn(AztecChar[AZ_D][source[1]], 4, binary_string, bp);
+                z_bs_append(bs, 30, 5); /* D/L */
+                z_bs_append(bs, AztecChar[AZ_D][source[0]], 4);
+                z_bs_append(bs, AztecChar[AZ_D][source[1]], 4);
             }
             have_extra_escapes = 1;
         }
@@ -1380,16 +1453,15 @@ static int az_text_process_segs(struct zint_symbol *symbol, struct zint_seg segs
             assert(current_mode == AZ_U || current_mode == AZ_L);
             /* Latch to D/L to save a bit */
             current_mode = AZ_D;
-            bp = z_bin_append_posn(30, 5, binary_string, bp); /* D/L */
+            z_bs_append(bs, 30, 5); /* D/L */
         }
         /* See if it's worthwhile latching to AZ_P */
         if (az_count_initial_puncts(source + position_fnc1, length - position_fnc1) >= 1 + !segs[0].eci) {
-            bp = z_bin_append_posn(AztecLatch[(int) current_mode][AZ_P], AztecLatchNum[(int) current_mode][AZ_P],
-                                    binary_string, bp);
-            bp = z_bin_append_posn(0, 5 + 3, binary_string, bp); /* FLG(0) = FNC1 */
+            z_bs_append(bs, AztecLatch[(int) current_mode][AZ_P], AztecLatchNum[(int) current_mode][AZ_P]);
+            z_bs_append(bs, 0, 5 + 3); /* FLG(0) = FNC1 */
             current_mode = AZ_P;
         } else {
-            bp = z_bin_append_posn(0, 4 + (current_mode != AZ_D) + 5 + 3, binary_string, bp); /* P/S FLG(0) = FNC1 */
+            z_bs_append(bs, 0, 4 + (current_mode != AZ_D) + 5 + 3); /* P/S FLG(0) = FNC1 */
         }
     }
 
@@ -1401,6 +1473,9 @@ static int az_text_process_segs(struct zint_symbol *symbol, struct zint_seg segs
             unsigned char *src_buf = (unsigned char *) z_alloca(length + 1);
             char *fncs = (char *) z_alloca(length);
 
+            if (Z_SCRATCH_FAILED()) {
+                return ZINT_ERROR_MEMORY;
+            }
             if (gs1) {
                 memset(fncs, 1, length);
             } else {
@@ -1416,13 +1491,16 @@ static int az_text_process_segs(struct zint_symbol *symbol, struct zint_seg segs
                 }
             }
 
-            if ((error_number = az_text_process(source, length, bp, binary_string, fncs, segs[i].eci, fast_encode,
-                                                &current_mode, &bp, symbol->debug))) {
+            if ((error_number = az_text_process(source, length, bs, fncs, segs[i].eci, fast_encode, &current_mode,
+                                                symbol->debug))) {
                 return error_number;
             }
         }
         if (debug_print) {
-            printf("Binary String (%d): %.*s\n", bp, bp, binary_string);
+            z_bs_flush(bs);
+            printf("Binary String (%d): ", bs->bp);
+            z_debug_print_bits(bs->buf, bs->bp);
+            fputc('\n', stdout);
         }
         if (content_segs) {
             if (have_extra_escapes) {
@@ -1433,8 +1511,7 @@ static int az_text_process_segs(struct zint_symbol *symbol, struct zint_seg segs
         }
         position_fnc1 = 0;
     }
-
-    *data_length = bp;
+    z_bs_flush(bs);
 
     return 0;
 }
@@ -1522,7 +1599,7 @@ static void az_populate_map(short AztecMap[], const int layers) {
 }
 
 /* Helper to insert dummy '0' or '1's into runs of same bits. See ISO/IEC 24778:2008 7.3.1.2 */
-static int az_bitrun_stuff(const char *binary_string, const int data_length, const int codeword_size,
+static int az_bitrun_stuff(const unsigned char binary[], const int data_length, const int codeword_size,
             const int data_maxsize, char adjusted_string[AZTEC_MAX_CAPACITY]) {
     int i, j = 0, count = 0;
 
@@ -1539,18 +1616,18 @@ static int az_bitrun_stuff(const char *binary_string, const int data_length, con
                     return 0; /* Fail */
                 }
                 adjusted_string[j++] = count == 0 ? '1' : '0';
-                count = binary_string[i] == '1' ? 1 : 0;
+                count = z_bs_bit(binary, i);
             } else {
                 count = 0;
             }
 
-        } else if (binary_string[i] == '1') { /* Skip B so only counting B-1 */
+        } else if (z_bs_bit(binary, i)) { /* Skip B so only counting B-1 */
             count++;
         }
         if (j > data_maxsize) {
             return 0; /* Fail */
         }
-        adjusted_string[j++] = binary_string[i];
+        adjusted_string[j++] = '0' + z_bs_bit(binary, i);
     }
 
     return j;
@@ -1602,16 +1679,16 @@ static int az_codeword_size(const int layers) {
 /* Encodes Aztec Code as specified in ISO/IEC 24778:2008 */
 INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count) {
     int x, y, i, p, num_data_cws, num_ecc_cws, layers, total_bits;
-    char bit_pattern[AZTEC_MAP_POSN_MAX + 1]; /* Note AZTEC_MAP_POSN_MAX > AZTEC_BIN_CAPACITY */
-    /* To lessen stack usage, share binary_string buffer with bit_pattern, as accessed separately */
-    char *binary_string = bit_pattern;
+    Z_LARGE_ARRAY(char, bit_pattern, AZTEC_MAP_POSN_MAX + 1); /* Note AZTEC_MAP_POSN_MAX > AZTEC_BIN_CAPACITY */
+    /* To lessen stack usage, share packed binary buffer with bit_pattern, as accessed separately */
+    unsigned char *binary = (unsigned char *) bit_pattern;
+    struct z_bitstream bs;
     char descriptor[42];
-    char adjusted_string[AZTEC_MAX_CAPACITY];
-    short AztecMap[AZTEC_MAP_SIZE];
+    Z_LARGE_ARRAY(char, adjusted_string, AZTEC_MAX_CAPACITY);
+    Z_LARGE_ARRAY(short, AztecMap, AZTEC_MAP_SIZE);
     unsigned char desc_data[4], desc_ecc[6];
     int error_number;
     int compact, data_length, data_maxsize, codeword_size, adjusted_length;
-    int bp = 0;
     const int gs1 = (symbol->input_mode & 0x07) == GS1_MODE;
     const int extra_escape_mode = symbol->input_mode & EXTRA_ESCAPE_MODE;
     const int reader_init = symbol->output_options & READER_INIT;
@@ -1624,6 +1701,10 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
     float ecc_ratio;
     int dim;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if ((i = z_segs_length(segs, seg_count)) > 4981) { /* Max is 4981 digits */
         return z_errtxtf(ZINT_ERROR_TOO_LONG, symbol, 803, "Input length %d too long (maximum 4981)", i);
     }
@@ -1645,6 +1726,8 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
         }
     }
 
+    z_bs_init(&bs, binary);
+
     if (symbol->structapp.count) {
         /* Structured Append info as string <SP> + ID + <SP> + index + count + NUL */
         unsigned char sa_src[1 + sizeof(symbol->structapp.id) + 1 + 1 + 1 + 1] = {0};
@@ -1670,8 +1753,8 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
         }
 
         /* Starting with M/L U/L signals Structured Append */
-        bp = z_bin_append_posn(29, 5, binary_string, bp); /* M/L */
-        bp = z_bin_append_posn(29, 5, binary_string, bp); /* U/L */
+        z_bs_append(&bs, 29, 5); /* M/L */
+        z_bs_append(&bs, 29, 5); /* U/L */
 
         sa_len = 0;
         if (id_len) { /* ID has a space on either side */
@@ -1687,12 +1770,15 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
                     symbol->structapp.count, symbol->structapp.index, symbol->structapp.id, sa_src);
         }
 
-        (void) az_text_process(sa_src, sa_len, bp, binary_string, fncs, 0 /*eci*/, 0 /*fast_encode*/,
-                                NULL /*p_current_mode*/, &bp, symbol->debug);
+        if ((error_number = az_text_process(sa_src, sa_len, &bs, fncs, 0 /*eci*/, 0 /*fast_encode*/,
+                                            NULL /*p_current_mode*/, symbol->debug))) {
+            assert(error_number == ZINT_ERROR_MEMORY);
+            return z_errtxt(error_number, symbol, 804, "Insufficient memory for optimized encodation");
+        }
         /* Will be in U/L due to uppercase A-Z index/count indicators at end */
     }
 
-    if ((error_number = az_text_process_segs(symbol, segs, seg_count, bp, binary_string, gs1, &data_length))) {
+    if ((error_number = az_text_process_segs(symbol, segs, seg_count, &bs, gs1))) {
         assert(error_number == ZINT_ERROR_TOO_LONG || error_number == ZINT_ERROR_MEMORY
                 || error_number == ZINT_ERROR_INVALID_DATA || error_number == ZINT_ERROR_INVALID_OPTION);
         if (error_number == ZINT_ERROR_TOO_LONG) {
@@ -1704,6 +1790,7 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
         }
         return error_number; /* EXTRA_ESCAPE_MODE errors, `errtxt` set */
     }
+    data_length = bs.bp;
     assert(data_length > 0); /* Suppress clang-tidy warning: clang-analyzer-core.UndefinedBinaryOperatorResult */
 
     if (symbol->option_1 < -1 || symbol->option_1 > 4) {
@@ -1766,7 +1853,7 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
 
             codeword_size = az_codeword_size(layers);
 
-            adjusted_length = az_bitrun_stuff(binary_string, data_length, codeword_size,
+            adjusted_length = az_bitrun_stuff(binary, data_length, codeword_size,
                                                 adjustment_size ? data_maxsize : AZTEC_BIN_CAPACITY, adjusted_string);
             if (adjusted_length) {
                 /* Add padding */
@@ -1818,7 +1905,7 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
             data_maxsize = codeword_size * (AztecSizes[layers - 1] - 3);
         }
 
-        adjusted_length = az_bitrun_stuff(binary_string, data_length, codeword_size, data_maxsize, adjusted_string);
+        adjusted_length = az_bitrun_stuff(binary, data_length, codeword_size, data_maxsize, adjusted_string);
         if (adjusted_length && adjusted_length <= data_maxsize) {
             /* Add padding */
             adjusted_length = az_add_padding(codeword_size, adjusted_string, adjusted_length, debug_print);
@@ -1882,9 +1969,13 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
         /* Feedback percentage in top byte */
         symbol->option_1 |= ((int) z_stripf(ecc_ratio * 100.0f)) << 8;
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
 
     data_part = (unsigned int *) z_alloca(sizeof(unsigned int) * num_data_cws);
     ecc_part = (unsigned int *) z_alloca(sizeof(unsigned int) * num_ecc_cws);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     /* Copy across data into separate integers */
     memset(data_part, 0, sizeof(unsigned int) * num_data_cws);
@@ -1911,18 +2002,20 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
             zint_rs_encode_uint(&rs, num_data_cws, data_part, ecc_part);
             break;
         case 10:
-            if (!zint_rs_uint_init_gf(&rs_uint, 0x409, 1023)) { /* Can fail on malloc() */
-                return z_errtxt(ZINT_ERROR_MEMORY, symbol, 500, "Insufficient memory for Reed-Solomon log tables");
+            zint_rs_uint_init_gf(&rs_uint, 0x409);
+            if (!zint_rs_uint_init_code(&rs_uint, num_ecc_cws, 1)) { /* Can fail on malloc() if not cached */
+                return z_errtxt(ZINT_ERROR_MEMORY, symbol, 500,
+                                "Insufficient memory for Reed-Solomon generator polynomial");
             }
-            zint_rs_uint_init_code(&rs_uint, num_ecc_cws, 1);
             zint_rs_uint_encode(&rs_uint, num_data_cws, data_part, ecc_part);
             zint_rs_uint_free(&rs_uint);
             break;
         case 12:
-            if (!zint_rs_uint_init_gf(&rs_uint, 0x1069, 4095)) { /* Can fail on malloc() */
-                return z_errtxt(ZINT_ERROR_MEMORY, symbol, 700, "Insufficient memory for Reed-Solomon log tables");
+            zint_rs_uint_init_gf(&rs_uint, 0x1069);
+            if (!zint_rs_uint_init_code(&rs_uint, num_ecc_cws, 1)) { /* Can fail on malloc() if not cached */
+                return z_errtxt(ZINT_ERROR_MEMORY, symbol, 700,
+                                "Insufficient memory for Reed-Solomon generator polynomial");
             }
-            zint_rs_uint_init_code(&rs_uint, num_ecc_cws, 1);
             zint_rs_uint_encode(&rs_uint, num_data_cws, data_part, ecc_part);
             zint_rs_uint_free(&rs_uint);
             break;
@@ -1931,6 +2024,7 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
     for (i = 0; i < num_ecc_cws; i++) {
         adjusted_length = z_bin_append_posn(ecc_part[i], codeword_size, adjusted_string, adjusted_length);
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
 
     /* Invert the data so that actual data is on the outside and reed-solomon on the inside */
     memset(bit_pattern, '0', AZTEC_MAP_POSN_MAX + 1);
@@ -2043,6 +2137,7 @@ INTERNAL int zint_aztec(struct zint_symbol *symbol, struct zint_seg segs[], cons
         }
         dim = 151 - (2 * offset);
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
     symbol->height = dim;
     symbol->rows = dim;
     symbol->width = dim;
@@ -387,6 +387,10 @@ static int Rows2Columns(const CharacterSetTable T[], const int dataLength, int *
     int pTestList[62 + 1];
     int *pBackupSet = (int *) z_alloca(sizeof(int) * dataLength);
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     rowsRequested = *pRows;
     columnsRequested = *pUseColumns >= 4 ? *pUseColumns : 0;
 
@@ -597,6 +601,9 @@ INTERNAL int zint_codablockf(struct zint_symbol *symbol, unsigned char source[],
     }
 
     data = (unsigned char *) z_alloca(length * 2 + 1);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     dataLength = 0;
     if (symbol->output_options & READER_INIT) {
@@ -614,6 +621,9 @@ INTERNAL int zint_codablockf(struct zint_symbol *symbol, unsigned char source[],
     /* Build character set table */
     T = (CharacterSetTable *) z_alloca(sizeof(CharacterSetTable) * dataLength);
     pSet = (int *) z_alloca(sizeof(int) * dataLength);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     CreateCharacterSetTable(T, data, dataLength);
 
     /* Find final row and column count */
@@ -693,6 +703,9 @@ INTERNAL int zint_codablockf(struct zint_symbol *symbol, unsigned char source[],
     /* >>> Build C128 code numbers */
     /* The C128 column count contains Start (2CW), Row ID, Checksum, Stop */
     pOutput = (unsigned char *) z_alloca((size_t) columns * (size_t) rows);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     pOutPos = pOutput;
     charCur = 0;
     /* >> Loop over rows */
@@ -499,6 +499,10 @@ static int c1_encode(struct zint_symbol *symbol, unsigned char source[], int len
     unsigned char *eci_buf = (unsigned char *) z_alloca(eci_length + 1);
     int *num_digits = (int *) z_alloca(sizeof(int) * (eci_length + 1));
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
     memset(num_digits, 0, sizeof(int) * (eci_length + 1));
 
     /* Step A */
@@ -988,6 +992,9 @@ static void c1_encode_segs(struct zint_symbol *symbol, struct zint_seg segs[], c
 
     for (i = 0; i < seg_count; i++) {
         tp = c1_encode(symbol, segs[i].source, segs[i].length, segs[i].eci, seg_count, gs1, target, &tp, p_last_mode);
+        if (Z_SCRATCH_FAILED()) {
+            break;
+        }
         if (content_segs && segs[i].eci) {
             z_ct_set_seg_eci(symbol, i, segs[i].eci);
         }
@@ -1028,13 +1035,17 @@ static int c1_total_length_segs(struct zint_seg segs[], const int seg_count) {
 
 INTERNAL int zint_codeone(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count) {
     int size = 1, i, j;
-    char datagrid[136][120];
+    Z_LARGE_ARRAY2(char, datagrid, 136, 120);
     int row, col;
     int sub_version = 0;
     rs_t rs;
     const int gs1 = (symbol->input_mode & 0x07) == GS1_MODE;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (symbol->option_2 < 0 || symbol->option_2 > 10) {
         return z_errtxtf(ZINT_ERROR_INVALID_OPTION, symbol, 513, "Version '%d' out of range (1 to 10)",
                             symbol->option_2);
@@ -1147,18 +1158,26 @@ INTERNAL int zint_codeone(struct zint_symbol *symbol, struct zint_seg segs[], co
 
     } else if (symbol->option_2 == 10) {
         /* Version T */
-        unsigned int target[C1_MAX_CWS + C1_MAX_ECCS]; /* Use same buffer size as A to H to avail of loop checks */
+        /* Use same buffer size as A to H to avail of loop checks */
+        Z_LARGE_ARRAY(unsigned int, target, C1_MAX_CWS + C1_MAX_ECCS);
         unsigned int ecc[22];
         int data_length;
         int data_cw, ecc_cw, block_width;
         int last_mode = 0; /* Suppress gcc 14 "-Wmaybe-uninitialized" false positive */
 
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
+
         if ((i = c1_total_length_segs(segs, seg_count)) > 90) {
             return z_errtxtf(ZINT_ERROR_TOO_LONG, symbol, 519, "Input length %d too long for Version T (maximum 90)",
                             i);
         }
 
         c1_encode_segs(symbol, segs, seg_count, gs1, target, &data_length, &last_mode);
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
 
         assert(data_length); /* Can't exceed C1_MAX_CWS as input <= 90 */
         if (data_length > 38) {
@@ -1234,14 +1253,20 @@ INTERNAL int zint_codeone(struct zint_symbol *symbol, struct zint_seg segs[], co
 
     } else {
         /* Versions A to H */
-        unsigned int target[C1_MAX_CWS + C1_MAX_ECCS];
+        Z_LARGE_ARRAY(unsigned int, target, C1_MAX_CWS + C1_MAX_ECCS);
         unsigned int sub_data[185], sub_ecc[70];
         int data_length;
         int data_cw;
         int blocks, data_blocks, ecc_blocks, ecc_length;
         int last_mode;
 
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
         c1_encode_segs(symbol, segs, seg_count, gs1, target, &data_length, &last_mode);
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
 
         if (data_length == 0) {
             return z_errtxt(ZINT_ERROR_TOO_LONG, symbol, 517,
@@ -235,9 +235,22 @@ static int c128_set_values(const unsigned char source[], const int length, const
     int cset = 0;
     int i;
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
     memset(costs, 0, sizeof(*costs) * length);
 
     assert(source[length] == '\0'); /* Terminating NUL required by `c128_cost()` */
+    /* Memoize back to front so that `c128_cost()` recursion is at most 1 deep (bounded stack) */
+    for (i = length - 1; i > 0; i--) {
+        int p;
+        for (p = 0; priority[p]; p++) {
+            if (!costs[i][(int) priority[p]]) {
+                c128_cost(source, length, i, priority[p], 0 /*start_idx*/, priority, fncs, manuals, costs, modes);
+            }
+        }
+    }
     c128_cost(source, length, 0 /*i*/, 0 /*prior_cset*/, start_idx, priority, fncs, manuals, costs, modes);
 
     if (costs[0][0] > C128_SYMBOL_MAX) { /* Total minimal cost (glyph count) */
@@ -481,6 +494,9 @@ INTERNAL int zint_code128(struct zint_symbol *symbol, unsigned char source[], in
 
     glyph_count = c128_set_values(src, length, start_idx, priority, fncs, manuals, values, &first_cset,
                                     NULL /*p_final_cset*/);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     if (symbol->debug & ZINT_DEBUG_PRINT) {
         printf("Data (%d): %.*s", length, length >= 100 ? 1 : length >= 10 ? 2 : 3, " ");
@@ -561,6 +577,10 @@ INTERNAL int zint_gs1_128_cc(struct zint_symbol *symbol, unsigned char source[],
     unsigned char *reduced = (unsigned char *) z_alloca(length + 1);
     const int content_segs = symbol->output_options & BARCODE_CONTENT_SEGS;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (length > C128_MAX) {
         /* This only blocks ridiculously long input - the actual length of the
            resulting barcode depends on the type of data, so this is trapped later */
@@ -586,6 +606,9 @@ INTERNAL int zint_gs1_128_cc(struct zint_symbol *symbol, unsigned char source[],
 
     glyph_count = c128_set_values(reduced, reduced_length, 1 /*start_idx*/, priority, fncs, manuals, values,
                                     NULL /*p_first_cset*/, &final_cset);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     if (symbol->debug & ZINT_DEBUG_PRINT) {
         printf("Data (%d): %.*s", reduced_length, reduced_length >= 100 ? 1 : reduced_length >= 10 ? 2 : 3, " ");
@@ -33,6 +33,11 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdio.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 #include "common.h"
 
 /* Converts a character 0-9, A-F to its equivalent integer value */
@@ -193,6 +198,207 @@ INTERNAL int z_bin_append_posn(const int arg, const int length, char *binary, co
     return bin_posn + length;
 }
 
+/* Initialize bitstream `bs` to write to `buf` */
+INTERNAL void z_bs_init(struct z_bitstream *bs, unsigned char *buf) {
+    bs->buf = buf;
+    bs->acc = 0;
+    bs->acc_bits = 0;
+    bs->bp = 0;
+}
+
+/* Append the `length` (0 to 32) least significant bits of `arg` to `bs` */
+INTERNAL void z_bs_append(struct z_bitstream *bs, const unsigned int arg, const int length) {
+    const unsigned int mask = length < 32 ? (1U << length) - 1 : 0xFFFFFFFF;
+
+    bs->acc = (bs->acc << length) | (arg & mask);
+    bs->acc_bits += length;
+    bs->bp += length;
+    if (bs->acc_bits >= 32) {
+        unsigned char *const b = bs->buf + ((bs->bp - bs->acc_bits) >> 3);
+        const unsigned int word = (unsigned int) (bs->acc >> (bs->acc_bits - 32));
+        b[0] = (unsigned char) (word >> 24);
+        b[1] = (unsigned char) (word >> 16);
+        b[2] = (unsigned char) (word >> 8);
+        b[3] = (unsigned char) word;
+        bs->acc_bits -= 32;
+    }
+}
+
+/* Overwrite the `length` (0 to 32) bits of `bs` at `posn` (all previously appended) with the least significant bits
+   of `arg` */
+INTERNAL void z_bs_put(struct z_bitstream *bs, const unsigned int arg, const int length, const int posn) {
+    const int flushed = bs->bp - bs->acc_bits;
+    int i;
+
+    for (i = 0; i < length; i++) {
+        const int p = posn + i;
+        const unsigned int bit = (arg >> (length - 1 - i)) & 1;
+        if (p >= flushed) {
+            const int shift = bs->bp - 1 - p;
+            bs->acc = (bs->acc & ~((uint64_t) 1 << shift)) | ((uint64_t) bit << shift);
+        } else {
+            const unsigned char mask = (unsigned char) (0x80 >> (p & 0x07));
+            bs->buf[p >> 3] = bit ? bs->buf[p >> 3] | mask : bs->buf[p >> 3] & ~mask;
+        }
+    }
+}
+
+/* Write any unflushed bits of `bs` to its buffer, the last byte zero-padded. Appending may continue afterwards */
+INTERNAL void z_bs_flush(struct z_bitstream *bs) {
+    if (bs->acc_bits) {
+        unsigned char *const b = bs->buf + ((bs->bp - bs->acc_bits) >> 3);
+        /* Left-align to 32 bits */
+        const unsigned int word = (unsigned int) (bs->acc << (32 - bs->acc_bits));
+        int i;
+        for (i = 0; i < bs->acc_bits; i += 8) {
+            b[i >> 3] = (unsigned char) (word >> (24 - i));
+        }
+    }
+}
+
+/* Return the `length` (1 to 25) bits at `posn` of bitstream buffer `buf` (see `z_bs_bit()`) */
+INTERNAL unsigned int z_bs_get(const unsigned char buf[], const int posn, const int length) {
+    const int end = (posn & 0x07) + length; /* Bits needed from byte at `posn >> 3` */
+    const unsigned char *b = buf + (posn >> 3);
+    unsigned int word = 0;
+    int i;
+
+    for (i = 0; i < end; i += 8) {
+        word = (word << 8) | *b++;
+    }
+    return (word >> ((8 - (end & 0x07)) & 0x07)) & ((1U << length) - 1);
+}
+
+#ifdef Z_ATOMICS_WIN
+/* Return `*pp` (full barrier) */
+INTERNAL void *z_atomic_load_ptr_win(void *volatile *pp) {
+    return InterlockedCompareExchangePointer(pp, NULL, NULL);
+}
+
+/* Set `*pp` to `value` if it's `*p_old`, else set `*p_old` to `*pp`, returning 1 if set (full barrier) */
+INTERNAL int z_atomic_cas_ptr_win(void *volatile *pp, void **p_old, void *value) {
+    void *const prev = InterlockedCompareExchangePointer(pp, value, *p_old);
+    if (prev == *p_old) {
+        return 1;
+    }
+    *p_old = prev;
+    return 0;
+}
+#endif
+
+#ifdef ZINT_SMALL_STACK
+
+#if defined(_MSC_VER)
+#  define Z_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#  define Z_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__) || defined(__SUNPRO_C)
+#  define Z_THREAD_LOCAL __thread
+#else
+#  error "ZINT_SMALL_STACK requires thread-local storage"
+#endif
+
+#define Z_SCRATCH_BLOCK_SIZE    0x10000 /* Minimum size of a scratch arena block's data (64K) */
+
+/* Scratch arena block, its data following the header */
+struct z_scratch_block {
+    struct z_scratch_block *prev;
+    size_t base;    /* Arena position of the start of the block's data */
+    size_t size;    /* Size of the block's data */
+    size_t used;    /* Bytes of the block's data allocated */
+};
+
+#define Z_SCRATCH_HDR_SIZE      ((sizeof(struct z_scratch_block) + 15) & ~((size_t) 15))
+
+static Z_THREAD_LOCAL struct z_scratch_block *z_scratch_top;
+static Z_THREAD_LOCAL int z_scratch_depth;
+static Z_THREAD_LOCAL int z_scratch_fail; /* Set on allocation failure until outermost API call returns */
+
+#ifdef ZINT_TEST
+static int z_scratch_fail_at = 0; /* For testing `malloc()` failure */
+
+INTERNAL void zint_test_scratch_set_fail(const int at) {
+    z_scratch_fail_at = at;
+}
+#define z_scratch_malloc(sz)    (z_scratch_fail_at > 0 && --z_scratch_fail_at == 0 ? NULL : malloc(sz))
+#else
+#define z_scratch_malloc(sz)    malloc(sz)
+#endif
+
+/* Enter API call */
+INTERNAL void z_scratch_enter(void) {
+    if (z_scratch_depth++ == 0) {
+        z_scratch_fail = 0;
+    }
+}
+
+/* Leave API call, freeing the arena if outermost. Returns 1 if an allocation failed, 0 otherwise */
+INTERNAL int z_scratch_leave(void) {
+    const int fail = z_scratch_fail;
+    if (--z_scratch_depth <= 0) {
+        while (z_scratch_top) {
+            struct z_scratch_block *const prev = z_scratch_top->prev;
+            free(z_scratch_top);
+            z_scratch_top = prev;
+        }
+        z_scratch_depth = 0;
+        z_scratch_fail = 0;
+    }
+    return fail;
+}
+
+/* Whether a scratch arena allocation has failed in the current API call */
+INTERNAL int z_scratch_failed(void) {
+    return z_scratch_fail;
+}
+
+/* Allocate `size` bytes from the scratch arena, aligned to 16 bytes. Returns NULL on memory allocation failure, and
+   for all allocations after it until the outermost API call returns */
+INTERNAL void *z_scratch_alloc(const size_t size) {
+    struct z_scratch_block *blk = z_scratch_top;
+    const size_t aligned = (size + 15) & ~((size_t) 15);
+    unsigned char *p;
+
+    if (z_scratch_fail) {
+        return NULL;
+    }
+    if (!blk || blk->size - blk->used < aligned) {
+        const size_t data_size = aligned > Z_SCRATCH_BLOCK_SIZE ? aligned : Z_SCRATCH_BLOCK_SIZE;
+        if (!(blk = (struct z_scratch_block *) z_scratch_malloc(Z_SCRATCH_HDR_SIZE + data_size))) {
+            z_scratch_fail = 1;
+            return NULL;
+        }
+        blk->prev = z_scratch_top;
+        blk->base = z_scratch_top ? z_scratch_top->base + z_scratch_top->used : 0;
+        blk->size = data_size;
+        blk->used = 0;
+        z_scratch_top = blk;
+    }
+    p = (unsigned char *) blk + Z_SCRATCH_HDR_SIZE + blk->used;
+    blk->used += aligned;
+
+    return p;
+}
+
+/* Return current position of scratch arena, to pass to `z_scratch_release()` */
+INTERNAL size_t z_scratch_mark(void) {
+    return z_scratch_top ? z_scratch_top->base + z_scratch_top->used : 0;
+}
+
+/* Release all scratch arena allocations made since `mark` */
+INTERNAL void z_scratch_release(const size_t mark) {
+    while (z_scratch_top && z_scratch_top->base > mark) {
+        struct z_scratch_block *const prev = z_scratch_top->prev;
+        free(z_scratch_top);
+        z_scratch_top = prev;
+    }
+    if (z_scratch_top) {
+        z_scratch_top->used = mark - z_scratch_top->base;
+    }
+}
+
+#endif /* ZINT_SMALL_STACK */
+
 #ifndef Z_COMMON_INLINE
 
 /* Returns true (1) if a module is dark/black, otherwise false (0) */
@@ -1315,6 +1521,198 @@ INTERNAL int z_set_height(struct zint_symbol *symbol, const float min_row_height
 #define ZINT_NOINLINE
 #endif
 
+/* Current time in seconds from some arbitrary point, monotonic if available */
+static double stats_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart / (double) freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/* Record trace event for `phase` from `start` to `end` if ZINT_DEBUG_TRACE set & tracing started */
+static void stats_trace(struct zint_symbol *symbol, const int phase, const double start, const double end) {
+    struct zint_trace *const trace = symbol->trace;
+    struct zint_trace_event *event;
+
+    if (!trace || !(symbol->debug & ZINT_DEBUG_TRACE)) {
+        return;
+    }
+    if (trace->next == trace->size) {
+        const int new_size = trace->size ? trace->size * 2 : 256;
+        struct zint_trace_event *events = NULL;
+
+        if (trace->size < ZINT_TRACE_MAX && (events = (struct zint_trace_event *) realloc(trace->events,
+                                                        sizeof(struct zint_trace_event) * new_size))) {
+            trace->events = events;
+            trace->size = new_size;
+        } else if (trace->size) {
+            trace->next = 0; /* Wrap, overwriting oldest */
+        } else {
+            return; /* Best effort, dropping event */
+        }
+    }
+    event = trace->events + trace->next++;
+    event->ts = start;
+    event->dur = end - start;
+    event->phase = phase;
+    event->symbology = symbol->symbology;
+    event->length = trace->length;
+    if (phase >= ZINT_STATS_BUILD) {
+        event->rows = symbol->rows;
+        event->width = symbol->width;
+    } else {
+        event->rows = event->width = 0;
+    }
+    if (phase == ZINT_STATS_FILE || phase == ZINT_STATS_OUTPUT) {
+        event->bytes = (int) (symbol->stats.bytes_out - trace->bytes_mark);
+        if (phase == ZINT_STATS_OUTPUT) {
+            trace->bytes_mark = symbol->stats.bytes_out;
+        }
+    } else {
+        event->bytes = 0;
+    }
+    if (trace->used < trace->size) {
+        trace->used++;
+    }
+}
+
+/* Start tracing encode of `length` input if ZINT_DEBUG_TRACE set, allocating `symbol->trace` if necessary */
+INTERNAL void z_trace_start(struct zint_symbol *symbol, const int length) {
+    if (!(symbol->debug & ZINT_DEBUG_TRACE)) {
+        return;
+    }
+    if (!symbol->trace && !(symbol->trace = (struct zint_trace *) calloc(1, sizeof(struct zint_trace)))) {
+        return; /* Best effort, not tracing */
+    }
+    symbol->trace->length = length;
+    symbol->trace->bytes_mark = symbol->stats.bytes_out;
+}
+
+/* Free `symbol->trace` */
+INTERNAL void z_trace_free(struct zint_symbol *symbol) {
+    if (symbol->trace) {
+        free(symbol->trace->events);
+        free(symbol->trace);
+        symbol->trace = NULL;
+    }
+}
+
+/* If `ZBarcode_Encode_Delta()`, returns previous encode state if it matches, else NULL */
+INTERNAL struct zint_delta *z_delta_get(struct zint_symbol *symbol, const int version, const int ecc_level,
+                const int data_cw) {
+    struct zint_delta *const delta = symbol->delta;
+
+    if (delta && delta->armed && delta->symbology == symbol->symbology && delta->version == version
+            && delta->ecc_level == ecc_level && delta->data_cw == data_cw) {
+        return delta;
+    }
+    return NULL;
+}
+
+/* If `ZBarcode_Encode_Delta()`, invalidates previous encode state and returns `posns` buffer to fill in, else NULL */
+INTERNAL unsigned short *z_delta_posns(struct zint_symbol *symbol) {
+    if (symbol->delta && symbol->delta->armed) {
+        symbol->delta->symbology = 0;
+        return symbol->delta->posns;
+    }
+    return NULL;
+}
+
+/* If `ZBarcode_Encode_Delta()`, saves state of encode just done (with `posns` filled in) */
+INTERNAL void z_delta_save(struct zint_symbol *symbol, const int version, const int ecc_level, const int mask,
+                const unsigned char data[], const int data_cw, const unsigned char full[], const int total_cw) {
+    struct zint_delta *const delta = symbol->delta;
+
+    if (!delta || !delta->armed) {
+        return;
+    }
+    assert(total_cw <= Z_DELTA_MAX_CW);
+    assert(symbol->rows <= 200);
+
+    delta->symbology = symbol->symbology;
+    delta->version = version;
+    delta->ecc_level = ecc_level;
+    delta->mask = mask;
+    delta->data_cw = data_cw;
+    delta->total_cw = total_cw;
+    delta->rows = symbol->rows;
+    delta->width = symbol->width;
+    memcpy(delta->data, data, data_cw);
+    memcpy(delta->full, full, total_cw);
+    memcpy(delta->encoded_data, symbol->encoded_data, sizeof(symbol->encoded_data[0]) * symbol->rows);
+}
+
+/* Sets modules to those of previous encode `delta`, flipping those whose bits differ in `full`, and saves state */
+INTERNAL void z_delta_patch(struct zint_symbol *symbol, struct zint_delta *delta, const unsigned char data[],
+                const unsigned char full[]) {
+    int i, b;
+
+    for (i = 0; i < delta->total_cw; i++) {
+        const int diff = delta->full[i] ^ full[i];
+        if (diff) {
+            for (b = 0; b < 8; b++) {
+                if (diff & (0x80 >> b)) {
+                    const int posn = delta->posns[i * 8 + b];
+                    const int x = posn % delta->width;
+                    delta->encoded_data[posn / delta->width][x >> 3] ^= (unsigned char) (1 << (x & 0x07));
+                }
+            }
+            delta->full[i] = full[i];
+        }
+    }
+    memcpy(delta->data, data, delta->data_cw);
+    delta->patches++;
+
+    memcpy(symbol->encoded_data, delta->encoded_data, sizeof(symbol->encoded_data[0]) * delta->rows);
+    for (i = 0; i < delta->rows; i++) {
+        symbol->row_height[i] = 1;
+    }
+    symbol->rows = delta->rows;
+    symbol->width = delta->width;
+    symbol->height = (float) delta->rows;
+}
+
+/* Set the start of the current phase to the current time, allocating `symbol->trace` if necessary, returning it */
+INTERNAL double z_stats_mark(struct zint_symbol *symbol) {
+    const double now = stats_now();
+
+    if (!symbol->trace && !(symbol->trace = (struct zint_trace *) calloc(1, sizeof(struct zint_trace)))) {
+        return now; /* Best effort, laps not timed */
+    }
+    return symbol->trace->mark = now;
+}
+
+/* Add the time since the start of the current phase to `phase`, starting the next */
+INTERNAL void z_stats_lap(struct zint_symbol *symbol, const int phase) {
+    struct zint_trace *const trace = symbol->trace;
+    const double now = stats_now();
+
+    if (!trace) {
+        return; /* Not marked */
+    }
+    symbol->stats.time[phase] += now - trace->mark;
+    symbol->stats.count[phase]++;
+    stats_trace(symbol, phase, trace->mark, now);
+    trace->mark = now;
+}
+
+/* Add the time since `start` to `phase` */
+INTERNAL void z_stats_add(struct zint_symbol *symbol, const int phase, const double start) {
+    const double now = stats_now();
+
+    symbol->stats.time[phase] += now - start;
+    symbol->stats.count[phase]++;
+    stats_trace(symbol, phase, start, now);
+}
+
 /* Removes excess precision from floats - see https://stackoverflow.com/q/503436 */
 INTERNAL ZINT_NOINLINE float z_stripf(const float arg) {
     return *((volatile const float *) &arg);
@@ -1376,6 +1774,14 @@ INTERNAL char *z_debug_print_escape(const unsigned char *source, const int first
     return buf;
 }
 
+/* Helper for ZINT_DEBUG_PRINT to print the first `length` bits of bitstream buffer `buf` as "0"s and "1"s */
+INTERNAL void z_debug_print_bits(const unsigned char buf[], const int length) {
+    int i;
+    for (i = 0; i < length; i++) {
+        fputc('0' + z_bs_bit(buf, i), stdout);
+    }
+}
+
 #ifdef ZINT_TEST
 /* Suppress gcc warning null destination pointer [-Wformat-overflow=] false-positive */
 #if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 7
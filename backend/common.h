@@ -78,6 +78,36 @@ typedef unsigned __int64 uint64_t;
 
 /* End of "frontend/main.c" copy */
 
+/* If ZINT_SMALL_STACK defined (for use on threads with small stacks, e.g. fibers), `z_alloca()` and large local
+   arrays declared with `Z_LARGE_ARRAY()`/`Z_LARGE_ARRAY2()` are taken from a per-thread heap scratch arena instead
+   of the stack, released when the outermost API call returns (`Z_SCRATCH_ENTER()`/`Z_SCRATCH_LEAVE()`), or earlier
+   by functions called repeatedly, which declare `Z_SCRATCH_MARK(mark)` before their allocations and call
+   `Z_SCRATCH_RELEASE(mark)` before returning (error returns needn't bother). As these allocations can then fail,
+   a function making them must check `Z_SCRATCH_FAILED()` before using them and return (an error if it can),
+   callers checking it again after any call that may have returned early; `Z_SCRATCH_LEAVE()` gives the failure,
+   which the API call reports as ZINT_ERROR_MEMORY */
+#ifdef ZINT_SMALL_STACK
+#  undef z_alloca
+#  define z_alloca(nmemb)           z_scratch_alloc(nmemb)
+#  define Z_LARGE_ARRAY(type, name, nmemb) \
+        type *const name = (type *) z_scratch_alloc(sizeof(type) * (nmemb))
+#  define Z_LARGE_ARRAY2(type, name, nmemb1, nmemb2) \
+        type (*const name)[nmemb2] = (type (*)[nmemb2]) z_scratch_alloc(sizeof(type) * (nmemb1) * (nmemb2))
+#  define Z_SCRATCH_ENTER()         z_scratch_enter()
+#  define Z_SCRATCH_LEAVE()         z_scratch_leave()
+#  define Z_SCRATCH_FAILED()        z_scratch_failed()
+#  define Z_SCRATCH_MARK(m)         const size_t m = z_scratch_mark()
+#  define Z_SCRATCH_RELEASE(m)      z_scratch_release(m)
+#else
+#  define Z_LARGE_ARRAY(type, name, nmemb)              type name[nmemb]
+#  define Z_LARGE_ARRAY2(type, name, nmemb1, nmemb2)    type name[nmemb1][nmemb2]
+#  define Z_SCRATCH_ENTER()         ((void) 0)
+#  define Z_SCRATCH_LEAVE()         0
+#  define Z_SCRATCH_FAILED()        0
+#  define Z_SCRATCH_MARK(m)         const size_t m = 0
+#  define Z_SCRATCH_RELEASE(m)      ((void) (m))
+#endif
+
 #ifdef _MSC_VER
 #  pragma warning(disable: 4125) /* decimal digit terminates octal escape sequence */
 #  pragma warning(disable: 4244) /* conversion from int to float */
@@ -138,6 +168,21 @@ typedef unsigned __int64 uint64_t;
 #define Z_NO_VSNPRINTF
 #endif
 
+/* Lock-free pointer atomics for write-once static caches. `z_atomic_load_ptr(pp)` returns `*pp` (acquire),
+   `z_atomic_cas_ptr(pp, old, new)` sets `*pp` to `new` if it's `old` (release), else sets lvalue `old` to `*pp`,
+   returning non-zero if set. `Z_HAVE_ATOMICS` not defined if unavailable */
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+#  define Z_HAVE_ATOMICS
+#  define z_atomic_load_ptr(pp)             __atomic_load_n(pp, __ATOMIC_ACQUIRE)
+#  define z_atomic_cas_ptr(pp, old, new) \
+            __atomic_compare_exchange_n(pp, &(old), new, 0, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE)
+#elif defined(_WIN32)
+#  define Z_HAVE_ATOMICS
+#  define Z_ATOMICS_WIN /* Implemented in "common.c" */
+#  define z_atomic_load_ptr(pp)             z_atomic_load_ptr_win((void *volatile *) (pp))
+#  define z_atomic_cas_ptr(pp, old, new)    z_atomic_cas_ptr_win((void *volatile *) (pp), (void **) &(old), new)
+#endif
+
 /* Is float integral value? (https://stackoverflow.com/a/40404149) */
 #define z_isfintf(arg) (fmodf(arg, 1.0f) == 0.0f)
 
@@ -219,6 +264,68 @@ INTERNAL int z_posn(const char set_string[], const char data);
   `bin_posn`. Returns `bin_posn` + `length` */
 INTERNAL int z_bin_append_posn(const int arg, const int length, char *binary, const int bin_posn);
 
+/* Packed bitstream writer - bits are appended MSB first to a 64-bit accumulator, which is flushed to `buf` 32 bits
+   at a time, so `buf` holds 8 bits per byte rather than the 1 of `z_bin_append_posn()` */
+struct z_bitstream {
+    unsigned char *buf;     /* Output, must be at least `Z_BS_SIZE(bits)` bytes */
+    uint64_t acc;           /* Bits not yet flushed, the last `acc_bits` significant */
+    int acc_bits;           /* Number of bits not yet flushed, less than 32 */
+    int bp;                 /* Number of bits appended */
+};
+
+/* Size in bytes of a `z_bitstream` buffer able to hold `bits` bits */
+#define Z_BS_SIZE(bits)         ((((bits) + 31) >> 5) << 2)
+
+/* Bit at `posn` of bitstream buffer `buf` (once `z_bs_flush()`ed if `posn` appended since last flush) */
+#define z_bs_bit(buf, posn)     (((buf)[(posn) >> 3] >> (7 - ((posn) & 0x07))) & 1)
+
+/* Initialize bitstream `bs` to write to `buf` */
+INTERNAL void z_bs_init(struct z_bitstream *bs, unsigned char *buf);
+
+/* Append the `length` (0 to 32) least significant bits of `arg` to `bs` */
+INTERNAL void z_bs_append(struct z_bitstream *bs, const unsigned int arg, const int length);
+
+/* Overwrite the `length` (0 to 32) bits of `bs` at `posn` (all previously appended) with the least significant bits
+   of `arg` */
+INTERNAL void z_bs_put(struct z_bitstream *bs, const unsigned int arg, const int length, const int posn);
+
+/* Write any unflushed bits of `bs` to its buffer, the last byte zero-padded. Appending may continue afterwards */
+INTERNAL void z_bs_flush(struct z_bitstream *bs);
+
+/* Return the `length` (1 to 25) bits at `posn` of bitstream buffer `buf` (see `z_bs_bit()`) */
+INTERNAL unsigned int z_bs_get(const unsigned char buf[], const int posn, const int length);
+
+#ifdef Z_ATOMICS_WIN
+/* Windows versions of `z_atomic_load_ptr()` & `z_atomic_cas_ptr()` (see above) */
+INTERNAL void *z_atomic_load_ptr_win(void *volatile *pp);
+INTERNAL int z_atomic_cas_ptr_win(void *volatile *pp, void **p_old, void *value);
+#endif
+
+#ifdef ZINT_SMALL_STACK
+/* Scratch arena (see ZINT_SMALL_STACK above) - enter/leave API call, nesting allowed. Leave returns 1 if an
+   allocation failed, 0 otherwise */
+INTERNAL void z_scratch_enter(void);
+INTERNAL int z_scratch_leave(void);
+
+/* Whether a scratch arena allocation has failed in the current API call */
+INTERNAL int z_scratch_failed(void);
+
+/* Allocate `size` bytes from the scratch arena, aligned to 16 bytes. Returns NULL on memory allocation failure, and
+   for all allocations after it until the outermost API call returns */
+INTERNAL void *z_scratch_alloc(const size_t size);
+
+/* Return current position of scratch arena, to pass to `z_scratch_release()` */
+INTERNAL size_t z_scratch_mark(void);
+
+/* Release all scratch arena allocations made since `mark` */
+INTERNAL void z_scratch_release(const size_t mark);
+
+#ifdef ZINT_TEST
+/* For testing scratch arena block `malloc()` failure, failing the `at`th one (0 to disable) */
+INTERNAL void zint_test_scratch_set_fail(const int at);
+#endif
+#endif
+
 #define Z_COMMON_INLINE   1
 
 #ifdef Z_COMMON_INLINE
@@ -404,6 +511,83 @@ INTERNAL int z_set_height(struct zint_symbol *symbol, const float min_row_height
                 const float max_height, const int no_errtxt);
 
 
+/* Per-phase stats, accumulated if ZINT_DEBUG_STATS or ZINT_DEBUG_TRACE set (unless ZINT_NO_STATS defined) */
+#ifdef ZINT_NO_STATS
+#define Z_STATS_ON(symbol) 0
+#else
+#define Z_STATS_ON(symbol) ((symbol)->debug & (ZINT_DEBUG_STATS | ZINT_DEBUG_TRACE))
+#endif
+/* Start timing phases, returning start time for use with `Z_STATS_ADD()` (0 if stats off) */
+#define Z_STATS_MARK(symbol) (Z_STATS_ON(symbol) ? z_stats_mark(symbol) : 0.0)
+/* End the current phase as `phase`, starting the next */
+#define Z_STATS_LAP(symbol, phase) do { if (Z_STATS_ON(symbol)) z_stats_lap(symbol, phase); } while (0)
+/* Add the time since `start` (from `Z_STATS_MARK()`) to `phase` */
+#define Z_STATS_ADD(symbol, phase, start) do { if (Z_STATS_ON(symbol)) z_stats_add(symbol, phase, start); } while (0)
+
+/* Set the start of the current phase to the current time, allocating `symbol->trace` if necessary, returning it */
+INTERNAL double z_stats_mark(struct zint_symbol *symbol);
+
+/* Add the time since the start of the current phase to `phase`, starting the next */
+INTERNAL void z_stats_lap(struct zint_symbol *symbol, const int phase);
+
+/* Add the time since `start` to `phase` */
+INTERNAL void z_stats_add(struct zint_symbol *symbol, const int phase, const double start);
+
+/* Stats state & trace events ring buffer (`symbol->trace`), the events recorded by `z_stats_lap()` &
+   `z_stats_add()` if ZINT_DEBUG_TRACE */
+struct zint_trace {
+    struct zint_trace_event *events; /* Allocated on first event, growing to ZINT_TRACE_MAX */
+    int size;           /* Allocated size of `events` */
+    int used;           /* Number of `events` in use */
+    int next;           /* Index of next event to write (wraps once `size` is ZINT_TRACE_MAX) */
+    int length;         /* Input length of current encode */
+    double bytes_mark;  /* `stats.bytes_out` at end of previous output */
+    double mark;        /* Start of current phase */
+};
+
+/* Start tracing encode of `length` input if ZINT_DEBUG_TRACE set, allocating `symbol->trace` if necessary */
+INTERNAL void z_trace_start(struct zint_symbol *symbol, const int length);
+
+/* Free `symbol->trace` */
+INTERNAL void z_trace_free(struct zint_symbol *symbol);
+
+
+#define Z_DELTA_MAX_CW  3706    /* Maximum total codewords (QR Code version 40) */
+
+/* Previous encode state (`symbol->delta`) used by `ZBarcode_Encode_Delta()` to patch rather than re-encode */
+struct zint_delta {
+    int armed;          /* Set during `ZBarcode_Encode_Delta()` */
+    int symbology;      /* Symbology of previous encode, 0 if none */
+    int version;        /* Symbol size of previous encode */
+    int ecc_level;      /* Symbology-specific ECC level/variant of previous encode */
+    int mask;           /* Mask of previous encode, if any */
+    int data_cw;        /* Number of data codewords */
+    int total_cw;       /* Number of data + ECC codewords */
+    int rows;
+    int width;
+    int patches;        /* Number of encodes done by patching (for testing) */
+    unsigned char data[Z_DELTA_MAX_CW]; /* Data codewords (in block order) */
+    unsigned char full[Z_DELTA_MAX_CW]; /* Data + ECC codewords (in placement order) */
+    unsigned short posns[Z_DELTA_MAX_CW * 8]; /* Module `row * width + column` of each bit of `full`, MSB first */
+    unsigned char encoded_data[200][144]; /* Modules */
+};
+
+/* If `ZBarcode_Encode_Delta()`, returns previous encode state if it matches, else NULL */
+INTERNAL struct zint_delta *z_delta_get(struct zint_symbol *symbol, const int version, const int ecc_level,
+                const int data_cw);
+
+/* If `ZBarcode_Encode_Delta()`, invalidates previous encode state and returns `posns` buffer to fill in, else NULL */
+INTERNAL unsigned short *z_delta_posns(struct zint_symbol *symbol);
+
+/* If `ZBarcode_Encode_Delta()`, saves state of encode just done (with `posns` filled in) */
+INTERNAL void z_delta_save(struct zint_symbol *symbol, const int version, const int ecc_level, const int mask,
+                const unsigned char data[], const int data_cw, const unsigned char full[], const int total_cw);
+
+/* Sets modules to those of previous encode `delta`, flipping those whose bits differ in `full`, and saves state */
+INTERNAL void z_delta_patch(struct zint_symbol *symbol, struct zint_delta *delta, const unsigned char data[],
+                const unsigned char full[]);
+
+
 /* Removes excess precision from floats - see https://stackoverflow.com/q/503436 */
 INTERNAL float z_stripf(const float arg);
 
@@ -420,6 +604,9 @@ INTERNAL void z_segs_cpy(const struct zint_symbol *symbol, const struct zint_seg
    stdout */
 INTERNAL char *z_debug_print_escape(const unsigned char *source, const int first_len, char *buf);
 
+/* Helper for ZINT_DEBUG_PRINT to print the first `length` bits of bitstream buffer `buf` as "0"s and "1"s */
+INTERNAL void z_debug_print_bits(const unsigned char buf[], const int length);
+
 #ifdef ZINT_TEST
 /* Dumps hex-formatted codewords in symbol->errtxt (for use in testing) */
 INTERNAL void z_debug_test_codeword_dump(struct zint_symbol *symbol, const unsigned char *codewords,
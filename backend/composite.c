@@ -272,6 +272,10 @@ static void cc_b(struct zint_symbol *symbol, const char source[], const int cc_w
 #endif
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
+
     for (i = 0; i < length; i++) {
         const int binloc = i * 8;
         int p;
@@ -332,6 +336,10 @@ static void cc_c(struct zint_symbol *symbol, const char source[], const int cc_w
     int bp = 0;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
+
     for (i = 0; i < length; i++) {
         const int binloc = i * 8;
         int p;
@@ -558,6 +566,10 @@ static int cc_binary_string(struct zint_symbol *symbol, const unsigned char sour
     int bp = 0;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     encoding_method = 1;
     read_posn = 0;
     ai_crop = 0;
@@ -633,6 +645,10 @@ static int cc_binary_string(struct zint_symbol *symbol, const unsigned char sour
         unsigned char *ninety = (unsigned char *) z_alloca(length + 1);
         int ninety_len, alpha, alphanum, numeric, alpha_posn;
 
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
+
         /* "This encodation method may be used if an element string with an AI
         90 occurs at the start of the data message, and if the data field
         following the two-digit AI 90 starts with an alphanumeric string which
@@ -907,19 +923,25 @@ static int cc_binary_string(struct zint_symbol *symbol, const unsigned char sour
 
 /* Calculate the width of the linear part (primary) */
 static int cc_linear_dummy_run(struct zint_symbol *symbol, unsigned char *source, int length) {
-    struct zint_symbol dummy = {0};
+    Z_LARGE_ARRAY(struct zint_symbol, dummy, 1);
     int error_number;
     int linear_width;
 
-    dummy.symbology = BARCODE_GS1_128_CC;
-    dummy.option_1 = -1;
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
+    memset(dummy, 0, sizeof(struct zint_symbol));
+
+    dummy->symbology = BARCODE_GS1_128_CC;
+    dummy->option_1 = -1;
     /* Verified later via `linear` symbol (unless GS1SYNTAXENGINE_MODE, when already verified) */
-    dummy.input_mode = symbol->input_mode | GS1NOCHECK_MODE;
-    dummy.debug = symbol->debug;
-    error_number = zint_gs1_128_cc(&dummy, source, length, 3 /*cc_mode*/, 0 /*cc_rows*/);
-    linear_width = dummy.width;
+    dummy->input_mode = symbol->input_mode | GS1NOCHECK_MODE;
+    dummy->debug = symbol->debug;
+    error_number = zint_gs1_128_cc(dummy, source, length, 3 /*cc_mode*/, 0 /*cc_rows*/);
+    linear_width = dummy->width;
     if (error_number >= ZINT_ERROR || (symbol->debug & ZINT_DEBUG_TEST)) {
-        (void) z_errtxt(0, symbol, -1, dummy.errtxt);
+        (void) z_errtxt(0, symbol, -1, dummy->errtxt);
     }
 
     if (error_number >= ZINT_ERROR) {
@@ -942,6 +964,10 @@ INTERNAL int zint_composite(struct zint_symbol *symbol, unsigned char source[],
     const int content_segs = symbol->output_options & BARCODE_CONTENT_SEGS;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (debug_print) printf("Reduced length: %d\n", length);
 
     /* Hack to initialize `warn_number` to warning (if any) returned by `zint_gs1_verify()` */
@@ -974,6 +1000,9 @@ INTERNAL int zint_composite(struct zint_symbol *symbol, unsigned char source[],
         /* Do a test run of encoding the linear component to establish its width */
         linear_width = cc_linear_dummy_run(symbol, ZUCP(symbol->primary), primary_len);
         if (linear_width == 0) { /* Only catches `GS1NOCHECK_MODE` errors */
+            if (Z_SCRATCH_FAILED()) {
+                return ZINT_ERROR_MEMORY;
+            }
             return z_errtxt_adj(ZINT_ERROR_INVALID_DATA, symbol, "%1$s%2$s", " (linear component)");
         }
         if (debug_print) {
@@ -1076,6 +1105,9 @@ INTERNAL int zint_composite(struct zint_symbol *symbol, unsigned char source[],
         case 2: cc_b(symbol, binary_string, cc_width); break;
         case 3: cc_c(symbol, binary_string, cc_width, ecc); break;
     }
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     if (warn_number == 0 && symbol->option_1 >= 1 && symbol->option_1 <= 3 && symbol->option_1 != cc_mode) {
         warn_number = ZEXT z_errtxtf(ZINT_WARN_INVALID_OPTION, symbol, 443,
@@ -46,8 +46,13 @@
 #include "reedsol.h"
 #include "dmatrix.h"
 
+#if defined(Z_HAVE_ATOMICS) && !defined(ZINT_NO_DM_CACHE)
+#define DM_CACHE
+#endif
+
 /* Annex F placement algorithm low level */
-static void dm_placementbit(int *array, const int NR, const int NC, int r, int c, const int p, const char b) {
+static void dm_placementbit(unsigned short *array, const int NR, const int NC, int r, int c, const int p,
+            const char b) {
     if (r < 0) {
         r += NR;
         c += 4 - ((NR + 4) % 8);
@@ -65,10 +70,10 @@ static void dm_placementbit(int *array, const int NR, const int NC, int r, int c
     assert(c < NC);
     /* Check double-assignment */
     assert(0 == array[r * NC + c]);
-    array[r * NC + c] = (p << 3) + b;
+    array[r * NC + c] = (unsigned short) ((p << 3) + b);
 }
 
-static void dm_placementblock(int *array, const int NR, const int NC, const int r,
+static void dm_placementblock(unsigned short *array, const int NR, const int NC, const int r,
         const int c, const int p) {
     dm_placementbit(array, NR, NC, r - 2, c - 2, p, 7);
     dm_placementbit(array, NR, NC, r - 2, c - 1, p, 6);
@@ -80,7 +85,7 @@ static void dm_placementblock(int *array, const int NR, const int NC, const int
     dm_placementbit(array, NR, NC, r - 0, c - 0, p, 0);
 }
 
-static void dm_placementcornerA(int *array, const int NR, const int NC, const int p) {
+static void dm_placementcornerA(unsigned short *array, const int NR, const int NC, const int p) {
     dm_placementbit(array, NR, NC, NR - 1, 0, p, 7);
     dm_placementbit(array, NR, NC, NR - 1, 1, p, 6);
     dm_placementbit(array, NR, NC, NR - 1, 2, p, 5);
@@ -91,7 +96,7 @@ static void dm_placementcornerA(int *array, const int NR, const int NC, const in
     dm_placementbit(array, NR, NC, 3, NC - 1, p, 0);
 }
 
-static void dm_placementcornerB(int *array, const int NR, const int NC, const int p) {
+static void dm_placementcornerB(unsigned short *array, const int NR, const int NC, const int p) {
     dm_placementbit(array, NR, NC, NR - 3, 0, p, 7);
     dm_placementbit(array, NR, NC, NR - 2, 0, p, 6);
     dm_placementbit(array, NR, NC, NR - 1, 0, p, 5);
@@ -102,7 +107,7 @@ static void dm_placementcornerB(int *array, const int NR, const int NC, const in
     dm_placementbit(array, NR, NC, 1, NC - 1, p, 0);
 }
 
-static void dm_placementcornerC(int *array, const int NR, const int NC, const int p) {
+static void dm_placementcornerC(unsigned short *array, const int NR, const int NC, const int p) {
     dm_placementbit(array, NR, NC, NR - 3, 0, p, 7);
     dm_placementbit(array, NR, NC, NR - 2, 0, p, 6);
     dm_placementbit(array, NR, NC, NR - 1, 0, p, 5);
@@ -113,7 +118,7 @@ static void dm_placementcornerC(int *array, const int NR, const int NC, const in
     dm_placementbit(array, NR, NC, 3, NC - 1, p, 0);
 }
 
-static void dm_placementcornerD(int *array, const int NR, const int NC, const int p) {
+static void dm_placementcornerD(unsigned short *array, const int NR, const int NC, const int p) {
     dm_placementbit(array, NR, NC, NR - 1, 0, p, 7);
     dm_placementbit(array, NR, NC, NR - 1, NC - 1, p, 6);
     dm_placementbit(array, NR, NC, 0, NC - 3, p, 5);
@@ -125,7 +130,7 @@ static void dm_placementcornerD(int *array, const int NR, const int NC, const in
 }
 
 /* Annex F placement algorithm main function */
-static void dm_placement(int *array, const int NR, const int NC) {
+static void dm_placement(unsigned short *array, const int NR, const int NC) {
     int r, c, p;
     /* start */
     p = 1;
@@ -165,8 +170,48 @@ static void dm_placement(int *array, const int NR, const int NC) {
         array[NR * NC - 1] = array[NR * NC - NC - 2] = 1;
 }
 
-/* calculate and append ecc code, and if necessary interleave */
-static void dm_ecc(unsigned char *binary, const int bytes, const int datablock, const int rsblock, const int skew) {
+#ifdef DM_CACHE
+/* Placement maps by symbol size, generated on first use, published with compare-and-swap and never freed */
+static unsigned short *dm_places_cache[DMSIZESCOUNT];
+#endif
+
+/* Return the placement map of `symbolsize` (`NR` x `NC`, each entry being codeword no. (1-based) << 3 plus bit
+   no., or 1 for the fixed dark module of an unfilled corner), setting `*p_free` if the caller must free it.
+   The map depends only on the symbol size so is cached (unless ZINT_NO_DM_CACHE defined or atomics unavailable).
+   Returns NULL on memory allocation failure */
+static const unsigned short *dm_get_places(const int symbolsize, const int NR, const int NC, int *p_free) {
+    unsigned short *places;
+#ifdef DM_CACHE
+    unsigned short *expected = NULL;
+
+    if ((places = (unsigned short *) z_atomic_load_ptr(&dm_places_cache[symbolsize]))) {
+        *p_free = 0;
+        return places;
+    }
+#else
+    (void) symbolsize;
+#endif
+    if (!(places = (unsigned short *) calloc((size_t) NC * (size_t) NR, sizeof(unsigned short)))) {
+        return NULL;
+    }
+    dm_placement(places, NR, NC);
+#ifdef DM_CACHE
+    if (!z_atomic_cas_ptr(&dm_places_cache[symbolsize], expected, places)) {
+        /* Another thread beat us to it - use theirs */
+        free(places);
+        places = expected;
+    }
+    *p_free = 0;
+#else
+    *p_free = 1;
+#endif
+    return places;
+}
+
+/* calculate and append ecc code, and if necessary interleave. If `prev` given, the ecc is updated from that of
+   `prev` (see `zint_rs_encode_delta()`) */
+static void dm_ecc(unsigned char *binary, const int bytes, const int datablock, const int rsblock, const int skew,
+            const unsigned char *prev) {
     int blocks = (bytes + 2) / datablock, b;
     int rsblocks = rsblock * blocks;
     int n;
@@ -176,25 +221,26 @@ static void dm_ecc(unsigned char *binary, const int bytes, const int datablock,
     zint_rs_init_code(&rs, rsblock, 1);
     for (b = 0; b < blocks; b++) {
         unsigned char buf[256], ecc[256];
+        /* Rotate ecc data to make 144x144 size symbols acceptable */
+        /* See http://groups.google.com/group/postscriptbarcode/msg/5ae8fda7757477da
+           or https://github.com/nu-book/zxing-cpp/issues/259 */
+        const int ecc_posn = skew ? (b < 8 ? bytes + 2 : bytes - 8) : bytes;
         int p = 0;
         for (n = b; n < bytes; n += blocks)
             buf[p++] = binary[n];
-        zint_rs_encode(&rs, p, buf, ecc);
-        if (skew) {
-            /* Rotate ecc data to make 144x144 size symbols acceptable */
-            /* See http://groups.google.com/group/postscriptbarcode/msg/5ae8fda7757477da
-               or https://github.com/nu-book/zxing-cpp/issues/259 */
-            for (n = b, p = 0; n < rsblocks; n += blocks, p++) {
-                if (b < 8) {
-                    binary[bytes + n + 2] = ecc[p];
-                } else {
-                    binary[bytes + n - 8] = ecc[p];
-                }
-            }
+        if (prev) {
+            unsigned char prev_buf[256];
+            const int datalen = p;
+            for (n = b, p = 0; n < bytes; n += blocks)
+                prev_buf[p++] = prev[n];
+            for (n = b, p = 0; n < rsblocks; n += blocks, p++)
+                ecc[p] = prev[ecc_posn + n];
+            zint_rs_encode_delta(&rs, datalen, buf, prev_buf, ecc);
         } else {
-            for (n = b, p = 0; n < rsblocks; n += blocks, p++) {
-                binary[bytes + n] = ecc[p];
-            }
+            zint_rs_encode(&rs, p, buf, ecc);
+        }
+        for (n = b, p = 0; n < rsblocks; n += blocks, p++) {
+            binary[ecc_posn + n] = ecc[p];
         }
     }
 }
@@ -594,8 +640,9 @@ static int dm_get_symbolsize(struct zint_symbol *symbol, const int minimum) {
     }
     for (i = minimum >= 62 ? 23 : 0; minimum > dm_matrixbytes[i]; i++);
 
-    /* `DM_DMRE` trumps `DM_SQUARE` */
-    if ((symbol->option_3 & DM_SQUARE_DMRE_MASK) == DM_DMRE) {
+    /* `DM_DMRE` trumps `DM_SQUARE`, `DM_BEST_FIT` (see `dm_best_fit()`) starts from smallest of all */
+    if ((symbol->option_3 & DM_SQUARE_DMRE_MASK) == DM_DMRE
+            || (symbol->option_3 & DM_SQUARE_DMRE_MASK) == DM_BEST_FIT) {
         return i;
     }
     if ((symbol->option_3 & DM_SQUARE_DMRE_MASK) == DM_SQUARE) {
@@ -692,21 +739,35 @@ static int dm_switch_mode(const int next_mode, unsigned char target[], int tp, i
 
 static const char dm_smodes[DM_NUM_MODES + 1][6] = { "?", "ASCII", "C40", "TEXT", "X12", "EDF", "B256" };
 
-/* The size of this structure could be significantly reduced using techniques pointed out by Alex Geller,
-   but not done currently to avoid the processing overhead */
+/* Edges are only kept in full for a rolling frontier of vertices (see `struct dm_frontier` below), previous
+   edges being recorded as 1-byte back-pointers per vertex and end mode (see `DM_BACK()`) */
 struct dm_edge {
     unsigned char mode;
     unsigned char endMode; /* Mode returned by `dm_getEndMode()` */
+    unsigned char previous; /* `endMode` of previous edge, 0 if none */
     unsigned short from; /* Position in input data, 0-based */
     unsigned short len;
     unsigned short size; /* Cumulative number of codewords */
     unsigned short bytes; /* DM_BASE256 byte count, kept to avoid runtime calc */
-    unsigned short previous; /* Index into edges array */
 };
 
-/* Note 1st row of edges not used so valid previous cannot point there, i.e. won't be zero */
-#define DM_PREVIOUS(edges, edge) \
-    ((edge)->previous ? (edges) + (edge)->previous : NULL)
+#define DM_RING_SIZE        8 /* Power of 2 greater than maximum non-C40/TEXT edge length 4 */
+#define DM_RING_MASK        (DM_RING_SIZE - 1)
+#define DM_PENDING_MAX      6 /* At most 3 C40 and 3 TEXT batch runs can overlap any position */
+#define DM_BACK_LONG        16 /* C40/TEXT edges this long or longer have length 0 in back-pointer */
+
+/* Edges ending at vertices `i` to `i + DM_RING_SIZE - 1` while processing vertex `i`, with the rare C40/TEXT edges
+   reaching further held in `pending` */
+struct dm_frontier {
+    struct dm_edge ring[DM_RING_SIZE][DM_NUM_MODES];
+    struct dm_edge pending[DM_PENDING_MAX];
+    int pending_cnt;
+};
+
+/* Back-pointer of edge: previous edge's end mode in bits 0-2, whether EDIFACT ending in ASCII in bit 3 (so mode
+   differs from end mode), and length in bits 4-7 if less than `DM_BACK_LONG` */
+#define DM_BACK(edge) ((edge)->previous | (((edge)->mode != (edge)->endMode) << 3) \
+                        | ((edge)->len < DM_BACK_LONG ? (edge)->len << 4 : 0))
 
 /* Determine if next 1 to 4 chars are at EOD and can be encoded as 1 or 2 ASCII codewords */
 static int dm_last_ascii(const unsigned char source[], const int length, const int from) {
@@ -771,7 +832,7 @@ static int dm_getEndMode(struct zint_symbol *symbol, const unsigned char *source
 #else
 #define DM_TRACE_Edges(px, s, l, p, v)
 #define DM_TRACE_AddEdge(s, l, es, p, v, e)
-#define DM_TRACE_NotAddEdge(s, l, es, p, v, ij, e)
+#define DM_TRACE_NotAddEdge(s, l, es, p, v, e)
 #endif
 
 /* Return number of C40/TEXT codewords needed to encode characters in full batches of 3 (or less if EOD).
@@ -807,8 +868,8 @@ static int dm_getNumberOfC40Words(const unsigned char *source, const int length,
 
 /* Initialize a new edge. Returns endMode */
 static int dm_new_Edge(struct zint_symbol *symbol, const unsigned char *source, const int length, const int last_seg,
-            struct dm_edge *edges, const int mode, const int from, const int len, struct dm_edge *previous,
-            struct dm_edge *edge, const int cwds) {
+            const int mode, const int from, const int len, const struct dm_edge *previous, struct dm_edge *edge,
+            const int cwds) {
     int previousMode;
     int size;
 
@@ -820,7 +881,7 @@ static int dm_new_Edge(struct zint_symbol *symbol, const unsigned char *source,
     if (previous) {
         assert(previous->mode && previous->len && previous->size && previous->endMode);
         previousMode = previous->endMode;
-        edge->previous = previous - edges;
+        edge->previous = previousMode;
         size = previous->size;
     } else {
         previousMode = DM_ASCII;
@@ -917,24 +978,59 @@ static int dm_new_Edge(struct zint_symbol *symbol, const unsigned char *source,
 
 /* Add an edge for a mode at a vertex if no existing edge or if more optimal than existing edge */
 static void dm_addEdge(struct zint_symbol *symbol, const unsigned char *source, const int length, const int last_seg,
-            struct dm_edge *edges, const int mode, const int from, const int len, struct dm_edge *previous,
+            struct dm_frontier *fr, const int mode, const int from, const int len, const struct dm_edge *previous,
             const int cwds) {
     struct dm_edge edge;
-    const int endMode = dm_new_Edge(symbol, source, length, last_seg, edges, mode, from, len, previous, &edge, cwds);
+    const int endMode = dm_new_Edge(symbol, source, length, last_seg, mode, from, len, previous, &edge, cwds);
     const int vertexIndex = from + len;
-    const int v_ij = vertexIndex * DM_NUM_MODES + endMode - 1;
+    struct dm_edge *v_edge;
+
+    if (len < DM_RING_SIZE) {
+        v_edge = &fr->ring[vertexIndex & DM_RING_MASK][endMode - 1];
+    } else {
+        int i;
+        for (i = 0; i < fr->pending_cnt; i++) {
+            if (fr->pending[i].from + fr->pending[i].len == vertexIndex && fr->pending[i].endMode == endMode) {
+                break;
+            }
+        }
+        if (i == fr->pending_cnt) {
+            assert(i < DM_PENDING_MAX);
+            fr->pending_cnt++;
+            fr->pending[i].mode = 0;
+        }
+        v_edge = &fr->pending[i];
+    }
 
-    if (edges[v_ij].mode == 0 || edges[v_ij].size > edge.size) {
-        DM_TRACE_AddEdge(source, length, edges, previous, vertexIndex, &edge);
-        edges[v_ij] = edge;
+    if (v_edge->mode == 0 || v_edge->size > edge.size) {
+        DM_TRACE_AddEdge(source, length, v_edge, previous, vertexIndex, &edge);
+        *v_edge = edge;
     } else {
-        DM_TRACE_NotAddEdge(source, length, edges, previous, vertexIndex, v_ij, &edge);
+        DM_TRACE_NotAddEdge(source, length, v_edge, previous, vertexIndex, &edge);
+    }
+}
+
+/* Move any pending edges ending at `vertexIndex` into the ring, ahead of ring edges as added earlier */
+static void dm_mergePending(struct dm_frontier *fr, const int vertexIndex) {
+    int i;
+
+    for (i = 0; i < fr->pending_cnt; i++) {
+        const struct dm_edge *const p_edge = &fr->pending[i];
+        if (p_edge->from + p_edge->len == vertexIndex) {
+            struct dm_edge *const v_edge = &fr->ring[vertexIndex & DM_RING_MASK][p_edge->endMode - 1];
+            if (v_edge->mode == 0 || v_edge->size >= p_edge->size) {
+                *v_edge = *p_edge;
+            }
+            fr->pending[i] = fr->pending[--fr->pending_cnt];
+            i--;
+        }
     }
 }
 
 /* Add edges for the various modes at a vertex */
 static void dm_addEdges(struct zint_symbol *symbol, const unsigned char source[], const int length,
-            const int last_seg, struct dm_edge *edges, const int from, struct dm_edge *previous, const char *fncs) {
+            const int last_seg, struct dm_frontier *fr, const int from, const struct dm_edge *previous,
+            const char *fncs) {
     int i, pos;
 
     assert(from < length); /* Suppress clang-tidy-21 clang-analyzer-security.ArrayBound */
@@ -945,29 +1041,29 @@ static void dm_addEdges(struct zint_symbol *symbol, const unsigned char source[]
         static const char c40text_modes[] = { DM_C40, DM_TEXT };
 
         if (z_isdigit(source[from]) && from + 1 < length && z_isdigit(source[from + 1])) {
-            dm_addEdge(symbol, source, length, last_seg, edges, DM_ASCII, from, 2, previous, 0);
+            dm_addEdge(symbol, source, length, last_seg, fr, DM_ASCII, from, 2, previous, 0);
             /* If ASCII vertex, don't bother adding other edges as this will be optimal; suggested by Alex Geller */
             if (previous && previous->mode == DM_ASCII) {
                 return;
             }
         } else {
-            dm_addEdge(symbol, source, length, last_seg, edges, DM_ASCII, from, 1, previous, 0);
+            dm_addEdge(symbol, source, length, last_seg, fr, DM_ASCII, from, 1, previous, 0);
         }
 
         for (i = 0; i < ARRAY_SIZE(c40text_modes); i++) {
             int len;
             int cwds = dm_getNumberOfC40Words(source, length, from, c40text_modes[i], &len);
             if (cwds) {
-                dm_addEdge(symbol, source, length, last_seg, edges, c40text_modes[i], from, len, previous, cwds);
+                dm_addEdge(symbol, source, length, last_seg, fr, c40text_modes[i], from, len, previous, cwds);
             }
         }
 
         if (from + 2 < length && dm_isX12(source[from]) && dm_isX12(source[from + 1]) && dm_isX12(source[from + 2])) {
-            dm_addEdge(symbol, source, length, last_seg, edges, DM_X12, from, 3, previous, 0);
+            dm_addEdge(symbol, source, length, last_seg, fr, DM_X12, from, 3, previous, 0);
         }
 
         if (!fncs[from] || source[from] != '\x1D') {
-            dm_addEdge(symbol, source, length, last_seg, edges, DM_BASE256, from, 1, previous, 0);
+            dm_addEdge(symbol, source, length, last_seg, fr, DM_BASE256, from, 1, previous, 0);
         }
     }
 
@@ -975,52 +1071,73 @@ static void dm_addEdges(struct zint_symbol *symbol, const unsigned char source[]
         /* We create 3 EDF edges, 2, 3 or 4 characters length. The 4-char normally doesn't have a latch to ASCII
            unless it is 2 characters away from the end of the input. */
         for (i = 1, pos = from + i; i < 4 && pos < length && dm_isedifact(source[pos]); i++, pos++) {
-            dm_addEdge(symbol, source, length, last_seg, edges, DM_EDIFACT, from, i + 1, previous, 0);
+            dm_addEdge(symbol, source, length, last_seg, fr, DM_EDIFACT, from, i + 1, previous, 0);
         }
     }
 }
 
+/* Return start of C40/TEXT edge at least `DM_BACK_LONG` long ending at `vertexIndex`. As a batch run ends at the
+   first full batch, there is only one such start for `vertexIndex` < `length` */
+static int dm_c40text_from(const unsigned char source[], const int length, const int vertexIndex, const int mode) {
+    int from, len;
+
+    assert(vertexIndex < length);
+    for (from = vertexIndex - DM_BACK_LONG; from >= 0; from--) {
+        if (dm_getNumberOfC40Words(source, length, from, mode, &len) && from + len == vertexIndex) {
+            return from;
+        }
+    }
+    assert(0); /* Not reached */
+    return 0;
+}
+
 /* Calculate optimized encoding modes */
 static int dm_define_modes(struct zint_symbol *symbol, char modes[], const unsigned char source[], const int length,
             const int last_seg, const char *fncs, const int debug_print) {
 
-    int i, j, v_i;
+    int i, j;
     int minimalJ, minimalSize;
-    struct dm_edge *edge;
-    int current_mode;
-    int mode_end, mode_len;
+    struct dm_edge *v_edges;
+    int mode, from, previous;
+    struct dm_frontier fr;
 
-    struct dm_edge *edges = (struct dm_edge *) calloc((length + 1) * DM_NUM_MODES, sizeof(struct dm_edge));
-    if (!edges) {
+    /* Back-pointers for each vertex and end mode (1st row not used) */
+    unsigned char *back = (unsigned char *) malloc((length + 1) * DM_NUM_MODES);
+    if (!back) {
         return 0;
     }
-    assert((length + 1) * DM_NUM_MODES < USHRT_MAX); /* Guaranteed by input length limit */
+    memset(&fr, 0, sizeof(fr));
 
-    dm_addEdges(symbol, source, length, last_seg, edges, 0, NULL, fncs);
+    dm_addEdges(symbol, source, length, last_seg, &fr, 0, NULL, fncs);
 
-    DM_TRACE_Edges("DEBUG Initial situation\n", source, length, edges, 0);
+    DM_TRACE_Edges("DEBUG Initial situation\n", source, length, fr.ring[1 & DM_RING_MASK], 1);
 
     for (i = 1; i < length; i++) {
-        v_i = i * DM_NUM_MODES;
+        dm_mergePending(&fr, i);
+        v_edges = fr.ring[i & DM_RING_MASK];
         for (j = 0; j < DM_NUM_MODES; j++) {
-            if (edges[v_i + j].mode) {
-                dm_addEdges(symbol, source, length, last_seg, edges, i, edges + v_i + j, fncs);
+            if (v_edges[j].mode) {
+                back[i * DM_NUM_MODES + j] = (unsigned char) DM_BACK(v_edges + j);
+                dm_addEdges(symbol, source, length, last_seg, &fr, i, v_edges + j, fncs);
             }
         }
-        DM_TRACE_Edges("DEBUG situation after adding edges to vertices at position %d\n", source, length, edges, i);
+        memset(v_edges, 0, sizeof(fr.ring[0]));
+        DM_TRACE_Edges("DEBUG situation after adding edges to vertices at position %d\n", source, length,
+                        fr.ring[(i + 1) & DM_RING_MASK], i + 1);
     }
+    dm_mergePending(&fr, length);
+    assert(fr.pending_cnt == 0);
+    v_edges = fr.ring[length & DM_RING_MASK];
 
-    DM_TRACE_Edges("DEBUG Final situation\n", source, length, edges, length);
+    DM_TRACE_Edges("DEBUG Final situation\n", source, length, v_edges, length);
 
-    v_i = length * DM_NUM_MODES;
     minimalJ = -1;
     minimalSize = INT_MAX;
     for (j = 0; j < DM_NUM_MODES; j++) {
-        edge = edges + v_i + j;
-        if (edge->mode) {
-            if (debug_print) printf("edges[%d][%d][0] size %d\n", length, j, edge->size);
-            if (edge->size < minimalSize) {
-                minimalSize = edge->size;
+        if (v_edges[j].mode) {
+            if (debug_print) printf("edges[%d][%d][0] size %d\n", length, j, v_edges[j].size);
+            if (v_edges[j].size < minimalSize) {
+                minimalSize = v_edges[j].size;
                 minimalJ = j;
                 if (debug_print) printf(" set minimalJ %d\n", minimalJ);
             }
@@ -1030,20 +1147,21 @@ static int dm_define_modes(struct zint_symbol *symbol, char modes[], const unsig
     }
     assert(minimalJ >= 0);
 
-    edge = edges + v_i + minimalJ;
-    mode_len = 0;
-    mode_end = length;
-    while (edge) {
-        current_mode = edge->mode;
-        mode_len += edge->len;
-        edge = DM_PREVIOUS(edges, edge);
-        if (!edge || edge->mode != current_mode) {
-            for (i = mode_end - mode_len; i < mode_end; i++) {
-                modes[i] = current_mode;
-            }
-            mode_end = mode_end - mode_len;
-            mode_len = 0;
+    /* Final edge is in the frontier, the rest are back-pointers */
+    mode = v_edges[minimalJ].mode;
+    from = v_edges[minimalJ].from;
+    previous = v_edges[minimalJ].previous;
+    i = length;
+    for (;;) {
+        memset(modes + from, mode, i - from);
+        if (!previous) {
+            break;
         }
+        i = from;
+        j = back[i * DM_NUM_MODES + previous - 1];
+        mode = j & 0x08 ? DM_EDIFACT : previous;
+        from = j >> 4 ? i - (j >> 4) : dm_c40text_from(source, length, i, mode);
+        previous = j & 0x07;
     }
 
     if (debug_print) {
@@ -1051,9 +1169,9 @@ static int dm_define_modes(struct zint_symbol *symbol, char modes[], const unsig
         for (i = 0; i < length; i++) printf("%c", dm_smodes[(int) modes[i]][0]);
         fputc('\n', stdout);
     }
-    assert(mode_end == 0);
+    assert(from == 0);
 
-    free(edges);
+    free(back);
 
     return 1;
 }
@@ -1069,7 +1187,11 @@ static int dm_minimalenc(struct zint_symbol *symbol, const unsigned char source[
     int i;
     char *modes = (char *) z_alloca(length);
 
-    assert(length <= 10921); /* Can only handle (10921 + 1) * 6 = 65532 < 65536 (2*16) due to sizeof(previous) */
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
+    assert(length <= 10921); /* Positions and cumulative sizes must fit in unsigned short */
 
     if (!dm_define_modes(symbol, modes, source, length, last_seg, fncs, debug_print)) {
         return z_errtxt(ZINT_ERROR_MEMORY, symbol, 728, "Insufficient memory for mode buffers");
@@ -1822,6 +1944,9 @@ static int dm_encode_segs(struct zint_symbol *symbol, struct zint_seg segs[], co
             unsigned char *src_buf = (unsigned char *) z_alloca(length + 1);
             char *fncs = (char *) z_alloca(length);
 
+            if (Z_SCRATCH_FAILED()) {
+                return ZINT_ERROR_MEMORY;
+            }
             if (gs1) {
                 memset(fncs, gs1 == 1, length);
             } else {
@@ -1915,6 +2040,85 @@ static void dm_add_tail(unsigned char target[], int tp, const int tail_length) {
     }
 }
 
+/* How far the width-to-height ratio of `symbolsize` is from `aspect` (1 if equal, else > 1) */
+static float dm_fit_aspect_dev(const int symbolsize, const float aspect) {
+    const float ratio = (float) dm_matrixW[symbolsize] / dm_matrixH[symbolsize];
+
+    return ratio > aspect ? ratio / aspect : aspect / ratio;
+}
+
+/* Whether `symbolsize` `a` is a better fit than `b` for `symbol->fit` */
+static int dm_fit_better(const struct zint_symbol *symbol, const int a, const int b) {
+    const int area_a = dm_matrixH[a] * dm_matrixW[a];
+    const int area_b = dm_matrixH[b] * dm_matrixW[b];
+
+    if (symbol->fit.aspect > 0.0f) {
+        const float dev_a = dm_fit_aspect_dev(a, symbol->fit.aspect);
+        const float dev_b = dm_fit_aspect_dev(b, symbol->fit.aspect);
+        if (dev_a != dev_b) {
+            return dev_a < dev_b;
+        }
+        return area_a < area_b;
+    }
+    if (area_a != area_b) {
+        return area_a < area_b;
+    }
+    /* Prefer squarer */
+    return dm_fit_aspect_dev(a, 1.0f) < dm_fit_aspect_dev(b, 1.0f);
+}
+
+/* Best-fit symbol size selection (`DM_BEST_FIT`). Given `*p_binlen` data codewords encoded for the smallest of all
+   sizes `*p_symbolsize`, pick the size within `symbol->fit.max_width`/`max_height` closest to `symbol->fit.aspect`
+   (or of least area if none) in one pass, without re-encoding for each size.
+   Capacity only affects the end-of-data encodation, and only when the data ends within 2 codewords of it (see
+   `dm_getEndMode()` and the `symbols_left` checks of `dm_encode()`), where at most one unlatch (or Base 256 length)
+   codeword is saved. As any larger size has at least one more codeword of capacity, every size from
+   `*p_symbolsize` on fits, and only `binary` for the size picked need be re-encoded, if its capacity differs */
+static int dm_best_fit(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count,
+            unsigned char binary[], int *p_binlen, int *p_symbolsize) {
+    const float max_width = symbol->fit.max_width;
+    const float max_height = symbol->fit.max_height;
+    const int option_2 = symbol->option_2;
+    const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
+    const int binlen = *p_binlen;
+    const int capacity = dm_matrixbytes[*p_symbolsize]; /* Capacity `binary` encoded for */
+    int best = -1;
+    int cand_cnt = 0;
+    int i, j;
+
+    for (i = *p_symbolsize; i < DMSIZESCOUNT; i++) {
+        if ((max_width > 0.0f && dm_matrixW[i] > max_width) || (max_height > 0.0f && dm_matrixH[i] > max_height)) {
+            continue;
+        }
+        cand_cnt++;
+        if (best == -1 || dm_fit_better(symbol, i, best)) { /* Strictly better so capacity order on ties */
+            best = i;
+        }
+    }
+
+    if (best == -1) {
+        return z_errtxtf(ZINT_ERROR_TOO_LONG, symbol, 987,
+                        "No symbol size within maximum width %g and height %g fits %d codewords",
+                        max_width > 0.0f ? max_width : 144.0f, max_height > 0.0f ? max_height : 144.0f, binlen);
+    }
+
+    if (dm_matrixbytes[best] != capacity) {
+        int error_number;
+        for (j = 0; dm_intsymbol[j] != best; j++);
+        symbol->option_2 = j + 1; /* Encode for this size */
+        error_number = dm_encode_segs(symbol, segs, seg_count, binary, p_binlen);
+        symbol->option_2 = option_2;
+        if (error_number != 0) {
+            return error_number;
+        }
+        assert(*p_binlen <= binlen + 1 && *p_binlen <= dm_matrixbytes[best]);
+    }
+    if (debug_print) printf("Best fit %dx%d (%d candidates)\n", dm_matrixH[best], dm_matrixW[best], cand_cnt);
+    *p_symbolsize = best;
+
+    return 0;
+}
+
 static int dm_ecc200(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count) {
     int i, skew = 0;
     unsigned char binary[2200];
@@ -1922,6 +2126,7 @@ static int dm_ecc200(struct zint_symbol *symbol, struct zint_seg segs[], const i
     int symbolsize;
     int taillength, error_number;
     int H, W, FH, FW, datablock, bytes, rsblock;
+    struct zint_delta *delta;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
     /* `length` may be decremented by 2 if macro character is used */
@@ -1931,6 +2136,13 @@ static int dm_ecc200(struct zint_symbol *symbol, struct zint_seg segs[], const i
     }
 
     symbolsize = dm_get_symbolsize(symbol, binlen);
+    if ((symbol->option_2 < 1 || symbol->option_2 > DMSIZESCOUNT)
+            && (symbol->option_3 & DM_SQUARE_DMRE_MASK) == DM_BEST_FIT && binlen <= 1558) {
+        if ((error_number = dm_best_fit(symbol, segs, seg_count, binary, &binlen, &symbolsize))) {
+            return error_number;
+        }
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
 
     if (binlen > dm_matrixbytes[symbolsize]) {
         if (symbol->option_2 >= 1 && symbol->option_2 <= DMSIZESCOUNT) {
@@ -1977,7 +2189,9 @@ static int dm_ecc200(struct zint_symbol *symbol, struct zint_seg segs[], const i
     if (symbolsize == DMINTSYMBOL144 && !(symbol->option_3 & DM_ISO_144)) {
         skew = 1;
     }
-    dm_ecc(binary, bytes, datablock, rsblock, skew);
+    delta = z_delta_get(symbol, symbolsize, skew, bytes);
+    dm_ecc(binary, bytes, datablock, rsblock, skew, delta ? delta->full : NULL);
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
     if (debug_print) {
         printf("ECC (%d): ", rsblock * (bytes / datablock));
         assert(bytes > 0); /* Suppress clang-tidy-21 clang-analyzer-security.ArrayBound */
@@ -1990,14 +2204,21 @@ static int dm_ecc200(struct zint_symbol *symbol, struct zint_seg segs[], const i
         z_debug_test_codeword_dump(symbol, binary, skew ? 1558 + 620 : bytes + rsblock * (bytes / datablock));
     }
 #endif
+    if (delta) {
+        /* Patch modules of previous encode */
+        z_delta_patch(symbol, delta, binary, binary);
+        Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
+        return error_number;
+    }
     { /* placement */
         const int NC = W - 2 * (W / FW);
         const int NR = H - 2 * (H / FH);
-        int x, y, *places;
-        if (!(places = (int *) calloc((size_t) NC * (size_t) NR, sizeof(int)))) {
+        unsigned short *posns = z_delta_posns(symbol);
+        const unsigned short *places;
+        int x, y, places_free;
+        if (!(places = dm_get_places(symbolsize, NR, NC, &places_free))) {
             return z_errtxt(ZINT_ERROR_MEMORY, symbol, 718, "Insufficient memory for placement array");
         }
-        dm_placement(places, NR, NC);
         for (y = 0; y < H; y += FH) {
             for (x = 0; x < W; x++)
                 z_set_module(symbol, (H - y) - 1, x);
@@ -2024,21 +2245,32 @@ static int dm_ecc200(struct zint_symbol *symbol, struct zint_seg segs[], const i
         for (y = 0; y < NR; y++) {
             for (x = 0; x < NC; x++) {
                 const int v = places[(NR - y - 1) * NC + x];
+                const int row = H - (1 + y + 2 * (y / (FH - 2))) - 1;
+                const int col = 1 + x + 2 * (x / (FW - 2));
                 if (v == 1 || (v > 7 && (binary[(v >> 3) - 1] & (1 << (v & 7))))) {
-                    z_set_module(symbol, H - (1 + y + 2 * (y / (FH - 2))) - 1, 1 + x + 2 * (x / (FW - 2)));
+                    z_set_module(symbol, row, col);
+                }
+                if (posns && v > 7) { /* Bits MSB first */
+                    posns[(((v >> 3) - 1) << 3) + 7 - (v & 7)] = (unsigned short) (row * W + col);
                 }
             }
         }
         for (y = 0; y < H; y++) {
             symbol->row_height[y] = 1;
         }
-        free(places);
+        if (places_free) {
+            free((void *) places);
+        }
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
 
     symbol->height = H;
     symbol->rows = H;
     symbol->width = W;
 
+    z_delta_save(symbol, symbolsize, skew, 0 /*mask*/, binary, bytes, binary,
+                bytes + rsblock * ((bytes + 2) / datablock));
+
     return error_number;
 }
 
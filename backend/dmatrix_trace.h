@@ -33,13 +33,8 @@
 #ifndef Z_DMATRIX_TRACE_H
 #define Z_DMATRIX_TRACE_H
 
-static int DM_TRACE_getPreviousMode(struct dm_edge *edges, struct dm_edge *edge) {
-    struct dm_edge *previous = DM_PREVIOUS(edges, edge);
-    return previous == NULL ? DM_ASCII : previous->endMode;
-}
-
 static void DM_TRACE_VertexToString(const unsigned char *source, const int length, const int position,
-            struct dm_edge *edge) {
+            const struct dm_edge *edge) {
     if (position >= length) {
         printf("end mode %s", dm_smodes[edge->mode]);
     } else {
@@ -47,74 +42,36 @@ static void DM_TRACE_VertexToString(const unsigned char *source, const int lengt
     }
 }
 
-static void DM_TRACE_EdgeToString(char *buf, const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *edge) {
-    int previousMode = DM_TRACE_getPreviousMode(edges, edge);
-    (void)length;
-    if (buf) {
-        sprintf(buf, "%d_%s %s(%.*s) (%d) --> %d_%s",
-            edge->from, dm_smodes[previousMode], dm_smodes[edge->mode], edge->len, source + edge->from, edge->size,
-            edge->from + edge->len, dm_smodes[edge->mode]);
-    } else {
-        printf("%d_%s %s(%.*s) (%d) --> %d_%s",
-            edge->from, dm_smodes[previousMode], dm_smodes[edge->mode], edge->len, source + edge->from, edge->size,
-            edge->from + edge->len, dm_smodes[edge->mode]);
-    }
-}
-
-static void DM_TRACE_Path(const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *edge, char *result, const int result_size) {
-    struct dm_edge *current;
-    DM_TRACE_EdgeToString(result, source, length, edges, edge);
-    current = DM_PREVIOUS(edges, edge);
-    while (current) {
-        char s[256];
-        char *pos;
-        int len;
-        DM_TRACE_EdgeToString(s, source, length, edges, current);
-        pos = strrchr(s, ' ');
-        assert(pos);
-        len = strlen(result);
-        if ((pos - s) + 1 + len + 1 >= result_size) {
-            memcpy(result + result_size - 4, "...", 4); /* Include terminating NUL */
-            break;
-        }
-        memmove(result + (pos - s) + 1, result, len + 1);
-        memcpy(result, s, (pos - s) + 1);
-        current = DM_PREVIOUS(edges, current);
-    }
-    puts(result);
+static void DM_TRACE_EdgeToString(const unsigned char *source, const struct dm_edge *edge) {
+    const int previousMode = edge->previous ? edge->previous : DM_ASCII;
+    printf("%d_%s %s(%.*s) (%d) --> %d_%s",
+        edge->from, dm_smodes[previousMode], dm_smodes[edge->mode], edge->len, source + edge->from, edge->size,
+        edge->from + edge->len, dm_smodes[edge->mode]);
 }
 
+/* Only the frontier is kept, so print the edges ending at `vertexIndex` */
 static void DM_TRACE_Edges(const char *prefix, const unsigned char *source, const int length,
-            struct dm_edge *edges, const int vertexIndex) {
-    int i, j, e_i;
-    char result[1024 * 2];
-    if (vertexIndex) {
-        printf(prefix, vertexIndex);
-    } else {
-        fputs(prefix, stdout);
-    }
-    for (i = vertexIndex; i <= length; i++) {
-        e_i = i * DM_NUM_MODES;
-        for (j = 0; j < DM_NUM_MODES; j++) {
-            if (edges[e_i + j].mode) {
-                fputs("DEBUG ", stdout);
-                DM_TRACE_Path(source, length, edges, edges + e_i + j, result, (int) ARRAY_SIZE(result));
-            }
+            const struct dm_edge *v_edges, const int vertexIndex) {
+    int j;
+    (void)length;
+    printf(prefix, vertexIndex);
+    for (j = 0; j < DM_NUM_MODES; j++) {
+        if (v_edges[j].mode) {
+            fputs("DEBUG ", stdout);
+            DM_TRACE_EdgeToString(source, v_edges + j);
+            fputc('\n', stdout);
         }
     }
 }
 
-static void DM_TRACE_AddEdge(const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *previous, const int vertexIndex, struct dm_edge *edge) {
+static void DM_TRACE_AddEdge(const unsigned char *source, const int length, const struct dm_edge *v_edge,
+            const struct dm_edge *previous, const int vertexIndex, const struct dm_edge *edge) {
+    (void)v_edge;
+    fputs("DEBUG add ", stdout);
+    DM_TRACE_EdgeToString(source, edge);
     if (previous == NULL) {
-        fputs("DEBUG add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
         printf(" from %d to %d size %d\n", edge->from, vertexIndex, edge->size);
     } else {
-        fputs("DEBUG add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
         fputs(" from ", stdout);
         DM_TRACE_VertexToString(source, length, previous->from, previous);
         fputs(" to ", stdout);
@@ -123,25 +80,21 @@ static void DM_TRACE_AddEdge(const unsigned char *source, const int length, stru
     }
 }
 
-static void DM_TRACE_NotAddEdge(const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *previous, const int vertexIndex, const int e_ij, struct dm_edge *edge) {
+static void DM_TRACE_NotAddEdge(const unsigned char *source, const int length, const struct dm_edge *v_edge,
+            const struct dm_edge *previous, const int vertexIndex, const struct dm_edge *edge) {
+    fputs("DEBUG not add ", stdout);
+    DM_TRACE_EdgeToString(source, edge);
     if (previous == NULL) {
-        fputs("DEBUG not add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
         printf(" from %d to %d size %d since ", edge->from, vertexIndex, edge->size);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edges + e_ij);
-        printf(" < size %d\n", edges[e_ij].size);
     } else {
-        fputs("DEBUG not add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
         fputs(" from ", stdout);
         DM_TRACE_VertexToString(source, length, previous->from, previous);
         fputs(" to ", stdout);
         DM_TRACE_VertexToString(source, length, vertexIndex, edge);
         printf(" size %d since ", edge->size);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edges + e_ij);
-        printf(" < size %d\n", edges[e_ij].size);
     }
+    DM_TRACE_EdgeToString(source, v_edge);
+    printf(" < size %d\n", v_edge->size);
 }
 
 /* vim: set ts=4 sw=4 et : */
@@ -1214,6 +1214,10 @@ INTERNAL int zint_dotcode(struct zint_symbol *symbol, struct zint_seg segs[], co
     char *dot_array;
     unsigned char *masked_codeword_array;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (symbol->eci > 811799) {
         return z_errtxtf(ZINT_ERROR_INVALID_OPTION, symbol, 525, "ECI code '%d' out of range (0 to 811799)",
                         symbol->eci);
@@ -1348,6 +1352,9 @@ INTERNAL int zint_dotcode(struct zint_symbol *symbol, struct zint_seg segs[], co
 
     dot_stream = (char *) z_alloca(height * width * 3);
     dot_array = (char *) z_alloca(width * height);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     /* Add pad characters */
     padding_dots = n_dots - min_dots; /* Get the number of free dots available for padding */
@@ -1410,6 +1417,9 @@ INTERNAL int zint_dotcode(struct zint_symbol *symbol, struct zint_seg segs[], co
     ecc_length = 3 + (data_length / 2);
 
     masked_codeword_array = (unsigned char *) z_alloca(data_length + 1 + ecc_length);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     if (user_mask) {
         best_mask = user_mask - 1;
@@ -803,6 +803,10 @@ INTERNAL int zint_get_best_eci(const unsigned char source[], int length) {
     /* Note: attempting single-byte conversions only, so `zint_get_eci_length()` unnecessary */
     unsigned char *local_source = (unsigned char *) z_alloca(length + 1);
 
+    if (Z_SCRATCH_FAILED()) {
+        return 26; /* Failure reported by API call */
+    }
+
     do {
         if (eci == 14) { /* Reserved */
             eci = 15;
@@ -861,6 +865,10 @@ INTERNAL int zint_sjis_utf8(struct zint_symbol *symbol, const unsigned char sour
     unsigned int i, length;
     unsigned int *utfdata = (unsigned int *) z_alloca(sizeof(unsigned int) * (*p_length + 1));
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     error_number = z_utf8_to_unicode(symbol, source, utfdata, p_length, 1 /*disallow_4byte*/);
     if (error_number != 0) {
         return error_number;
@@ -930,6 +938,10 @@ INTERNAL int zint_sjis_utf8_to_eci(const int eci, const unsigned char source[],
         const int eci_length = zint_get_eci_length(eci, source, *p_length);
         unsigned char *converted = (unsigned char *) z_alloca(eci_length + 1);
 
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
+
         error_number = zint_utf8_to_eci(eci, source, converted, p_length);
         if (error_number != 0) {
             /* Note not setting `symbol->errtxt`, up to caller */
@@ -953,6 +965,10 @@ INTERNAL int zint_gb2312_utf8(struct zint_symbol *symbol, const unsigned char so
     unsigned int i, length;
     unsigned int *utfdata = (unsigned int *) z_alloca(sizeof(unsigned int) * (*p_length + 1));
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     error_number = z_utf8_to_unicode(symbol, source, utfdata, p_length, 1 /*disallow_4byte*/);
     if (error_number != 0) {
         return error_number;
@@ -1037,6 +1053,10 @@ INTERNAL int zint_gb2312_utf8_to_eci(const int eci, const unsigned char source[]
         const int eci_length = zint_get_eci_length(eci, source, *p_length);
         unsigned char *converted = (unsigned char *) z_alloca(eci_length + 1);
 
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
+
         error_number = zint_utf8_to_eci(eci, source, converted, p_length);
         if (error_number != 0) {
             /* Note not setting `symbol->errtxt`, up to caller */
@@ -1060,6 +1080,10 @@ INTERNAL int zint_gb18030_utf8(struct zint_symbol *symbol, const unsigned char s
     unsigned int i, j, length;
     unsigned int *utfdata = (unsigned int *) z_alloca(sizeof(unsigned int) * (*p_length + 1));
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     error_number = z_utf8_to_unicode(symbol, source, utfdata, p_length, 0 /*disallow_4byte*/);
     if (error_number != 0) {
         return error_number;
@@ -1156,6 +1180,10 @@ INTERNAL int zint_gb18030_utf8_to_eci(const int eci, const unsigned char source[
         const int eci_length = zint_get_eci_length(eci, source, *p_length);
         unsigned char *converted = (unsigned char *) z_alloca(eci_length + 1);
 
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
+
         error_number = zint_utf8_to_eci(eci, source, converted, p_length);
         if (error_number != 0) {
             /* Note not setting `symbol->errtxt`, up to caller */
@@ -257,6 +257,9 @@ INTERNAL int zint_emf_plot(struct zint_symbol *symbol, int rotate_angle) {
     rectangle = (emr_rectangle_t *) z_alloca(sizeof(emr_rectangle_t) * (rectangle_count ? rectangle_count : 1));
     circle = (emr_ellipse_t *) z_alloca(sizeof(emr_ellipse_t) * (circle_count ? circle_count : 1));
     hexagon = (emr_polygon_t *) z_alloca(sizeof(emr_polygon_t) * (hexagon_count ? hexagon_count : 1));
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     /* Calculate how many coloured rectangles */
     if (symbol->symbology == BARCODE_ULTRA) {
@@ -0,0 +1,103 @@
+/* escpos.c - Handles output to Epson ESC/POS raster bit image */
+/*
+    libzint - the open source barcode library
+    Copyright (C) 2026 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+#include <errno.h>
+#include <stdio.h>
+#include "common.h"
+#include "filemem.h"
+#include "output.h"
+
+/* Maximum rows per "GS v 0" command - printers have limited raster buffers so split into bands */
+#define ESCPOS_BAND_ROWS 255
+
+/* ESC/POS Application Programming Guide, GS v 0 Print raster bit image */
+INTERNAL int zint_escpos_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf) {
+    unsigned char map[128];
+    unsigned char header[8] = { 0x1D, 0x76, 0x30, 0x00 }; /* GS v 0 m=0 (normal) */
+    int row, band_rows;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    const unsigned char *pb;
+    const int bytes_per_row = (symbol->bitmap_width + 7) >> 3;
+    unsigned char *bandbuf;
+
+    if (bytes_per_row > 0xFFFF) {
+        return z_errtxt(ZINT_ERROR_INVALID_OPTION, symbol, 612, "Output width too large for ESC/POS raster command");
+    }
+    if (!(bandbuf = (unsigned char *) malloc((size_t) bytes_per_row * ESCPOS_BAND_ROWS))) {
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 613, "Insufficient memory for ESC/POS band buffer");
+    }
+
+    zint_out_mono_map(symbol, map);
+
+    /* Open output file in binary mode */
+    if (!zint_fm_open(fmp, symbol, "wb")) {
+        ZEXT z_errtxtf(0, symbol, 616, "Could not open ESC/POS output file (%1$d: %2$s)", fmp->err,
+                        strerror(fmp->err));
+        free(bandbuf);
+        return ZINT_ERROR_FILE_ACCESS;
+    }
+
+    zint_out_le_u16(header[4], bytes_per_row);
+
+    for (row = 0, pb = pixelbuf; row < symbol->bitmap_height; row += band_rows) {
+        int i;
+        band_rows = symbol->bitmap_height - row;
+        if (band_rows > ESCPOS_BAND_ROWS) {
+            band_rows = ESCPOS_BAND_ROWS;
+        }
+        for (i = 0; i < band_rows; i++, pb += symbol->bitmap_width) {
+            zint_out_mono_pack_row(map, pb, symbol->bitmap_width, bandbuf + (size_t) bytes_per_row * i);
+        }
+        zint_out_le_u16(header[6], band_rows);
+        zint_fm_write(header, 1, sizeof(header), fmp);
+        zint_fm_write(bandbuf, 1, (size_t) bytes_per_row * band_rows, fmp);
+    }
+
+    free(bandbuf);
+
+    if (zint_fm_error(fmp)) {
+        ZEXT z_errtxtf(0, symbol, 618, "Incomplete write of ESC/POS output (%1$d: %2$s)", fmp->err,
+                        strerror(fmp->err));
+        (void) zint_fm_close(fmp, symbol);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+
+    if (!zint_fm_close(fmp, symbol)) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_WRITE, symbol, 619,
+                                "Failure on closing ESC/POS output file (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+    }
+
+    return 0;
+}
+
+/* vim: set ts=4 sw=4 et : */
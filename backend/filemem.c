@@ -396,6 +396,9 @@ INTERNAL int zint_fm_close(struct filemem *restrict const fmp, struct zint_symbo
         symbol->memfile = fmp->mem;
         fmp->mem = NULL; /* Now belongs to `symbol` */
         fm_clear_mem(fmp);
+        if (Z_STATS_ON(symbol)) {
+            symbol->stats.bytes_out += symbol->memfile_size;
+        }
         return 1;
     }
     if (fmp->err || !fmp->fp) {
@@ -410,6 +413,13 @@ INTERNAL int zint_fm_close(struct filemem *restrict const fmp, struct zint_symbo
             return fm_seterr(fmp, errno);
         }
     } else {
+        /* Size from end as may have seeked back (TIF) - not available for stdout, which may be a pipe */
+        if (Z_STATS_ON(symbol) && fseek(fmp->fp, 0, SEEK_END) == 0) {
+            const long size = ftell(fmp->fp);
+            if (size > 0) {
+                symbol->stats.bytes_out += size;
+            }
+        }
         if ((FM_FAIL_ERRNO(FM_FAIL_ID_CLOSE, EIO, EOF) fclose(fmp->fp)) != 0) {
             fmp->fp = NULL;
             return fm_seterr(fmp, errno);
@@ -245,7 +245,7 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
     int paletteCount, i;
     unsigned char paletteBitSize;
     int paletteSize;
-    struct gif_state State;
+    Z_LARGE_ARRAY(struct gif_state, State, 1);
     int transparent_index;
     int bgindex = -1, fgindex = -1;
 
@@ -257,32 +257,36 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
 
     const size_t bitmapSize = (size_t) symbol->bitmap_height * symbol->bitmap_width;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     (void) zint_out_colour_get_rgb(symbol->fgcolour, &RGBfg[0], &RGBfg[1], &RGBfg[2], &fgalpha);
     (void) zint_out_colour_get_rgb(symbol->bgcolour, &RGBbg[0], &RGBbg[1], &RGBbg[2], &bgalpha);
 
     /* Prepare state array */
-    State.pIn = pixelbuf;
-    State.pInEnd = pixelbuf + bitmapSize;
+    State->pIn = pixelbuf;
+    State->pInEnd = pixelbuf + bitmapSize;
     /* Allow for overhead of 4 == code size + byte count + overflow byte + zero terminator */
-    State.OutLength = bitmapSize + 4;
-    State.fOutPaged = State.OutLength > GIF_LZW_PAGE_SIZE;
-    if (State.fOutPaged) {
-        State.OutLength = GIF_LZW_PAGE_SIZE;
+    State->OutLength = bitmapSize + 4;
+    State->fOutPaged = State->OutLength > GIF_LZW_PAGE_SIZE;
+    if (State->fOutPaged) {
+        State->OutLength = GIF_LZW_PAGE_SIZE;
     }
-    if (!(State.pOut = (unsigned char *) malloc(State.OutLength))) {
+    if (!(State->pOut = (unsigned char *) malloc(State->OutLength))) {
         return z_errtxt(ZINT_ERROR_MEMORY, symbol, 614, "Insufficient memory for GIF LZW buffer");
     }
 #ifdef ZINT_SANITIZEM /* Suppress clang -fsanitize=memory false positive */
-    memset(State.pOut, 0, State.OutLength);
+    memset(State->pOut, 0, State->OutLength);
 #endif
 
-    State.fmp = &fm;
+    State->fmp = &fm;
 
     /* Open output file in binary mode */
-    if (!zint_fm_open(State.fmp, symbol, "wb")) {
-        ZEXT z_errtxtf(0, symbol, 611, "Could not open GIF output file (%1$d: %2$s)", State.fmp->err,
-                        strerror(State.fmp->err));
-        free(State.pOut);
+    if (!zint_fm_open(State->fmp, symbol, "wb")) {
+        ZEXT z_errtxtf(0, symbol, 611, "Could not open GIF output file (%1$d: %2$s)", State->fmp->err,
+                        strerror(State->fmp->err));
+        free(State->pOut);
         return ZINT_ERROR_FILE_ACCESS;
     }
 
@@ -301,11 +305,11 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
      * 'K': black
      * '0' and '1' may be identical to one of the other values
      */
-    memset(State.map, 0, sizeof(State.map));
+    memset(State->map, 0, sizeof(State->map));
     if (symbol->symbology == BARCODE_ULTRA) {
         static const unsigned char ultra_chars[8] = { 'W', 'C', 'B', 'M', 'R', 'Y', 'G', 'K' };
         for (i = 0; i < 8; i++) {
-            State.map[ultra_chars[i]] = (unsigned char) i;
+            State->map[ultra_chars[i]] = (unsigned char) i;
             zint_out_colour_char_to_rgb(ultra_chars[i], &paletteRGB[i][0], &paletteRGB[i][1], &paletteRGB[i][2]);
         }
         paletteCount = 8;
@@ -315,9 +319,9 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
         if (symbol->border_width > 0 && (symbol->output_options & (BARCODE_BIND | BARCODE_BOX | BARCODE_BIND_TOP))) {
             /* Check whether can re-use black */
             if (RGBfg[0] == 0 && RGBfg[1] == 0 && RGBfg[2] == 0) {
-                State.map['1'] = (unsigned char) (fgindex = 7); /* Re-use black */
+                State->map['1'] = (unsigned char) (fgindex = 7); /* Re-use black */
             } else {
-                State.map['1'] = (unsigned char) (fgindex = paletteCount);
+                State->map['1'] = (unsigned char) (fgindex = paletteCount);
                 memcpy(paletteRGB[paletteCount++], RGBfg, 3);
                 paletteBitSize = 4;
             }
@@ -329,17 +333,17 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
                     && !(symbol->output_options & BARCODE_NO_QUIET_ZONES))) {
             /* Check whether can re-use white */
             if (RGBbg[0] == 0xff && RGBbg[1] == 0xff && RGBbg[2] == 0xff && bgalpha == fgalpha) {
-                State.map['0'] = (unsigned char) (bgindex = 0); /* Re-use white */
+                State->map['0'] = (unsigned char) (bgindex = 0); /* Re-use white */
             } else {
-                State.map['0'] = (unsigned char) (bgindex = paletteCount);
+                State->map['0'] = (unsigned char) (bgindex = paletteCount);
                 memcpy(paletteRGB[paletteCount++], RGBbg, 3);
                 paletteBitSize = 4;
             }
         }
     } else {
-        State.map['0'] = (unsigned char) (bgindex = 0);
+        State->map['0'] = (unsigned char) (bgindex = 0);
         memcpy(paletteRGB[bgindex], RGBbg, 3);
-        State.map['1'] = (unsigned char) (fgindex = 1);
+        State->map['1'] = (unsigned char) (fgindex = 1);
         memcpy(paletteRGB[fgindex], RGBfg, 3);
         paletteCount = 2;
         paletteBitSize = 1;
@@ -361,7 +365,7 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
     paletteSize = 1 << paletteBitSize;
 
     /* GIF signature (6) */
-    zint_fm_write(transparent_index == -1 ? "GIF87a" : "GIF89a", 1, 6, State.fmp);
+    zint_fm_write(transparent_index == -1 ? "GIF87a" : "GIF89a", 1, 6, State->fmp);
     /* Screen Descriptor (7) */
     /* Screen Width */
     outbuf[0] = (unsigned char) (0xff & symbol->bitmap_width);
@@ -386,12 +390,12 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
     outbuf[5] = (unsigned char) (bgindex == -1 ? 0 : bgindex);
     /* Byte 7 must be 0x00  */
     outbuf[6] = 0x00;
-    zint_fm_write(outbuf, 1, 7, State.fmp);
+    zint_fm_write(outbuf, 1, 7, State->fmp);
     /* Global Color Table (paletteSize*3) */
-    zint_fm_write(paletteRGB, 1, 3 * paletteCount, State.fmp);
+    zint_fm_write(paletteRGB, 1, 3 * paletteCount, State->fmp);
     /* Add unused palette items to fill palette size */
     for (i = paletteCount; i < paletteSize; i++) {
-        zint_fm_write(RGBUnused, 1, 3, State.fmp);
+        zint_fm_write(RGBUnused, 1, 3, State->fmp);
     }
 
     /* Graphic control extension (8) */
@@ -419,7 +423,7 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
         outbuf[6] = (unsigned char) transparent_index;
         /* Block Terminator */
         outbuf[7] = 0;
-        zint_fm_write(outbuf, 1, 8, State.fmp);
+        zint_fm_write(outbuf, 1, 8, State->fmp);
     }
     /* Image Descriptor */
     /* Image separator character = ',' */
@@ -442,26 +446,26 @@ INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixe
      * There is no local color table if its most significant bit is reset.
      */
     outbuf[9] = 0x00;
-    zint_fm_write(outbuf, 1, 10, State.fmp);
+    zint_fm_write(outbuf, 1, 10, State->fmp);
 
     /* Call lzw encoding */
-    gif_lzw(&State, paletteBitSize);
-    zint_fm_write(State.pOut, 1, State.OutPosCur, State.fmp);
-    free(State.pOut);
+    gif_lzw(State, paletteBitSize);
+    zint_fm_write(State->pOut, 1, State->OutPosCur, State->fmp);
+    free(State->pOut);
 
     /* GIF terminator */
-    zint_fm_putc(';', State.fmp);
+    zint_fm_putc(';', State->fmp);
 
-    if (zint_fm_error(State.fmp)) {
-        ZEXT z_errtxtf(0, symbol, 615, "Incomplete write of GIF output (%1$d: %2$s)", State.fmp->err,
-                        strerror(State.fmp->err));
-        (void) zint_fm_close(State.fmp, symbol);
+    if (zint_fm_error(State->fmp)) {
+        ZEXT z_errtxtf(0, symbol, 615, "Incomplete write of GIF output (%1$d: %2$s)", State->fmp->err,
+                        strerror(State->fmp->err));
+        (void) zint_fm_close(State->fmp, symbol);
         return ZINT_ERROR_FILE_WRITE;
     }
 
-    if (!zint_fm_close(State.fmp, symbol)) {
+    if (!zint_fm_close(State->fmp, symbol)) {
         return ZEXT z_errtxtf(ZINT_ERROR_FILE_WRITE, symbol, 617, "Failure on closing GIF output file (%1$d: %2$s)",
-                                State.fmp->err, strerror(State.fmp->err));
+                                State->fmp->err, strerror(State->fmp->err));
     }
 
     return 0;
@@ -165,6 +165,10 @@ static void gm_define_modes(char *modes, const unsigned int ddata[], const int l
     unsigned int cur_costs[GM_NUM_MODES];
     char (*char_modes)[GM_NUM_MODES] = (char (*)[GM_NUM_MODES]) z_alloca(GM_NUM_MODES * length);
 
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
+
     /* char_modes[i][j] represents the mode to encode the code point at index i such that the final segment
        ends in mode_types[j] and the total number of bits is minimized over all possible choices */
     memset(char_modes, 0, length * GM_NUM_MODES);
@@ -283,14 +287,14 @@ static void gm_define_modes(char *modes, const unsigned int ddata[], const int l
 }
 
 /* Add the length indicator for byte encoded blocks */
-static void gm_add_byte_count(char binary[], const int byte_count_posn, const int byte_count) {
+static void gm_add_byte_count(struct z_bitstream *bs, const int byte_count_posn, const int byte_count) {
     /* AIMD014 6.3.7: "Let L be the number of bytes of input data to be encoded in the 8-bit binary data set.
      * First output (L-1) as a 9-bit binary prefix to record the number of bytes..." */
-    z_bin_append_posn(byte_count - 1, 9, binary, byte_count_posn);
+    z_bs_put(bs, byte_count - 1, 9, byte_count_posn);
 }
 
 /* Add a control character to the data stream */
-static int gm_add_shift_char(char binary[], int bp, const int shifty, const int debug_print) {
+static void gm_add_shift_char(struct z_bitstream *bs, const int shifty, const int debug_print) {
     int glyph;
 
     /* See Table 7 - Encoding of control characters */
@@ -310,12 +314,10 @@ static int gm_add_shift_char(char binary[], int bp, const int shifty, const int
         printf("SHIFT [%d] ", glyph);
     }
 
-    bp = z_bin_append_posn(glyph, 6, binary, bp);
-
-    return bp;
+    z_bs_append(bs, glyph, 6);
 }
 
-static int gm_encode(const unsigned int ddata[], const int length, char binary[], const int eci, int *p_bp,
+static int gm_encode(const unsigned int ddata[], const int length, struct z_bitstream *bs, const int eci,
             const int debug_print) {
     /* Create a binary stream representation of the input data.
        6 sets are defined - Chinese characters, Numerals, Lower case letters, Upper case letters,
@@ -328,24 +330,30 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
     int numeral_pad_posn = 0;
     int byte_count_posn = 0;
     int byte_count = 0;
-    int bp = *p_bp;
     char *modes = (char *) z_alloca(length);
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (eci != 0) {
         /* ECI assignment according to Table 8 */
-        bp = z_bin_append_posn(12, 4, binary, bp); /* ECI */
+        z_bs_append(bs, 12, 4); /* ECI */
         if (eci <= 1023) {
-            bp = z_bin_append_posn(eci, 11, binary, bp);
+            z_bs_append(bs, eci, 11);
         } else if (eci <= 32767) {
-            bp = z_bin_append_posn(2, 2, binary, bp);
-            bp = z_bin_append_posn(eci, 15, binary, bp);
+            z_bs_append(bs, 2, 2);
+            z_bs_append(bs, eci, 15);
         } else {
-            bp = z_bin_append_posn(3, 2, binary, bp);
-            bp = z_bin_append_posn(eci, 20, binary, bp);
+            z_bs_append(bs, 3, 2);
+            z_bs_append(bs, eci, 20);
         }
     }
 
     gm_define_modes(modes, ddata, length, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     do {
         const int next_mode = modes[sp];
@@ -355,18 +363,17 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
         if (next_mode != current_mode) {
             if (current_mode == GM_BYTE) {
                 /* Add byte block length indicator */
-                gm_add_byte_count(binary, byte_count_posn, byte_count);
+                gm_add_byte_count(bs, byte_count_posn, byte_count);
                 byte_count = 0;
             } else if (current_mode == GM_NUMERAL && numeral_cnt) {
                 /* Set numeric block padding value */
-                (void) z_bin_append_posn(3 - numeral_cnt, 2, binary, numeral_pad_posn);
+                z_bs_put(bs, 3 - numeral_cnt, 2, numeral_pad_posn);
             }
-            bp = z_bin_append_posn(gm_mode_switch[current_mode][next_mode - 1],
-                                    gm_mode_len[current_mode][next_mode - 1], binary, bp);
+            z_bs_append(bs, gm_mode_switch[current_mode][next_mode - 1], gm_mode_len[current_mode][next_mode - 1]);
             if (debug_print) {
                 fputs(gm_debug_modes[next_mode - 1], stdout);
             }
-            if (bp > 9191) {
+            if (bs->bp > 9191) {
                 return ZINT_ERROR_TOO_LONG;
             }
         }
@@ -404,15 +411,15 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
                     printf("[%d] ", (int) glyph);
                 }
 
-                bp = z_bin_append_posn(glyph, 13, binary, bp);
+                z_bs_append(bs, glyph, 13);
                 sp++;
                 break;
 
             case GM_NUMERAL:
                 if (last_mode != current_mode) {
                     /* Reserve a space for numeric digit padding value (2 bits) */
-                    numeral_pad_posn = bp;
-                    bp = z_bin_append_posn(0, 2, binary, bp);
+                    numeral_pad_posn = bs->bp;
+                    z_bs_append(bs, 0, 2);
                 }
                 numeral_cnt = 0;
                 nondigit_posn = -1;
@@ -457,7 +464,7 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
                         printf("[%d] ", (int) glyph);
                     }
 
-                    bp = z_bin_append_posn(glyph, 10, binary, bp);
+                    z_bs_append(bs, glyph, 10);
                 }
 
                 glyph = (100 * (numbuf[0] - '0')) + (10 * (numbuf[1] - '0')) + (numbuf[2] - '0');
@@ -465,34 +472,34 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
                     printf("[%d] ", (int) glyph);
                 }
 
-                bp = z_bin_append_posn(glyph, 10, binary, bp);
+                z_bs_append(bs, glyph, 10);
                 break;
 
             case GM_BYTE:
                 if (last_mode != current_mode) {
                     /* Reserve space for byte block length indicator (9 bits) */
-                    byte_count_posn = bp;
-                    bp = z_bin_append_posn(0, 9, binary, bp);
+                    byte_count_posn = bs->bp;
+                    z_bs_append(bs, 0, 9);
                 }
                 glyph = ddata[sp];
                 if (byte_count == 512 || (glyph > 0xFF && byte_count == 511)) {
                     /* Maximum byte block size is 512 bytes. If longer is needed then start a new block */
                     if (glyph > 0xFF && byte_count == 511) { /* Split double-byte */
-                        bp = z_bin_append_posn(glyph >> 8, 8, binary, bp);
+                        z_bs_append(bs, glyph >> 8, 8);
                         glyph &= 0xFF;
                         byte_count++;
                     }
-                    gm_add_byte_count(binary, byte_count_posn, byte_count);
-                    bp = z_bin_append_posn(7, 4, binary, bp);
-                    byte_count_posn = bp;
-                    bp = z_bin_append_posn(0, 9, binary, bp);
+                    gm_add_byte_count(bs, byte_count_posn, byte_count);
+                    z_bs_append(bs, 7, 4);
+                    byte_count_posn = bs->bp;
+                    z_bs_append(bs, 0, 9);
                     byte_count = 0;
                 }
 
                 if (debug_print) {
                     printf("[%d] ", (int) glyph);
                 }
-                bp = z_bin_append_posn(glyph, glyph > 0xFF ? 16 : 8, binary, bp);
+                z_bs_append(bs, glyph, glyph > 0xFF ? 16 : 8);
                 sp++;
                 byte_count++;
                 if (glyph > 0xFF) {
@@ -508,11 +515,11 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
                     if (debug_print) {
                         printf("[%d] ", (int) glyph);
                     }
-                    bp = z_bin_append_posn(glyph, 6, binary, bp);
+                    z_bs_append(bs, glyph, 6);
                 } else {
                     /* Shift Mode character */
-                    bp = z_bin_append_posn(1014, 10, binary, bp); /* Shift indicator */
-                    bp = gm_add_shift_char(binary, bp, ddata[sp], debug_print);
+                    z_bs_append(bs, 1014, 10); /* Shift indicator */
+                    gm_add_shift_char(bs, ddata[sp], debug_print);
                 }
 
                 sp++;
@@ -525,11 +532,11 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
                     if (debug_print) {
                         printf("[%d] ", (int) glyph);
                     }
-                    bp = z_bin_append_posn(glyph, 5, binary, bp);
+                    z_bs_append(bs, glyph, 5);
                 } else {
                     /* Shift Mode character */
-                    bp = z_bin_append_posn(125, 7, binary, bp); /* Shift indicator */
-                    bp = gm_add_shift_char(binary, bp, ddata[sp], debug_print);
+                    z_bs_append(bs, 125, 7); /* Shift indicator */
+                    gm_add_shift_char(bs, ddata[sp], debug_print);
                 }
 
                 sp++;
@@ -542,17 +549,17 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
                     if (debug_print) {
                         printf("[%d] ", (int) glyph);
                     }
-                    bp = z_bin_append_posn(glyph, 5, binary, bp);
+                    z_bs_append(bs, glyph, 5);
                 } else {
                     /* Shift Mode character */
-                    bp = z_bin_append_posn(125, 7, binary, bp); /* Shift indicator */
-                    bp = gm_add_shift_char(binary, bp, ddata[sp], debug_print);
+                    z_bs_append(bs, 125, 7); /* Shift indicator */
+                    gm_add_shift_char(bs, ddata[sp], debug_print);
                 }
 
                 sp++;
                 break;
         }
-        if (bp > 9191) {
+        if (bs->bp > 9191) {
             return ZINT_ERROR_TOO_LONG;
         }
 
@@ -560,52 +567,50 @@ static int gm_encode(const unsigned int ddata[], const int length, char binary[]
 
     if (current_mode == GM_BYTE) {
         /* Add byte block length indicator */
-        gm_add_byte_count(binary, byte_count_posn, byte_count);
+        gm_add_byte_count(bs, byte_count_posn, byte_count);
     } else if (current_mode == GM_NUMERAL && numeral_cnt) {
         /* HAN numeric block padding value */
-        (void) z_bin_append_posn(3 - numeral_cnt, 2, binary, numeral_pad_posn);
+        z_bs_put(bs, 3 - numeral_cnt, 2, numeral_pad_posn);
     }
 
     /* Add "end of data" character */
     assert(current_mode >= GM_CHINESE && current_mode <= GM_BYTE);
-    bp = z_bin_append_posn(gm_mode_switch[GM_EOD][current_mode - 1], gm_mode_len[GM_EOD][current_mode - 1],
-                            binary, bp);
+    z_bs_append(bs, gm_mode_switch[GM_EOD][current_mode - 1], gm_mode_len[GM_EOD][current_mode - 1]);
 
-    if (bp > 9191) {
+    if (bs->bp > 9191) {
         return ZINT_ERROR_TOO_LONG;
     }
 
-    *p_bp = bp;
-
     if (debug_print) {
-        printf("\nBinary (%d): %.*s\n", bp, bp, binary);
+        z_bs_flush(bs);
+        printf("\nBinary (%d): ", bs->bp);
+        z_debug_print_bits(bs->buf, bs->bp);
+        fputc('\n', stdout);
     }
 
     return 0;
 }
 
 static int gm_encode_segs(const unsigned int ddata[], const struct zint_seg segs[], const int seg_count,
-            char binary[], const int reader, const struct zint_structapp *p_structapp, int *p_bin_len,
+            struct z_bitstream *bs, const int reader, const struct zint_structapp *p_structapp,
             const int debug_print) {
     int i;
     const unsigned int *dd = ddata;
-    int bp = 0;
     int padding;
 
     if (reader && (!p_structapp || p_structapp->index == 1)) { /* Appears only in 1st symbol if Structured Append */
-        bp = z_bin_append_posn(10, 4, binary, bp); /* FNC3 - Reader Initialisation */
+        z_bs_append(bs, 10, 4); /* FNC3 - Reader Initialisation */
     }
 
     if (p_structapp) {
-        bp = z_bin_append_posn(9, 4, binary, bp); /* FNC2 - Structured Append */
-        bp = z_bin_append_posn(z_to_int(ZCUCP( p_structapp->id), (int) strlen(p_structapp->id)), 8,
-                binary, bp); /* File signature */
-        bp = z_bin_append_posn(p_structapp->count - 1, 4, binary, bp);
-        bp = z_bin_append_posn(p_structapp->index - 1, 4, binary, bp);
+        z_bs_append(bs, 9, 4); /* FNC2 - Structured Append */
+        z_bs_append(bs, z_to_int(ZCUCP( p_structapp->id), (int) strlen(p_structapp->id)), 8); /* File signature */
+        z_bs_append(bs, p_structapp->count - 1, 4);
+        z_bs_append(bs, p_structapp->index - 1, 4);
     }
 
     for (i = 0; i < seg_count; i++) {
-        int error_number = gm_encode(dd, segs[i].length, binary, segs[i].eci, &bp, debug_print);
+        int error_number = gm_encode(dd, segs[i].length, bs, segs[i].eci, debug_print);
         if (error_number != 0) {
             return error_number;
         }
@@ -613,22 +618,23 @@ static int gm_encode_segs(const unsigned int ddata[], const struct zint_seg segs
     }
 
     /* Add padding bits if required */
-    padding = 7 - (bp % 7);
+    padding = 7 - (bs->bp % 7);
     if (padding % 7) {
-        bp = z_bin_append_posn(0, padding, binary, bp);
+        z_bs_append(bs, 0, padding);
     }
     /* Note bit-padding can't tip `bp` over max 9191 (1313 * 7) */
+    z_bs_flush(bs);
 
     if (debug_print) {
-        printf("\nBinary (%d): %.*s\n", bp, bp, binary);
+        printf("\nBinary (%d): ", bs->bp);
+        z_debug_print_bits(bs->buf, bs->bp);
+        fputc('\n', stdout);
     }
 
-    *p_bin_len = bp;
-
     return 0;
 }
 
-static void gm_add_ecc(const char binary[], const int num_data_cws, const int layers, const int ecc_level,
+static void gm_add_ecc(const unsigned char binary[], const int num_data_cws, const int layers, const int ecc_level,
                 unsigned char cws[]) {
     int tot_data_cws, i, j, wp;
     int n1, b1, n2, b2, e1, b3, e2;
@@ -638,9 +644,7 @@ static void gm_add_ecc(const char binary[], const int num_data_cws, const int la
 
     /* Convert from binary stream to 7-bit codewords */
     for (i = 0; i < num_data_cws; i++) {
-        for (j = 0; j < 7; j++) {
-            data[i] |= (binary[i * 7 + j] == '1') << (6 - j);
-        }
+        data[i] = (unsigned char) z_bs_get(binary, i * 7, 7);
     }
 
     tot_data_cws = gm_data_cws[layers - 1][ecc_level - 1];
@@ -751,6 +755,9 @@ static void gm_place_layer_id(char grid[], const int size, const int layers, con
     int *layer_ids = (int *) z_alloca(sizeof(int) * (layers + 1));
     int *ids = (int *) z_alloca(sizeof(int) * (macromodules_per_dim * macromodules_per_dim));
 
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Reported by API call */
+    }
     assert(layers > 0); /* Suppress clang-tidy-23 warning clang-analyzer-core.UndefinedBinaryOperatorResult */
 
     /* Calculate Layer IDs */
@@ -796,7 +803,9 @@ INTERNAL int zint_gridmatrix(struct zint_symbol *symbol, struct zint_seg segs[],
     int auto_layers, min_layers, layers, rec_ecc_level, min_rec_ecc_level, ecc_level;
     int x, y, i;
     int full_multibyte;
-    char binary[9240]; /* 1313 * 7 = 9191 + 46 (max overflow (GM_BYTE) in `gm_encode()`) + 3 */
+    /* 1313 * 7 = 9191 + 46 (max overflow (GM_BYTE) in `gm_encode()`) + 3 */
+    unsigned char binary[Z_BS_SIZE(9240)];
+    struct z_bitstream bs;
     int num_data_cws;
     unsigned char cws[1458] = {0};
     int reader = 0;
@@ -811,6 +820,10 @@ INTERNAL int zint_gridmatrix(struct zint_symbol *symbol, struct zint_seg segs[],
     unsigned int *ddata = (unsigned int *) z_alloca(sizeof(unsigned int) * eci_length_segs);
     char *grid;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     z_segs_cpy(symbol, segs, seg_count, local_segs); /* Shallow copy (needed to set default ECIs & protect lengths) */
 
     /* If ZINT_FULL_MULTIBYTE set use Hanzi mode in DATA_MODE or for non-GB 2312 in UNICODE_MODE */
@@ -887,7 +900,12 @@ INTERNAL int zint_gridmatrix(struct zint_symbol *symbol, struct zint_seg segs[],
                         symbol->eci);
     }
 
-    error_number = gm_encode_segs(ddata, local_segs, seg_count, binary, reader, p_structapp, &bin_len, debug_print);
+    z_bs_init(&bs, binary);
+    error_number = gm_encode_segs(ddata, local_segs, seg_count, &bs, reader, p_structapp, debug_print);
+    bin_len = bs.bp;
+    if (error_number == ZINT_ERROR_MEMORY) {
+        return error_number;
+    }
     if (error_number != 0) {
         return z_errtxt(error_number, symbol, 531, "Input too long, requires too many codewords (maximum 1313)");
     }
@@ -971,6 +989,9 @@ INTERNAL int zint_gridmatrix(struct zint_symbol *symbol, struct zint_seg segs[],
     size_squared = size * size;
 
     grid = (char *) z_alloca(size_squared);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     memset(grid, '0', size_squared);
 
     gm_place_data_in_grid(cws, grid, size, layers);
@@ -1682,6 +1682,10 @@ static int gs1se_verify(struct zint_symbol *symbol, const unsigned char source[]
     gs1_encoder *ctx;
     int gs1se_ret;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (length < 2 + gs1_caret) {
         return z_errtxt(ZINT_ERROR_INVALID_DATA, symbol, 802, "Data does not start with an AI");
     }
@@ -1829,6 +1833,10 @@ static int gs1se_verify(struct zint_symbol *symbol, const unsigned char source[]
         int errtxt_set = 0;
         if (errmsg_len && errmarkup_len && errmsg_len + 1 + errmarkup_len < ARRAY_SIZE(symbol->errtxt)) {
             char *local_errmarkup = (char *) z_alloca(errmarkup_len * 4 + 1);
+            if (Z_SCRATCH_FAILED()) {
+                gs1_encoder_free(ctx);
+                return ZINT_ERROR_MEMORY;
+            }
             z_debug_print_escape(ZCUCP(errmarkup), errmarkup_len, local_errmarkup);
             errmarkup_len = (int) strlen(local_errmarkup);
             if (errmsg_len + 1 + errmarkup_len < ARRAY_SIZE(symbol->errtxt)) {
@@ -2097,6 +2105,10 @@ INTERNAL int zint_gs1_verify(struct zint_symbol *symbol, const unsigned char sou
 
     *p_reduced_length = 0;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
 #ifdef ZINT_HAVE_GS1SE
     if ((symbol->input_mode & GS1SYNTAXENGINE_MODE) && !gs1nocheck_mode) {
         /* Strict verification */
@@ -2137,6 +2149,9 @@ INTERNAL int zint_gs1_verify(struct zint_symbol *symbol, const unsigned char sou
             ai_locs = (int *) z_alloca(sizeof(int) * ai_max);
             data_locs = (int *) z_alloca(sizeof(int) * ai_max);
             data_lens = (int *) z_alloca(sizeof(int) * ai_max);
+            if (Z_SCRATCH_FAILED()) {
+                return ZINT_ERROR_MEMORY;
+            }
             if (!gs1_lint_parse_raw_caret(source, length, ai_max, ai_vals, ai_locs, data_locs, data_lens, &ai_count,
                     &err_no, &err_posn)) {
                 /* Both raw & caret modes require valid AIs and underlong data lengths to work, so check regardless of
@@ -2249,6 +2264,9 @@ INTERNAL int zint_gs1_verify(struct zint_symbol *symbol, const unsigned char sou
         ai_locs = (int *) z_alloca(sizeof(int) * ai_max);
         data_locs = (int *) z_alloca(sizeof(int) * ai_max);
         data_lens = (int *) z_alloca(sizeof(int) * ai_max);
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
 
         /* Check the balance of the brackets & AI lengths */
         ai_latch = 0;
@@ -2322,6 +2340,9 @@ INTERNAL int zint_gs1_verify(struct zint_symbol *symbol, const unsigned char sou
             const unsigned char *local_source2 = local_source;
             unsigned char *local_source2_buf = (unsigned char *) z_alloca(local_length + 1);
             int ai_count = 0;
+            if (Z_SCRATCH_FAILED()) {
+                return ZINT_ERROR_MEMORY;
+            }
             for (i = 1; i < local_length; i++) {
                 if (local_source[i - 1] == obracket) {
                     ai_locs[ai_count] = i - 1;
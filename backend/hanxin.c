@@ -392,6 +392,10 @@ static void hx_define_modes(char *modes, const unsigned int ddata[], const int l
     unsigned int cur_costs[HX_NUM_MODES];
     char (*char_modes)[HX_NUM_MODES] = (char (*)[HX_NUM_MODES]) z_alloca(HX_NUM_MODES * length);
 
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
+
     /* char_modes[i][j] represents the mode to encode the code point at index i such that the final segment
        ends in mode_types[j] and the total number of bits is minimized over all possible choices */
     memset(char_modes, 0, HX_NUM_MODES * length);
@@ -508,27 +512,26 @@ static void hx_define_modes_segs(char modes[], const unsigned int ddata[], const
 }
 
 /* Convert input data to binary stream */
-static void hx_calculate_binary(char binary[], const char modes[], const unsigned int ddata[], const int length,
-            const int eci, int *p_bp, const int debug_print) {
+static void hx_calculate_binary(struct z_bitstream *bs, const char modes[], const unsigned int ddata[],
+            const int length, const int eci, const int debug_print) {
     int position = 0;
     int i, count, encoding_value;
     int first_byte, second_byte;
     int third_byte, fourth_byte;
     int glyph;
     int submode;
-    int bp = *p_bp;
 
     if (eci != 0) {
         /* Encoding ECI assignment number, according to Table 5 */
-        bp = z_bin_append_posn(8, 4, binary, bp); /* ECI */
+        z_bs_append(bs, 8, 4); /* ECI */
         if (eci <= 127) {
-            bp = z_bin_append_posn(eci, 8, binary, bp);
+            z_bs_append(bs, eci, 8);
         } else if (eci <= 16383) {
-            bp = z_bin_append_posn(2, 2, binary, bp);
-            bp = z_bin_append_posn(eci, 14, binary, bp);
+            z_bs_append(bs, 2, 2);
+            z_bs_append(bs, eci, 14);
         } else {
-            bp = z_bin_append_posn(6, 3, binary, bp);
-            bp = z_bin_append_posn(eci, 21, binary, bp);
+            z_bs_append(bs, 6, 3);
+            z_bs_append(bs, eci, 21);
         }
     }
 
@@ -546,7 +549,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
             case 'n':
                 /* Numeric mode */
                 /* Mode indicator */
-                bp = z_bin_append_posn(1, 4, binary, bp);
+                z_bs_append(bs, 1, 4);
 
                 if (debug_print) {
                     printf("Numeric (N%d): ", block_length);
@@ -572,7 +575,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                         }
                     }
 
-                    bp = z_bin_append_posn(encoding_value, 10, binary, bp);
+                    z_bs_append(bs, encoding_value, 10);
 
                     if (debug_print) {
                         printf(" 0x%3x(%d)", encoding_value, encoding_value);
@@ -584,13 +587,13 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                 /* Mode terminator depends on number of characters in last group (Table 2) */
                 switch (count) {
                     case 1:
-                        bp = z_bin_append_posn(1021, 10, binary, bp);
+                        z_bs_append(bs, 1021, 10);
                         break;
                     case 2:
-                        bp = z_bin_append_posn(1022, 10, binary, bp);
+                        z_bs_append(bs, 1022, 10);
                         break;
                     case 3:
-                        bp = z_bin_append_posn(1023, 10, binary, bp);
+                        z_bs_append(bs, 1023, 10);
                         break;
                 }
 
@@ -602,7 +605,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
             case 't':
                 /* Text mode */
                 /* Mode indicator */
-                bp = z_bin_append_posn(2, 4, binary, bp);
+                z_bs_append(bs, 2, 4);
 
                 if (debug_print) {
                     printf("Text (T%d):", block_length);
@@ -616,7 +619,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
 
                     if (hx_getsubmode(ddata[i + position]) != submode) {
                         /* Change submode */
-                        bp = z_bin_append_posn(62, 6, binary, bp);
+                        z_bs_append(bs, 62, 6);
                         submode = hx_getsubmode(ddata[i + position]);
                         if (debug_print) {
                             fputs(" SWITCH", stdout);
@@ -629,7 +632,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                         encoding_value = hx_lookup_text2(ddata[i + position]);
                     }
 
-                    bp = z_bin_append_posn(encoding_value, 6, binary, bp);
+                    z_bs_append(bs, encoding_value, 6);
 
                     if (debug_print) {
                         printf(" %.2x[ASC %.2x]", encoding_value, ddata[i + position]);
@@ -638,7 +641,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                 }
 
                 /* Terminator */
-                bp = z_bin_append_posn(63, 6, binary, bp);
+                z_bs_append(bs, 63, 6);
 
                 if (debug_print) {
                     fputs("\n", stdout);
@@ -647,10 +650,10 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
             case 'b':
                 /* Binary Mode */
                 /* Mode indicator */
-                bp = z_bin_append_posn(3, 4, binary, bp);
+                z_bs_append(bs, 3, 4);
 
                 /* Count indicator */
-                bp = z_bin_append_posn(block_length + double_byte, 13, binary, bp);
+                z_bs_append(bs, block_length + double_byte, 13);
 
                 if (debug_print) {
                     printf("Binary Mode (B%d):", block_length + double_byte);
@@ -661,7 +664,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                 while (i < block_length) {
 
                     /* 8-bit bytes with no conversion */
-                    bp = z_bin_append_posn(ddata[i + position], ddata[i + position] > 0xFF ? 16 : 8, binary, bp);
+                    z_bs_append(bs, ddata[i + position], ddata[i + position] > 0xFF ? 16 : 8);
 
                     if (debug_print) {
                         printf(" %02x", (int) ddata[i + position]);
@@ -678,7 +681,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                 /* Region One encoding */
                 /* Mode indicator */
                 if (position == 0 || modes[position - 1] != '2') { /* Unless previous mode Region Two */
-                    bp = z_bin_append_posn(4, 4, binary, bp);
+                    z_bs_append(bs, 4, 4);
                 }
 
                 if (debug_print) {
@@ -711,13 +714,13 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                         printf(" %.3x[GB %.4x]", glyph, ddata[i + position]);
                     }
 
-                    bp = z_bin_append_posn(glyph, 12, binary, bp);
+                    z_bs_append(bs, glyph, 12);
                     i++;
                 }
 
                 /* Terminator */
-                bp = z_bin_append_posn(position + block_length == length || modes[position + block_length] != '2'
-                                        ? 4095 : 4094, 12, binary, bp);
+                z_bs_append(bs, position + block_length == length || modes[position + block_length] != '2'
+                            ? 4095 : 4094, 12);
 
                 if (debug_print) {
                     printf(" (TERM %x)\n", position + block_length == length || modes[position + block_length] != '2'
@@ -729,7 +732,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                 /* Region Two encoding */
                 /* Mode indicator */
                 if (position == 0 || modes[position - 1] != '1') { /* Unless previous mode Region One */
-                    bp = z_bin_append_posn(5, 4, binary, bp);
+                    z_bs_append(bs, 5, 4);
                 }
 
                 if (debug_print) {
@@ -749,13 +752,13 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                         printf(" %.3x[GB %.4x]", glyph, ddata[i + position]);
                     }
 
-                    bp = z_bin_append_posn(glyph, 12, binary, bp);
+                    z_bs_append(bs, glyph, 12);
                     i++;
                 }
 
                 /* Terminator */
-                bp = z_bin_append_posn(position + block_length == length || modes[position + block_length] != '1'
-                                        ? 4095 : 4094, 12, binary, bp);
+                z_bs_append(bs, position + block_length == length || modes[position + block_length] != '1'
+                            ? 4095 : 4094, 12);
 
                 if (debug_print) {
                     printf(" (TERM %x)\n", position + block_length == length || modes[position + block_length] != '1'
@@ -766,7 +769,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
             case 'd':
                 /* Double byte encoding */
                 /* Mode indicator */
-                bp = z_bin_append_posn(6, 4, binary, bp);
+                z_bs_append(bs, 6, 4);
 
                 if (debug_print) {
                     printf("Double byte (H(d)%d):", block_length);
@@ -788,12 +791,12 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                         printf("%.4x ", glyph);
                     }
 
-                    bp = z_bin_append_posn(glyph, 15, binary, bp);
+                    z_bs_append(bs, glyph, 15);
                     i++;
                 }
 
                 /* Terminator */
-                bp = z_bin_append_posn(32767, 15, binary, bp);
+                z_bs_append(bs, 32767, 15);
                 /* Terminator sequence of length 12 is a mistake
                    - confirmed by Wang Yi */
 
@@ -812,7 +815,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                 while (i < block_length) {
 
                     /* Mode indicator */
-                    bp = z_bin_append_posn(7, 4, binary, bp);
+                    z_bs_append(bs, 7, 4);
 
                     first_byte = (ddata[i + position] & 0xFF00) >> 8;
                     second_byte = ddata[i + position] & 0xFF;
@@ -826,7 +829,7 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
                         printf(" %d", glyph);
                     }
 
-                    bp = z_bin_append_posn(glyph, 21, binary, bp);
+                    z_bs_append(bs, glyph, 21);
                     i += 2;
                 }
 
@@ -842,26 +845,27 @@ static void hx_calculate_binary(char binary[], const char modes[], const unsigne
 
     } while (position < length);
 
-    if (debug_print) printf("Binary (%d): %.*s\n", bp, bp, binary);
-
-    *p_bp = bp;
+    if (debug_print) {
+        z_bs_flush(bs);
+        printf("Binary (%d): ", bs->bp);
+        z_debug_print_bits(bs->buf, bs->bp);
+        fputc('\n', stdout);
+    }
 }
 
 /* Call `hx_calculate_binary()` for each segment */
-static void hx_calculate_binary_segs(char binary[], const char modes[], const unsigned int ddata[],
-            const struct zint_seg segs[], const int seg_count, int *p_bin_len, const int debug_print) {
+static void hx_calculate_binary_segs(struct z_bitstream *bs, const char modes[], const unsigned int ddata[],
+            const struct zint_seg segs[], const int seg_count, const int debug_print) {
     int i;
     const unsigned int *dd = ddata;
     const char *mds = modes;
-    int bp = 0;
 
     for (i = 0; i < seg_count; i++) {
-        hx_calculate_binary(binary, mds, dd, segs[i].length, segs[i].eci, &bp, debug_print);
+        hx_calculate_binary(bs, mds, dd, segs[i].length, segs[i].eci, debug_print);
         mds += segs[i].length;
         dd += segs[i].length;
     }
-
-    *p_bin_len = bp;
+    z_bs_flush(bs);
 }
 
 /* Finder pattern for top left of symbol */
@@ -1390,6 +1394,10 @@ static int hx_apply_bitmask(unsigned char *grid, const int size, const int versi
     unsigned char *mask = (unsigned char *) z_alloca(size_squared);
     unsigned char *local = (unsigned char *) z_alloca(size_squared);
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
     /* Perform data masking */
     memset(mask, 0, size_squared);
     for (y = 0; y < size; y++) {
@@ -1496,12 +1504,17 @@ INTERNAL int zint_hanxin(struct zint_symbol *symbol, struct zint_seg segs[], con
     struct zint_seg *local_segs = (struct zint_seg *) z_alloca(sizeof(struct zint_seg) * seg_count);
     unsigned int *ddata = (unsigned int *) z_alloca(sizeof(unsigned int) * eci_length_segs);
     char *modes = (char *) z_alloca(eci_length_segs);
-    char *binary;
+    unsigned char *binary;
+    struct z_bitstream bs;
     unsigned char *datastream;
     unsigned char *fullstream;
     unsigned char *picket_fence;
     unsigned char *grid;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     z_segs_cpy(symbol, segs, seg_count, local_segs); /* Shallow copy (needed to set default ECI & protect lengths) */
 
     /* If ZINT_FULL_MULTIBYTE set use Hanzi mode in DATA_MODE or for non-GB 18030 in UNICODE_MODE */
@@ -1548,19 +1561,24 @@ INTERNAL int zint_hanxin(struct zint_symbol *symbol, struct zint_seg segs[], con
     }
 
     hx_define_modes_segs(modes, ddata, local_segs, seg_count, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     est_binlen = hx_calc_binlen_segs(modes, ddata, local_segs, seg_count);
     if (debug_print) {
         printf("Estimated binary length: %d\n", est_binlen);
     }
 
-    binary = (char *) malloc(est_binlen + 1);
+    binary = (unsigned char *) malloc(Z_BS_SIZE(est_binlen));
 
     if (ecc_level <= 0 || ecc_level >= 5) {
         ecc_level = 1;
     }
 
-    hx_calculate_binary_segs(binary, modes, ddata, local_segs, seg_count, &bin_len, debug_print);
+    z_bs_init(&bs, binary);
+    hx_calculate_binary_segs(&bs, modes, ddata, local_segs, seg_count, debug_print);
+    bin_len = bs.bp;
     codewords = bin_len >> 3;
     if (bin_len & 0x07) {
         codewords++;
@@ -1632,14 +1650,13 @@ INTERNAL int zint_hanxin(struct zint_symbol *symbol, struct zint_seg segs[], con
     fullstream = (unsigned char *) z_alloca(hx_total_codewords[version - 1]);
     picket_fence = (unsigned char *) z_alloca(hx_total_codewords[version - 1]);
     grid = (unsigned char *) z_alloca(size_squared);
-
-    memset(datastream, 0, data_codewords);
-
-    for (i = 0; i < bin_len; i++) {
-        if (binary[i] == '1') {
-            datastream[i >> 3] |= 0x80 >> (i & 0x07);
-        }
+    if (Z_SCRATCH_FAILED()) {
+        free(binary);
+        return ZINT_ERROR_MEMORY;
     }
+
+    memcpy(datastream, binary, codewords);
+    memset(datastream + codewords, 0, data_codewords - codewords);
     free(binary);
 
     if (debug_print) {
@@ -1652,10 +1669,10 @@ INTERNAL int zint_hanxin(struct zint_symbol *symbol, struct zint_seg segs[], con
 #ifdef ZINT_TEST
     if (symbol->debug & ZINT_DEBUG_TEST) z_debug_test_codeword_dump(symbol, datastream, data_codewords);
 #endif
-
-    hx_setup_grid(grid, size, version);
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
 
     hx_add_ecc(fullstream, datastream, data_codewords, version, ecc_level);
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
 
     if (debug_print) {
         printf("Fullstream (%d):", hx_total_codewords[version - 1]);
@@ -1667,6 +1684,8 @@ INTERNAL int zint_hanxin(struct zint_symbol *symbol, struct zint_seg segs[], con
 
     hx_make_picket_fence(fullstream, picket_fence, hx_total_codewords[version - 1]);
 
+    hx_setup_grid(grid, size, version);
+
     /* Populate grid */
     j = 0;
     j_max = hx_total_codewords[version - 1] * 8;
@@ -1682,8 +1701,13 @@ INTERNAL int zint_hanxin(struct zint_symbol *symbol, struct zint_seg segs[], con
             }
         }
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
 
     bitmask = hx_apply_bitmask(grid, size, version, ecc_level, user_mask, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_MASK);
 
     /* Feedback options */
     symbol->option_1 = ecc_level;
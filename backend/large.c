@@ -285,6 +285,9 @@ INTERNAL void zint_large_uchar_array(const large_uint *t, unsigned char *uchar_a
     int i;
     unsigned int *uint_array = (unsigned int *) z_alloca(sizeof(unsigned int) * (size ? size : 1));
 
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Reported by API call */
+    }
     zint_large_uint_array(t, uint_array, size, bits);
 
     for (i = 0; i < size; i++) {
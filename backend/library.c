@@ -145,6 +145,8 @@ void ZBarcode_Reset(struct zint_symbol *symbol) {
 
     z_ct_free_segs(symbol);
     zint_vector_free(symbol);
+    z_trace_free(symbol);
+    free(symbol->delta);
 
     memset(symbol, 0, sizeof(*symbol));
     set_symbol_defaults(symbol);
@@ -163,6 +165,8 @@ void ZBarcode_Delete(struct zint_symbol *symbol) {
 
     z_ct_free_segs(symbol);
     zint_vector_free(symbol);
+    z_trace_free(symbol);
+    free(symbol->delta);
 
     free(symbol);
 }
@@ -242,8 +246,14 @@ INTERNAL LIB_DECL_FUNC_SRC(zint_dxfilmedge); /* DX Film Edge Barcode */
 /* Output handlers */
 /* Plot to BMP/GIF/PCX/PNG/TIF */
 INTERNAL int zint_plot_raster(struct zint_symbol *symbol, int rotate_angle, int file_type);
-/* Plot to EMF/EPS/SVG */
+/* Plot to EMF/EPS/PDF/SVG */
 INTERNAL int zint_plot_vector(struct zint_symbol *symbol, int rotate_angle, int file_type);
+/* Plot sheet of symbols to BMP/GIF/PCX/PNG/TIF */
+INTERNAL int zint_plot_raster_sheet(struct zint_symbol *symbols[], const int symbol_cnt,
+                const struct zint_sheet *sheet, const int rotate_angle, const int file_type);
+/* Plot sheet of symbols to EPS/PDF/SVG */
+INTERNAL int zint_plot_vector_sheet(struct zint_symbol *symbols[], const int symbol_cnt,
+                const struct zint_sheet *sheet, const int rotate_angle, const int file_type);
 
 /* Helper to convert `error_number` based on `warn_level` */
 static int error_warn_level(int error_number, struct zint_symbol *symbol) {
@@ -612,11 +622,18 @@ static int reduced_charset(struct zint_symbol *symbol, struct zint_seg segs[], c
     struct zint_seg *local_segs = (struct zint_seg *) z_alloca(sizeof(struct zint_seg) * seg_count);
     int *convertible = (int *) z_alloca(sizeof(int) * seg_count);
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if ((symbol->input_mode & 0x07) == UNICODE_MODE && zint_is_eci_convertible_segs(segs, seg_count, convertible)) {
         unsigned char *preprocessed;
         const int eci_length_segs = zint_get_eci_length_segs(segs, seg_count);
         unsigned char *preprocessed_buf = (unsigned char *) z_alloca(eci_length_segs + seg_count);
 
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
         /* Prior check ensures ECI only set for those that support it */
         z_segs_cpy(symbol, segs, seg_count, local_segs); /* Shallow copy (needed to set default ECIs) */
         preprocessed = preprocessed_buf;
@@ -967,8 +984,26 @@ int ZBarcode_Encode(struct zint_symbol *symbol, const unsigned char *source, int
     return ZBarcode_Encode_Segs(symbol, segs, 1);
 }
 
-/* Encode a barcode with multiple ECI segments. */
-int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[], const int seg_count) {
+/* Encode a barcode, patching the previous `ZBarcode_Encode_Delta()` encode of `symbol` if only some of its
+   codewords differ (QR Code and Data Matrix only), else as `ZBarcode_Encode()` */
+int ZBarcode_Encode_Delta(struct zint_symbol *symbol, const unsigned char *source, int length) {
+    int error_number;
+
+    if (!symbol) return ZINT_ERROR_INVALID_DATA;
+
+    if (!symbol->delta && !(symbol->delta = (struct zint_delta *) calloc(1, sizeof(struct zint_delta)))) {
+        return ZBarcode_Encode(symbol, source, length); /* Best effort, full encode */
+    }
+
+    symbol->delta->armed = 1;
+    error_number = ZBarcode_Encode(symbol, source, length);
+    symbol->delta->armed = 0;
+
+    return error_number;
+}
+
+/* Encode a barcode with multiple ECI segments (see `ZBarcode_Encode_Segs()` below) */
+static int encode_segs(struct zint_symbol *symbol, const struct zint_seg segs[], const int seg_count) {
     int error_number, warn_number = 0;
     int total_len = 0;
     int have_zero_eci = 0;
@@ -1009,6 +1044,9 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
     content_segs = symbol->output_options & BARCODE_CONTENT_SEGS;
 
     local_segs = (struct zint_seg *) z_alloca(sizeof(struct zint_seg) * (seg_count > 0 ? seg_count : 1));
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     /* Check segment lengths */
     for (i = 0; i < seg_count; i++) {
@@ -1062,7 +1100,10 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
         const int len = local_segs[0].length;
         const int primary_len = symbol->primary[0] ? (int) strlen(symbol->primary) : 0;
         char name[32];
-        char source[10001]; /* 2000*5 + 1 = 10001 */
+        Z_LARGE_ARRAY(char, source, 10001); /* 2000*5 + 1 = 10001 */
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
         (void) ZBarcode_BarcodeName(symbol->symbology, name);
         z_debug_print_escape(local_segs[0].source, len > 2000 ? 2000 : len, source);
         printf("\nZBarcode_Encode_Segs: %s (%d), height %g, scale: %g, whitespace: (%d, %d), border_width: %d\n"
@@ -1175,6 +1216,9 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
     }
 
     local_sources = (unsigned char *) z_alloca(total_len + seg_count);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     /* Copy input, de-escaping if required */
     for (i = 0, local_source = local_sources; i < seg_count; i++) {
@@ -1231,6 +1275,9 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
 
         if (is_composite || !check_force_gs1(symbol->symbology)) {
             unsigned char *reduced = (unsigned char *) z_alloca(local_segs[0].length + 1);
+            if (Z_SCRATCH_FAILED()) {
+                return ZINT_ERROR_MEMORY;
+            }
             error_number = zint_gs1_verify(symbol, local_segs[0].source, local_segs[0].length, reduced,
                                             &local_segs[0].length, 0 /*set_hrt*/);
             if (error_number) {
@@ -1263,6 +1310,8 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
         }
     }
 
+    Z_STATS_LAP(symbol, ZINT_STATS_INPUT);
+
     error_number = extended_or_reduced_charset(symbol, local_segs, seg_count);
 
     if (error_number == ZINT_ERROR_INVALID_DATA && have_zero_eci && supports_eci(symbol->symbology)
@@ -1300,6 +1349,46 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
     return error_number;
 }
 
+/* Encode a barcode with multiple ECI segments, accumulating stats if ZINT_DEBUG_STATS and recording trace events
+   if ZINT_DEBUG_TRACE */
+int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[], const int seg_count) {
+    int error_number;
+    double stats_start;
+    int length = 0;
+    int i;
+
+    if (!symbol || !Z_STATS_ON(symbol)) {
+        Z_SCRATCH_ENTER();
+        error_number = encode_segs(symbol, segs, seg_count);
+        if (Z_SCRATCH_LEAVE() && symbol) {
+            error_number = error_tag(ZINT_ERROR_MEMORY, symbol, 246, "Insufficient memory for scratch arena");
+        }
+        return error_number;
+    }
+
+    if (segs) {
+        for (i = 0; i < seg_count && i < ZINT_MAX_SEG_COUNT; i++) {
+            if (segs[i].source) {
+                length += segs[i].length > 0 ? segs[i].length : (int) z_ustrlen(segs[i].source);
+            }
+        }
+    }
+    z_trace_start(symbol, length);
+
+    stats_start = Z_STATS_MARK(symbol);
+    Z_SCRATCH_ENTER();
+    error_number = encode_segs(symbol, segs, seg_count);
+    if (Z_SCRATCH_LEAVE()) {
+        error_number = error_tag(ZINT_ERROR_MEMORY, symbol, 246, "Insufficient memory for scratch arena");
+    }
+    Z_STATS_ADD(symbol, ZINT_STATS_ENCODE, stats_start);
+    if (error_number < ZINT_ERROR) {
+        symbol->stats.bytes_in += length;
+    }
+
+    return error_number;
+}
+
 /* Helper for output routines to check `rotate_angle` and dottiness */
 static int check_output_args(struct zint_symbol *symbol, int rotate_angle) {
 
@@ -1325,8 +1414,10 @@ static int check_output_args(struct zint_symbol *symbol, int rotate_angle) {
 
 static const struct { const char extension[4]; int is_raster; int filetype; } filetypes[] = {
     { "BMP", 1, OUT_BMP_FILE }, { "EMF", 0, OUT_EMF_FILE }, { "EPS", 0, OUT_EPS_FILE },
-    { "GIF", 1, OUT_GIF_FILE }, { "PCX", 1, OUT_PCX_FILE }, { "PNG", 1, OUT_PNG_FILE },
-    { "SVG", 0, OUT_SVG_FILE }, { "TIF", 1, OUT_TIF_FILE }, { "TXT", 0, 0 }
+    { "GIF", 1, OUT_GIF_FILE }, { "PBM", 1, OUT_PBM_FILE }, { "PCX", 1, OUT_PCX_FILE },
+    { "PDF", 0, OUT_PDF_FILE }, { "PNG", 1, OUT_PNG_FILE }, { "POS", 1, OUT_POS_FILE },
+    { "SVG", 0, OUT_SVG_FILE }, { "TIF", 1, OUT_TIF_FILE }, { "TXT", 0, 0 },
+    { "ZMM", 0, OUT_ZMM_FILE }, { "ZPL", 1, OUT_ZPL_FILE }
 };
 
 /* Return index of `extension` in `filetypes`, or -1 if not found */
@@ -1407,6 +1498,62 @@ static int txt_hex_plot(struct zint_symbol *symbol) {
     return 0;
 }
 
+/* Output module matrix ("ZMM") binary, little-endian: "ZMM" and version byte 1, uint16 symbology, uint16 flags
+   (bit 0 set if colour, i.e. ULTRA), uint32 rows, uint32 width, float32 height, `rows` float32 row heights, then
+   `rows` rows of modules straight from `encoded_data` - if colour 1 byte per module (colour 0-8), otherwise
+   `(width + 7) / 8` bytes with module `x` in bit `x & 7` of byte `x >> 3` (i.e. LSB-first) */
+static int zmm_plot(struct zint_symbol *symbol) {
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    unsigned char header[20] = { 'Z', 'M', 'M', 1 };
+    unsigned char buf[4];
+    unsigned char row[sizeof(symbol->encoded_data[0])];
+    const int is_colour = symbol->symbology == BARCODE_ULTRA;
+    const int bytes_per_row = is_colour ? symbol->width : (symbol->width + 7) >> 3;
+    uint32_t bits;
+    int r;
+
+    if (!zint_fm_open(fmp, symbol, "wb")) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_ACCESS, symbol, 627, "Could not open ZMM output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    zint_out_le_u16(header[4], symbol->symbology);
+    zint_out_le_u16(header[6], is_colour);
+    zint_out_le_u32(header[8], symbol->rows);
+    zint_out_le_u32(header[12], symbol->width);
+    memcpy(&bits, &symbol->height, 4); /* Assuming IEEE 754 */
+    zint_out_le_u32(header[16], bits);
+    zint_fm_write(header, 1, sizeof(header), fmp);
+
+    for (r = 0; r < symbol->rows; r++) {
+        memcpy(&bits, &symbol->row_height[r], 4);
+        zint_out_le_u32(buf[0], bits);
+        zint_fm_write(buf, 1, 4, fmp);
+    }
+
+    for (r = 0; r < symbol->rows; r++) {
+        memcpy(row, symbol->encoded_data[r], bytes_per_row);
+        if (!is_colour && (symbol->width & 0x07)) {
+            row[bytes_per_row - 1] &= (1 << (symbol->width & 0x07)) - 1; /* Zero any bits past `width` */
+        }
+        zint_fm_write(row, 1, bytes_per_row, fmp);
+    }
+
+    if (zint_fm_error(fmp)) {
+        ZEXT z_errtxtf(0, symbol, 628, "Incomplete write of ZMM output (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+        (void) zint_fm_close(fmp, symbol);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+
+    if (!zint_fm_close(fmp, symbol)) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_WRITE, symbol, 629, "Failure on closing ZMM output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    return 0;
+}
+
 /* Output a previously encoded symbol to file `symbol->outfile` */
 int ZBarcode_Print(struct zint_symbol *symbol, int rotate_angle) {
     int error_number;
@@ -1423,7 +1570,12 @@ int ZBarcode_Print(struct zint_symbol *symbol, int rotate_angle) {
     if (len > 3) {
         int i = filetype_idx(symbol->outfile + len - 3);
         if (i >= 0) {
-            if (filetypes[i].filetype) {
+            const double stats_start = Z_STATS_MARK(symbol);
+            Z_SCRATCH_ENTER();
+            if (filetypes[i].filetype == OUT_ZMM_FILE) {
+                error_number = zmm_plot(symbol);
+                Z_STATS_LAP(symbol, ZINT_STATS_FILE);
+            } else if (filetypes[i].filetype) {
                 if (filetypes[i].is_raster) {
                     error_number = zint_plot_raster(symbol, rotate_angle, filetypes[i].filetype);
                 } else {
@@ -1431,7 +1583,12 @@ int ZBarcode_Print(struct zint_symbol *symbol, int rotate_angle) {
                 }
             } else {
                 error_number = txt_hex_plot(symbol);
+                Z_STATS_LAP(symbol, ZINT_STATS_FILE);
             }
+            if (Z_SCRATCH_LEAVE()) {
+                error_number = z_errtxt(ZINT_ERROR_MEMORY, symbol, 246, "Insufficient memory for scratch arena");
+            }
+            Z_STATS_ADD(symbol, ZINT_STATS_OUTPUT, stats_start);
         } else {
             return error_tag(ZINT_ERROR_INVALID_OPTION, symbol, 225, "Unknown output format");
         }
@@ -1445,24 +1602,38 @@ int ZBarcode_Print(struct zint_symbol *symbol, int rotate_angle) {
 /* Output a previously encoded symbol to memory as raster (`symbol->bitmap`) */
 int ZBarcode_Buffer(struct zint_symbol *symbol, int rotate_angle) {
     int error_number;
+    double stats_start;
 
     if ((error_number = check_output_args(symbol, rotate_angle))) { /* >= ZINT_ERROR only */
         return error_number; /* Already tagged */
     }
 
+    stats_start = Z_STATS_MARK(symbol);
+    Z_SCRATCH_ENTER();
     error_number = zint_plot_raster(symbol, rotate_angle, OUT_BUFFER);
+    if (Z_SCRATCH_LEAVE()) {
+        error_number = z_errtxt(ZINT_ERROR_MEMORY, symbol, 246, "Insufficient memory for scratch arena");
+    }
+    Z_STATS_ADD(symbol, ZINT_STATS_OUTPUT, stats_start);
     return error_tag(error_number, symbol, -1, NULL);
 }
 
 /* Output a previously encoded symbol to memory as vector (`symbol->vector`) */
 int ZBarcode_Buffer_Vector(struct zint_symbol *symbol, int rotate_angle) {
     int error_number;
+    double stats_start;
 
     if ((error_number = check_output_args(symbol, rotate_angle))) { /* >= ZINT_ERROR only */
         return error_number; /* Already tagged */
     }
 
+    stats_start = Z_STATS_MARK(symbol);
+    Z_SCRATCH_ENTER();
     error_number = zint_plot_vector(symbol, rotate_angle, OUT_BUFFER);
+    if (Z_SCRATCH_LEAVE()) {
+        error_number = z_errtxt(ZINT_ERROR_MEMORY, symbol, 246, "Insufficient memory for scratch arena");
+    }
+    Z_STATS_ADD(symbol, ZINT_STATS_OUTPUT, stats_start);
     return error_tag(error_number, symbol, -1, NULL);
 }
 
@@ -1670,6 +1841,75 @@ int ZBarcode_Encode_File_and_Print(struct zint_symbol *symbol, const char *filen
     return error_number ? error_number : warn_number;
 }
 
+/* Output `symbol_count` previously encoded `symbols` laid out on pages per `sheet` to file `symbols[0]->outfile` */
+int ZBarcode_Print_Sheet(struct zint_symbol *symbols[], int symbol_count, const struct zint_sheet *sheet,
+        int rotate_angle) {
+    struct zint_symbol *symbol;
+    int error_number;
+    int len, i, cols;
+    double stats_start;
+
+    if (!symbols || !symbols[0]) return ZINT_ERROR_INVALID_DATA;
+    symbol = symbols[0];
+
+    if (symbol_count <= 0) {
+        return error_tag(ZINT_ERROR_INVALID_DATA, symbol, 906, "Invalid symbol count, must be at least 1");
+    }
+    if (!sheet) {
+        return error_tag(ZINT_ERROR_INVALID_DATA, symbol, 907, "Sheet layout NULL");
+    }
+    if (!(sheet->margin >= 0.0f && sheet->margin <= 1000.0f) || !(sheet->gap >= 0.0f && sheet->gap <= 1000.0f)) {
+        return error_tag(ZINT_ERROR_INVALID_OPTION, symbol, 908, "Invalid sheet margin or gap (0 to 1000 only)");
+    }
+    for (i = 0; i < symbol_count; i++) {
+        if (!symbols[i]) {
+            ZEXT z_errtxtf(0, symbol, 909, "Sheet symbol %d NULL", i + 1);
+            return error_tag(ZINT_ERROR_INVALID_DATA, symbol, -1, NULL);
+        }
+        if ((error_number = check_output_args(symbols[i], rotate_angle))) { /* >= ZINT_ERROR only */
+            if (i) {
+                memcpy(symbol->errtxt, symbols[i]->errtxt, sizeof(symbol->errtxt));
+            }
+            return error_number; /* Already tagged */
+        }
+    }
+
+    len = (int) strlen(symbol->outfile);
+    if (len >= (int) sizeof(symbol->outfile)) {
+        return error_tag(ZINT_ERROR_INVALID_DATA, symbol, 910, "Invalid outfile, must be NUL-terminated");
+    }
+    if (len <= 3 || (i = filetype_idx(symbol->outfile + len - 3)) < 0) {
+        return error_tag(ZINT_ERROR_INVALID_OPTION, symbol, 911, "Unknown output format");
+    }
+    if (!filetypes[i].filetype || filetypes[i].filetype == OUT_EMF_FILE || filetypes[i].filetype == OUT_ZMM_FILE) {
+        ZEXT z_errtxtf(0, symbol, 912, "Sheet output not available for %s format", filetypes[i].extension);
+        return error_tag(ZINT_ERROR_INVALID_OPTION, symbol, -1, NULL);
+    }
+
+    /* Separate files per page can't be output to stdout or memory */
+    cols = sheet->cols > 0 ? sheet->cols : 1;
+    if (sheet->rows > 0 && (symbol_count + cols - 1) / cols > sheet->rows
+            && (symbol->output_options & (BARCODE_STDOUT | BARCODE_MEMORY_FILE))
+            && filetypes[i].filetype != OUT_TIF_FILE && filetypes[i].filetype != OUT_PDF_FILE) {
+        return error_tag(ZINT_ERROR_INVALID_OPTION, symbol, 913,
+                        "Multiple sheet pages to stdout or memory require TIF or PDF format");
+    }
+
+    stats_start = Z_STATS_MARK(symbol);
+    Z_SCRATCH_ENTER();
+    if (filetypes[i].is_raster) {
+        error_number = zint_plot_raster_sheet(symbols, symbol_count, sheet, rotate_angle, filetypes[i].filetype);
+    } else {
+        error_number = zint_plot_vector_sheet(symbols, symbol_count, sheet, rotate_angle, filetypes[i].filetype);
+    }
+    if (Z_SCRATCH_LEAVE()) {
+        error_number = z_errtxt(ZINT_ERROR_MEMORY, symbol, 246, "Insufficient memory for scratch arena");
+    }
+    Z_STATS_ADD(symbol, ZINT_STATS_OUTPUT, stats_start);
+
+    return error_tag(error_number, symbol, -1, NULL);
+}
+
 /* Encode a symbol using input data from file `filename` and output to memory as raster (`symbol->bitmap`) */
 int ZBarcode_Encode_File_and_Buffer(struct zint_symbol *symbol, char const *filename, int rotate_angle) {
     int error_number;
@@ -2156,7 +2396,8 @@ float ZBarcode_XdimDp_From_Scale(int symbol_id, float scale, float xdim_mm_or_dp
         return 0.0f;
     }
     if (filetype && *filetype) {
-        if ((i = filetype_idx(filetype)) < 0 || filetypes[i].filetype == 0) { /* Not found or TXT */
+        if ((i = filetype_idx(filetype)) < 0 || filetypes[i].filetype == 0 || filetypes[i].filetype == OUT_ZMM_FILE) {
+            /* Not found or TXT/ZMM */
             return 0.0f;
         }
     } else {
@@ -2192,7 +2433,8 @@ static int is_valid_char_set_eci(const int eci) {
 
 /* Convert UTF-8 `source` of length `length` to `eci`-encoded `dest`, setting `p_dest_length` to length of `dest`
    on output. If `length` is 0 or negative, `source` must be NUL-terminated. Returns 0 on success, else
-   ZINT_ERROR_INVALID_OPTION or ZINT_ERROR_INVALID_DATA. Compatible with libzueci `zueci_utf8_to_eci()` */
+   ZINT_ERROR_INVALID_OPTION or ZINT_ERROR_INVALID_DATA (or ZINT_ERROR_MEMORY if built with ZINT_SMALL_STACK).
+   Compatible with libzueci `zueci_utf8_to_eci()` */
 int ZBarcode_UTF8_To_ECI(int eci, const unsigned char *source, int length, unsigned char dest[], int *p_dest_length) {
     int error_number;
 
@@ -2217,7 +2459,12 @@ int ZBarcode_UTF8_To_ECI(int eci, const unsigned char *source, int length, unsig
     }
 
     /* Only set `p_dest_length` on success, for libzueci compatibility */
-    if ((error_number = zint_utf8_to_eci(eci, source, dest, &length)) == 0) {
+    Z_SCRATCH_ENTER();
+    error_number = zint_utf8_to_eci(eci, source, dest, &length);
+    if (Z_SCRATCH_LEAVE()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    if (error_number == 0) {
         *p_dest_length = length;
     }
     return error_number; /* 0 or ZINT_ERROR_INVALID_DATA */
@@ -2245,6 +2492,96 @@ int ZBarcode_Dest_Len_ECI(int eci, const unsigned char *source, int length, int
     return 0;
 }
 
+#define SEQ_MAX_DIGITS 18 /* Maximum number of digits of a sequence item */
+
+/* Parse NUL-terminated decimal `str` of 1 to `SEQ_MAX_DIGITS` digits into `p_val`. Returns 0 if invalid */
+static int seq_parse(const char *str, uint64_t *p_val) {
+    int i;
+
+    *p_val = 0;
+    for (i = 0; str[i]; i++) {
+        if (i == SEQ_MAX_DIGITS || !z_isdigit(str[i])) {
+            return 0;
+        }
+        *p_val = *p_val * 10 + (str[i] - '0');
+    }
+    return i != 0;
+}
+
+/* Place item `index` (zero-based) of the sequence `start`, `start + step`, `start + 2 * step` etc. in `dest`,
+   NUL-terminated, setting `p_dest_length` to its length. `start` and `step` are decimal strings of up to 18 digits.
+   If `format` is NULL or empty the item is placed as is, otherwise it is formatted as for the GUI Sequence dialog,
+   i.e. from the right "#", "$" and "*" are replaced by the item's digits, or when they run out by space, "0" and
+   "*" respectively, with other characters (apart from "?") copied. A "?" is replaced by the GS1 Mod 10 check digit
+   of the digits immediately preceding it. `dest` must be at least `strlen(format) + 1` long, or 19 if `format`
+   NULL or empty. Returns 0 on success, else ZINT_ERROR_INVALID_OPTION if arguments invalid, or
+   ZINT_ERROR_INVALID_DATA if the item exceeds 18 digits or the digit placeholders of `format` */
+int ZBarcode_Sequence_Item(const char *start, const char *step, int index, const char *format, unsigned char dest[],
+            int *p_dest_length) {
+    const uint64_t max = (uint64_t) 999999999 * 1000000000 + 999999999; /* 18 digits */
+    uint64_t start_val, step_val, val;
+    unsigned char digits[SEQ_MAX_DIGITS];
+    int digits_len = 0;
+    int placeholders = 0, fill, run = 0;
+    int i, d;
+
+    if (!start || !step || index < 0 || !dest || !p_dest_length || !seq_parse(start, &start_val)
+            || !seq_parse(step, &step_val)) {
+        return ZINT_ERROR_INVALID_OPTION;
+    }
+    if (step_val && (uint64_t) index > (max - start_val) / step_val) {
+        return ZINT_ERROR_INVALID_DATA;
+    }
+    val = start_val + step_val * (uint64_t) index;
+
+    do {
+        digits[SEQ_MAX_DIGITS - ++digits_len] = (unsigned char) ('0' + val % 10);
+        val /= 10;
+    } while (val);
+
+    if (!format || !format[0]) {
+        memcpy(dest, digits + SEQ_MAX_DIGITS - digits_len, digits_len);
+        dest[digits_len] = '\0';
+        *p_dest_length = digits_len;
+        return 0;
+    }
+
+    for (i = 0; format[i]; i++) {
+        if (format[i] == '#' || format[i] == '$' || format[i] == '*') {
+            placeholders++;
+        }
+    }
+    if (digits_len > placeholders) {
+        return ZINT_ERROR_INVALID_DATA;
+    }
+
+    /* Placeholders to the left of the item's digits are filled */
+    fill = placeholders - digits_len;
+    for (i = 0, d = SEQ_MAX_DIGITS - digits_len; format[i]; i++) {
+        const char ch = format[i];
+        if (ch == '#' || ch == '$' || ch == '*') {
+            if (fill) {
+                dest[i] = ch == '#' ? ' ' : ch == '$' ? '0' : '*';
+                fill--;
+            } else {
+                dest[i] = digits[d++];
+            }
+        } else if (ch == '?') {
+            if (run == 0) {
+                return ZINT_ERROR_INVALID_OPTION;
+            }
+            dest[i] = (unsigned char) zint_gs1_check_digit(dest + i - run, run);
+        } else {
+            dest[i] = (unsigned char) ch;
+        }
+        run = z_isdigit(dest[i]) ? run + 1 : 0;
+    }
+    dest[i] = '\0';
+    *p_dest_length = i;
+
+    return 0;
+}
+
 /* Whether Zint built without PNG support */
 int ZBarcode_NoPng(void) {
 #ifdef ZINT_NO_PNG
@@ -2263,6 +2600,45 @@ int ZBarcode_HaveGS1SyntaxEngine(void) {
 #endif
 }
 
+/* Copy the per-phase timings & counts accumulated by `symbol` to `stats` */
+int ZBarcode_GetStats(const struct zint_symbol *symbol, struct zint_stats *stats) {
+    if (!symbol || !stats) {
+        return ZINT_ERROR_INVALID_DATA;
+    }
+#ifdef ZINT_NO_STATS
+    memset(stats, 0, sizeof(*stats));
+    return ZINT_ERROR_INVALID_OPTION;
+#else
+    *stats = symbol->stats;
+    return 0;
+#endif
+}
+
+/* Copy up to `max_events` of the most recent trace events recorded by `symbol` to `events`, oldest first, returning
+   the number copied, or if `events` NULL the number available */
+int ZBarcode_GetTrace(const struct zint_symbol *symbol, struct zint_trace_event *events, int max_events) {
+    const struct zint_trace *trace;
+    int skip, start, cnt, i;
+
+    if (!symbol || !(trace = symbol->trace) || !trace->used) {
+        return 0;
+    }
+    if (!events) {
+        return trace->used;
+    }
+    if (max_events <= 0) {
+        return 0;
+    }
+    cnt = trace->used < max_events ? trace->used : max_events;
+    skip = trace->used - cnt; /* Most recent `cnt` events wanted */
+    start = trace->used == trace->size ? trace->next % trace->size : 0;
+    for (i = 0; i < cnt; i++) {
+        events[i] = trace->events[(start + skip + i) % trace->size];
+    }
+
+    return cnt;
+}
+
 /* Return the version of Zint linked to */
 int ZBarcode_Version(void) {
 #if ZINT_VERSION_BUILD
@@ -307,8 +307,15 @@ static int mx_text_process_segs(unsigned char codewords[144], const int mode, st
     int si = 0; /* Segment offset to `source` position */
     int i, j;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (scm_vv != -1) { /* Add SCM prefix */
         source_scm_vv = (unsigned char *) z_alloca(segs[0].length + 9);
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
         sprintf((char *) source_scm_vv, "[)>\03601\035%02d", scm_vv); /* [)>\R01\Gvv */
         memcpy(source_scm_vv + 9, segs[0].source, segs[0].length);
         segs[0].source = source_scm_vv;
@@ -691,6 +698,9 @@ INTERNAL int zint_maxicode(struct zint_symbol *symbol, struct zint_seg segs[], c
     }
 
     error_number = mx_text_process_segs(codewords, mode, segs, seg_count, structapp_cw, scm_vv, debug_print);
+    if (error_number == ZINT_ERROR_MEMORY) {
+        return error_number;
+    }
     if (error_number == ZINT_ERROR_TOO_LONG) {
         return z_errtxt(error_number, symbol, 553, "Input too long, requires too many codewords (maximum 144)");
     }
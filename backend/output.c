@@ -222,6 +222,45 @@ INTERNAL int zint_out_colour_char_to_rgb(const unsigned char ch, unsigned char *
     return ret;
 }
 
+/* Whether RGB(A) would print as a dot on a 1-bit (thermal) printer, i.e. is opaque-ish and dark */
+static int out_mono_is_dot(const unsigned char red, const unsigned char green, const unsigned char blue,
+                const unsigned char alpha) {
+    /* ITU-R BT.601 luma */
+    return alpha >= 0x80 && red * 299 + green * 587 + blue * 114 < 0x80 * 1000;
+}
+
+/* Set `map` to 1 for each pixel char "01CBMRYGKW" that prints as a dot on a 1-bit printer, else 0 */
+INTERNAL void zint_out_mono_map(const struct zint_symbol *symbol, unsigned char map[128]) {
+    static const char chars[] = "CBMRYGKW";
+    unsigned char red, green, blue, alpha;
+    int i;
+
+    memset(map, 0, 128);
+
+    (void) zint_out_colour_get_rgb(symbol->fgcolour, &red, &green, &blue, &alpha);
+    map['1'] = (unsigned char) out_mono_is_dot(red, green, blue, alpha);
+    (void) zint_out_colour_get_rgb(symbol->bgcolour, &red, &green, &blue, &alpha);
+    map['0'] = (unsigned char) out_mono_is_dot(red, green, blue, alpha);
+
+    for (i = 0; i < 8; i++) {
+        (void) zint_out_colour_char_to_rgb(chars[i], &red, &green, &blue);
+        map[(unsigned char) chars[i]] = (unsigned char) out_mono_is_dot(red, green, blue, 0xFF);
+    }
+}
+
+/* Pack a row of `width` pixel chars into `buf` as 1-bit MSB-first per `map`, padding last byte with zero bits */
+INTERNAL void zint_out_mono_pack_row(const unsigned char map[128], const unsigned char *pb, const int width,
+                unsigned char *buf) {
+    int column;
+
+    memset(buf, 0, (width + 7) >> 3);
+    for (column = 0; column < width; column++) {
+        if (map[pb[column] & 0x7F]) {
+            buf[column >> 3] |= 0x80 >> (column & 7);
+        }
+    }
+}
+
 /* Return minimum quiet zones for each symbology */
 static int out_quiet_zones(const struct zint_symbol *symbol, const int hide_text, const int comp_xoffset,
                             float *left, float *right, float *top, float *bottom) {
@@ -890,6 +929,101 @@ INTERNAL float zint_out_large_bar_height(struct zint_symbol *symbol, const int s
     return large_bar_height;
 }
 
+/* Set up sheet `layout` for `symbol_cnt` cells of `cell_width` x `cell_height` as specified by `sheet`, with `xdim`
+   the size of an X-dimension in output units */
+INTERNAL void zint_out_sheet_layout(const struct zint_sheet *sheet, const int symbol_cnt, const float cell_width,
+                const float cell_height, const float xdim, struct zint_out_sheet *layout) {
+    const float gap = sheet->gap * xdim;
+
+    layout->cols = sheet->cols > 0 ? sheet->cols : 1;
+    if (layout->cols > symbol_cnt) {
+        layout->cols = symbol_cnt;
+    }
+    if (sheet->rows > 0) {
+        layout->rows = sheet->rows;
+        layout->page_cnt = (symbol_cnt + layout->cols * layout->rows - 1) / (layout->cols * layout->rows);
+    } else {
+        layout->rows = (symbol_cnt + layout->cols - 1) / layout->cols;
+        layout->page_cnt = 1;
+    }
+    layout->margin = sheet->margin * xdim;
+    layout->cell_width = cell_width;
+    layout->cell_height = cell_height;
+    layout->step_x = cell_width + gap;
+    layout->step_y = cell_height + gap;
+    layout->page_width = layout->margin * 2.0f + layout->step_x * layout->cols - gap;
+    layout->page_height = layout->margin * 2.0f + layout->step_y * layout->rows - gap;
+}
+
+/* Set page `p_page` & top left position `p_x`, `p_y` on page of symbol `idx` of dimensions `width` x `height`,
+   centred within its cell */
+INTERNAL void zint_out_sheet_position(const struct zint_out_sheet *layout, const int idx, const float width,
+                const float height, int *p_page, float *p_x, float *p_y) {
+    const int per_page = layout->cols * layout->rows;
+    const int cell = idx % per_page;
+
+    *p_page = idx / per_page;
+    *p_x = layout->margin + layout->step_x * (cell % layout->cols) + (layout->cell_width - width) / 2.0f;
+    *p_y = layout->margin + layout->step_y * (cell / layout->cols) + (layout->cell_height - height) / 2.0f;
+}
+
+/* Set `page_outfile` to `outfile` with 1-based `page` number inserted before extension, e.g. "out.svg" ->
+   "out-2.svg". Returns 0 if result too long */
+INTERNAL int zint_out_sheet_page_outfile(const char *outfile, const int page, char page_outfile[256]) {
+    const char *const dot = strrchr(outfile, '.');
+    const int base_len = dot ? (int) (dot - outfile) : (int) strlen(outfile);
+    const int ext_len = (int) strlen(outfile + base_len);
+    char number[16];
+    const int number_len = sprintf(number, "-%d", page);
+
+    if (base_len + number_len + ext_len >= 256) {
+        return 0;
+    }
+    memcpy(page_outfile, outfile, base_len);
+    memcpy(page_outfile + base_len, number, number_len);
+    memcpy(page_outfile + base_len + number_len, outfile + base_len, ext_len + 1);
+
+    return 1;
+}
+
+/* Return copy of `symbol` without output buffers, to be used for outputting sheet pages, or NULL if malloc fails */
+INTERNAL struct zint_symbol *zint_out_sheet_symbol(const struct zint_symbol *symbol) {
+    struct zint_symbol *page_symbol = (struct zint_symbol *) malloc(sizeof(struct zint_symbol));
+
+    if (page_symbol) {
+        memcpy(page_symbol, symbol, sizeof(struct zint_symbol));
+        page_symbol->fgcolor = page_symbol->fgcolour;
+        page_symbol->bgcolor = page_symbol->bgcolour;
+        page_symbol->errtxt[0] = '\0';
+        page_symbol->bitmap = page_symbol->alphamap = NULL;
+        page_symbol->bitmap_width = page_symbol->bitmap_height = 0;
+        page_symbol->vector = NULL;
+        page_symbol->memfile = NULL;
+        page_symbol->memfile_size = 0;
+        page_symbol->content_segs = NULL;
+        page_symbol->content_seg_count = 0;
+        page_symbol->trace = NULL;
+        page_symbol->delta = NULL;
+    }
+    return page_symbol;
+}
+
+/* Transfer any in-memory file and error message from sheet page symbol `page_symbol` to `symbol` and free
+   `page_symbol` */
+INTERNAL void zint_out_sheet_symbol_free(struct zint_symbol *symbol, struct zint_symbol *page_symbol) {
+    if (page_symbol->memfile) {
+        if (symbol->memfile) {
+            free(symbol->memfile);
+        }
+        symbol->memfile = page_symbol->memfile;
+        symbol->memfile_size = page_symbol->memfile_size;
+    }
+    if (page_symbol->errtxt[0]) {
+        memcpy(symbol->errtxt, page_symbol->errtxt, sizeof(symbol->errtxt));
+    }
+    free(page_symbol);
+}
+
 #ifdef _WIN32
 /* Convert UTF-8 to Windows wide chars. Ticket #288, props Marcel */
 /* Note if change this, change versions in "frontend/main.c" and "backend/tests/testcommon.c" also */
@@ -898,6 +1032,7 @@ INTERNAL float zint_out_large_bar_height(struct zint_symbol *symbol, const int s
         int lenW; /* Includes terminating NUL */ \
         if ((lenW = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, u, -1, NULL, 0)) == 0) return r; \
         w = (wchar_t *) z_alloca(sizeof(wchar_t) * lenW); \
+        if (Z_SCRATCH_FAILED()) return r; \
         if (MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, u, -1, w, lenW) == 0) return r; \
     }
 
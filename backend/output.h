@@ -53,6 +53,13 @@ INTERNAL int zint_out_colour_get_cmyk(const char *colour, int *cyan, int *magent
 INTERNAL int zint_out_colour_char_to_rgb(const unsigned char ch, unsigned char *red, unsigned char *green,
                 unsigned char *blue);
 
+/* Set `map` to 1 for each pixel char "01CBMRYGKW" that prints as a dot on a 1-bit printer, else 0 */
+INTERNAL void zint_out_mono_map(const struct zint_symbol *symbol, unsigned char map[128]);
+
+/* Pack a row of `width` pixel chars into `buf` as 1-bit MSB-first per `map`, padding last byte with zero bits */
+INTERNAL void zint_out_mono_pack_row(const unsigned char map[128], const unsigned char *pb, const int width,
+                unsigned char *buf);
+
 /* Set left (x), top (y), right and bottom offsets for whitespace, also right quiet zone */
 INTERNAL void zint_out_set_whitespace_offsets(const struct zint_symbol *symbol, const int hide_text,
                 const int comp_xoffset, float *p_xoffset, float *p_yoffset, float *p_roffset, float *p_boffset,
@@ -70,6 +77,37 @@ INTERNAL int zint_out_process_upcean(const struct zint_symbol *symbol, const int
 INTERNAL float zint_out_large_bar_height(struct zint_symbol *symbol, const int si, int *row_heights_si,
                 int *symbol_height_si);
 
+/* Sheet layout (see `ZBarcode_Print_Sheet()`), all dimensions in output units (pixels or points) */
+struct zint_out_sheet {
+    int cols, rows;         /* Cells across & down each page */
+    int page_cnt;           /* Number of pages */
+    float margin;           /* Page margin */
+    float step_x, step_y;   /* Distance between starts of adjacent cells, i.e. cell dimension plus gap */
+    float cell_width, cell_height; /* Maximum symbol dimensions */
+    float page_width, page_height;
+};
+
+/* Set up sheet `layout` for `symbol_cnt` cells of `cell_width` x `cell_height` as specified by `sheet`, with `xdim`
+   the size of an X-dimension in output units */
+INTERNAL void zint_out_sheet_layout(const struct zint_sheet *sheet, const int symbol_cnt, const float cell_width,
+                const float cell_height, const float xdim, struct zint_out_sheet *layout);
+
+/* Set page `p_page` & top left position `p_x`, `p_y` on page of symbol `idx` of dimensions `width` x `height`,
+   centred within its cell */
+INTERNAL void zint_out_sheet_position(const struct zint_out_sheet *layout, const int idx, const float width,
+                const float height, int *p_page, float *p_x, float *p_y);
+
+/* Set `page_outfile` to `outfile` with 1-based `page` number inserted before extension, e.g. "out.svg" ->
+   "out-2.svg". Returns 0 if result too long */
+INTERNAL int zint_out_sheet_page_outfile(const char *outfile, const int page, char page_outfile[256]);
+
+/* Return copy of `symbol` without output buffers, to be used for outputting sheet pages, or NULL if malloc fails */
+INTERNAL struct zint_symbol *zint_out_sheet_symbol(const struct zint_symbol *symbol);
+
+/* Transfer any in-memory file and error message from sheet page symbol `page_symbol` to `symbol` and free
+   `page_symbol` */
+INTERNAL void zint_out_sheet_symbol_free(struct zint_symbol *symbol, struct zint_symbol *page_symbol);
+
 /* Create output file, creating sub-directories if necessary. Returns `fopen()` FILE pointer */
 INTERNAL FILE *zint_out_fopen(char filename[256], const char *mode);
 
@@ -0,0 +1,85 @@
+/* pbm.c - Handles output to Netpbm Portable Bitmap (PBM) file */
+/*
+    libzint - the open source barcode library
+    Copyright (C) 2026 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+#include <errno.h>
+#include <stdio.h>
+#include "common.h"
+#include "filemem.h"
+#include "output.h"
+
+/* Netpbm "pbm" format specification https://netpbm.sourceforge.net/doc/pbm.html - uses "raw" (P4) format */
+INTERNAL int zint_pbm_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf) {
+    unsigned char map[128];
+    int row;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    const unsigned char *pb;
+    const int bytes_per_row = (symbol->bitmap_width + 7) >> 3;
+    unsigned char *rowbuf;
+
+    if (!(rowbuf = (unsigned char *) malloc(bytes_per_row))) {
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 620, "Insufficient memory for PBM row buffer");
+    }
+
+    zint_out_mono_map(symbol, map); /* PBM 1 is black */
+
+    /* Open output file in binary mode */
+    if (!zint_fm_open(fmp, symbol, "wb")) {
+        ZEXT z_errtxtf(0, symbol, 623, "Could not open PBM output file (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+        free(rowbuf);
+        return ZINT_ERROR_FILE_ACCESS;
+    }
+
+    zint_fm_printf(fmp, "P4\n%d %d\n", symbol->bitmap_width, symbol->bitmap_height);
+
+    for (row = 0, pb = pixelbuf; row < symbol->bitmap_height; row++, pb += symbol->bitmap_width) {
+        zint_out_mono_pack_row(map, pb, symbol->bitmap_width, rowbuf);
+        zint_fm_write(rowbuf, 1, bytes_per_row, fmp);
+    }
+
+    free(rowbuf);
+
+    if (zint_fm_error(fmp)) {
+        ZEXT z_errtxtf(0, symbol, 625, "Incomplete write of PBM output (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+        (void) zint_fm_close(fmp, symbol);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+
+    if (!zint_fm_close(fmp, symbol)) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_WRITE, symbol, 626, "Failure on closing PBM output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    return 0;
+}
+
+/* vim: set ts=4 sw=4 et : */
@@ -0,0 +1,864 @@
+/* pdf.c - PDF (Portable Document Format) output */
+/*
+    libzint - the open source barcode library
+    Copyright (C) 2026 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+#include <assert.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "common.h"
+#include "filemem.h"
+#include "output.h"
+#include "fonts/normal_ttf.h"
+#include "fonts/upcean_ttf.h"
+
+/* Widths of WinAnsiEncoding chars 0x20-0x7E in 1000ths of an em for the standard Type 1 Helvetica fonts (from
+   the Adobe Font Metrics files). Latin-1 chars 0xA0-0xFF are given the digit width 556 */
+static const short pdf_helvetica_widths[2][95] = {
+    { /* Helvetica */
+        278, 278, 355, 556, 556, 889, 667, 191, 333, 333, 389, 584, 278, 333, 278, 278, /* 0x20-0x2F */
+        556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 278, 278, 584, 584, 584, 556, /* 0x30-0x3F */
+        1015, 667, 667, 722, 722, 667, 611, 778, 722, 278, 500, 667, 556, 833, 722, 778, /* 0x40-0x4F */
+        667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 278, 278, 278, 469, 556, /* 0x50-0x5F */
+        333, 556, 556, 500, 556, 556, 278, 556, 556, 222, 222, 500, 222, 833, 556, 556, /* 0x60-0x6F */
+        556, 556, 333, 500, 278, 556, 500, 722, 500, 500, 500, 334, 260, 334, 584, /* 0x70-0x7E */
+    },
+    { /* Helvetica-Bold */
+        278, 333, 474, 556, 556, 889, 722, 238, 333, 333, 389, 584, 278, 333, 278, 278, /* 0x20-0x2F */
+        556, 556, 556, 556, 556, 556, 556, 556, 556, 556, 333, 333, 584, 584, 584, 611, /* 0x30-0x3F */
+        975, 722, 722, 722, 722, 667, 611, 778, 722, 278, 556, 722, 611, 833, 722, 778, /* 0x40-0x4F */
+        667, 778, 722, 667, 611, 722, 667, 944, 667, 667, 611, 333, 278, 333, 584, 556, /* 0x50-0x5F */
+        333, 556, 611, 556, 611, 556, 333, 611, 611, 278, 278, 556, 278, 889, 611, 611, /* 0x60-0x6F */
+        611, 611, 389, 556, 333, 611, 556, 778, 556, 556, 500, 389, 280, 389, 584, /* 0x70-0x7E */
+    },
+};
+
+/* Metrics of a font, widths covering WinAnsiEncoding chars `PDF_FIRST_CHAR` to `PDF_LAST_CHAR` */
+#define PDF_FIRST_CHAR  32
+#define PDF_LAST_CHAR   255
+
+struct pdf_font {
+    short widths[PDF_LAST_CHAR - PDF_FIRST_CHAR + 1]; /* In 1000ths of an em */
+    short bbox[4];          /* Font bounding box (embedded only) */
+    short ascent, descent;  /* (Embedded only) */
+    const unsigned char *ttf; /* TrueType font if embedding, else NULL */
+    int ttf_size;
+    const char *name;       /* BaseFont name */
+};
+
+/* Growable memory buffer that the document is assembled in (so object offsets are known) */
+struct pdf_buf {
+    char *s;
+    size_t len;
+    size_t size;
+    int err;
+};
+
+/* Append `n` bytes of `s` to `buf`, returning 1 on success, 0 on memory failure */
+static int pdf_putn(struct pdf_buf *buf, const char *s, const size_t n) {
+    if (buf->err) {
+        return 0;
+    }
+    if (buf->len + n > buf->size) {
+        size_t new_size = buf->size ? buf->size * 2 : 4096;
+        char *new_s;
+        while (new_size < buf->len + n) {
+            new_size *= 2;
+        }
+        if (!(new_s = (char *) realloc(buf->s, new_size))) {
+            buf->err = ENOMEM;
+            return 0;
+        }
+        buf->s = new_s;
+        buf->size = new_size;
+    }
+    memcpy(buf->s + buf->len, s, n);
+    buf->len += n;
+    return 1;
+}
+
+/* Append NUL-terminated string `s` */
+static int pdf_puts(struct pdf_buf *buf, const char *s) {
+    return pdf_putn(buf, s, strlen(s));
+}
+
+/* Append integer `arg` preceded by `prefix` */
+static int pdf_puti(struct pdf_buf *buf, const char *prefix, const long arg) {
+    char num[24];
+    if (prefix && *prefix && !pdf_puts(buf, prefix)) {
+        return 0;
+    }
+    sprintf(num, "%ld", arg);
+    return pdf_puts(buf, num);
+}
+
+/* Append float without trailing zeroes to decimal pts `dp`, preceded by `prefix` (see `zint_fm_putsf()`) */
+static int pdf_putsf(struct pdf_buf *buf, const char *prefix, const int dp, const float arg) {
+    int i, end;
+    char num[64]; /* Assuming `dp` reasonable */
+    const int len = sprintf(num, "%.*f", dp, arg);
+
+    if (prefix && *prefix && !pdf_puts(buf, prefix)) {
+        return 0;
+    }
+    for (i = len - 1, end = len; i >= 0; i--) {
+        if (num[i] == '0') {
+            if (end == i + 1) {
+                end = i;
+            }
+        } else if (!z_isdigit(num[i]) && num[i] != '-') { /* If not digit or minus then decimal point */
+            if (end == i + 1) {
+                end = i;
+            } else {
+                num[i] = '.'; /* Overwrite any locale-specific setting for decimal point */
+            }
+            num[end] = '\0';
+            break;
+        }
+    }
+    if (strcmp(num, "-0") == 0) {
+        return pdf_puts(buf, "0");
+    }
+    return pdf_puts(buf, num);
+}
+
+/* Big-endian TrueType accessors */
+#define PDF_TTF_U16(p) ((unsigned short) (((p)[0] << 8) | (p)[1]))
+#define PDF_TTF_S16(p) ((short) PDF_TTF_U16(p))
+#define PDF_TTF_U32(p) (((unsigned long) (p)[0] << 24) | ((unsigned long) (p)[1] << 16) \
+                        | ((unsigned long) (p)[2] << 8) | (unsigned long) (p)[3])
+
+/* Return pointer to TrueType table `tag`, or NULL if not found */
+static const unsigned char *pdf_ttf_table(const unsigned char *ttf, const int ttf_size, const char tag[5],
+                const unsigned long min_len) {
+    const int num_tables = PDF_TTF_U16(ttf + 4);
+    int i;
+
+    for (i = 0; i < num_tables && 12 + i * 16 + 16 <= ttf_size; i++) {
+        const unsigned char *entry = ttf + 12 + i * 16;
+        if (memcmp(entry, tag, 4) == 0) {
+            const unsigned long offset = PDF_TTF_U32(entry + 8);
+            const unsigned long length = PDF_TTF_U32(entry + 12);
+            if (length < min_len || offset + length > (unsigned long) ttf_size) {
+                return NULL;
+            }
+            return ttf + offset;
+        }
+    }
+    return NULL;
+}
+
+/* Map Unicode BMP `ch` to glyph id using (3,1) format 4 cmap subtable, returning 0 (.notdef) if not found */
+static int pdf_ttf_glyph(const unsigned char *cmap4, const unsigned int ch) {
+    const int seg_count = PDF_TTF_U16(cmap4 + 6) / 2;
+    const unsigned char *end_codes = cmap4 + 14;
+    const unsigned char *start_codes = end_codes + seg_count * 2 + 2;
+    const unsigned char *id_deltas = start_codes + seg_count * 2;
+    const unsigned char *id_range_offsets = id_deltas + seg_count * 2;
+    int i;
+
+    for (i = 0; i < seg_count; i++) {
+        if (ch <= PDF_TTF_U16(end_codes + i * 2)) {
+            const unsigned int start = PDF_TTF_U16(start_codes + i * 2);
+            const unsigned int range_offset = PDF_TTF_U16(id_range_offsets + i * 2);
+            if (ch < start) {
+                return 0;
+            }
+            if (range_offset == 0) {
+                return (ch + PDF_TTF_U16(id_deltas + i * 2)) & 0xFFFF;
+            } else {
+                const unsigned char *gp = id_range_offsets + i * 2 + range_offset + (ch - start) * 2;
+                const unsigned int glyph = PDF_TTF_U16(gp);
+                return glyph ? (glyph + PDF_TTF_U16(id_deltas + i * 2)) & 0xFFFF : 0;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Set up `font` metrics from embedded TrueType `ttf`, returning 1 on success, 0 if font malformed */
+static int pdf_ttf_metrics(struct pdf_font *font, const unsigned char *ttf, const int ttf_size) {
+    const unsigned char *head = pdf_ttf_table(ttf, ttf_size, "head", 54);
+    const unsigned char *hhea = pdf_ttf_table(ttf, ttf_size, "hhea", 36);
+    const unsigned char *hmtx = pdf_ttf_table(ttf, ttf_size, "hmtx", 4);
+    const unsigned char *cmap = pdf_ttf_table(ttf, ttf_size, "cmap", 4);
+    const unsigned char *cmap4 = NULL;
+    int units_per_em, num_hmetrics, num_subtables;
+    int i;
+
+    if (!head || !hhea || !hmtx || !cmap) {
+        return 0;
+    }
+    units_per_em = PDF_TTF_U16(head + 18);
+    num_hmetrics = PDF_TTF_U16(hhea + 34);
+    if (units_per_em == 0 || num_hmetrics == 0) {
+        return 0;
+    }
+    num_subtables = PDF_TTF_U16(cmap + 2);
+    for (i = 0; i < num_subtables; i++) {
+        const unsigned char *rec = cmap + 4 + i * 8;
+        if (PDF_TTF_U16(rec) == 3 && PDF_TTF_U16(rec + 2) == 1) {
+            cmap4 = cmap + PDF_TTF_U32(rec + 4);
+            if (PDF_TTF_U16(cmap4) != 4) {
+                cmap4 = NULL;
+            }
+            break;
+        }
+    }
+    if (!cmap4) {
+        return 0;
+    }
+
+    for (i = 0; i < 4; i++) {
+        font->bbox[i] = (short) (PDF_TTF_S16(head + 36 + i * 2) * 1000 / units_per_em);
+    }
+    font->ascent = (short) (PDF_TTF_S16(hhea + 4) * 1000 / units_per_em);
+    font->descent = (short) (PDF_TTF_S16(hhea + 6) * 1000 / units_per_em);
+
+    for (i = PDF_FIRST_CHAR; i <= PDF_LAST_CHAR; i++) {
+        int width = 0;
+        /* WinAnsiEncoding 0x80-0x9F not used (only Latin-1 output) */
+        if (i < 0x7F || i >= 0xA0) {
+            int glyph = pdf_ttf_glyph(cmap4, i);
+            if (glyph) {
+                if (glyph >= num_hmetrics) {
+                    glyph = num_hmetrics - 1;
+                }
+                width = PDF_TTF_U16(hmtx + glyph * 4) * 1000 / units_per_em;
+            }
+        }
+        font->widths[i - PDF_FIRST_CHAR] = (short) width;
+    }
+    font->ttf = ttf;
+    font->ttf_size = ttf_size;
+
+    return 1;
+}
+
+/* Set up font to use for HRT */
+static void pdf_font_init(const struct zint_symbol *symbol, const int is_upcean, struct pdf_font *font) {
+    int i;
+
+    memset(font, 0, sizeof(*font));
+
+    if (symbol->output_options & EMBED_VECTOR_FONT) {
+        if (is_upcean) {
+            font->name = "OCRB";
+            if (pdf_ttf_metrics(font, upcean_ttf, ARRAY_SIZE(upcean_ttf))) {
+                return;
+            }
+        } else {
+            font->name = "Arimo";
+            if (pdf_ttf_metrics(font, normal_ttf, ARRAY_SIZE(normal_ttf))) {
+                return;
+            }
+        }
+        memset(font, 0, sizeof(*font)); /* Shouldn't happen - fall back to standard font */
+    }
+    if ((symbol->output_options & BOLD_TEXT) && !is_upcean) {
+        font->name = "Helvetica-Bold";
+        for (i = 0; i < 95; i++) {
+            font->widths[i] = pdf_helvetica_widths[1][i];
+        }
+    } else {
+        font->name = "Helvetica";
+        for (i = 0; i < 95; i++) {
+            font->widths[i] = pdf_helvetica_widths[0][i];
+        }
+    }
+    for (i = 0xA0; i <= PDF_LAST_CHAR; i++) {
+        font->widths[i - PDF_FIRST_CHAR] = 556;
+    }
+}
+
+/* Convert UTF-8 `string` to escaped WinAnsiEncoding PDF string `pdf_string` (max 4 times length), returning width
+   in 1000ths of an em. Assumes valid UTF-8-encoded ISO/IEC 8859-1, other chars ignored */
+static int pdf_convert(const unsigned char *string, const struct pdf_font *font, unsigned char *pdf_string) {
+    const unsigned char *s;
+    unsigned char *p = pdf_string;
+    int width = 0;
+
+    for (s = string; *s; s++) {
+        unsigned int ch;
+        if (*s < 0x80) {
+            ch = *s;
+        } else if ((*s == 0xC2 || *s == 0xC3) && s[1]) {
+            ch = ((*s & 0x1F) << 6) | (s[1] & 0x3F);
+            s++;
+            if (ch < 0xA0) {
+                continue; /* C1 controls not in WinAnsiEncoding */
+            }
+        } else {
+            continue; /* Unicode points > U+00FF ignored */
+        }
+        if (ch < PDF_FIRST_CHAR || ch == 0x7F) {
+            continue;
+        }
+        width += font->widths[ch - PDF_FIRST_CHAR];
+        if (ch == '(' || ch == ')' || ch == '\\') {
+            *p++ = '\\';
+            *p++ = (unsigned char) ch;
+        } else if (ch >= 0x80) {
+            /* Use octal escape to keep content stream 7-bit */
+            *p++ = '\\';
+            *p++ = (unsigned char) ('0' + (ch >> 6));
+            *p++ = (unsigned char) ('0' + ((ch >> 3) & 0x07));
+            *p++ = (unsigned char) ('0' + (ch & 0x07));
+        } else {
+            *p++ = (unsigned char) ch;
+        }
+    }
+    *p = '\0';
+
+    return width;
+}
+
+#ifdef ZINT_TEST /* Wrapper for direct testing */
+INTERNAL int zint_test_pdf_convert(const struct zint_symbol *symbol, const unsigned char *string,
+                unsigned char *pdf_string) {
+    struct pdf_font font;
+    pdf_font_init(symbol, z_is_upcean(symbol->symbology), &font);
+    return pdf_convert(string, &font, pdf_string);
+}
+#endif
+
+/* Output fill colour given as Ultracode colour 1-8 */
+static void pdf_put_ultra_colour(struct pdf_buf *cs, const int is_rgb, const int colour) {
+    const int idx = colour >= 1 && colour <= 8 ? colour - 1 : 6 /*black*/;
+    if (is_rgb) {
+        static const char pdf_rgbs[8][6] = {
+            "0 1 1", /* 0: Cyan (1) */
+            "0 0 1", /* 1: Blue (2) */
+            "1 0 1", /* 2: Magenta (3) */
+            "1 0 0", /* 3: Red (4) */
+            "1 1 0", /* 4: Yellow (5) */
+            "0 1 0", /* 5: Green (6) */
+            "0 0 0", /* 6: Black (7) */
+            "1 1 1", /* 7: White (8) */
+        };
+        pdf_puts(cs, pdf_rgbs[idx]);
+        pdf_puts(cs, " rg\n");
+    } else {
+        static const char pdf_cmyks[8][8] = {
+            "1 0 0 0", /* 0: Cyan (1) */
+            "1 1 0 0", /* 1: Blue (2) */
+            "0 1 0 0", /* 2: Magenta (3) */
+            "0 1 1 0", /* 3: Red (4) */
+            "0 0 1 0", /* 4: Yellow (5) */
+            "1 0 1 0", /* 5: Green (6) */
+            "0 0 0 1", /* 6: Black (7) */
+            "0 0 0 0", /* 7: White (8) */
+        };
+        pdf_puts(cs, pdf_cmyks[idx]);
+        pdf_puts(cs, " k\n");
+    }
+}
+
+/* Output colour `colour` ("RRGGBB[AA]" or "C,M,Y,K") as fill and stroke colour */
+static void pdf_put_colour(struct pdf_buf *cs, const int is_rgb, const char *colour) {
+    if (is_rgb) {
+        unsigned char red, green, blue;
+        (void) zint_out_colour_get_rgb(colour, &red, &green, &blue, NULL /*alpha*/);
+        pdf_putsf(cs, "", 3, red / 255.0f);
+        pdf_putsf(cs, " ", 3, green / 255.0f);
+        pdf_putsf(cs, " ", 3, blue / 255.0f);
+        pdf_puts(cs, " rg ");
+        pdf_putsf(cs, "", 3, red / 255.0f);
+        pdf_putsf(cs, " ", 3, green / 255.0f);
+        pdf_putsf(cs, " ", 3, blue / 255.0f);
+        pdf_puts(cs, " RG\n");
+    } else {
+        int cyan, magenta, yellow, black;
+        (void) zint_out_colour_get_cmyk(colour, &cyan, &magenta, &yellow, &black, NULL /*rgb_alpha*/);
+        pdf_putsf(cs, "", 2, cyan / 100.0f);
+        pdf_putsf(cs, " ", 2, magenta / 100.0f);
+        pdf_putsf(cs, " ", 2, yellow / 100.0f);
+        pdf_putsf(cs, " ", 2, black / 100.0f);
+        pdf_puts(cs, " k ");
+        pdf_putsf(cs, "", 2, cyan / 100.0f);
+        pdf_putsf(cs, " ", 2, magenta / 100.0f);
+        pdf_putsf(cs, " ", 2, yellow / 100.0f);
+        pdf_putsf(cs, " ", 2, black / 100.0f);
+        pdf_puts(cs, " K\n");
+    }
+}
+
+/* Output circle path of radius `r` centred at `x`, `y` as 4 Bezier curves */
+static void pdf_put_circle_path(struct pdf_buf *cs, const float x, const float y, const float r) {
+    const float k = 0.55228475f * r; /* 4 * (sqrt(2) - 1) / 3 */
+
+    pdf_putsf(cs, "", 2, x + r);
+    pdf_putsf(cs, " ", 2, y);
+    pdf_puts(cs, " m\n");
+    pdf_putsf(cs, "", 2, x + r);
+    pdf_putsf(cs, " ", 2, y + k);
+    pdf_putsf(cs, " ", 2, x + k);
+    pdf_putsf(cs, " ", 2, y + r);
+    pdf_putsf(cs, " ", 2, x);
+    pdf_putsf(cs, " ", 2, y + r);
+    pdf_puts(cs, " c\n");
+    pdf_putsf(cs, "", 2, x - k);
+    pdf_putsf(cs, " ", 2, y + r);
+    pdf_putsf(cs, " ", 2, x - r);
+    pdf_putsf(cs, " ", 2, y + k);
+    pdf_putsf(cs, " ", 2, x - r);
+    pdf_putsf(cs, " ", 2, y);
+    pdf_puts(cs, " c\n");
+    pdf_putsf(cs, "", 2, x - r);
+    pdf_putsf(cs, " ", 2, y - k);
+    pdf_putsf(cs, " ", 2, x - k);
+    pdf_putsf(cs, " ", 2, y - r);
+    pdf_putsf(cs, " ", 2, x);
+    pdf_putsf(cs, " ", 2, y - r);
+    pdf_puts(cs, " c\n");
+    pdf_putsf(cs, "", 2, x + k);
+    pdf_putsf(cs, " ", 2, y - r);
+    pdf_putsf(cs, " ", 2, x + r);
+    pdf_putsf(cs, " ", 2, y - k);
+    pdf_putsf(cs, " ", 2, x + r);
+    pdf_putsf(cs, " ", 2, y);
+    pdf_puts(cs, " c\n");
+}
+
+/* Append the drawing operators for `vector` to content stream `cs`, using the colours and options of `symbol`,
+   with the bottom left of the vector placed at `xoffset`, `yoffset` (PDF coordinates, i.e. y increasing upwards) */
+static int pdf_content(struct pdf_buf *cs, const struct zint_symbol *symbol, const struct zint_vector *vector,
+                const struct pdf_font *font, const float xoffset, const float yoffset) {
+    const float top = yoffset + vector->height; /* Vector y is top-down */
+    const int is_rgb = (symbol->output_options & CMYK_COLOUR) == 0;
+    const int is_upcean = z_is_upcean(symbol->symbology);
+    unsigned char bgalpha = 0xFF;
+    struct zint_vector_rect *rect;
+    struct zint_vector_hexagon *hex;
+    struct zint_vector_circle *circle;
+    struct zint_vector_string *string;
+
+    if (is_rgb) {
+        unsigned char dummy;
+        (void) zint_out_colour_get_rgb(symbol->bgcolour, &dummy, &dummy, &dummy, &bgalpha);
+    } else {
+        int idummy;
+        (void) zint_out_colour_get_cmyk(symbol->bgcolour, &idummy, &idummy, &idummy, &idummy, &bgalpha);
+    }
+
+    /* Background */
+    if (bgalpha != 0) {
+        pdf_put_colour(cs, is_rgb, symbol->bgcolour);
+        pdf_putsf(cs, "", 2, xoffset);
+        pdf_putsf(cs, " ", 2, yoffset);
+        pdf_putsf(cs, " ", 2, vector->width);
+        pdf_putsf(cs, " ", 2, vector->height);
+        pdf_puts(cs, " re f\n");
+    }
+
+    pdf_put_colour(cs, is_rgb, symbol->fgcolour);
+
+    /* Rectangles - consecutive rectangles of the same colour are filled together */
+    if (vector->rectangles) {
+        int last_colour = -1;
+        for (rect = vector->rectangles; rect; rect = rect->next) {
+            if (rect->colour != last_colour) {
+                if (rect != vector->rectangles) {
+                    pdf_puts(cs, "f\n");
+                }
+                if (rect->colour == -1) {
+                    pdf_put_colour(cs, is_rgb, symbol->fgcolour);
+                } else {
+                    pdf_put_ultra_colour(cs, is_rgb, rect->colour); /* Ultracode */
+                }
+                last_colour = rect->colour;
+            }
+            pdf_putsf(cs, "", 2, xoffset + rect->x);
+            pdf_putsf(cs, " ", 2, top - rect->y - rect->height);
+            pdf_putsf(cs, " ", 2, rect->width);
+            pdf_putsf(cs, " ", 2, rect->height);
+            pdf_puts(cs, " re\n");
+        }
+        pdf_puts(cs, "f\n");
+        if (last_colour != -1) {
+            pdf_put_colour(cs, is_rgb, symbol->fgcolour);
+        }
+    }
+
+    /* Hexagons */
+    if (vector->hexagons) {
+        float previous_diameter = 0.0f, radius = 0.0f, half_radius = 0.0f, half_sqrt3_radius = 0.0f;
+        for (hex = vector->hexagons; hex; hex = hex->next) {
+            const float hx = xoffset + hex->x;
+            const float hy = top - hex->y;
+            if (previous_diameter != hex->diameter) {
+                previous_diameter = hex->diameter;
+                radius = 0.5f * previous_diameter;
+                half_radius = 0.25f * previous_diameter;
+                half_sqrt3_radius = 0.43301270189221932338f * previous_diameter;
+            }
+            if (hex->rotation == 0 || hex->rotation == 180) {
+                pdf_putsf(cs, "", 2, hx);
+                pdf_putsf(cs, " ", 2, hy + radius);
+                pdf_putsf(cs, " m ", 2, hx + half_sqrt3_radius);
+                pdf_putsf(cs, " ", 2, hy + half_radius);
+                pdf_putsf(cs, " l ", 2, hx + half_sqrt3_radius);
+                pdf_putsf(cs, " ", 2, hy - half_radius);
+                pdf_putsf(cs, " l ", 2, hx);
+                pdf_putsf(cs, " ", 2, hy - radius);
+                pdf_putsf(cs, " l ", 2, hx - half_sqrt3_radius);
+                pdf_putsf(cs, " ", 2, hy - half_radius);
+                pdf_putsf(cs, " l ", 2, hx - half_sqrt3_radius);
+                pdf_putsf(cs, " ", 2, hy + half_radius);
+            } else {
+                pdf_putsf(cs, "", 2, hx - radius);
+                pdf_putsf(cs, " ", 2, hy);
+                pdf_putsf(cs, " m ", 2, hx - half_radius);
+                pdf_putsf(cs, " ", 2, hy + half_sqrt3_radius);
+                pdf_putsf(cs, " l ", 2, hx + half_radius);
+                pdf_putsf(cs, " ", 2, hy + half_sqrt3_radius);
+                pdf_putsf(cs, " l ", 2, hx + radius);
+                pdf_putsf(cs, " ", 2, hy);
+                pdf_putsf(cs, " l ", 2, hx + half_radius);
+                pdf_putsf(cs, " ", 2, hy - half_sqrt3_radius);
+                pdf_putsf(cs, " l ", 2, hx - half_radius);
+                pdf_putsf(cs, " ", 2, hy - half_sqrt3_radius);
+            }
+            pdf_puts(cs, " l h\n");
+        }
+        pdf_puts(cs, "f\n");
+    }
+
+    /* Circles - discs are filled together, rings (MaxiCode bullseye) stroked individually */
+    if (vector->circles) {
+        int have_discs = 0;
+        for (circle = vector->circles; circle; circle = circle->next) {
+            assert(circle->colour == 0); /* Legacy - no longer used */
+            if (circle->width == 0.0f) {
+                pdf_put_circle_path(cs, xoffset + circle->x, top - circle->y, 0.5f * circle->diameter);
+                have_discs = 1;
+            }
+        }
+        if (have_discs) {
+            pdf_puts(cs, "f\n");
+        }
+        for (circle = vector->circles; circle; circle = circle->next) {
+            if (circle->width) {
+                pdf_putsf(cs, "", 3, circle->width);
+                pdf_puts(cs, " w\n");
+                pdf_put_circle_path(cs, xoffset + circle->x, top - circle->y, 0.5f * circle->diameter);
+                pdf_puts(cs, "S\n");
+            }
+        }
+    }
+
+    /* Text */
+    if (vector->strings) {
+        const int embedded = font->ttf != NULL;
+        /* Synthesize bold for the embedded (regular only) font by also stroking the glyph outlines */
+        const int fake_bold = embedded && (symbol->output_options & BOLD_TEXT) && !is_upcean;
+        float previous_fsize = 0.0f;
+        int max_len = 0;
+        unsigned char *pdf_string;
+
+        for (string = vector->strings; string; string = string->next) {
+            if (string->length > max_len) {
+                max_len = string->length;
+            }
+        }
+        pdf_string = (unsigned char *) z_alloca(max_len * 4 + 1);
+        if (Z_SCRATCH_FAILED()) {
+            cs->err = ENOMEM;
+            return 0;
+        }
+
+        pdf_puts(cs, "BT\n");
+        if (fake_bold) {
+            pdf_puts(cs, "2 Tr\n");
+        }
+        for (string = vector->strings; string; string = string->next) {
+            /* Compensate for Helvetica being smaller than Zint's OCR-B (as EPS) */
+            const float fsize = is_upcean && !embedded ? string->fsize * 1.07f : string->fsize;
+            const float width = pdf_convert(string->text, font, pdf_string) * fsize / 1000.0f;
+            const float shift = string->halign == 0 ? width / 2.0f : string->halign == 2 ? width : 0.0f;
+            float x = string->x, y = top - string->y;
+            float cos_r = 1.0f, sin_r = 0.0f;
+
+            if (string->fsize != previous_fsize) {
+                pdf_putsf(cs, "/F1 ", 2, fsize);
+                pdf_puts(cs, " Tf\n");
+                if (fake_bold) {
+                    pdf_putsf(cs, "", 3, fsize * 0.03f);
+                    pdf_puts(cs, " w\n");
+                }
+                previous_fsize = string->fsize;
+            }
+            if (!embedded && is_upcean) {
+                /* Unhack the guard whitespace `gws_left_fudge`/`gws_right_fudge` hack (as EPS) */
+                const float gws_fudge = symbol->scale < 0.1f ? 0.1f : symbol->scale; /* 0.5 * 2 * scale */
+                if (string->halign == 1 && string->text[0] == '<') {
+                    x += gws_fudge;
+                } else if (string->halign == 2 && string->text[0] == '>') {
+                    x -= gws_fudge;
+                }
+            }
+            /* Rotation is clockwise, PDF y-axis goes up */
+            if (string->rotation == 90) {
+                cos_r = 0.0f;
+                sin_r = -1.0f;
+            } else if (string->rotation == 180) {
+                cos_r = -1.0f;
+            } else if (string->rotation == 270) {
+                cos_r = 0.0f;
+                sin_r = 1.0f;
+            }
+            x = xoffset + x - shift * cos_r;
+            y -= shift * sin_r;
+            if (string->rotation == 0) {
+                pdf_putsf(cs, "1 0 0 1 ", 2, x);
+            } else {
+                pdf_puti(cs, "", (long) cos_r);
+                pdf_puti(cs, " ", (long) sin_r);
+                pdf_puti(cs, " ", (long) -sin_r);
+                pdf_puti(cs, " ", (long) cos_r);
+                pdf_putsf(cs, " ", 2, x);
+            }
+            pdf_putsf(cs, " ", 2, y);
+            pdf_puts(cs, " Tm (");
+            pdf_puts(cs, (const char *) pdf_string);
+            pdf_puts(cs, ") Tj\n");
+        }
+        pdf_puts(cs, "ET\n");
+    }
+
+    return !cs->err;
+}
+
+/* Output object `obj_num`'s header, recording its offset */
+static void pdf_obj_start(struct pdf_buf *buf, long offsets[], const int obj_num) {
+    offsets[obj_num] = (long) buf->len;
+    pdf_puti(buf, "", obj_num);
+    pdf_puts(buf, " 0 obj\n");
+}
+
+/* Output the font dictionary for `font` as object `obj_num` (plus descriptor & font file if embedded) */
+static void pdf_put_font(struct pdf_buf *buf, long offsets[], const int obj_num, const struct pdf_font *font) {
+    int i;
+
+    pdf_obj_start(buf, offsets, obj_num);
+    if (!font->ttf) {
+        pdf_puts(buf, "<< /Type /Font /Subtype /Type1 /BaseFont /");
+        pdf_puts(buf, font->name);
+        pdf_puts(buf, " /Encoding /WinAnsiEncoding >>\nendobj\n");
+        return;
+    }
+    pdf_puts(buf, "<< /Type /Font /Subtype /TrueType /BaseFont /");
+    pdf_puts(buf, font->name);
+    pdf_puti(buf, " /FirstChar ", PDF_FIRST_CHAR);
+    pdf_puti(buf, " /LastChar ", PDF_LAST_CHAR);
+    pdf_puts(buf, "\n/Widths [");
+    for (i = 0; i <= PDF_LAST_CHAR - PDF_FIRST_CHAR; i++) {
+        pdf_puti(buf, i == 0 ? "" : (i & 0x0F) == 0 ? "\n" : " ", font->widths[i]);
+    }
+    pdf_puts(buf, "]\n/Encoding /WinAnsiEncoding");
+    pdf_puti(buf, " /FontDescriptor ", obj_num + 1);
+    pdf_puts(buf, " 0 R >>\nendobj\n");
+
+    pdf_obj_start(buf, offsets, obj_num + 1);
+    pdf_puts(buf, "<< /Type /FontDescriptor /FontName /");
+    pdf_puts(buf, font->name);
+    pdf_puts(buf, " /Flags 32 /FontBBox [");
+    for (i = 0; i < 4; i++) {
+        pdf_puti(buf, i ? " " : "", font->bbox[i]);
+    }
+    pdf_puti(buf, "] /ItalicAngle 0 /Ascent ", font->ascent);
+    pdf_puti(buf, " /Descent ", font->descent);
+    pdf_puti(buf, " /CapHeight ", font->ascent);
+    pdf_puti(buf, " /StemV 80 /FontFile2 ", obj_num + 2);
+    pdf_puts(buf, " 0 R >>\nendobj\n");
+
+    pdf_obj_start(buf, offsets, obj_num + 2);
+    pdf_puti(buf, "<< /Length ", font->ttf_size);
+    pdf_puti(buf, " /Length1 ", font->ttf_size);
+    pdf_puts(buf, " >>\nstream\n");
+    pdf_putn(buf, (const char *) font->ttf, font->ttf_size);
+    pdf_puts(buf, "\nendstream\nendobj\n");
+}
+
+/* Assemble complete document consisting of `page_cnt` pages of size `width` x `height` with content streams
+   `contents`, returning 1 on success, 0 on memory failure */
+static int pdf_document(struct pdf_buf *buf, const struct pdf_buf contents[], const int page_cnt,
+                const float width, const float height, const struct pdf_font *font) {
+    /* Objects: 1 Catalog, 2 Pages, then per page Page & Contents, then Font (3 objects if embedded), then Info */
+    const int font_obj = 3 + page_cnt * 2;
+    const int info_obj = font ? font_obj + (font->ttf ? 3 : 1) : font_obj;
+    long *offsets = (long *) malloc(sizeof(long) * (info_obj + 1));
+    long xref_offset;
+    int i;
+
+    if (!offsets) {
+        buf->err = ENOMEM;
+        return 0;
+    }
+
+    /* Header, with binary comment to mark file as binary */
+    pdf_puts(buf, "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n");
+
+    pdf_obj_start(buf, offsets, 1);
+    pdf_puts(buf, "<< /Type /Catalog /Pages 2 0 R >>\nendobj\n");
+
+    pdf_obj_start(buf, offsets, 2);
+    pdf_puts(buf, "<< /Type /Pages /Kids [");
+    for (i = 0; i < page_cnt; i++) {
+        pdf_puti(buf, i ? " " : "", 3 + i * 2);
+        pdf_puts(buf, " 0 R");
+    }
+    pdf_puti(buf, "] /Count ", page_cnt);
+    pdf_puts(buf, " >>\nendobj\n");
+
+    for (i = 0; i < page_cnt; i++) {
+        const int page_obj = 3 + i * 2;
+        pdf_obj_start(buf, offsets, page_obj);
+        pdf_putsf(buf, "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 ", 2, width);
+        pdf_putsf(buf, " ", 2, height);
+        pdf_puts(buf, "]");
+        if (font) {
+            pdf_puti(buf, " /Resources << /Font << /F1 ", font_obj);
+            pdf_puts(buf, " 0 R >> >>");
+        } else {
+            pdf_puts(buf, " /Resources << >>");
+        }
+        pdf_puti(buf, " /Contents ", page_obj + 1);
+        pdf_puts(buf, " 0 R >>\nendobj\n");
+
+        pdf_obj_start(buf, offsets, page_obj + 1);
+        pdf_puti(buf, "<< /Length ", (long) contents[i].len);
+        pdf_puts(buf, " >>\nstream\n");
+        pdf_putn(buf, contents[i].s, contents[i].len);
+        pdf_puts(buf, "endstream\nendobj\n");
+    }
+
+    if (font) {
+        pdf_put_font(buf, offsets, font_obj, font);
+    }
+
+    pdf_obj_start(buf, offsets, info_obj);
+    pdf_puts(buf, "<< /Title (Zint Generated Symbol) /Producer (Zint) >>\nendobj\n");
+
+    /* Cross-reference table, each entry exactly 20 bytes */
+    xref_offset = (long) buf->len;
+    pdf_puti(buf, "xref\n0 ", info_obj + 1);
+    pdf_puts(buf, "\n0000000000 65535 f \n");
+    for (i = 1; i <= info_obj; i++) {
+        char entry[24];
+        sprintf(entry, "%010ld 00000 n \n", offsets[i]);
+        pdf_puts(buf, entry);
+    }
+    pdf_puti(buf, "trailer\n<< /Size ", info_obj + 1);
+    pdf_puti(buf, " /Root 1 0 R /Info ", info_obj);
+    pdf_puti(buf, " 0 R >>\nstartxref\n", xref_offset);
+    pdf_puts(buf, "\n%%EOF\n");
+
+    free(offsets);
+
+    return !buf->err;
+}
+
+/* Write out assembled document `buf` to `symbol->outfile` (or memory/stdout) */
+static int pdf_write(struct zint_symbol *symbol, const struct pdf_buf *buf) {
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+
+    if (!zint_fm_open(fmp, symbol, "wb")) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_ACCESS, symbol, 901, "Could not open PDF output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    (void) zint_fm_write(buf->s, 1, buf->len, fmp);
+
+    if (zint_fm_error(fmp)) {
+        ZEXT z_errtxtf(0, symbol, 902, "Incomplete write of PDF output (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+        (void) zint_fm_close(fmp, symbol);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+
+    if (!zint_fm_close(fmp, symbol)) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_WRITE, symbol, 903, "Failure on closing PDF output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    return 0;
+}
+
+/* Output `page_cnt` pages, one per element of `vectors` (all of the same dimensions), as a single PDF */
+INTERNAL int zint_pdf_plot_pages(struct zint_symbol *symbol, const struct zint_vector vectors[], const int page_cnt) {
+    struct pdf_buf *contents;
+    struct pdf_buf doc = {0};
+    struct pdf_font font;
+    int have_strings = 0;
+    int error_number = 0;
+    int i;
+
+    if (!(contents = (struct pdf_buf *) calloc(page_cnt, sizeof(struct pdf_buf)))) {
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 905, "Insufficient memory for PDF page buffers");
+    }
+
+    pdf_font_init(symbol, z_is_upcean(symbol->symbology), &font);
+
+    for (i = 0; i < page_cnt && !error_number; i++) {
+        if (!pdf_content(&contents[i], symbol, &vectors[i], &font, 0.0f, 0.0f)) {
+            error_number = ZINT_ERROR_MEMORY;
+        }
+        if (vectors[i].strings) {
+            have_strings = 1;
+        }
+    }
+    if (error_number || !pdf_document(&doc, contents, page_cnt, vectors[0].width, vectors[0].height,
+                                        have_strings ? &font : NULL)) {
+        error_number = z_errtxt(ZINT_ERROR_MEMORY, symbol, 904, "Insufficient memory for PDF output buffer");
+    } else {
+        error_number = pdf_write(symbol, &doc);
+    }
+
+    for (i = 0; i < page_cnt; i++) {
+        free(contents[i].s);
+    }
+    free(contents);
+    free(doc.s);
+
+    return error_number;
+}
+
+INTERNAL int zint_pdf_plot(struct zint_symbol *symbol) {
+    if (symbol->vector == NULL) {
+        return z_errtxt(ZINT_ERROR_INVALID_DATA, symbol, 900, "Vector header NULL");
+    }
+
+    return zint_pdf_plot_pages(symbol, symbol->vector, 1 /*page_cnt*/);
+}
+
+/* vim: set ts=4 sw=4 et : */
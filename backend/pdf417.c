@@ -258,8 +258,14 @@ static int pdf_text_num_length(short liste[3][PDF_MAX_LEN], const int indexliste
 
 /* Calculate length of TEX allowing for sub-mode switches (no-output version of `pdf_textprocess()`) */
 static int pdf_text_submode_length(const unsigned char chaine[], const int start, const int length, int *p_curtable) {
-    int j, indexlistet, curtable = *p_curtable, listet[PDF_MAX_LEN], wnet = 0;
-    unsigned char chainet[PDF_MAX_STREAM_LEN];
+    int j, indexlistet, curtable = *p_curtable, wnet = 0;
+    Z_SCRATCH_MARK(scratch_mark);
+    Z_LARGE_ARRAY(int, listet, PDF_MAX_LEN);
+    Z_LARGE_ARRAY(unsigned char, chainet, PDF_MAX_STREAM_LEN);
+
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
 
     for (indexlistet = 0; indexlistet < length; indexlistet++) {
         assert(pdf_asciix[chaine[start + indexlistet]]); /* Should only be dealing with TEX */
@@ -308,6 +314,7 @@ static int pdf_text_submode_length(const unsigned char chaine[], const int start
 
     *p_curtable = curtable;
 
+    Z_SCRATCH_RELEASE(scratch_mark);
     return wnet;
 }
 
@@ -448,9 +455,16 @@ static void pdf_textprocess(short *chainemc, int *p_mclength, const unsigned cha
     const int real_lastmode = PDF_REAL_MODE(lastmode);
     int j, indexlistet;
     int curtable = real_lastmode == PDF_TEX ? *p_curtable : T_ALPHA; /* Set default table upper alpha */
-    int listet[2][PDF_MAX_LEN] = {{0}};
-    unsigned char chainet[PDF_MAX_STREAM_LEN];
     int wnet = 0;
+    Z_SCRATCH_MARK(scratch_mark);
+    Z_LARGE_ARRAY2(int, listet, 2, PDF_MAX_LEN);
+    Z_LARGE_ARRAY(unsigned char, chainet, PDF_MAX_STREAM_LEN);
+
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
+
+    memset(listet, 0, sizeof(int) * 2 * PDF_MAX_LEN);
 
     /* Add mode indicator if needed */
     if (real_lastmode != PDF_TEX) {
@@ -510,6 +524,7 @@ static void pdf_textprocess(short *chainemc, int *p_mclength, const unsigned cha
 
     *p_curtable = curtable;
     pdf_textprocess_end(chainemc, p_mclength, is_last_seg, chainet, wnet, p_curtable, p_tex_padded);
+    Z_SCRATCH_RELEASE(scratch_mark);
 }
 
 /* Minimal text compaction */
@@ -519,8 +534,13 @@ static void pdf_textprocess_minimal(short *chainemc, int *p_mclength, const unsi
     const int real_lastmode = PDF_REAL_MODE(lastmode);
     int i, j, k;
     int curtable = real_lastmode == PDF_TEX ? *p_curtable : T_ALPHA; /* Set default table upper alpha */
-    unsigned char chainet[PDF_MAX_STREAM_LEN];
     int wnet = 0;
+    Z_SCRATCH_MARK(scratch_mark);
+    Z_LARGE_ARRAY(unsigned char, chainet, PDF_MAX_STREAM_LEN);
+
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
 
     /* Add mode indicator if needed */
     if (real_lastmode != PDF_TEX) {
@@ -567,6 +587,7 @@ static void pdf_textprocess_minimal(short *chainemc, int *p_mclength, const unsi
 
     *p_curtable = curtable;
     pdf_textprocess_end(chainemc, p_mclength, is_last_seg, chainet, wnet, p_curtable, p_tex_padded);
+    Z_SCRATCH_RELEASE(scratch_mark);
 }
 
 /* 671 */
@@ -691,19 +712,33 @@ static int pdf_table_length(const unsigned char source[], const int length, cons
     return i - position;
 }
 
+/* Edges are only kept in full for the current and next vertices plus a run edge per mode (see `struct
+   pdf_frontier` below), previous edges being recorded as 1-byte back-pointers per vertex and mode */
 struct pdf_edge {
     unsigned char mode;
+    unsigned char previous; /* Mode of previous edge, 0 if none */
     unsigned short from; /* Position in input data, 0-based */
     unsigned short len;
     unsigned short units; /* Cumulative TEX/NUM/BYT units since entering TEX/NUM/BYT mode */
     unsigned short unit_size; /* Number of codewords based on units since entering TEX/NUM/BYT mode */
     unsigned short size; /* Cumulative number of codewords in previous TEX/NUM/BYT modes */
-    unsigned short previous; /* Index into edges array */
 };
 
-/* Note 1st row of edges not used so valid previous cannot point there, i.e. won't be zero */
-#define PDF_PREVIOUS(edges, edge) \
-    ((edge)->previous ? (edges) + (edge)->previous : NULL)
+/* Edges ending at vertex `i + 1` while processing vertex `i`, with longer edges held in `runs` - these all end at
+   the end of the run of the mode's table (or digits) containing `i`, so there is at most one per mode */
+struct pdf_frontier {
+    struct pdf_edge next[PDF_NUM_MODES];
+    struct pdf_edge runs[PDF_NUM_MODES];
+};
+
+#define PDF_BACK_LONG   32 /* Edges this long or longer have length 0 in back-pointer, with start in `long_froms` */
+
+/* Back-pointer of edge: previous edge's mode in bits 0-2 and length in bits 3-7 if less than `PDF_BACK_LONG` */
+#define PDF_BACK(edge) ((edge)->previous | ((edge)->len < PDF_BACK_LONG ? (edge)->len << 3 : 0))
+
+/* Index into `long_froms` for long edge ending at `vertexIndex` - as the table run ending there is at least
+   `PDF_BACK_LONG` long, the next long edge for the mode must end at least `PDF_BACK_LONG` further on */
+#define PDF_LONG_IDX(vertexIndex, j) (((vertexIndex) / PDF_BACK_LONG) * PDF_NUM_MODES + (j))
 
 #if 0
 #include "pdf417_trace.h"
@@ -714,8 +749,8 @@ struct pdf_edge {
 #endif
 
 /* Initialize a new edge */
-static int pdf_new_Edge(struct pdf_edge *edges, const int mode, const int from, const int len, const int t_table,
-            const int lastmode, struct pdf_edge *previous, struct pdf_edge *edge) {
+static int pdf_new_Edge(const int mode, const int from, const int len, const int t_table, const int lastmode,
+            const struct pdf_edge *previous, struct pdf_edge *edge) {
     const int real_mode = PDF_REAL_MODE(mode);
     int previousMode, real_previousMode;
     int units;
@@ -729,7 +764,7 @@ static int pdf_new_Edge(struct pdf_edge *edges, const int mode, const int from,
         assert(previous->mode && previous->len && (previous->unit_size + previous->size));
         previousMode = previous->mode;
         real_previousMode = PDF_REAL_MODE(previousMode);
-        edge->previous = previous - edges;
+        edge->previous = previousMode;
         if (real_mode != real_previousMode) {
             edge->size = previous->size + previous->unit_size + 1; /* + TEX/NUM/BYT switch */
             units = 0;
@@ -860,108 +895,127 @@ static int pdf_new_units_better(const int mode, const int existing_units, const
 }
 
 /* Add an edge for a mode at a vertex if no existing edge or if more optimal than existing edge */
-static void pdf_addEdge(const unsigned char *source, const int length, struct pdf_edge *edges, const int mode,
-            const int from, const int len, const int t_table, const int lastmode, struct pdf_edge *previous) {
+static void pdf_addEdge(const unsigned char *source, const int length, struct pdf_frontier *fr, const int mode,
+            const int from, const int len, const int t_table, const int lastmode, const struct pdf_edge *previous) {
     struct pdf_edge edge;
-    const int new_size = pdf_new_Edge(edges, mode, from, len, t_table, lastmode, previous, &edge);
-    const int vertexIndex = from + len;
-    const int v_ij = vertexIndex * PDF_NUM_MODES + mode - 1;
-    const int v_size = edges[v_ij].size + edges[v_ij].unit_size;
-
-    if (edges[v_ij].mode == 0 || v_size > new_size
-            || (v_size == new_size && pdf_new_units_better(mode, edge.units, edges[v_ij].units))) {
-        PDF_TRACE_AddEdge(source, length, edges, previous, vertexIndex, t_table, &edge);
-        edges[v_ij] = edge;
+    const int new_size = pdf_new_Edge(mode, from, len, t_table, lastmode, previous, &edge);
+    struct pdf_edge *const v_edge = len == 1 ? &fr->next[mode - 1] : &fr->runs[mode - 1];
+    const int v_size = v_edge->size + v_edge->unit_size;
+
+    assert(len == 1 || v_edge->mode == 0 || v_edge->from + v_edge->len == from + len);
+
+    if (v_edge->mode == 0 || v_size > new_size
+            || (v_size == new_size && pdf_new_units_better(mode, edge.units, v_edge->units))) {
+        PDF_TRACE_AddEdge(source, length, v_edge, previous, from + len, t_table, &edge);
+        *v_edge = edge;
     } else {
-        PDF_TRACE_NotAddEdge(source, length, edges, previous, vertexIndex, t_table, &edge);
+        PDF_TRACE_NotAddEdge(source, length, v_edge, previous, from + len, t_table, &edge);
     }
 }
 
 /* Add edges for the various modes at a vertex */
-static void pdf_addEdges(const unsigned char source[], const int length, const int lastmode, struct pdf_edge *edges,
-            const int from, struct pdf_edge *previous) {
+static void pdf_addEdges(const unsigned char source[], const int length, const int lastmode,
+            struct pdf_frontier *fr, const int from, const struct pdf_edge *previous) {
     const unsigned char c = source[from];
     const int t_table = pdf_asciix[c];
 
     if (t_table & T_ALPHA) {
         const int len = pdf_table_length(source, length, from, T_ALPHA);
-        pdf_addEdge(source, length, edges, PDF_ALP, from, len, T_ALPHA, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_ALP, from, len, T_ALPHA, lastmode, previous);
     }
     if (!t_table || (t_table & T_PUNCT)) { /* Binary shift or PS */
-        pdf_addEdge(source, length, edges, PDF_ALP, from, 1 /*len*/, t_table & ~T_ALPHA, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_ALP, from, 1 /*len*/, t_table & ~T_ALPHA, lastmode, previous);
     }
 
     if (t_table & T_LOWER) {
         const int len = pdf_table_length(source, length, from, T_LOWER);
-        pdf_addEdge(source, length, edges, PDF_LOW, from, len, T_LOWER, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_LOW, from, len, T_LOWER, lastmode, previous);
     }
     if (!t_table || (t_table & (T_PUNCT | T_ALPHA))) { /* Binary shift or PS/AS */
-        pdf_addEdge(source, length, edges, PDF_LOW, from, 1 /*len*/, t_table & ~T_LOWER, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_LOW, from, 1 /*len*/, t_table & ~T_LOWER, lastmode, previous);
     }
 
     if (t_table & T_MIXED) {
         const int len = pdf_table_length(source, length, from, T_MIXED);
-        pdf_addEdge(source, length, edges, PDF_MIX, from, len, T_MIXED, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_MIX, from, len, T_MIXED, lastmode, previous);
         if (len > 1 && z_isdigit(source[from + 1])) { /* Add single-length edge before digit to compare to NUM */
-            pdf_addEdge(source, length, edges, PDF_MIX, from, 1 /*len*/, T_MIXED, lastmode, previous);
+            pdf_addEdge(source, length, fr, PDF_MIX, from, 1 /*len*/, T_MIXED, lastmode, previous);
         }
     }
     if (!t_table || (t_table & T_PUNCT)) { /* Binary shift or PS */
-        pdf_addEdge(source, length, edges, PDF_MIX, from, 1 /*len*/, t_table & ~T_MIXED, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_MIX, from, 1 /*len*/, t_table & ~T_MIXED, lastmode, previous);
     }
 
     if (t_table & T_PUNCT) {
         const int len = pdf_table_length(source, length, from, T_PUNCT);
-        pdf_addEdge(source, length, edges, PDF_PNC, from, len, T_PUNCT, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_PNC, from, len, T_PUNCT, lastmode, previous);
     }
     if (!t_table) { /* Binary shift */
-        pdf_addEdge(source, length, edges, PDF_PNC, from, 1 /*len*/, t_table, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_PNC, from, 1 /*len*/, t_table, lastmode, previous);
     }
 
     if (z_isdigit(c)) {
         const int len = z_cnt_digits(source, length, from, -1 /*all*/);
-        pdf_addEdge(source, length, edges, PDF_NUM, from, len, 0 /*t_table*/, lastmode, previous);
+        pdf_addEdge(source, length, fr, PDF_NUM, from, len, 0 /*t_table*/, lastmode, previous);
     }
 
-    pdf_addEdge(source, length, edges, PDF_BYT, from, 1 /*len*/, 0 /*t_table*/, lastmode, previous);
+    pdf_addEdge(source, length, fr, PDF_BYT, from, 1 /*len*/, 0 /*t_table*/, lastmode, previous);
 }
 
 /* Calculate optimized encoding modes */
 static int pdf_define_modes(short liste[3][PDF_MAX_LEN], int *p_indexliste, const unsigned char source[],
             const int length, const int lastmode, const int debug_print) {
 
-    int i, j, v_i;
+    int i, j;
     int minimalJ, minimalSize;
-    struct pdf_edge *edge;
+    struct pdf_frontier fr;
+    struct pdf_edge cur[PDF_NUM_MODES];
+    int mode, from, len, previous;
     int mode_start, mode_len;
 
-    struct pdf_edge *edges = (struct pdf_edge *) calloc((length + 1) * PDF_NUM_MODES, sizeof(struct pdf_edge));
-    if (!edges) {
+    /* Back-pointers for each vertex and mode (1st row not used), plus starts of long edges */
+    unsigned char *back = (unsigned char *) malloc((length + 1) * PDF_NUM_MODES);
+    unsigned short *long_froms = (unsigned short *) malloc(PDF_LONG_IDX(length, PDF_NUM_MODES)
+                                                            * sizeof(unsigned short));
+    if (!back || !long_froms) {
+        free(back);
+        free(long_froms);
         return 0;
     }
-    assert((length + 1) * PDF_NUM_MODES < USHRT_MAX); /* Guaranteed by input length limit */
+    memset(&fr, 0, sizeof(fr));
 
-    pdf_addEdges(source, length, lastmode, edges, 0, NULL);
+    pdf_addEdges(source, length, lastmode, &fr, 0, NULL);
 
-    PDF_TRACE_Edges("DEBUG Initial situation\n", source, length, edges, 0);
+    PDF_TRACE_Edges("DEBUG Initial situation\n", source, length, fr.next, 1);
 
     for (i = 1; i < length; i++) {
-        v_i = i * PDF_NUM_MODES;
+        memcpy(cur, fr.next, sizeof(cur));
+        memset(fr.next, 0, sizeof(fr.next));
         for (j = 0; j < PDF_NUM_MODES; j++) {
-            if (edges[v_i + j].mode) {
-                pdf_addEdges(source, length, lastmode, edges, i, edges + v_i + j);
+            if (fr.runs[j].mode && fr.runs[j].from + fr.runs[j].len == i + 1) {
+                fr.next[j] = fr.runs[j]; /* Was added before any edges from `i` */
+                fr.runs[j].mode = 0;
             }
         }
-        PDF_TRACE_Edges("DEBUG situation after adding edges to vertices at position %d\n", source, length, edges, i);
+        for (j = 0; j < PDF_NUM_MODES; j++) {
+            if (cur[j].mode) {
+                back[i * PDF_NUM_MODES + j] = (unsigned char) PDF_BACK(cur + j);
+                if (cur[j].len >= PDF_BACK_LONG) {
+                    long_froms[PDF_LONG_IDX(i, j)] = cur[j].from;
+                }
+                pdf_addEdges(source, length, lastmode, &fr, i, cur + j);
+            }
+        }
+        PDF_TRACE_Edges("DEBUG situation after adding edges to vertices at position %d\n", source, length, fr.next,
+                        i + 1);
     }
 
-    PDF_TRACE_Edges("DEBUG Final situation\n", source, length, edges, length);
+    PDF_TRACE_Edges("DEBUG Final situation\n", source, length, fr.next, length);
 
-    v_i = length * PDF_NUM_MODES;
     minimalJ = -1;
     minimalSize = INT_MAX;
     for (j = 0; j < PDF_NUM_MODES; j++) {
-        edge = edges + v_i + j;
+        const struct pdf_edge *const edge = &fr.next[j];
         if (edge->mode) {
             const int edge_size = edge->size + edge->unit_size;
             if (debug_print) {
@@ -978,21 +1032,32 @@ static int pdf_define_modes(short liste[3][PDF_MAX_LEN], int *p_indexliste, cons
     }
     assert(minimalJ >= 0);
 
-    edge = edges + v_i + minimalJ;
+    /* Final edge is in the frontier, the rest are back-pointers */
+    mode = fr.next[minimalJ].mode;
+    from = fr.next[minimalJ].from;
+    len = fr.next[minimalJ].len;
+    previous = fr.next[minimalJ].previous;
     mode_len = 0;
     mode_start = length;
-    while (edge) {
-        const int current_mode = edge->mode;
-        const int current_from = edge->from;
-        mode_len += edge->len;
-        edge = PDF_PREVIOUS(edges, edge);
-        if (!edge || edge->mode != current_mode) {
+    for (;;) {
+        mode_len += len;
+        if (previous != mode) {
             mode_start--;
             liste[0][mode_start] = mode_len;
-            liste[1][mode_start] = current_mode;
-            liste[2][mode_start] = current_from;
+            liste[1][mode_start] = mode;
+            liste[2][mode_start] = from;
             mode_len = 0;
         }
+        if (!previous) {
+            break;
+        }
+        i = from;
+        j = back[i * PDF_NUM_MODES + previous - 1];
+        mode = previous;
+        len = j >> 3;
+        from = len ? i - len : long_froms[PDF_LONG_IDX(i, mode - 1)];
+        len = i - from;
+        previous = j & 0x07;
     }
     *p_indexliste = length - mode_start;
     if (mode_start) {
@@ -1006,7 +1071,8 @@ static int pdf_define_modes(short liste[3][PDF_MAX_LEN], int *p_indexliste, cons
         fputc('\n', stdout);
     }
 
-    free(edges);
+    free(back);
+    free(long_froms);
 
     return 1;
 }
@@ -1016,10 +1082,17 @@ static int pdf_initial(struct zint_symbol *symbol, const unsigned char chaine[],
             const int is_micro, const int is_last_seg, int *p_lastmode, int *p_curtable, int *p_tex_padded,
             short chainemc[PDF_MAX_STREAM_LEN], int *p_mclength) {
     int i, indexchaine = 0, indexliste = 0;
-    short liste[3][PDF_MAX_LEN] = {{0}};
     int mclength;
     const int fast_encode = symbol->input_mode & FAST_MODE;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
+    Z_SCRATCH_MARK(scratch_mark);
+    Z_LARGE_ARRAY2(short, liste, 3, PDF_MAX_LEN);
+
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
+    memset(liste, 0, sizeof(short) * 3 * PDF_MAX_LEN);
 
     /* 456 */
 
@@ -1048,6 +1121,9 @@ static int pdf_initial(struct zint_symbol *symbol, const unsigned char chaine[],
         }
 
         pdf_appendix_d_encode(chaine, liste, &indexliste);
+        if (Z_SCRATCH_FAILED()) {
+            return ZINT_ERROR_MEMORY;
+        }
      } else {
         if (!pdf_define_modes(liste, &indexliste, chaine, length, *p_lastmode, debug_print)) {
             return z_errtxt(ZINT_ERROR_MEMORY, symbol, 749, "Insufficient memory for mode buffers");
@@ -1108,6 +1184,9 @@ static int pdf_initial(struct zint_symbol *symbol, const unsigned char chaine[],
                     indexchaine = i + 1 < indexliste ? liste[2][i + 1] : length;
                     *p_lastmode = PDF_TABLE_TO_MODE(*p_curtable);
                 }
+                if (Z_SCRATCH_FAILED()) {
+                    return ZINT_ERROR_MEMORY;
+                }
                 break;
             case PDF_BYT: /* 670 - octet stream mode */
                 zint_pdf_byteprocess(chainemc, &mclength, chaine, indexchaine, liste[0][i], *p_lastmode);
@@ -1130,6 +1209,7 @@ static int pdf_initial(struct zint_symbol *symbol, const unsigned char chaine[],
 
     *p_mclength = mclength;
 
+    Z_SCRATCH_RELEASE(scratch_mark);
     return 0;
 }
 
@@ -1225,7 +1305,7 @@ static int pdf_initial_segs(struct zint_symbol *symbol, struct zint_seg segs[],
 static int pdf_enc(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count) {
     int i, j, longueur, loop, mccorrection[520] = {0}, offset;
     int total, mclength, c1, c2, c3, dummy[35];
-    short chainemc[PDF_MAX_STREAM_LEN];
+    Z_LARGE_ARRAY(short, chainemc, PDF_MAX_STREAM_LEN);
     int rows, cols, ecc, ecc_cws, padding;
     char pattern[580];
     int bp = 0;
@@ -1234,6 +1314,10 @@ static int pdf_enc(struct zint_symbol *symbol, struct zint_seg segs[], const int
     int error_number;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if ((i = z_segs_length(segs, seg_count)) > PDF_MAX_LEN) {
         return z_errtxtf(ZINT_ERROR_TOO_LONG, symbol, 463, "Input length %d too long (maximum " PDF_MAX_LEN_S ")", i);
     }
@@ -1362,6 +1446,7 @@ static int pdf_enc(struct zint_symbol *symbol, struct zint_seg segs[], const int
 
     /* Set the length descriptor */
     chainemc[0] = mclength;
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
 
     /* 796 - we now take care of the Reed Solomon codes */
     assert(ecc >= 0 && ecc <= 8);
@@ -1380,6 +1465,7 @@ static int pdf_enc(struct zint_symbol *symbol, struct zint_seg segs[], const int
     for (i = ecc_cws - 1; i >= 0; i--) {
         chainemc[mclength++] = mccorrection[i] ? 929 - mccorrection[i] : 0;
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
 
     if (debug_print) {
         printf("Complete CW string (%d):\n", mclength);
@@ -1447,6 +1533,7 @@ static int pdf_enc(struct zint_symbol *symbol, struct zint_seg segs[], const int
             }
         }
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
     symbol->width = bp;
     symbol->rows = rows;
 
@@ -1597,6 +1684,8 @@ INTERNAL void zint_micropdf_expand(struct zint_symbol *symbol, short *chainemc,
     int RightRAP = zint_pdf_RAPTable[2][variant] - 1;
     int Cluster;
 
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
+
     /* Reed-Solomon error correction */
     ecc_cwds = zint_pdf_MicroVariants[2][variant]; /* Number of EC CWs */
     assert(ecc_cwds >= 7); /* Suppress clang-tidy-23 warning clang-analyzer-security.ArrayBound */
@@ -1622,6 +1711,7 @@ INTERNAL void zint_micropdf_expand(struct zint_symbol *symbol, short *chainemc,
     for (i = ecc_cwds - 1; i >= 0; i--) {
         chainemc[mclength++] = mccorrection[i];
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
 
     if (debug_print) {
         printf("Encoded Data Stream with ECC (%d):\n", mclength);
@@ -1685,6 +1775,7 @@ INTERNAL void zint_micropdf_expand(struct zint_symbol *symbol, short *chainemc,
         RightRAP = RightRAP == 51 ? 0 : RightRAP + 1;
         Cluster = Cluster == 2 ? 0 : Cluster + 1;
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
     symbol->width = bp;
 }
 
@@ -1693,7 +1784,7 @@ INTERNAL int zint_micropdf417(struct zint_symbol *symbol, struct zint_seg segs[]
     int i, longueur, padding;
     int ecc_cwds;
     int mclength, error_number = 0;
-    short chainemc[PDF_MAX_STREAM_LEN];
+    Z_LARGE_ARRAY(short, chainemc, PDF_MAX_STREAM_LEN);
     char pattern[580];
     int structapp_cws[18] = {0}; /* 3 (Index) + 10 (ID) + 4 (Count) + 1 (Last) */
     int structapp_cp = 0;
@@ -1702,6 +1793,10 @@ INTERNAL int zint_micropdf417(struct zint_symbol *symbol, struct zint_seg segs[]
     /* From ISO/IEC 24728:2006 Table 1 — MicroPDF417 version characteristics */
     static char col_max_codewords[5] = { 0, 20, 37, 82, 126 };
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if ((i = z_segs_length(segs, seg_count)) > MICRO_PDF_MAX_LEN) {
         return z_errtxtf(ZINT_ERROR_TOO_LONG, symbol, 474,
                         "Input length %d too long (maximum " MICRO_PDF_MAX_LEN_S ")", i);
@@ -33,95 +33,51 @@
 #ifndef Z_PDF417_TRACE_H
 #define Z_PDF417_TRACE_H
 
-static int PDF_TRACE_getPreviousMode(struct pdf_edge *edges, struct pdf_edge *edge) {
-    struct pdf_edge *previous = PDF_PREVIOUS(edges, edge);
-    return previous == NULL ? PDF_ALP : previous->mode;
-}
-
-static void PDF_TRACE_EdgeToString(char *buf, const unsigned char *source, const int length, struct pdf_edge *edges,
-            struct pdf_edge *edge) {
-    int previousMode = PDF_TRACE_getPreviousMode(edges, edge);
-    (void)length;
-    if (buf) {
-        sprintf(buf, "%d_%c %c(%d,%d) %d(%d,%d,%d) -> %d_%c",
-            edge->from, pdf_smodes[previousMode], pdf_smodes[edge->mode], source[edge->from], edge->len, edge->size
-            + edge->unit_size, edge->units, edge->unit_size, edge->size, edge->from + 1, pdf_smodes[edge->mode]);
-    } else {
-        printf("%d_%c %c(%d,%d) %d(%d,%d,%d) -> %d_%c",
-            edge->from, pdf_smodes[previousMode], pdf_smodes[edge->mode], source[edge->from], edge->len, edge->size
-            + edge->unit_size, edge->units, edge->unit_size, edge->size, edge->from + 1, pdf_smodes[edge->mode]);
-    }
-}
-
-static void PDF_TRACE_Path(const unsigned char *source, const int length, struct pdf_edge *edges,
-            struct pdf_edge *edge, char *result, const int result_size) {
-    struct pdf_edge *current;
-    PDF_TRACE_EdgeToString(result, source, length, edges, edge);
-    current = PDF_PREVIOUS(edges, edge);
-    while (current) {
-        char s[256];
-        char *pos;
-        int len;
-        PDF_TRACE_EdgeToString(s, source, length, edges, current);
-        pos = strrchr(s, ' ');
-        assert(pos);
-        len = strlen(result);
-        if ((pos - s) + 1 + len + 1 >= result_size) {
-            memcpy(result + result_size - 4, "...", 4); /* Include terminating NUL */
-            break;
-        }
-        memmove(result + (pos - s) + 1, result, len + 1);
-        memcpy(result, s, (pos - s) + 1);
-        current = PDF_PREVIOUS(edges, current);
-    }
-    puts(result);
+static void PDF_TRACE_EdgeToString(const unsigned char *source, const struct pdf_edge *edge) {
+    const int previousMode = edge->previous ? edge->previous : PDF_ALP;
+    printf("%d_%c %c(%d,%d) %d(%d,%d,%d) -> %d_%c",
+        edge->from, pdf_smodes[previousMode], pdf_smodes[edge->mode], source[edge->from], edge->len, edge->size
+        + edge->unit_size, edge->units, edge->unit_size, edge->size, edge->from + edge->len, pdf_smodes[edge->mode]);
 }
 
+/* Only the frontier is kept, so print the edges ending at `vertexIndex` */
 static void PDF_TRACE_Edges(const char *prefix, const unsigned char *source, const int length,
-            struct pdf_edge *edges, const int vertexIndex) {
-    int i, j, e_i;
-    char result[1024 * 2];
-    if (vertexIndex) {
-        printf(prefix, vertexIndex);
-    } else {
-        fputs(prefix, stdout);
-    }
-    for (i = vertexIndex; i <= length; i++) {
-        e_i = i * PDF_NUM_MODES;
-        for (j = 0; j < PDF_NUM_MODES; j++) {
-            if (edges[e_i + j].mode) {
-                fputs(" **** ", stdout);
-                PDF_TRACE_Path(source, length, edges, edges + e_i + j, result, (int) ARRAY_SIZE(result));
-            }
+            const struct pdf_edge *v_edges, const int vertexIndex) {
+    int j;
+    (void)length;
+    printf(prefix, vertexIndex);
+    for (j = 0; j < PDF_NUM_MODES; j++) {
+        if (v_edges[j].mode) {
+            fputs(" **** ", stdout);
+            PDF_TRACE_EdgeToString(source, v_edges + j);
+            fputc('\n', stdout);
         }
     }
 }
 
-static void PDF_TRACE_AddEdge(const unsigned char *source, const int length, struct pdf_edge *edges,
-            struct pdf_edge *previous, const int vertexIndex, const int t_table, struct pdf_edge *edge) {
+static void PDF_TRACE_AddEdge(const unsigned char *source, const int length, const struct pdf_edge *v_edge,
+            const struct pdf_edge *previous, const int vertexIndex, const int t_table, const struct pdf_edge *edge) {
     const int new_size = edge->size + edge->unit_size;
-    const int v_ij = vertexIndex * PDF_NUM_MODES + edge->mode - 1;
-    const int v_size = edges[v_ij].size + edges[v_ij].unit_size;
+    const int v_size = v_edge->size + v_edge->unit_size;
 
     (void)source; (void)length;
 
-    printf("add mode %c, t_table 0x%X, previous %d, from %d, len %d, v_ij %d, %d(%d,%d,%d) > %d(%d,%d,%d)\n",
-            pdf_smodes[edge->mode], t_table, previous ? (int) (previous - edges) : 0, edge->from, edge->len, v_ij,
-            v_size, edges[v_ij].units, edges[v_ij].unit_size, edges[v_ij].size,
+    printf("add mode %c, t_table 0x%X, previous %c, from %d, len %d, vertex %d, %d(%d,%d,%d) > %d(%d,%d,%d)\n",
+            pdf_smodes[edge->mode], t_table, previous ? pdf_smodes[previous->mode] : '-', edge->from, edge->len,
+            vertexIndex, v_size, v_edge->units, v_edge->unit_size, v_edge->size,
             new_size, edge->units, edge->unit_size, edge->size);
 }
 
-static void PDF_TRACE_NotAddEdge(const unsigned char *source, const int length, struct pdf_edge *edges,
-            struct pdf_edge *previous, const int vertexIndex, const int t_table, struct pdf_edge *edge) {
+static void PDF_TRACE_NotAddEdge(const unsigned char *source, const int length, const struct pdf_edge *v_edge,
+            const struct pdf_edge *previous, const int vertexIndex, const int t_table, const struct pdf_edge *edge) {
     const int new_size = edge->size + edge->unit_size;
-    const int v_ij = vertexIndex * PDF_NUM_MODES + edge->mode - 1;
-    const int v_size = edges[v_ij].size + edges[v_ij].unit_size;
+    const int v_size = v_edge->size + v_edge->unit_size;
 
     (void)source; (void)length;
 
-    printf("NOT mode %c, t_table %d, previous %d, from %d, len %d, v_ij %d, %d(%d,%d,%d) <= %d(%d,%d,%d)\n",
-            pdf_smodes[edge->mode], t_table, previous ? (int) (previous - edges) : 0, edge->from, edge->len, v_ij,
-            v_size, edges[v_ij].units, edges[v_ij].unit_size, edges[v_ij].size,
+    printf("NOT mode %c, t_table %d, previous %c, from %d, len %d, vertex %d, %d(%d,%d,%d) <= %d(%d,%d,%d)\n",
+            pdf_smodes[edge->mode], t_table, previous ? pdf_smodes[previous->mode] : '-', edge->from, edge->len,
+            vertexIndex, v_size, v_edge->units, v_edge->unit_size, v_edge->size,
             new_size, edge->units, edge->unit_size, edge->size);
 }
 
@@ -117,6 +117,9 @@ INTERNAL int zint_png_pixel_plot(struct zint_symbol *symbol, const unsigned char
     const unsigned char *pb;
     unsigned char *outdata = (unsigned char *) z_alloca(symbol->bitmap_width);
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     zpng_error.symbol = symbol;
 
     (void) zint_out_colour_get_rgb(symbol->fgcolour, &fg.red, &fg.green, &fg.blue, &fg_alpha);
@@ -232,19 +232,26 @@ INTERNAL int zint_ps_plot(struct zint_symbol *symbol) {
         draw_background = 0;
     }
 
-    for (i = 0; i < symbol->text_length; i++) {
-        switch (symbol->text[i]) {
-            case '(':
-            case ')':
-            case '\\':
-                ps_len += 2;
-                break;
-            default:
-                if (!iso_latin1 && symbol->text[i] >= 0x80) {
-                    iso_latin1 = 1;
-                }
-                ps_len++; /* Will overcount 2 byte UTF-8 chars */
-                break;
+    /* Longest escaped string (strings on a sheet page may come from different symbols) */
+    for (string = symbol->vector->strings; string; string = string->next) {
+        int len = 0;
+        for (i = 0; i < string->length; i++) {
+            switch (string->text[i]) {
+                case '(':
+                case ')':
+                case '\\':
+                    len += 2;
+                    break;
+                default:
+                    if (!iso_latin1 && string->text[i] >= 0x80) {
+                        iso_latin1 = 1;
+                    }
+                    len++; /* Will overcount 2 byte UTF-8 chars */
+                    break;
+            }
+        }
+        if (len > ps_len) {
+            ps_len = len;
         }
     }
 
@@ -343,6 +350,10 @@ INTERNAL int zint_ps_plot(struct zint_symbol *symbol) {
         struct zint_vector_rect **ultra_rects
             = (struct zint_vector_rect **) z_alloca(sizeof(struct zint_vector_rect *) * (rect_cnt ? rect_cnt : 1));
         int u_i = 0;
+        if (Z_SCRATCH_FAILED()) {
+            (void) zint_fm_close(fmp, symbol);
+            return ZINT_ERROR_MEMORY;
+        }
         for (i = 0; i <= 8; i++) {
             for (rect = symbol->vector->rectangles; rect; rect = rect->next) {
                 if ((i == 0 && rect->colour == -1) || rect->colour == i) {
@@ -441,6 +452,10 @@ INTERNAL int zint_ps_plot(struct zint_symbol *symbol) {
         const char *font;
         unsigned char *ps_string = (unsigned char *) z_alloca(ps_len + 1);
 
+        if (Z_SCRATCH_FAILED()) {
+            (void) zint_fm_close(fmp, symbol);
+            return ZINT_ERROR_MEMORY;
+        }
         if ((symbol->output_options & BOLD_TEXT) && !is_upcean) {
             font = "Helvetica-Bold";
         } else {
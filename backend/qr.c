@@ -243,8 +243,13 @@ static void qr_define_modes(char modes[], const unsigned int ddata[], const int
     char cur_mode;
     unsigned int prev_costs[QR_NUM_MODES];
     unsigned int cur_costs[QR_NUM_MODES];
+    Z_SCRATCH_MARK(scratch_mark); /* Called for each version tried */
     char (*char_modes)[QR_NUM_MODES] = (char (*)[QR_NUM_MODES]) z_alloca(QR_NUM_MODES * length);
 
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
+
     state[QR_VER] = (unsigned int) version;
 
     /* char_modes[i][j] represents the mode to encode the code point at index i such that the final segment
@@ -336,6 +341,7 @@ static void qr_define_modes(char modes[], const unsigned int ddata[], const int
     if (debug_print) {
         printf("  Modes: %.*s\n", length, modes);
     }
+    Z_SCRATCH_RELEASE(scratch_mark);
 }
 
 /* Returns mode indicator based on version and mode */
@@ -415,8 +421,8 @@ static int qr_terminator_bits(const int version) {
     return 3 + (version - MICROQR_VERSION) * 2; /* MICROQR */
 }
 
-/* Convert input data to a binary stream and add padding */
-static int qr_binary(char binary[], int bp, const int version, const char modes[],
+/* Convert input data to a binary stream */
+static void qr_binary(struct z_bitstream *bs, const int version, const char modes[],
             const unsigned int ddata[], const int length, const int gs1,
             const int eci, const int debug_print) {
     int position = 0;
@@ -426,13 +432,13 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
     int percent_count;
 
     if (eci != 0) { /* Not applicable to MICROQR */
-        bp = z_bin_append_posn(7, version < RMQR_VERSION ? 4 : 3, binary, bp); /* ECI (Table 4) */
+        z_bs_append(bs, 7, version < RMQR_VERSION ? 4 : 3); /* ECI (Table 4) */
         if (eci <= 127) {
-            bp = z_bin_append_posn(eci, 8, binary, bp); /* 000000 to 000127 */
+            z_bs_append(bs, eci, 8); /* 000000 to 000127 */
         } else if (eci <= 16383) {
-            bp = z_bin_append_posn(0x8000 + eci, 16, binary, bp); /* 000128 to 016383 */
+            z_bs_append(bs, 0x8000 + eci, 16); /* 000128 to 016383 */
         } else {
-            bp = z_bin_append_posn(0xC00000 + eci, 24, binary, bp); /* 016384 to 999999 */
+            z_bs_append(bs, 0xC00000 + eci, 24); /* 016384 to 999999 */
         }
     }
 
@@ -451,7 +457,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
 
         /* Mode indicator */
         if (modebits) {
-            bp = z_bin_append_posn(qr_mode_indicator(version, block_mode), modebits, binary, bp);
+            z_bs_append(bs, qr_mode_indicator(version, block_mode), modebits);
         }
 
         switch (block_mode) {
@@ -459,7 +465,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
                 /* Kanji mode */
 
                 /* Character count indicator */
-                bp = z_bin_append_posn(block_length, qr_cci_bits(version, block_mode), binary, bp);
+                z_bs_append(bs, block_length, qr_cci_bits(version, block_mode));
 
                 if (debug_print) {
                     printf("Kanji block (length %d)\n\t", block_length);
@@ -478,7 +484,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
 
                     prod = ((jis >> 8) * 0xC0) + (jis & 0xFF);
 
-                    bp = z_bin_append_posn(prod, 13, binary, bp);
+                    z_bs_append(bs, prod, 13);
 
                     if (debug_print) {
                         printf("0x%04X ", prod);
@@ -494,7 +500,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
                 /* Byte mode */
 
                 /* Character count indicator */
-                bp = z_bin_append_posn(block_length + double_byte, qr_cci_bits(version, block_mode), binary, bp);
+                z_bs_append(bs, block_length + double_byte, qr_cci_bits(version, block_mode));
 
                 if (debug_print) {
                     printf("Byte block (length %d)\n\t", block_length + double_byte);
@@ -504,7 +510,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
                 for (i = 0; i < block_length; i++) {
                     unsigned int byte = ddata[position + i];
 
-                    bp = z_bin_append_posn(byte, byte > 0xFF ? 16 : 8, binary, bp);
+                    z_bs_append(bs, byte, byte > 0xFF ? 16 : 8);
 
                     if (debug_print) {
                         printf("0x%02X(%d) ", byte, (int) byte);
@@ -529,7 +535,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
                 }
 
                 /* Character count indicator */
-                bp = z_bin_append_posn(block_length + percent_count, qr_cci_bits(version, block_mode), binary, bp);
+                z_bs_append(bs, block_length + percent_count, qr_cci_bits(version, block_mode));
 
                 if (debug_print) {
                     printf("Alpha block (length %d)\n\t", block_length + percent_count);
@@ -602,7 +608,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
                         }
                     }
 
-                    bp = z_bin_append_posn(prod, 1 + (5 * count), binary, bp);
+                    z_bs_append(bs, prod, 1 + (5 * count));
 
                     if (debug_print) {
                         printf("0x%X ", prod);
@@ -618,7 +624,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
                 /* Numeric mode */
 
                 /* Character count indicator */
-                bp = z_bin_append_posn(block_length, qr_cci_bits(version, block_mode), binary, bp);
+                z_bs_append(bs, block_length, qr_cci_bits(version, block_mode));
 
                 if (debug_print) {
                     printf("Number block (length %d)\n\t", block_length);
@@ -646,7 +652,7 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
                         }
                     }
 
-                    bp = z_bin_append_posn(prod, 1 + (3 * count), binary, bp);
+                    z_bs_append(bs, prod, 1 + (3 * count));
 
                     if (debug_print) {
                         printf("0x%X(%d) ", prod, prod);
@@ -664,99 +670,85 @@ static int qr_binary(char binary[], int bp, const int version, const char modes[
 
         position += block_length;
     } while (position < length);
-
-    return bp;
 }
 
-/* Call `qr_binary()` for each segment, dealing with Structured Append and GS1 beforehand and padding afterwards */
-static int qr_binary_segs(unsigned char datastream[], const int version, const int target_codewords,
+/* Call `qr_binary()` for each segment, dealing with Structured Append and GS1 beforehand, writing to `bs`. Unless
+   MICROQR (which does its own), then terminate and pad to `target_codewords` */
+static void qr_binary_segs(struct z_bitstream *bs, const int version, const int target_codewords,
             const char modes[], const unsigned int ddata[], const struct zint_seg segs[], const int seg_count,
-            const struct zint_structapp *p_structapp, const int gs1, const int est_binlen, const int debug_print) {
-    int i, j;
+            const struct zint_structapp *p_structapp, const int gs1, const int debug_print) {
+    int i;
     const unsigned int *dd = ddata;
     const char *mds = modes;
-    int bp = 0;
+    int bp;
     int termbits, padbits;
     int current_bytes;
     int toggle;
-    char *binary = (char *) z_alloca(est_binlen + 12);
 
     assert(seg_count > 0); /* Suppress clang-tidy clang-analyzer-core.uninitialized.Assign warning */
 
-    *binary = '\0';
-
     if (p_structapp) {
-        bp = z_bin_append_posn(3, 4, binary, bp); /* Structured Append indicator */
-        bp = z_bin_append_posn(p_structapp->index - 1, 4, binary, bp);
-        bp = z_bin_append_posn(p_structapp->count - 1, 4, binary, bp);
-        bp = z_bin_append_posn(z_to_int(ZCUCP(p_structapp->id), (int) strlen(p_structapp->id)), 8, binary,
-                                bp); /* Parity */
+        z_bs_append(bs, 3, 4); /* Structured Append indicator */
+        z_bs_append(bs, p_structapp->index - 1, 4);
+        z_bs_append(bs, p_structapp->count - 1, 4);
+        z_bs_append(bs, z_to_int(ZCUCP(p_structapp->id), (int) strlen(p_structapp->id)), 8); /* Parity */
     }
 
     if (gs1) { /* Not applicable to MICROQR */
         if (version < RMQR_VERSION) {
-            bp = z_bin_append_posn(5, 4, binary, bp); /* FNC1 */
+            z_bs_append(bs, 5, 4); /* FNC1 */
         } else {
-            bp = z_bin_append_posn(5, 3, binary, bp);
+            z_bs_append(bs, 5, 3);
         }
     }
 
     for (i = 0; i < seg_count; i++) {
-        bp = qr_binary(binary, bp, version, mds, dd, segs[i].length, gs1, segs[i].eci, debug_print);
+        qr_binary(bs, version, mds, dd, segs[i].length, gs1, segs[i].eci, debug_print);
         mds += segs[i].length;
         dd += segs[i].length;
     }
 
     if (version >= MICROQR_VERSION && version < MICROQR_VERSION + 4) {
         /* MICROQR does its own terminating/padding */
-        memcpy(datastream, binary, bp);
-        return bp;
+        return;
     }
 
     /* Terminator */
-    termbits = 8 - bp % 8;
+    termbits = 8 - bs->bp % 8;
     if (termbits == 8) {
         termbits = 0;
     }
-    current_bytes = (bp + termbits) / 8;
+    current_bytes = (bs->bp + termbits) / 8;
     if (termbits || current_bytes < target_codewords) {
         int max_termbits = qr_terminator_bits(version);
         termbits = termbits < max_termbits && current_bytes == target_codewords ? termbits : max_termbits;
-        bp = z_bin_append_posn(0, termbits, binary, bp);
+        z_bs_append(bs, 0, termbits);
     }
+    bp = bs->bp;
 
     /* Padding bits */
     padbits = 8 - bp % 8;
     if (padbits == 8) {
         padbits = 0;
     }
-    if (padbits) {
-        current_bytes = (bp + padbits) / 8;
-        (void) z_bin_append_posn(0, padbits, binary, bp); /* Last use so not setting bp */
-    }
-
-    if (debug_print) printf("Terminated binary (%d): %.*s (padbits %d)\n", bp, bp, binary, padbits);
+    z_bs_append(bs, 0, padbits);
+    z_bs_flush(bs); /* Data now in 8-bit codewords */
+    current_bytes = bs->bp >> 3;
 
-    /* Put data into 8-bit codewords */
-    for (i = 0; i < current_bytes; i++) {
-        int p;
-        j = i * 8;
-        datastream[i] = 0x00;
-        for (p = 0; p < 8; p++) {
-            if (binary[j + p] == '1') {
-                datastream[i] |= (0x80 >> p);
-            }
-        }
+    if (debug_print) {
+        printf("Terminated binary (%d): ", bp);
+        z_debug_print_bits(bs->buf, bp);
+        printf(" (padbits %d)\n", padbits);
     }
 
     /* Add pad codewords */
     toggle = 0;
     for (i = current_bytes; i < target_codewords; i++) {
         if (toggle == 0) {
-            datastream[i] = 0xEC;
+            bs->buf[i] = 0xEC;
             toggle = 1;
         } else {
-            datastream[i] = 0x11;
+            bs->buf[i] = 0x11;
             toggle = 0;
         }
     }
@@ -764,17 +756,18 @@ static int qr_binary_segs(unsigned char datastream[], const int version, const i
     if (debug_print) {
         printf("Resulting codewords (%d):\n\t", target_codewords);
         for (i = 0; i < target_codewords; i++) {
-            printf("0x%02X ", datastream[i]);
+            printf("0x%02X ", bs->buf[i]);
         }
         fputc('\n', stdout);
     }
-
-    return 0; /* Not used */
 }
 
-/* Split data into blocks, add error correction and then interleave the blocks and error correction data */
+/* Split data into blocks, add error correction and then interleave the blocks and error correction data.
+   If `prev_datastream` given, the error correction is updated from that of `prev_fullstream` (see
+   `zint_rs_encode_delta()`) */
 static void qr_add_ecc(unsigned char fullstream[], const unsigned char datastream[], const int version,
-            const int data_cw, const int blocks, const int debug_print) {
+            const int data_cw, const int blocks, const unsigned char prev_datastream[],
+            const unsigned char prev_fullstream[], const int debug_print) {
     int ecc_cw;
     int short_data_block_length;
     int qty_short_blocks;
@@ -809,6 +802,9 @@ static void qr_add_ecc(unsigned char fullstream[], const unsigned char datastrea
     ecc_block = (unsigned char *) z_alloca(ecc_block_length);
     interleaved_data = (unsigned char *) z_alloca(data_cw);
     interleaved_ecc = (unsigned char *) z_alloca(ecc_cw);
+    if (Z_SCRATCH_FAILED()) {
+        return; /* Checked by caller */
+    }
 
     zint_rs_init_gf(&rs, 0x11d);
     zint_rs_init_code(&rs, ecc_block_length, 0);
@@ -822,7 +818,14 @@ static void qr_add_ecc(unsigned char fullstream[], const unsigned char datastrea
             data_block[j] = datastream[in_posn + j];
         }
 
-        zint_rs_encode(&rs, length_this_block, data_block, ecc_block);
+        if (prev_datastream) {
+            for (j = 0; j < ecc_block_length; j++) {
+                ecc_block[j] = prev_fullstream[data_cw + (j * blocks) + i];
+            }
+            zint_rs_encode_delta(&rs, length_this_block, data_block, prev_datastream + in_posn, ecc_block);
+        } else {
+            zint_rs_encode(&rs, length_this_block, data_block, ecc_block);
+        }
 
         if (debug_print) {
             printf("Block %d: ", i + 1);
@@ -990,8 +993,9 @@ static int qr_cwbit(const unsigned char *fullstream, const int i) {
     return 0;
 }
 
+/* Place codewords, setting `posns` (if non-NULL) to the grid index of each bit */
 static void qr_populate_grid(unsigned char *grid, const int h_size, const int v_size, const unsigned char *fullstream,
-            const int cw) {
+            const int cw, unsigned short posns[]) {
     const int not_rmqr = v_size == h_size;
     const int x_start = h_size - (not_rmqr ? 2 : 3); /* For rMQR allow for righthand vertical timing pattern */
     int direction = 1; /* up */
@@ -1011,12 +1015,18 @@ static void qr_populate_grid(unsigned char *grid, const int h_size, const int v_
 
         if (!(grid[r + (x + 1)] & 0xF0)) {
             grid[r + (x + 1)] = qr_cwbit(fullstream, i);
+            if (posns) {
+                posns[i] = (unsigned short) (r + (x + 1));
+            }
             i++;
         }
 
         if (i < n) {
             if (!(grid[r + x] & 0xF0)) {
                 grid[r + x] = qr_cwbit(fullstream, i);
+                if (posns) {
+                    posns[i] = (unsigned short) (r + x);
+                }
                 i++;
             }
         }
@@ -1320,6 +1330,10 @@ static int qr_apply_bitmask(unsigned char *grid, const int size, const int ecc_l
     char str[15];
 #endif
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
     /* Perform data masking */
     memset(mask, 0, size_squared);
     for (y = 0; y < size; y++) {
@@ -1437,6 +1451,9 @@ static int qr_calc_binlen(const int version, char modes[], const unsigned int dd
 
     if (!mode_preset) {
         qr_define_modes(modes, ddata, length, gs1, version, debug_print);
+        if (Z_SCRATCH_FAILED()) {
+            return 0; /* Checked by caller */
+        }
     }
 
     currentMode = ' '; /* Null */
@@ -1614,8 +1631,14 @@ INTERNAL int zint_qrcode(struct zint_symbol *symbol, struct zint_seg segs[], con
     char *modes = (char *) z_alloca(eci_length_segs);
     char *prev_modes = (char *) z_alloca(eci_length_segs);
     unsigned char *datastream;
+    struct z_bitstream bs;
     unsigned char *fullstream;
     unsigned char *grid;
+    struct zint_delta *delta;
+
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     user_mask = (symbol->option_3 >> 8) & 0x0F; /* User mask is pattern + 1, so >= 1 and <= 8 */
     if (user_mask > 8) {
@@ -1791,13 +1814,40 @@ INTERNAL int zint_qrcode(struct zint_symbol *symbol, struct zint_seg segs[], con
 
     datastream = (unsigned char *) z_alloca(target_codewords + 1);
     fullstream = (unsigned char *) z_alloca(qr_total_codewords[version - 1] + 1);
+    if (Z_SCRATCH_FAILED()) { /* Also catches any failure in `qr_calc_binlen_segs()` */
+        return ZINT_ERROR_MEMORY;
+    }
 
-    (void) qr_binary_segs(datastream, version, target_codewords, modes, ddata, local_segs, seg_count, p_structapp,
-                    gs1, est_binlen, debug_print);
+    z_bs_init(&bs, datastream);
+    qr_binary_segs(&bs, version, target_codewords, modes, ddata, local_segs, seg_count, p_structapp, gs1,
+                    debug_print);
 #ifdef ZINT_TEST
     if (symbol->debug & ZINT_DEBUG_TEST) z_debug_test_codeword_dump(symbol, datastream, target_codewords);
 #endif
-    qr_add_ecc(fullstream, datastream, version, target_codewords, blocks, debug_print);
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
+    delta = z_delta_get(symbol, version, ecc_level, target_codewords);
+    if (delta && user_mask && user_mask - 1 != delta->mask) {
+        delta = NULL; /* Different mask requested */
+    }
+    qr_add_ecc(fullstream, datastream, version, target_codewords, blocks, delta ? delta->data : NULL,
+                delta ? delta->full : NULL, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
+
+    if (delta) {
+        /* Patch modules of previous encode, keeping its mask */
+        z_delta_patch(symbol, delta, datastream, fullstream);
+        Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
+
+        /* Feedback options */
+        symbol->option_1 = ecc_level + 1;
+        symbol->option_2 = version;
+        symbol->option_3 = (symbol->option_3 & 0xFF) | ((delta->mask + 1) << 8);
+
+        return warn_number;
+    }
 
     size = qr_sizes[version - 1];
     size_squared = size * size;
@@ -1805,16 +1855,25 @@ INTERNAL int zint_qrcode(struct zint_symbol *symbol, struct zint_seg segs[], con
     assert(size >= 21); /* Suppress clang-tidy-21 clang-analyzer-security.ArrayBound */
 
     grid = (unsigned char *) z_alloca(size_squared);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     memset(grid, 0, size_squared);
 
     qr_setup_grid(grid, size, version);
-    qr_populate_grid(grid, size, size, fullstream, qr_total_codewords[version - 1]);
+    qr_populate_grid(grid, size, size, fullstream, qr_total_codewords[version - 1],
+                    z_delta_posns(symbol));
 
     if (version >= 7) {
         qr_add_version_info(grid, size, version);
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
 
     bitmask = qr_apply_bitmask(grid, size, ecc_level, user_mask, fast_encode, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_MASK);
 
     /* Feedback options */
     symbol->option_1 = ecc_level + 1;
@@ -1837,13 +1896,16 @@ INTERNAL int zint_qrcode(struct zint_symbol *symbol, struct zint_seg segs[], con
     }
     symbol->height = size;
 
+    z_delta_save(symbol, version, ecc_level, bitmask, datastream, target_codewords, fullstream,
+                qr_total_codewords[version - 1]);
+
     return warn_number;
 }
 
 /* Write terminator, padding & ECC */
-static int microqr_end(struct zint_symbol *symbol, char binary_data[], int bp, const int ecc_level,
+static void microqr_end(struct zint_symbol *symbol, struct z_bitstream *bs, const int ecc_level,
             const int version) {
-    int i, j;
+    int i;
     int bits_left;
     unsigned char data_blocks[17];
     unsigned char ecc_blocks[15];
@@ -1856,32 +1918,33 @@ static int microqr_end(struct zint_symbol *symbol, char binary_data[], int bp, c
     const int bits_end = version == 0 || version == 2 ? 4 : 8;
 
     /* Add terminator */
-    bits_left = bits_total - bp;
+    bits_left = bits_total - bs->bp;
     if (bits_left <= terminator_bits) {
-        if (bits_left) {
-            bp = z_bin_append_posn(0, bits_left, binary_data, bp);
-            bits_left = 0;
-        }
+        z_bs_append(bs, 0, bits_left);
+        bits_left = 0;
     } else {
-        bp = z_bin_append_posn(0, terminator_bits, binary_data, bp);
+        z_bs_append(bs, 0, terminator_bits);
         bits_left -= terminator_bits;
     }
 
     if (symbol->debug & ZINT_DEBUG_PRINT) {
-        printf("M%d Terminated binary (%d): %.*s (bits_left %d)\n", version + 1, bp, bp, binary_data, bits_left);
+        z_bs_flush(bs);
+        printf("M%d Terminated binary (%d): ", version + 1, bs->bp);
+        z_debug_print_bits(bs->buf, bs->bp);
+        printf(" (bits_left %d)\n", bits_left);
     }
 
     /* Manage last (4-bit) block */
     if (bits_end == 4 && bits_left && bits_left <= 4) {
-        bp = z_bin_append_posn(0, bits_left, binary_data, bp);
+        z_bs_append(bs, 0, bits_left);
         bits_left = 0;
     }
 
     if (bits_left) {
         /* Complete current byte */
-        int remainder = 8 - (bp % 8);
+        int remainder = 8 - (bs->bp % 8);
         if (remainder != 8) {
-            bp = z_bin_append_posn(0, remainder, binary_data, bp);
+            z_bs_append(bs, 0, remainder);
             bits_left -= remainder;
         }
 
@@ -1891,30 +1954,22 @@ static int microqr_end(struct zint_symbol *symbol, char binary_data[], int bp, c
         }
         remainder = bits_left / 8;
         for (i = 0; i < remainder; i++) {
-            bp = z_bin_append_posn(i & 1 ? 0x11 : 0xEC, 8, binary_data, bp);
+            z_bs_append(bs, i & 1 ? 0x11 : 0xEC, 8);
         }
         if (bits_end == 4) {
-            bp = z_bin_append_posn(0, 4, binary_data, bp);
+            z_bs_append(bs, 0, 4);
         }
     }
-    assert((bp & 0x07) == 8 - bits_end);
+    assert((bs->bp & 0x07) == 8 - bits_end);
 
-    /* Copy data into codewords */
-    for (i = 0; i < data_codewords; i++) {
-        const int bits = i + 1 == data_codewords ? bits_end : 8;
-        data_blocks[i] = 0;
-
-        for (j = 0; j < bits; j++) {
-            if (binary_data[(i * 8) + j] == '1') {
-                data_blocks[i] |= 0x80 >> j;
-            }
-        }
-    }
+    /* Copy data into codewords (any last 4-bit block zero-padded by the flush) */
+    z_bs_flush(bs);
+    memcpy(data_blocks, bs->buf, data_codewords);
 #ifdef ZINT_TEST
     if (symbol->debug & ZINT_DEBUG_TEST) {
         char bp_buf[10];
         z_debug_test_codeword_dump(symbol, data_blocks, data_codewords);
-        sprintf(bp_buf, "%d", bp); /* Append `bp` to detect padding errors */
+        sprintf(bp_buf, "%d", bs->bp); /* Append `bp` to detect padding errors */
         z_errtxt_adj(0, symbol, "%s (%s)", bp_buf);
     }
 #endif
@@ -1926,10 +1981,9 @@ static int microqr_end(struct zint_symbol *symbol, char binary_data[], int bp, c
 
     /* Add Reed-Solomon codewords to binary data */
     for (i = 0; i < ecc_codewords; i++) {
-        bp = z_bin_append_posn(ecc_blocks[i], 8, binary_data, bp);
+        z_bs_append(bs, ecc_blocks[i], 8);
     }
-
-    return bp;
+    z_bs_flush(bs);
 }
 
 static void microqr_setup_grid(unsigned char *grid, const int size) {
@@ -1960,7 +2014,8 @@ static void microqr_setup_grid(unsigned char *grid, const int size) {
     }
 }
 
-static void microqr_populate_grid(unsigned char *grid, const int size, const char full_stream[], int bp) {
+static void microqr_populate_grid(unsigned char *grid, const int size, const unsigned char full_stream[],
+            const int bp) {
     int direction = 1; /* up */
     int row = 0; /* right hand side */
     int i;
@@ -1972,13 +2027,13 @@ static void microqr_populate_grid(unsigned char *grid, const int size, const cha
         int x = (size - 2) - (row * 2);
 
         if (!(grid[(y * size) + (x + 1)] & 0xF0)) {
-            grid[(y * size) + (x + 1)] = full_stream[i] == '1';
+            grid[(y * size) + (x + 1)] = z_bs_bit(full_stream, i);
             i++;
         }
 
         if (i < bp) {
             if (!(grid[(y * size) + x] & 0xF0)) {
-                grid[(y * size) + x] = full_stream[i] == '1';
+                grid[(y * size) + x] = z_bs_bit(full_stream, i);
                 i++;
             }
         }
@@ -2043,6 +2098,10 @@ static int microqr_apply_bitmask(unsigned char *grid, const int size, const int
     unsigned char *mask = (unsigned char *) z_alloca(size_squared);
     unsigned char *eval = (unsigned char *) z_alloca(size_squared);
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
     /* Perform data masking */
     memset(mask, 0, size_squared);
     for (y = 0; y < size; y++) {
@@ -2100,8 +2159,8 @@ static int microqr_apply_bitmask(unsigned char *grid, const int size, const int
 /* Micro QR Code ISO/IEC 18004:2024 */
 INTERNAL int zint_microqr(struct zint_symbol *symbol, unsigned char source[], int length) {
     int i, size, j;
-    char full_stream[200];
-    int bp;
+    unsigned char full_stream[Z_BS_SIZE(200)];
+    struct z_bitstream bs;
     int full_multibyte;
     int user_mask;
 
@@ -2270,23 +2329,42 @@ INTERNAL int zint_microqr(struct zint_symbol *symbol, unsigned char source[], in
     }
 
     qr_define_modes(modes, ddata, length, 0 /*gs1*/, MICROQR_VERSION + version, debug_print);
+    if (Z_SCRATCH_FAILED()) { /* Also catches any failure in `qr_calc_binlen_segs()` */
+        return ZINT_ERROR_MEMORY;
+    }
 
-    bp = qr_binary_segs(ZUCP(full_stream), MICROQR_VERSION + version, 0 /*target_codewords*/, modes, ddata,
-                        segs, seg_count, NULL /*p_structapp*/, 0 /*gs1*/, binary_count[version], debug_print);
+    z_bs_init(&bs, full_stream);
+    qr_binary_segs(&bs, MICROQR_VERSION + version, 0 /*target_codewords*/, modes, ddata, segs, seg_count,
+                    NULL /*p_structapp*/, 0 /*gs1*/, debug_print);
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
 
-    if (debug_print) printf("Binary (%d): %.*s\n", bp, bp, full_stream);
+    if (debug_print) {
+        z_bs_flush(&bs);
+        printf("Binary (%d): ", bs.bp);
+        z_debug_print_bits(full_stream, bs.bp);
+        fputc('\n', stdout);
+    }
 
-    bp = microqr_end(symbol, full_stream, bp, ecc_level, version);
+    microqr_end(symbol, &bs, ecc_level, version);
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
 
     size = microqr_sizes[version];
     size_squared = size * size;
 
     grid = (unsigned char *) z_alloca(size_squared);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     memset(grid, 0, size_squared);
 
     microqr_setup_grid(grid, size);
-    microqr_populate_grid(grid, size, full_stream, bp);
+    microqr_populate_grid(grid, size, full_stream, bs.bp);
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
     bitmask = microqr_apply_bitmask(grid, size, user_mask, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_MASK);
 
     /* Feedback options */
     symbol->option_1 = ecc_level + 1;
@@ -2341,12 +2419,17 @@ INTERNAL int zint_upnqr(struct zint_symbol *symbol, unsigned char source[], int
     const int content_segs = symbol->output_options & BARCODE_CONTENT_SEGS;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
     unsigned char *datastream;
+    struct z_bitstream bs;
     unsigned char *fullstream;
     unsigned char *grid;
     unsigned int *ddata = (unsigned int *) z_alloca(sizeof(unsigned int) * length);
     char *modes = (char *) z_alloca(length + 1);
     unsigned char *preprocessed = (unsigned char *) z_alloca(length + 1);
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     user_mask = (symbol->option_3 >> 8) & 0x0F; /* User mask is pattern + 1, so >= 1 and <= 8 */
     if (user_mask > 8) {
         user_mask = 0; /* Ignore */
@@ -2399,26 +2482,43 @@ INTERNAL int zint_upnqr(struct zint_symbol *symbol, unsigned char source[], int
 
     datastream = (unsigned char *) z_alloca(target_codewords + 1);
     fullstream = (unsigned char *) z_alloca(qr_total_codewords[version - 1] + 1);
+    if (Z_SCRATCH_FAILED()) { /* Also catches any failure in `qr_calc_binlen_segs()` */
+        return ZINT_ERROR_MEMORY;
+    }
 
-    (void) qr_binary_segs(datastream, version, target_codewords, modes, ddata, segs, seg_count, NULL /*p_structapp*/,
-                    0 /*gs1*/, est_binlen, debug_print);
+    z_bs_init(&bs, datastream);
+    qr_binary_segs(&bs, version, target_codewords, modes, ddata, segs, seg_count, NULL /*p_structapp*/, 0 /*gs1*/,
+                    debug_print);
 #ifdef ZINT_TEST
     if (symbol->debug & ZINT_DEBUG_TEST) z_debug_test_codeword_dump(symbol, datastream, target_codewords);
 #endif
-    qr_add_ecc(fullstream, datastream, version, target_codewords, blocks, debug_print);
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
+    qr_add_ecc(fullstream, datastream, version, target_codewords, blocks, NULL, NULL, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
 
     size = qr_sizes[version - 1];
     size_squared = size * size;
 
     grid = (unsigned char *) z_alloca(size_squared);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     memset(grid, 0, size_squared);
 
     qr_setup_grid(grid, size, version);
-    qr_populate_grid(grid, size, size, fullstream, qr_total_codewords[version - 1]);
+    qr_populate_grid(grid, size, size, fullstream, qr_total_codewords[version - 1], NULL);
 
     qr_add_version_info(grid, size, version);
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
 
     bitmask = qr_apply_bitmask(grid, size, ecc_level, user_mask, fast_encode, debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_MASK);
 
     /* Feedback options */
     symbol->option_1 = ecc_level + 1;
@@ -2562,9 +2662,14 @@ INTERNAL int zint_rmqr(struct zint_symbol *symbol, struct zint_seg segs[], const
     unsigned int *ddata = (unsigned int *) z_alloca(sizeof(unsigned int) * eci_length_segs);
     char *modes = (char *) z_alloca(eci_length_segs);
     unsigned char *datastream;
+    struct z_bitstream bs;
     unsigned char *fullstream;
     unsigned char *grid;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (symbol->option_1 == 1) {
         return z_errtxt(ZINT_ERROR_INVALID_OPTION, symbol, 576, "Error correction level L not available in rMQR");
     }
@@ -2684,13 +2789,23 @@ INTERNAL int zint_rmqr(struct zint_symbol *symbol, struct zint_seg segs[], const
 
     datastream = (unsigned char *) z_alloca(target_codewords + 1);
     fullstream = (unsigned char *) z_alloca(rmqr_total_codewords[version] + 1);
+    if (Z_SCRATCH_FAILED()) { /* Also catches any failure in `qr_calc_binlen_segs()` */
+        return ZINT_ERROR_MEMORY;
+    }
 
-    (void) qr_binary_segs(datastream, RMQR_VERSION + version, target_codewords, modes, ddata, local_segs, seg_count,
-                    NULL /*p_structapp*/, gs1, est_binlen, debug_print);
+    z_bs_init(&bs, datastream);
+    qr_binary_segs(&bs, RMQR_VERSION + version, target_codewords, modes, ddata, local_segs, seg_count,
+                    NULL /*p_structapp*/, gs1, debug_print);
 #ifdef ZINT_TEST
     if (symbol->debug & ZINT_DEBUG_TEST) z_debug_test_codeword_dump(symbol, datastream, target_codewords);
 #endif
-    qr_add_ecc(fullstream, datastream, RMQR_VERSION + version, target_codewords, blocks, debug_print);
+    Z_STATS_LAP(symbol, ZINT_STATS_MODES);
+    qr_add_ecc(fullstream, datastream, RMQR_VERSION + version, target_codewords, blocks, NULL, NULL,
+                debug_print);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+    Z_STATS_LAP(symbol, ZINT_STATS_ECC);
 
     h_size = rmqr_width[version];
     v_size = rmqr_height[version];
@@ -2698,10 +2813,14 @@ INTERNAL int zint_rmqr(struct zint_symbol *symbol, struct zint_seg segs[], const
     assert(h_size >= 27 && v_size >= 7); /* Suppress clang-tidy-21 clang-analyzer-security.ArrayBound */
 
     grid = (unsigned char *) z_alloca(h_size * v_size);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     memset(grid, 0, h_size * v_size);
 
     rmqr_setup_grid(grid, h_size, v_size);
-    qr_populate_grid(grid, h_size, v_size, fullstream, rmqr_total_codewords[version]);
+    qr_populate_grid(grid, h_size, v_size, fullstream, rmqr_total_codewords[version], NULL);
+    Z_STATS_LAP(symbol, ZINT_STATS_PLACE);
 
     /* apply bitmask */
     for (i = 0; i < v_size; i++) {
@@ -2716,6 +2835,7 @@ INTERNAL int zint_rmqr(struct zint_symbol *symbol, struct zint_seg segs[], const
             }
         }
     }
+    Z_STATS_LAP(symbol, ZINT_STATS_MASK);
 
     /* add format information */
     format_data = version;
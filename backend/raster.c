@@ -57,6 +57,9 @@
 #define ZFONT_HALIGN_RIGHT  2
 #define ZFONT_UPCEAN_TEXT   4   /* Helper flag to indicate dealing with EAN/UPC */
 
+/* Size of full image buffer(s) above which TIF output (if possible) is rendered in tiles instead */
+#define RASTER_TILE_MIN     0x4000000 /* 64MB */
+
 #ifdef ZINT_TEST
 /* For testing `malloc()` failure */
 
@@ -68,6 +71,14 @@ INTERNAL void zint_test_raster_set_fail(const int id, const int at) {
     raster_fail_at = at;
 }
 
+/* For testing tiled output without very large images */
+
+static size_t raster_tile_min = RASTER_TILE_MIN;
+
+INTERNAL void zint_test_raster_set_tile_min(const size_t size) {
+    raster_tile_min = size ? size : RASTER_TILE_MIN;
+}
+
 /* TODO: add new "raster.h" & put these in it */
 #define RAST_FAIL_ID_BITMAP         1
 #define RAST_FAIL_ID_ALPHA          2
@@ -77,6 +88,8 @@ INTERNAL void zint_test_raster_set_fail(const int id, const int at) {
 #define RAST_FAIL_ID_DOTTY_SCALED   6
 #define RAST_FAIL_ID_PIXELBUF       7
 #define RAST_FAIL_ID_SCALED         8
+#define RAST_FAIL_ID_SHEET          9
+#define RAST_FAIL_ID_TILER          10
 
 #define rast_malloc(id, sz) (raster_fail_at > 0 && raster_fail_id == (id) && --raster_fail_at == 0 \
                                 ? NULL : malloc(sz))
@@ -89,6 +102,8 @@ INTERNAL void zint_test_raster_set_fail(const int id, const int at) {
 #define raster_malloc_dotty_scaled(sz, psz) raster_malloc(RAST_FAIL_ID_DOTTY_SCALED, sz, psz)
 #define raster_malloc_pixelbuf(sz, psz)     raster_malloc(RAST_FAIL_ID_PIXELBUF, sz, psz)
 #define raster_malloc_scaled(sz, psz)       raster_malloc(RAST_FAIL_ID_SCALED, sz, psz)
+#define raster_malloc_sheet(sz, psz)        raster_malloc(RAST_FAIL_ID_SHEET, sz, psz)
+#define raster_malloc_tiler(sz, psz)        raster_malloc(RAST_FAIL_ID_TILER, sz, psz)
 
 #else
 
@@ -102,6 +117,10 @@ INTERNAL void zint_test_raster_set_fail(const int id, const int at) {
 #define raster_malloc_dotty_scaled(sz, psz) raster_malloc(sz, psz)
 #define raster_malloc_pixelbuf(sz, psz)     raster_malloc(sz, psz)
 #define raster_malloc_scaled(sz, psz)       raster_malloc(sz, psz)
+#define raster_malloc_sheet(sz, psz)        raster_malloc(sz, psz)
+#define raster_malloc_tiler(sz, psz)        raster_malloc(sz, psz)
+
+#define raster_tile_min RASTER_TILE_MIN
 
 #endif
 
@@ -112,6 +131,13 @@ INTERNAL int zint_bmp_pixel_plot(struct zint_symbol *symbol, const unsigned char
 INTERNAL int zint_pcx_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf);
 INTERNAL int zint_gif_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf);
 INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf);
+INTERNAL int zint_tif_pixel_plot_pages(struct zint_symbol *symbol, const unsigned char *pixelbuf,
+                const int page_cnt);
+INTERNAL int zint_zpl_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf);
+INTERNAL int zint_escpos_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf);
+INTERNAL int zint_pbm_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf);
+struct zint_raster_tiler;
+INTERNAL int zint_tif_tile_plot(struct zint_symbol *symbol, const struct zint_raster_tiler *tiler);
 
 static const char ultra_colour[] = "0CBMRYGKW";
 
@@ -280,6 +306,10 @@ static int save_raster_image_to_file(struct zint_symbol *symbol, const int image
             break;
     }
 
+    if (file_type != OUT_BUFFER) {
+        Z_STATS_LAP(symbol, ZINT_STATS_BUILD);
+    }
+
     switch (file_type) {
         case OUT_BUFFER:
             if (symbol->output_options & OUT_BUFFER_INTERMEDIATE) {
@@ -319,6 +349,15 @@ static int save_raster_image_to_file(struct zint_symbol *symbol, const int image
         case OUT_TIF_FILE:
             error_number = zint_tif_pixel_plot(symbol, rotated_pixbuf);
             break;
+        case OUT_ZPL_FILE:
+            error_number = zint_zpl_pixel_plot(symbol, rotated_pixbuf);
+            break;
+        case OUT_POS_FILE:
+            error_number = zint_escpos_pixel_plot(symbol, rotated_pixbuf);
+            break;
+        case OUT_PBM_FILE:
+            error_number = zint_pbm_pixel_plot(symbol, rotated_pixbuf);
+            break;
         default:
             error_number = zint_bmp_pixel_plot(symbol, rotated_pixbuf);
             break;
@@ -327,6 +366,8 @@ static int save_raster_image_to_file(struct zint_symbol *symbol, const int image
 #endif
     }
 
+    Z_STATS_LAP(symbol, file_type == OUT_BUFFER ? ZINT_STATS_BUILD : ZINT_STATS_FILE);
+
     if (rotate_angle) {
         free(rotated_pixbuf);
     }
@@ -389,6 +430,135 @@ static void draw_bar(unsigned char *pixelbuf, const int xpos, const int xlen, co
     }
 }
 
+/* Tiled rendering - as symbols without text consist of a limited no. of distinct pixel rows, these are stored
+   once each at unscaled size along with per-row and per-column maps, and tiles produced on demand from them */
+struct zint_raster_tiler {
+    int image_width;        /* Unscaled width, i.e. length of each line */
+    int image_height;       /* Unscaled height */
+    int scale_width;        /* Scaled width (before rotation) */
+    int scale_height;       /* Scaled height (before rotation) */
+    int rotate_angle;
+    int line_cnt;           /* No. of distinct lines */
+    int line_max;           /* No. of lines allocated */
+    unsigned char *lines;   /* `line_cnt` lines of `image_width` pixels */
+    int *line_idx;          /* Index of line for each unscaled row */
+    int *xmap;              /* Unscaled column for each scaled column */
+    int *ymap;              /* Index of line for each scaled row */
+    int fail;               /* Set if allocation fails */
+};
+
+/* Add a new line to `tiler`, copying line `src` if non-negative, otherwise filled with paper, returning its index,
+   or -1 (and setting `tiler->fail`) on allocation failure */
+static int raster_tile_new_line(struct zint_raster_tiler *tiler, const int src) {
+    const size_t line_size = tiler->image_width;
+    unsigned char *line;
+
+    if (tiler->fail) {
+        return -1;
+    }
+    if (tiler->line_cnt == tiler->line_max) {
+        const int line_max = tiler->line_max ? tiler->line_max * 2 : 32;
+        unsigned char *lines;
+        /* Same crude limit as `raster_malloc()` */
+        if (line_size * line_max > 0x40000000 /*1GB*/
+                || !(lines = (unsigned char *) realloc(tiler->lines, line_size * line_max))) {
+            tiler->fail = 1;
+            return -1;
+        }
+        tiler->lines = lines;
+        tiler->line_max = line_max;
+    }
+    line = tiler->lines + line_size * tiler->line_cnt;
+    if (src >= 0) {
+        memcpy(line, tiler->lines + line_size * src, line_size);
+    } else {
+        memset(line, DEFAULT_PAPER, line_size);
+    }
+    return tiler->line_cnt++;
+}
+
+/* `draw_bar()` equivalent for tiled rendering, creating new lines for the rows affected */
+static void raster_tile_bar(struct zint_raster_tiler *tiler, const int xpos, const int xlen, const int ypos,
+            const int ylen, const int fill) {
+    int y;
+    int prev_src = -1, prev_idx = -1;
+    const int ye = ypos + ylen > tiler->image_height ? tiler->image_height : ypos + ylen;
+
+    assert(xpos >= 0);
+    assert(xlen >= 0);
+    assert(ypos >= 0);
+    assert(xpos + xlen <= tiler->image_width);
+
+    for (y = ypos; y < ye; y++) {
+        const int src = tiler->line_idx[y];
+        /* Consecutive rows with the same line share the same new line */
+        if (src != prev_src) {
+            if ((prev_idx = raster_tile_new_line(tiler, src)) < 0) {
+                return;
+            }
+            memset(tiler->lines + (size_t) tiler->image_width * prev_idx + xpos, fill, xlen);
+            prev_src = src;
+        }
+        tiler->line_idx[y] = prev_idx;
+    }
+}
+
+/* Draw a rectangle to `pixelbuf`, or if `tiler` set, to the tiler lines */
+static void raster_bar(unsigned char *pixelbuf, struct zint_raster_tiler *tiler, const int xpos, const int xlen,
+            const int ypos, const int ylen, const int image_width, const int image_height, const int fill) {
+    if (tiler) {
+        raster_tile_bar(tiler, xpos, xlen, ypos, ylen, fill);
+    } else {
+        draw_bar(pixelbuf, xpos, xlen, ypos, ylen, image_width, image_height, fill);
+    }
+}
+
+/* Fill `buf` (with row length `stride`) with the `width` x `height` tile at `x`, `y` of the scaled & rotated
+   image */
+INTERNAL void zint_raster_tile(const struct zint_raster_tiler *tiler, const int x, const int y, const int width,
+            const int height, const int stride, unsigned char *buf) {
+    const size_t line_size = tiler->image_width;
+    const unsigned char *const lines = tiler->lines;
+    const int *const xmap = tiler->xmap;
+    const int *const ymap = tiler->ymap;
+    const int sw = tiler->scale_width, sh = tiler->scale_height;
+    int row, column;
+
+    for (row = 0; row < height; row++) {
+        unsigned char *b = buf + (size_t) stride * row;
+        const int yr = y + row;
+        const unsigned char *line;
+        int xs;
+
+        switch (tiler->rotate_angle) {
+            case 0:
+                line = lines + line_size * ymap[yr];
+                for (column = 0; column < width; column++) {
+                    b[column] = line[xmap[x + column]];
+                }
+                break;
+            case 90: /* Row `yr` is column `yr` bottom to top */
+                xs = xmap[yr];
+                for (column = 0; column < width; column++) {
+                    b[column] = lines[line_size * ymap[sh - 1 - x - column] + xs];
+                }
+                break;
+            case 180:
+                line = lines + line_size * ymap[sh - 1 - yr];
+                for (column = 0; column < width; column++) {
+                    b[column] = line[xmap[sw - 1 - x - column]];
+                }
+                break;
+            default: /* 270 - row `yr` is column `sw - 1 - yr` top to bottom */
+                xs = xmap[sw - 1 - yr];
+                for (column = 0; column < width; column++) {
+                    b[column] = lines[line_size * ymap[x + column] + xs];
+                }
+                break;
+        }
+    }
+}
+
 /* Put a letter into a position */
 static void draw_letter(unsigned char *pixelbuf, const unsigned char letter, int xposn, const int yposn,
             const int textflags, const int image_width, const int image_height, const int si) {
@@ -741,11 +911,45 @@ static void plot_hexagon(unsigned char *scaled_hexagon, const int hex_width, con
     }
 }
 
+/* Draw separator binding for stacked barcodes */
+static void draw_bind_separators(const struct zint_symbol *symbol, unsigned char *pixelbuf,
+            struct zint_raster_tiler *tiler, const int xoffset_si, const int yoffset_si, const int row_heights_si[],
+            const int image_width, const int image_height, const int si) {
+    if ((symbol->output_options & BARCODE_BIND) && symbol->rows > 1 && z_is_bindable(symbol->symbology)) {
+        const int is_codablockf = symbol->symbology == BARCODE_CODABLOCKF
+                                    || symbol->symbology == BARCODE_HIBC_BLOCKF;
+        int sep_xoffset_si = xoffset_si;
+        int sep_width_si = symbol->width * si;
+        int sep_height_si, sep_yoffset_si;
+        float sep_height = 1.0f;
+        int r;
+        if (symbol->option_3 > 0 && symbol->option_3 <= 4) {
+            sep_height = symbol->option_3;
+        }
+        sep_height_si = (int) (sep_height * si);
+        if (sep_height_si > row_heights_si[0] * 2) { /* Ticket 353, props Simon Resch */
+            sep_height_si = row_heights_si[0] * 2;
+        }
+        sep_yoffset_si = yoffset_si + row_heights_si[0] - sep_height_si / 2;
+        if (is_codablockf) {
+            /* Avoid 11-module start and 13-module stop chars */
+            sep_xoffset_si += 11 * si;
+            sep_width_si -= (11 + 13) * si;
+            assert(sep_width_si >= 0);
+        }
+        for (r = 1; r < symbol->rows; r++) {
+            raster_bar(pixelbuf, tiler, sep_xoffset_si, sep_width_si, sep_yoffset_si, sep_height_si, image_width,
+                        image_height, DEFAULT_INK);
+            sep_yoffset_si += row_heights_si[r];
+        }
+    }
+}
+
 /* Draw binding or box */
 static void draw_bind_box(const struct zint_symbol *symbol, unsigned char *pixelbuf,
-            const int xoffset_si, const int yoffset_si, const int symbol_height_si, const int dot_overspill_si,
-            const int upceanflag, const int textoffset_si, const int image_width, const int image_height,
-            const int si) {
+            struct zint_raster_tiler *tiler, const int xoffset_si, const int yoffset_si, const int symbol_height_si,
+            const int dot_overspill_si, const int upceanflag, const int textoffset_si, const int image_width,
+            const int image_height, const int si) {
     if (symbol->border_width > 0 && (symbol->output_options & (BARCODE_BOX | BARCODE_BIND | BARCODE_BIND_TOP))) {
         const int no_extend = symbol->symbology == BARCODE_CODABLOCKF || symbol->symbology == BARCODE_HIBC_BLOCKF
                                 || symbol->symbology == BARCODE_DPD;
@@ -763,16 +967,16 @@ static void draw_bind_box(const struct zint_symbol *symbol, unsigned char *pixel
         /* Horizontal boundary bars */
         if ((symbol->output_options & BARCODE_BOX) || !no_extend) {
             /* Box or not CodaBlockF/DPD */
-            draw_bar(pixelbuf, 0, image_width, ybind_top, bwidth_si, image_width, image_height, DEFAULT_INK);
+            raster_bar(pixelbuf, tiler, 0, image_width, ybind_top, bwidth_si, image_width, image_height, DEFAULT_INK);
             if (!(symbol->output_options & BARCODE_BIND_TOP)) { /* Trumps BARCODE_BOX & BARCODE_BIND */
-                draw_bar(pixelbuf, 0, image_width, ybind_bot, bwidth_si, image_width, image_height, DEFAULT_INK);
+                raster_bar(pixelbuf, tiler, 0, image_width, ybind_bot, bwidth_si, image_width, image_height, DEFAULT_INK);
             }
         } else {
             /* CodaBlockF/DPD bind - does not extend over horizontal whitespace */
             const int width_si = symbol->width * si;
-            draw_bar(pixelbuf, xoffset_si, width_si, ybind_top, bwidth_si, image_width, image_height, DEFAULT_INK);
+            raster_bar(pixelbuf, tiler, xoffset_si, width_si, ybind_top, bwidth_si, image_width, image_height, DEFAULT_INK);
             if (!(symbol->output_options & BARCODE_BIND_TOP)) { /* Trumps BARCODE_BOX & BARCODE_BIND */
-                draw_bar(pixelbuf, xoffset_si, width_si, ybind_bot, bwidth_si, image_width, image_height,
+                raster_bar(pixelbuf, tiler, xoffset_si, width_si, ybind_bot, bwidth_si, image_width, image_height,
                             DEFAULT_INK);
             }
         }
@@ -788,8 +992,8 @@ static void draw_bind_box(const struct zint_symbol *symbol, unsigned char *pixel
             } else if (upceanflag == 2 || upceanflag == 5) {
                 box_top += textoffset_si;
             }
-            draw_bar(pixelbuf, 0, bwidth_si, box_top, box_height, image_width, image_height, DEFAULT_INK);
-            draw_bar(pixelbuf, xbox_right, bwidth_si, box_top, box_height, image_width, image_height, DEFAULT_INK);
+            raster_bar(pixelbuf, tiler, 0, bwidth_si, box_top, box_height, image_width, image_height, DEFAULT_INK);
+            raster_bar(pixelbuf, tiler, xbox_right, bwidth_si, box_top, box_height, image_width, image_height, DEFAULT_INK);
         }
     }
 }
@@ -878,8 +1082,9 @@ static int plot_raster_maxicode(struct zint_symbol *symbol, const int rotate_ang
     draw_bullseye(pixelbuf, image_width, image_height, hex_width, hex_height, hx_start, hx_end, hex_image_height,
                     xoffset_si, yoffset_si);
 
-    draw_bind_box(symbol, pixelbuf, xoffset_si, yoffset_si, hex_image_height, 0 /*dot_overspill_si*/,
-                    0 /*upceanflag*/, 0 /*textoffset_si*/, image_width, image_height, (int) scaler);
+    draw_bind_box(symbol, pixelbuf, NULL /*tiler*/, xoffset_si, yoffset_si, hex_image_height,
+                    0 /*dot_overspill_si*/, 0 /*upceanflag*/, 0 /*textoffset_si*/, image_width, image_height,
+                    (int) scaler);
 
     error_number = save_raster_image_to_file(symbol, image_height, image_width, pixelbuf, rotate_angle, file_type);
     free(scaled_hexagon);
@@ -959,8 +1164,8 @@ static int plot_raster_dotty(struct zint_symbol *symbol, const int rotate_angle,
         }
     }
 
-    draw_bind_box(symbol, scaled_pixelbuf, xoffset_si, yoffset_si, symbol_height_si, dot_overspill_si,
-                    0 /*upceanflag*/, 0 /*textoffset_si*/, scale_width, scale_height, (int) scaler);
+    draw_bind_box(symbol, scaled_pixelbuf, NULL /*tiler*/, xoffset_si, yoffset_si, symbol_height_si,
+                    dot_overspill_si, 0 /*upceanflag*/, 0 /*textoffset_si*/, scale_width, scale_height, (int) scaler);
 
     error_number = save_raster_image_to_file(symbol, scale_height, scale_width, scaled_pixelbuf, rotate_angle,
                                             file_type);
@@ -971,6 +1176,120 @@ static int plot_raster_dotty(struct zint_symbol *symbol, const int rotate_angle,
     return error_number;
 }
 
+/* Free tiler buffers */
+static void raster_tiler_free(struct zint_raster_tiler *tiler) {
+    free(tiler->lines);
+    free(tiler->line_idx);
+    free(tiler->xmap);
+    free(tiler->ymap);
+}
+
+/* Plot a symbol without text to a tiled TIF, rendering tiles on demand so that the full image is never in memory;
+   geometry as calculated by `plot_raster_default()` */
+static int plot_raster_tiled(struct zint_symbol *symbol, const int rotate_angle, const int xoffset_si,
+            const int yoffset_si, const int row_heights_si[], const int symbol_height_si, const int image_width,
+            const int image_height, const int scale_width, const int scale_height, const float scaler,
+            const int half_int_scaling, const int si) {
+    int error_number;
+    struct zint_raster_tiler tiler;
+    int i, r, y;
+    int block_width = 0;
+    int yposn_si = yoffset_si;
+
+    memset(&tiler, 0, sizeof(tiler));
+    tiler.image_width = image_width;
+    tiler.image_height = image_height;
+    tiler.scale_width = scale_width;
+    tiler.scale_height = scale_height;
+    tiler.rotate_angle = rotate_angle;
+
+    if (!(tiler.line_idx = (int *) raster_malloc_tiler(sizeof(int) * image_height, 0 /*prev_size*/))
+            || !(tiler.xmap = (int *) raster_malloc_tiler(sizeof(int) * scale_width, 0 /*prev_size*/))
+            || !(tiler.ymap = (int *) raster_malloc_tiler(sizeof(int) * scale_height, 0 /*prev_size*/))) {
+        raster_tiler_free(&tiler);
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 685, "Insufficient memory for tiled output buffers");
+    }
+
+    /* Line 0 is paper, used for all rows not otherwise set */
+    (void) raster_tile_new_line(&tiler, -1 /*src*/);
+    memset(tiler.line_idx, 0, sizeof(int) * image_height);
+
+    /* One line per symbol row */
+    for (r = 0; r < symbol->rows && !tiler.fail; r++) {
+        const int idx = raster_tile_new_line(&tiler, -1 /*src*/);
+        const int ye = yposn_si + row_heights_si[r] > image_height ? image_height : yposn_si + row_heights_si[r];
+        unsigned char *line;
+
+        if (idx < 0) {
+            break;
+        }
+        line = tiler.lines + (size_t) image_width * idx;
+        for (i = 0; i < symbol->width; i += block_width) {
+            int fill;
+            if (symbol->symbology == BARCODE_ULTRA) {
+                fill = z_module_colour_is_set(symbol, r, i);
+                for (block_width = 1; (i + block_width < symbol->width)
+                                        && z_module_colour_is_set(symbol, r, i + block_width) == fill; block_width++);
+            } else {
+                fill = z_module_is_set(symbol, r, i);
+                for (block_width = 1; (i + block_width < symbol->width)
+                                        && z_module_is_set(symbol, r, i + block_width) == fill; block_width++);
+            }
+            if (fill) {
+                draw_bar_line(line, i * si + xoffset_si, block_width * si, 0 /*ypos*/, image_width,
+                                symbol->symbology == BARCODE_ULTRA ? ultra_colour[fill] : DEFAULT_INK);
+            }
+        }
+        for (y = yposn_si; y < ye; y++) {
+            tiler.line_idx[y] = idx;
+        }
+        yposn_si += row_heights_si[r];
+    }
+
+    draw_bind_separators(symbol, NULL /*pixelbuf*/, &tiler, xoffset_si, yoffset_si, row_heights_si, image_width,
+                            image_height, si);
+    draw_bind_box(symbol, NULL /*pixelbuf*/, &tiler, xoffset_si, yoffset_si, symbol_height_si,
+                    0 /*dot_overspill_si*/, 0 /*upceanflag*/, 0 /*textoffset_si*/, image_width, image_height, si);
+
+    if (tiler.fail) {
+        raster_tiler_free(&tiler);
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 685, "Insufficient memory for tiled output buffers");
+    }
+
+    /* Map scaled to unscaled as done by `plot_raster_default()` interpolation */
+    for (i = 0; i < scale_width; i++) {
+        const int x = half_int_scaling ? i : (int) z_stripf(i / scaler);
+        tiler.xmap[i] = x < image_width ? x : image_width - 1;
+    }
+    for (i = 0; i < scale_height; i++) {
+        const int y_s = half_int_scaling ? i : (int) z_stripf(i / scaler);
+        tiler.ymap[i] = tiler.line_idx[y_s < image_height ? y_s : image_height - 1];
+    }
+
+    if (rotate_angle == 90 || rotate_angle == 270) {
+        symbol->bitmap_width = scale_height;
+        symbol->bitmap_height = scale_width;
+    } else {
+        symbol->bitmap_width = scale_width;
+        symbol->bitmap_height = scale_height;
+    }
+
+    if (symbol->debug & ZINT_DEBUG_PRINT) {
+        printf("Tiled (%dx%d) from %d distinct lines of %d\n", symbol->bitmap_width, symbol->bitmap_height,
+                tiler.line_cnt, image_width);
+    }
+
+    /* Tiles are rendered as written so count as file encoding */
+    Z_STATS_LAP(symbol, ZINT_STATS_BUILD);
+
+    error_number = zint_tif_tile_plot(symbol, &tiler);
+    Z_STATS_LAP(symbol, ZINT_STATS_FILE);
+
+    raster_tiler_free(&tiler);
+
+    return error_number;
+}
+
 /* Convert UTF-8 to ISO/IEC 8859-1 for `draw_string()` human readable text */
 static void to_iso8859_1(const unsigned char source[], unsigned char preprocessed[]) {
     int j, i, input_length;
@@ -1030,7 +1349,6 @@ static int plot_raster_default(struct zint_symbol *symbol, const int rotate_angl
     float large_bar_height;
     const int upcean_guard_whitespace = !(symbol->output_options & BARCODE_NO_QUIET_ZONES)
                                         && (symbol->output_options & EANUPC_GUARD_WHITESPACE);
-    const int is_codablockf = symbol->symbology == BARCODE_CODABLOCKF || symbol->symbology == BARCODE_HIBC_BLOCKF;
 
     int textflags = 0;
     int xoffset_si, yoffset_si, roffset_si, boffset_si, qz_right_si;
@@ -1117,6 +1435,19 @@ static int plot_raster_default(struct zint_symbol *symbol, const int rotate_angl
     assert(image_width && image_height);
     image_size = (size_t) image_width * image_height;
 
+    /* If no text and frame(s) large, render TIF in tiles instead */
+    if (file_type == OUT_TIF_FILE && !upceanflag && hide_text) {
+        const int scale_width = half_int_scaling ? image_width : (int) z_stripf(image_width * scaler);
+        const int scale_height = half_int_scaling ? image_height : (int) z_stripf(image_height * scaler);
+        const size_t frame_size = (size_t) scale_width * scale_height * (rotate_angle ? 2 : 1)
+                                    + (half_int_scaling ? 0 : image_size);
+        if (frame_size > raster_tile_min) {
+            return plot_raster_tiled(symbol, rotate_angle, xoffset_si, yoffset_si, row_heights_si, symbol_height_si,
+                                    image_width, image_height, scale_width, scale_height, scaler, half_int_scaling,
+                                    si);
+        }
+    }
+
     if (!(pixelbuf = (unsigned char *) raster_malloc_pixelbuf(image_size, 0 /*prev_size*/))) {
         return z_errtxt(ZINT_ERROR_MEMORY, symbol, 658, "Insufficient memory for pixel buffer");
     }
@@ -1420,34 +1751,11 @@ static int plot_raster_default(struct zint_symbol *symbol, const int rotate_angl
     }
 
     /* Separator binding for stacked barcodes */
-    if ((symbol->output_options & BARCODE_BIND) && symbol->rows > 1 && z_is_bindable(symbol->symbology)) {
-        int sep_xoffset_si = xoffset_si;
-        int sep_width_si = symbol->width * si;
-        int sep_height_si, sep_yoffset_si;
-        float sep_height = 1.0f;
-        if (symbol->option_3 > 0 && symbol->option_3 <= 4) {
-            sep_height = symbol->option_3;
-        }
-        sep_height_si = (int) (sep_height * si);
-        if (sep_height_si > row_heights_si[0] * 2) { /* Ticket 353, props Simon Resch */
-            sep_height_si = row_heights_si[0] * 2;
-        }
-        sep_yoffset_si = yoffset_si + row_heights_si[0] - sep_height_si / 2;
-        if (is_codablockf) {
-            /* Avoid 11-module start and 13-module stop chars */
-            sep_xoffset_si += 11 * si;
-            sep_width_si -= (11 + 13) * si;
-            assert(sep_width_si >= 0);
-        }
-        for (r = 1; r < symbol->rows; r++) {
-            draw_bar(pixelbuf, sep_xoffset_si, sep_width_si, sep_yoffset_si, sep_height_si, image_width, image_height,
-                        DEFAULT_INK);
-            sep_yoffset_si += row_heights_si[r];
-        }
-    }
+    draw_bind_separators(symbol, pixelbuf, NULL /*tiler*/, xoffset_si, yoffset_si, row_heights_si, image_width,
+                            image_height, si);
 
-    draw_bind_box(symbol, pixelbuf, xoffset_si, yoffset_si, symbol_height_si, 0 /*dot_overspill_si*/, upceanflag,
-                    textoffset_si, image_width, image_height, si);
+    draw_bind_box(symbol, pixelbuf, NULL /*tiler*/, xoffset_si, yoffset_si, symbol_height_si,
+                    0 /*dot_overspill_si*/, upceanflag, textoffset_si, image_width, image_height, si);
 
     if (!half_int_scaling) {
         size_t prev_image_row;
@@ -1497,6 +1805,8 @@ static int plot_raster_default(struct zint_symbol *symbol, const int rotate_angl
 INTERNAL int zint_plot_raster(struct zint_symbol *symbol, int rotate_angle, int file_type) {
     int error;
 
+    (void) Z_STATS_MARK(symbol);
+
 #ifdef ZINT_NO_PNG
     if (file_type == OUT_PNG_FILE) {
         return z_errtxt(ZINT_ERROR_INVALID_OPTION, symbol, 660, "PNG format disabled at compile time");
@@ -1522,4 +1832,130 @@ INTERNAL int zint_plot_raster(struct zint_symbol *symbol, int rotate_angle, int
     return error;
 }
 
+/* Free intermediate pixel buffers of first `cnt` sheet symbols */
+static void raster_sheet_free(struct zint_symbol *symbols[], const int cnt) {
+    int i;
+
+    for (i = 0; i < cnt; i++) {
+        if (symbols[i]->bitmap != NULL) {
+            free(symbols[i]->bitmap);
+            symbols[i]->bitmap = NULL;
+        }
+        symbols[i]->bitmap_width = symbols[i]->bitmap_height = 0;
+    }
+}
+
+/* Plot `symbol_cnt` encoded `symbols` onto one or more pages as specified by `sheet`, using the output settings
+   of `symbols[0]`. Each symbol is rendered into an intermediate pixel buffer which is then copied into its cell */
+INTERNAL int zint_plot_raster_sheet(struct zint_symbol *symbols[], const int symbol_cnt,
+                const struct zint_sheet *sheet, const int rotate_angle, const int file_type) {
+    struct zint_symbol *const symbol = symbols[0];
+    struct zint_symbol *page_symbol;
+    struct zint_out_sheet layout;
+    unsigned char *sheet_buf;
+    size_t page_size;
+    int page_width, page_height;
+    int cell_width = 0, cell_height = 0;
+    int ultra_cnt = 0;
+    int i, page, row;
+    int error_number, warn_number = 0;
+    const float xdim = (symbol->scale < 0.5f ? 0.5f : symbol->scale) * 2.0f; /* As `plot_raster_default()` */
+
+#ifdef ZINT_NO_PNG
+    if (file_type == OUT_PNG_FILE) {
+        return z_errtxt(ZINT_ERROR_INVALID_OPTION, symbol, 668, "PNG format disabled at compile time");
+    }
+#endif /* ZINT_NO_PNG */
+
+    for (i = 0; i < symbol_cnt; i++) {
+        struct zint_symbol *const sym = symbols[i];
+        const int output_options = sym->output_options;
+
+        sym->output_options |= OUT_BUFFER_INTERMEDIATE;
+        error_number = zint_plot_raster(sym, rotate_angle, OUT_BUFFER);
+        sym->output_options = output_options;
+        if (error_number) {
+            if (sym != symbol) {
+                memcpy(symbol->errtxt, sym->errtxt, sizeof(symbol->errtxt));
+            }
+            if (error_number >= ZINT_ERROR) {
+                raster_sheet_free(symbols, i + 1);
+                return error_number;
+            }
+            warn_number = error_number;
+        }
+        if (sym->bitmap_width > cell_width) {
+            cell_width = sym->bitmap_width;
+        }
+        if (sym->bitmap_height > cell_height) {
+            cell_height = sym->bitmap_height;
+        }
+        if (sym->symbology == BARCODE_ULTRA) {
+            ultra_cnt++;
+        }
+    }
+
+    zint_out_sheet_layout(sheet, symbol_cnt, (float) cell_width, (float) cell_height, xdim, &layout);
+    page_width = (int) ceil(layout.page_width);
+    page_height = (int) ceil(layout.page_height);
+    page_size = (size_t) page_width * page_height;
+
+    if (page_size > 0x40000000 / (size_t) layout.page_cnt /*1GB*/
+            || !(sheet_buf = (unsigned char *) raster_malloc_sheet(page_size * layout.page_cnt, 0 /*prev_size*/))) {
+        raster_sheet_free(symbols, symbol_cnt);
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 665, "Insufficient memory for sheet pixel buffer");
+    }
+    memset(sheet_buf, DEFAULT_PAPER, page_size * layout.page_cnt);
+
+    for (i = 0; i < symbol_cnt; i++) {
+        const struct zint_symbol *const sym = symbols[i];
+        unsigned char *dst;
+        float x, y;
+
+        zint_out_sheet_position(&layout, i, (float) sym->bitmap_width, (float) sym->bitmap_height, &page, &x, &y);
+        dst = sheet_buf + page_size * page + (size_t) page_width * (int) y + (int) x;
+        for (row = 0; row < sym->bitmap_height; row++) {
+            memcpy(dst + (size_t) page_width * row, sym->bitmap + (size_t) sym->bitmap_width * row,
+                    sym->bitmap_width);
+        }
+    }
+    raster_sheet_free(symbols, symbol_cnt);
+
+    if (!(page_symbol = zint_out_sheet_symbol(symbol))) {
+        free(sheet_buf);
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 667, "Insufficient memory for sheet symbol");
+    }
+    if (ultra_cnt) {
+        /* Have Ultracode palettes include background (margins & gaps) and foreground (any other symbols) */
+        page_symbol->symbology = BARCODE_ULTRA;
+        page_symbol->whitespace_width = 1;
+        if (ultra_cnt != symbol_cnt) {
+            page_symbol->border_width = 1;
+            page_symbol->output_options |= BARCODE_BOX;
+        }
+    }
+
+    if (file_type == OUT_TIF_FILE) {
+        page_symbol->bitmap_width = page_width;
+        page_symbol->bitmap_height = page_height;
+        error_number = zint_tif_pixel_plot_pages(page_symbol, sheet_buf, layout.page_cnt);
+    } else {
+        error_number = 0;
+        for (page = 0; page < layout.page_cnt && !error_number; page++) {
+            if (layout.page_cnt > 1
+                    && !zint_out_sheet_page_outfile(symbol->outfile, page + 1, page_symbol->outfile)) {
+                error_number = z_errtxt(ZINT_ERROR_INVALID_OPTION, page_symbol, 666,
+                                        "Output filename too long to add page number");
+            } else {
+                error_number = save_raster_image_to_file(page_symbol, page_height, page_width,
+                                                        sheet_buf + page_size * page, 0 /*rotate_angle*/, file_type);
+            }
+        }
+    }
+    free(sheet_buf);
+    zint_out_sheet_symbol_free(symbol, page_symbol);
+
+    return error_number ? error_number : warn_number;
+}
+
 /* vim: set ts=4 sw=4 et : */
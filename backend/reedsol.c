@@ -46,6 +46,7 @@
    First call rs_init_gf(&rs, prime_poly) to set up the Galois Field parameters.
    Then  call rs_init_code(&rs, nsym, index) to set the encoding size
    Then  call rs_encode(&rs, datalen, data, out) to encode the data.
+   Or    call rs_encode_delta(&rs, datalen, data, prev_data, out) to update the ECC `out` of `prev_data`.
 
    These can be called repeatedly as required - but note that
    rs_init_code must be called following any rs_init_gf call.
@@ -54,13 +55,82 @@
    replaced with constants in the obvious way, and additionally
    malloc/free can be avoided by using static arrays of a suitable
    size.
-   Note: use of statics has been done for (up to) 8-bit tables.
+   Note: use of statics has been done for (up to) 8-bit tables, and for the Aztec Code 10 and 12-bit tables.
+
+   Generator polynomials are cached by (prime_poly, nsym, index) in a fixed-size lock-free table, entries being
+   written once to a static arena then published with compare-and-swap, and never freed (unless ZINT_NO_RS_CACHE
+   defined or atomics unavailable, when they're generated on every call).
+
+   For (up to) 8-bit fields, medium-sized codes are encoded with the remainder held in registers, multiplying the
+   whole generator polynomial by each feedback symbol at once, using split-nibble table lookups (PSHUFB) on x86
+   CPUs supporting SSSE3 or AVX2 (selected at runtime, unless ZINT_NO_SIMD defined), or else 64 bits at a time
+   using the generator pre-multiplied by each nibble.
 */
 
 #include "common.h"
 #include "reedsol.h"
 #include "reedsol_logs.h"
 
+#if defined(Z_HAVE_ATOMICS) && !defined(ZINT_NO_RS_CACHE)
+#define RS_CACHE
+#endif
+
+#if !defined(ZINT_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) \
+        && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define RS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/* Kernels used by `rs_encode_fast()` */
+#define RS_KERNEL_SCALAR    -1  /* Don't use `rs_encode_fast()` */
+#define RS_KERNEL_U64       0   /* Portable 64-bit */
+#define RS_KERNEL_SSSE3     1
+#define RS_KERNEL_AVX2      2
+
+/* Sizes `rs_encode_fast()` used for - minimums worth setting up for, maximum held in registers (multiple of 32) */
+#define RS_FAST_MIN_NSYM    16
+#define RS_FAST_MAX_NSYM    96
+#define RS_FAST_MIN_DATALEN 8   /* SIMD */
+#define RS_U64_MIN_DATALEN  32  /* Portable */
+
+#ifdef ZINT_TEST
+static int rs_test_kernel = -2; /* Unset */
+#endif
+
+#ifdef RS_X86_SIMD
+static const int rs_kernels[3] = { RS_KERNEL_U64, RS_KERNEL_SSSE3, RS_KERNEL_AVX2 };
+static const int *volatile rs_kernel_best; /* Entry of `rs_kernels` detected on first use, NULL if not yet */
+#endif
+
+/* Best kernel supported by the CPU */
+static int rs_kernel(void) {
+#ifdef RS_X86_SIMD
+    const int *best, *expected = NULL;
+#endif
+#ifdef ZINT_TEST
+    if (rs_test_kernel != -2) {
+        return rs_test_kernel;
+    }
+#endif
+#ifdef RS_X86_SIMD
+    if ((best = (const int *) z_atomic_load_ptr(&rs_kernel_best))) {
+        return *best;
+    }
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        best = rs_kernels + RS_KERNEL_AVX2;
+    } else if (__builtin_cpu_supports("ssse3")) {
+        best = rs_kernels + RS_KERNEL_SSSE3;
+    } else {
+        best = rs_kernels + RS_KERNEL_U64;
+    }
+    (void) z_atomic_cas_ptr(&rs_kernel_best, expected, best); /* Same result if another thread beat us to it */
+    return *best;
+#else
+    return RS_KERNEL_U64;
+#endif
+}
+
 #ifdef ZINT_TEST
 /* For testing `calloc()` failure */
 
@@ -71,10 +141,120 @@ INTERNAL void zint_test_rs_set_fail(const int id) {
 }
 
 #define rs_calloc(id, num, sz)  (rs_fail_id == (id) ? NULL : calloc(num, sz))
+#define rs_no_cache()           (rs_fail_id == RS_FAIL_ID_GEN)
+
+/* Force kernel used by `zint_rs_encode()` & `zint_rs_encode_uint()` (-1 scalar, 0 64-bit, 1 SSSE3, 2 AVX2, -2 best),
+   returning 0 if not supported */
+INTERNAL int zint_test_rs_set_kernel(const int kernel) {
+    rs_test_kernel = -2;
+    if (kernel > rs_kernel()) {
+        return 0;
+    }
+    rs_test_kernel = kernel;
+    return 1;
+}
 #else
 #define rs_calloc(id, num, sz)  calloc(num, sz)
+#define rs_no_cache()           0
 #endif
 
+#ifdef RS_CACHE
+#define RS_CACHE_SLOTS      1024    /* Power of 2 */
+#define RS_CACHE_PROBES     8
+#define RS_CACHE_ARENA_SIZE 65536   /* In shorts */
+#define RS_CACHE_HDR        4       /* Entry header: prime_poly, nsym, index, zero */
+
+static unsigned short *volatile rs_cache_slots[RS_CACHE_SLOTS]; /* Entries in arena, NULL if empty */
+static unsigned short rs_cache_arena[RS_CACHE_ARENA_SIZE];
+static unsigned short *volatile rs_cache_top = rs_cache_arena; /* End of arena used */
+
+/* Whether arena `entry` is for (`prime_poly`, `nsym`, `index`) */
+static int rs_cache_match(const unsigned short *entry, const unsigned int prime_poly, const int nsym,
+                const int index) {
+    return entry[0] == prime_poly && entry[1] == nsym && entry[2] == index;
+}
+
+/* Initial slot of (`prime_poly`, `nsym`, `index`) */
+static int rs_cache_hash(const unsigned int prime_poly, const int nsym, const int index) {
+    return (int) ((prime_poly * 31 + (unsigned int) nsym * 2 + (unsigned int) index) & (RS_CACHE_SLOTS - 1));
+}
+#endif
+
+/* Return cached generator polynomial (`nsym + 1` coeffs followed by their `nsym + 1` logs) for (`prime_poly`,
+   `nsym`, `index`), or NULL if none, setting `p_zero` if it has a zero coeff */
+static const unsigned short *rs_cache_get(const unsigned int prime_poly, const int nsym, const int index,
+                int *p_zero) {
+#ifdef RS_CACHE
+    const int hash = rs_cache_hash(prime_poly, nsym, index);
+    int i;
+
+    if (rs_no_cache()) {
+        return NULL;
+    }
+    for (i = 0; i < RS_CACHE_PROBES; i++) {
+        const unsigned short *const entry = (const unsigned short *)
+                                            z_atomic_load_ptr(&rs_cache_slots[(hash + i) & (RS_CACHE_SLOTS - 1)]);
+        if (!entry) {
+            break;
+        }
+        if (rs_cache_match(entry, prime_poly, nsym, index)) {
+            *p_zero = entry[3];
+            return entry + RS_CACHE_HDR;
+        }
+    }
+#else
+    (void) prime_poly; (void) nsym; (void) index; (void) p_zero;
+#endif
+    return NULL;
+}
+
+/* Reserve space in arena for generator polynomial of `nsym`, returning NULL if full (or no cache) */
+static unsigned short *rs_cache_reserve(const int nsym) {
+#ifdef RS_CACHE
+    const int size = RS_CACHE_HDR + (nsym + 1) * 2;
+    unsigned short *top;
+
+    if (rs_no_cache()) {
+        return NULL;
+    }
+    top = (unsigned short *) z_atomic_load_ptr(&rs_cache_top);
+    do {
+        if (size > RS_CACHE_ARENA_SIZE - (top - rs_cache_arena)) {
+            return NULL;
+        }
+    } while (!z_atomic_cas_ptr(&rs_cache_top, top, top + size)); /* On failure `top` reloaded */
+    return top + RS_CACHE_HDR;
+#else
+    (void) nsym;
+    return NULL;
+#endif
+}
+
+/* Publish generator polynomial `gen` returned by `rs_cache_reserve()` and filled in. If no free slot (or another
+   thread beat us to it) it remains unpublished, but is still valid for the caller */
+static void rs_cache_put(unsigned short *gen, const unsigned int prime_poly, const int nsym, const int index,
+                const int zero) {
+#ifdef RS_CACHE
+    unsigned short *const entry = gen - RS_CACHE_HDR;
+    const int hash = rs_cache_hash(prime_poly, nsym, index);
+    int i;
+
+    entry[0] = (unsigned short) prime_poly;
+    entry[1] = (unsigned short) nsym;
+    entry[2] = (unsigned short) index;
+    entry[3] = (unsigned short) zero;
+    for (i = 0; i < RS_CACHE_PROBES; i++) {
+        unsigned short *slot = NULL;
+        if (z_atomic_cas_ptr(&rs_cache_slots[(hash + i) & (RS_CACHE_SLOTS - 1)], slot, entry)
+                || rs_cache_match(slot, prime_poly, nsym, index)) {
+            return;
+        }
+    }
+#else
+    (void) gen; (void) prime_poly; (void) nsym; (void) index; (void) zero;
+#endif
+}
+
 /* rs_init_gf(&rs, prime_poly) initialises the parameters for the Galois Field.
    The symbol size is determined from the highest bit set in poly
    This implementation will support sizes up to 8 bits (see rs_uint_init_gf()
@@ -114,6 +294,7 @@ INTERNAL void zint_rs_init_gf(rs_t *rs, const unsigned int prime_poly) {
 
     rs->logt = data[hash].logt;
     rs->alog = data[hash].alog;
+    rs->prime_poly = prime_poly;
 }
 
 /* rs_init_code(&rs, nsym, index) initialises the Reed-Solomon encoder
@@ -130,9 +311,20 @@ INTERNAL void zint_rs_init_code(rs_t *rs, const int nsym, int index) {
     const unsigned char *const alog = rs->alog;
     unsigned char *rspoly = rs->rspoly;
     unsigned char *log_rspoly = rs->log_rspoly;
+    const int index_in = index;
+    const unsigned short *cached;
+    unsigned short *gen;
 
     rs->nsym = nsym;
 
+    if ((cached = rs_cache_get(rs->prime_poly, nsym, index, &rs->zero))) {
+        for (i = 0; i <= nsym; i++) {
+            rspoly[i] = (unsigned char) cached[i];
+            log_rspoly[i] = (unsigned char) cached[nsym + 1 + i];
+        }
+        return;
+    }
+
     rspoly[0] = 1;
     for (i = 1; i <= nsym; i++) {
         rspoly[i] = 1;
@@ -151,11 +343,258 @@ INTERNAL void zint_rs_init_code(rs_t *rs, const int nsym, int index) {
         log_rspoly[i] = logt[rspoly[i]]; /* For simplicity allow log of 0 */
         rs->zero |= rspoly[i] == 0;
     }
+
+    if ((gen = rs_cache_reserve(nsym))) {
+        for (i = 0; i <= nsym; i++) {
+            gen[i] = rspoly[i];
+            gen[nsym + 1 + i] = log_rspoly[i];
+        }
+        rs_cache_put(gen, rs->prime_poly, nsym, index_in, rs->zero);
+    }
+}
+
+/* Portable version of `rs_encode_fast()` below, the remainder held in 64-bit words (lowest byte first) */
+static void rs_encode_u64(const rs_t *rs, const int datalen, const unsigned char *data,
+                const unsigned int *data_uint, unsigned char *res) {
+    const unsigned char *const logt = rs->logt;
+    const unsigned char *const alog = rs->alog;
+    const int nsym = rs->nsym;
+    const int nw = (nsym + 7) >> 3;
+    uint64_t rem[RS_FAST_MAX_NSYM / 8];
+    uint64_t lo[16][RS_FAST_MAX_NSYM / 8], hi[16][RS_FAST_MAX_NSYM / 8]; /* Generator times nibbles */
+    int i, j, k, b;
+
+    /* Generator (highest coefficient first, excluding leading 1) times 2**b, for b 0-3 in `lo[2**b]` and for b 4-7
+       in `hi[2**(b - 4)]`, then combined into products with each nibble */
+    for (k = 0; k < nw; k++) {
+        lo[0][k] = hi[0][k] = 0;
+        for (b = 0; b < 4; b++) {
+            lo[1 << b][k] = hi[1 << b][k] = 0;
+        }
+        for (j = 7; j >= 0; j--) {
+            const int idx = k * 8 + j;
+            const unsigned int g = idx < nsym ? rs->rspoly[nsym - 1 - idx] : 0;
+            for (b = 0; b < 4; b++) {
+                lo[1 << b][k] = (lo[1 << b][k] << 8) | (g ? alog[logt[g] + b] : 0);
+                hi[1 << b][k] = (hi[1 << b][k] << 8) | (g ? alog[logt[g] + b + 4] : 0);
+            }
+        }
+        for (b = 1; b < 4; b++) {
+            for (j = 1; j < (1 << b); j++) {
+                lo[(1 << b) + j][k] = lo[1 << b][k] ^ lo[j][k];
+                hi[(1 << b) + j][k] = hi[1 << b][k] ^ hi[j][k];
+            }
+        }
+        rem[k] = 0;
+    }
+
+    for (i = 0; i < datalen; i++) {
+        const unsigned int m = ((unsigned int) rem[0] & 0xFF) ^ (data ? data[i] : data_uint[i]);
+        const uint64_t *const mlo = lo[m & 0x0F];
+        const uint64_t *const mhi = hi[m >> 4];
+        for (k = 0; k < nw - 1; k++) {
+            rem[k] = ((rem[k] >> 8) | (rem[k + 1] << 56)) ^ mlo[k] ^ mhi[k];
+        }
+        rem[k] = (rem[k] >> 8) ^ mlo[k] ^ mhi[k];
+    }
+    for (j = 0; j < nsym; j++) {
+        res[j] = (unsigned char) (rem[j >> 3] >> ((j & 7) << 3));
+    }
+}
+
+#ifdef RS_X86_SIMD
+/* Set `g0lo` & `g0hi` to products of highest generator coefficient with low & high nibbles, allowing the next
+   feedback symbol to be calculated ahead of the SIMD registers */
+static void rs_g0_tables(const rs_t *rs, unsigned char g0lo[16], unsigned char g0hi[16]) {
+    const unsigned int g0 = rs->rspoly[rs->nsym - 1];
+    unsigned char lo[4], hi[4]; /* Products of `g0` with each nibble bit */
+    int b, j;
+
+    for (b = 0; b < 4; b++) {
+        lo[b] = g0 ? rs->alog[rs->logt[g0] + b] : 0;
+        hi[b] = g0 ? rs->alog[rs->logt[g0] + b + 4] : 0;
+    }
+    for (j = 0; j < 16; j++) {
+        g0lo[j] = (j & 1 ? lo[0] : 0) ^ (j & 2 ? lo[1] : 0) ^ (j & 4 ? lo[2] : 0) ^ (j & 8 ? lo[3] : 0);
+        g0hi[j] = (j & 1 ? hi[0] : 0) ^ (j & 2 ? hi[1] : 0) ^ (j & 4 ? hi[2] : 0) ^ (j & 8 ? hi[3] : 0);
+    }
+}
+
+/* Generate `nsym` Reed-Solomon codes of `data` (or `data_uint` if `data` NULL) with the remainder held in SSSE3
+   registers, multiplying the whole generator polynomial by each feedback symbol at once using split-nibble
+   PSHUFB table lookups */
+__attribute__((target("ssse3")))
+static void rs_encode_ssse3(const rs_t *rs, const int datalen, const unsigned char *data,
+                const unsigned int *data_uint, unsigned char *res) {
+    const unsigned char *const logt = rs->logt;
+    const unsigned char *const alog = rs->alog;
+    const int nsym = rs->nsym;
+    const int nv = (nsym + 15) >> 4;
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i rem[RS_FAST_MAX_NSYM / 16], glo[RS_FAST_MAX_NSYM / 16], ghi[RS_FAST_MAX_NSYM / 16];
+    __m128i idx[4];
+    unsigned char buf[RS_FAST_MAX_NSYM];
+    unsigned char g0lo[16], g0hi[16];
+    unsigned int m;
+    int i, j, k;
+
+    for (j = 0; j < nv * 16; j++) {
+        buf[j] = j < nsym ? rs->rspoly[nsym - 1 - j] : 0;
+    }
+    for (k = 0; k < nv; k++) {
+        const __m128i g = _mm_loadu_si128((const __m128i *) (buf + k * 16));
+        glo[k] = _mm_and_si128(g, mask);
+        ghi[k] = _mm_and_si128(_mm_srli_epi64(g, 4), mask);
+        rem[k] = _mm_setzero_si128();
+    }
+    for (j = 0; j < 4; j++) {
+        /* Index of byte for bit `j` if set in nibble, else 0x80 (zero) */
+        char s[16];
+        for (k = 0; k < 16; k++) {
+            s[k] = (char) (k & (1 << j) ? j : 0x80);
+        }
+        idx[j] = _mm_loadu_si128((const __m128i *) s);
+    }
+
+    rs_g0_tables(rs, g0lo, g0hi);
+
+    for (i = 0, m = data ? data[0] : data_uint[0]; i < datalen; i++) {
+        /* 2nd highest remainder symbol before shift, to calculate next feedback ahead of the multiply below */
+        const unsigned int r1 = (_mm_cvtsi128_si32(rem[0]) >> 8) & 0xFF;
+        for (k = 0; k < nv - 1; k++) {
+            rem[k] = _mm_alignr_epi8(rem[k + 1], rem[k], 1);
+        }
+        rem[k] = _mm_srli_si128(rem[k], 1);
+        if (m) {
+            /* Feedback times 2**0 to 2**7 */
+            const __m128i a = _mm_loadl_epi64((const __m128i *) (alog + logt[m]));
+            const __m128i a_hi = _mm_srli_epi64(a, 32);
+            const __m128i tlo = _mm_xor_si128(
+                                    _mm_xor_si128(_mm_shuffle_epi8(a, idx[0]), _mm_shuffle_epi8(a, idx[1])),
+                                    _mm_xor_si128(_mm_shuffle_epi8(a, idx[2]), _mm_shuffle_epi8(a, idx[3])));
+            const __m128i thi = _mm_xor_si128(
+                                    _mm_xor_si128(_mm_shuffle_epi8(a_hi, idx[0]), _mm_shuffle_epi8(a_hi, idx[1])),
+                                    _mm_xor_si128(_mm_shuffle_epi8(a_hi, idx[2]), _mm_shuffle_epi8(a_hi, idx[3])));
+            for (k = 0; k < nv; k++) {
+                rem[k] = _mm_xor_si128(rem[k], _mm_xor_si128(_mm_shuffle_epi8(tlo, glo[k]),
+                                                                _mm_shuffle_epi8(thi, ghi[k])));
+            }
+        }
+        if (i + 1 < datalen) {
+            m = r1 ^ g0lo[m & 0x0F] ^ g0hi[m >> 4] ^ (data ? data[i + 1] : data_uint[i + 1]);
+        }
+    }
+    for (k = 0; k < nv; k++) {
+        _mm_storeu_si128((__m128i *) (buf + k * 16), rem[k]);
+    }
+    memcpy(res, buf, nsym);
+}
+
+/* As above using AVX2 registers */
+__attribute__((target("avx2")))
+static void rs_encode_avx2(const rs_t *rs, const int datalen, const unsigned char *data,
+                const unsigned int *data_uint, unsigned char *res) {
+    const unsigned char *const logt = rs->logt;
+    const unsigned char *const alog = rs->alog;
+    const int nsym = rs->nsym;
+    const int nv = (nsym + 31) >> 5;
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i rem[RS_FAST_MAX_NSYM / 32], glo[RS_FAST_MAX_NSYM / 32], ghi[RS_FAST_MAX_NSYM / 32];
+    __m256i idx[4];
+    unsigned char buf[RS_FAST_MAX_NSYM];
+    unsigned char g0lo[16], g0hi[16];
+    unsigned int m;
+    int i, j, k;
+
+    for (j = 0; j < nv * 32; j++) {
+        buf[j] = j < nsym ? rs->rspoly[nsym - 1 - j] : 0;
+    }
+    for (k = 0; k < nv; k++) {
+        const __m256i g = _mm256_loadu_si256((const __m256i *) (buf + k * 32));
+        glo[k] = _mm256_and_si256(g, mask);
+        ghi[k] = _mm256_and_si256(_mm256_srli_epi64(g, 4), mask);
+        rem[k] = _mm256_setzero_si256();
+    }
+    for (j = 0; j < 4; j++) {
+        /* As SSSE3 but low 128-bit lane selecting from bytes 0-3 and high lane from bytes 4-7 */
+        char s[32];
+        for (k = 0; k < 32; k++) {
+            s[k] = (char) (k & (1 << j) ? j + (k >> 4) * 4 : 0x80);
+        }
+        idx[j] = _mm256_loadu_si256((const __m256i *) s);
+    }
+
+    rs_g0_tables(rs, g0lo, g0hi);
+
+    for (i = 0, m = data ? data[0] : data_uint[0]; i < datalen; i++) {
+        const unsigned int r1 = (_mm256_cvtsi256_si32(rem[0]) >> 8) & 0xFF;
+        for (k = 0; k < nv - 1; k++) {
+            rem[k] = _mm256_alignr_epi8(_mm256_permute2x128_si256(rem[k], rem[k + 1], 0x21), rem[k], 1);
+        }
+        rem[k] = _mm256_alignr_epi8(_mm256_permute2x128_si256(rem[k], rem[k], 0x81), rem[k], 1);
+        if (m) {
+            /* Feedback times 2**0 to 2**7 broadcast to both lanes, then products with low nibbles in low lane and
+               with high nibbles in high lane */
+            const __m256i a = _mm256_broadcastsi128_si256(_mm_loadl_epi64((const __m128i *) (alog + logt[m])));
+            const __m256i t = _mm256_xor_si256(
+                                    _mm256_xor_si256(_mm256_shuffle_epi8(a, idx[0]), _mm256_shuffle_epi8(a, idx[1])),
+                                    _mm256_xor_si256(_mm256_shuffle_epi8(a, idx[2]), _mm256_shuffle_epi8(a, idx[3])));
+            const __m256i tlo = _mm256_permute2x128_si256(t, t, 0x00);
+            const __m256i thi = _mm256_permute2x128_si256(t, t, 0x11);
+            for (k = 0; k < nv; k++) {
+                rem[k] = _mm256_xor_si256(rem[k], _mm256_xor_si256(_mm256_shuffle_epi8(tlo, glo[k]),
+                                                                    _mm256_shuffle_epi8(thi, ghi[k])));
+            }
+        }
+        if (i + 1 < datalen) {
+            m = r1 ^ g0lo[m & 0x0F] ^ g0hi[m >> 4] ^ (data ? data[i + 1] : data_uint[i + 1]);
+        }
+    }
+    for (k = 0; k < nv; k++) {
+        _mm256_storeu_si256((__m256i *) (buf + k * 32), rem[k]);
+    }
+    memcpy(res, buf, nsym);
+}
+#endif /* RS_X86_SIMD */
+
+/* Kernel to use for `rs_encode_fast()`, or RS_KERNEL_SCALAR if not worth it */
+static int rs_fast_kernel(const rs_t *rs, const int datalen) {
+    int kernel;
+
+    if (rs->nsym < RS_FAST_MIN_NSYM || rs->nsym > RS_FAST_MAX_NSYM || datalen < RS_FAST_MIN_DATALEN) {
+        return RS_KERNEL_SCALAR;
+    }
+    kernel = rs_kernel();
+    if (kernel == RS_KERNEL_U64 && datalen < RS_U64_MIN_DATALEN) {
+        return RS_KERNEL_SCALAR;
+    }
+    return kernel;
+}
+
+/* Generate `nsym` Reed-Solomon codes of `data` (or `data_uint` if `data` NULL) by long division by the generator
+   polynomial, multiplying the whole polynomial by each feedback symbol at once using `kernel`. Results are highest
+   first, i.e. already reversed */
+static void rs_encode_fast(const rs_t *rs, const int datalen, const unsigned char *data,
+                const unsigned int *data_uint, unsigned char *res, const int kernel) {
+#ifdef RS_X86_SIMD
+    /* AVX2 only a gain if more than 2 SSSE3 registers' worth (AVX2 implies SSSE3) */
+    if (kernel == RS_KERNEL_AVX2 && rs->nsym > 32) {
+        rs_encode_avx2(rs, datalen, data, data_uint, res);
+        return;
+    }
+    if (kernel >= RS_KERNEL_SSSE3) {
+        rs_encode_ssse3(rs, datalen, data, data_uint, res);
+        return;
+    }
+#else
+    (void) kernel;
+#endif
+    rs_encode_u64(rs, datalen, data, data_uint, res);
 }
 
 /* rs_encode(&rs, datalen, data, res) generates nsym Reed-Solomon codes (nsym as given in rs_init_code()) */
 INTERNAL void zint_rs_encode(const rs_t *rs, const int datalen, const unsigned char *data, unsigned char *res) {
-    int i, k;
+    int i, k, kernel;
     const unsigned char *const logt = rs->logt;
     const unsigned char *const alog = rs->alog;
     const unsigned char *const rspoly = rs->rspoly;
@@ -163,6 +602,11 @@ INTERNAL void zint_rs_encode(const rs_t *rs, const int datalen, const unsigned c
     const int nsym = rs->nsym;
     const int nsym_halved = nsym >> 1;
 
+    if ((kernel = rs_fast_kernel(rs, datalen)) != RS_KERNEL_SCALAR) {
+        rs_encode_fast(rs, datalen, data, NULL, res, kernel);
+        return;
+    }
+
     memset(res, 0, nsym);
     if (rs->zero) { /* Poly has a zero coeff so need to check in inner loop */
         for (i = 0; i < datalen; i++) {
@@ -204,10 +648,31 @@ INTERNAL void zint_rs_encode(const rs_t *rs, const int datalen, const unsigned c
     }
 }
 
+/* Update `res`, the ECC of `prev_data`, to the ECC of `data` (both `datalen` long), encoding only from the first
+   codeword that differs - as Reed-Solomon is linear, ECC(data) = ECC(prev_data) ^ ECC(data ^ prev_data), and the
+   leading zeroes of the latter don't contribute */
+INTERNAL void zint_rs_encode_delta(const rs_t *rs, const int datalen, const unsigned char *data,
+                const unsigned char *prev_data, unsigned char *res) {
+    unsigned char delta[256], delta_res[256];
+    int i, first;
+
+    for (first = 0; first < datalen && data[first] == prev_data[first]; first++);
+    if (first == datalen) {
+        return;
+    }
+    for (i = first; i < datalen; i++) {
+        delta[i - first] = data[i] ^ prev_data[i];
+    }
+    zint_rs_encode(rs, datalen - first, delta, delta_res);
+    for (i = 0; i < rs->nsym; i++) {
+        res[i] ^= delta_res[i];
+    }
+}
+
 /* The same as above but for unsigned int data and result - Aztec code compatible */
 
 INTERNAL void zint_rs_encode_uint(const rs_t *rs, const int datalen, const unsigned int *data, unsigned int *res) {
-    int i, k;
+    int i, k, kernel;
     const unsigned char *const logt = rs->logt;
     const unsigned char *const alog = rs->alog;
     const unsigned char *const rspoly = rs->rspoly;
@@ -215,6 +680,15 @@ INTERNAL void zint_rs_encode_uint(const rs_t *rs, const int datalen, const unsig
     const int nsym = rs->nsym;
     const int nsym_halved = nsym >> 1;
 
+    if ((kernel = rs_fast_kernel(rs, datalen)) != RS_KERNEL_SCALAR) {
+        unsigned char res8[RS_FAST_MAX_NSYM];
+        rs_encode_fast(rs, datalen, NULL, data, res8, kernel);
+        for (i = 0; i < nsym; i++) {
+            res[i] = res8[i];
+        }
+        return;
+    }
+
     memset(res, 0, sizeof(unsigned int) * nsym);
     if (rs->zero) { /* Poly has a zero coeff so need to check in inner loop */
         for (i = 0; i < datalen; i++) {
@@ -259,56 +733,52 @@ INTERNAL void zint_rs_encode_uint(const rs_t *rs, const int datalen, const unsig
 /* Versions of the above for bitlengths > 8 and <= 30 and unsigned int data and results - Aztec code compatible */
 
 /* Usage:
-   First call rs_uint_init_gf(&rs_uint, prime_poly, logmod) to set up the Galois Field parameters.
-   Then  call rs_uint_init_code(&rs_uint, nsym, index) to set the encoding size
+   First call rs_uint_init_gf(&rs_uint, prime_poly) to set up the Galois Field parameters.
+   Then  call rs_uint_init_code(&rs_uint, nsym, index) to set the encoding size (can fail if generator polynomial
+         not cached)
    Then  call rs_uint_encode(&rs_uint, datalen, data, out) to encode the data.
-   Then  call rs_uint_free(&rs_uint) to free the log tables.
+   Then  call rs_uint_free(&rs_uint) to free the generator polynomial (if not cached).
 */
 
-/* `logmod` (field characteristic) will be 2**bitlength - 1, eg 1023 for bitlength 10, 4095 for bitlength 12 */
-INTERNAL int zint_rs_uint_init_gf(rs_uint_t *rs_uint, const unsigned int prime_poly, const int logmod) {
-    int b, p, v;
-    unsigned short *logt, *alog;
-
-    b = logmod + 1;
-
-    rs_uint->logt = NULL;
-    rs_uint->alog = NULL;
-
-    if (!(logt = (unsigned short *) rs_calloc(RS_FAIL_ID_LOGT, b, sizeof(unsigned short)))) {
-        return 0;
-    }
-    if (!(alog = (unsigned short *) rs_calloc(RS_FAIL_ID_ALOG, b * 2, sizeof(unsigned short)))) {
-        free(logt);
-        return 0;
-    }
-
-    /* Calculate the log/alog tables */
-    for (p = 1, v = 0; v < logmod; v++) {
-        alog[v] = p;
-        alog[logmod + v] = p; /* Double up, avoids mod */
-        logt[p] = v;
-        p <<= 1;
-        if (p & b) /* If overflow */
-            p ^= prime_poly; /* Subtract prime poly */
+/* Only the Aztec Code prime polys 0x409 (bitlength 10) and 0x1069 (bitlength 12) are supported */
+INTERNAL void zint_rs_uint_init_gf(rs_uint_t *rs_uint, const unsigned int prime_poly) {
+    if (prime_poly == 0x409) {
+        rs_uint->logt = logt_0x409;
+        rs_uint->alog = alog_0x409;
+    } else { /* 0x1069 */
+        rs_uint->logt = logt_0x1069;
+        rs_uint->alog = alog_0x1069;
     }
-    rs_uint->logt = logt;
-    rs_uint->alog = alog;
-    return 1;
+    rs_uint->prime_poly = prime_poly;
+    rs_uint->rspoly = rs_uint->log_rspoly = NULL;
+    rs_uint->buf = NULL;
 }
 
-INTERNAL void zint_rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int index) {
+/* Returns 0 if `malloc()` fails, in which case `rs_uint_encode()` will produce zeroes */
+INTERNAL int zint_rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int index) {
     int i, k;
     const unsigned short *const logt = rs_uint->logt;
     const unsigned short *const alog = rs_uint->alog;
-    unsigned short *rspoly = rs_uint->rspoly;
-    unsigned int *log_rspoly = rs_uint->log_rspoly;
+    const int index_in = index;
+    const unsigned short *cached;
+    unsigned short *rspoly, *log_rspoly;
 
-    if (logt == NULL || alog == NULL) {
-        return;
-    }
     rs_uint->nsym = nsym;
 
+    if ((cached = rs_cache_get(rs_uint->prime_poly, nsym, index, &rs_uint->zero))) {
+        rs_uint->rspoly = cached;
+        rs_uint->log_rspoly = cached + nsym + 1;
+        return 1;
+    }
+    if (!(rspoly = rs_cache_reserve(nsym))) {
+        if (!(rspoly = rs_uint->buf = (unsigned short *) rs_calloc(RS_FAIL_ID_GEN, (nsym + 1) * 2,
+                                                                    sizeof(unsigned short)))) {
+            rs_uint->rspoly = rs_uint->log_rspoly = NULL;
+            return 0;
+        }
+    }
+    log_rspoly = rspoly + nsym + 1;
+
     rspoly[0] = 1;
     for (i = 1; i <= nsym; i++) {
         rspoly[i] = 1;
@@ -327,6 +797,13 @@ INTERNAL void zint_rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int ind
         log_rspoly[i] = logt[rspoly[i]]; /* For simplicity allow log of 0 */
         rs_uint->zero |= rspoly[i] == 0;
     }
+    rs_uint->rspoly = rspoly;
+    rs_uint->log_rspoly = log_rspoly;
+
+    if (!rs_uint->buf) {
+        rs_cache_put(rspoly, rs_uint->prime_poly, nsym, index_in, rs_uint->zero);
+    }
+    return 1;
 }
 
 INTERNAL void zint_rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, const unsigned int *data,
@@ -335,12 +812,12 @@ INTERNAL void zint_rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, c
     const unsigned short *const logt = rs_uint->logt;
     const unsigned short *const alog = rs_uint->alog;
     const unsigned short *const rspoly = rs_uint->rspoly;
-    const unsigned int *const log_rspoly = rs_uint->log_rspoly;
+    const unsigned short *const log_rspoly = rs_uint->log_rspoly;
     const int nsym = rs_uint->nsym;
     const int nsym_halved = nsym >> 1;
 
     memset(res, 0, sizeof(unsigned int) * nsym);
-    if (logt == NULL || alog == NULL) {
+    if (rspoly == NULL) {
         return;
     }
     if (rs_uint->zero) { /* Poly has a zero coeff so need to check in inner loop */
@@ -384,14 +861,11 @@ INTERNAL void zint_rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, c
 }
 
 INTERNAL void zint_rs_uint_free(rs_uint_t *rs_uint) {
-    if (rs_uint->logt) {
-        free(rs_uint->logt);
-        rs_uint->logt = NULL;
-    }
-    if (rs_uint->alog) {
-        free(rs_uint->alog);
-        rs_uint->alog = NULL;
+    if (rs_uint->buf) {
+        free(rs_uint->buf);
+        rs_uint->buf = NULL;
     }
+    rs_uint->rspoly = rs_uint->log_rspoly = NULL;
 }
 
 /* vim: set ts=4 sw=4 et : */
@@ -52,13 +52,16 @@ typedef struct {
     unsigned char log_rspoly[256]; /* Logs of poly */
     int nsym; /* Degree of poly */
     int zero; /* Set if poly has a zero coeff */
+    unsigned int prime_poly;
 } rs_t;
 
 typedef struct {
-    unsigned short *logt; /* These are malloced */
-    unsigned short *alog;
-    unsigned short rspoly[4096]; /* Generated poly, 12-bit max - needs to be enlarged if > 12-bit used */
-    unsigned int log_rspoly[4096]; /* Logs of poly */
+    const unsigned short *logt; /* These are static */
+    const unsigned short *alog;
+    const unsigned short *rspoly; /* Generated poly, cached or in `buf` */
+    const unsigned short *log_rspoly; /* Logs of poly */
+    unsigned short *buf; /* Malloced if generated poly not cached */
+    unsigned int prime_poly;
     int nsym; /* Degree of poly */
     int zero; /* Set if poly has a zero coeff */
 } rs_uint_t;
@@ -66,20 +69,22 @@ typedef struct {
 INTERNAL void zint_rs_init_gf(rs_t *rs, const unsigned int prime_poly);
 INTERNAL void zint_rs_init_code(rs_t *rs, const int nsym, int index);
 INTERNAL void zint_rs_encode(const rs_t *rs, const int datalen, const unsigned char *data, unsigned char *res);
+INTERNAL void zint_rs_encode_delta(const rs_t *rs, const int datalen, const unsigned char *data,
+                const unsigned char *prev_data, unsigned char *res);
 INTERNAL void zint_rs_encode_uint(const rs_t *rs, const int datalen, const unsigned int *data, unsigned int *res);
 /* No free needed as log tables static */
 
-INTERNAL int zint_rs_uint_init_gf(rs_uint_t *rs_uint, const unsigned int prime_poly, const int logmod);
-INTERNAL void zint_rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int index);
+INTERNAL void zint_rs_uint_init_gf(rs_uint_t *rs_uint, const unsigned int prime_poly);
+INTERNAL int zint_rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int index);
 INTERNAL void zint_rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, const unsigned int *data,
                 unsigned int *res);
 INTERNAL void zint_rs_uint_free(rs_uint_t *rs_uint);
 
 #ifdef ZINT_TEST
-/* For testing `calloc()` failure */
-#define RS_FAIL_ID_LOGT 1
-#define RS_FAIL_ID_ALOG 2
+/* For testing `calloc()` failure (also disables generator polynomial cache) */
+#define RS_FAIL_ID_GEN  1
 INTERNAL void zint_test_rs_set_fail(const int id);
+INTERNAL int zint_test_rs_set_kernel(const int kernel);
 #endif
 
 #ifdef __cplusplus
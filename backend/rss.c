@@ -784,6 +784,10 @@ static int dbar_exp_binary_string(struct zint_symbol *symbol, const unsigned cha
     int cdf_bp_start; /* Compressed data field start - debug only */
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     if (length > 77) { /* ISO/IEC 24724:2011 4.2.d.2 */
         /* Caught below anyway but catch here also for better feedback */
         return z_errtxtf(ZINT_ERROR_TOO_LONG, symbol, 378, "Processed input length %d too long (maximum 77)", length);
@@ -1222,6 +1226,10 @@ INTERNAL int zint_dbar_exp_cc(struct zint_symbol *symbol, unsigned char source[]
     const int content_segs = symbol->output_options & BARCODE_CONTENT_SEGS;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
+
     error_number = zint_gs1_verify(symbol, source, length, reduced, &reduced_length, set_hrt);
     if (error_number >= ZINT_ERROR) {
         return error_number;
@@ -157,24 +157,30 @@ INTERNAL int zint_svg_plot(struct zint_symbol *symbol) {
     }
     sprintf(bgcolour_string, "%02X%02X%02X", bgred, bggreen, bgblue);
 
-    html_len = symbol->text_length + 1;
-
-    for (i = 0; i < symbol->text_length; i++) {
-        switch (symbol->text[i]) {
-            case '>':
-            case '<':
-            case '"':
-            case '&':
-            case '\'':
-                html_len += 6;
-                break;
+    /* Size from the vector strings rather than `symbol->text` as a sheet page may hold several symbols' text */
+    html_len = 1;
+    for (string = symbol->vector ? symbol->vector->strings : NULL; string; string = string->next) {
+        int len = string->length + 1;
+        for (i = 0; i < string->length; i++) {
+            switch (string->text[i]) {
+                case '>':
+                case '<':
+                case '"':
+                case '&':
+                case '\'':
+                    len += 6;
+                    break;
+            }
+        }
+        if (len > html_len) {
+            html_len = len;
         }
-    }
-    if (symbol->output_options & EANUPC_GUARD_WHITESPACE) {
-        html_len += 12; /* Allow for "<" & ">" */
     }
 
     html_string = (char *) z_alloca(html_len);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     /* Check for no created vector set */
     /* E-Mail Christian Schmitz 2019-09-10: reason unknown  Ticket #164 */
@@ -9965,10 +9965,10 @@ static void test_fuzz(const testCtx *const p_ctx) {
 INTERNAL void zint_test_az_set_fail(const int id, const int at);
 
 /* TODO: put these & above def in "aztec.h" (& rename existing "aztec.h" to "aztec_tabs.h" */
-#define AZ_FAIL_ID_LIST_INIT    1
-#define AZ_FAIL_ID_CPY          2
-#define AZ_FAIL_ID_ADD_CHK      3
-#define AZ_FAIL_ID_LIST_ADD_CHK 4
+#define AZ_FAIL_ID_LIST_INIT     1
+#define AZ_FAIL_ID_ARENA_INIT    2
+#define AZ_FAIL_ID_ARENA_ADD_CHK 3
+#define AZ_FAIL_ID_LIST_ADD_CHK  4
 
 static void test_alloc(const testCtx *const p_ctx) {
     int debug = p_ctx->debug;
@@ -9984,13 +9984,13 @@ static void test_alloc(const testCtx *const p_ctx) {
     };
     /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
     static const struct item data[] = {
-        /*  0*/ { BARCODE_MEMORY_FILE, "Aa345", -1, ZINT_ERROR_MEMORY, { 1, 2, 3, 0, 0 }, 3, AZ_FAIL_ID_LIST_INIT },
-        /*  1*/ { BARCODE_MEMORY_FILE, "\015\012. , : ", -1, ZINT_ERROR_MEMORY, { 1, 2, 3, 0, 0 }, 3, AZ_FAIL_ID_LIST_INIT },
-        /*  2*/ { BARCODE_MEMORY_FILE, "Aa345", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_CPY },
-        /*  3*/ { BARCODE_MEMORY_FILE, "ABC\241", -1, ZINT_ERROR_MEMORY, { 5, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_CPY },
-        /*  4*/ { BARCODE_MEMORY_FILE, "\241\015\012", -1, ZINT_ERROR_MEMORY, { 4, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_CPY },
-        /*  5*/ { BARCODE_MEMORY_FILE, NULL, 32, ZINT_ERROR_MEMORY, { 7, 42, 95, 96, 0 }, 4, AZ_FAIL_ID_CPY },
-        /*  6*/ { BARCODE_MEMORY_FILE, NULL, 32, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_ADD_CHK },
+        /*  0*/ { BARCODE_MEMORY_FILE, "Aa345", -1, ZINT_ERROR_MEMORY, { 1, 2, 0, 0, 0 }, 2, AZ_FAIL_ID_LIST_INIT },
+        /*  1*/ { BARCODE_MEMORY_FILE, "\015\012. , : ", -1, ZINT_ERROR_MEMORY, { 1, 2, 0, 0, 0 }, 2, AZ_FAIL_ID_LIST_INIT },
+        /*  2*/ { BARCODE_MEMORY_FILE, "Aa345", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_ARENA_INIT },
+        /*  3*/ { BARCODE_MEMORY_FILE, "\241\015\012", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_ARENA_INIT },
+        /*  4*/ { BARCODE_MEMORY_FILE, NULL, 32, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_ARENA_INIT },
+        /*  5*/ { BARCODE_MEMORY_FILE, "aBcDeF", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_ARENA_ADD_CHK },
+        /*  6*/ { BARCODE_MEMORY_FILE, "Code 2D!", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_ARENA_ADD_CHK },
         /*  7*/ { BARCODE_MEMORY_FILE, "Code 2D!", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_LIST_ADD_CHK },
         /*  8*/ { BARCODE_MEMORY_FILE, "+/EO5232013", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_LIST_ADD_CHK },
         /*  9*/ { BARCODE_MEMORY_FILE, "+/KN12345A", -1, ZINT_ERROR_MEMORY, { 1, 0, 0, 0, 0 }, 1, AZ_FAIL_ID_LIST_ADD_CHK },
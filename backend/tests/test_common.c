@@ -722,6 +722,80 @@ static void test_cnt_digits(const testCtx *const p_ctx) {
     testFinish();
 }
 
+static void test_bitstream(const testCtx *const p_ctx) {
+
+    struct item {
+        int appends[6][2]; /* Pairs of `arg`, `length`, terminated by -1 `length` */
+        int flush_after; /* Flush after this many appends, -1 if none */
+        int put[3]; /* `arg`, `length`, `posn` to overwrite with at end, `length` 0 if none */
+        const char *expected;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { { { 0, 0 }, { 0, -1 } }, -1, { 0, 0, 0 }, "" },
+        /*  1*/ { { { 1, 1 }, { 0, -1 } }, -1, { 0, 0, 0 }, "1" },
+        /*  2*/ { { { 5, 3 }, { 2, 4 }, { 0, -1 } }, -1, { 0, 0, 0 }, "1010010" },
+        /*  3*/ { { { 0xFF, 4 }, { 0, -1 } }, -1, { 0, 0, 0 }, "1111" },
+        /*  4*/ { { { 0xABCD, 16 }, { 0x1234, 16 }, { 0, -1 } }, -1, { 0, 0, 0 }, "10101011110011010001001000110100" },
+        /*  5*/ { { { 0x12345678, 32 }, { 1, 1 }, { 0, -1 } }, -1, { 0, 0, 0 }, "000100100011010001010110011110001" },
+        /*  6*/ { { { 0x7, 3 }, { 0x12345678, 32 }, { 0x3, 2 }, { 0, -1 } }, -1, { 0, 0, 0 }, "1110001001000110100010101100111100011" },
+        /*  7*/ { { { 0x7, 3 }, { 0x12345678, 32 }, { 0x3, 2 }, { 0, -1 } }, 1, { 0, 0, 0 }, "1110001001000110100010101100111100011" },
+        /*  8*/ { { { 0x7, 3 }, { 0x12345678, 32 }, { 0x3, 2 }, { 0, -1 } }, 2, { 0, 0, 0 }, "1110001001000110100010101100111100011" },
+        /*  9*/ { { { 0, 9 }, { 0xAA, 8 }, { 0, -1 } }, -1, { 0x1FF, 9, 0 }, "11111111110101010" },
+        /* 10*/ { { { 0, 9 }, { 0xAA, 8 }, { 0, -1 } }, 2, { 0x1FF, 9, 0 }, "11111111110101010" },
+        /* 11*/ { { { 0x3FFFFFFF, 30 }, { 0, 9 }, { 0x7, 3 }, { 0, -1 } }, -1, { 0x155, 9, 30 }, "111111111111111111111111111111101010101111" },
+        /* 12*/ { { { 0x3FFFFFFF, 30 }, { 0, 9 }, { 0x7, 3 }, { 0, -1 } }, 2, { 0, 2, 29 }, "111111111111111111111111111110000000000111" },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, j, length;
+    unsigned char buf[Z_BS_SIZE(64)];
+    struct z_bitstream bs;
+
+    testStart(p_ctx->func_name);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        memset(buf, 0xFF, sizeof(buf)); /* Check that flushed bits overwrite rather than OR */
+        z_bs_init(&bs, buf);
+        for (j = 0; data[i].appends[j][1] != -1; j++) {
+            if (j == data[i].flush_after) {
+                z_bs_flush(&bs);
+            }
+            z_bs_append(&bs, (unsigned int) data[i].appends[j][0], data[i].appends[j][1]);
+        }
+        if (data[i].put[1]) {
+            z_bs_put(&bs, (unsigned int) data[i].put[0], data[i].put[1], data[i].put[2]);
+        }
+        z_bs_flush(&bs);
+
+        length = (int) strlen(data[i].expected);
+        assert_equal(bs.bp, length, "i:%d bs.bp %d != length %d\n", i, bs.bp, length);
+        for (j = 0; j < length; j++) {
+            const int bit = z_bs_bit(buf, j);
+            assert_equal(bit, data[i].expected[j] - '0', "i:%d bit %d %d != %c\n", i, j, bit, data[i].expected[j]);
+        }
+        if (length & 0x07) {
+            /* Last byte zero-padded */
+            const int pad = buf[length >> 3] & ((1 << (8 - (length & 0x07))) - 1);
+            assert_zero(pad, "i:%d pad 0x%X non-zero\n", i, pad);
+        }
+        for (j = 0; j < length; j++) {
+            const int get_len = length - j > 25 ? 25 : length - j;
+            const unsigned int get = z_bs_get(buf, j, get_len);
+            unsigned int expected = 0;
+            int k;
+            for (k = 0; k < get_len; k++) {
+                expected = (expected << 1) | (data[i].expected[j + k] == '1');
+            }
+            assert_equal(get, expected, "i:%d z_bs_get(%d, %d) 0x%X != 0x%X\n", i, j, get_len, get, expected);
+        }
+    }
+
+    testFinish();
+}
+
 static void test_is_valid_utf8(const testCtx *const p_ctx) {
 
     struct item {
@@ -1598,6 +1672,109 @@ static void test_ct_printf_256(const testCtx *const p_ctx) {
     testFinish();
 }
 
+static void test_scratch(const testCtx *const p_ctx) {
+#ifndef ZINT_SMALL_STACK
+    testStart(p_ctx->func_name);
+    testSkip("Test requires ZINT_SMALL_STACK");
+#else
+    unsigned char *p1, *p2, *p3, *p4, *p5;
+    size_t mark;
+    int ret;
+
+    testStart(p_ctx->func_name);
+
+    z_scratch_enter();
+    assert_zero((int) z_scratch_mark(), "z_scratch_mark() %d != 0\n", (int) z_scratch_mark());
+
+    p1 = (unsigned char *) z_scratch_alloc(10);
+    assert_nonnull(p1, "p1 NULL\n");
+    assert_zero((int) ((size_t) p1 & 15), "p1 not 16-byte aligned\n");
+    mark = z_scratch_mark();
+    assert_equal((int) mark, 16, "mark %d != 16\n", (int) mark);
+
+    /* Fill 1st block exactly */
+    p2 = (unsigned char *) z_scratch_alloc(0x10000 - 16);
+    assert_nonnull(p2, "p2 NULL\n");
+    assert_equal(p2, p1 + 16, "p2 %p != p1 + 16 %p\n", (void *) p2, (void *) (p1 + 16));
+    assert_equal((int) z_scratch_mark(), 0x10000, "z_scratch_mark() 0x%X != 0x10000\n", (int) z_scratch_mark());
+
+    /* New block */
+    p3 = (unsigned char *) z_scratch_alloc(17);
+    assert_nonnull(p3, "p3 NULL\n");
+    assert_zero((int) ((size_t) p3 & 15), "p3 not 16-byte aligned\n");
+    assert_equal((int) z_scratch_mark(), 0x10020, "z_scratch_mark() 0x%X != 0x10020\n", (int) z_scratch_mark());
+
+    /* New block larger than minimum */
+    p4 = (unsigned char *) z_scratch_alloc(0x20000);
+    assert_nonnull(p4, "p4 NULL\n");
+    assert_equal((int) z_scratch_mark(), 0x30020, "z_scratch_mark() 0x%X != 0x30020\n", (int) z_scratch_mark());
+    memset(p2, 'A', 0x10000 - 16);
+    memset(p3, 'B', 17);
+    memset(p4, 'C', 0x20000);
+    assert_equal(p2[0x10000 - 17], 'A', "p2[0x10000 - 17] 0x%X != 'A'\n", p2[0x10000 - 17]);
+
+    /* Release across block boundaries back into 1st block, which is reused */
+    z_scratch_release(mark);
+    assert_equal((int) z_scratch_mark(), 16, "z_scratch_mark() %d != 16\n", (int) z_scratch_mark());
+    p5 = (unsigned char *) z_scratch_alloc(32);
+    assert_equal(p5, p2, "p5 %p != p2 %p\n", (void *) p5, (void *) p2);
+    assert_equal(p5[0], 'A', "p5[0] 0x%X != 'A'\n", p5[0]);
+
+    /* Release within block */
+    z_scratch_release(mark);
+    assert_equal((int) z_scratch_mark(), 16, "z_scratch_mark() %d != 16\n", (int) z_scratch_mark());
+
+    /* Nested call doesn't free arena */
+    z_scratch_enter();
+    p5 = (unsigned char *) z_scratch_alloc(16);
+    assert_equal(p5, p2, "p5 %p != p2 %p\n", (void *) p5, (void *) p2);
+    ret = z_scratch_leave();
+    assert_zero(ret, "z_scratch_leave() %d != 0\n", ret);
+    assert_equal((int) z_scratch_mark(), 32, "z_scratch_mark() %d != 32\n", (int) z_scratch_mark());
+
+    ret = z_scratch_leave();
+    assert_zero(ret, "z_scratch_leave() %d != 0\n", ret);
+    assert_zero((int) z_scratch_mark(), "z_scratch_mark() %d != 0\n", (int) z_scratch_mark());
+
+    /* Block allocation failure */
+    z_scratch_enter();
+    p1 = (unsigned char *) z_scratch_alloc(16);
+    assert_nonnull(p1, "p1 NULL\n");
+    assert_zero(z_scratch_failed(), "z_scratch_failed() non-zero\n");
+
+    zint_test_scratch_set_fail(1);
+    p2 = (unsigned char *) z_scratch_alloc(0x10000);
+    zint_test_scratch_set_fail(0);
+    assert_null(p2, "p2 non-NULL\n");
+    assert_nonzero(z_scratch_failed(), "z_scratch_failed() zero\n");
+
+    /* Sticky, even if would fit */
+    p3 = (unsigned char *) z_scratch_alloc(16);
+    assert_null(p3, "p3 non-NULL\n");
+
+    /* Nested leave reports but doesn't reset */
+    z_scratch_enter();
+    assert_nonzero(z_scratch_failed(), "z_scratch_failed() zero\n");
+    ret = z_scratch_leave();
+    assert_equal(ret, 1, "z_scratch_leave() %d != 1\n", ret);
+    assert_nonzero(z_scratch_failed(), "z_scratch_failed() zero\n");
+
+    ret = z_scratch_leave();
+    assert_equal(ret, 1, "z_scratch_leave() %d != 1\n", ret);
+    assert_zero(z_scratch_failed(), "z_scratch_failed() non-zero\n");
+    assert_zero((int) z_scratch_mark(), "z_scratch_mark() %d != 0\n", (int) z_scratch_mark());
+
+    /* Next call unaffected */
+    z_scratch_enter();
+    p1 = (unsigned char *) z_scratch_alloc(16);
+    assert_nonnull(p1, "p1 NULL\n");
+    ret = z_scratch_leave();
+    assert_zero(ret, "z_scratch_leave() %d != 0\n", ret);
+
+    testFinish();
+#endif
+}
+
 static void test_set_height(const testCtx *const p_ctx) {
     int debug = p_ctx->debug;
 
@@ -1719,6 +1896,7 @@ int main(int argc, char *argv[]) {
         { "test_errtxt", test_errtxt },
         { "test_errtxtf", test_errtxtf },
         { "test_cnt_digits", test_cnt_digits },
+        { "test_bitstream", test_bitstream },
         { "test_is_valid_utf8", test_is_valid_utf8 },
         { "test_utf8_to_unicode", test_utf8_to_unicode },
         { "test_extra_escapes", test_extra_escapes },
@@ -1733,6 +1911,7 @@ int main(int argc, char *argv[]) {
         { "test_ct_cpy", test_ct_cpy },
         { "test_ct_cpy_iso8859_1", test_ct_cpy_iso8859_1 },
         { "test_ct_printf_256", test_ct_printf_256 },
+        { "test_scratch", test_scratch },
         { "test_set_height", test_set_height },
         { "test_debug_test_codeword_dump_int", test_debug_test_codeword_dump_int },
     };
@@ -844,6 +844,90 @@ static void test_options(const testCtx *const p_ctx) {
     testFinish();
 }
 
+static void test_best_fit(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int option_2;
+        int option_3;
+        float aspect;
+        float max_width;
+        float max_height;
+        const char *data;
+        int ret;
+
+        int expected_rows;
+        int expected_width;
+        const char *expected_errtxt;
+        int expected_option_2;
+        const char *comment;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { -1, DM_BEST_FIT, 0, 0, 0, "1", 0, 10, 10, "", 1, "" },
+        /*  1*/ { -1, DM_BEST_FIT, 3, 0, 0, "1", 0, 12, 36, "", 28, "Exact ratio trumps area" },
+        /*  2*/ { -1, DM_BEST_FIT, 0, 9, 0, "1", ZINT_ERROR_TOO_LONG, -1, -1, "Error 987: No symbol size within maximum width 9 and height 144 fits 1 codewords", 0, "" },
+        /*  3*/ { -1, DM_BEST_FIT, 0, 0, 0, "__________", 0, 16, 16, "", 4, "10 data, 16x16 & 8x32 same area, squarer preferred" },
+        /*  4*/ { -1, DM_BEST_FIT, 4, 0, 0, "__________", 0, 8, 32, "", 26, "" },
+        /*  5*/ { -1, DM_BEST_FIT, 0.25f, 0, 0, "__________", 0, 16, 16, "", 4, "No tall sizes so square closest" },
+        /*  6*/ { -1, DM_BEST_FIT, 0, 20, 0, "__________", 0, 16, 16, "", 4, "" },
+        /*  7*/ { -1, DM_BEST_FIT, 0, 0, 10, "__________", 0, 8, 32, "", 26, "" },
+        /*  8*/ { -1, DM_BEST_FIT, 10, 0, 0, "__________", 0, 8, 80, "", 33, "DMRE" },
+        /*  9*/ { -1, DM_BEST_FIT | DM_ISO_144, 10, 0, 0, "__________", 0, 8, 80, "", 33, "" },
+        /* 10*/ { 4, DM_BEST_FIT, 4, 0, 0, "__________", 0, 16, 16, "", 4, "Ignored if version given" },
+        /* 11*/ { -1, -1, 4, 0, 0, "__________", 0, 8, 32, "", 26, "Ignored if not DM_BEST_FIT" },
+        /* 12*/ { -1, DM_BEST_FIT, 0, 0, 0, "ABCDEFGHIJ1234567890abcdefghij", 0, 20, 20, "", 6, "22 data" },
+        /* 13*/ { -1, DM_BEST_FIT, 4, 0, 0, "ABCDEFGHIJ1234567890abcdefghij", 0, 16, 64, "", 39, "Re-encoded for 62 capacity" },
+        /* 14*/ { -1, DM_BEST_FIT, 2, 0, 0, "ABCDEFGHIJ1234567890abcdefghij", 0, 24, 48, "", 44, "" },
+        /* 15*/ { -1, DM_BEST_FIT, 0, 40, 10, "ABCDEFGHIJ1234567890abcdefghij", ZINT_ERROR_TOO_LONG, -1, -1, "Error 987: No symbol size within maximum width 40 and height 10 fits 22 codewords", 0, "" },
+        /* 16*/ { -1, DM_BEST_FIT, 0, 0, 12, "12345678901234567890123456789012345678901234567890", 0, 8, 80, "", 33, "" },
+        /* 17*/ { -1, DM_BEST_FIT, 0, 0, 0, " AB2A.A>@", 0, 14, 14, "", 3, "8 data, EDIFACT unlatch omitted as exactly fills" },
+        /* 18*/ { -1, DM_BEST_FIT, 4, 0, 0, " AB2A.A>@", 0, 8, 32, "", 26, "Re-encoded for 10 capacity" },
+        /* 19*/ { -1, DM_BEST_FIT, 6, 0, 0, "b2 .Aa@@@bBa*>A1 b>b1@a1a>  >22 >@2  b>*a2** ", 0, 12, 64, "", 37, "43 data, TEXT unlatch omitted as exactly fills" },
+        /* 20*/ { -1, DM_BEST_FIT, 1, 0, 0, "b2 .Aa@@@bBa*>A1 b>b1@a1a>  >22 >@2  b>*a2** ", 0, 26, 26, "", 9, "Re-encoded for 44 capacity, needs 1 more codeword" },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, length, ret;
+    struct zint_symbol *symbol = NULL;
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        symbol->fit.aspect = data[i].aspect;
+        symbol->fit.max_width = data[i].max_width;
+        symbol->fit.max_height = data[i].max_height;
+
+        length = testUtilSetSymbol(symbol, BARCODE_DATAMATRIX, -1 /*input_mode*/, -1 /*eci*/,
+                                    -1 /*option_1*/, data[i].option_2, data[i].option_3, -1 /*output_options*/,
+                                    data[i].data, -1, debug);
+
+        ret = ZBarcode_Encode(symbol, TCU(data[i].data), length);
+        assert_equal(ret, data[i].ret, "i:%d ZBarcode_Encode ret %d != %d (%s)\n",
+                    i, ret, data[i].ret, symbol->errtxt);
+        assert_zero(strcmp(symbol->errtxt, data[i].expected_errtxt), "i:%d symbol->errtxt (%s) != (%s)\n",
+                    i, symbol->errtxt, data[i].expected_errtxt);
+
+        if (ret < ZINT_ERROR) {
+            assert_equal(symbol->rows, data[i].expected_rows, "i:%d symbol->rows %d != %d\n",
+                        i, symbol->rows, data[i].expected_rows);
+            assert_equal(symbol->width, data[i].expected_width, "i:%d symbol->width %d != %d\n",
+                        i, symbol->width, data[i].expected_width);
+            assert_equal(symbol->option_2, data[i].expected_option_2, "i:%d symbol->option_2 %d != %d\n",
+                        i, symbol->option_2, data[i].expected_option_2);
+        }
+
+        ZBarcode_Delete(symbol);
+    }
+
+    testFinish();
+}
+
 static void test_reader_init(const testCtx *const p_ctx) {
     int debug = p_ctx->debug;
 
@@ -1292,6 +1376,7 @@ static void test_input(const testCtx *const p_ctx) {
         /*307*/ { UNICODE_MODE | EXTRA_ESCAPE_MODE, 3, -1, -1, -1, -1, { 1, 2, "001001" }, "\\^11234\\^1", 0, 3, 8, 32, 1, 1, "E9 0F 01 01 E8 F1 04 8E A4 E8 C1 D2 2C 58 06 98 9E 54 39 C0 48", "", 0 },
         /*308*/ { UNICODE_MODE | FAST_MODE | EXTRA_ESCAPE_MODE, 4, -1, -1, -1, -1, { 1, 2, "001001" }, "12\\^11234\\^1", 0, 4, 16, 16, 1, 1, "E9 0F 01 01 8E E8 F1 05 8E A4 E8 81 5B 4D 22 4E 82 0A 9C B4 32 CF 84 EB", "", 0 },
         /*309*/ { UNICODE_MODE | EXTRA_ESCAPE_MODE, 4, -1, -1, -1, -1, { 1, 2, "001001" }, "12\\^11234\\^1", 0, 4, 16, 16, 1, 1, "E9 0F 01 01 8E E8 F1 05 8E A4 E8 81 5B 4D 22 4E 82 0A 9C B4 32 CF 84 EB", "", 0 },
+        /*310*/ { DATA_MODE, 0, -1, -1, -1, -1, { 0, 0, "" }, "\303A*\3011aC10C8N CaAa8aA.1b9.6\301181", 0, 0, 16, 36, 1, 1, "(56) EB 44 42 2B EB 42 32 62 44 8C E6 65 FC 15 43 08 73 08 23 08 72 52 0B 0E 8A 52 D2 BD", "Back-pointer of C40/TEXT edge >= 16 long", 0 },
     };
     const int data_size = ARRAY_SIZE(data);
     int i, length, ret;
@@ -6970,6 +7055,43 @@ static void test_ct_segs(const testCtx *const p_ctx) {
     testFinish();
 }
 
+/* Placement maps are cached per symbol size - check each size gives the same modules on generation and reuse */
+static void test_placement_cache(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    int i, j, length, ret;
+    struct zint_symbol *symbol = NULL;
+    const char *data = "1";
+    char modules_dump[2][144 * 144 + 1];
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    for (i = 1; i <= 48; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        for (j = 0; j < 2; j++) {
+            symbol = ZBarcode_Create();
+            assert_nonnull(symbol, "Symbol not created\n");
+
+            length = testUtilSetSymbol(symbol, BARCODE_DATAMATRIX, -1 /*input_mode*/, -1 /*eci*/,
+                                        -1 /*option_1*/, i /*option_2*/, -1, -1 /*output_options*/,
+                                        data, -1, debug);
+
+            ret = ZBarcode_Encode(symbol, TCU(data), length);
+            assert_zero(ret, "i:%d j:%d ZBarcode_Encode ret %d != 0 (%s)\n", i, j, ret, symbol->errtxt);
+            assert_notequal(testUtilModulesDump(symbol, modules_dump[j], sizeof(modules_dump[j])), -1,
+                        "i:%d j:%d testUtilModulesDump == -1\n", i, j);
+
+            ZBarcode_Delete(symbol);
+        }
+        assert_zero(strcmp(modules_dump[0], modules_dump[1]), "i:%d modules differ\n  first: %s\n second: %s\n",
+                    i, modules_dump[0], modules_dump[1]);
+    }
+
+    testFinish();
+}
+
 #ifdef ZINT_TEST_ENCODING
 static void test_minimalenc(const testCtx *const p_ctx) {
     int debug = p_ctx->debug;
@@ -8081,12 +8203,14 @@ int main(int argc, char *argv[]) {
         { "test_large", test_large },
         { "test_buffer", test_buffer },
         { "test_options", test_options },
+        { "test_best_fit", test_best_fit },
         { "test_reader_init", test_reader_init },
         { "test_input", test_input },
         { "test_encode", test_encode },
         { "test_encode_segs", test_encode_segs },
         { "test_ct", test_ct },
         { "test_ct_segs", test_ct_segs },
+        { "test_placement_cache", test_placement_cache },
 #ifdef ZINT_TEST_ENCODING
         { "test_minimalenc", test_minimalenc },
 #endif
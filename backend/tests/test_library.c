@@ -2648,6 +2648,365 @@ static void test_reset(const testCtx *const p_ctx) {
     testFinish();
 }
 
+static void test_stats(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int symbology;
+        int stats;
+        const char *outfile;
+        const char *data;
+        int ret;
+        unsigned int expected_count[ZINT_STATS_PHASES];
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { BARCODE_QRCODE, 1, "out.svg", "1234", 0, { 1, 1, 1, 1, 1, 1, 1, 1, 1 } },
+        /*  1*/ { BARCODE_DATAMATRIX, 1, "out.png", "1234", 0, { 1, 1, 1, 0, 1, 1, 1, 1, 1 } },
+        /*  2*/ { BARCODE_AZTEC, 1, NULL, "1234", 0, { 1, 1, 1, 0, 1, 1, 0, 1, 1 } },
+        /*  3*/ { BARCODE_PDF417, 1, "out.txt", "1234", 0, { 1, 1, 1, 0, 1, 0, 1, 1, 1 } },
+        /*  4*/ { BARCODE_MICROPDF417, 1, "out.emf", "1234", 0, { 1, 1, 1, 0, 1, 1, 1, 1, 1 } },
+        /*  5*/ { BARCODE_HANXIN, 1, "out.eps", "1234", 0, { 1, 1, 1, 1, 1, 1, 1, 1, 1 } },
+        /*  6*/ { BARCODE_MICROQR, 1, "out.bmp", "1234", 0, { 1, 1, 1, 1, 1, 1, 1, 1, 1 } },
+        /*  7*/ { BARCODE_RMQR, 1, "out.gif", "1234", 0, { 1, 1, 1, 1, 1, 1, 1, 1, 1 } },
+        /*  8*/ { BARCODE_CODE128, 1, "out.pcx", "1234", 0, { 1, 0, 0, 0, 0, 1, 1, 1, 1 } },
+        /*  9*/ { BARCODE_EAN13, 1, "out.svg", "A", ZINT_ERROR_INVALID_DATA, { 1, 0, 0, 0, 0, 0, 0, 1, 0 } },
+        /* 10*/ { BARCODE_QRCODE, 0, "out.svg", "1234", 0, { 0, 0, 0, 0, 0, 0, 0, 0, 0 } },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, j, length, ret;
+    int option_1, option_2, option_3;
+    struct zint_symbol *symbol = NULL;
+    struct zint_stats stats;
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        length = testUtilSetSymbol(symbol, data[i].symbology, -1 /*input_mode*/, -1 /*eci*/, -1 /*option_1*/,
+                                    -1 /*option_2*/, -1 /*option_3*/, BARCODE_MEMORY_FILE, data[i].data, -1,
+                                    data[i].stats ? debug | ZINT_DEBUG_STATS : debug);
+        option_1 = symbol->option_1;
+        option_2 = symbol->option_2;
+        option_3 = symbol->option_3;
+
+        ret = ZBarcode_Encode(symbol, TCU(data[i].data), length);
+        assert_equal(ret, data[i].ret, "i:%d ZBarcode_Encode ret %d != %d (%s)\n", i, ret, data[i].ret, symbol->errtxt);
+        if (ret < ZINT_ERROR) {
+            if (data[i].outfile) {
+                strcpy(symbol->outfile, data[i].outfile);
+                ret = ZBarcode_Print(symbol, 0 /*rotate_angle*/);
+                assert_zero(ret, "i:%d ZBarcode_Print ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+            } else {
+                ret = ZBarcode_Buffer(symbol, 0 /*rotate_angle*/);
+                assert_zero(ret, "i:%d ZBarcode_Buffer ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+            }
+        }
+
+        ret = ZBarcode_GetStats(symbol, &stats);
+        assert_zero(ret, "i:%d ZBarcode_GetStats ret %d != 0\n", i, ret);
+        for (j = 0; j < ZINT_STATS_PHASES; j++) {
+            assert_equal(stats.count[j], data[i].expected_count[j], "i:%d count[%d] %u != %u\n",
+                        i, j, stats.count[j], data[i].expected_count[j]);
+            assert_nonzero(stats.time[j] >= 0.0, "i:%d time[%d] %g < 0\n", i, j, stats.time[j]);
+            assert_nonzero(stats.count[j] || stats.time[j] == 0.0, "i:%d time[%d] %g != 0\n",
+                        i, j, stats.time[j]);
+        }
+        if (data[i].stats && data[i].ret < ZINT_ERROR) {
+            assert_equal((int) stats.bytes_in, length, "i:%d bytes_in %g != %d\n", i, stats.bytes_in, length);
+        } else {
+            assert_zero(stats.bytes_in, "i:%d bytes_in %g != 0\n", i, stats.bytes_in);
+        }
+        if (data[i].stats && data[i].ret < ZINT_ERROR && data[i].outfile) {
+            assert_nonzero(symbol->memfile_size, "i:%d memfile_size 0\n", i);
+            assert_equal((int) stats.bytes_out, symbol->memfile_size, "i:%d bytes_out %g != %d\n",
+                        i, stats.bytes_out, symbol->memfile_size);
+        } else {
+            assert_zero(stats.bytes_out, "i:%d bytes_out %g != 0\n", i, stats.bytes_out);
+        }
+
+        /* Accumulates */
+        if (data[i].stats && data[i].ret < ZINT_ERROR) {
+            symbol->option_1 = option_1; /* Undo any feedback */
+            symbol->option_2 = option_2;
+            symbol->option_3 = option_3;
+            ret = ZBarcode_Encode(symbol, TCU(data[i].data), length);
+            assert_zero(ret, "i:%d ZBarcode_Encode 2nd ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+            ret = ZBarcode_GetStats(symbol, &stats);
+            assert_zero(ret, "i:%d ZBarcode_GetStats 2nd ret %d != 0\n", i, ret);
+            assert_equal(stats.count[ZINT_STATS_ENCODE], 2, "i:%d count[ZINT_STATS_ENCODE] %u != 2\n",
+                        i, stats.count[ZINT_STATS_ENCODE]);
+            assert_equal((int) stats.bytes_in, length * 2, "i:%d bytes_in %g != %d\n",
+                        i, stats.bytes_in, length * 2);
+        }
+
+        /* Reset clears */
+        ZBarcode_Reset(symbol);
+        ret = ZBarcode_GetStats(symbol, &stats);
+        assert_zero(ret, "i:%d ZBarcode_GetStats reset ret %d != 0\n", i, ret);
+        assert_zero(stats.count[ZINT_STATS_ENCODE], "i:%d count[ZINT_STATS_ENCODE] %u != 0\n",
+                    i, stats.count[ZINT_STATS_ENCODE]);
+
+        ret = ZBarcode_GetStats(NULL, &stats);
+        assert_equal(ret, ZINT_ERROR_INVALID_DATA,
+                    "i:%d ZBarcode_GetStats(NULL) ret %d != ZINT_ERROR_INVALID_DATA\n", i, ret);
+        ret = ZBarcode_GetStats(symbol, NULL);
+        assert_equal(ret, ZINT_ERROR_INVALID_DATA,
+                    "i:%d ZBarcode_GetStats(NULL stats) ret %d != ZINT_ERROR_INVALID_DATA\n", i, ret);
+
+        ZBarcode_Delete(symbol);
+    }
+
+    testFinish();
+}
+
+static void test_trace(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int symbology;
+        int trace;
+        const char *outfile;
+        const char *data;
+        int ret;
+        int expected_cnt;
+        int expected_phases[10];
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { BARCODE_QRCODE, 1, "out.svg", "1234", 0, 9, { 0, 1, 2, 4, 3, 7, 5, 6, 8 } },
+        /*  1*/ { BARCODE_DATAMATRIX, 1, "out.png", "1234", 0, 8, { 0, 1, 2, 4, 7, 5, 6, 8 } },
+        /*  2*/ { BARCODE_AZTEC, 1, NULL, "1234", 0, 7, { 0, 1, 2, 4, 7, 5, 8 } },
+        /*  3*/ { BARCODE_CODE128, 1, "out.txt", "1234", 0, 4, { 0, 7, 6, 8 } },
+        /*  4*/ { BARCODE_EAN13, 1, "out.svg", "A", ZINT_ERROR_INVALID_DATA, 2, { 0, 7 } },
+        /*  5*/ { BARCODE_QRCODE, 0, "out.svg", "1234", 0, 0, { 0 } },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, j, length, ret, cnt;
+    struct zint_symbol *symbol = NULL;
+    struct zint_trace_event events[10];
+    struct zint_stats stats;
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        length = testUtilSetSymbol(symbol, data[i].symbology, -1 /*input_mode*/, -1 /*eci*/, -1 /*option_1*/,
+                                    -1 /*option_2*/, -1 /*option_3*/, BARCODE_MEMORY_FILE, data[i].data, -1,
+                                    data[i].trace ? debug | ZINT_DEBUG_TRACE : debug);
+
+        ret = ZBarcode_Encode(symbol, TCU(data[i].data), length);
+        assert_equal(ret, data[i].ret, "i:%d ZBarcode_Encode ret %d != %d (%s)\n", i, ret, data[i].ret, symbol->errtxt);
+        if (ret < ZINT_ERROR) {
+            if (data[i].outfile) {
+                strcpy(symbol->outfile, data[i].outfile);
+                ret = ZBarcode_Print(symbol, 0 /*rotate_angle*/);
+                assert_zero(ret, "i:%d ZBarcode_Print ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+            } else {
+                ret = ZBarcode_Buffer(symbol, 0 /*rotate_angle*/);
+                assert_zero(ret, "i:%d ZBarcode_Buffer ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+            }
+        }
+
+        cnt = ZBarcode_GetTrace(symbol, NULL /*events*/, 0);
+        assert_equal(cnt, data[i].expected_cnt, "i:%d ZBarcode_GetTrace(NULL) cnt %d != %d\n",
+                    i, cnt, data[i].expected_cnt);
+        cnt = ZBarcode_GetTrace(symbol, events, ARRAY_SIZE(events));
+        assert_equal(cnt, data[i].expected_cnt, "i:%d ZBarcode_GetTrace cnt %d != %d\n",
+                    i, cnt, data[i].expected_cnt);
+        for (j = 0; j < cnt; j++) {
+            assert_equal(events[j].phase, data[i].expected_phases[j], "i:%d events[%d].phase %d != %d\n",
+                        i, j, events[j].phase, data[i].expected_phases[j]);
+            assert_equal(events[j].symbology, data[i].symbology, "i:%d events[%d].symbology %d != %d\n",
+                        i, j, events[j].symbology, data[i].symbology);
+            assert_equal(events[j].length, length, "i:%d events[%d].length %d != %d\n",
+                        i, j, events[j].length, length);
+            assert_nonzero(events[j].dur >= 0.0, "i:%d events[%d].dur %g < 0\n", i, j, events[j].dur);
+            if (events[j].phase == ZINT_STATS_ENCODE && data[i].ret < ZINT_ERROR) {
+                assert_equal(events[j].rows, symbol->rows, "i:%d events[%d].rows %d != %d\n",
+                            i, j, events[j].rows, symbol->rows);
+                assert_equal(events[j].width, symbol->width, "i:%d events[%d].width %d != %d\n",
+                            i, j, events[j].width, symbol->width);
+            } else if (events[j].phase < ZINT_STATS_BUILD) {
+                assert_zero(events[j].rows, "i:%d events[%d].rows %d != 0\n", i, j, events[j].rows);
+                assert_zero(events[j].width, "i:%d events[%d].width %d != 0\n", i, j, events[j].width);
+            }
+            if (events[j].phase == ZINT_STATS_OUTPUT || events[j].phase == ZINT_STATS_FILE) {
+                assert_equal(events[j].bytes, symbol->memfile_size, "i:%d events[%d].bytes %d != %d\n",
+                            i, j, events[j].bytes, symbol->memfile_size);
+            } else {
+                assert_zero(events[j].bytes, "i:%d events[%d].bytes %d != 0\n", i, j, events[j].bytes);
+            }
+        }
+        if (cnt) {
+            /* Most recent only */
+            cnt = ZBarcode_GetTrace(symbol, events, 1);
+            assert_equal(cnt, 1, "i:%d ZBarcode_GetTrace 1 cnt %d != 1\n", i, cnt);
+            assert_equal(events[0].phase, data[i].expected_phases[data[i].expected_cnt - 1],
+                        "i:%d events[0].phase %d != %d\n",
+                        i, events[0].phase, data[i].expected_phases[data[i].expected_cnt - 1]);
+            /* Also accumulates stats */
+            ret = ZBarcode_GetStats(symbol, &stats);
+            assert_zero(ret, "i:%d ZBarcode_GetStats ret %d != 0\n", i, ret);
+            assert_equal(stats.count[ZINT_STATS_ENCODE], 1, "i:%d count[ZINT_STATS_ENCODE] %u != 1\n",
+                        i, stats.count[ZINT_STATS_ENCODE]);
+        }
+
+        /* Reset clears */
+        ZBarcode_Reset(symbol);
+        cnt = ZBarcode_GetTrace(symbol, NULL /*events*/, 0);
+        assert_zero(cnt, "i:%d ZBarcode_GetTrace reset cnt %d != 0\n", i, cnt);
+
+        cnt = ZBarcode_GetTrace(NULL, events, ARRAY_SIZE(events));
+        assert_zero(cnt, "i:%d ZBarcode_GetTrace(NULL) cnt %d != 0\n", i, cnt);
+
+        ZBarcode_Delete(symbol);
+    }
+
+    /* Ring buffer wraps, keeping most recent ZINT_TRACE_MAX events */
+    if (!testContinue(p_ctx, data_size)) {
+        struct zint_trace_event *all;
+        double ts;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+        symbol->symbology = BARCODE_CODE128;
+        symbol->debug = debug | ZINT_DEBUG_TRACE;
+
+        for (i = 0; i < ZINT_TRACE_MAX / 2 + 10; i++) { /* 2 events per encode (INPUT & ENCODE) */
+            ZBarcode_Clear(symbol); /* Keeps trace */
+            ret = ZBarcode_Encode(symbol, TCU(i & 1 ? "12" : "123"), i & 1 ? 2 : 3);
+            assert_zero(ret, "i:%d ZBarcode_Encode ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+        }
+        cnt = ZBarcode_GetTrace(symbol, NULL /*events*/, 0);
+        assert_equal(cnt, ZINT_TRACE_MAX, "ZBarcode_GetTrace(NULL) cnt %d != %d\n", cnt, ZINT_TRACE_MAX);
+
+        all = (struct zint_trace_event *) malloc(sizeof(struct zint_trace_event) * ZINT_TRACE_MAX);
+        assert_nonnull(all, "malloc fail\n");
+        cnt = ZBarcode_GetTrace(symbol, all, ZINT_TRACE_MAX);
+        assert_equal(cnt, ZINT_TRACE_MAX, "ZBarcode_GetTrace cnt %d != %d\n", cnt, ZINT_TRACE_MAX);
+        for (j = 0, ts = 0.0; j < cnt; j++) {
+            assert_equal(all[j].phase, j & 1 ? ZINT_STATS_ENCODE : ZINT_STATS_INPUT, "j:%d phase %d != %d\n",
+                        j, all[j].phase, j & 1 ? ZINT_STATS_ENCODE : ZINT_STATS_INPUT);
+            assert_nonzero(all[j].ts >= ts, "j:%d ts %g < %g\n", j, all[j].ts, ts);
+            ts = all[j].ts;
+        }
+        assert_equal(all[cnt - 1].length, 2, "all[%d].length %d != 2 \n", cnt - 1, all[cnt - 1].length);
+
+        free(all);
+        ZBarcode_Delete(symbol);
+    }
+
+    testFinish();
+}
+
+static void test_encode_delta(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int symbology;
+        int input_mode;
+        int option_1;
+        int option_3;
+        int reset; /* Undo any feedback before each encode */
+        const char *prefix;
+        int prefix_repeat;
+        const char *suffixes[4];
+        int expected_patches;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { BARCODE_QRCODE, -1, -1, -1, 0, "ABC-", 1, { "0001", "0002", "0099", "1000" }, 3 },
+        /*  1*/ { BARCODE_QRCODE, -1, -1, -1, 1, "ABC-", 1, { "0001", "0002", "0099", "1000" }, 3 },
+        /*  2*/ { BARCODE_QRCODE, -1, 2, 4 << 8, 0, "https://example.com/item?serial=", 1, { "000123", "000124", "000125", "999999" }, 3 },
+        /*  3*/ { BARCODE_QRCODE, -1, -1, -1, 1, "1234", 1, { "1", "2", "12345678901234567890123456789012345678901234567890", "3" }, 1 },
+        /*  4*/ { BARCODE_QRCODE, -1, -1, -1, 0, "1234", 1, { "1", "A", "2", "B" }, 3 }, /* Mode change but same version */
+        /*  5*/ { BARCODE_QRCODE, -1, 1, -1, 0, "Lorem ipsum dolor sit amet, ", 100, { "00001", "00002", "00010", "99999" }, 3 },
+        /*  6*/ { BARCODE_HIBC_QR, -1, -1, -1, 0, "A123BJC5D6E71", 1, { "0001", "0002", "0003", "0004" }, 3 },
+        /*  7*/ { BARCODE_DATAMATRIX, -1, -1, -1, 0, "ABC-", 1, { "0001", "0002", "0099", "1000" }, 3 },
+        /*  8*/ { BARCODE_DATAMATRIX, -1, -1, -1, 1, "ABC-", 1, { "0001", "0002", "0099", "1000" }, 3 },
+        /*  9*/ { BARCODE_DATAMATRIX, GS1_MODE, -1, -1, 0, "[01]09501101530003[21]", 1, { "000001", "000002", "123456", "654321" }, 3 },
+        /* 10*/ { BARCODE_DATAMATRIX, -1, -1, -1, 0, "1234567890", 300, { "000001", "000002", "000003", "999999" }, 3 },
+        /* 11*/ { BARCODE_DATAMATRIX, -1, -1, DM_ISO_144, 0, "1234567890", 300, { "000001", "000002", "000003", "999999" }, 3 },
+        /* 12*/ { BARCODE_DATAMATRIX, -1, -1, DM_DMRE, 1, "ABCDEFGH", 1, { "0001", "abcd", "0002", "0003" }, 1 },
+        /* 13*/ { BARCODE_CODE128, -1, -1, -1, 0, "ABC-", 1, { "0001", "0002", "0099", "1000" }, 0 },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, j, k, length, ret;
+    struct zint_symbol *symbol = NULL;
+    struct zint_symbol *symbol_full = NULL;
+    char buf[4096];
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    for (i = 0; i < data_size; i++) {
+        int option_1 = -1, option_2 = -1, option_3 = -1;
+
+        if (testContinue(p_ctx, i)) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        for (j = 0; j < 4; j++) {
+            buf[0] = '\0';
+            for (k = 0; k < data[i].prefix_repeat; k++) {
+                strcat(buf, data[i].prefix);
+            }
+            strcat(buf, data[i].suffixes[j]);
+
+            if (j == 0) {
+                length = testUtilSetSymbol(symbol, data[i].symbology, data[i].input_mode, -1 /*eci*/,
+                                            data[i].option_1, -1 /*option_2*/, data[i].option_3,
+                                            -1 /*output_options*/, buf, -1, debug);
+                option_1 = symbol->option_1;
+                option_2 = symbol->option_2;
+                option_3 = symbol->option_3;
+            } else {
+                length = (int) strlen(buf);
+                if (data[i].reset) {
+                    symbol->option_1 = option_1;
+                    symbol->option_2 = option_2;
+                    symbol->option_3 = option_3;
+                }
+            }
+            ZBarcode_Clear(symbol);
+            ret = ZBarcode_Encode_Delta(symbol, TCU(buf), length);
+            assert_zero(ret, "i:%d j:%d ZBarcode_Encode_Delta ret %d != 0 (%s)\n", i, j, ret, symbol->errtxt);
+
+            /* Same as full encode with same (fed back) options */
+            symbol_full = ZBarcode_Create();
+            assert_nonnull(symbol_full, "Symbol not created\n");
+            (void) testUtilSetSymbol(symbol_full, data[i].symbology, data[i].input_mode, -1 /*eci*/,
+                                        symbol->option_1, symbol->option_2, symbol->option_3,
+                                        -1 /*output_options*/, buf, -1, debug);
+            ret = ZBarcode_Encode(symbol_full, TCU(buf), length);
+            assert_zero(ret, "i:%d j:%d ZBarcode_Encode ret %d != 0 (%s)\n", i, j, ret, symbol_full->errtxt);
+            ret = testUtilSymbolCmp(symbol, symbol_full);
+            assert_zero(ret, "i:%d j:%d testUtilSymbolCmp ret %d != 0\n", i, j, ret);
+            assert_equal(symbol_full->option_3, symbol->option_3, "i:%d j:%d option_3 0x%X != 0x%X\n",
+                        i, j, symbol_full->option_3, symbol->option_3);
+            ZBarcode_Delete(symbol_full);
+        }
+        assert_nonnull(symbol->delta, "i:%d delta NULL\n", i);
+        assert_equal(symbol->delta->patches, data[i].expected_patches, "i:%d patches %d != %d\n",
+                    i, symbol->delta->patches, data[i].expected_patches);
+
+        ZBarcode_Delete(symbol);
+    }
+
+    testFinish();
+}
+
 static void test_default_xdim(const testCtx *const p_ctx) {
 
     struct item {
@@ -2800,6 +3159,9 @@ static void test_scale_from_xdimdp(const testCtx *const p_ctx) {
         /* 93*/ { BARCODE_CODE128, 0.5f, 300, -1, "abcd", 0 }, /* filetype unknown */
         /* 94*/ { BARCODE_QRCODE, 10, 31, 800, "gif", 155 },
         /* 95*/ { BARCODE_LAST + 1, 0, 12, 300, "gif", 0 },
+        /* 96*/ { BARCODE_PDF417, 0.27f, 12, 300, "zpl", 1.5 },
+        /* 97*/ { BARCODE_PDF417, 0.27f, 8, 203, "pos", 1 },
+        /* 98*/ { BARCODE_PDF417, 0.27f, 8, 203, "svg", 1.08f },
     };
     const int data_size = ARRAY_SIZE(data);
     int i;
@@ -2828,7 +3190,8 @@ static void test_scale_from_xdimdp(const testCtx *const p_ctx) {
 
             if (data[i].expected > 0.1f && data[i].expected < 200.0f /* Can't round trip scales <= 0.1 or >= 200.0 */
                     /* Non-MAXICODE raster rounds to half-increments */
-                    && (data[i].symbology == BARCODE_MAXICODE || strcmp(data[i].filetype, "gif") != 0)) {
+                    && (data[i].symbology == BARCODE_MAXICODE || (strcmp(data[i].filetype, "gif") != 0
+                        && strcmp(data[i].filetype, "pos") != 0 && strcmp(data[i].filetype, "zpl") != 0))) {
                 x_dim_from_scale = ZBarcode_XdimDp_From_Scale(data[i].symbology, ret, data[i].dpmm, data[i].filetype);
                 x_dim_from_scale = z_stripf(z_stripf(roundf(x_dim_from_scale * 100.0f)) / 100.0f);
                 assert_equal(x_dim_from_scale, data[i].x_dim,
@@ -2885,6 +3248,7 @@ static void test_xdimdp_from_scale(const testCtx *const p_ctx) {
         /* 28*/ { BARCODE_CODE128, 0.5f, 1000.1f, -1, "gif", 0 }, /* xdim_mm_or_dpmm > 1000 */
         /* 29*/ { BARCODE_CODE128, 1, 12, -1, "txt", 0 },
         /* 30*/ { BARCODE_LAST + 1, 1, 12, -1, "gif", 0 },
+        /* 31*/ { BARCODE_CODE128, 1, 12, -1, "zmm", 0 },
     };
     const int data_size = ARRAY_SIZE(data);
     int i;
@@ -3048,6 +3412,82 @@ static void test_utf8_to_eci(const testCtx *const p_ctx) {
     testFinish();
 }
 
+static void test_sequence_item(const testCtx *const p_ctx) {
+
+    struct item {
+        const char *start;
+        const char *step;
+        int index;
+        const char *format;
+        int ret;
+        const char *expected;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { "1", "1", 0, NULL, 0, "1" },
+        /*  1*/ { "1", "1", 9, "", 0, "10" },
+        /*  2*/ { "007", "3", 2, NULL, 0, "13" },
+        /*  3*/ { "5", "0", 100, NULL, 0, "5" },
+        /*  4*/ { "1", "1", 0, "####", 0, "   1" },
+        /*  5*/ { "1", "1", 0, "$$$$", 0, "0001" },
+        /*  6*/ { "1", "1", 0, "****", 0, "***1" },
+        /*  7*/ { "12", "1", 0, "#$*#", 0, " 012" },
+        /*  8*/ { "12", "1", 0, "$#*$", 0, "0 12" },
+        /*  9*/ { "1234", "1", 0, "A#-#B#C#D", 0, "A1-2B3C4D" },
+        /* 10*/ { "12345", "1", 0, "####", ZINT_ERROR_INVALID_DATA, "" },
+        /* 11*/ { "1", "1", 0, "ABC", ZINT_ERROR_INVALID_DATA, "" },
+        /* 12*/ { "1234567890", "1", 0, "[00]1061414$$$$$$$$$$?", 0, "[00]106141412345678908" }, /* GS1 General Specs example SSCC */
+        /* 13*/ { "1", "1", 0, "[00]1061414$$$$$$$$$$?", 0, "[00]106141400000000010" },
+        /* 14*/ { "1", "1", 1, "[00]1061414$$$$$$$$$$?", 0, "[00]106141400000000027" },
+        /* 15*/ { "629104150021", "1", 0, "$$$$$$$$$$$$?", 0, "6291041500213" }, /* EAN-13 */
+        /* 16*/ { "1", "1", 0, "#?#", ZINT_ERROR_INVALID_OPTION, "" }, /* No digits before check digit */
+        /* 17*/ { "1", "1", 9, "#?", ZINT_ERROR_INVALID_DATA, "" },
+        /* 18*/ { "12", "1", 0, "#?#?", 0, "1724" }, /* Check digit includes previous check digit */
+        /* 19*/ { "1", "1", 0, "?$", ZINT_ERROR_INVALID_OPTION, "" },
+        /* 20*/ { "999999999999999999", "0", 2000000000, NULL, 0, "999999999999999999" },
+        /* 21*/ { "999999999999999998", "1", 1, NULL, 0, "999999999999999999" },
+        /* 22*/ { "999999999999999998", "1", 2, NULL, ZINT_ERROR_INVALID_DATA, "" },
+        /* 23*/ { "1", "999999999999999999", 1, NULL, ZINT_ERROR_INVALID_DATA, "" },
+        /* 24*/ { "1000000000000000000", "1", 0, NULL, ZINT_ERROR_INVALID_OPTION, "" },
+        /* 25*/ { "", "1", 0, NULL, ZINT_ERROR_INVALID_OPTION, "" },
+        /* 26*/ { "1", "", 0, NULL, ZINT_ERROR_INVALID_OPTION, "" },
+        /* 27*/ { "-1", "1", 0, NULL, ZINT_ERROR_INVALID_OPTION, "" },
+        /* 28*/ { "1", "1", -1, NULL, ZINT_ERROR_INVALID_OPTION, "" },
+        /* 29*/ { NULL, "1", 0, NULL, ZINT_ERROR_INVALID_OPTION, "" },
+        /* 30*/ { "1", NULL, 0, NULL, ZINT_ERROR_INVALID_OPTION, "" },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, ret;
+
+    testStart(p_ctx->func_name);
+
+    for (i = 0; i < data_size; i++) {
+        unsigned char dest[64];
+        int dest_length = -1;
+
+        if (testContinue(p_ctx, i)) continue;
+
+        memset(dest, 0xFF, sizeof(dest));
+        ret = ZBarcode_Sequence_Item(data[i].start, data[i].step, data[i].index, data[i].format, dest,
+                                        &dest_length);
+        assert_equal(ret, data[i].ret, "i:%d ZBarcode_Sequence_Item ret %d != %d\n", i, ret, data[i].ret);
+        if (ret == 0) {
+            const int expected_length = (int) strlen(data[i].expected);
+            assert_equal(dest_length, expected_length, "i:%d dest_length %d != %d\n",
+                        i, dest_length, expected_length);
+            assert_zero(strcmp((const char *) dest, data[i].expected), "i:%d strcmp(%s, %s) != 0\n",
+                        i, dest, data[i].expected);
+        } else {
+            assert_equal(dest_length, -1, "i:%d dest_length %d != -1\n", i, dest_length);
+        }
+    }
+
+    ret = ZBarcode_Sequence_Item("1", "1", 0, NULL, NULL, &i);
+    assert_equal(ret, ZINT_ERROR_INVALID_OPTION, "NULL dest ret %d != ZINT_ERROR_INVALID_OPTION\n", ret);
+
+    testFinish();
+}
+
 static void test_content_segs(const testCtx *const p_ctx) {
     int debug = p_ctx->debug;
 
@@ -3336,6 +3776,271 @@ static void test_txt_hex_plot(const testCtx *const p_ctx) {
     testFinish();
 }
 
+/* Little-endian uint32 */
+static unsigned int test_zmm_u32(const unsigned char *b) {
+    return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int) b[3] << 24);
+}
+
+/* Little-endian IEEE float32 */
+static float test_zmm_f32(const unsigned char *b) {
+    unsigned int u32 = test_zmm_u32(b);
+    float f;
+    memcpy(&f, &u32, 4);
+    return f;
+}
+
+static void test_zmm_plot(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int symbology;
+        int option_1;
+        int option_2;
+        const char *data;
+        int expected_size;
+        const char *expected_start;
+        int expected_start_len;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { BARCODE_DATAMATRIX, -1, -1, "1", 20 + 10 * 4 + 10 * 2, "ZMM\001\107\000\000\000\012\000\000\000\012\000\000\000\000\000\040\101", 20 },
+        /*  1*/ { BARCODE_CODE128, -1, -1, "A", 20 + 1 * 4 + 1 * 6, "ZMM\001\024\000\000\000\001\000\000\000\056\000\000\000\000\000\110\102", 20 },
+        /*  2*/ { BARCODE_PDF417, -1, 1, "1234", -1, "ZMM\001\067\000\000\000", 8 },
+        /*  3*/ { BARCODE_ULTRA, -1, -1, "A", -1, "ZMM\001\220\000\001\000", 8 },
+        /*  4*/ { BARCODE_DBAR_EXPSTK, -1, 1, "[01]12345678901231", -1, "ZMM\001\121\000\000\000", 8 },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, length, ret;
+    struct zint_symbol *symbol = NULL;
+    struct zint_sheet sheet = {0};
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    for (i = 0; i < data_size; i++) {
+        const unsigned char *mf;
+        int r, x, is_colour, bytes_per_row, size;
+
+        if (testContinue(p_ctx, i)) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        length = testUtilSetSymbol(symbol, data[i].symbology, -1 /*input_mode*/, -1 /*eci*/,
+                                    data[i].option_1, data[i].option_2, -1 /*option_3*/, BARCODE_MEMORY_FILE,
+                                    data[i].data, -1, debug);
+        strcpy(symbol->outfile, "out.zmm");
+
+        ret = ZBarcode_Encode_and_Print(symbol, TCU(data[i].data), length, 0 /*rotate_angle*/);
+        assert_zero(ret, "i:%d ZBarcode_Encode_and_Print ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+        assert_nonnull(symbol->memfile, "i:%d memfile NULL\n", i);
+        mf = symbol->memfile;
+
+        is_colour = data[i].symbology == BARCODE_ULTRA;
+        bytes_per_row = is_colour ? symbol->width : (symbol->width + 7) / 8;
+        size = 20 + symbol->rows * (4 + bytes_per_row);
+        assert_equal(symbol->memfile_size, size, "i:%d memfile_size %d != %d\n", i, symbol->memfile_size, size);
+        if (data[i].expected_size != -1) {
+            assert_equal(size, data[i].expected_size, "i:%d size %d != expected_size %d\n",
+                        i, size, data[i].expected_size);
+        }
+        assert_zero(memcmp(mf, data[i].expected_start, data[i].expected_start_len),
+                    "i:%d memcmp(memfile, expected_start) != 0\n", i);
+
+        assert_equal((int) (mf[4] | (mf[5] << 8)), data[i].symbology, "i:%d symbology %d != %d\n",
+                    i, mf[4] | (mf[5] << 8), data[i].symbology);
+        assert_equal((int) (mf[6] | (mf[7] << 8)), is_colour, "i:%d flags %d != %d\n",
+                    i, mf[6] | (mf[7] << 8), is_colour);
+        assert_equal((int) test_zmm_u32(mf + 8), symbol->rows, "i:%d rows %d != %d\n",
+                    i, (int) test_zmm_u32(mf + 8), symbol->rows);
+        assert_equal((int) test_zmm_u32(mf + 12), symbol->width, "i:%d width %d != %d\n",
+                    i, (int) test_zmm_u32(mf + 12), symbol->width);
+        assert_equal(test_zmm_f32(mf + 16), symbol->height, "i:%d height %g != %g\n",
+                    i, test_zmm_f32(mf + 16), symbol->height);
+        for (r = 0; r < symbol->rows; r++) {
+            assert_equal(test_zmm_f32(mf + 20 + r * 4), symbol->row_height[r], "i:%d row_height[%d] %g != %g\n",
+                        i, r, test_zmm_f32(mf + 20 + r * 4), symbol->row_height[r]);
+        }
+        mf += 20 + symbol->rows * 4;
+        for (r = 0; r < symbol->rows; r++, mf += bytes_per_row) {
+            for (x = 0; x < bytes_per_row * (is_colour ? 1 : 8); x++) {
+                if (is_colour) {
+                    assert_equal(mf[x], z_module_colour_is_set(symbol, r, x), "i:%d (%d, %d) colour %d != %d\n",
+                                i, r, x, mf[x], z_module_colour_is_set(symbol, r, x));
+                } else {
+                    const int bit = (mf[x >> 3] >> (x & 7)) & 1;
+                    const int expected = x < symbol->width ? z_module_is_set(symbol, r, x) : 0;
+                    assert_equal(bit, expected, "i:%d (%d, %d) module %d != %d\n", i, r, x, bit, expected);
+                }
+            }
+        }
+
+        /* Not available for sheets */
+        ret = ZBarcode_Print_Sheet(&symbol, 1, &sheet, 0 /*rotate_angle*/);
+        assert_equal(ret, ZINT_ERROR_INVALID_OPTION, "i:%d ZBarcode_Print_Sheet ret %d != ZINT_ERROR_INVALID_OPTION\n",
+                    i, ret);
+        assert_zero(strcmp(symbol->errtxt, "Error 912: Sheet output not available for ZMM format"),
+                    "i:%d errtxt %s != Error 912\n", i, symbol->errtxt);
+
+        ZBarcode_Delete(symbol);
+    }
+
+    testFinish();
+}
+
+static void test_zmm_plot_fm(const testCtx *const p_ctx) {
+    struct item {
+        int id;
+        int at;
+        int expected;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { FM_FAIL_ID_OPEN, 1, ZINT_ERROR_FILE_ACCESS },
+        /*  1*/ { FM_FAIL_ID_WRITE, 1, ZINT_ERROR_FILE_WRITE },
+        /*  2*/ { FM_FAIL_ID_WRITE, 2, ZINT_ERROR_FILE_WRITE },
+        /*  3*/ { FM_FAIL_ID_WRITE, 13, ZINT_ERROR_FILE_WRITE },
+        /*  4*/ { FM_FAIL_ID_CLOSE, 1, ZINT_ERROR_FILE_WRITE },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, ret;
+    struct zint_symbol *symbol = NULL;
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    symbol = ZBarcode_Create();
+    assert_nonnull(symbol, "Symbol not created\n");
+
+    symbol->symbology = BARCODE_DATAMATRIX;
+    strcpy(symbol->outfile, "out.zmm");
+    ret = ZBarcode_Encode(symbol, TCU("1"), 1);
+    assert_zero(ret, "ZBarcode_Encode ret %d != 0 (%s)\n", ret, symbol->errtxt);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        zint_test_fm_set_fail(data[i].id, data[i].at);
+        ret = ZBarcode_Print(symbol, 0 /*rotate_angle*/);
+        assert_equal(ret, data[i].expected, "i:%d ZBarcode_Print ret %d != %d (%s)\n",
+                    i, ret, data[i].expected, symbol->errtxt);
+    }
+    zint_test_fm_set_fail(0, 0);
+
+    assert_zero(testUtilRemove(symbol->outfile), "testUtilRemove(%s) != 0\n", symbol->outfile);
+
+    ZBarcode_Delete(symbol);
+
+    testFinish();
+}
+
+static void test_scratch_fail(const testCtx *const p_ctx) {
+#ifndef ZINT_SMALL_STACK
+    testStart(p_ctx->func_name);
+    testSkip("Test requires ZINT_SMALL_STACK");
+#else
+    int debug = p_ctx->debug;
+
+    struct item {
+        int symbology;
+        int input_mode;
+        const char *data;
+        const char *primary;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, -1, "1234567890", "" },
+        /*  1*/ { BARCODE_GS1_128, GS1_MODE, "[01]12345678901231", "" },
+        /*  2*/ { BARCODE_CODABLOCKF, -1, "1234567890ABCDEFGHIJ", "" },
+        /*  3*/ { BARCODE_PDF417, -1, "1234567890ABCDEFGHIJ", "" },
+        /*  4*/ { BARCODE_MICROPDF417, -1, "1234567890ABCDEFGHIJ", "" },
+        /*  5*/ { BARCODE_MAXICODE, -1, "1234567890ABCDEFGHIJ", "" },
+        /*  6*/ { BARCODE_QRCODE, -1, "1234567890ABCDEFGHIJ", "" },
+        /*  7*/ { BARCODE_MICROQR, -1, "1234567890", "" },
+        /*  8*/ { BARCODE_RMQR, -1, "1234567890ABCDEFGHIJ", "" },
+        /*  9*/ { BARCODE_UPNQR, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 10*/ { BARCODE_DATAMATRIX, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 11*/ { BARCODE_AZTEC, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 12*/ { BARCODE_CODEONE, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 13*/ { BARCODE_GRIDMATRIX, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 14*/ { BARCODE_HANXIN, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 15*/ { BARCODE_DOTCODE, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 16*/ { BARCODE_ULTRA, -1, "1234567890ABCDEFGHIJ", "" },
+        /* 17*/ { BARCODE_DBAR_EXP, GS1_MODE, "[01]12345678901231", "" },
+        /* 18*/ { BARCODE_GS1_128_CC, GS1_MODE, "[20]01", "[01]12345678901231" },
+        /* 19*/ { BARCODE_EANX_CC, GS1_MODE, "[20]01", "1234567" },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, length, ret;
+    struct zint_symbol *symbol = NULL;
+
+    static const char *const outfiles[] = { "out.svg", "out.eps", "out.emf", "out.pdf", "out.gif", "out.pcx",
+                                            "out.tif",
+#ifndef ZINT_NO_PNG
+                                            "out.png",
+#endif
+    };
+    const int outfiles_size = ARRAY_SIZE(outfiles);
+
+    const char expected_errtxt[] = "Error 246: Insufficient memory for scratch arena";
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        strcpy(symbol->primary, data[i].primary);
+        length = testUtilSetSymbol(symbol, data[i].symbology, data[i].input_mode, -1 /*eci*/,
+                                    -1 /*option_1*/, -1 /*option_2*/, -1 /*option_3*/, -1 /*output_options*/,
+                                    data[i].data, -1, debug);
+
+        zint_test_scratch_set_fail(1);
+        ret = ZBarcode_Encode(symbol, TCU(data[i].data), length);
+        zint_test_scratch_set_fail(0);
+        assert_equal(ret, ZINT_ERROR_MEMORY, "i:%d ZBarcode_Encode ret %d != ZINT_ERROR_MEMORY (%s)\n",
+                    i, ret, symbol->errtxt);
+        assert_zero(strcmp(symbol->errtxt, expected_errtxt), "i:%d strcmp(%s, %s) != 0\n",
+                    i, symbol->errtxt, expected_errtxt);
+
+        /* Next call unaffected */
+        ret = ZBarcode_Encode(symbol, TCU(data[i].data), length);
+        assert_zero(ret, "i:%d ZBarcode_Encode ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+
+        ZBarcode_Delete(symbol);
+    }
+
+    symbol = ZBarcode_Create();
+    assert_nonnull(symbol, "Symbol not created\n");
+
+    symbol->symbology = BARCODE_CODE128;
+    symbol->output_options |= BARCODE_MEMORY_FILE;
+    ret = ZBarcode_Encode(symbol, TCU("1234"), 4);
+    assert_zero(ret, "ZBarcode_Encode ret %d != 0 (%s)\n", ret, symbol->errtxt);
+
+    for (i = 0; i < outfiles_size; i++) {
+        strcpy(symbol->outfile, outfiles[i]);
+
+        zint_test_scratch_set_fail(1);
+        ret = ZBarcode_Print(symbol, 0 /*rotate_angle*/);
+        zint_test_scratch_set_fail(0);
+        assert_equal(ret, ZINT_ERROR_MEMORY, "i:%d (%s) ZBarcode_Print ret %d != ZINT_ERROR_MEMORY (%s)\n",
+                    i, outfiles[i], ret, symbol->errtxt);
+        assert_zero(strcmp(symbol->errtxt, expected_errtxt), "i:%d (%s) strcmp(%s, %s) != 0\n",
+                    i, outfiles[i], symbol->errtxt, expected_errtxt);
+
+        ret = ZBarcode_Print(symbol, 0 /*rotate_angle*/);
+        assert_zero(ret, "i:%d (%s) ZBarcode_Print ret %d != 0 (%s)\n", i, outfiles[i], ret, symbol->errtxt);
+    }
+
+    ZBarcode_Delete(symbol);
+
+    testFinish();
+#endif
+}
+
 int main(int argc, char *argv[]) {
 
     testFunction funcs[] = { /* name, func */
@@ -3366,12 +4071,19 @@ int main(int argc, char *argv[]) {
         { "test_zero_outfile", test_zero_outfile },
         { "test_clear", test_clear },
         { "test_reset", test_reset },
+        { "test_stats", test_stats },
+        { "test_trace", test_trace },
+        { "test_encode_delta", test_encode_delta },
         { "test_default_xdim", test_default_xdim },
         { "test_scale_from_xdimdp", test_scale_from_xdimdp },
         { "test_xdimdp_from_scale", test_xdimdp_from_scale },
         { "test_utf8_to_eci", test_utf8_to_eci },
+        { "test_sequence_item", test_sequence_item },
         { "test_content_segs", test_content_segs },
         { "test_txt_hex_plot", test_txt_hex_plot },
+        { "test_zmm_plot", test_zmm_plot },
+        { "test_zmm_plot_fm", test_zmm_plot_fm },
+        { "test_scratch_fail", test_scratch_fail },
     };
 
     testRun(argc, argv, funcs, ARRAY_SIZE(funcs));
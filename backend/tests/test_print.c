@@ -219,10 +219,250 @@ static void test_print(const testCtx *const p_ctx) {
     testFinish();
 }
 
+/* Compare output `outfile` with `expected_file` according to extension `ext` */
+static int test_print_sheet_cmp(const char *ext, const char *outfile, const char *expected_file) {
+    if (strcmp(ext, "eps") == 0) {
+        return testUtilCmpEpss(outfile, expected_file);
+    }
+    if (strcmp(ext, "png") == 0) {
+        return testUtilCmpPngs(outfile, expected_file);
+    }
+    if (strcmp(ext, "svg") == 0) {
+        return testUtilCmpSvgs(outfile, expected_file);
+    }
+    return testUtilCmpBins(outfile, expected_file);
+}
+
+static void test_print_sheet(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        const char *ext;
+        int cols;
+        int rows;
+        float margin;
+        float gap;
+        int rotate_angle;
+        int page_cnt;
+        const char *expected_file;
+    };
+    struct item data[] = {
+        /*  0*/ { "png", 2, 0, 2, 1, 0, 1, "sheet_2_m2_g1" },
+        /*  1*/ { "bmp", 3, 0, 0, 0, 0, 1, "sheet_3" },
+        /*  2*/ { "gif", 2, 0, 4, 2, 90, 1, "sheet_2_m4_g2_rot90" },
+        /*  3*/ { "pcx", 5, 0, 1, 1, 0, 1, "sheet_5_m1_g1" },
+        /*  4*/ { "tif", 2, 1, 2, 1, 0, 3, "sheet_2x1_m2_g1" },
+        /*  5*/ { "tif", 0, 0, 0, 0, 180, 1, "sheet_1_rot180" },
+        /*  6*/ { "svg", 2, 0, 2, 1, 0, 1, "sheet_2_m2_g1" },
+        /*  7*/ { "svg", 3, 1, 1, 2, 0, 2, "sheet_3x1_m1_g2" },
+        /*  8*/ { "eps", 2, 2, 2, 1, 270, 2, "sheet_2x2_m2_g1_rot270" },
+        /*  9*/ { "pdf", 2, 0, 2, 1, 0, 1, "sheet_2_m2_g1" },
+        /* 10*/ { "pdf", 1, 2, 2, 0, 0, 3, "sheet_1x2_m2" },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i, ret;
+
+    static const struct { int symbology; const char *data; } symbols_data[] = {
+        { BARCODE_CODE128, "A1" }, { BARCODE_QRCODE, "12345" }, { BARCODE_DATAMATRIX, "ABC" },
+        { BARCODE_EANX, "123456789012" }, { BARCODE_ULTRA, "A" },
+    };
+    struct zint_symbol *symbols[ARRAY_SIZE(symbols_data)];
+    const int symbols_size = ARRAY_SIZE(symbols_data);
+    struct zint_sheet sheet;
+    int j, page;
+
+    char data_dir[1024];
+    char outfile[1024];
+    char expected_file[1024];
+
+    testStartSymbol(p_ctx->func_name, &symbols[0]);
+
+    assert_nonzero(testUtilDataPath(data_dir, sizeof(data_dir), "/backend/tests/data/print", NULL),
+                "testUtilDataPath == 0\n");
+    assert_nonzero(sizeof(data_dir) > strlen(data_dir) + 6, "sizeof(data_dir) %d <= strlen (%d) + 6\n",
+                (int) sizeof(data_dir), (int) strlen(data_dir));
+    strcat(data_dir, "/sheet");
+
+    if (p_ctx->generate) {
+        if (!testUtilDirExists(data_dir)) {
+            ret = testUtilMkDir(data_dir);
+            assert_zero(ret, "testUtilMkDir(%s) ret %d != 0 (%d: %s)\n", data_dir, ret, errno, strerror(errno));
+        }
+    }
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+        if (ZBarcode_NoPng() && strcmp(data[i].ext, "png") == 0) continue;
+
+        for (j = 0; j < symbols_size; j++) {
+            symbols[j] = ZBarcode_Create();
+            assert_nonnull(symbols[j], "i:%d j:%d Symbol not created\n", i, j);
+
+            (void) testUtilSetSymbol(symbols[j], symbols_data[j].symbology, -1 /*input_mode*/, -1 /*eci*/,
+                                        -1 /*option_1*/, -1, -1, -1 /*output_options*/, symbols_data[j].data, -1,
+                                        debug);
+            ret = ZBarcode_Encode(symbols[j], TCU(symbols_data[j].data), -1);
+            assert_zero(ret, "i:%d j:%d %s ZBarcode_Encode ret %d != 0 %s\n",
+                        i, j, testUtilBarcodeName(symbols_data[j].symbology), ret, symbols[j]->errtxt);
+        }
+        sprintf(symbols[0]->outfile, "out.%s", data[i].ext);
+
+        sheet.cols = data[i].cols;
+        sheet.rows = data[i].rows;
+        sheet.margin = data[i].margin;
+        sheet.gap = data[i].gap;
+
+        ret = ZBarcode_Print_Sheet(symbols, symbols_size, &sheet, data[i].rotate_angle);
+        assert_zero(ret, "i:%d ZBarcode_Print_Sheet(%s) ret %d != 0 (%s)\n",
+                    i, symbols[0]->outfile, ret, symbols[0]->errtxt);
+
+        if (p_ctx->generate) {
+            printf("        /*%3d*/ { \"%s\", %d, %d, %.8g, %.8g, %d, %d, \"%s\" },\n",
+                    i, data[i].ext, data[i].cols, data[i].rows, data[i].margin, data[i].gap, data[i].rotate_angle,
+                    data[i].page_cnt, data[i].expected_file);
+        }
+
+        /* Multiple pages output to separate files unless TIF or PDF */
+        for (page = 1; page <= data[i].page_cnt; page++) {
+            assert_nonzero(sizeof(expected_file) > strlen(data_dir) + 1 + strlen(data[i].expected_file) + 12
+                            + strlen(data[i].ext),
+                        "i:%d sizeof(expected_file) (%d) <= strlen(data_dir) (%d) + 1 + strlen(%s) (%d) + 12"
+                        " + strlen(%s) (%d)\n",
+                        i, (int) sizeof(expected_file), (int) strlen(data_dir), data[i].expected_file,
+                        (int) strlen(data[i].expected_file), data[i].ext, (int) strlen(data[i].ext));
+            strcpy(expected_file, data_dir);
+            strcat(expected_file, "/");
+            strcat(expected_file, data[i].expected_file);
+            if (data[i].page_cnt == 1 || strcmp(data[i].ext, "tif") == 0 || strcmp(data[i].ext, "pdf") == 0) {
+                if (page > 1) {
+                    break;
+                }
+                sprintf(outfile, "out.%s", data[i].ext);
+            } else {
+                sprintf(outfile, "out-%d.%s", page, data[i].ext);
+                sprintf(expected_file + strlen(expected_file), "-%d", page);
+            }
+            strcat(expected_file, ".");
+            strcat(expected_file, data[i].ext);
+            if (p_ctx->generate) {
+                ret = testUtilRename(outfile, expected_file);
+                assert_zero(ret, "i:%d testUtilRename(%s, %s) ret %d != 0\n", i, outfile, expected_file, ret);
+            } else {
+                assert_nonzero(testUtilExists(outfile), "i:%d testUtilExists(%s) == 0\n", i, outfile);
+                ret = test_print_sheet_cmp(data[i].ext, outfile, expected_file);
+                assert_zero(ret, "i:%d test_print_sheet_cmp(%s, %s) %d != 0\n", i, outfile, expected_file, ret);
+                if (p_ctx->index == -1) assert_zero(testUtilRemove(outfile), "i:%d testUtilRemove(%s) != 0\n", i, outfile);
+            }
+        }
+        if (data[i].page_cnt > 1 && strcmp(data[i].ext, "tif") != 0 && strcmp(data[i].ext, "pdf") != 0) {
+            sprintf(outfile, "out-%d.%s", data[i].page_cnt + 1, data[i].ext);
+            assert_zero(testUtilExists(outfile), "i:%d testUtilExists(%s) != 0\n", i, outfile);
+        }
+
+        for (j = 0; j < symbols_size; j++) {
+            ZBarcode_Delete(symbols[j]);
+        }
+    }
+
+    testFinish();
+}
+
+static void test_print_sheet_args(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        const char *outfile;
+        int output_options;
+        int symbol_cnt;
+        int null_sheet;
+        int null_symbol;
+        int cols;
+        int rows;
+        float margin;
+        float gap;
+        int rotate_angle;
+        int ret;
+        const char *expected_errtxt;
+    };
+    struct item data[] = {
+        /*  0*/ { "out.png", -1, 0, 0, 0, 1, 0, 0, 0, 0, ZINT_ERROR_INVALID_DATA, "Error 906: Invalid symbol count, must be at least 1" },
+        /*  1*/ { "out.png", -1, 2, 1, 0, 1, 0, 0, 0, 0, ZINT_ERROR_INVALID_DATA, "Error 907: Sheet layout NULL" },
+        /*  2*/ { "out.png", -1, 2, 0, 0, 1, 0, -1, 0, 0, ZINT_ERROR_INVALID_OPTION, "Error 908: Invalid sheet margin or gap (0 to 1000 only)" },
+        /*  3*/ { "out.png", -1, 2, 0, 0, 1, 0, 0, 1001, 0, ZINT_ERROR_INVALID_OPTION, "Error 908: Invalid sheet margin or gap (0 to 1000 only)" },
+        /*  4*/ { "out.png", -1, 2, 0, 1, 1, 0, 0, 0, 0, ZINT_ERROR_INVALID_DATA, "Error 909: Sheet symbol 2 NULL" },
+        /*  5*/ { "out.png", -1, 2, 0, 0, 1, 0, 0, 0, 45, ZINT_ERROR_INVALID_OPTION, "Error 223: Invalid rotation angle" },
+        /*  6*/ { "out.xyz", -1, 2, 0, 0, 1, 0, 0, 0, 0, ZINT_ERROR_INVALID_OPTION, "Error 911: Unknown output format" },
+        /*  7*/ { "png", -1, 2, 0, 0, 1, 0, 0, 0, 0, ZINT_ERROR_INVALID_OPTION, "Error 911: Unknown output format" },
+        /*  8*/ { "out.emf", -1, 2, 0, 0, 1, 0, 0, 0, 0, ZINT_ERROR_INVALID_OPTION, "Error 912: Sheet output not available for EMF format" },
+        /*  9*/ { "out.txt", -1, 2, 0, 0, 1, 0, 0, 0, 0, ZINT_ERROR_INVALID_OPTION, "Error 912: Sheet output not available for TXT format" },
+        /* 10*/ { "out.svg", BARCODE_MEMORY_FILE, 2, 0, 0, 1, 1, 0, 0, 0, ZINT_ERROR_INVALID_OPTION, "Error 913: Multiple sheet pages to stdout or memory require TIF or PDF format" },
+        /* 11*/ { "out.svg", BARCODE_MEMORY_FILE, 2, 0, 0, 2, 1, 0, 0, 0, 0, "" },
+        /* 12*/ { "out.tif", BARCODE_MEMORY_FILE, 2, 0, 0, 1, 1, 0, 0, 0, 0, "" },
+        /* 13*/ { "out.pdf", BARCODE_MEMORY_FILE, 2, 0, 0, 1, 1, 0, 0, 0, 0, "" },
+        /* 14*/ { "out.gif", BARCODE_MEMORY_FILE, 2, 0, 0, 1, 0, 0, 0, 0, 0, "" },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i, ret;
+
+    struct zint_symbol *symbols[2];
+    struct zint_sheet sheet;
+    int j;
+
+    testStartSymbol(p_ctx->func_name, &symbols[0]);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        for (j = 0; j < 2; j++) {
+            symbols[j] = ZBarcode_Create();
+            assert_nonnull(symbols[j], "i:%d j:%d Symbol not created\n", i, j);
+
+            (void) testUtilSetSymbol(symbols[j], BARCODE_CODE128, -1 /*input_mode*/, -1 /*eci*/, -1 /*option_1*/,
+                                        -1, -1, data[i].output_options, "A", -1, debug);
+            ret = ZBarcode_Encode(symbols[j], TCU("A"), -1);
+            assert_zero(ret, "i:%d j:%d ZBarcode_Encode ret %d != 0 %s\n", i, j, ret, symbols[j]->errtxt);
+        }
+        strcpy(symbols[0]->outfile, data[i].outfile);
+        if (data[i].null_symbol) {
+            ZBarcode_Delete(symbols[1]);
+            symbols[1] = NULL;
+        }
+
+        sheet.cols = data[i].cols;
+        sheet.rows = data[i].rows;
+        sheet.margin = data[i].margin;
+        sheet.gap = data[i].gap;
+
+        ret = ZBarcode_Print_Sheet(symbols, data[i].symbol_cnt, data[i].null_sheet ? NULL : &sheet,
+                                    data[i].rotate_angle);
+        assert_equal(ret, data[i].ret, "i:%d ZBarcode_Print_Sheet ret %d != %d (%s)\n",
+                    i, ret, data[i].ret, symbols[0]->errtxt);
+        assert_zero(strcmp(symbols[0]->errtxt, data[i].expected_errtxt), "i:%d errtxt %s != %s\n",
+                    i, symbols[0]->errtxt, data[i].expected_errtxt);
+        if (ret == 0) {
+            assert_nonnull(symbols[0]->memfile, "i:%d memfile NULL\n", i);
+            assert_nonzero(symbols[0]->memfile_size, "i:%d memfile_size 0\n", i);
+        }
+
+        for (j = 0; j < 2; j++) {
+            ZBarcode_Delete(symbols[j]);
+        }
+    }
+
+    ret = ZBarcode_Print_Sheet(NULL, 1, &sheet, 0);
+    assert_equal(ret, ZINT_ERROR_INVALID_DATA, "ZBarcode_Print_Sheet(NULL) ret %d != ZINT_ERROR_INVALID_DATA\n", ret);
+
+    testFinish();
+}
+
 int main(int argc, char *argv[]) {
 
     testFunction funcs[] = { /* name, func */
         { "test_print", test_print },
+        { "test_print_sheet", test_print_sheet },
+        { "test_print_sheet_args", test_print_sheet_args },
     };
 
     testRun(argc, argv, funcs, ARRAY_SIZE(funcs));
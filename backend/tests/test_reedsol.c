@@ -37,22 +37,23 @@ static void print_logs(const char *name, int logmod, unsigned int *logt, unsigne
     int i;
     const char *type = u16 ? "short" : "char";
     const char *format = u16 ? " 0x%04X," : " 0x%02X,";
+    const int per_line = u16 ? 12 : 16;
 
     printf("static const unsigned %s logt_%s[%d] = {", type, name, logmod + 1);
     for (i = 0; i < logmod + 1; i++) {
-        if (i % 16 == 0) printf("\n   ");
+        if (i % per_line == 0) printf("\n   ");
         printf(format, i ? logt[i] : 0);
     }
     printf("\n};\n");
 
     printf("static const unsigned %s alog_%s[%d] = {", type, name, logmod * 2);
     for (i = 0; i < logmod; i++) {
-        if (i % 16 == 0) printf("\n   ");
+        if (i % per_line == 0) printf("\n   ");
         printf(format, alog[i]);
     }
     /* Double antilog table */
     for (i = 0; i < logmod; i++) {
-        if (i % 16 == 0) printf("\n   ");
+        if (i % per_line == 0) printf("\n   ");
         printf(format, alog[i]);
     }
     printf("\n};\n");
@@ -93,6 +94,8 @@ static void test_generate(const testCtx *const p_ctx) {
         { "0x11d", 255, 0x11d, 0 },
         { "0x12d", 255, 0x12d, 0 },
         { "0x163", 255, 0x163, 0 },
+        { "0x409", 1023, 0x409, 1 },
+        { "0x1069", 4095, 0x1069, 1 },
     };
     int data_size = ARRAY_SIZE(data);
     int i;
@@ -249,7 +252,6 @@ static void test_uint_encoding(const testCtx *const p_ctx) {
 
     struct item {
         unsigned int prime_poly;
-        int logmod;
         int nsym;
         int index;
         int datalen;
@@ -259,11 +261,11 @@ static void test_uint_encoding(const testCtx *const p_ctx) {
     };
     /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
     struct item data[] = {
-        /*  0*/ { 0x409, 1023, 4, 1, 7, { 0x3FF, 0x000, 0x100, 0x1FF, 0x3FF, 0x000, 0x123 }, { 674, 993, 153, 229 } },
-        /*  1*/ { 0x1069, 4095, 4, 1, 7, { 0xFFF, 0x000, 0x700, 0x7FF, 0xFFF, 0x000, 0x123 }, { 575, 3494, 2350, 3472 } },
-        /*  2*/ { 0x1000, 4095, 4, 0, 7, { 0xFFF, 0x000, 0x700, 0x7FF, 0xFFF, 0x000, 0x123 }, { 64, 0, 65, 1 } },
-        /*  3*/ { 0x1000, 4095, 256, 0, 1, { 0xFFF }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2048, 0, 512, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1 } },
-        /*  4*/ { 0x409, 1023, 4, 0, 7, { 0, 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0 } },
+        /*  0*/ { 0x409, 4, 1, 7, { 0x3FF, 0x000, 0x100, 0x1FF, 0x3FF, 0x000, 0x123 }, { 674, 993, 153, 229 } },
+        /*  1*/ { 0x1069, 4, 1, 7, { 0xFFF, 0x000, 0x700, 0x7FF, 0xFFF, 0x000, 0x123 }, { 575, 3494, 2350, 3472 } },
+        /*  2*/ { 0x1069, 4, 0, 7, { 0xFFF, 0x000, 0x700, 0x7FF, 0xFFF, 0x000, 0x123 }, { 3379, 54, 2634, 1683 } },
+        /*  3*/ { 0x1069, 256, 0, 1, { 0xFFF }, { 414, 1960, 1305, 3182, 1232, 1493, 1079, 1826, 2142, 4032, 1028, 2574, 1979, 2589, 2715, 508, 998, 246, 165, 422, 2416, 1728, 3978, 1194, 1049, 1324, 3131, 348, 425, 2172, 926, 1719, 1894, 315, 1617, 2211, 3477, 1252, 3341, 1786, 836, 3116, 2751, 1429, 1676, 3653, 557, 2482, 567, 982, 1185, 637, 1523, 1477, 3942, 1044, 2821, 3594, 3697, 2569, 916, 2868, 1334, 1493, 509, 3365, 4072, 1759, 3504, 1547, 2857, 3949, 2824, 978, 1560, 2291, 784, 3354, 1556, 1644, 2491, 3507, 3607, 49, 1943, 1752, 2291, 1682, 630, 1379, 52, 1424, 2417, 2347, 1822, 3728, 1180, 1233, 3933, 2909, 1265, 3176, 905, 754, 2935, 284, 2791, 2799, 1972, 211, 1181, 243, 2356, 2770, 2990, 2338, 3958, 423, 628, 2634, 748, 3072, 2947, 1556, 798, 1623, 2415, 1755, 3539, 2631, 9, 3822, 1120, 660, 3443, 4009, 2731, 1501, 2689, 2853, 160, 509, 874, 1614, 944, 2228, 3036, 142, 2755, 1903, 418, 3286, 2095, 3216, 3370, 1652, 2798, 955, 2435, 2627, 1595, 3577, 2584, 525, 455, 2163, 3809, 961, 1349, 2231, 131, 3912, 3857, 1653, 26, 3494, 2300, 206, 124, 3001, 3649, 2644, 3281, 3011, 1422, 1606, 2863, 3973, 1702, 2150, 2099, 3032, 1154, 1645, 3873, 2257, 1718, 3268, 162, 506, 531, 2525, 2481, 2992, 2447, 4000, 11, 1111, 3000, 119, 3911, 3474, 1974, 701, 2188, 672, 459, 135, 57, 3710, 3413, 3790, 941, 1490, 406, 3290, 2659, 3363, 2510, 625, 2555, 3079, 2754, 736, 625, 324, 778, 3095, 74, 2827, 4048, 469, 3134, 3760, 3584, 2343, 767, 2595, 535, 1799, 3431, 1526, 545, 3776, 1749, 3803 } },
+        /*  4*/ { 0x409, 4, 0, 7, { 0, 0, 0, 0, 0, 0, 0 }, { 0, 0, 0, 0 } },
     };
     int data_size = ARRAY_SIZE(data);
     int i;
@@ -277,9 +279,9 @@ static void test_uint_encoding(const testCtx *const p_ctx) {
 
         if (testContinue(p_ctx, i)) continue;
 
-        assert_nonzero(zint_rs_uint_init_gf(&rs_uint, data[i].prime_poly, data[i].logmod),
-                        "i:%d zint_rs_uint_init_gf() == 0\n", i);
-        zint_rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index);
+        zint_rs_uint_init_gf(&rs_uint, data[i].prime_poly);
+        assert_nonzero(zint_rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index),
+                        "i:%d zint_rs_uint_init_code() == 0\n", i);
         zint_rs_uint_encode(&rs_uint, data[i].datalen, data[i].data, res);
         zint_rs_uint_free(&rs_uint);
 
@@ -295,16 +297,12 @@ static void test_uint_encoding(const testCtx *const p_ctx) {
                         i, k, (int) res[k], j, (int) data[i].expected[j]);
         }
 
-        /* Simulate zint_rs_uint_init_gf() malloc() failure and zint_rs_uint_init_gf()'s return val not being
-           checked */
-        assert_nonzero(zint_rs_uint_init_gf(&rs_uint, data[i].prime_poly, data[i].logmod),
-                        "i:%d zint_rs_uint_init_gf() == 0\n", i);
-        free(rs_uint.logt);
-        rs_uint.logt = NULL;
-        free(rs_uint.alog);
-        rs_uint.alog = NULL;
-
-        zint_rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index);
+        /* Simulate zint_rs_uint_init_code() malloc() failure and its return val not being checked */
+        zint_test_rs_set_fail(RS_FAIL_ID_GEN);
+        zint_rs_uint_init_gf(&rs_uint, data[i].prime_poly);
+        assert_zero(zint_rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index),
+                        "i:%d zint_rs_uint_init_code() != 0\n", i);
+        zint_test_rs_set_fail(0);
         zint_rs_uint_encode(&rs_uint, data[i].datalen, data[i].data, res);
         zint_rs_uint_free(&rs_uint);
 
@@ -317,6 +315,176 @@ static void test_uint_encoding(const testCtx *const p_ctx) {
     testFinish();
 }
 
+/* Check `zint_rs_encode()` & `zint_rs_encode_uint()` kernels against scalar */
+static void test_kernels(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        unsigned int prime_poly;
+        int logmod;
+        int nsym;
+        int index;
+        int datalen;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { 0x13, 15, 16, 1, 8 },
+        /*  1*/ { 0x25, 31, 17, 1, 14 },
+        /*  2*/ { 0x43, 63, 20, 1, 42 },
+        /*  3*/ { 0x89, 127, 25, 1, 32 },
+        /*  4*/ { 0x11d, 255, 16, 0, 8 },
+        /*  5*/ { 0x11d, 255, 30, 0, 122 },
+        /*  6*/ { 0x11d, 255, 31, 0, 224 },
+        /*  7*/ { 0x11d, 255, 32, 0, 223 },
+        /*  8*/ { 0x11d, 255, 33, 0, 222 },
+        /*  9*/ { 0x12d, 255, 62, 1, 156 },
+        /* 10*/ { 0x12d, 255, 68, 1, 187 },
+        /* 11*/ { 0x12d, 255, 95, 1, 160 },
+        /* 12*/ { 0x12d, 255, 96, 1, 159 },
+        /* 13*/ { 0x12d, 255, 97, 1, 158 }, /* Scalar */
+        /* 14*/ { 0x163, 255, 64, 1, 191 },
+        /* 15*/ { 0x163, 255, 15, 1, 240 }, /* Scalar */
+        /* 16*/ { 0x163, 255, 256, 1, 600 }, /* Scalar */
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, j, kernel;
+
+    testStart(p_ctx->func_name);
+
+    for (i = 0; i < data_size; i++) {
+        rs_t rs;
+        unsigned char buf[1000];
+        unsigned int buf_uint[1000];
+        unsigned char expected[256], res[256];
+        unsigned int expected_uint[256], res_uint[256];
+
+        if (testContinue(p_ctx, i)) continue;
+
+        for (j = 0; j < data[i].datalen; j++) {
+            buf_uint[j] = buf[j] = (unsigned char) ((j * 151 + i * 37 + (j >> 3)) % (data[i].logmod + 1));
+        }
+
+        zint_rs_init_gf(&rs, data[i].prime_poly);
+        zint_rs_init_code(&rs, data[i].nsym, data[i].index);
+
+        assert_nonzero(zint_test_rs_set_kernel(-1), "i:%d zint_test_rs_set_kernel(-1) zero\n", i);
+        zint_rs_encode(&rs, data[i].datalen, buf, expected);
+        zint_rs_encode_uint(&rs, data[i].datalen, buf_uint, expected_uint);
+
+        for (kernel = 0; kernel <= 2; kernel++) {
+            if (!zint_test_rs_set_kernel(kernel)) {
+                if (debug & ZINT_DEBUG_TEST_PRINT) {
+                    fprintf(stderr, "i:%d kernel %d not supported\n", i, kernel);
+                }
+                continue;
+            }
+            memset(res, 0xFF, sizeof(res));
+            zint_rs_encode(&rs, data[i].datalen, buf, res);
+            assert_zero(memcmp(res, expected, data[i].nsym), "i:%d kernel %d zint_rs_encode memcmp != 0\n",
+                        i, kernel);
+
+            memset(res_uint, 0xFF, sizeof(res_uint));
+            zint_rs_encode_uint(&rs, data[i].datalen, buf_uint, res_uint);
+            for (j = 0; j < data[i].nsym; j++) {
+                assert_equal(res_uint[j], expected_uint[j], "i:%d kernel %d res_uint[%d] %u != %u\n",
+                            i, kernel, j, res_uint[j], expected_uint[j]);
+                assert_equal(res_uint[j], (unsigned int) expected[j], "i:%d kernel %d res_uint[%d] %u != %u\n",
+                            i, kernel, j, res_uint[j], expected[j]);
+            }
+        }
+        zint_test_rs_set_kernel(-2);
+    }
+
+    testFinish();
+}
+
+/* Check generator polynomial cache gives same polys as uncached */
+static void test_cache(const testCtx *const p_ctx) {
+
+    struct item {
+        unsigned int prime_poly;
+        int nsym;
+        int index;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct item data[] = {
+        /*  0*/ { 0x11d, 30, 0 },
+        /*  1*/ { 0x12d, 62, 1 },
+        /*  2*/ { 0x163, 255, 1 },
+        /*  3*/ { 0x409, 28, 1 },
+        /*  4*/ { 0x1069, 703, 1 },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, j;
+
+    testStart(p_ctx->func_name);
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        if (data[i].prime_poly <= 0x163) {
+            rs_t rs, rs_nocache;
+            int pass;
+
+            zint_test_rs_set_fail(RS_FAIL_ID_GEN); /* Disables cache */
+            zint_rs_init_gf(&rs_nocache, data[i].prime_poly);
+            zint_rs_init_code(&rs_nocache, data[i].nsym, data[i].index);
+            zint_test_rs_set_fail(0);
+
+            for (pass = 0; pass < 2; pass++) { /* 2nd pass hits cache */
+                memset(&rs, 0, sizeof(rs));
+                zint_rs_init_gf(&rs, data[i].prime_poly);
+                zint_rs_init_code(&rs, data[i].nsym, data[i].index);
+                assert_equal(rs.zero, rs_nocache.zero, "i:%d pass %d zero %d != %d\n",
+                            i, pass, rs.zero, rs_nocache.zero);
+                for (j = 0; j <= data[i].nsym; j++) {
+                    assert_equal(rs.rspoly[j], rs_nocache.rspoly[j], "i:%d pass %d rspoly[%d] %d != %d\n",
+                                i, pass, j, rs.rspoly[j], rs_nocache.rspoly[j]);
+                    assert_equal(rs.log_rspoly[j], rs_nocache.log_rspoly[j],
+                                "i:%d pass %d log_rspoly[%d] %d != %d\n",
+                                i, pass, j, rs.log_rspoly[j], rs_nocache.log_rspoly[j]);
+                }
+            }
+        } else {
+            rs_uint_t rs_uint, rs_uint_nocache;
+            const unsigned short *rspoly;
+
+            zint_test_rs_set_fail(RS_FAIL_ID_GEN);
+            zint_rs_uint_init_gf(&rs_uint_nocache, data[i].prime_poly);
+            assert_zero(zint_rs_uint_init_code(&rs_uint_nocache, data[i].nsym, data[i].index),
+                        "i:%d zint_rs_uint_init_code() != 0\n", i);
+            zint_test_rs_set_fail(0);
+            zint_rs_uint_free(&rs_uint_nocache);
+            assert_null(rs_uint_nocache.rspoly, "i:%d rs_uint_nocache.rspoly not NULL\n", i);
+
+            zint_rs_uint_init_gf(&rs_uint, data[i].prime_poly);
+            assert_nonzero(zint_rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index),
+                        "i:%d zint_rs_uint_init_code() == 0\n", i);
+            rspoly = rs_uint.rspoly;
+            if (rs_uint.buf == NULL) { /* Cached (unless ZINT_NO_RS_CACHE) */
+                zint_rs_uint_free(&rs_uint);
+                zint_rs_uint_init_gf(&rs_uint, data[i].prime_poly);
+                assert_nonzero(zint_rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index),
+                            "i:%d zint_rs_uint_init_code() == 0 (2nd)\n", i);
+                assert_equal(rs_uint.rspoly, rspoly, "i:%d rs_uint.rspoly %p != %p\n",
+                            i, (const void *) rs_uint.rspoly, (const void *) rspoly);
+                assert_null(rs_uint.buf, "i:%d rs_uint.buf not NULL\n", i);
+            }
+            for (j = 0; j <= data[i].nsym; j++) {
+                assert_nonzero(rs_uint.rspoly[j] < data[i].prime_poly, "i:%d rspoly[%d] %d >= 0x%X\n",
+                            i, j, rs_uint.rspoly[j], data[i].prime_poly);
+                assert_equal(rs_uint.log_rspoly[j], rs_uint.logt[rs_uint.rspoly[j]],
+                            "i:%d log_rspoly[%d] %d != logt %d\n",
+                            i, j, rs_uint.log_rspoly[j], rs_uint.logt[rs_uint.rspoly[j]]);
+            }
+            zint_rs_uint_free(&rs_uint);
+        }
+    }
+
+    testFinish();
+}
+
 static void test_alloc(const testCtx *const p_ctx) {
     int debug = p_ctx->debug;
 
@@ -329,10 +497,8 @@ static void test_alloc(const testCtx *const p_ctx) {
     };
     /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
     static const struct item data[] = {
-        /*  0*/ { BARCODE_AZTEC, 13, "123", ZINT_ERROR_MEMORY, RS_FAIL_ID_LOGT },
-        /*  1*/ { BARCODE_AZTEC, 13, "123", ZINT_ERROR_MEMORY, RS_FAIL_ID_ALOG },
-        /*  2*/ { BARCODE_AZTEC, 27, "123", ZINT_ERROR_MEMORY, RS_FAIL_ID_LOGT },
-        /*  3*/ { BARCODE_AZTEC, 27, "123", ZINT_ERROR_MEMORY, RS_FAIL_ID_ALOG },
+        /*  0*/ { BARCODE_AZTEC, 13, "123", ZINT_ERROR_MEMORY, RS_FAIL_ID_GEN },
+        /*  1*/ { BARCODE_AZTEC, 27, "123", ZINT_ERROR_MEMORY, RS_FAIL_ID_GEN },
     };
     const int data_size = ARRAY_SIZE(data);
     int i, length, ret;
@@ -369,6 +535,8 @@ int main(int argc, char *argv[]) {
         { "test_encoding", test_encoding },
         { "test_encoding_uint", test_encoding_uint },
         { "test_uint_encoding", test_uint_encoding },
+        { "test_kernels", test_kernels },
+        { "test_cache", test_cache },
         { "test_alloc", test_alloc },
     };
 
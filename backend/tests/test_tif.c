@@ -33,6 +33,8 @@
 #include <sys/stat.h>
 
 INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf);
+INTERNAL void zint_test_raster_set_tile_min(const size_t size);
+INTERNAL void zint_test_tif_set_capture(unsigned char *buf, const size_t size);
 
 /* For overview when debugging: ./test_tif -f pixel_plot -d 5 */
 static void test_pixel_plot(const testCtx *const p_ctx) {
@@ -356,6 +358,182 @@ static void test_print(const testCtx *const p_ctx) {
     testFinish();
 }
 
+static void test_print_tiled(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int symbology;
+        int border_width;
+        int output_options;
+        int rotate_angle;
+        float scale;
+        const char *fgcolour;
+        const char *bgcolour;
+        const char *data;
+        const char *expected_file;
+        const char *comment;
+    };
+    static const struct item data[] = {
+        /*  0*/ { BARCODE_QRCODE, -1, -1, 0, 12.0f, "", "", "https://example.com/tiled/output", "qr_tiled_scale12.tif", "4 tiles" },
+        /*  1*/ { BARCODE_QRCODE, 2, BARCODE_BOX, 90, 7.5f, "112233", "FFEEDD", "https://example.com/tiled/output", "qr_tiled_scale7.5_box2_rot90.tif", "Non-half-integer scale" },
+        /*  2*/ { BARCODE_QRCODE, -1, BARCODE_STDOUT, 0, 3.0f, "", "", "https://example.com/tiled/output", "", "Uncompressed" },
+        /*  3*/ { BARCODE_PDF417, 1, BARCODE_BIND, 180, 4.0f, "", "", "PDF417 tiled 0123456789 0123456789 0123456789", "pdf417_tiled_bind1_rot180.tif", "" },
+        /*  4*/ { BARCODE_PDF417, -1, CMYK_COLOUR, 270, 3.0f, "C0000099", "FEDCBACC", "PDF417 tiled 0123456789", "pdf417_tiled_cmyk_fgbgalpha_rot270.tif", "" },
+        /*  5*/ { BARCODE_CODABLOCKF, 2, BARCODE_BIND, 0, 2.0f, "00000099", "FEDCBA", "Codablock F tiled 0123456789 0123456789 0123456789", "codablockf_tiled_bind2_fgalpha.tif", "" },
+        /*  6*/ { BARCODE_ULTRA, 1, BARCODE_BOX, 0, 12.0f, "", "", "ULTRA tiled 123", "ultra_tiled_box1.tif", "" },
+        /*  7*/ { BARCODE_ULTRA, -1, CMYK_COLOUR, 90, 12.0f, "", "", "ULTRA tiled 123", "ultra_tiled_cmyk_rot90.tif", "" },
+        /*  8*/ { BARCODE_CODE128, -1, -1, 0, 2.0f, "", "", "Text", "code128_not_tiled.tif", "HRT so not tiled" },
+    };
+    const int data_size = ARRAY_SIZE(data);
+    int i, length, ret;
+    struct zint_symbol *symbol = NULL;
+
+    const char *data_dir = "/backend/tests/data/tif";
+    const char *tif = "out.tif";
+    char expected_file[1024];
+    char escaped[1024];
+    int escaped_size = 1024;
+    unsigned char filebuf[32768];
+    int filebuf_size;
+    const size_t pixels_size = 0x200000;
+    unsigned char *tiled_pixels, *pixels;
+    int bitmap_width, bitmap_height;
+
+    int have_tiffinfo = testUtilHaveTiffInfo();
+    const char *const have_identify = testUtilHaveIdentify();
+
+    testStartSymbol(p_ctx->func_name, &symbol);
+
+    tiled_pixels = (unsigned char *) malloc(pixels_size * 2);
+    assert_nonnull(tiled_pixels, "malloc(%d) NULL\n", (int) pixels_size * 2);
+    pixels = tiled_pixels + pixels_size;
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        length = testUtilSetSymbol(symbol, data[i].symbology, -1 /*input_mode*/, -1 /*eci*/,
+                                    -1 /*option_1*/, -1 /*option_2*/, -1 /*option_3*/, data[i].output_options,
+                                    data[i].data, -1, debug);
+        symbol->scale = data[i].scale;
+        if (data[i].border_width != -1) {
+            symbol->border_width = data[i].border_width;
+        }
+        if (*data[i].fgcolour) {
+            strcpy(symbol->fgcolour, data[i].fgcolour);
+        }
+        if (*data[i].bgcolour) {
+            strcpy(symbol->bgcolour, data[i].bgcolour);
+        }
+
+        ret = ZBarcode_Encode(symbol, TCU(data[i].data), length);
+        assert_zero(ret, "i:%d %s ZBarcode_Encode ret %d != 0 %s\n",
+                    i, testUtilBarcodeName(data[i].symbology), ret, symbol->errtxt);
+
+        zint_test_raster_set_tile_min(1); /* Tile whenever possible */
+
+        strcpy(symbol->outfile, tif);
+        if (data[i].output_options & BARCODE_STDOUT) {
+            printf("<<<Begin ignore (TIF to stdout)\n"); fflush(stdout);
+        }
+        ret = ZBarcode_Print(symbol, data[i].rotate_angle);
+        if (data[i].output_options & BARCODE_STDOUT) {
+            printf("\n<<<End ignore (TIF to stdout)\n"); fflush(stdout);
+        }
+        assert_zero(ret, "i:%d %s ZBarcode_Print %s ret %d != 0 (%s)\n",
+                    i, testUtilBarcodeName(data[i].symbology), symbol->outfile, ret, symbol->errtxt);
+
+        if (*data[i].expected_file) {
+            assert_nonzero(testUtilDataPath(expected_file, sizeof(expected_file), data_dir, data[i].expected_file),
+                        "i:%d testUtilDataPath == 0\n", i);
+
+            if (p_ctx->generate) {
+                printf("        /*%3d*/ { %s, %d, %s, %d, %.5g, \"%s\", \"%s\", \"%s\", \"%s\", \"%s\" },\n",
+                        i, testUtilBarcodeName(data[i].symbology), data[i].border_width,
+                        testUtilOutputOptionsName(data[i].output_options), data[i].rotate_angle, data[i].scale,
+                        data[i].fgcolour, data[i].bgcolour, testUtilEscape(data[i].data, length, escaped, escaped_size),
+                        data[i].expected_file, data[i].comment);
+                ret = testUtilRename(symbol->outfile, expected_file);
+                assert_zero(ret, "i:%d testUtilRename(%s, %s) ret %d != 0\n", i, symbol->outfile, expected_file, ret);
+                if (have_tiffinfo) {
+                    ret = testUtilVerifyTiffInfo(expected_file, debug);
+                    assert_zero(ret, "i:%d %s tiffinfo %s ret %d != 0\n",
+                                i, testUtilBarcodeName(data[i].symbology), expected_file, ret);
+                } else if (have_identify) {
+                    ret = testUtilVerifyIdentify(have_identify, expected_file, debug);
+                    assert_zero(ret, "i:%d %s identify %s ret %d != 0\n",
+                                i, testUtilBarcodeName(data[i].symbology), expected_file, ret);
+                }
+            } else {
+                assert_nonzero(testUtilExists(symbol->outfile), "i:%d testUtilExists(%s) == 0\n", i, symbol->outfile);
+                assert_nonzero(testUtilExists(expected_file), "i:%d testUtilExists(%s) == 0\n", i, expected_file);
+
+                ret = testUtilCmpBins(symbol->outfile, expected_file);
+                assert_zero(ret, "i:%d %s testUtilCmpBins(%s, %s) %d != 0\n",
+                            i, testUtilBarcodeName(data[i].symbology), symbol->outfile, expected_file, ret);
+
+                /* For BARCODE_MEMORY_FILE */
+                ret = testUtilReadFile(symbol->outfile, filebuf, sizeof(filebuf), &filebuf_size);
+                assert_zero(ret, "i:%d %s testUtilReadFile(%s) %d != 0\n",
+                            i, testUtilBarcodeName(data[i].symbology), symbol->outfile, ret);
+
+                if (!(debug & ZINT_DEBUG_TEST_KEEP_OUTFILE)) {
+                    assert_zero(testUtilRemove(symbol->outfile), "i:%d testUtilRemove(%s) != 0\n",
+                                i, symbol->outfile);
+                }
+
+                symbol->output_options |= BARCODE_MEMORY_FILE;
+                ret = ZBarcode_Print(symbol, data[i].rotate_angle);
+                assert_zero(ret, "i:%d %s ZBarcode_Print %s ret %d != 0 (%s)\n",
+                            i, testUtilBarcodeName(data[i].symbology), symbol->outfile, ret, symbol->errtxt);
+                assert_nonnull(symbol->memfile, "i:%d %s memfile NULL\n",
+                            i, testUtilBarcodeName(data[i].symbology));
+                assert_equal(symbol->memfile_size, filebuf_size, "i:%d %s memfile_size %d != %d\n",
+                            i, testUtilBarcodeName(data[i].symbology), symbol->memfile_size, filebuf_size);
+                assert_zero(memcmp(symbol->memfile, filebuf, symbol->memfile_size),
+                            "i:%d %s memcmp(memfile, filebuf) != 0\n",
+                            i, testUtilBarcodeName(data[i].symbology));
+            }
+        }
+
+        /* Check pixels output tiled same as untiled */
+        symbol->output_options |= BARCODE_MEMORY_FILE; /* Not to disk or stdout */
+        memset(tiled_pixels, 0, pixels_size);
+        zint_test_tif_set_capture(tiled_pixels, pixels_size);
+        ret = ZBarcode_Print(symbol, data[i].rotate_angle);
+        assert_zero(ret, "i:%d %s ZBarcode_Print tiled ret %d != 0 (%s)\n",
+                    i, testUtilBarcodeName(data[i].symbology), ret, symbol->errtxt);
+        bitmap_width = symbol->bitmap_width;
+        bitmap_height = symbol->bitmap_height;
+        assert_nonzero((size_t) bitmap_width * bitmap_height <= pixels_size, "i:%d %s bitmap %dx%d > %d\n",
+                    i, testUtilBarcodeName(data[i].symbology), bitmap_width, bitmap_height, (int) pixels_size);
+
+        zint_test_raster_set_tile_min(0); /* Restore default */
+
+        memset(pixels, 0xFF, pixels_size); /* Differs from `tiled_pixels` if not captured */
+        zint_test_tif_set_capture(pixels, pixels_size);
+        ret = ZBarcode_Print(symbol, data[i].rotate_angle);
+        zint_test_tif_set_capture(NULL, 0);
+        assert_zero(ret, "i:%d %s ZBarcode_Print untiled ret %d != 0 (%s)\n",
+                    i, testUtilBarcodeName(data[i].symbology), ret, symbol->errtxt);
+        assert_equal(symbol->bitmap_width, bitmap_width, "i:%d %s bitmap_width %d != %d\n",
+                    i, testUtilBarcodeName(data[i].symbology), symbol->bitmap_width, bitmap_width);
+        assert_equal(symbol->bitmap_height, bitmap_height, "i:%d %s bitmap_height %d != %d\n",
+                    i, testUtilBarcodeName(data[i].symbology), symbol->bitmap_height, bitmap_height);
+        assert_zero(memcmp(tiled_pixels, pixels, (size_t) bitmap_width * bitmap_height),
+                    "i:%d %s memcmp(tiled_pixels, pixels) != 0\n", i, testUtilBarcodeName(data[i].symbology));
+
+        ZBarcode_Delete(symbol);
+    }
+
+    free(tiled_pixels);
+
+    testFinish();
+}
+
 static void test_outfile(const testCtx *const p_ctx) {
     int ret;
     int skip_readonly_test = 0;
@@ -478,6 +656,7 @@ int main(int argc, char *argv[]) {
     testFunction funcs[] = { /* name, func */
         { "test_pixel_plot", test_pixel_plot },
         { "test_print", test_print },
+        { "test_print_tiled", test_print_tiled },
         { "test_outfile", test_outfile },
         { "test_fm", test_fm },
     };
@@ -0,0 +1,653 @@
+/* Benchmark of encoding and output (not a test) - run "zint_bench -h" for usage */
+/*
+    libzint - the open source barcode library
+    Copyright (C) 2026 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+/* Times `ZBarcode_Encode()`, `ZBarcode_Buffer()`, `ZBarcode_Buffer_Vector()` and `ZBarcode_Print()` (to memory) per
+   output filetype for every symbology with small, medium and maximum capacity inputs, reporting min/median/p99 times
+   and throughput, optionally writing the results as JSON and/or comparing them against a baseline JSON written
+   previously, flagging any regressions beyond a threshold (exit status 1).
+
+   The inputs are generated by repeating a unit of data, the first of mixed text, uppercase alphanumerics or digits
+   that the symbology accepts (or a fixed sample for fixed-format symbologies), the maximum capacity being found by
+   searching for the longest length that encodes. The medium length is the geometric mean of the smallest and
+   largest. */
+
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#include "zint.h"
+
+#define ARRAY_SIZE(x) ((int) (sizeof(x) / sizeof((x)[0])))
+
+#define BENCH_MIN_SAMPLES   5       /* Minimum number of timed samples per case */
+#define BENCH_NAME_SIZE     32      /* Size of names (symbology, op) */
+
+/* Units of data repeated to make inputs, tried in order */
+static const char *const bench_units[] = {
+    "Zint Barcode 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz !#$%&()*+,-./:;<=>?@",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789",
+    "1234567890",
+};
+
+/* Symbologies needing particular input */
+static const struct bench_special {
+    int symbology;
+    int input_mode;
+    const char *primary;    /* Composite linear component */
+    const char *prefix;     /* Prefix before repeated unit, NULL if `fixed` */
+    const char *unit;
+    const char *fixed;      /* Fixed sample (single size) */
+} bench_specials[] = {
+    { BARCODE_GS1_128, GS1_MODE, NULL, "[01]12345678901231[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_EXP, GS1_MODE, NULL, "[01]12345678901231[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_EXPSTK, GS1_MODE, NULL, "[01]12345678901231[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_EANX_CC, GS1_MODE, "331234567890", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_EAN13_CC, GS1_MODE, "331234567890", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_EAN8_CC, GS1_MODE, "1234567", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_UPCA_CC, GS1_MODE, "12345678901", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_UPCE_CC, GS1_MODE, "1234567", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_GS1_128_CC, GS1_MODE, "[01]12345678901231", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_OMN_CC, GS1_MODE, "[01]12345678901231", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_LTD_CC, GS1_MODE, "[01]12345678901231", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_EXP_CC, GS1_MODE, "[01]12345678901231", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_STK_CC, GS1_MODE, "[01]12345678901231", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_OMNSTK_CC, GS1_MODE, "[01]12345678901231", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_DBAR_EXPSTK_CC, GS1_MODE, "[01]12345678901231", "[10]", "ABCDEFGHIJ1234567890", NULL },
+    { BARCODE_AUSPOST, DATA_MODE, NULL, NULL, NULL, "96184209" },
+    { BARCODE_AUSREPLY, DATA_MODE, NULL, NULL, NULL, "12345678" },
+    { BARCODE_AUSROUTE, DATA_MODE, NULL, NULL, NULL, "34567890" },
+    { BARCODE_AUSREDIRECT, DATA_MODE, NULL, NULL, NULL, "98765432" },
+    { BARCODE_CODABAR, DATA_MODE, NULL, NULL, NULL, "A37859B" },
+    { BARCODE_DAFT, DATA_MODE, NULL, NULL, NULL, "DAFTTFADFATDTAFD" },
+    { BARCODE_DPD, DATA_MODE, NULL, NULL, NULL, "%000393206219912345678101040" },
+    { BARCODE_DXFILMEDGE, DATA_MODE, NULL, NULL, NULL, "112-1/10A" },
+    { BARCODE_FIM, DATA_MODE, NULL, NULL, NULL, "A" },
+    { BARCODE_ISBNX, DATA_MODE, NULL, NULL, NULL, "9789295055124" },
+    { BARCODE_JAPANPOST, DATA_MODE, NULL, NULL, NULL, "15400233-16-4-205" },
+    { BARCODE_MAILMARK_2D, DATA_MODE, NULL, "JGB 012100123412345678AB19XY1A 0             ", NULL, NULL },
+    { BARCODE_MAILMARK_4S, DATA_MODE, NULL, NULL, NULL, "01000000000000000AA00AA0A" },
+    { BARCODE_UPU_S10, DATA_MODE, NULL, NULL, NULL, "EE876543216CA" },
+    { BARCODE_UPCE_CHK, DATA_MODE, NULL, NULL, NULL, "01234565" },
+    { BARCODE_USPS_IMAIL, DATA_MODE, NULL, NULL, NULL, "01234567094987654321" },
+    { BARCODE_VIN, DATA_MODE, NULL, NULL, NULL, "2FTPX28L0XCA15511" },
+};
+
+/* Sizes of input */
+static const char bench_sizes[3][8] = { "small", "medium", "max" };
+
+/* Output filetypes for `ZBarcode_Print()` */
+static const char bench_filetypes[][4] = {
+    "bmp", "emf", "eps", "gif", "pbm", "pcx", "pdf", "png", "pos", "svg", "tif", "txt", "zmm", "zpl"
+};
+
+/* Operations timed */
+enum { BENCH_ENCODE, BENCH_BUFFER, BENCH_VECTOR, BENCH_PRINT };
+static const char bench_ops[4][8] = { "encode", "buffer", "vector", "print" };
+
+/* Settings from the command line */
+struct bench_opts {
+    const char *symbologies;    /* Comma-separated list, NULL for all */
+    const char *filetypes;      /* Comma-separated list, NULL for all */
+    const char *sizes;          /* Comma-separated list, NULL for all */
+    const char *ops;            /* Comma-separated list, NULL for all */
+    double time_ns;             /* Time budget per case */
+    int warmup;                 /* Untimed iterations per case */
+    int max_samples;
+    const char *outfile;        /* JSON output */
+    const char *baseline;       /* JSON to compare against */
+    double threshold;           /* Regression threshold percentage */
+    int quiet;
+};
+
+/* A result, as written to & read from JSON */
+struct bench_result {
+    char symbology[BENCH_NAME_SIZE];
+    char size[8];
+    char op[BENCH_NAME_SIZE];
+    int length;
+    int samples;
+    double min_ns;
+    double median_ns;
+    double p99_ns;
+    double bytes;               /* Input length for encode/vector, bitmap size for buffer, file length for print */
+};
+
+/* Results accumulated */
+struct bench_results {
+    struct bench_result *results;
+    int count;
+    int size;
+};
+
+/* Current time in nanoseconds from an arbitrary base */
+static double bench_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart * 1e9 / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1e9 + (double) ts.tv_nsec;
+#endif
+}
+
+/* Whether `name` is in comma-separated `list` (case-insensitive), or `list` NULL */
+static int bench_in_list(const char *list, const char *name) {
+    const size_t len = strlen(name);
+
+    if (!list) {
+        return 1;
+    }
+    while (*list) {
+        const char *const comma = strchr(list, ',');
+        const size_t item_len = comma ? (size_t) (comma - list) : strlen(list);
+        size_t i;
+        for (i = 0; i < len && i < item_len && (name[i] | 0x20) == (list[i] | 0x20); i++);
+        if (i == len && i == item_len) {
+            return 1;
+        }
+        if (!comma) {
+            break;
+        }
+        list = comma + 1;
+    }
+    return 0;
+}
+
+/* Whether `symbology` named `name` (without "BARCODE_" prefix) is selected by comma-separated `list` of names or
+   numbers */
+static int bench_symbology_in_list(const char *list, const int symbology, const char *name) {
+    char number[12];
+
+    if (bench_in_list(list, name)) {
+        return 1;
+    }
+    sprintf(number, "%d", symbology);
+    return bench_in_list(list, number);
+}
+
+/* Fill `buf` with `length` characters of `prefix` followed by `unit` repeated, NUL-terminated */
+static void bench_data(char *buf, const int length, const char *prefix, const char *unit) {
+    const int prefix_len = (int) strlen(prefix);
+    const int unit_len = (int) strlen(unit);
+    int i;
+
+    for (i = 0; i < length && i < prefix_len; i++) {
+        buf[i] = prefix[i];
+    }
+    for (; i < length; i++) {
+        buf[i] = unit[(i - prefix_len) % unit_len];
+    }
+    buf[length] = '\0';
+}
+
+/* Set `symbol` for `symbology` & `special` (if any) */
+static void bench_set_symbol(struct zint_symbol *symbol, const int symbology,
+            const struct bench_special *const special) {
+    ZBarcode_Reset(symbol);
+    symbol->symbology = symbology;
+    symbol->input_mode = special ? special->input_mode : DATA_MODE;
+    if (special && special->primary) {
+        strcpy(symbol->primary, special->primary);
+    }
+}
+
+/* Whether `length` of generated data encodes */
+static int bench_valid(struct zint_symbol *symbol, const int symbology, const struct bench_special *const special,
+            char *buf, const int length, const char *prefix, const char *unit) {
+    bench_set_symbol(symbol, symbology, special);
+    bench_data(buf, length, prefix, unit);
+    return ZBarcode_Encode(symbol, (const unsigned char *) buf, length) < ZINT_ERROR;
+}
+
+/* Find the smallest, medium and largest lengths of generated data that encode, returning the unit used or NULL if
+   none */
+static const char *bench_lengths(struct zint_symbol *symbol, const int symbology,
+            const struct bench_special *const special, char *buf, int lengths[3]) {
+    const char *const prefix = special && special->prefix ? special->prefix : "";
+    const int prefix_len = (int) strlen(prefix);
+    int u, lo, hi, mid;
+
+    for (u = 0; u < ARRAY_SIZE(bench_units); u++) {
+        const char *const unit = special && special->unit ? special->unit : bench_units[u];
+
+        for (lo = prefix_len ? prefix_len : 1; lo <= prefix_len + 64
+                && !bench_valid(symbol, symbology, special, buf, lo, prefix, unit); lo++);
+        if (lo <= prefix_len + 64) {
+            lengths[0] = lo;
+            /* Double while valid then binary search for the largest */
+            for (hi = lo * 2; hi <= ZINT_MAX_DATA_LEN && bench_valid(symbol, symbology, special, buf, hi, prefix,
+                                                                    unit); hi *= 2) {
+                lo = hi;
+            }
+            if (hi > ZINT_MAX_DATA_LEN) {
+                hi = ZINT_MAX_DATA_LEN + 1;
+            }
+            while (hi - lo > 1) {
+                mid = lo + (hi - lo) / 2;
+                if (bench_valid(symbol, symbology, special, buf, mid, prefix, unit)) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            lengths[2] = lo;
+            for (mid = (int) sqrt((double) lengths[0] * lengths[2]); mid > lengths[0]
+                    && !bench_valid(symbol, symbology, special, buf, mid, prefix, unit); mid--);
+            lengths[1] = mid;
+            return unit;
+        }
+        if (special && special->unit) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/* Compare doubles for `qsort()` */
+static int bench_cmp(const void *a, const void *b) {
+    const double da = *(const double *) a, db = *(const double *) b;
+    return da < db ? -1 : da > db;
+}
+
+/* Add result, returning 0 if memory allocation fails */
+static int bench_add(struct bench_results *const results, const struct bench_result *const result) {
+    if (results->count == results->size) {
+        const int new_size = results->size ? results->size * 2 : 256;
+        struct bench_result *const new_results = (struct bench_result *) realloc(results->results,
+                                                        sizeof(struct bench_result) * new_size);
+        if (!new_results) {
+            return 0;
+        }
+        results->results = new_results;
+        results->size = new_size;
+    }
+    results->results[results->count++] = *result;
+    return 1;
+}
+
+/* Time `op` (with `ext` if print) on `symbol` encoding `buf` of `length`, storing in `result`. Returns 0 on failure
+   (error message in `symbol->errtxt`) */
+static int bench_case(struct zint_symbol *symbol, const struct bench_opts *const opts, const int op,
+            const char *ext, const char *buf, const int length, double *samples, struct bench_result *result) {
+    const int option_1 = symbol->option_1, option_2 = symbol->option_2, option_3 = symbol->option_3;
+    double start, t0, t1;
+    int cnt = 0, i, ret;
+
+    if (op != BENCH_ENCODE) {
+        if (ZBarcode_Encode(symbol, (const unsigned char *) buf, length) >= ZINT_ERROR) {
+            return 0;
+        }
+        if (op == BENCH_PRINT) {
+            symbol->output_options |= BARCODE_MEMORY_FILE;
+            sprintf(symbol->outfile, "bench.%s", ext);
+        }
+    }
+    start = bench_now();
+    for (i = 0; ; i++) {
+        if (op == BENCH_ENCODE) {
+            ZBarcode_Clear(symbol);
+            symbol->option_1 = option_1; /* Undo any feedback */
+            symbol->option_2 = option_2;
+            symbol->option_3 = option_3;
+        }
+        t0 = bench_now();
+        switch (op) {
+            case BENCH_ENCODE:
+                ret = ZBarcode_Encode(symbol, (const unsigned char *) buf, length);
+                break;
+            case BENCH_BUFFER:
+                ret = ZBarcode_Buffer(symbol, 0 /*rotate_angle*/);
+                break;
+            case BENCH_VECTOR:
+                ret = ZBarcode_Buffer_Vector(symbol, 0 /*rotate_angle*/);
+                break;
+            default:
+                ret = ZBarcode_Print(symbol, 0 /*rotate_angle*/);
+                break;
+        }
+        t1 = bench_now();
+        if (ret >= ZINT_ERROR) {
+            return 0;
+        }
+        if (i >= opts->warmup) {
+            samples[cnt++] = t1 - t0;
+            if (cnt == opts->max_samples || (cnt >= BENCH_MIN_SAMPLES && t1 - start >= opts->time_ns)) {
+                break;
+            }
+        }
+    }
+    qsort(samples, cnt, sizeof(double), bench_cmp);
+
+    result->length = length;
+    result->samples = cnt;
+    result->min_ns = samples[0];
+    result->median_ns = samples[cnt / 2];
+    result->p99_ns = samples[(cnt * 99 + 99) / 100 - 1];
+    if (op == BENCH_BUFFER) {
+        result->bytes = (double) symbol->bitmap_width * symbol->bitmap_height * 3;
+    } else if (op == BENCH_PRINT) {
+        result->bytes = symbol->memfile_size;
+    } else {
+        result->bytes = length;
+    }
+    return 1;
+}
+
+/* Print header of results table */
+static void bench_print_header(void) {
+    printf("%-16s %-6s %6s %-9s %7s %11s %11s %11s %11s %9s\n", "symbology", "size", "length", "op", "samples",
+            "min ns", "median ns", "p99 ns", "symbols/s", "MB/s");
+}
+
+/* Print `result` as row of results table */
+static void bench_print(const struct bench_result *const result) {
+    printf("%-16s %-6s %6d %-9s %7d %11.0f %11.0f %11.0f %11.1f %9.2f\n", result->symbology, result->size,
+            result->length, result->op, result->samples, result->min_ns, result->median_ns, result->p99_ns,
+            1e9 / result->median_ns, result->bytes * 1e3 / result->median_ns);
+    fflush(stdout);
+}
+
+/* Run the benchmarks selected by `opts`, adding to `results`. Returns 0 on failure */
+static int bench_run(const struct bench_opts *const opts, struct bench_results *const results) {
+    struct zint_symbol *symbol = ZBarcode_Create();
+    char *buf = (char *) malloc(ZINT_MAX_DATA_LEN + 2);
+    double *samples = (double *) malloc(sizeof(double) * (opts->warmup + opts->max_samples));
+    char name[32];
+    int symbology, s, j, k, op;
+
+    if (!symbol || !buf || !samples) {
+        fprintf(stderr, "zint_bench: insufficient memory\n");
+        ZBarcode_Delete(symbol);
+        free(buf);
+        free(samples);
+        return 0;
+    }
+    if (!opts->quiet) {
+        bench_print_header();
+    }
+    for (symbology = 1; symbology <= BARCODE_LAST; symbology++) {
+        const struct bench_special *special = NULL;
+        const char *unit = NULL, *prefix = "";
+        int lengths[3];
+
+        if (ZBarcode_BarcodeName(symbology, name) || !bench_symbology_in_list(opts->symbologies, symbology,
+                                                                                name + 8)) {
+            continue;
+        }
+        for (j = 0; j < ARRAY_SIZE(bench_specials); j++) {
+            if (bench_specials[j].symbology == symbology) {
+                special = bench_specials + j;
+                break;
+            }
+        }
+        if (special && special->fixed) {
+            lengths[0] = lengths[1] = lengths[2] = (int) strlen(special->fixed);
+        } else if ((unit = bench_lengths(symbol, symbology, special, buf, lengths))) {
+            prefix = special && special->prefix ? special->prefix : "";
+        } else {
+            fprintf(stderr, "zint_bench: no input found for %s, skipping\n", name + 8);
+            continue;
+        }
+        for (s = 0; s < 3; s++) {
+            struct bench_result result;
+
+            if (!bench_in_list(opts->sizes, bench_sizes[s]) || (s && lengths[s] == lengths[s - 1])) {
+                continue;
+            }
+            if (unit) {
+                bench_data(buf, lengths[s], prefix, unit);
+            } else {
+                strcpy(buf, special->fixed);
+            }
+            memset(&result, 0, sizeof(result));
+            strcpy(result.symbology, name + 8);
+            strcpy(result.size, bench_sizes[s]);
+            for (op = BENCH_ENCODE; op <= BENCH_PRINT; op++) {
+                if (!bench_in_list(opts->ops, bench_ops[op])) {
+                    continue;
+                }
+                for (k = 0; k < (op == BENCH_PRINT ? ARRAY_SIZE(bench_filetypes) : 1); k++) {
+                    if (op == BENCH_PRINT) {
+                        if (!bench_in_list(opts->filetypes, bench_filetypes[k])
+                                || (ZBarcode_NoPng() && strcmp(bench_filetypes[k], "png") == 0)) {
+                            continue;
+                        }
+                        sprintf(result.op, "print.%s", bench_filetypes[k]);
+                    } else {
+                        strcpy(result.op, bench_ops[op]);
+                    }
+                    bench_set_symbol(symbol, symbology, special);
+                    if (!bench_case(symbol, opts, op, bench_filetypes[k], buf, lengths[s], samples, &result)) {
+                        fprintf(stderr, "zint_bench: %s %s %s failed: %s\n", result.symbology, result.size,
+                                result.op, symbol->errtxt);
+                        continue;
+                    }
+                    if (!bench_add(results, &result)) {
+                        fprintf(stderr, "zint_bench: insufficient memory\n");
+                        ZBarcode_Delete(symbol);
+                        free(buf);
+                        free(samples);
+                        return 0;
+                    }
+                    if (!opts->quiet) {
+                        bench_print(&result);
+                    }
+                }
+            }
+        }
+    }
+    ZBarcode_Delete(symbol);
+    free(buf);
+    free(samples);
+    return 1;
+}
+
+/* Write `results` to `filename` as JSON, one result per line. Returns 0 on failure */
+static int bench_write_json(const char *filename, const struct bench_results *const results) {
+    FILE *fp = fopen(filename, "w");
+    int i;
+
+    if (!fp) {
+        fprintf(stderr, "zint_bench: unable to open '%s' for writing\n", filename);
+        return 0;
+    }
+    fprintf(fp, "{\n\"zint_version\": %d,\n\"results\": [\n", ZBarcode_Version());
+    for (i = 0; i < results->count; i++) {
+        const struct bench_result *const r = results->results + i;
+        fprintf(fp, "{\"symbology\":\"%s\",\"size\":\"%s\",\"op\":\"%s\",\"length\":%d,\"samples\":%d,"
+                "\"min_ns\":%.0f,\"median_ns\":%.0f,\"p99_ns\":%.0f,\"bytes\":%.0f,\"symbols_per_s\":%.1f,"
+                "\"mb_per_s\":%.3f}%s\n", r->symbology, r->size, r->op, r->length, r->samples, r->min_ns,
+                r->median_ns, r->p99_ns, r->bytes, 1e9 / r->median_ns, r->bytes * 1e3 / r->median_ns,
+                i + 1 < results->count ? "," : "");
+    }
+    fputs("]\n}\n", fp);
+    if (ferror(fp) | fclose(fp)) {
+        fprintf(stderr, "zint_bench: failure writing '%s'\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+/* Read results written by `bench_write_json()` from `filename` into `results`. Returns 0 on failure */
+static int bench_read_json(const char *filename, struct bench_results *const results) {
+    FILE *fp = fopen(filename, "r");
+    char line[1024];
+
+    if (!fp) {
+        fprintf(stderr, "zint_bench: unable to open baseline '%s'\n", filename);
+        return 0;
+    }
+    while (fgets(line, sizeof(line), fp)) {
+        struct bench_result r;
+        memset(&r, 0, sizeof(r));
+        if (sscanf(line, "{\"symbology\":\"%31[^\"]\",\"size\":\"%7[^\"]\",\"op\":\"%31[^\"]\",\"length\":%d,"
+                    "\"samples\":%d,\"min_ns\":%lf,\"median_ns\":%lf,\"p99_ns\":%lf,\"bytes\":%lf", r.symbology,
+                    r.size, r.op, &r.length, &r.samples, &r.min_ns, &r.median_ns, &r.p99_ns, &r.bytes) == 9) {
+            if (!bench_add(results, &r)) {
+                fprintf(stderr, "zint_bench: insufficient memory\n");
+                (void) fclose(fp);
+                return 0;
+            }
+        }
+    }
+    (void) fclose(fp);
+    if (!results->count) {
+        fprintf(stderr, "zint_bench: no results in baseline '%s'\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+/* Compare median times of `results` against `baseline`, printing any regressions beyond `threshold` percent.
+   Returns number of regressions */
+static int bench_compare(const struct bench_results *const results, const struct bench_results *const baseline,
+            const double threshold) {
+    int regressions = 0, improvements = 0, compared = 0;
+    int i, j;
+
+    for (i = 0; i < results->count; i++) {
+        const struct bench_result *const r = results->results + i;
+        for (j = 0; j < baseline->count; j++) {
+            const struct bench_result *const b = baseline->results + j;
+            if (strcmp(r->symbology, b->symbology) == 0 && strcmp(r->size, b->size) == 0
+                    && strcmp(r->op, b->op) == 0) {
+                const double change = (r->median_ns - b->median_ns) * 100.0 / b->median_ns;
+                if (r->length != b->length) {
+                    printf("LENGTH CHANGED %s %s %s: %d -> %d (not compared)\n", r->symbology, r->size, r->op,
+                            b->length, r->length);
+                    break;
+                }
+                compared++;
+                if (change > threshold) {
+                    printf("REGRESSION %s %s %s: median %.0f ns -> %.0f ns (%+.1f%%)\n", r->symbology, r->size,
+                            r->op, b->median_ns, r->median_ns, change);
+                    regressions++;
+                } else if (change < -threshold) {
+                    improvements++;
+                }
+                break;
+            }
+        }
+    }
+    printf("Compared %d of %d results: %d regressions, %d improvements (threshold %g%%)\n", compared,
+            results->count, regressions, improvements, threshold);
+    return regressions;
+}
+
+static void usage(void) {
+    printf("Usage: zint_bench [OPTIONS]\n"
+           "  -b LIST     Symbologies (names without \"BARCODE_\" or numbers), comma-separated (default all)\n"
+           "  -c FILE     Compare against baseline JSON FILE, exit status 1 if any regressions\n"
+           "  -f LIST     Filetypes for print, comma-separated (default all)\n"
+           "  -h          Display this help\n"
+           "  -n INTEGER  Maximum timed samples per case (default 100000)\n"
+           "  -o FILE     Write results as JSON to FILE\n"
+           "  -p LIST     Ops \"encode\", \"buffer\", \"vector\", \"print\", comma-separated (default all)\n"
+           "  -q          Quiet - don't print results table\n"
+           "  -r NUMBER   Regression threshold percentage of median time for \"-c\" (default 10)\n"
+           "  -s LIST     Sizes \"small\", \"medium\", \"max\", comma-separated (default all)\n"
+           "  -t NUMBER   Time budget per case in milliseconds (default 20)\n"
+           "  -w INTEGER  Untimed warmup iterations per case (default 3)\n");
+}
+
+int main(int argc, char *argv[]) {
+    struct bench_opts opts;
+    struct bench_results results = {0}, baseline = {0};
+    int ret = 0;
+    int i;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.time_ns = 20 * 1e6;
+    opts.warmup = 3;
+    opts.max_samples = 100000;
+    opts.threshold = 10.0;
+
+    for (i = 1; i < argc; i++) {
+        const char *const arg = argv[i];
+        const char *const val = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "-h") == 0) {
+            usage();
+            return 0;
+        }
+        if (strcmp(arg, "-q") == 0) {
+            opts.quiet = 1;
+            continue;
+        }
+        if (arg[0] != '-' || !arg[1] || arg[2] || !val || !strchr("bcfnoprstw", arg[1])) {
+            fprintf(stderr, "zint_bench: invalid option '%s' (\"-h\" for help)\n", arg);
+            return 2;
+        }
+        switch (arg[1]) {
+            case 'b': opts.symbologies = val; break;
+            case 'c': opts.baseline = val; break;
+            case 'f': opts.filetypes = val; break;
+            case 'n': opts.max_samples = atoi(val); break;
+            case 'o': opts.outfile = val; break;
+            case 'p': opts.ops = val; break;
+            case 'r': opts.threshold = atof(val); break;
+            case 's': opts.sizes = val; break;
+            case 't': opts.time_ns = atof(val) * 1e6; break;
+            case 'w': opts.warmup = atoi(val); break;
+        }
+        i++;
+    }
+    if (opts.max_samples < BENCH_MIN_SAMPLES || opts.max_samples > INT_MAX / 2 || opts.warmup < 0
+            || opts.warmup > INT_MAX / 2 || opts.time_ns < 0.0 || opts.threshold < 0.0) {
+        fprintf(stderr, "zint_bench: invalid value (\"-h\" for help)\n");
+        return 2;
+    }
+    if (opts.baseline && !bench_read_json(opts.baseline, &baseline)) {
+        return 2;
+    }
+
+    if (!bench_run(&opts, &results) || (opts.outfile && !bench_write_json(opts.outfile, &results))) {
+        ret = 2;
+    } else if (opts.baseline && bench_compare(&results, &baseline, opts.threshold)) {
+        ret = 1;
+    }
+
+    free(results.results);
+    free(baseline.results);
+
+    return ret;
+}
+
+/* vim: set ts=4 sw=4 et : */
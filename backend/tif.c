@@ -50,6 +50,55 @@
 #define TIF_NO_COMPRESSION      1
 #define TIF_LZW                 5
 
+/* Width & length of tiles, must be a multiple of 16 (TIFF Rev 6 Section 15 p.67) */
+#define TIF_TILE_SIZE           512
+
+#ifdef ZINT_TEST
+/* For testing tiled output against untiled - pixels output are copied to `tif_capture_buf` if set */
+
+static unsigned char *tif_capture_buf = NULL;
+static size_t tif_capture_size = 0;
+
+INTERNAL void zint_test_tif_set_capture(unsigned char *buf, const size_t size) {
+    tif_capture_buf = buf;
+    tif_capture_size = size;
+}
+
+/* Copy `width` x `height` pixels `pixels` (row length `stride`) to `tif_capture_buf` at (`x`, `y`), rows being
+   `symbol->bitmap_width` long */
+static void tif_capture(const struct zint_symbol *symbol, const int x, const int y, const int width,
+                const int height, const int stride, const unsigned char *pixels) {
+    int row;
+
+    if (!tif_capture_buf || (size_t) symbol->bitmap_width * symbol->bitmap_height > tif_capture_size) {
+        return;
+    }
+    for (row = 0; row < height; row++) {
+        memcpy(tif_capture_buf + (size_t) symbol->bitmap_width * (y + row) + x, pixels + (size_t) stride * row,
+                width);
+    }
+}
+#else
+#define tif_capture(symbol, x, y, width, height, stride, pixels)
+#endif
+
+struct zint_raster_tiler;
+INTERNAL void zint_raster_tile(const struct zint_raster_tiler *tiler, const int x, const int y, const int width,
+                const int height, const int stride, unsigned char *buf);
+
+/* Colour mapping & sample layout */
+struct tif_colours {
+    tiff_color_t color_map[256];
+    unsigned char map[128];
+    unsigned char palette[32][5];
+    int pmi; /* PhotometricInterpretation */
+    uint16_t bits_per_sample;
+    int samples_per_pixel;
+    int pixels_per_sample;
+    int color_map_size;
+    int extra_samples;
+};
+
 static void tif_to_color_map(const unsigned char rgb[4], tiff_color_t *color_map_entry) {
     color_map_entry->red = (rgb[0] << 8) | rgb[0];
     color_map_entry->green = (rgb[1] << 8) | rgb[1];
@@ -105,11 +154,12 @@ static int tif_lzw_putCode(struct filemem *fmp, const int code, const int bitsPe
 */
 /* Copyright (C) 1988 Bob Montgomery */
 static int tif_lzw_compress(struct filemem *fmp, const unsigned char *bp, const unsigned int blen) {
-    short suffixes[TIF_LZW_TABLE_SIZE] = {0}; /* "shade[]" in Montgomery diagram */
+    Z_SCRATCH_MARK(scratch_mark); /* Called for each strip/tile */
+    Z_LARGE_ARRAY(short, suffixes, TIF_LZW_TABLE_SIZE); /* "shade[]" in Montgomery diagram */
     /* A child is made up of a parent (or prefix) code plus a suffix byte
        and siblings are strings with a common parent (or prefix) and different suffix bytes */
-    short children[TIF_LZW_TABLE_SIZE] = {0}; /* "child[]" in Montgomery diagram */
-    short siblings[TIF_LZW_TABLE_SIZE] = {0}; /* "sib[]" in Montgomery diagram */
+    Z_LARGE_ARRAY(short, children, TIF_LZW_TABLE_SIZE); /* "child[]" in Montgomery diagram */
+    Z_LARGE_ARRAY(short, siblings, TIF_LZW_TABLE_SIZE); /* "sib[]" in Montgomery diagram */
 
     int parent;
     int bitsPerCode = TIF_LZW_MIN_BITS; /* "codesize" in Montgomery diagram, goes from 9 to 12 */
@@ -123,6 +173,14 @@ static int tif_lzw_compress(struct filemem *fmp, const unsigned char *bp, const
 
     assert(blen != 0);
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
+    memset(suffixes, 0, sizeof(short) * TIF_LZW_TABLE_SIZE);
+    memset(children, 0, sizeof(short) * TIF_LZW_TABLE_SIZE);
+    memset(siblings, 0, sizeof(short) * TIF_LZW_TABLE_SIZE);
+
     /* Init */
     bytes_put = tif_lzw_putCode(fmp, TIF_LZW_CLEAR_CODE & maxCode, bitsPerCode, &bits, bytes_put);
     parent = *bp++; /* Parent is 1st code */
@@ -194,48 +252,16 @@ update_child:
         bytes_put++;
     }
 
+    Z_SCRATCH_RELEASE(scratch_mark);
     return bytes_put;
 }
 
-/* TIFF Revision 6.0 https://www.adobe.io/content/dam/udp/en/open/standards/tiff/TIFF6.pdf */
-INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf) {
+/* Set up colour mapping & sample layout shared by strip & tile output */
+static void tif_colours(const struct zint_symbol *symbol, struct tif_colours *c) {
     unsigned char fg[4], bg[4];
     int i;
-    int pmi; /* PhotometricInterpretation */
-    int rows_per_strip, strip_count;
-    int rows_last_strip;
-    int bytes_per_strip;
-    uint16_t bits_per_sample;
-    int samples_per_pixel;
-    int pixels_per_sample;
-    unsigned char map[128];
-    tiff_color_t color_map[256] = {{0}};
-    unsigned char palette[32][5];
-    int color_map_size = 0;
-    int extra_samples = 0;
-    size_t free_memory;
-    int row, column, strip;
-    int strip_row;
-    unsigned int bytes_put;
-    long total_bytes_put;
-    struct filemem fm;
-    struct filemem *const fmp = &fm;
-    const unsigned char *pb;
-    int compression = TIF_NO_COMPRESSION;
-    const int output_to_stdout = symbol->output_options & BARCODE_STDOUT;
-    uint32_t *strip_offset;
-    uint32_t *strip_bytes;
-    unsigned char *strip_buf;
 
-    tiff_header_t header;
-    uint16_t entries = 0;
-    tiff_tag_t tags[20];
-    uint32_t offset = 0;
-    int update_offsets[20];
-    int offsets = 0;
-    int ifd_size;
-    uint32_t temp32;
-    uint16_t temp16;
+    memset(c, 0, sizeof(*c));
 
     (void) zint_out_colour_get_rgb(symbol->fgcolour, &fg[0], &fg[1], &fg[2], &fg[3]);
     (void) zint_out_colour_get_rgb(symbol->bgcolour, &bg[0], &bg[1], &bg[2], &bg[3]);
@@ -255,24 +281,24 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
                 {    0,    0,    0, 0xFF }, /* Black */
             };
             for (i = 0; i < 8; i++) {
-                map[ultra_chars[i]] = i;
-                memcpy(palette[i], ultra_cmyks[i], 4);
-                palette[i][4] = fg[3];
+                c->map[ultra_chars[i]] = i;
+                memcpy(c->palette[i], ultra_cmyks[i], 4);
+                c->palette[i][4] = fg[3];
             }
-            map['0'] = 8;
-            tif_to_cmyk(symbol->bgcolour, palette[8]);
-            map['1'] = 9;
-            tif_to_cmyk(symbol->fgcolour, palette[9]);
+            c->map['0'] = 8;
+            tif_to_cmyk(symbol->bgcolour, c->palette[8]);
+            c->map['1'] = 9;
+            tif_to_cmyk(symbol->fgcolour, c->palette[9]);
 
-            pmi = TIF_PMI_SEPARATED;
-            bits_per_sample = 8;
+            c->pmi = TIF_PMI_SEPARATED;
+            c->bits_per_sample = 8;
             if (fg[3] == 0xff && bg[3] == 0xff) { /* If no alpha */
-                samples_per_pixel = 4;
+                c->samples_per_pixel = 4;
             } else {
-                samples_per_pixel = 5;
-                extra_samples = 1; /* Associated alpha */
+                c->samples_per_pixel = 5;
+                c->extra_samples = 1; /* Associated alpha */
             }
-            pixels_per_sample = 1;
+            c->pixels_per_sample = 1;
         } else {
             static const unsigned char ultra_rgbs[8][3] = {
                 { 0xff, 0xff, 0xff, }, /* White */
@@ -285,95 +311,204 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
                 {    0,    0,    0, }, /* Black */
             };
             for (i = 0; i < 8; i++) {
-                map[ultra_chars[i]] = i;
-                memcpy(palette[i], ultra_rgbs[i], 3);
-                palette[i][3] = fg[3];
+                c->map[ultra_chars[i]] = i;
+                memcpy(c->palette[i], ultra_rgbs[i], 3);
+                c->palette[i][3] = fg[3];
             }
-            map['0'] = 8;
-            memcpy(palette[8], bg, 4);
-            map['1'] = 9;
-            memcpy(palette[9], fg, 4);
+            c->map['0'] = 8;
+            memcpy(c->palette[8], bg, 4);
+            c->map['1'] = 9;
+            memcpy(c->palette[9], fg, 4);
 
             if (fg[3] == 0xff && bg[3] == 0xff) { /* If no alpha */
-                pmi = TIF_PMI_PALETTE_COLOR;
+                c->pmi = TIF_PMI_PALETTE_COLOR;
                 for (i = 0; i < 10; i++) {
-                    tif_to_color_map(palette[i], &color_map[i]);
+                    tif_to_color_map(c->palette[i], &c->color_map[i]);
                 }
-                bits_per_sample = 4;
-                samples_per_pixel = 1;
-                pixels_per_sample = 2;
-                color_map_size = 16; /* 2**BitsPerSample */
+                c->bits_per_sample = 4;
+                c->samples_per_pixel = 1;
+                c->pixels_per_sample = 2;
+                c->color_map_size = 16; /* 2**BitsPerSample */
             } else {
-                pmi = TIF_PMI_RGB;
-                bits_per_sample = 8;
-                samples_per_pixel = 4;
-                pixels_per_sample = 1;
-                extra_samples = 1; /* Associated alpha */
+                c->pmi = TIF_PMI_RGB;
+                c->bits_per_sample = 8;
+                c->samples_per_pixel = 4;
+                c->pixels_per_sample = 1;
+                c->extra_samples = 1; /* Associated alpha */
             }
         }
     } else { /* fg/bg only */
         if (symbol->output_options & CMYK_COLOUR) {
-            map['0'] = 0;
-            tif_to_cmyk(symbol->bgcolour, palette[0]);
-            map['1'] = 1;
-            tif_to_cmyk(symbol->fgcolour, palette[1]);
+            c->map['0'] = 0;
+            tif_to_cmyk(symbol->bgcolour, c->palette[0]);
+            c->map['1'] = 1;
+            tif_to_cmyk(symbol->fgcolour, c->palette[1]);
 
-            pmi = TIF_PMI_SEPARATED;
-            bits_per_sample = 8;
+            c->pmi = TIF_PMI_SEPARATED;
+            c->bits_per_sample = 8;
             if (fg[3] == 0xff && bg[3] == 0xff) { /* If no alpha */
-                samples_per_pixel = 4;
+                c->samples_per_pixel = 4;
             } else {
-                samples_per_pixel = 5;
-                extra_samples = 1; /* Associated alpha */
+                c->samples_per_pixel = 5;
+                c->extra_samples = 1; /* Associated alpha */
             }
-            pixels_per_sample = 1;
+            c->pixels_per_sample = 1;
         } else if (bg[0] == 0xff && bg[1] == 0xff && bg[2] == 0xff && bg[3] == 0xff
                     && fg[0] == 0 && fg[1] == 0 && fg[2] == 0 && fg[3] == 0xff) {
-            map['0'] = 0;
-            map['1'] = 1;
+            c->map['0'] = 0;
+            c->map['1'] = 1;
 
-            pmi = TIF_PMI_WHITEISZERO;
-            bits_per_sample = 1;
-            samples_per_pixel = 1;
-            pixels_per_sample = 8;
+            c->pmi = TIF_PMI_WHITEISZERO;
+            c->bits_per_sample = 1;
+            c->samples_per_pixel = 1;
+            c->pixels_per_sample = 8;
         } else if (bg[0] == 0 && bg[1] == 0 && bg[2] == 0 && bg[3] == 0xff
                 && fg[0] == 0xff && fg[1] == 0xff && fg[2] == 0xff && fg[3] == 0xff) {
-            map['0'] = 0;
-            map['1'] = 1;
+            c->map['0'] = 0;
+            c->map['1'] = 1;
 
-            pmi = TIF_PMI_BLACKISZERO;
-            bits_per_sample = 1;
-            samples_per_pixel = 1;
-            pixels_per_sample = 8;
+            c->pmi = TIF_PMI_BLACKISZERO;
+            c->bits_per_sample = 1;
+            c->samples_per_pixel = 1;
+            c->pixels_per_sample = 8;
         } else {
-            map['0'] = 0;
-            memcpy(palette[0], bg, 4);
-            map['1'] = 1;
-            memcpy(palette[1], fg, 4);
+            c->map['0'] = 0;
+            memcpy(c->palette[0], bg, 4);
+            c->map['1'] = 1;
+            memcpy(c->palette[1], fg, 4);
 
-            pmi = TIF_PMI_PALETTE_COLOR;
+            c->pmi = TIF_PMI_PALETTE_COLOR;
             for (i = 0; i < 2; i++) {
-                tif_to_color_map(palette[i], &color_map[i]);
+                tif_to_color_map(c->palette[i], &c->color_map[i]);
             }
             if (fg[3] == 0xff && bg[3] == 0xff) { /* If no alpha */
-                bits_per_sample = 4;
-                samples_per_pixel = 1;
-                pixels_per_sample = 2;
-                color_map_size = 16; /* 2**BitsPerSample */
+                c->bits_per_sample = 4;
+                c->samples_per_pixel = 1;
+                c->pixels_per_sample = 2;
+                c->color_map_size = 16; /* 2**BitsPerSample */
+            } else {
+                c->bits_per_sample = 8;
+                c->samples_per_pixel = 2;
+                c->pixels_per_sample = 1;
+                c->color_map_size = 256; /* 2**BitsPerSample */
+                c->extra_samples = 1; /* Associated alpha */
+            }
+        }
+    }
+}
+
+/* Pack a row of `width` pixels `pb` into `buf` according to `c`, returning no. of bytes packed */
+static int tif_pack_row(const struct tif_colours *c, const unsigned char *pb, const int width, unsigned char *buf) {
+    int column, i;
+    int bytes_put = 0;
+
+    if (c->samples_per_pixel == 1) {
+        if (c->bits_per_sample == 1) { /* WHITEISZERO or BLACKISZERO */
+            for (column = 0; column < width; column += 8) {
+                unsigned char byte = 0;
+                for (i = 0; i < 8 && column + i < width; i++, pb++) {
+                    byte |= c->map[*pb] << (7 - i);
+                }
+                buf[bytes_put++] = byte;
+            }
+        } else { /* bits_per_sample == 4, PALETTE_COLOR with no alpha */
+            for (column = 0; column < width; column += 2) {
+                unsigned char byte = c->map[*pb++] << 4;
+                if (column + 1 < width) {
+                    byte |= c->map[*pb++];
+                }
+                buf[bytes_put++] = byte;
+            }
+        }
+    } else if (c->samples_per_pixel == 2) { /* PALETTE_COLOR with alpha */
+        for (column = 0; column < width; column++) {
+            const int idx = c->map[*pb++];
+            buf[bytes_put++] = idx;
+            buf[bytes_put++] = c->palette[idx][3];
+        }
+    } else { /* samples_per_pixel >= 4, RGB with alpha (4) or CMYK with (5) or without (4) alpha */
+        for (column = 0; column < width; column++) {
+            const int idx = c->map[*pb++];
+            memcpy(&buf[bytes_put], &c->palette[idx], c->samples_per_pixel);
+            bytes_put += c->samples_per_pixel;
+        }
+    }
+
+    return bytes_put;
+}
+
+/* Set strip offsets & byte counts for uncompressed strips starting at `start`, returning the offset following
+   (rounded up to word boundary) */
+static size_t tif_set_strips(const size_t start, const int strip_count, const int bytes_per_strip,
+                const int rows_last_strip, const int bytes_per_row, uint32_t *strip_offset, uint32_t *strip_bytes) {
+    size_t free_memory = start;
+    int i;
+
+    for (i = 0; i < strip_count; i++) {
+        strip_offset[i] = (uint32_t) free_memory;
+        if (i != (strip_count - 1)) {
+            strip_bytes[i] = bytes_per_strip;
+        } else {
+            if (rows_last_strip) {
+                strip_bytes[i] = rows_last_strip * bytes_per_row;
             } else {
-                bits_per_sample = 8;
-                samples_per_pixel = 2;
-                pixels_per_sample = 1;
-                color_map_size = 256; /* 2**BitsPerSample */
-                extra_samples = 1; /* Associated alpha */
+                strip_bytes[i] = bytes_per_strip;
             }
         }
+        free_memory += strip_bytes[i];
+    }
+    if (free_memory & 1) {
+        free_memory++; /* IFD must be on word boundary */
     }
 
+    return free_memory;
+}
+
+/* Output `page_cnt` pages of `symbol->bitmap_width` x `symbol->bitmap_height` pixels, stored consecutively in
+   `pixelbuf`, each page as a separate image (IFD) */
+/* TIFF Revision 6.0 https://www.adobe.io/content/dam/udp/en/open/standards/tiff/TIFF6.pdf */
+INTERNAL int zint_tif_pixel_plot_pages(struct zint_symbol *symbol, const unsigned char *pixelbuf,
+                const int page_cnt) {
+    int i;
+    struct tif_colours colours;
+    int rows_per_strip, strip_count;
+    int rows_last_strip;
+    int bytes_per_strip;
+    size_t free_memory;
+    int row, strip;
+    int strip_row;
+    int page;
+    unsigned int bytes_put;
+    long total_bytes_put;
+    long page_start, ifd_pos;
+    long next_ifd_pos = 4; /* Position of pointer to next IFD, initially that in header */
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    const unsigned char *pb;
+    int compression = TIF_NO_COMPRESSION;
+    const int output_to_stdout = symbol->output_options & BARCODE_STDOUT;
+    uint32_t *strip_offset;
+    uint32_t *strip_bytes;
+    unsigned char *strip_buf;
+
+    tiff_header_t header;
+    uint16_t entries = 0;
+    tiff_tag_t tags[22];
+    uint32_t offset = 0;
+    int update_offsets[22];
+    int offsets = 0;
+    int ifd_size;
+    uint32_t temp32;
+    uint16_t temp16;
+
+    tif_colours(symbol, &colours);
+
+    tif_capture(symbol, 0, 0, symbol->bitmap_width, symbol->bitmap_height, symbol->bitmap_width, pixelbuf);
+
     /* TIFF Rev 6 Section 7 p.27 "Set RowsPerStrip such that the size of each strip is about 8K bytes...
      * Note that extremely wide high resolution images may have rows larger than 8K bytes; in this case,
      * RowsPerStrip should be 1, and the strip will be larger than 8K." */
-    rows_per_strip = (8192 * pixels_per_sample) / (symbol->bitmap_width * samples_per_pixel);
+    rows_per_strip = (8192 * colours.pixels_per_sample) / (symbol->bitmap_width * colours.samples_per_pixel);
     if (rows_per_strip == 0) {
         rows_per_strip = 1;
     }
@@ -398,40 +533,26 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
 
     if (symbol->debug & ZINT_DEBUG_PRINT) {
         printf("TIFF (%dx%d) Strip Count %d, Rows Per Strip %d, Pixels Per Sample %d, Samples Per Pixel %d, PMI %d\n",
-            symbol->bitmap_width, symbol->bitmap_height, strip_count, rows_per_strip, pixels_per_sample,
-            samples_per_pixel, pmi);
+            symbol->bitmap_width, symbol->bitmap_height, strip_count, rows_per_strip, colours.pixels_per_sample,
+            colours.samples_per_pixel, colours.pmi);
     }
 
-    bytes_per_strip = rows_per_strip * ((symbol->bitmap_width + pixels_per_sample - 1) / pixels_per_sample)
-                        * samples_per_pixel;
+    bytes_per_strip = rows_per_strip * ((symbol->bitmap_width + colours.pixels_per_sample - 1) / colours.pixels_per_sample)
+                        * colours.samples_per_pixel;
     assert(bytes_per_strip >= 0); /* Suppress clang-tidy-21 clang-analyzer-security.ArrayBound */
 
     strip_offset = (uint32_t *) z_alloca(sizeof(uint32_t) * strip_count);
     strip_bytes = (uint32_t *) z_alloca(sizeof(uint32_t) * strip_count);
     strip_buf = (unsigned char *) z_alloca(bytes_per_strip + 1);
-
-    free_memory = sizeof(tiff_header_t);
-
-    for (i = 0; i < strip_count; i++) {
-        strip_offset[i] = (uint32_t) free_memory;
-        if (i != (strip_count - 1)) {
-            strip_bytes[i] = bytes_per_strip;
-        } else {
-            if (rows_last_strip) {
-                strip_bytes[i] = rows_last_strip
-                                    * ((symbol->bitmap_width + pixels_per_sample - 1) / pixels_per_sample)
-                                    * samples_per_pixel;
-            } else {
-                strip_bytes[i] = bytes_per_strip;
-            }
-        }
-        free_memory += strip_bytes[i];
-    }
-    if (free_memory & 1) {
-        free_memory++; /* IFD must be on word boundary */
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
     }
 
-    if (free_memory > 0xffff0000) {
+    free_memory = tif_set_strips(sizeof(tiff_header_t), strip_count, bytes_per_strip, rows_last_strip,
+                                    ((symbol->bitmap_width + colours.pixels_per_sample - 1) / colours.pixels_per_sample)
+                                    * colours.samples_per_pixel, strip_offset, strip_bytes);
+
+    if (free_memory > 0xffff0000 || (page_cnt > 1 && (free_memory + 0x10000) > 0xffff0000 / page_cnt)) {
         return z_errtxt(ZINT_ERROR_MEMORY, symbol, 670, "TIF output file size too big");
     }
 
@@ -452,83 +573,444 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
     zint_fm_write(&header, sizeof(tiff_header_t), 1, fmp);
     total_bytes_put = sizeof(tiff_header_t);
 
-    /* Pixel data */
     pb = pixelbuf;
-    strip = 0;
-    strip_row = 0;
-    bytes_put = 0;
-    for (row = 0; row < symbol->bitmap_height; row++) {
-        if (samples_per_pixel == 1) {
-            if (bits_per_sample == 1) { /* WHITEISZERO or BLACKISZERO */
-                for (column = 0; column < symbol->bitmap_width; column += 8) {
-                    unsigned char byte = 0;
-                    for (i = 0; i < 8 && column + i < symbol->bitmap_width; i++, pb++) {
-                        byte |= map[*pb] << (7 - i);
+    for (page = 0; page < page_cnt; page++) {
+        if (page) {
+            free_memory = tif_set_strips((size_t) total_bytes_put, strip_count, bytes_per_strip, rows_last_strip,
+                                        ((symbol->bitmap_width + colours.pixels_per_sample - 1) / colours.pixels_per_sample)
+                                        * colours.samples_per_pixel, strip_offset, strip_bytes);
+            entries = 0;
+            offsets = 0;
+        }
+        page_start = total_bytes_put;
+
+        /* Pixel data */
+        strip = 0;
+        strip_row = 0;
+        bytes_put = 0;
+        for (row = 0; row < symbol->bitmap_height; row++) {
+            bytes_put += tif_pack_row(&colours, pb, symbol->bitmap_width, strip_buf + bytes_put);
+            pb += symbol->bitmap_width;
+
+            strip_row++;
+
+            if (strip_row == rows_per_strip || (strip == strip_count - 1 && strip_row == rows_last_strip)) {
+                /* End of strip */
+                if (compression == TIF_LZW) {
+                    #ifndef NDEBUG
+                    long before_file_pos, after_file_pos;
+                    if ((before_file_pos = zint_fm_tell(fmp)) == -1L) {
+                        (void) zint_fm_close(fmp, symbol);
+                        return z_errtxt(ZINT_ERROR_FILE_WRITE, symbol, 671,
+                                        "Failed to get file position in TIF output");
                     }
-                    strip_buf[bytes_put++] = byte;
-                }
-            } else { /* bits_per_sample == 4, PALETTE_COLOR with no alpha */
-                for (column = 0; column < symbol->bitmap_width; column += 2) {
-                    unsigned char byte = map[*pb++] << 4;
-                    if (column + 1 < symbol->bitmap_width) {
-                        byte |= map[*pb++];
+                    #endif
+
+                    bytes_put = tif_lzw_compress(fmp, strip_buf, bytes_put);
+                    if (Z_SCRATCH_FAILED()) {
+                        (void) zint_fm_close(fmp, symbol);
+                        return ZINT_ERROR_MEMORY;
+                    }
+
+                    #ifndef NDEBUG
+                    if ((after_file_pos = zint_fm_tell(fmp)) == -1L) {
+                        (void) zint_fm_close(fmp, symbol);
+                        return z_errtxt(ZINT_ERROR_FILE_WRITE, symbol, 673,
+                                        "Failed to get file position in TIF output");
                     }
-                    strip_buf[bytes_put++] = byte;
+                    assert(bytes_put == (unsigned int) (after_file_pos - before_file_pos));
+                    #endif
+
+                    if (bytes_put != strip_bytes[strip]) {
+                        const int diff = bytes_put - strip_bytes[strip];
+                        strip_bytes[strip] = bytes_put;
+                        for (i = strip + 1; i < strip_count; i++) {
+                            strip_offset[i] += diff;
+                        }
+                    }
+                } else {
+                    zint_fm_write(strip_buf, 1, bytes_put, fmp);
                 }
+                strip++;
+                total_bytes_put += bytes_put;
+                bytes_put = 0;
+                strip_row = 0;
+                /* Suppress clang-analyzer-core.UndefinedBinaryOperatorResult */
+                assert(strip < strip_count || row + 1 == symbol->bitmap_height);
             }
-        } else if (samples_per_pixel == 2) { /* PALETTE_COLOR with alpha */
-            for (column = 0; column < symbol->bitmap_width; column++) {
-                const int idx = map[*pb++];
-                strip_buf[bytes_put++] = idx;
-                strip_buf[bytes_put++] = palette[idx][3];
+        }
+
+        if (total_bytes_put & 1) {
+            zint_fm_putc(0, fmp); /* IFD must be on word boundary */
+            total_bytes_put++;
+        }
+
+        if (compression == TIF_LZW) {
+            long file_pos;
+            if ((file_pos = zint_fm_tell(fmp)) == -1L) {
+                (void) zint_fm_close(fmp, symbol);
+                return z_errtxt(ZINT_ERROR_FILE_WRITE, symbol, 675, "Failed to get file position in TIF output");
             }
-        } else { /* samples_per_pixel >= 4, RGB with alpha (4) or CMYK with (5) or without (4) alpha */
-            for (column = 0; column < symbol->bitmap_width; column++) {
-                const int idx = map[*pb++];
-                memcpy(&strip_buf[bytes_put], &palette[idx], samples_per_pixel);
-                bytes_put += samples_per_pixel;
+            zint_fm_seek(fmp, next_ifd_pos, SEEK_SET);
+            free_memory = file_pos;
+            temp32 = (uint32_t) free_memory;
+            /* Shouldn't happen as `free_memory` checked above to be <= 0xffff0000 & should only decrease */
+            if (free_memory != temp32 || (long) free_memory != file_pos) {
+                (void) zint_fm_close(fmp, symbol);
+                return z_errtxt(ZINT_ERROR_MEMORY, symbol, 982, "TIF output file size too big");
             }
+            zint_out_le_u32(temp32, temp32);
+            zint_fm_write(&temp32, 4, 1, fmp);
+            zint_fm_seek(fmp, file_pos, SEEK_SET);
         }
 
-        strip_row++;
+        ifd_pos = (long) free_memory;
 
-        if (strip_row == rows_per_strip || (strip == strip_count - 1 && strip_row == rows_last_strip)) {
-            /* End of strip */
-            if (compression == TIF_LZW) {
-                #ifndef NDEBUG
-                long before_file_pos, after_file_pos;
-                if ((before_file_pos = zint_fm_tell(fmp)) == -1L) {
-                    (void) zint_fm_close(fmp, symbol);
-                    return z_errtxt(ZINT_ERROR_FILE_WRITE, symbol, 671, "Failed to get file position in TIF output");
-                }
-                #endif
+        /* Image File Directory */
+        if (page_cnt > 1) {
+            zint_out_le_u16(tags[entries].tag, 0x00fe); /* NewSubfileType */
+            zint_out_le_u16(tags[entries].type, 4); /* LONG */
+            zint_out_le_u32(tags[entries].count, 1);
+            zint_out_le_u32(tags[entries++].offset, 2); /* Page of multi-page image */
+        }
 
-                bytes_put = tif_lzw_compress(fmp, strip_buf, bytes_put);
+        zint_out_le_u16(tags[entries].tag, 0x0100); /* ImageWidth */
+        zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+        zint_out_le_u32(tags[entries].count, 1);
+        zint_out_le_u32(tags[entries++].offset, symbol->bitmap_width);
 
-                #ifndef NDEBUG
-                if ((after_file_pos = zint_fm_tell(fmp)) == -1L) {
-                    (void) zint_fm_close(fmp, symbol);
-                    return z_errtxt(ZINT_ERROR_FILE_WRITE, symbol, 673, "Failed to get file position in TIF output");
-                }
-                assert(bytes_put == (unsigned int) (after_file_pos - before_file_pos));
-                #endif
-
-                if (bytes_put != strip_bytes[strip]) {
-                    const int diff = bytes_put - strip_bytes[strip];
-                    strip_bytes[strip] = bytes_put;
-                    for (i = strip + 1; i < strip_count; i++) {
-                        strip_offset[i] += diff;
-                    }
-                }
+        zint_out_le_u16(tags[entries].tag, 0x0101); /* ImageLength - number of rows */
+        zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+        zint_out_le_u32(tags[entries].count, 1);
+        zint_out_le_u32(tags[entries++].offset, symbol->bitmap_height);
+
+        if (colours.samples_per_pixel != 1 || colours.bits_per_sample != 1) {
+            zint_out_le_u16(tags[entries].tag, 0x0102); /* BitsPerSample */
+            zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+            zint_out_le_u32(tags[entries].count, colours.samples_per_pixel);
+            if (colours.samples_per_pixel == 1) {
+                zint_out_le_u32(tags[entries++].offset, colours.bits_per_sample);
+            } else if (colours.samples_per_pixel == 2) { /* 2 SHORTS fit into LONG offset so packed into offset */
+                zint_out_le_u32(tags[entries++].offset, (colours.bits_per_sample << 16) | colours.bits_per_sample);
             } else {
-                zint_fm_write(strip_buf, 1, bytes_put, fmp);
+                update_offsets[offsets++] = entries;
+                tags[entries++].offset = (uint32_t) free_memory;
+                free_memory += colours.samples_per_pixel * 2;
+            }
+        }
+
+        zint_out_le_u16(tags[entries].tag, 0x0103); /* Compression */
+        zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+        zint_out_le_u32(tags[entries].count, 1);
+        zint_out_le_u32(tags[entries++].offset, compression);
+
+        zint_out_le_u16(tags[entries].tag, 0x0106); /* PhotometricInterpretation */
+        zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+        zint_out_le_u32(tags[entries].count, 1);
+        zint_out_le_u32(tags[entries++].offset, colours.pmi);
+
+        zint_out_le_u16(tags[entries].tag, 0x0111); /* StripOffsets */
+        zint_out_le_u16(tags[entries].type, 4); /* LONG */
+        zint_out_le_u32(tags[entries].count, strip_count);
+        if (strip_count == 1) {
+            zint_out_le_u32(tags[entries++].offset, strip_offset[0]);
+        } else {
+            update_offsets[offsets++] = entries;
+            tags[entries++].offset = (uint32_t) free_memory;
+            free_memory += strip_count * 4;
+        }
+
+        if (colours.samples_per_pixel > 1) {
+            zint_out_le_u16(tags[entries].tag, 0x0115); /* SamplesPerPixel */
+            zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+            zint_out_le_u32(tags[entries].count, 1);
+            zint_out_le_u32(tags[entries++].offset, colours.samples_per_pixel);
+        }
+
+        zint_out_le_u16(tags[entries].tag, 0x0116); /* RowsPerStrip */
+        zint_out_le_u16(tags[entries].type, 4); /* LONG */
+        zint_out_le_u32(tags[entries].count, 1);
+        zint_out_le_u32(tags[entries++].offset, rows_per_strip);
+
+        zint_out_le_u16(tags[entries].tag, 0x0117); /* StripByteCounts */
+        zint_out_le_u16(tags[entries].type, 4); /* LONG */
+        zint_out_le_u32(tags[entries].count, strip_count);
+        if (strip_count == 1) {
+            zint_out_le_u32(tags[entries++].offset, strip_bytes[0]);
+        } else {
+            update_offsets[offsets++] = entries;
+            tags[entries++].offset = (uint32_t) free_memory;
+            free_memory += strip_count * 4;
+        }
+
+        zint_out_le_u16(tags[entries].tag, 0x011a); /* XResolution */
+        zint_out_le_u16(tags[entries].type, 5); /* RATIONAL */
+        zint_out_le_u32(tags[entries].count, 1);
+        update_offsets[offsets++] = entries;
+        tags[entries++].offset = (uint32_t) free_memory;
+        free_memory += 8;
+
+        zint_out_le_u16(tags[entries].tag, 0x011b); /* YResolution */
+        zint_out_le_u16(tags[entries].type, 5); /* RATIONAL */
+        zint_out_le_u32(tags[entries].count, 1);
+        update_offsets[offsets++] = entries;
+        tags[entries++].offset = (uint32_t) free_memory;
+        free_memory += 8;
+
+        zint_out_le_u16(tags[entries].tag, 0x0128); /* ResolutionUnit */
+        zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+        zint_out_le_u32(tags[entries].count, 1);
+        if (symbol->dpmm) {
+            zint_out_le_u32(tags[entries++].offset, 3); /* Centimetres */
+        } else {
+            zint_out_le_u32(tags[entries++].offset, 2); /* Inches */
+        }
+
+        if (page_cnt > 1) {
+            zint_out_le_u16(tags[entries].tag, 0x0129); /* PageNumber */
+            zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+            zint_out_le_u32(tags[entries].count, 2);
+            /* 2 SHORTS fit into LONG offset so packed into offset */
+            zint_out_le_u32(tags[entries++].offset, ((page_cnt & 0xFFFF) << 16) | page);
+        }
+
+        if (colours.color_map_size) {
+            zint_out_le_u16(tags[entries].tag, 0x0140); /* ColorMap */
+            zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+            zint_out_le_u32(tags[entries].count, colours.color_map_size * 3);
+            update_offsets[offsets++] = entries;
+            tags[entries++].offset = (uint32_t) free_memory;
+            free_memory += colours.color_map_size * 3 * 2;
+        }
+
+        if (colours.extra_samples) {
+            zint_out_le_u16(tags[entries].tag, 0x0152); /* ExtraSamples */
+            zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+            zint_out_le_u32(tags[entries].count, 1);
+            zint_out_le_u32(tags[entries++].offset, colours.extra_samples);
+        }
+
+        ifd_size = sizeof(entries) + sizeof(tiff_tag_t) * entries + sizeof(offset);
+        for (i = 0; i < offsets; i++) {
+            zint_out_le_u32(tags[update_offsets[i]].offset, tags[update_offsets[i]].offset + ifd_size);
+        }
+
+        zint_out_le_u16(temp16, entries);
+        zint_fm_write(&temp16, sizeof(entries), 1, fmp);
+        zint_fm_write(&tags, sizeof(tiff_tag_t), entries, fmp);
+        /* Offset of next IFD - if compressing will be updated when known */
+        if (page + 1 < page_cnt && compression != TIF_LZW) {
+            /* Next page same size so its IFD at same relative position */
+            zint_out_le_u32(offset, (uint32_t) (free_memory + ifd_size + (ifd_pos - page_start)));
+        } else {
+            zint_out_le_u32(offset, 0);
+        }
+        zint_fm_write(&offset, sizeof(offset), 1, fmp);
+        next_ifd_pos = ifd_pos + ifd_size - (long) sizeof(offset);
+        total_bytes_put += ifd_size;
+
+        if (colours.samples_per_pixel > 2) {
+            zint_out_le_u16(colours.bits_per_sample, colours.bits_per_sample);
+            for (i = 0; i < colours.samples_per_pixel; i++) {
+                zint_fm_write(&colours.bits_per_sample, sizeof(colours.bits_per_sample), 1, fmp);
+            }
+            total_bytes_put += sizeof(colours.bits_per_sample) * colours.samples_per_pixel;
+        }
+
+        if (strip_count != 1) {
+            /* Strip offsets */
+            for (i = 0; i < strip_count; i++) {
+                zint_out_le_u32(temp32, strip_offset[i]);
+                zint_fm_write(&temp32, 4, 1, fmp);
+            }
+
+            /* Strip byte lengths */
+            for (i = 0; i < strip_count; i++) {
+                zint_out_le_u32(temp32, strip_bytes[i]);
+                zint_fm_write(&temp32, 4, 1, fmp);
+            }
+            total_bytes_put += strip_count * 8;
+        }
+
+        /* XResolution */
+        zint_out_le_u32(temp32, symbol->dpmm ? symbol->dpmm : 72);
+        zint_fm_write(&temp32, 4, 1, fmp);
+        zint_out_le_u32(temp32, symbol->dpmm ? 10 /*cm*/ : 1);
+        zint_fm_write(&temp32, 4, 1, fmp);
+        total_bytes_put += 8;
+
+        /* YResolution */
+        zint_out_le_u32(temp32, symbol->dpmm ? symbol->dpmm : 72);
+        zint_fm_write(&temp32, 4, 1, fmp);
+        zint_out_le_u32(temp32, symbol->dpmm ? 10 /*cm*/ : 1);
+        zint_fm_write(&temp32, 4, 1, fmp);
+        total_bytes_put += 8;
+
+        if (colours.color_map_size) {
+            for (i = 0; i < colours.color_map_size; i++) {
+                zint_fm_write(&colours.color_map[i].red, 2, 1, fmp);
+            }
+            for (i = 0; i < colours.color_map_size; i++) {
+                zint_fm_write(&colours.color_map[i].green, 2, 1, fmp);
+            }
+            for (i = 0; i < colours.color_map_size; i++) {
+                zint_fm_write(&colours.color_map[i].blue, 2, 1, fmp);
+            }
+            total_bytes_put += 6 * colours.color_map_size;
+        }
+    }
+
+    if (zint_fm_error(fmp)) {
+        ZEXT z_errtxtf(0, symbol, 679, "Incomplete write of TIF output (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+        (void) zint_fm_close(fmp, symbol);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+
+    if (!output_to_stdout) {
+        if (zint_fm_tell(fmp) != total_bytes_put) {
+            (void) zint_fm_close(fmp, symbol);
+            return z_errtxt(ZINT_ERROR_FILE_WRITE, symbol, 674, "Failed to write all TIF output");
+        }
+    }
+    if (!zint_fm_close(fmp, symbol)) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_WRITE, symbol, 981, "Failure on closing TIF output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    return 0;
+}
+
+/* Output single page `symbol->bitmap_width` x `symbol->bitmap_height` image `pixelbuf` */
+INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf) {
+    return zint_tif_pixel_plot_pages(symbol, pixelbuf, 1);
+}
+
+/* Output `symbol->bitmap_width` x `symbol->bitmap_height` image as tiles rendered on demand by `tiler`, so that the
+   full image is never held in memory */
+/* TIFF Revision 6.0 Section 15 "Tiled Images" */
+INTERNAL int zint_tif_tile_plot(struct zint_symbol *symbol, const struct zint_raster_tiler *tiler) {
+    int i;
+    struct tif_colours colours;
+    const int tiles_across = (symbol->bitmap_width + TIF_TILE_SIZE - 1) / TIF_TILE_SIZE;
+    const int tiles_down = (symbol->bitmap_height + TIF_TILE_SIZE - 1) / TIF_TILE_SIZE;
+    int tile_cnt;
+    int bytes_per_row, bytes_per_tile;
+    int tile, row;
+    size_t free_memory;
+    unsigned int bytes_put;
+    long total_bytes_put;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    int compression = TIF_NO_COMPRESSION;
+    const int output_to_stdout = symbol->output_options & BARCODE_STDOUT;
+    unsigned char *tile_mem;
+    uint32_t *tile_offset;
+    uint32_t *tile_bytes;
+    unsigned char *tile_pixels;
+    unsigned char *tile_buf;
+
+    tiff_header_t header;
+    uint16_t entries = 0;
+    tiff_tag_t tags[16];
+    uint32_t offset = 0;
+    int update_offsets[16];
+    int offsets = 0;
+    int ifd_size;
+    uint32_t temp32;
+    uint16_t temp16;
+
+    assert(symbol->bitmap_width > 0 && symbol->bitmap_height > 0);
+
+    /* Tile offsets & byte counts alone must fit */
+    if ((size_t) tiles_across * tiles_down > 0xffff0000 / 8) {
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 677, "TIF output file size too big");
+    }
+    tile_cnt = tiles_across * tiles_down;
+
+    tif_colours(symbol, &colours);
+
+    bytes_per_row = ((TIF_TILE_SIZE + colours.pixels_per_sample - 1) / colours.pixels_per_sample)
+                    * colours.samples_per_pixel;
+    bytes_per_tile = bytes_per_row * TIF_TILE_SIZE;
+
+    if (!output_to_stdout) {
+        compression = TIF_LZW;
+    }
+
+    /* If not compressing, IFD follows tiles, which are all the same size */
+    free_memory = sizeof(tiff_header_t) + (size_t) tile_cnt * bytes_per_tile;
+    if (compression != TIF_LZW && free_memory > 0xffff0000) {
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 678, "TIF output file size too big");
+    }
+
+    if (symbol->debug & ZINT_DEBUG_PRINT) {
+        printf("TIFF (%dx%d) Tile Count %d (%dx%d), Pixels Per Sample %d, Samples Per Pixel %d, PMI %d\n",
+            symbol->bitmap_width, symbol->bitmap_height, tile_cnt, tiles_across, tiles_down,
+            colours.pixels_per_sample, colours.samples_per_pixel, colours.pmi);
+    }
+
+    if (!(tile_mem = (unsigned char *) malloc(sizeof(uint32_t) * 2 * tile_cnt + TIF_TILE_SIZE * TIF_TILE_SIZE
+                                                + bytes_per_tile + 1))) {
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 676, "Insufficient memory for TIF tile buffers");
+    }
+    tile_offset = (uint32_t *) tile_mem;
+    tile_bytes = tile_offset + tile_cnt;
+    tile_pixels = (unsigned char *) (tile_bytes + tile_cnt);
+    tile_buf = tile_pixels + TIF_TILE_SIZE * TIF_TILE_SIZE;
+
+    /* Open output file in binary mode */
+    if (!zint_fm_open(fmp, symbol, "wb")) {
+        free(tile_mem);
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_ACCESS, symbol, 672, "Could not open TIF output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    /* Header */
+    if (free_memory & 1) {
+        free_memory++; /* IFD must be on word boundary */
+    }
+    zint_out_le_u16(header.byte_order, 0x4949); /* "II" little-endian */
+    zint_out_le_u16(header.identity, 42);
+    zint_out_le_u32(header.offset, free_memory); /* Updated below if compressing */
+
+    zint_fm_write(&header, sizeof(tiff_header_t), 1, fmp);
+    total_bytes_put = sizeof(tiff_header_t);
+
+    /* Tiles, left-to-right, top-to-bottom, each padded to full size */
+    for (tile = 0; tile < tile_cnt; tile++) {
+        const int x = (tile % tiles_across) * TIF_TILE_SIZE;
+        const int y = (tile / tiles_across) * TIF_TILE_SIZE;
+        const int width = symbol->bitmap_width - x < TIF_TILE_SIZE ? symbol->bitmap_width - x : TIF_TILE_SIZE;
+        const int height = symbol->bitmap_height - y < TIF_TILE_SIZE ? symbol->bitmap_height - y : TIF_TILE_SIZE;
+
+        if (width < TIF_TILE_SIZE || height < TIF_TILE_SIZE) {
+            memset(tile_pixels, '0', TIF_TILE_SIZE * TIF_TILE_SIZE); /* Pad with background */
+        }
+        zint_raster_tile(tiler, x, y, width, height, TIF_TILE_SIZE, tile_pixels);
+        tif_capture(symbol, x, y, width, height, TIF_TILE_SIZE, tile_pixels);
+
+        bytes_put = 0;
+        for (row = 0; row < TIF_TILE_SIZE; row++) {
+            bytes_put += tif_pack_row(&colours, tile_pixels + TIF_TILE_SIZE * row, TIF_TILE_SIZE,
+                                        tile_buf + bytes_put);
+        }
+        if (compression == TIF_LZW) {
+            bytes_put = tif_lzw_compress(fmp, tile_buf, bytes_put);
+            if (Z_SCRATCH_FAILED()) {
+                (void) zint_fm_close(fmp, symbol);
+                free(tile_mem);
+                return ZINT_ERROR_MEMORY;
             }
-            strip++;
-            total_bytes_put += bytes_put;
-            bytes_put = 0;
-            strip_row = 0;
-            /* Suppress clang-analyzer-core.UndefinedBinaryOperatorResult */
-            assert(strip < strip_count || row + 1 == symbol->bitmap_height);
+        } else {
+            zint_fm_write(tile_buf, 1, bytes_put, fmp);
+        }
+        tile_offset[tile] = (uint32_t) total_bytes_put;
+        tile_bytes[tile] = bytes_put;
+        total_bytes_put += bytes_put;
+        if (total_bytes_put > 0xffff0000) {
+            (void) zint_fm_close(fmp, symbol);
+            free(tile_mem);
+            return z_errtxt(ZINT_ERROR_MEMORY, symbol, 669, "TIF output file size too big");
         }
     }
 
@@ -538,47 +1020,36 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
     }
 
     if (compression == TIF_LZW) {
-        long file_pos;
-        if ((file_pos = zint_fm_tell(fmp)) == -1L) {
-            (void) zint_fm_close(fmp, symbol);
-            return z_errtxt(ZINT_ERROR_FILE_WRITE, symbol, 675, "Failed to get file position in TIF output");
-        }
         zint_fm_seek(fmp, 4, SEEK_SET);
-        free_memory = file_pos;
-        temp32 = (uint32_t) free_memory;
-        /* Shouldn't happen as `free_memory` checked above to be <= 0xffff0000 & should only decrease */
-        if (free_memory != temp32 || (long) free_memory != file_pos) {
-            (void) zint_fm_close(fmp, symbol);
-            return z_errtxt(ZINT_ERROR_MEMORY, symbol, 982, "TIF output file size too big");
-        }
-        zint_out_le_u32(temp32, temp32);
+        zint_out_le_u32(temp32, (uint32_t) total_bytes_put);
         zint_fm_write(&temp32, 4, 1, fmp);
-        zint_fm_seek(fmp, file_pos, SEEK_SET);
+        zint_fm_seek(fmp, total_bytes_put, SEEK_SET);
     }
+    free_memory = total_bytes_put;
 
     /* Image File Directory */
     zint_out_le_u16(tags[entries].tag, 0x0100); /* ImageWidth */
-    zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+    zint_out_le_u16(tags[entries].type, 4); /* LONG */
     zint_out_le_u32(tags[entries].count, 1);
     zint_out_le_u32(tags[entries++].offset, symbol->bitmap_width);
 
     zint_out_le_u16(tags[entries].tag, 0x0101); /* ImageLength - number of rows */
-    zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+    zint_out_le_u16(tags[entries].type, 4); /* LONG */
     zint_out_le_u32(tags[entries].count, 1);
     zint_out_le_u32(tags[entries++].offset, symbol->bitmap_height);
 
-    if (samples_per_pixel != 1 || bits_per_sample != 1) {
+    if (colours.samples_per_pixel != 1 || colours.bits_per_sample != 1) {
         zint_out_le_u16(tags[entries].tag, 0x0102); /* BitsPerSample */
         zint_out_le_u16(tags[entries].type, 3); /* SHORT */
-        zint_out_le_u32(tags[entries].count, samples_per_pixel);
-        if (samples_per_pixel == 1) {
-            zint_out_le_u32(tags[entries++].offset, bits_per_sample);
-        } else if (samples_per_pixel == 2) { /* 2 SHORTS fit into LONG offset so packed into offset */
-            zint_out_le_u32(tags[entries++].offset, (bits_per_sample << 16) | bits_per_sample);
+        zint_out_le_u32(tags[entries].count, colours.samples_per_pixel);
+        if (colours.samples_per_pixel == 1) {
+            zint_out_le_u32(tags[entries++].offset, colours.bits_per_sample);
+        } else if (colours.samples_per_pixel == 2) { /* 2 SHORTS fit into LONG offset so packed into offset */
+            zint_out_le_u32(tags[entries++].offset, (colours.bits_per_sample << 16) | colours.bits_per_sample);
         } else {
             update_offsets[offsets++] = entries;
             tags[entries++].offset = (uint32_t) free_memory;
-            free_memory += samples_per_pixel * 2;
+            free_memory += colours.samples_per_pixel * 2;
         }
     }
 
@@ -590,40 +1061,13 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
     zint_out_le_u16(tags[entries].tag, 0x0106); /* PhotometricInterpretation */
     zint_out_le_u16(tags[entries].type, 3); /* SHORT */
     zint_out_le_u32(tags[entries].count, 1);
-    zint_out_le_u32(tags[entries++].offset, pmi);
-
-    zint_out_le_u16(tags[entries].tag, 0x0111); /* StripOffsets */
-    zint_out_le_u16(tags[entries].type, 4); /* LONG */
-    zint_out_le_u32(tags[entries].count, strip_count);
-    if (strip_count == 1) {
-        zint_out_le_u32(tags[entries++].offset, strip_offset[0]);
-    } else {
-        update_offsets[offsets++] = entries;
-        tags[entries++].offset = (uint32_t) free_memory;
-        free_memory += strip_count * 4;
-    }
+    zint_out_le_u32(tags[entries++].offset, colours.pmi);
 
-    if (samples_per_pixel > 1) {
+    if (colours.samples_per_pixel > 1) {
         zint_out_le_u16(tags[entries].tag, 0x0115); /* SamplesPerPixel */
         zint_out_le_u16(tags[entries].type, 3); /* SHORT */
         zint_out_le_u32(tags[entries].count, 1);
-        zint_out_le_u32(tags[entries++].offset, samples_per_pixel);
-    }
-
-    zint_out_le_u16(tags[entries].tag, 0x0116); /* RowsPerStrip */
-    zint_out_le_u16(tags[entries].type, 4); /* LONG */
-    zint_out_le_u32(tags[entries].count, 1);
-    zint_out_le_u32(tags[entries++].offset, rows_per_strip);
-
-    zint_out_le_u16(tags[entries].tag, 0x0117); /* StripByteCounts */
-    zint_out_le_u16(tags[entries].type, 4); /* LONG */
-    zint_out_le_u32(tags[entries].count, strip_count);
-    if (strip_count == 1) {
-        zint_out_le_u32(tags[entries++].offset, strip_bytes[0]);
-    } else {
-        update_offsets[offsets++] = entries;
-        tags[entries++].offset = (uint32_t) free_memory;
-        free_memory += strip_count * 4;
+        zint_out_le_u32(tags[entries++].offset, colours.samples_per_pixel);
     }
 
     zint_out_le_u16(tags[entries].tag, 0x011a); /* XResolution */
@@ -649,23 +1093,60 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
         zint_out_le_u32(tags[entries++].offset, 2); /* Inches */
     }
 
-    if (color_map_size) {
+    if (colours.color_map_size) {
         zint_out_le_u16(tags[entries].tag, 0x0140); /* ColorMap */
         zint_out_le_u16(tags[entries].type, 3); /* SHORT */
-        zint_out_le_u32(tags[entries].count, color_map_size * 3);
+        zint_out_le_u32(tags[entries].count, colours.color_map_size * 3);
+        update_offsets[offsets++] = entries;
+        tags[entries++].offset = (uint32_t) free_memory;
+        free_memory += colours.color_map_size * 3 * 2;
+    }
+
+    zint_out_le_u16(tags[entries].tag, 0x0142); /* TileWidth */
+    zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+    zint_out_le_u32(tags[entries].count, 1);
+    zint_out_le_u32(tags[entries++].offset, TIF_TILE_SIZE);
+
+    zint_out_le_u16(tags[entries].tag, 0x0143); /* TileLength */
+    zint_out_le_u16(tags[entries].type, 3); /* SHORT */
+    zint_out_le_u32(tags[entries].count, 1);
+    zint_out_le_u32(tags[entries++].offset, TIF_TILE_SIZE);
+
+    zint_out_le_u16(tags[entries].tag, 0x0144); /* TileOffsets */
+    zint_out_le_u16(tags[entries].type, 4); /* LONG */
+    zint_out_le_u32(tags[entries].count, tile_cnt);
+    if (tile_cnt == 1) {
+        zint_out_le_u32(tags[entries++].offset, tile_offset[0]);
+    } else {
+        update_offsets[offsets++] = entries;
+        tags[entries++].offset = (uint32_t) free_memory;
+        free_memory += tile_cnt * 4;
+    }
+
+    zint_out_le_u16(tags[entries].tag, 0x0145); /* TileByteCounts */
+    zint_out_le_u16(tags[entries].type, 4); /* LONG */
+    zint_out_le_u32(tags[entries].count, tile_cnt);
+    if (tile_cnt == 1) {
+        zint_out_le_u32(tags[entries++].offset, tile_bytes[0]);
+    } else {
         update_offsets[offsets++] = entries;
         tags[entries++].offset = (uint32_t) free_memory;
-        /* free_memory += color_map_size * 3 * 2; Unnecessary as long as last use */
+        free_memory += tile_cnt * 4;
     }
 
-    if (extra_samples) {
+    if (colours.extra_samples) {
         zint_out_le_u16(tags[entries].tag, 0x0152); /* ExtraSamples */
         zint_out_le_u16(tags[entries].type, 3); /* SHORT */
         zint_out_le_u32(tags[entries].count, 1);
-        zint_out_le_u32(tags[entries++].offset, extra_samples);
+        zint_out_le_u32(tags[entries++].offset, colours.extra_samples);
     }
 
     ifd_size = sizeof(entries) + sizeof(tiff_tag_t) * entries + sizeof(offset);
+    if (free_memory + ifd_size > 0xffff0000) {
+        (void) zint_fm_close(fmp, symbol);
+        free(tile_mem);
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 683, "TIF output file size too big");
+    }
     for (i = 0; i < offsets; i++) {
         zint_out_le_u32(tags[update_offsets[i]].offset, tags[update_offsets[i]].offset + ifd_size);
     }
@@ -673,31 +1154,15 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
     zint_out_le_u16(temp16, entries);
     zint_fm_write(&temp16, sizeof(entries), 1, fmp);
     zint_fm_write(&tags, sizeof(tiff_tag_t), entries, fmp);
-    zint_out_le_u32(offset, offset);
-    zint_fm_write(&offset, sizeof(offset), 1, fmp);
+    zint_fm_write(&offset, sizeof(offset), 1, fmp); /* Offset of next IFD - none */
     total_bytes_put += ifd_size;
 
-    if (samples_per_pixel > 2) {
-        zint_out_le_u16(bits_per_sample, bits_per_sample);
-        for (i = 0; i < samples_per_pixel; i++) {
-            zint_fm_write(&bits_per_sample, sizeof(bits_per_sample), 1, fmp);
-        }
-        total_bytes_put += sizeof(bits_per_sample) * samples_per_pixel;
-    }
-
-    if (strip_count != 1) {
-        /* Strip offsets */
-        for (i = 0; i < strip_count; i++) {
-            zint_out_le_u32(temp32, strip_offset[i]);
-            zint_fm_write(&temp32, 4, 1, fmp);
-        }
-
-        /* Strip byte lengths */
-        for (i = 0; i < strip_count; i++) {
-            zint_out_le_u32(temp32, strip_bytes[i]);
-            zint_fm_write(&temp32, 4, 1, fmp);
+    if (colours.samples_per_pixel > 2) {
+        zint_out_le_u16(temp16, colours.bits_per_sample);
+        for (i = 0; i < colours.samples_per_pixel; i++) {
+            zint_fm_write(&temp16, sizeof(temp16), 1, fmp);
         }
-        total_bytes_put += strip_count * 8;
+        total_bytes_put += sizeof(temp16) * colours.samples_per_pixel;
     }
 
     /* XResolution */
@@ -714,19 +1179,36 @@ INTERNAL int zint_tif_pixel_plot(struct zint_symbol *symbol, const unsigned char
     zint_fm_write(&temp32, 4, 1, fmp);
     total_bytes_put += 8;
 
-    if (color_map_size) {
-        for (i = 0; i < color_map_size; i++) {
-            zint_fm_write(&color_map[i].red, 2, 1, fmp);
+    if (colours.color_map_size) {
+        for (i = 0; i < colours.color_map_size; i++) {
+            zint_fm_write(&colours.color_map[i].red, 2, 1, fmp);
         }
-        for (i = 0; i < color_map_size; i++) {
-            zint_fm_write(&color_map[i].green, 2, 1, fmp);
+        for (i = 0; i < colours.color_map_size; i++) {
+            zint_fm_write(&colours.color_map[i].green, 2, 1, fmp);
         }
-        for (i = 0; i < color_map_size; i++) {
-            zint_fm_write(&color_map[i].blue, 2, 1, fmp);
+        for (i = 0; i < colours.color_map_size; i++) {
+            zint_fm_write(&colours.color_map[i].blue, 2, 1, fmp);
         }
-        total_bytes_put += 6 * color_map_size;
+        total_bytes_put += 6 * colours.color_map_size;
     }
 
+    if (tile_cnt != 1) {
+        /* Tile offsets */
+        for (i = 0; i < tile_cnt; i++) {
+            zint_out_le_u32(temp32, tile_offset[i]);
+            zint_fm_write(&temp32, 4, 1, fmp);
+        }
+
+        /* Tile byte lengths */
+        for (i = 0; i < tile_cnt; i++) {
+            zint_out_le_u32(temp32, tile_bytes[i]);
+            zint_fm_write(&temp32, 4, 1, fmp);
+        }
+        total_bytes_put += tile_cnt * 8;
+    }
+
+    free(tile_mem);
+
     if (zint_fm_error(fmp)) {
         ZEXT z_errtxtf(0, symbol, 679, "Incomplete write of TIF output (%1$d: %2$s)", fmp->err, strerror(fmp->err));
         (void) zint_fm_close(fmp, symbol);
@@ -431,8 +431,13 @@ static float ult_look_ahead_c43(const unsigned char source[], const int length,
     int base43_value;
     int letters_encoded = 0;
     int pad;
+    Z_SCRATCH_MARK(scratch_mark); /* Called for each block */
     int *subcw = (int *) z_alloca(sizeof(int) * (length + 3) * 2);
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0.0f; /* Checked by caller */
+    }
+
     if (current_mode == ULT_EIGHTBIT_MODE) {
         /* Check for permissible URL C43 macro sequences, otherwise encode directly */
         fragno = ult_find_fragment(source, length, sublocn);
@@ -567,6 +572,7 @@ static float ult_look_ahead_c43(const unsigned char source[], const int length,
 
     *cw_len = codeword_count;
 
+    Z_SCRATCH_RELEASE(scratch_mark);
     if (codeword_count == 0) {
         return 0.0f;
     }
@@ -594,6 +600,10 @@ static int ult_generate_codewords(struct zint_symbol *symbol, const unsigned cha
     char *mode = (char *) z_alloca(length + 1);
     int *cw_fragment = (int *) z_alloca(sizeof(int) * (length * 2 + 1));
 
+    if (Z_SCRATCH_FAILED()) {
+        return 0; /* Checked by caller */
+    }
+
     assert(length > 0); /* Suppress clang-tidy-21 clang-analyzer-security.ArrayBound */
 
     /* Check for 06 Macro Sequence and crop accordingly */
@@ -636,6 +646,9 @@ static int ult_generate_codewords(struct zint_symbol *symbol, const unsigned cha
             subset = ult_c43_should_latch_other(crop_source, crop_length, input_locn, 1 /*subset*/) ? 2 : 1;
             c43_score = ult_look_ahead_c43(crop_source, crop_length, input_locn, current_mode, end_char,
                                 subset, cw_fragment, &fragment_length, &c43_encoded, gs1, 0 /*debug_print*/);
+            if (Z_SCRATCH_FAILED()) {
+                return 0; /* Checked by caller */
+            }
 
             mode[input_locn] = 'a';
             current_mode = ULT_ASCII_MODE;
@@ -715,6 +728,9 @@ static int ult_generate_codewords(struct zint_symbol *symbol, const unsigned cha
                 subset = ult_c43_should_latch_other(crop_source, crop_length, input_locn, 1 /*subset*/) ? 2 : 1;
                 ult_look_ahead_c43(crop_source, crop_length, input_locn, current_mode, input_locn + block_length,
                                     subset, cw_fragment, &fragment_length, NULL, gs1, debug_print);
+                if (Z_SCRATCH_FAILED()) {
+                    return 0; /* Checked by caller */
+                }
 
                 /* Substitute temporary latch if possible */
                 if (current_mode == ULT_EIGHTBIT_MODE && cw_fragment[0] == 260 && fragment_length >= 5
@@ -961,8 +977,14 @@ INTERNAL int zint_ultra(struct zint_symbol *symbol, struct zint_seg segs[], cons
     }
 
     data_codewords = (int *) z_alloca(sizeof(int) * cw_alloc);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     data_cw_count = ult_generate_codewords_segs(symbol, segs, seg_count, data_codewords);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     if (debug_print) {
         printf("Codewords (%d):", data_cw_count);
@@ -1116,6 +1138,9 @@ INTERNAL int zint_ultra(struct zint_symbol *symbol, struct zint_seg segs[], cons
 
     /* Build symbol */
     pattern = (char *) z_alloca((size_t) total_height * (size_t) total_width);
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
 
     for (i = 0; i < (total_height * total_width); i++) {
         pattern[i] = 'W';
@@ -76,6 +76,8 @@ INTERNAL void zint_test_vector_set_fail(const int id, const int at) {
 INTERNAL int zint_ps_plot(struct zint_symbol *symbol);
 INTERNAL int zint_svg_plot(struct zint_symbol *symbol);
 INTERNAL int zint_emf_plot(struct zint_symbol *symbol, int rotate_angle);
+INTERNAL int zint_pdf_plot(struct zint_symbol *symbol);
+INTERNAL int zint_pdf_plot_pages(struct zint_symbol *symbol, const struct zint_vector vectors[], const int page_cnt);
 
 static int vector_add_rect(struct zint_symbol *symbol, const float x, const float y, const float width,
             const float height, struct zint_vector_rect **last_rect) {
@@ -218,45 +220,50 @@ static int vector_add_string(struct zint_symbol *symbol, const unsigned char *te
     return 1;
 }
 
-INTERNAL void zint_vector_free(struct zint_symbol *symbol) {
-    if (symbol->vector != NULL) {
-        struct zint_vector_rect *rect;
-        struct zint_vector_hexagon *hex;
-        struct zint_vector_circle *circle;
-        struct zint_vector_string *string;
-
-        /* Free Rectangles */
-        rect = symbol->vector->rectangles;
-        while (rect) {
-            struct zint_vector_rect *r = rect;
-            rect = rect->next;
-            free(r);
-        }
+/* Free the element lists of `vector` (but not `vector` itself) */
+static void vector_free_lists(struct zint_vector *vector) {
+    struct zint_vector_rect *rect;
+    struct zint_vector_hexagon *hex;
+    struct zint_vector_circle *circle;
+    struct zint_vector_string *string;
 
-        /* Free Hexagons */
-        hex = symbol->vector->hexagons;
-        while (hex) {
-            struct zint_vector_hexagon *h = hex;
-            hex = hex->next;
-            free(h);
-        }
+    /* Free Rectangles */
+    rect = vector->rectangles;
+    while (rect) {
+        struct zint_vector_rect *r = rect;
+        rect = rect->next;
+        free(r);
+    }
 
-        /* Free Circles */
-        circle = symbol->vector->circles;
-        while (circle) {
-            struct zint_vector_circle *c = circle;
-            circle = circle->next;
-            free(c);
-        }
+    /* Free Hexagons */
+    hex = vector->hexagons;
+    while (hex) {
+        struct zint_vector_hexagon *h = hex;
+        hex = hex->next;
+        free(h);
+    }
 
-        /* Free Strings */
-        string = symbol->vector->strings;
-        while (string) {
-            struct zint_vector_string *s = string;
-            string = string->next;
-            free(s->text);
-            free(s);
-        }
+    /* Free Circles */
+    circle = vector->circles;
+    while (circle) {
+        struct zint_vector_circle *c = circle;
+        circle = circle->next;
+        free(c);
+    }
+
+    /* Free Strings */
+    string = vector->strings;
+    while (string) {
+        struct zint_vector_string *s = string;
+        string = string->next;
+        free(s->text);
+        free(s);
+    }
+}
+
+INTERNAL void zint_vector_free(struct zint_symbol *symbol) {
+    if (symbol->vector != NULL) {
+        vector_free_lists(symbol->vector);
 
         /* Free vector */
         free(symbol->vector);
@@ -500,8 +507,13 @@ INTERNAL int zint_plot_vector(struct zint_symbol *symbol, int rotate_angle, int
     struct zint_vector_rect **first_row_rects
                     = (struct zint_vector_rect **) z_alloca(sizeof(struct zint_vector_rect *) * (symbol->rows + 1));
 
+    if (Z_SCRATCH_FAILED()) {
+        return ZINT_ERROR_MEMORY;
+    }
     memset(first_row_rects, 0, sizeof(struct zint_vector_rect *) * (symbol->rows + 1));
 
+    (void) Z_STATS_MARK(symbol);
+
     /* Free any previous rendering structures */
     zint_vector_free(symbol);
 
@@ -1160,6 +1172,8 @@ INTERNAL int zint_plot_vector(struct zint_symbol *symbol, int rotate_angle, int
         vector_rotate(symbol, rotate_angle);
     }
 
+    Z_STATS_LAP(symbol, ZINT_STATS_BUILD);
+
     switch (file_type) {
         case OUT_EPS_FILE:
             error_number = zint_ps_plot(symbol);
@@ -1170,8 +1184,164 @@ INTERNAL int zint_plot_vector(struct zint_symbol *symbol, int rotate_angle, int
         case OUT_EMF_FILE:
             error_number = zint_emf_plot(symbol, rotate_angle);
             break;
+        case OUT_PDF_FILE:
+            error_number = zint_pdf_plot(symbol);
+            break;
         /* case OUT_BUFFER: No more work needed */
     }
+    if (file_type != OUT_BUFFER) {
+        Z_STATS_LAP(symbol, ZINT_STATS_FILE);
+    }
+
+    return error_number ? error_number : warn_number;
+}
+
+/* Tails of the element lists of a sheet page, for appending */
+struct vector_sheet_tails {
+    struct zint_vector_rect **p_rect;
+    struct zint_vector_hexagon **p_hex;
+    struct zint_vector_string **p_string;
+    struct zint_vector_circle **p_circle;
+};
+
+/* Translate the elements of `vector` by `dx`, `dy` and move them onto the ends of the page lists given by `tails`,
+   leaving `vector` empty */
+static void vector_sheet_move(struct zint_vector *vector, struct vector_sheet_tails *tails, const float dx,
+            const float dy) {
+    struct zint_vector_rect *rect;
+    struct zint_vector_hexagon *hex;
+    struct zint_vector_circle *circle;
+    struct zint_vector_string *string;
+
+    for (rect = vector->rectangles; rect; rect = rect->next) {
+        rect->x += dx;
+        rect->y += dy;
+        *tails->p_rect = rect;
+        tails->p_rect = &rect->next;
+    }
+    for (hex = vector->hexagons; hex; hex = hex->next) {
+        hex->x += dx;
+        hex->y += dy;
+        *tails->p_hex = hex;
+        tails->p_hex = &hex->next;
+    }
+    for (circle = vector->circles; circle; circle = circle->next) {
+        circle->x += dx;
+        circle->y += dy;
+        *tails->p_circle = circle;
+        tails->p_circle = &circle->next;
+    }
+    for (string = vector->strings; string; string = string->next) {
+        string->x += dx;
+        string->y += dy;
+        *tails->p_string = string;
+        tails->p_string = &string->next;
+    }
+    vector->rectangles = NULL;
+    vector->hexagons = NULL;
+    vector->circles = NULL;
+    vector->strings = NULL;
+}
+
+/* Plot `symbol_cnt` encoded `symbols` onto one or more pages as specified by `sheet`, using the output settings
+   of `symbols[0]`. Each symbol's vector is generated as for `OUT_BUFFER` and its elements moved into its cell */
+INTERNAL int zint_plot_vector_sheet(struct zint_symbol *symbols[], const int symbol_cnt,
+                const struct zint_sheet *sheet, const int rotate_angle, const int file_type) {
+    struct zint_symbol *const symbol = symbols[0];
+    struct zint_symbol *page_symbol = NULL;
+    struct zint_out_sheet layout;
+    struct zint_vector *pages = NULL;
+    struct vector_sheet_tails *tails = NULL;
+    float cell_width = 0.0f, cell_height = 0.0f;
+    int i, page;
+    int error_number = 0, warn_number = 0;
+    float xdim = symbol->scale * 2.0f; /* As `vector_scale()` */
+
+    if (xdim < 0.2f) {
+        xdim = 0.2f;
+    }
+
+    for (i = 0; i < symbol_cnt && !error_number; i++) {
+        struct zint_symbol *const sym = symbols[i];
+
+        error_number = zint_plot_vector(sym, rotate_angle, OUT_BUFFER);
+        if (error_number) {
+            if (sym != symbol) {
+                memcpy(symbol->errtxt, sym->errtxt, sizeof(symbol->errtxt));
+            }
+            if (error_number < ZINT_ERROR) {
+                warn_number = error_number;
+                error_number = 0;
+            }
+        }
+        if (!error_number) {
+            if (sym->vector->width > cell_width) {
+                cell_width = sym->vector->width;
+            }
+            if (sym->vector->height > cell_height) {
+                cell_height = sym->vector->height;
+            }
+        }
+    }
+
+    if (!error_number) {
+        zint_out_sheet_layout(sheet, symbol_cnt, cell_width, cell_height, xdim, &layout);
+
+        pages = (struct zint_vector *) calloc(layout.page_cnt, sizeof(struct zint_vector));
+        tails = (struct vector_sheet_tails *) malloc(sizeof(struct vector_sheet_tails) * layout.page_cnt);
+        if (!pages || !tails || !(page_symbol = zint_out_sheet_symbol(symbol))) {
+            error_number = z_errtxt(ZINT_ERROR_MEMORY, symbol, 698, "Insufficient memory for sheet vector pages");
+        }
+    }
+
+    if (!error_number) {
+        for (page = 0; page < layout.page_cnt; page++) {
+            pages[page].width = z_stripf(layout.page_width);
+            pages[page].height = z_stripf(layout.page_height);
+            tails[page].p_rect = &pages[page].rectangles;
+            tails[page].p_hex = &pages[page].hexagons;
+            tails[page].p_string = &pages[page].strings;
+            tails[page].p_circle = &pages[page].circles;
+        }
+        for (i = 0; i < symbol_cnt; i++) {
+            float x, y;
+
+            zint_out_sheet_position(&layout, i, symbols[i]->vector->width, symbols[i]->vector->height, &page, &x,
+                                    &y);
+            vector_sheet_move(symbols[i]->vector, &tails[page], z_stripf(x), z_stripf(y));
+        }
+
+        if (file_type == OUT_PDF_FILE) {
+            error_number = zint_pdf_plot_pages(page_symbol, pages, layout.page_cnt);
+        } else {
+            for (page = 0; page < layout.page_cnt && !error_number; page++) {
+                if (layout.page_cnt > 1
+                        && !zint_out_sheet_page_outfile(symbol->outfile, page + 1, page_symbol->outfile)) {
+                    error_number = z_errtxt(ZINT_ERROR_INVALID_OPTION, page_symbol, 699,
+                                            "Output filename too long to add page number");
+                } else {
+                    page_symbol->vector = &pages[page];
+                    error_number = file_type == OUT_EPS_FILE ? zint_ps_plot(page_symbol)
+                                                                : zint_svg_plot(page_symbol);
+                    page_symbol->vector = NULL;
+                }
+            }
+        }
+    }
+
+    if (pages) {
+        for (page = 0; page < layout.page_cnt; page++) {
+            vector_free_lists(&pages[page]);
+        }
+        free(pages);
+    }
+    free(tails);
+    if (page_symbol) {
+        zint_out_sheet_symbol_free(symbol, page_symbol);
+    }
+    for (i = 0; i < symbol_cnt; i++) {
+        zint_vector_free(symbols[i]);
+    }
 
     return error_number ? error_number : warn_number;
 }
@@ -35,15 +35,20 @@
 
 /* File types */
 #define OUT_BUFFER              0
+#define OUT_ZMM_FILE            1   /* Module matrix, neither vector nor raster */
 #define OUT_SVG_FILE            10
 #define OUT_EPS_FILE            20
 #define OUT_EMF_FILE            30
+#define OUT_PDF_FILE            40
 #define OUT_PNG_FILE            100
 #define OUT_BMP_FILE            120
 #define OUT_GIF_FILE            140
 #define OUT_PCX_FILE            160
 #define OUT_JPG_FILE            180
 #define OUT_TIF_FILE            200
+#define OUT_ZPL_FILE            220
+#define OUT_POS_FILE            240
+#define OUT_PBM_FILE            260
 
 /* vim: set ts=4 sw=4 et : */
 #endif /* Z_ZFILETYPES_H */
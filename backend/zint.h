@@ -97,6 +97,13 @@ extern "C" {
         char id[32];        /* Optional ID to distinguish sequence, ASCII, NUL-terminated unless max 32 long */
     };
 
+    /* Best-fit size selection constraints (see `symbol->fit` below) - Data Matrix with `DM_BEST_FIT` only */
+    struct zint_fit {
+        float aspect;       /* Target width-to-height ratio. If <= 0 then smallest area chosen */
+        float max_width;    /* Maximum width in X-dimensions. If <= 0 then no limit */
+        float max_height;   /* Maximum height in X-dimensions. If <= 0 then no limit */
+    };
+
     /* Segment for use with API `ZBarcode_Encode_Segs()` and `content_segs` */
     struct zint_seg {
         unsigned char *source; /* Data to encode */
@@ -104,6 +111,39 @@ extern "C" {
         int eci;            /* Extended Channel Interpretation */
     };
 
+    /* Sheet layout for `ZBarcode_Print_Sheet()` - symbols placed in a grid, left to right, top to bottom */
+    struct zint_sheet {
+        int cols;           /* Number of symbols across a page. If <= 0 then 1 */
+        int rows;           /* Number of symbols down a page. If <= 0 then all symbols placed on one page */
+        float margin;       /* Page margin in X-dimensions (based on first symbol's `scale`) */
+        float gap;          /* Horizontal & vertical gap between symbols in X-dimensions */
+    };
+
+    /* Per-phase timings & counts for `ZBarcode_GetStats()` - accumulated only if `symbol->debug` has
+       ZINT_DEBUG_STATS set. `time` & `count` are indexed by phase (see ZINT_STATS_XXX below) */
+    struct zint_stats {
+        double time[9];     /* Seconds spent in each phase */
+        unsigned int count[9]; /* Number of times each phase completed */
+        double bytes_in;    /* Total length of input data encoded */
+        double bytes_out;   /* Total length of files output (on disk or in memory) */
+    };
+
+    /* Trace event for `ZBarcode_GetTrace()` - recorded only if `symbol->debug` has ZINT_DEBUG_TRACE set */
+    struct zint_trace_event {
+        double ts;          /* Start of phase in seconds (from an arbitrary base) */
+        double dur;         /* Duration of phase in seconds */
+        int phase;          /* ZINT_STATS_XXX */
+        int symbology;      /* Symbology being encoded */
+        int length;         /* Length of input data being encoded */
+        int rows;           /* Rows of symbol (ZINT_STATS_ENCODE and output phases only, else 0) */
+        int width;          /* Width of symbol (ZINT_STATS_ENCODE and output phases only, else 0) */
+        int bytes;          /* Length of file output (ZINT_STATS_FILE & ZINT_STATS_OUTPUT only, else 0) */
+    };
+
+    struct zint_trace; /* Opaque stats & trace events state */
+
+    struct zint_delta; /* Opaque incremental re-encode state */
+
     /* Main symbol structure */
     struct zint_symbol {
         int symbology;      /* Symbol to use (see BARCODE_XXX below) */
@@ -146,6 +186,10 @@ extern "C" {
         int memfile_size;   /* Length of in-memory file buffer (output only) */
         struct zint_seg *content_segs; /* Pointer to array of content segs if BARCODE_CONTENT_SEGS (output only) */
         int content_seg_count; /* Number of `content_segs` (output only) */
+        struct zint_stats stats; /* Per-phase timings & counts if ZINT_DEBUG_STATS (output only, accumulated) */
+        struct zint_trace *trace; /* Stats & trace state if ZINT_DEBUG_STATS/TRACE (internal use only) */
+        struct zint_delta *delta; /* Previous encode state if `ZBarcode_Encode_Delta()` used (internal use only) */
+        struct zint_fit fit; /* Best-fit size selection constraints. Default fit.aspect etc 0 (smallest area) */
         unsigned char encoded_data[200][144]; /* Encoded data (output only). Allows for rows of 1152 modules */
         float row_height[200]; /* Heights of rows (output only). Allows for 200 row DotCode */
     };
@@ -324,15 +368,16 @@ extern "C" {
 #define ZINT_AZTEC_FULL         128     /* Only consider Full versions on automatic symbol size selection */
 
 /* Data Matrix specific options (`symbol->option_3`) */
-/* OR-able, but only one of DM_BASE_256_START/DM_C40_START, and only one of DM_SQUARE/DM_DMRE */
+/* OR-able, but only one of DM_BASE_256_START/DM_C40_START, and only one of DM_SQUARE/DM_DMRE/DM_BEST_FIT */
 #define DM_B256_START           0x02    /* Use Base 256 encodation initially, length given in `option_1` (0 = all) */
 #define DM_C40_START            0x08    /* Use C40 encodation initially, length given in `option_1` (0 = all) */
 #define DM_SQUARE               0x64    /* Only consider square versions on automatic symbol size selection */
 #define DM_DMRE                 0x65    /* Consider DMRE versions on automatic symbol size selection */
+#define DM_BEST_FIT             0x61    /* Consider all versions, choosing best fit to `symbol->fit` (see above) */
 #define DM_ISO_144              0x80    /* Use ISO instead of "de facto" format for 144x144 (i.e. don't skew ECC) */
 /* Masks for testing the exclusive pairs above */
 #define DM_B256_C40_START_MASK  0x0A    /* DM_B256_START or DM_C40_START */
-#define DM_SQUARE_DMRE_MASK     0x65    /* DM_SQUARE or DM_DMRE */
+#define DM_SQUARE_DMRE_MASK     0x65    /* DM_SQUARE or DM_DMRE or DM_BEST_FIT */
 
 /* QR, Han Xin, Grid Matrix specific options (`symbol->option_3`) */
 #define ZINT_FULL_MULTIBYTE     200     /* Enable Kanji/Hanzi compression for Latin-1 & binary data */
@@ -390,6 +435,23 @@ extern "C" {
 /* Debug flags (`symbol->debug`) */
 #define ZINT_DEBUG_PRINT        0x0001  /* Print debug info (if any) to stdout */
 #define ZINT_DEBUG_TEST         0x0002  /* For internal test use only */
+#define ZINT_DEBUG_STATS        0x0004  /* Accumulate per-phase timings & counts in `stats` */
+#define ZINT_DEBUG_TRACE        0x0008  /* Record per-phase trace events (see `ZBarcode_GetTrace()`) */
+
+/* Maximum number of trace events kept per symbol, older events being overwritten */
+#define ZINT_TRACE_MAX          65536
+
+/* Stats phases (indexes of `stats.time` & `stats.count`) */
+#define ZINT_STATS_INPUT        0   /* Input checking & preparation, including escape processing */
+#define ZINT_STATS_MODES        1   /* Mode selection & data encodation */
+#define ZINT_STATS_ECC          2   /* Error correction */
+#define ZINT_STATS_MASK         3   /* Masking */
+#define ZINT_STATS_PLACE        4   /* Module placement */
+#define ZINT_STATS_BUILD        5   /* Raster/vector build */
+#define ZINT_STATS_FILE         6   /* File encoding (on disk or in memory) */
+#define ZINT_STATS_ENCODE       7   /* Whole of encoding (includes INPUT to PLACE) */
+#define ZINT_STATS_OUTPUT       8   /* Whole of output (includes BUILD & FILE) */
+#define ZINT_STATS_PHASES       9   /* Number of phases */
 
 #ifdef _WIN32
 #  if defined(DLL_EXPORT) || defined(PIC) || defined(_USRDLL)
@@ -425,6 +487,10 @@ extern "C" {
     ZINT_EXTERN int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[],
                         const int seg_count);
 
+    /* Encode a barcode, patching the previous `ZBarcode_Encode_Delta()` encode of `symbol` if only some of its
+       codewords differ (QR Code and Data Matrix only), else as `ZBarcode_Encode()` */
+    ZINT_EXTERN int ZBarcode_Encode_Delta(struct zint_symbol *symbol, const unsigned char *source, int length);
+
     /* Encode a barcode using input data from file `filename` */
     ZINT_EXTERN int ZBarcode_Encode_File(struct zint_symbol *symbol, const char *filename);
 
@@ -444,6 +510,12 @@ extern "C" {
     ZINT_EXTERN int ZBarcode_Encode_File_and_Print(struct zint_symbol *symbol, const char *filename,
                         int rotate_angle);
 
+    /* Output `symbol_count` previously encoded `symbols` laid out on pages per `sheet` to file `symbols[0]->outfile`,
+       using the output options & colours of `symbols[0]`. Multiple pages are output to a single file for TIF and
+       PDF, otherwise to a file per page, numbered "-1", "-2" etc. before the extension */
+    ZINT_EXTERN int ZBarcode_Print_Sheet(struct zint_symbol *symbols[], int symbol_count,
+                        const struct zint_sheet *sheet, int rotate_angle);
+
 
     /* Output a previously encoded symbol to memory as raster (`symbol->bitmap`) */
     ZINT_EXTERN int ZBarcode_Buffer(struct zint_symbol *symbol, int rotate_angle);
@@ -503,7 +575,8 @@ extern "C" {
 
     /* Convert UTF-8 `source` of length `length` to `eci`-encoded `dest`, setting `p_dest_length` to length of `dest`
        on output. If `length` is 0 or negative, `source` must be NUL-terminated. Returns 0 on success, else
-       ZINT_ERROR_INVALID_OPTION or ZINT_ERROR_INVALID_DATA. Compatible with libzueci `zueci_utf8_to_eci()` */
+       ZINT_ERROR_INVALID_OPTION or ZINT_ERROR_INVALID_DATA (or ZINT_ERROR_MEMORY if built with ZINT_SMALL_STACK).
+       Compatible with libzueci `zueci_utf8_to_eci()` */
     ZINT_EXTERN int ZBarcode_UTF8_To_ECI(int eci, const unsigned char *source, int length, unsigned char dest[],
                         int *p_dest_length);
 
@@ -513,6 +586,15 @@ extern "C" {
     ZINT_EXTERN int ZBarcode_Dest_Len_ECI(int eci, const unsigned char *source, int length, int *p_dest_length);
 
 
+    /* Place item `index` (zero-based) of the sequence `start`, `start + step`, `start + 2 * step` etc., where `start`
+       and `step` are decimal strings of up to 18 digits, in `dest`, NUL-terminated, setting `p_dest_length` to its
+       length. If `format` is non-empty the item's digits replace "#", "$" and "*" from the right, as for the GUI
+       Sequence dialog, and "?" is replaced by the GS1 Mod 10 check digit of the digits immediately preceding it.
+       `dest` must be at least `strlen(format) + 1` long, or 19 if no `format`. Returns 0 on success, else
+       ZINT_ERROR_INVALID_OPTION or ZINT_ERROR_INVALID_DATA */
+    ZINT_EXTERN int ZBarcode_Sequence_Item(const char *start, const char *step, int index, const char *format,
+                        unsigned char dest[], int *p_dest_length);
+
     /* Whether Zint built without PNG support */
     ZINT_EXTERN int ZBarcode_NoPng(void);
 
@@ -522,6 +604,16 @@ extern "C" {
     /* Return the version of Zint linked to */
     ZINT_EXTERN int ZBarcode_Version(void);
 
+    /* Copy the per-phase timings & counts accumulated by `symbol` (if ZINT_DEBUG_STATS set) since it was created or
+       reset to `stats`. Returns 0 on success, ZINT_ERROR_INVALID_DATA if `symbol` or `stats` NULL, or
+       ZINT_ERROR_INVALID_OPTION if stats disabled at compile time (ZINT_NO_STATS) */
+    ZINT_EXTERN int ZBarcode_GetStats(const struct zint_symbol *symbol, struct zint_stats *stats);
+
+    /* Copy up to `max_events` of the most recent trace events recorded by `symbol` (if ZINT_DEBUG_TRACE set) to
+       `events`, oldest first, returning the number copied. If `events` is NULL returns the number available */
+    ZINT_EXTERN int ZBarcode_GetTrace(const struct zint_symbol *symbol, struct zint_trace_event *events,
+                    int max_events);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
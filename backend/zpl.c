@@ -0,0 +1,137 @@
+/* zpl.c - Handles output to Zebra Programming Language (ZPL) graphic field */
+/*
+    libzint - the open source barcode library
+    Copyright (C) 2026 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+#include <errno.h>
+#include <stdio.h>
+#include "common.h"
+#include "filemem.h"
+#include "output.h"
+
+/* Output repeat count `cnt` (2 to 419) using ZPL ASCII compression count chars, "G" to "Y" for 1 to 19, and "g" to
+   "z" for 20 to 400 in steps of 20 */
+static void zpl_put_count(const int cnt, struct filemem *const fmp) {
+    if (cnt >= 20) {
+        zint_fm_putc('g' + cnt / 20 - 1, fmp);
+    }
+    if (cnt % 20) {
+        zint_fm_putc('G' + cnt % 20 - 1, fmp);
+    }
+}
+
+/* Output a row of ASCII hex `hex` of length `len` using ZPL ASCII compression */
+static void zpl_put_row(const unsigned char *hex, const int len, struct filemem *const fmp) {
+    int end = len;
+    int i, j, cnt;
+
+    /* Trailing run of "0"s or "F"s to end of row can be replaced by "," or "!" respectively */
+    if (hex[len - 1] == '0' || hex[len - 1] == 'F') {
+        while (end > 0 && hex[end - 1] == hex[len - 1]) {
+            end--;
+        }
+    }
+    for (i = 0; i < end; i = j) {
+        for (j = i + 1; j < end && hex[j] == hex[i]; j++);
+        for (cnt = j - i; cnt > 0; cnt -= 419) {
+            if (cnt > 1) {
+                zpl_put_count(cnt > 419 ? 419 : cnt, fmp);
+            }
+            zint_fm_putc(hex[i], fmp);
+        }
+    }
+    if (end < len) {
+        zint_fm_putc(hex[len - 1] == '0' ? ',' : '!', fmp);
+    }
+}
+
+/* ZPL II Programming Guide, ^GF Graphic Field and "Alternative Data Compression Scheme for ~DG and ~DB Commands" */
+INTERNAL int zint_zpl_pixel_plot(struct zint_symbol *symbol, const unsigned char *pixelbuf) {
+    static const char hex_digits[] = "0123456789ABCDEF";
+    unsigned char map[128];
+    int row, i;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    const unsigned char *pb;
+    const int bytes_per_row = (symbol->bitmap_width + 7) >> 3;
+    const unsigned long total_bytes = (unsigned long) bytes_per_row * symbol->bitmap_height;
+    unsigned char *rowbuf, *prev_rowbuf, *hex;
+
+    if (!(rowbuf = (unsigned char *) malloc(bytes_per_row * 4))) {
+        return z_errtxt(ZINT_ERROR_MEMORY, symbol, 607, "Insufficient memory for ZPL row buffer");
+    }
+    prev_rowbuf = rowbuf + bytes_per_row;
+    hex = prev_rowbuf + bytes_per_row;
+
+    zint_out_mono_map(symbol, map);
+
+    /* Open output file in binary mode */
+    if (!zint_fm_open(fmp, symbol, "wb")) {
+        ZEXT z_errtxtf(0, symbol, 608, "Could not open ZPL output file (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+        free(rowbuf);
+        return ZINT_ERROR_FILE_ACCESS;
+    }
+
+    zint_fm_printf(fmp, "^XA\n^FO0,0^GFA,%lu,%lu,%d,\n", total_bytes, total_bytes, bytes_per_row);
+
+    for (row = 0, pb = pixelbuf; row < symbol->bitmap_height; row++, pb += symbol->bitmap_width) {
+        zint_out_mono_pack_row(map, pb, symbol->bitmap_width, rowbuf);
+        if (row && memcmp(rowbuf, prev_rowbuf, bytes_per_row) == 0) {
+            zint_fm_putc(':', fmp); /* Repeat previous row */
+        } else {
+            for (i = 0; i < bytes_per_row; i++) {
+                hex[i << 1] = hex_digits[rowbuf[i] >> 4];
+                hex[(i << 1) + 1] = hex_digits[rowbuf[i] & 0x0F];
+            }
+            zpl_put_row(hex, bytes_per_row << 1, fmp);
+            memcpy(prev_rowbuf, rowbuf, bytes_per_row);
+        }
+        zint_fm_putc('\n', fmp);
+    }
+
+    zint_fm_puts("^FS\n^XZ\n", fmp);
+
+    free(rowbuf);
+
+    if (zint_fm_error(fmp)) {
+        ZEXT z_errtxtf(0, symbol, 609, "Incomplete write of ZPL output (%1$d: %2$s)", fmp->err, strerror(fmp->err));
+        (void) zint_fm_close(fmp, symbol);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+
+    if (!zint_fm_close(fmp, symbol)) {
+        return ZEXT z_errtxtf(ZINT_ERROR_FILE_WRITE, symbol, 610, "Failure on closing ZPL output file (%1$d: %2$s)",
+                                fmp->err, strerror(fmp->err));
+    }
+
+    return 0;
+}
+
+/* vim: set ts=4 sw=4 et : */
@@ -95,6 +95,7 @@ SOURCES += ../backend/2of5.c \
            ../backend/dxfilmedge.c \
            ../backend/eci.c \
            ../backend/emf.c \
+           ../backend/escpos.c \
            ../backend/filemem.c \
            ../backend/general_field.c \
            ../backend/gif.c \
@@ -108,7 +109,9 @@ SOURCES += ../backend/2of5.c \
            ../backend/maxicode.c \
            ../backend/medical.c \
            ../backend/output.c \
+           ../backend/pbm.c \
            ../backend/pcx.c \
+           ../backend/pdf.c \
            ../backend/pdf417.c \
            ../backend/plessey.c \
            ../backend/png.c \
@@ -124,6 +127,7 @@ SOURCES += ../backend/2of5.c \
            ../backend/ultra.c \
            ../backend/upcean.c \
            ../backend/vector.c \
+           ../backend/zpl.c \
            ../backend/dllversion.c \
            qzint.cpp
 
@@ -77,6 +77,7 @@ SOURCES += ../backend/2of5.c \
            ../backend/dxfilmedge.c \
            ../backend/eci.c \
            ../backend/emf.c \
+           ../backend/escpos.c \
            ../backend/gridmtx.c \
            ../backend/filemem.c \
            ../backend/general_field.c \
@@ -90,7 +91,9 @@ SOURCES += ../backend/2of5.c \
            ../backend/maxicode.c \
            ../backend/medical.c \
            ../backend/output.c \
+           ../backend/pbm.c \
            ../backend/pcx.c \
+           ../backend/pdf.c \
            ../backend/pdf417.c \
            ../backend/plessey.c \
            ../backend/postal.c \
@@ -105,4 +108,5 @@ SOURCES += ../backend/2of5.c \
            ../backend/ultra.c \
            ../backend/upcean.c \
            ../backend/vector.c \
+           ../backend/zpl.c \
            qzint.cpp
@@ -22,9 +22,29 @@
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#  include <windows.h>
+#  include <direct.h>
+#  include <fcntl.h>
+#  include <io.h>
+#  include <process.h>
+#else
+#  include <fcntl.h>
+#  include <pthread.h>
+#  include <unistd.h>
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/un.h>
+#  if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+#    include <sys/mman.h>
+#    define BATCH_MMAP
+#  endif
+#endif
 
 #if !defined(_MSC_VER) && !defined(__NetBSD__) && !defined(_AIX)
 #  include <getopt.h>
@@ -49,6 +69,12 @@ typedef char static_assert_int_at_least_32bits[sizeof(int) * CHAR_BIT < 32 ? -1
 
 /* Following copied from "backend/common.h" */
 
+#ifdef _MSC_VER
+typedef unsigned __int64 uint64_t;
+#else
+#include <stdint.h> /* Introduced C99 */
+#endif
+
 #define ARRAY_SIZE(x) ((int) (sizeof(x) / sizeof((x)[0])))
 
 #ifdef _MSC_VER
@@ -169,11 +195,16 @@ static void usage(const int no_png, const int have_gs1syntaxengine) {
     version(no_png, have_gs1syntaxengine);
 
     /* Breaking up strings so don't get too long (i.e. 500 or so) */
-    printf("Encode input data in a barcode and save as BMP/EMF/EPS/GIF/PCX%s/SVG/TIF/TXT\n\n", no_png_type);
+    printf("Encode input data in a barcode and save as BMP/EMF/EPS/GIF/PBM/PCX/PDF%s/POS/SVG/TIF/TXT/ZMM/ZPL\n\n",
+            no_png_type);
     fputs( "  -b, --barcode=TYPE    Number or name of barcode type. Default is 20 (CODE128)\n"
            "  --addongap=INTEGER    Set add-on gap in multiples of X-dimension for EAN/UPC\n"
+           "  --archive=TYPE[,FILE] Write batch to single tar/stream FILE (default stdout)\n"
+           "  --async               Write batch output files on a background thread\n"
            "  --azfull              Ignore Compact Aztec Codes on automatic size selection\n"
            "  --batch               Treat each line of input file as a separate data set\n"
+           "  --batch0              As --batch but with data sets terminated by NUL not newline\n"
+           "  --batchformat=FORMAT  Batch lines as \"lines\" (default), or \"csv\"/\"tsv\" rows\n"
            "  --bg=COLOUR           Specify a background colour (as RGB(A) or \"C,M,Y,K\")\n", stdout);
     fputs( "  --binary              Treat input as raw binary data\n"
            "  --bind                Add boundary bars\n"
@@ -181,13 +212,15 @@ static void usage(const int no_png, const int have_gs1syntaxengine) {
            "  --bold                Use bold text (HRT)\n"
            "  --border=INTEGER      Set width of border in multiples of X-dimension\n", stdout);
     fputs( "  --box                 Add a box around the symbol\n"
-           "  --cmyk                Use CMYK colour space in EPS/TIF symbols\n"
+           "  --cmyk                Use CMYK colour space in EPS/PDF/TIF symbols\n"
            "  --cols=INTEGER        Set the number of data columns in symbol\n"
            "  --compliantheight     Warn if height not compliant, and use standard default\n"
-           "  -d, --data=DATA       Set the symbol data content (segment 0)\n", stdout);
+           "  -d, --data=DATA       Set the symbol data content (segment 0)\n"
+           "  --dedupe[=DIR]        Encode repeated batch lines once, caching in DIR if given\n", stdout);
     fputs( "  --direct              Send output to stdout\n"
            "  --dmb256[=INTEGER]    Start Data Matrix in Base 256 for given length (0 all)\n"
            "  --dmc40[=INTEGER]     Start Data Matrix in C40 mode for given length (0 all)\n"
+           "  --dmfit[=R[,W,H]]     Choose Data Matrix size best fitting ratio R and max W x H\n"
            "  --dmiso144            Use ISO format for 144x144 Data Matrix symbols\n"
            "  --dmre                Allow Data Matrix Rectangular Extended\n", stdout);
     fputs( "  --dotsize=NUMBER      Set radius of dots in dotty mode\n"
@@ -195,13 +228,15 @@ static void usage(const int no_png, const int have_gs1syntaxengine) {
            "  --dump                Dump hexadecimal representation to stdout\n"
            "  -e, --ecinos          Display ECI (Extended Channel Interpretation) table\n"
            "  --eci=INTEGER         Set the ECI code for the data (segment 0)\n", stdout);
-    fputs( "  --embedfont           Embed font in vector output (SVG only)\n"
+    fputs( "  --embedfont           Embed font in vector output (PDF/SVG only)\n"
            "  --esc                 Process escape sequences in input data\n"
            "  --extraesc            Process extra symbology-specific escape sequences\n"
            "  --fast                Use faster encodation or other shortcuts if available\n"
            "  --fg=COLOUR           Specify a foreground colour (as RGB(A) or \"C,M,Y,K\")\n", stdout);
-    printf("  --filetype=TYPE       Set output file type BMP/EMF/EPS/GIF/PCX%s/SVG/TIF/TXT\n", no_png_type);
-    fputs( "  --fullmultibyte       Use multibyte for binary/Latin (QR/Han Xin/Grid Matrix)\n"
+    printf("  --filetype=TYPE       Set output file type BMP/EMF/EPS/GIF/PBM/PCX/PDF%s/POS/SVG/\n"
+           "                        TIF/TXT/ZMM/ZPL\n", no_png_type);
+    fputs( "  --fsync               Sync batch output files to disk once all written\n"
+           "  --fullmultibyte       Use multibyte for binary/Latin (QR/Han Xin/Grid Matrix)\n"
            "  --gs1                 Treat input as GS1 compatible data\n"
            "  --gs1nocheck          Do not check validity of GS1 data\n"
            "  --gs1parens           Process parentheses \"()\" as GS1 AI delimiters, not \"[]\"\n"
@@ -217,10 +252,11 @@ if (have_gs1syntaxengine) {
     fputs( "  --heightperrow        Treat height as per-row\n"
            "  -i, --input=FILE      Read input data from FILE\n"
            "  --init                Create Reader Initialisation (Programming) symbol\n"
+           "  -j, --jobs=INTEGER    Encode batch using INTEGER threads (0 for all CPUs)\n"
            "  --mask=INTEGER        Set masking pattern to use (QR/Han Xin/DotCode)\n"
            "  --mirror              Use data to determine filename\n", stdout);
     fputs( "  --mode=INTEGER        Set encoding mode (MaxiCode/Composite)\n", stdout);
-    printf("  --nobackground        Remove background (EMF/EPS/GIF%s/SVG/TIF only)\n", no_png_type);
+    printf("  --nobackground        Remove background (EMF/EPS/GIF/PDF%s/SVG/TIF only)\n", no_png_type);
     fputs( "  --noquietzones        Disable default quiet zones\n"
            "  --notext              Remove human readable text (HRT)\n", stdout);
     printf("  -o, --output=FILE     Send output to FILE. Default is out.%s\n", no_png_ext);
@@ -235,11 +271,17 @@ if (have_gs1syntaxengine) {
            "  --secure=INTEGER      Set error correction level (ECC)\n"
            "  --segN=ECI,DATA       Set the ECI & data content for segment N, where N 1 to 9\n", stdout);
     fputs( "  --separator=INTEGER   Set height of row separator bars (stacked symbologies)\n"
+           "  --sequence=S,E[,I,F]  Batch encode numbers S to E step I formatted by F\n"
+           "  --serve[=SOCKET]      Answer framed requests on stdin/stdout or Unix SOCKET\n"
+           "  --shard=INTEGER       Write batch output files in INTEGER hex digit hash subdirs\n"
+           "  --sheet=C[xR][,M,G]   Output batch on sheet(s) C symbols across, R down\n"
            "  --small               Use small text (HRT)\n"
            "  --square              Force Data Matrix symbols to be square\n"
+           "  --stats               Print totals, throughput & phase timings at end (stderr)\n"
            "  --structapp=I,C[,ID]  Set Structured Append info (I index, C count)\n"
            "  -t, --types           Display table of barcode types\n", stdout);
     fputs( "  --textgap=NUMBER      Adjust gap between barcode and HRT in multiples of X-dim\n"
+           "  --trace=FILE          Write Chrome trace-event JSON of encode/output phases\n"
            "  --verbose             Output debug info to stdout\n"
            "  --vers=INTEGER        Set symbol version (size, check digits, other options)\n"
            "  -v, --version         Display Zint version\n"
@@ -715,7 +757,7 @@ static int get_barcode_name(const char *const barcode_name) {
 /* Whether `filetype` supported by Zint. Sets `png_refused` if `no_png` and PNG requested */
 static int supported_filetype(const char *const filetype, const int no_png, int *const png_refused) {
     static const char filetypes[][4] = {
-        "bmp", "emf", "eps", "gif", "pcx", "png", "svg", "tif", "txt",
+        "bmp", "emf", "eps", "gif", "pbm", "pcx", "pdf", "png", "pos", "svg", "tif", "txt", "zmm", "zpl",
     };
     char lc_filetype[5];
     int i;
@@ -791,7 +833,7 @@ static void set_extension(char file[256], const char *const filetype) {
 /* Whether `filetype` is raster type */
 static int is_raster(const char *const filetype, const int no_png) {
     static const char raster_filetypes[][4] = {
-        "bmp", "gif", "pcx", "png", "tif",
+        "bmp", "gif", "pbm", "pcx", "png", "pos", "tif", "zpl",
     };
     int i;
     char lc_filetype[4];
@@ -899,6 +941,51 @@ static int validate_scalexdimdp(const char *const arg, float *const p_x_dim_mm,
     return 1;
 }
 
+/* Parse and validate argument "[aspect][,width,height]" to "--dmfit", `width` & `height` in mm (or inches) */
+static int validate_dmfit(const char *const arg, float *const p_aspect, float *const p_width_mm,
+            float *const p_height_mm, char errbuf[ERRBUF_SIZE]) {
+    static const char units[][5] = { "mm", "in" };
+    static const char names[3][7] = { "aspect", "width", "height" };
+    char buf[7 + 1 + 4 + 1]; /* Allow for 7 digits + dot + 4-char unit + NUL */
+    float vals[3] = { 0.0f, 0.0f, 0.0f };
+    int units_i = 0; /* For `validate_units()` */
+    char *units_err; /* For `validate_units()` */
+    char errbuf_float[ERRBUF_SIZE]; /* For `validate_float()` */
+    const char *s = arg;
+    int i;
+
+    for (i = 0; i < 3 && s; i++) {
+        const char *const comma = strchr(s, ',');
+        const int len = comma ? (int) (comma - s) : (int) strlen(s);
+        if ((i && !len) || len >= ARRAY_SIZE(buf)) {
+            sprintf(errbuf, "dmfit %s too %s", names[i], len ? "long" : "short");
+            return 0;
+        }
+        ncpy_str(buf, ARRAY_SIZE(buf), s, len);
+        if (i && (units_i = validate_units(buf, units, ARRAY_SIZE(units), &units_err)) < 0) {
+            sprintf(errbuf, "dmfit %s unknown units: %.20s", names[i], units_err);
+            return 0;
+        }
+        if (len && !validate_float(buf, 0 /*allow_neg*/, &vals[i], errbuf_float)) {
+            sprintf(errbuf, "dmfit %s invalid floating point: %.60s", names[i], errbuf_float);
+            return 0;
+        }
+        if (units_i > 0) { /* Ignore mm */
+            vals[i] *= 25.4f /*in*/;
+        }
+        s = comma ? comma + 1 : NULL;
+    }
+    if (s || i == 2) {
+        cpy_str(errbuf, ERRBUF_SIZE, s ? "dmfit too many values (maximum 3)" : "dmfit height missing");
+        return 0;
+    }
+    *p_aspect = vals[0];
+    *p_width_mm = vals[1];
+    *p_height_mm = vals[2];
+
+    return 1;
+}
+
 /* Parse and validate Structured Append argument "index,count[,ID]" to "--structapp" */
 static int validate_structapp(const char *const arg, struct zint_structapp *const structapp,
             char errbuf[ERRBUF_SIZE]) {
@@ -967,6 +1054,190 @@ static int validate_structapp(const char *const arg, struct zint_structapp *cons
     return 1;
 }
 
+/* Parse and validate sheet argument "cols[xrows][,margin[,gap]]" to "--sheet" */
+static int validate_sheet(const char *const arg, struct zint_sheet *const sheet, char errbuf[ERRBUF_SIZE]) {
+    char buf[32];
+    char *comma, *comma2 = NULL, *x;
+
+    if (strlen(arg) >= ARRAY_SIZE(buf)) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Sheet argument too long");
+        return 0;
+    }
+    cpy_str(buf, ARRAY_SIZE(buf), arg);
+    if ((comma = strchr(buf, ',')) != NULL) {
+        *comma++ = '\0';
+        if ((comma2 = strchr(comma, ',')) != NULL) {
+            *comma2++ = '\0';
+        }
+    }
+    if ((x = strchr(buf, 'x')) != NULL || (x = strchr(buf, 'X')) != NULL) {
+        *x++ = '\0';
+    }
+    if (!*buf || !validate_int(buf, -1 /*len*/, &sheet->cols) || sheet->cols < 1 || sheet->cols > 1000) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Invalid sheet columns (digits only, 1 to 1000)");
+        return 0;
+    }
+    if (x && (!*x || !validate_int(x, -1 /*len*/, &sheet->rows) || sheet->rows < 1 || sheet->rows > 1000)) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Invalid sheet rows (digits only, 1 to 1000)");
+        return 0;
+    }
+    if (comma) {
+        char float_errbuf[ERRBUF_SIZE];
+        if (!validate_float(comma, 0 /*allow_neg*/, &sheet->margin, float_errbuf)) {
+            sprintf(errbuf, "Invalid sheet margin floating point (%.60s)", float_errbuf);
+            return 0;
+        }
+        if (comma2 && !validate_float(comma2, 0 /*allow_neg*/, &sheet->gap, float_errbuf)) {
+            sprintf(errbuf, "Invalid sheet gap floating point (%.60s)", float_errbuf);
+            return 0;
+        }
+        if (sheet->margin > 1000.0f || sheet->gap > 1000.0f) {
+            cpy_str(errbuf, ERRBUF_SIZE, "Sheet margin and gap must be 1000 or less");
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#define BATCH_ARCHIVE_TAR       1   /* POSIX ustar archive */
+#define BATCH_ARCHIVE_STREAM    2   /* Length-prefixed record stream */
+
+/* Batch mode - single archive or stream that all outputs are written to, as given by "--archive" */
+struct batch_archive {
+    int type;               /* BATCH_ARCHIVE_XXX */
+    char filename[256];     /* Archive filename, empty for stdout */
+    FILE *fp;
+    unsigned long mtime;    /* Modification time of tar entries */
+    int error;              /* Set on write failure */
+};
+
+/* Parse and validate archive argument "type[,file]" to "--archive" */
+static int validate_archive(const char *const arg, struct batch_archive *const archive,
+            char errbuf[ERRBUF_SIZE]) {
+    const char *const comma = strchr(arg, ',');
+    const int len = comma ? (int) (comma - arg) : (int) strlen(arg);
+    char type[8];
+
+    if (len >= ARRAY_SIZE(type)) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Invalid archive type (\"tar\" or \"stream\" only)");
+        return 0;
+    }
+    ncpy_str(type, ARRAY_SIZE(type), arg, len);
+    to_lower(type);
+    if (strcmp(type, "tar") == 0) {
+        archive->type = BATCH_ARCHIVE_TAR;
+    } else if (strcmp(type, "stream") == 0) {
+        archive->type = BATCH_ARCHIVE_STREAM;
+    } else {
+        cpy_str(errbuf, ERRBUF_SIZE, "Invalid archive type (\"tar\" or \"stream\" only)");
+        return 0;
+    }
+    archive->filename[0] = '\0';
+    if (comma) {
+        if (!comma[1] || strlen(comma + 1) >= ARRAY_SIZE(archive->filename)) {
+            cpy_str(errbuf, ERRBUF_SIZE, "Invalid archive filename (1 to 255 characters)");
+            return 0;
+        }
+        if (strcmp(comma + 1, "-") != 0) {
+            cpy_str(archive->filename, ARRAY_SIZE(archive->filename), comma + 1);
+        }
+    }
+    return 1;
+}
+
+#define SEQUENCE_MAX_DIGITS 18 /* Maximum number of digits of `--sequence` start, end and step */
+
+/* Sequence mode - arguments of "--sequence", items being generated by `ZBarcode_Sequence_Item()` */
+struct batch_sequence {
+    char start[SEQUENCE_MAX_DIGITS + 1];
+    char step[SEQUENCE_MAX_DIGITS + 1];
+    int count;              /* Number of items */
+    const char *format;     /* Item format, empty if none */
+};
+
+/* Parse `len` decimal digits of `str` (1 to `SEQUENCE_MAX_DIGITS`) into `p_val`, copying them NUL-terminated to
+   `buf` if non-NULL. Returns 0 if invalid */
+static int validate_sequence_num(const char *const str, const int len, uint64_t *const p_val, char *const buf) {
+    int i;
+
+    if (len < 1 || len > SEQUENCE_MAX_DIGITS) {
+        return 0;
+    }
+    for (i = 0, *p_val = 0; i < len; i++) {
+        if (!z_isdigit(str[i])) {
+            return 0;
+        }
+        *p_val = *p_val * 10 + (str[i] - '0');
+    }
+    if (buf) {
+        ncpy_str(buf, SEQUENCE_MAX_DIGITS + 1, str, len);
+    }
+    return 1;
+}
+
+/* Parse and validate sequence argument "start,end[,step[,format]]" to "--sequence" */
+static int validate_sequence(const char *const arg, struct batch_sequence *const seq, char errbuf[ERRBUF_SIZE]) {
+    const char *const comma = strchr(arg, ',');
+    const char *comma2 = NULL, *comma3 = NULL;
+    uint64_t start, end, step = 1;
+    unsigned char item[ZINT_MAX_DATA_LEN];
+    int len, item_len, bad_item = 0;
+
+    if (!comma) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Invalid sequence argument, expect \"start,end[,step[,format]]\"");
+        return 0;
+    }
+    if (!validate_sequence_num(arg, (int) (comma - arg), &start, seq->start)) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Invalid sequence start (1 to 18 digits only)");
+        return 0;
+    }
+    if ((comma2 = strchr(comma + 1, ',')) != NULL) {
+        comma3 = strchr(comma2 + 1, ',');
+    }
+    len = comma2 ? (int) (comma2 - (comma + 1)) : (int) strlen(comma + 1);
+    if (!validate_sequence_num(comma + 1, len, &end, NULL)) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Invalid sequence end (1 to 18 digits only)");
+        return 0;
+    }
+    cpy_str(seq->step, ARRAY_SIZE(seq->step), "1");
+    if (comma2) {
+        len = comma3 ? (int) (comma3 - (comma2 + 1)) : (int) strlen(comma2 + 1);
+        if (!validate_sequence_num(comma2 + 1, len, &step, seq->step) || step == 0) {
+            cpy_str(errbuf, ERRBUF_SIZE, "Invalid sequence step (1 to 18 digits only, non-zero)");
+            return 0;
+        }
+    }
+    seq->format = comma3 ? comma3 + 1 : "";
+    if (strlen(seq->format) >= ZINT_MAX_DATA_LEN) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Sequence format too long");
+        return 0;
+    }
+    if (end < start) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Sequence end less than start");
+        return 0;
+    }
+    if ((end - start) / step >= 1999999999) {
+        cpy_str(errbuf, ERRBUF_SIZE, "Sequence too long (maximum 1999999999 items)");
+        return 0;
+    }
+    seq->count = (int) ((end - start) / step) + 1;
+
+    /* An item only fails to fit `format` if it has too many digits for its placeholders, or too few to put one
+       before a check digit "?", so suffices to check the first and last */
+    if (ZBarcode_Sequence_Item(seq->start, seq->step, 0, seq->format, item, &item_len) != 0) {
+        bad_item = 1;
+    } else if (ZBarcode_Sequence_Item(seq->start, seq->step, seq->count - 1, seq->format, item, &item_len) != 0) {
+        bad_item = seq->count;
+    }
+    if (bad_item) {
+        sprintf(errbuf, "Sequence item %d does not fit format '%.60s'", bad_item, seq->format);
+        assert(strlen(errbuf) < ERRBUF_SIZE);
+        return 0;
+    }
+
+    return 1;
+}
+
 /* Parse and validate the segment argument "ECI,DATA" to "--segN" */
 static int validate_seg(const char *const arg, const int N, struct zint_seg segs[10], char errbuf[ERRBUF_SIZE]) {
     char eci[10];
@@ -1083,188 +1354,2816 @@ static void mirror_outfile(struct zint_symbol *const symbol, const unsigned char
         o++;
     } while (i < length && o < 251);
 
-    /* Add file extension */
-    output_file[o] = '.';
-    ncpy_str(output_file + o + 1, ARRAY_SIZE(symbol->outfile) - o - 1, filetype, 3);
+    /* Add file extension */
+    output_file[o] = '.';
+    ncpy_str(output_file + o + 1, ARRAY_SIZE(symbol->outfile) - o - 1, filetype, 3);
+}
+
+#ifdef _WIN32
+static FILE *win_fopen(const char *const filename, const char *const mode); /* Forward ref */
+static int win_mkdir(const char *const dirname); /* Forward ref */
+#endif
+
+/* Return copy of the settings of unencoded `symbol`, or NULL if memory allocation fails */
+static struct zint_symbol *clone_symbol(const struct zint_symbol *const symbol) {
+    struct zint_symbol *const clone = ZBarcode_Create();
+
+    if (clone) {
+        memcpy(clone, symbol, sizeof(struct zint_symbol));
+        clone->fgcolor = clone->fgcolour;
+        clone->bgcolor = clone->bgcolour;
+        memset(&clone->stats, 0, sizeof(clone->stats));
+        clone->trace = NULL;
+        clone->delta = NULL;
+    }
+    return clone;
+}
+
+/* Add the stats accumulated by `from` to those of `symbol` */
+static void stats_merge(struct zint_symbol *const symbol, const struct zint_symbol *const from) {
+    struct zint_stats stats;
+    int i;
+
+    if (ZBarcode_GetStats(from, &stats) == 0) {
+        for (i = 0; i < ZINT_STATS_PHASES; i++) {
+            symbol->stats.time[i] += stats.time[i];
+            symbol->stats.count[i] += stats.count[i];
+        }
+        symbol->stats.bytes_in += stats.bytes_in;
+        symbol->stats.bytes_out += stats.bytes_out;
+    }
+}
+
+/* Current time in seconds from an arbitrary base (same as "backend/common.c") */
+static double stats_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double) count.QuadPart / (double) freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    (void) clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ts.tv_nsec / 1e9;
+#else
+    return (double) clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/* Names of stats phases ZINT_STATS_XXX */
+static const char stats_names[ZINT_STATS_PHASES][8] = {
+    "input", "modes", "ecc", "mask", "place", "build", "file", "encode", "output"
+};
+
+/* Print to stderr the totals, throughput and per-phase timings accumulated by `symbol` over `elapsed` seconds */
+static void stats_print(const struct zint_symbol *const symbol, const double elapsed) {
+    struct zint_stats stats;
+    const double secs = elapsed > 0.0 ? elapsed : 1e-9;
+    int i;
+
+    if (ZBarcode_GetStats(symbol, &stats) != 0) {
+        fprintf(stderr, "Warning 250: Stats not available in this build, ignoring\n");
+        fflush(stderr);
+        return;
+    }
+    fprintf(stderr, "Stats: %u encodes, %u outputs in %.3f s (%.1f/s), %.0f bytes in, %.0f bytes out (%.2f MB/s)\n",
+            stats.count[ZINT_STATS_ENCODE], stats.count[ZINT_STATS_OUTPUT], elapsed,
+            stats.count[ZINT_STATS_ENCODE] / secs, stats.bytes_in, stats.bytes_out, stats.bytes_out / secs / 1e6);
+    fprintf(stderr, "  %-8s %10s %12s %12s\n", "phase", "count", "total ms", "mean us");
+    for (i = 0; i < ZINT_STATS_PHASES; i++) {
+        if (stats.count[i]) {
+            fprintf(stderr, "  %-8s %10u %12.3f %12.3f\n", stats_names[i], stats.count[i], stats.time[i] * 1e3,
+                    stats.time[i] * 1e6 / stats.count[i]);
+        }
+    }
+    fflush(stderr);
+}
+
+/* Trace output file (`--trace`) */
+struct trace_file {
+    const char *filename;
+    FILE *fp;
+    int count;              /* Number of events written */
+    int tids;               /* Highest thread id named */
+    int error;
+};
+
+/* Open `trace` for writing as Chrome trace-event JSON, returning 0 on failure */
+static int trace_open(struct trace_file *const trace) {
+#ifdef _WIN32
+    trace->fp = win_fopen(trace->filename, "wb");
+#else
+    trace->fp = fopen(trace->filename, "wb");
+#endif
+    if (!trace->fp) {
+        fprintf(stderr, "Error 252: Unable to open trace file '%s' (%d: %s)\n", trace->filename, errno,
+                strerror(errno));
+        fflush(stderr);
+        return 0;
+    }
+    trace->count = trace->tids = 0;
+    trace->error = fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                         "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"main\"}}",
+                         trace->fp) < 0;
+    return 1;
+}
+
+/* Write the trace events recorded by `symbol` to `trace` as thread `tid` */
+static void trace_write(struct trace_file *const trace, const struct zint_symbol *const symbol, const int tid) {
+    struct zint_trace_event *events;
+    char name[32];
+    int cnt, i;
+
+    if (trace->error || (cnt = ZBarcode_GetTrace(symbol, NULL /*events*/, 0)) <= 0) {
+        return;
+    }
+    if (!(events = (struct zint_trace_event *) malloc(sizeof(struct zint_trace_event) * cnt))) {
+        trace->error = 1;
+        return;
+    }
+    cnt = ZBarcode_GetTrace(symbol, events, cnt);
+    if (tid > trace->tids) {
+        fprintf(trace->fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                "\"args\":{\"name\":\"worker %d\"}}", tid, tid);
+        trace->tids = tid;
+    }
+    for (i = 0; i < cnt; i++) {
+        const struct zint_trace_event *const event = events + i;
+        if (ZBarcode_BarcodeName(event->symbology, name)) {
+            cpy_str(name + 8, ARRAY_SIZE(name) - 8, "UNKNOWN");
+        }
+        fprintf(trace->fp, ",\n{\"name\":\"%s\",\"cat\":\"zint\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"symbology\":\"%s\",\"length\":%d,\"rows\":%d,"
+                "\"width\":%d,\"bytes\":%d}}", stats_names[event->phase], tid, event->ts * 1e6,
+                event->dur * 1e6, name + 8, event->length, event->rows, event->width, event->bytes);
+    }
+    trace->count += cnt;
+    free(events);
+}
+
+/* Close `trace`, returning ZINT_ERROR_FILE_WRITE on failure */
+static int trace_close(struct trace_file *const trace) {
+    if (fputs("\n]}\n", trace->fp) < 0 || fflush(trace->fp) != 0) {
+        trace->error = 1;
+    }
+    if (fclose(trace->fp) != 0) {
+        trace->error = 1;
+    }
+    trace->fp = NULL;
+    if (trace->error) {
+        fprintf(stderr, "Error 253: Failure writing trace file '%s' (%d: %s)\n", trace->filename, errno,
+                strerror(errno));
+        fflush(stderr);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+    return 0;
+}
+
+/* Sheet batch mode - encode line `line_count` of `length` into a copy of `symbol` and add it to `p_sheet_symbols`
+   for outputting at end */
+static int batch_sheet_add(const struct zint_symbol *const symbol, const unsigned char *const buffer,
+            const int length, const int line_count, struct zint_symbol ***p_sheet_symbols, int *p_sheet_cnt,
+            int *p_sheet_size) {
+    struct zint_symbol *line_symbol;
+    int ret;
+
+    if (*p_sheet_cnt == *p_sheet_size) {
+        const int new_size = *p_sheet_size ? *p_sheet_size * 2 : 64;
+        struct zint_symbol **const sheet_symbols = (struct zint_symbol **) realloc(*p_sheet_symbols,
+                                                        sizeof(struct zint_symbol *) * new_size);
+        if (!sheet_symbols) {
+            fprintf(stderr, "On line %d: Error 197: Insufficient memory for sheet\n", line_count);
+            fflush(stderr);
+            return ZINT_ERROR_MEMORY;
+        }
+        *p_sheet_symbols = sheet_symbols;
+        *p_sheet_size = new_size;
+    }
+    if (!(line_symbol = clone_symbol(symbol))) {
+        fprintf(stderr, "On line %d: Error 198: Insufficient memory for sheet symbol\n", line_count);
+        fflush(stderr);
+        return ZINT_ERROR_MEMORY;
+    }
+    ret = ZBarcode_Encode(line_symbol, buffer, length);
+    if (ret != 0) {
+        fprintf(stderr, "On line %d: %s\n", line_count, line_symbol->errtxt);
+        fflush(stderr);
+        if (ret >= ZINT_ERROR) {
+            ZBarcode_Delete(line_symbol);
+            return ret;
+        }
+    }
+    (*p_sheet_symbols)[(*p_sheet_cnt)++] = line_symbol;
+
+    return ret;
+}
+
+#define BATCH_READ_SIZE     (1024 * 1024) /* Size of batch input buffer when not memory-mapped */
+
+/* Batch mode - input file and state of record (line) splitting. Records are handed out as views into either the
+   memory-mapped file or a block buffer, without copying. If `seq` given records are instead generated into the
+   block buffer */
+struct batch_reader {
+    FILE *file;
+    const struct batch_sequence *seq; /* Sequence mode arguments, NULL if reading `file` */
+    int seq_idx;            /* Index of next item of `seq` */
+    int delim;              /* Record delimiter, '\n' or '\0' for `--batch0` */
+    const unsigned char *buf; /* Mapped file or `block` */
+    unsigned char *block;   /* Block buffer if not mapped */
+    size_t pos;             /* Start of next record in `buf` */
+    size_t end;             /* End of data in `buf` */
+    int mapped;             /* Set if `buf` is the memory-mapped file, in which case views stay valid */
+    int eof;                /* Set if nothing more to be read into `buf` */
+    int last_ch;            /* Last character consumed (-1 if none), used to detect unterminated last record */
+};
+
+/* Batch mode - set up `reader` for `file`, memory-mapping it if possible (POSIX regular files), otherwise allocating
+   a block buffer. If `seq` given `file` is ignored and records are generated from `seq` instead. Returns 0 on
+   memory allocation failure */
+static int batch_reader_init(struct batch_reader *const reader, FILE *const file, const int delim,
+            const struct batch_sequence *const seq) {
+    memset(reader, 0, sizeof(*reader));
+    reader->file = file;
+    reader->seq = seq;
+    reader->delim = delim;
+    reader->last_ch = seq ? delim : -1;
+#ifdef BATCH_MMAP
+    if (!seq) {
+        struct stat st;
+        const int fd = fileno(file);
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0
+                && st.st_size == (off_t) (size_t) st.st_size) {
+            void *const map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map != MAP_FAILED) {
+#ifdef POSIX_MADV_SEQUENTIAL
+                (void) posix_madvise(map, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+                reader->buf = (const unsigned char *) map;
+                reader->end = (size_t) st.st_size;
+                reader->mapped = 1;
+                reader->eof = 1;
+                return 1;
+            }
+        }
+    }
+#endif
+    if (!(reader->block = (unsigned char *) malloc(BATCH_READ_SIZE))) {
+        return 0;
+    }
+    reader->buf = reader->block;
+    return 1;
+}
+
+/* Batch mode - unmap or free buffer of `reader` */
+static void batch_reader_free(struct batch_reader *const reader) {
+#ifdef BATCH_MMAP
+    if (reader->mapped) {
+        (void) munmap((void *) reader->buf, reader->end);
+    }
+#endif
+    free(reader->block);
+    reader->buf = reader->block = NULL;
+}
+
+/* Batch mode - move any partial record to start of block buffer and read more input, setting `reader->eof` if
+   none */
+static void batch_reader_fill(struct batch_reader *const reader) {
+    const size_t partial = reader->end - reader->pos;
+    size_t cnt;
+
+    if (reader->mapped || reader->eof) {
+        reader->eof = 1;
+        return;
+    }
+    if (partial && reader->pos) {
+        memmove(reader->block, reader->block + reader->pos, partial);
+    }
+    reader->pos = 0;
+    reader->end = partial;
+    if ((cnt = fread(reader->block + partial, 1, BATCH_READ_SIZE - partial, reader->file)) == 0) {
+        reader->eof = 1;
+    }
+    reader->end += cnt;
+}
+
+/* Batch mode - get a view of the next record of input in `*p_record`, excluding its delimiter (and CR if
+   newline-delimited CR+LF), setting `*p_length`. The view is valid until the next call, or if `reader->mapped` until
+   `batch_reader_free()`. Returns 1 if record read, 0 if end of input (ignoring any unterminated record), and -1 if
+   record too long (`ZINT_MAX_DATA_LEN` or more), in which case it's skipped */
+static int batch_read_line(struct batch_reader *const reader, const unsigned char **p_record, int *p_length) {
+    const unsigned char *delim_ptr;
+    size_t length;
+    int too_long = 0;
+
+    if (reader->seq) {
+        if (reader->seq_idx == reader->seq->count) {
+            *p_length = 0;
+            return 0;
+        }
+        /* Can't fail as all item lengths checked by `validate_sequence()` */
+        (void) ZBarcode_Sequence_Item(reader->seq->start, reader->seq->step, reader->seq_idx++, reader->seq->format,
+                                        reader->block, p_length);
+        *p_record = reader->block;
+        return 1;
+    }
+
+    for (;;) {
+        const unsigned char *const record = reader->buf + reader->pos;
+        const size_t avail = reader->end - reader->pos;
+
+        if ((delim_ptr = (const unsigned char *) memchr(record, reader->delim, avail))) {
+            length = delim_ptr - record;
+            reader->pos += length + 1;
+            reader->last_ch = reader->delim;
+            if (too_long || length >= ZINT_MAX_DATA_LEN) {
+                *p_length = 0;
+                return -1;
+            }
+            if (reader->delim == '\n' && length && record[length - 1] == '\r') {
+                /* CR+LF - assume Windows formatting and remove CR */
+                length--;
+            }
+            /* Views aren't NUL-terminated so use empty string for zero length (taken as NUL-terminated by API) */
+            *p_record = length ? record : ZCUCP("");
+            *p_length = (int) length;
+            return 1;
+        }
+        if (avail) {
+            reader->last_ch = record[avail - 1];
+        }
+        if (avail >= ZINT_MAX_DATA_LEN) {
+            /* Discard and keep looking for delimiter */
+            too_long = 1;
+            reader->pos = reader->end;
+        }
+        if (reader->eof) {
+            reader->pos = reader->end;
+            *p_length = 0;
+            return too_long ? -1 : 0;
+        }
+        batch_reader_fill(reader);
+    }
+}
+
+/* Batch mode - set `output_file` for line `line_count` from `format_string`, replacing "#", "~" and "@" from the
+   right with the digits of `line_count`, or when the digits run out with space, "0" and "*" ("+" on Windows)
+   respectively */
+static void batch_outfile(const char *const format_string, const int line_count, char *const output_file) {
+    char number[12], reverse_number[12];
+    char reversed_string[256];
+    char *rs = reversed_string;
+    int inpos = 0;
+    int local_line_count = line_count;
+    const int format_len = (int) strlen(format_string);
+    int i;
+
+    do {
+        number[inpos++] = (local_line_count % 10) + '0';
+        local_line_count /= 10;
+    } while (local_line_count > 0);
+
+    for (i = 0; i < inpos; i++) {
+        reverse_number[i] = number[inpos - i - 1];
+    }
+
+    for (i = format_len; i > 0; i--) {
+        char adjusted;
+
+        switch (format_string[i - 1]) {
+            case '#':
+                if (inpos > 0) {
+                    adjusted = reverse_number[inpos - 1];
+                    inpos--;
+                } else {
+                    adjusted = ' ';
+                }
+                break;
+            case '~':
+                if (inpos > 0) {
+                    adjusted = reverse_number[inpos - 1];
+                    inpos--;
+                } else {
+                    adjusted = '0';
+                }
+                break;
+            case '@':
+                if (inpos > 0) {
+                    adjusted = reverse_number[inpos - 1];
+                    inpos--;
+                } else {
+#ifndef _WIN32
+                    adjusted = '*';
+#else
+                    adjusted = '+';
+#endif
+                }
+                break;
+            default:
+                adjusted = format_string[i - 1];
+                break;
+        }
+        *rs++ = adjusted;
+    }
+
+    for (i = 0; i < format_len; i++) {
+        output_file[i] = reversed_string[format_len - i - 1];
+    }
+    output_file[format_len] = '\0';
+}
+
+/* Batch mode - open `archive` for writing, returning 0 on failure */
+static int batch_archive_open(struct batch_archive *const archive) {
+    if (!archive->filename[0]) {
+#ifdef _WIN32
+        (void) _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        archive->fp = stdout;
+    } else {
+#ifdef _WIN32
+        archive->fp = win_fopen(archive->filename, "wb");
+#else
+        archive->fp = fopen(archive->filename, "wb");
+#endif
+        if (!archive->fp) {
+            fprintf(stderr, "Error 213: Unable to open archive file '%s' (%d: %s)\n", archive->filename, errno,
+                    strerror(errno));
+            fflush(stderr);
+            return 0;
+        }
+    }
+    archive->mtime = (unsigned long) time(NULL);
+    archive->error = 0;
+    if (archive->type == BATCH_ARCHIVE_STREAM) {
+        archive->error = fwrite("ZBS1", 1, 4, archive->fp) != 4;
+    }
+    return 1;
+}
+
+/* Batch mode - put `n` into `field` of `size` as zero-padded octal digits followed by NUL (tar header) */
+static void batch_tar_octal(unsigned char *const field, const int size, unsigned long n) {
+    int i;
+
+    field[size - 1] = '\0';
+    for (i = size - 2; i >= 0; i--) {
+        field[i] = (unsigned char) ('0' + (n & 7));
+        n >>= 3;
+    }
+}
+
+/* Batch mode - put `n` into `b` as `size` bytes little-endian (stream record) */
+static void batch_le(unsigned char *const b, unsigned long n, const int size) {
+    int i;
+
+    for (i = 0; i < size; i++) {
+        b[i] = (unsigned char) (n & 0xFF);
+        n >>= 8;
+    }
+}
+
+/* Batch mode - add tar entry `filename` of `size` bytes `data`, returning 0 if `filename` too long */
+static int batch_archive_tar(struct batch_archive *const archive, const char *const filename,
+            const unsigned char *const data, const int size) {
+    static const unsigned char zeroes[512] = {0};
+    unsigned char header[512] = {0};
+    const int len = (int) strlen(filename);
+    int name_o = 0; /* Offset of name, prefix before if any */
+    unsigned long chksum = 0;
+    int i;
+
+    if (len > 100) {
+        /* Split at a slash into prefix (max 155) and name (max 100) */
+        for (name_o = len - 100; name_o <= 156 && name_o < len && filename[name_o - 1] != '/'; name_o++);
+        if (name_o > 156 || name_o == len) {
+            return 0;
+        }
+        memcpy(header + 345, filename, name_o - 1);
+    }
+    memcpy(header, filename + name_o, len - name_o);
+    memcpy(header + 100, "0000644", 7); /* mode */
+    memcpy(header + 108, "0000000", 7); /* uid */
+    memcpy(header + 116, "0000000", 7); /* gid */
+    batch_tar_octal(header + 124, 12, (unsigned long) size);
+    batch_tar_octal(header + 136, 12, archive->mtime);
+    memset(header + 148, ' ', 8); /* Checksum calculated with spaces */
+    header[156] = '0'; /* Regular file */
+    memcpy(header + 257, "ustar", 6);
+    memcpy(header + 263, "00", 2);
+    for (i = 0; i < 512; i++) {
+        chksum += header[i];
+    }
+    batch_tar_octal(header + 148, 7, chksum);
+
+    if (fwrite(header, 1, 512, archive->fp) != 512 || (size && fwrite(data, 1, size, archive->fp) != (size_t) size)
+            || ((size & 511) && fwrite(zeroes, 1, 512 - (size & 511), archive->fp) != (size_t) (512 - (size & 511)))) {
+        archive->error = 1;
+    }
+    return 1;
+}
+
+/* Batch mode - add output of line `line_count` to `archive`, `ret` and `errtxt` being the result of encoding and
+   `data` & `size` the in-memory output (if any). For tar, only lines with output are added. Returns non-zero and
+   reports error if can't be added */
+static int batch_archive_add(struct batch_archive *const archive, const int line_count, const char *const filename,
+            const int ret, const char *const errtxt, const unsigned char *const data, const int size) {
+    if (archive->error) {
+        return 0; /* Reported on close */
+    }
+    if (archive->type == BATCH_ARCHIVE_TAR) {
+        if (data && !batch_archive_tar(archive, filename, data, size)) {
+            fprintf(stderr, "On line %d: Error 215: Filename '%s' too long for tar archive\n", line_count,
+                    filename);
+            fflush(stderr);
+            return ZINT_ERROR_INVALID_OPTION;
+        }
+    } else {
+        /* Record: u32 line, i32 return, u16 filename length, filename, u16 errtxt length, errtxt, u32 data size,
+           data (all little-endian) */
+        const int filename_len = (int) strlen(filename);
+        const int errtxt_len = ret ? (int) strlen(errtxt) : 0;
+        const int data_size = data ? size : 0;
+        unsigned char b[10];
+
+        batch_le(b, (unsigned long) line_count, 4);
+        batch_le(b + 4, (unsigned long) ret, 4);
+        batch_le(b + 8, (unsigned long) filename_len, 2);
+        archive->error = fwrite(b, 1, 10, archive->fp) != 10
+                        || fwrite(filename, 1, filename_len, archive->fp) != (size_t) filename_len;
+        batch_le(b, (unsigned long) errtxt_len, 2);
+        archive->error |= fwrite(b, 1, 2, archive->fp) != 2
+                            || (errtxt_len && fwrite(errtxt, 1, errtxt_len, archive->fp) != (size_t) errtxt_len);
+        batch_le(b, (unsigned long) data_size, 4);
+        archive->error |= fwrite(b, 1, 4, archive->fp) != 4
+                            || (data_size && fwrite(data, 1, data_size, archive->fp) != (size_t) data_size);
+    }
+    return 0;
+}
+
+/* Batch mode - finish and close `archive`, returning non-zero and reporting error if writing failed */
+static int batch_archive_close(struct batch_archive *const archive) {
+    if (archive->type == BATCH_ARCHIVE_TAR && !archive->error) {
+        /* End of archive - 2 zero blocks */
+        static const unsigned char zeroes[1024] = {0};
+        archive->error = fwrite(zeroes, 1, 1024, archive->fp) != 1024;
+    }
+    if (fflush(archive->fp) != 0) {
+        archive->error = 1;
+    }
+    if (archive->fp != stdout && fclose(archive->fp) != 0) {
+        archive->error = 1;
+    }
+    archive->fp = NULL;
+    if (archive->error) {
+        fprintf(stderr, "Error 214: Failure writing archive '%s' (%d: %s)\n",
+                archive->filename[0] ? archive->filename : "-", errno, strerror(errno));
+        fflush(stderr);
+        return ZINT_ERROR_FILE_WRITE;
+    }
+    return 0;
+}
+
+#define BATCH_SHARD_MAX     4       /* Maximum number of hex digits of `--shard` subdirectory (65536 directories) */
+#define BATCH_WRITER_QUEUE  256     /* Maximum number of outputs queued for the `--async` writer thread */
+#define BATCH_WRITE_SIZE    (256 + BATCH_SHARD_MAX + 1) /* Size of output filename allowing for shard subdirectory */
+
+/* Batch mode - an output to be written */
+struct batch_write {
+    char filename[BATCH_WRITE_SIZE]; /* Output filename, including shard subdirectory if any */
+    char link[BATCH_WRITE_SIZE]; /* If non-empty, earlier output to hard-link or copy instead of `data` (dedupe) */
+    unsigned char *data;    /* Owned by the writer once put */
+    int size;
+    int line_count;
+    unsigned char *cache;   /* If non-NULL, NUL-terminated cache filename followed by header, to be written along
+                               with `data` to the dedupe cache, owned by the writer once put */
+    int cache_size;
+};
+
+struct batch_dedupe; /* Forward ref */
+
+/* Batch mode - writer of outputs to files, as given by "--async", "--shard", "--fsync" and "--dedupe" */
+struct batch_writer {
+    int async;              /* Whether writing done by a background thread */
+    int shard;              /* Number of hex digits of hash subdirectory, 0 if none */
+    int sync;               /* Whether to sync outputs to disk on close, -1 if noting them failed */
+    struct batch_dedupe *dedupe; /* If non-NULL, lines with same settings and data only encoded once */
+    int error;              /* ZINT_ERROR_XXX of last failure (reported as it happens) */
+    struct batch_write *queue; /* Ring buffer of `BATCH_WRITER_QUEUE` outputs if `async` */
+    int head;               /* Next slot to put, only accessed by main thread */
+    int tail;               /* Next slot to write, only accessed by writer thread */
+    char *synced;           /* NUL-terminated names of files written and directories made if `sync` */
+    size_t synced_len;
+    size_t synced_size;
+#ifdef _WIN32
+    HANDLE thread;
+    HANDLE slots;           /* Semaphore counting free slots */
+    HANDLE items;           /* Semaphore counting queued outputs */
+#else
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int count;              /* Number of queued outputs */
+#endif
+};
+
+/* Batch mode - return offset of the basename of `filename` */
+static int batch_basename(const char *const filename) {
+    int i;
+
+    for (i = (int) strlen(filename); i > 0; i--) {
+#ifndef _WIN32
+        if (filename[i - 1] == '/') {
+#else
+        if (filename[i - 1] == '/' || filename[i - 1] == '\\') {
+#endif
+            break;
+        }
+    }
+    return i;
+}
+
+/* Batch mode - set `dest` to `filename` with a subdirectory of `shard` hex digits of the FNV-1a hash of its
+   basename inserted before the basename, e.g. "out/00042.png" -> "out/6a/00042.png" for `shard` 2 */
+static void batch_shard(const char *const filename, const int shard, char *const dest) {
+    static const char hex[] = "0123456789abcdef";
+    const int base = batch_basename(filename);
+    unsigned long hash = 2166136261UL;
+    const unsigned char *p;
+    int i;
+
+    for (p = ZCUCP(filename + base); *p; p++) {
+        hash = ((hash ^ *p) * 16777619UL) & 0xFFFFFFFF;
+    }
+    memcpy(dest, filename, base);
+    for (i = 0; i < shard; i++) {
+        dest[base + i] = hex[(hash >> (28 - 4 * i)) & 0xF];
+    }
+#ifndef _WIN32
+    dest[base + shard] = '/';
+#else
+    dest[base + shard] = '\\';
+#endif
+    cpy_str(dest + base + shard + 1, BATCH_WRITE_SIZE - base - shard - 1, filename + base);
+}
+
+/* Batch mode - note `name` (file or directory) to be synced on close, returning 0 if memory allocation fails */
+static int batch_writer_note(struct batch_writer *const writer, const char *const name) {
+    const size_t len = strlen(name) + 1;
+
+    if (writer->synced_size - writer->synced_len < len) {
+        const size_t size = writer->synced_size ? writer->synced_size * 2 : 64 * 1024;
+        char *const synced = (char *) realloc(writer->synced, size);
+        if (!synced) {
+            return 0;
+        }
+        writer->synced = synced;
+        writer->synced_size = size;
+    }
+    memcpy(writer->synced + writer->synced_len, name, len);
+    writer->synced_len += len;
+    return 1;
+}
+
+/* Batch mode - create any missing directories of `filename` (as `zint_out_fopen()` does), returning 0 on
+   failure */
+static int batch_writer_mkdir(struct batch_writer *const writer, const char *const filename) {
+    char dirname[BATCH_WRITE_SIZE];
+    const int base = batch_basename(filename);
+    int i;
+
+    if (base == 0 || base >= BATCH_WRITE_SIZE) {
+        return 0;
+    }
+    ncpy_str(dirname, ARRAY_SIZE(dirname), filename, base); /* Includes trailing separator */
+
+    for (i = 1; dirname[i]; i++) { /* Ignore separator at start if any */
+#ifndef _WIN32
+        if (dirname[i] == '/' && dirname[i - 1] != '/') { /* Ignore double separators */
+#else
+        if ((dirname[i] == '/' || dirname[i] == '\\') && dirname[i - 1] != '/' && dirname[i - 1] != '\\') {
+#endif
+            const char sep = dirname[i];
+            dirname[i] = '\0'; /* Temporarily truncate */
+#ifdef _WIN32
+            if (win_mkdir(dirname) != 0 && errno != EEXIST) {
+                return 0;
+            }
+#else
+            if (mkdir(dirname, 0777) == 0) {
+                if (writer->sync > 0 && !batch_writer_note(writer, dirname)) {
+                    writer->sync = -1; /* Reported on close */
+                }
+            } else if (errno != EEXIST) {
+                return 0;
+            }
+#endif
+            dirname[i] = sep; /* Restore */
+        }
+    }
+    return 1;
+}
+
+/* Batch mode - open `filename` for writing, creating any missing directories if necessary */
+static FILE *batch_writer_fopen(struct batch_writer *const writer, const char *const filename) {
+    FILE *fp;
+
+#ifdef _WIN32
+    fp = win_fopen(filename, "wb");
+#else
+    fp = fopen(filename, "wb");
+#endif
+    if (!fp && errno == ENOENT && batch_writer_mkdir(writer, filename)) {
+#ifdef _WIN32
+        fp = win_fopen(filename, "wb");
+#else
+        fp = fopen(filename, "wb");
+#endif
+    }
+    return fp;
+}
+
+/* Batch mode - output `w->filename` as a copy of earlier output `w->link`, by hard link if possible, returning 0
+   and reporting on failure */
+static int batch_writer_link(struct batch_writer *const writer, const struct batch_write *const w) {
+    unsigned char buf[8192];
+    FILE *src, *dst;
+    size_t n;
+    int ok = 1;
+
+    if (strcmp(w->filename, w->link) == 0) {
+        return 1; /* Same file, e.g. mirrored */
+    }
+#ifndef _WIN32
+    if ((unlink(w->filename) == 0 || errno == ENOENT) && (link(w->link, w->filename) == 0
+            || (errno == ENOENT && batch_writer_mkdir(writer, w->filename)
+                && link(w->link, w->filename) == 0))) {
+        return 1;
+    }
+#endif
+    /* Hard links not supported (or across devices etc.) so copy */
+#ifdef _WIN32
+    src = win_fopen(w->link, "rb");
+#else
+    src = fopen(w->link, "rb");
+#endif
+    if (!src) {
+        fprintf(stderr, "On line %d: Error 248: Unable to read earlier output file '%s' (%d: %s)\n", w->line_count,
+                w->link, errno, strerror(errno));
+        fflush(stderr);
+        writer->error = ZINT_ERROR_FILE_ACCESS;
+        return 0;
+    }
+    if (!(dst = batch_writer_fopen(writer, w->filename))) {
+        fprintf(stderr, "On line %d: Error 239: Unable to open output file '%s' (%d: %s)\n", w->line_count,
+                w->filename, errno, strerror(errno));
+        fflush(stderr);
+        (void) fclose(src);
+        writer->error = ZINT_ERROR_FILE_ACCESS;
+        return 0;
+    }
+    while (ok && (n = fread(buf, 1, sizeof(buf), src)) != 0) {
+        ok = fwrite(buf, 1, n, dst) == n;
+    }
+    if (ferror(src)) {
+        ok = 0;
+    }
+    (void) fclose(src);
+    if (fclose(dst) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        fprintf(stderr, "On line %d: Error 240: Failure writing output file '%s' (%d: %s)\n", w->line_count,
+                w->filename, errno, strerror(errno));
+        fflush(stderr);
+        writer->error = ZINT_ERROR_FILE_WRITE;
+    }
+    return ok;
+}
+
+/* Batch mode - write dedupe cache entry of `w` to a temporary file then rename, so that concurrent runs sharing
+   the cache see either no entry or a complete one */
+static void batch_writer_cache(struct batch_writer *const writer, const struct batch_write *const w) {
+    const char *const cache_name = (const char *) w->cache;
+    const int name_len = (int) strlen(cache_name) + 1;
+    char tmp_name[BATCH_WRITE_SIZE + 24];
+    FILE *fp;
+    int ok;
+
+#ifdef _WIN32
+    sprintf(tmp_name, "%s.%d.tmp", cache_name, _getpid());
+    fp = win_fopen(tmp_name, "wb");
+#else
+    sprintf(tmp_name, "%s.%ld.tmp", cache_name, (long) getpid());
+    fp = fopen(tmp_name, "wb");
+#endif
+    if (!fp) {
+        ok = 0;
+    } else {
+        ok = fwrite(w->cache + name_len, 1, w->cache_size - name_len, fp) == (size_t) (w->cache_size - name_len)
+                && (!w->size || fwrite(w->data, 1, w->size, fp) == (size_t) w->size);
+        if (fclose(fp) != 0) {
+            ok = 0;
+        }
+        if (ok) {
+#ifdef _WIN32
+            /* Windows `rename()` fails if exists, in which case fine to keep existing entry */
+            if (rename(tmp_name, cache_name) != 0) {
+                (void) remove(tmp_name);
+            }
+#else
+            ok = rename(tmp_name, cache_name) == 0;
+#endif
+        } else {
+            (void) remove(tmp_name);
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "On line %d: Error 247: Failure writing cache file '%s' (%d: %s)\n", w->line_count,
+                cache_name, errno, strerror(errno));
+        fflush(stderr);
+        writer->error = ZINT_ERROR_FILE_WRITE;
+    }
+}
+
+/* Batch mode - write output `w` to its file (or link/copy if `w->link` set), creating its shard subdirectory if
+   necessary, and to the dedupe cache if `w->cache` set, reporting any failure */
+static void batch_writer_write(struct batch_writer *const writer, const struct batch_write *const w) {
+    FILE *fp;
+    int ok;
+
+    if (w->link[0]) {
+        if (!batch_writer_link(writer, w)) {
+            return;
+        }
+    } else {
+        if (!(fp = batch_writer_fopen(writer, w->filename))) {
+            fprintf(stderr, "On line %d: Error 239: Unable to open output file '%s' (%d: %s)\n", w->line_count,
+                    w->filename, errno, strerror(errno));
+            fflush(stderr);
+            writer->error = ZINT_ERROR_FILE_ACCESS;
+            return;
+        }
+        ok = !w->size || fwrite(w->data, 1, w->size, fp) == (size_t) w->size;
+        if (fclose(fp) != 0) {
+            ok = 0;
+        }
+        if (!ok) {
+            fprintf(stderr, "On line %d: Error 240: Failure writing output file '%s' (%d: %s)\n", w->line_count,
+                    w->filename, errno, strerror(errno));
+            fflush(stderr);
+            writer->error = ZINT_ERROR_FILE_WRITE;
+            return;
+        }
+        if (w->cache) {
+            batch_writer_cache(writer, w);
+        }
+    }
+    if (writer->sync > 0 && !batch_writer_note(writer, w->filename)) {
+        writer->sync = -1; /* Reported on close */
+    }
+}
+
+/* Batch mode - writer thread, writing queued outputs until an empty filename is dequeued */
+static void batch_writer_run(struct batch_writer *const writer) {
+    for (;;) {
+        struct batch_write *const w = writer->queue + writer->tail;
+#ifdef _WIN32
+        WaitForSingleObject(writer->items, INFINITE);
+#else
+        pthread_mutex_lock(&writer->lock);
+        while (writer->count == 0) {
+            pthread_cond_wait(&writer->cond, &writer->lock);
+        }
+        pthread_mutex_unlock(&writer->lock);
+#endif
+        if (!w->filename[0]) {
+            break;
+        }
+        batch_writer_write(writer, w);
+        free(w->data);
+        free(w->cache);
+        writer->tail = (writer->tail + 1) % BATCH_WRITER_QUEUE;
+#ifdef _WIN32
+        ReleaseSemaphore(writer->slots, 1, NULL);
+#else
+        pthread_mutex_lock(&writer->lock);
+        writer->count--;
+        pthread_cond_signal(&writer->cond);
+        pthread_mutex_unlock(&writer->lock);
+#endif
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI batch_writer_thread(LPVOID arg) {
+    batch_writer_run((struct batch_writer *) arg);
+    return 0;
+}
+#else
+static void *batch_writer_thread(void *arg) {
+    batch_writer_run((struct batch_writer *) arg);
+    return NULL;
+}
+#endif
+
+/* Batch mode - start `writer`, its thread if `async` (if that fails writing is done in the main thread) */
+static void batch_writer_open(struct batch_writer *const writer) {
+    writer->error = 0;
+    writer->head = writer->tail = 0;
+    writer->synced = NULL;
+    writer->synced_len = writer->synced_size = 0;
+    if (writer->async
+            && !(writer->queue = (struct batch_write *) calloc(BATCH_WRITER_QUEUE, sizeof(struct batch_write)))) {
+        writer->async = 0;
+    }
+    if (writer->async) {
+#ifdef _WIN32
+        writer->slots = CreateSemaphore(NULL, BATCH_WRITER_QUEUE, BATCH_WRITER_QUEUE, NULL);
+        writer->items = CreateSemaphore(NULL, 0, BATCH_WRITER_QUEUE, NULL);
+        if (!writer->slots || !writer->items
+                || !(writer->thread = CreateThread(NULL, 0, batch_writer_thread, writer, 0, NULL))) {
+            if (writer->slots) {
+                CloseHandle(writer->slots);
+            }
+            if (writer->items) {
+                CloseHandle(writer->items);
+            }
+            writer->async = 0;
+        }
+#else
+        writer->count = 0;
+        pthread_mutex_init(&writer->lock, NULL);
+        pthread_cond_init(&writer->cond, NULL);
+        if (pthread_create(&writer->thread, NULL, batch_writer_thread, writer) != 0) {
+            pthread_cond_destroy(&writer->cond);
+            pthread_mutex_destroy(&writer->lock);
+            writer->async = 0;
+        }
+#endif
+        if (!writer->async) {
+            free(writer->queue);
+            writer->queue = NULL;
+        }
+    }
+}
+
+/* Batch mode - put output `w` to be written, its `filename` and `link` being sharded if `shard`, taking ownership
+   of `w->data` and `w->cache`, which must be `malloc()`ed. If not `async` written immediately, otherwise queued,
+   blocking if the queue is full */
+static void batch_writer_put(struct batch_writer *const writer, const struct batch_write *const w) {
+    struct batch_write local;
+    struct batch_write *const q = writer->async ? writer->queue + writer->head : &local;
+
+#ifdef _WIN32
+    if (writer->async) {
+        WaitForSingleObject(writer->slots, INFINITE);
+    }
+#else
+    if (writer->async) {
+        pthread_mutex_lock(&writer->lock);
+        while (writer->count == BATCH_WRITER_QUEUE) {
+            pthread_cond_wait(&writer->cond, &writer->lock);
+        }
+        pthread_mutex_unlock(&writer->lock);
+    }
+#endif
+    if (writer->shard && w->filename[0]) {
+        batch_shard(w->filename, writer->shard, q->filename);
+    } else {
+        cpy_str(q->filename, ARRAY_SIZE(q->filename), w->filename);
+    }
+    if (writer->shard && w->link[0]) {
+        batch_shard(w->link, writer->shard, q->link);
+    } else {
+        cpy_str(q->link, ARRAY_SIZE(q->link), w->link);
+    }
+    q->data = w->data;
+    q->size = w->size;
+    q->line_count = w->line_count;
+    q->cache = w->cache;
+    q->cache_size = w->cache_size;
+    if (!writer->async) {
+        batch_writer_write(writer, q);
+        free(q->data);
+        free(q->cache);
+        return;
+    }
+    writer->head = (writer->head + 1) % BATCH_WRITER_QUEUE;
+#ifdef _WIN32
+    ReleaseSemaphore(writer->items, 1, NULL);
+#else
+    pthread_mutex_lock(&writer->lock);
+    writer->count++;
+    pthread_cond_signal(&writer->cond);
+    pthread_mutex_unlock(&writer->lock);
+#endif
+}
+
+/* Batch mode - `qsort()` comparator ordering names by directory then name, so each directory synced once */
+static int batch_synced_cmp(const void *a, const void *b) {
+    const char *const name_a = *(const char *const *) a;
+    const char *const name_b = *(const char *const *) b;
+    const int base_a = batch_basename(name_a), base_b = batch_basename(name_b);
+    int cmp;
+
+    if (base_a != base_b) {
+        cmp = memcmp(name_a, name_b, base_a < base_b ? base_a : base_b);
+        return cmp ? cmp : base_a - base_b;
+    }
+    cmp = memcmp(name_a, name_b, base_a);
+    return cmp ? cmp : strcmp(name_a + base_a, name_b + base_a);
+}
+
+/* Batch mode - sync to disk `name` (file or directory), returning 0 on failure */
+static int batch_sync(const char *const name) {
+#ifdef _WIN32
+    FILE *const fp = win_fopen(name, "r+b");
+    int ok;
+    if (!fp) {
+        return 0;
+    }
+    ok = _commit(_fileno(fp)) == 0;
+    if (fclose(fp) != 0) {
+        ok = 0;
+    }
+    return ok;
+#else
+    const int fd = open(name, O_RDONLY);
+    int ok;
+    if (fd < 0) {
+        return 0;
+    }
+    ok = fsync(fd) == 0;
+    if (close(fd) != 0) {
+        ok = 0;
+    }
+    return ok;
+#endif
+}
+
+/* Batch mode - sync all files written (and directories made) by `writer` and the directories containing them,
+   all at once after writing rather than per file, returning 0 and reporting on failure */
+static int batch_writer_sync(struct batch_writer *const writer) {
+    const char **names;
+#ifndef _WIN32
+    char dirname[BATCH_WRITE_SIZE], prev_dirname[BATCH_WRITE_SIZE];
+#endif
+    int count = 0, ok = 1;
+    size_t i;
+    int j;
+
+    for (i = 0; i < writer->synced_len; i++) {
+        count += writer->synced[i] == '\0';
+    }
+    if (!count) {
+        return 1;
+    }
+    if (!(names = (const char **) malloc(sizeof(const char *) * count))) {
+        fprintf(stderr, "Error 242: Insufficient memory for syncing output files\n");
+        fflush(stderr);
+        return 0;
+    }
+    for (i = 0, j = 0; j < count; i += strlen(writer->synced + i) + 1) {
+        names[j++] = writer->synced + i;
+    }
+    qsort(names, count, sizeof(const char *), batch_synced_cmp);
+
+    for (j = 0; j < count; j++) {
+#ifndef _WIN32
+        const int base = batch_basename(names[j]);
+#endif
+        if (!batch_sync(names[j])) {
+            fprintf(stderr, "Error 241: Failure syncing output '%s' (%d: %s)\n", names[j], errno, strerror(errno));
+            fflush(stderr);
+            ok = 0;
+        }
+#ifndef _WIN32
+        /* Sync the entries of each directory once (not possible on Windows) */
+        if (base > 1) {
+            ncpy_str(dirname, ARRAY_SIZE(dirname), names[j], base - 1);
+        } else {
+            cpy_str(dirname, ARRAY_SIZE(dirname), base ? "/" : ".");
+        }
+        if (j == 0 || strcmp(dirname, prev_dirname) != 0) {
+            if (!batch_sync(dirname)) {
+                fprintf(stderr, "Error 241: Failure syncing output '%s' (%d: %s)\n", dirname, errno,
+                        strerror(errno));
+                fflush(stderr);
+                ok = 0;
+            }
+            cpy_str(prev_dirname, ARRAY_SIZE(prev_dirname), dirname);
+        }
+#endif
+    }
+    free(names);
+    return ok;
+}
+
+/* Batch mode - wait for `writer` to finish writing, then sync if `sync`, returning non-zero if any failure */
+static int batch_writer_close(struct batch_writer *const writer) {
+    if (writer->async) {
+        struct batch_write w;
+        memset(&w, 0, sizeof(w)); /* Empty filename to end writer thread */
+        batch_writer_put(writer, &w);
+#ifdef _WIN32
+        WaitForSingleObject(writer->thread, INFINITE);
+        CloseHandle(writer->thread);
+        CloseHandle(writer->slots);
+        CloseHandle(writer->items);
+#else
+        pthread_join(writer->thread, NULL);
+        pthread_cond_destroy(&writer->cond);
+        pthread_mutex_destroy(&writer->lock);
+#endif
+        free(writer->queue);
+        writer->queue = NULL;
+    }
+    if (writer->sync > 0) {
+        if (!batch_writer_sync(writer)) {
+            writer->error = ZINT_ERROR_FILE_WRITE;
+        }
+    } else if (writer->sync < 0) {
+        fprintf(stderr, "Error 242: Insufficient memory for syncing output files\n");
+        fflush(stderr);
+        writer->error = ZINT_ERROR_MEMORY;
+    }
+    free(writer->synced);
+    writer->synced = NULL;
+    return writer->error;
+}
+
+#define BATCH_CSV_COLS_MAX  16      /* Maximum number of CSV/TSV columns */
+#define BATCH_CSV_FIELDS_SIZE   (ZINT_MAX_DATA_LEN + BATCH_CSV_COLS_MAX) /* Size of unquoted fields buffer */
+
+/* CSV/TSV batch mode - column types, indexes into `batch_csv_names[]` */
+#define BATCH_COL_SYMBOLOGY 0
+#define BATCH_COL_DATA      1
+#define BATCH_COL_PRIMARY   2
+#define BATCH_COL_OPTION_1  3
+#define BATCH_COL_OPTION_2  4
+#define BATCH_COL_OPTION_3  5
+#define BATCH_COL_SCALE     6
+#define BATCH_COL_HEIGHT    7
+#define BATCH_COL_ROTATE    8
+#define BATCH_COL_FG        9
+#define BATCH_COL_BG        10
+#define BATCH_COL_OUTFILE   11
+
+/* CSV/TSV batch and serve modes - column or request field names (case-insensitive) */
+static const char batch_csv_names[][10] = {
+    "symbology", "data", "primary", "option_1", "option_2", "option_3",
+    "scale", "height", "rotate", "fg", "bg", "outfile"
+};
+
+/* CSV/TSV batch and serve modes - settings of a row or request, defaulting to those given on the command line */
+struct batch_row {
+    int symbology;
+    int option_1, option_2, option_3;
+    float scale;
+    float height;
+    int rotate_angle;
+    char fgcolour[16];      /* Same sizes as `symbol->fgcolour` etc */
+    char bgcolour[16];
+    char primary[128];
+    int data_offset;        /* Offset of data field in unquoted fields buffer */
+    int data_length;
+    int outfile_offset;     /* Offset of outfile field in unquoted fields buffer, -1 if none */
+    int fields_length;      /* Total length of unquoted fields (including NUL terminators) */
+};
+
+/* CSV/TSV batch mode - column layout as given by header row */
+struct batch_csv {
+    int sep;                /* Field separator, ',' for CSV, '\t' for TSV */
+    int count;              /* Number of columns */
+    int cols[BATCH_CSV_COLS_MAX]; /* BATCH_COL_XXX of each column */
+    struct batch_row base;  /* Default settings */
+};
+
+/* Parse and validate batch format argument to "--batchformat", returning field separator (0 for lines) or -1 */
+static int validate_batchformat(const char *const arg) {
+    char format[8];
+
+    if (strlen(arg) >= ARRAY_SIZE(format)) {
+        return -1;
+    }
+    cpy_str(format, ARRAY_SIZE(format), arg);
+    to_lower(format);
+    if (strcmp(format, "lines") == 0) {
+        return 0;
+    }
+    if (strcmp(format, "csv") == 0) {
+        return ',';
+    }
+    if (strcmp(format, "tsv") == 0) {
+        return '\t';
+    }
+    return -1;
+}
+
+/* CSV/TSV batch mode - unquote field of `record` starting at `*p_i` into `out` (NUL-terminated) if non-NULL,
+   advancing `*p_i` to the separator (or end). Returns length of field, or -1 if unterminated quote or -2 if
+   character other than separator follows closing quote. TSV fields are not quoted */
+static int batch_csv_field(const int sep, const unsigned char *const record, const int length, int *p_i,
+            unsigned char *const out) {
+    int i = *p_i;
+    int n = 0;
+
+    if (sep == ',' && i < length && record[i] == '"') {
+        for (i++; ; i++) {
+            if (i == length) {
+                return -1;
+            }
+            if (record[i] == '"') {
+                if (i + 1 == length || record[i + 1] != '"') {
+                    break;
+                }
+                i++; /* Doubled quote */
+            }
+            if (out) {
+                out[n] = record[i];
+            }
+            n++;
+        }
+        if (++i < length && record[i] != sep) {
+            return -2;
+        }
+    } else {
+        for (; i < length && record[i] != sep; i++) {
+            if (out) {
+                out[n] = record[i];
+            }
+            n++;
+        }
+    }
+    if (out) {
+        out[n] = '\0';
+    }
+    *p_i = i;
+    return n;
+}
+
+/* CSV/TSV batch mode - split `record` into NUL-terminated unquoted fields in `fields`, setting their `offsets`,
+   `*p_count` and total `*p_fields_length`, and if `expected` non-zero checking number of fields. Returns 1 on
+   success, else 0 and sets `errtxt` */
+static int batch_csv_split(const int sep, const unsigned char *const record, const int length, const int expected,
+            unsigned char *const fields, int offsets[BATCH_CSV_COLS_MAX], int *p_count, int *p_fields_length,
+            char errtxt[ERRBUF_SIZE]) {
+    int i = 0, count = 0, len = 0;
+
+    while (1) {
+        const int n = batch_csv_field(sep, record, length, &i, count < BATCH_CSV_COLS_MAX ? fields + len : NULL);
+        if (n < 0) {
+            sprintf(errtxt, n == -1 ? "Error 221: Unterminated quoted field %d"
+                                    : "Error 222: Invalid character after closing quote of field %d", count + 1);
+            return 0;
+        }
+        if (count < BATCH_CSV_COLS_MAX) {
+            offsets[count] = len;
+            len += n + 1;
+        }
+        count++;
+        if (i == length) {
+            break;
+        }
+        i++; /* Skip separator */
+    }
+    if (expected && count != expected) {
+        sprintf(errtxt, "Error 223: Row has %d fields, header has %d", count, expected);
+        return 0;
+    }
+    if (count > BATCH_CSV_COLS_MAX) {
+        sprintf(errtxt, "Error 220: Too many columns (%d maximum)", BATCH_CSV_COLS_MAX);
+        return 0;
+    }
+    *p_count = count;
+    *p_fields_length = len;
+    return 1;
+}
+
+/* Batch mode - return BATCH_COL_XXX of column or field `name`, which is lowercased, or -1 if unknown */
+static int batch_col_lookup(char *const name) {
+    int i;
+
+    to_lower(name);
+    for (i = 0; i < ARRAY_SIZE(batch_csv_names); i++) {
+        if (strcmp(name, batch_csv_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/* Batch mode - initialize `row` to default settings from `symbol` and `rotate_angle` */
+static void batch_row_init(struct batch_row *const row, const struct zint_symbol *const symbol,
+            const int rotate_angle) {
+    memset(row, 0, sizeof(*row));
+    row->symbology = symbol->symbology;
+    row->option_1 = symbol->option_1;
+    row->option_2 = symbol->option_2;
+    row->option_3 = symbol->option_3;
+    row->scale = symbol->scale;
+    row->height = symbol->height;
+    row->rotate_angle = rotate_angle;
+    cpy_str(row->fgcolour, ARRAY_SIZE(row->fgcolour), symbol->fgcolour);
+    cpy_str(row->bgcolour, ARRAY_SIZE(row->bgcolour), symbol->bgcolour);
+    cpy_str(row->primary, ARRAY_SIZE(row->primary), symbol->primary);
+    row->outfile_offset = -1;
+}
+
+/* Batch mode - set column `col` of `row` from NUL-terminated `field` of length `len` at `offset` in its buffer,
+   leaving the default if empty. Returns 0 if invalid */
+static int batch_row_field(struct batch_row *const row, const int col, const char *const field, const int len,
+            const int offset) {
+    char float_errbuf[ERRBUF_SIZE];
+    int val = 0, valid = 1;
+
+    if (col == BATCH_COL_DATA) {
+        row->data_offset = offset;
+        row->data_length = len;
+        return 1;
+    }
+    if (len == 0) {
+        return 1;
+    }
+    switch (col) {
+        case BATCH_COL_SYMBOLOGY:
+#ifdef ZINT_TEST
+            if (!validate_int(field, len, &val) && !(val = get_barcode_name(field, 0 /*test*/))) {
+#else
+            if (!validate_int(field, len, &val) && !(val = get_barcode_name(field))) {
+#endif
+                valid = 0;
+            } else if ((valid = ZBarcode_ValidID(val))) {
+                row->symbology = val;
+            }
+            break;
+        case BATCH_COL_OPTION_1:
+        case BATCH_COL_OPTION_2:
+        case BATCH_COL_OPTION_3:
+        case BATCH_COL_ROTATE:
+            if (field[0] == '-' && col != BATCH_COL_ROTATE) {
+                valid = validate_int(field + 1, len - 1, &val) && len > 1;
+                val = -val;
+            } else {
+                valid = validate_int(field, len, &val);
+            }
+            if (!valid) {
+                break;
+            }
+            if (col == BATCH_COL_OPTION_1) {
+                row->option_1 = val;
+            } else if (col == BATCH_COL_OPTION_2) {
+                row->option_2 = val;
+            } else if (col == BATCH_COL_OPTION_3) {
+                row->option_3 = val;
+            } else if ((valid = val == 0 || val == 90 || val == 180 || val == 270)) {
+                row->rotate_angle = val;
+            }
+            break;
+        case BATCH_COL_SCALE:
+            valid = validate_float(field, 0 /*allow_neg*/, &row->scale, float_errbuf);
+            break;
+        case BATCH_COL_HEIGHT:
+            valid = validate_float(field, 0 /*allow_neg*/, &row->height, float_errbuf);
+            break;
+        case BATCH_COL_FG:
+        case BATCH_COL_BG:
+            if ((valid = len < ARRAY_SIZE(row->fgcolour))) {
+                cpy_str(col == BATCH_COL_FG ? row->fgcolour : row->bgcolour, ARRAY_SIZE(row->fgcolour), field);
+            }
+            break;
+        case BATCH_COL_PRIMARY:
+            if ((valid = len < ARRAY_SIZE(row->primary))) {
+                cpy_str(row->primary, ARRAY_SIZE(row->primary), field);
+            }
+            break;
+        case BATCH_COL_OUTFILE:
+            if ((valid = len < 256)) {
+                row->outfile_offset = offset;
+            }
+            break;
+    }
+
+    return valid;
+}
+
+/* CSV/TSV batch mode - set up `csv` from header `record`, with default settings from `symbol` and
+   `rotate_angle`. Returns 0 on success, else ZINT_ERROR_INVALID_DATA and sets `errtxt` */
+static int batch_csv_header(struct batch_csv *const csv, const int sep, const struct zint_symbol *const symbol,
+            const int rotate_angle, const unsigned char *const record, const int length, unsigned char *const fields,
+            char errtxt[ERRBUF_SIZE]) {
+    int offsets[BATCH_CSV_COLS_MAX];
+    int fields_length;
+    int have_data = 0;
+    int i, j;
+
+    csv->sep = sep;
+    if (!batch_csv_split(sep, record, length, 0 /*expected*/, fields, offsets, &csv->count, &fields_length,
+                        errtxt)) {
+        return ZINT_ERROR_INVALID_DATA;
+    }
+    for (i = 0; i < csv->count; i++) {
+        char *const name = (char *) fields + offsets[i];
+        if ((csv->cols[i] = batch_col_lookup(name)) < 0) {
+            sprintf(errtxt, "Error 217: Unknown column '%.60s'", name);
+            return ZINT_ERROR_INVALID_DATA;
+        }
+        for (j = 0; j < i; j++) {
+            if (csv->cols[j] == csv->cols[i]) {
+                sprintf(errtxt, "Error 218: Duplicate column '%s'", batch_csv_names[csv->cols[i]]);
+                return ZINT_ERROR_INVALID_DATA;
+            }
+        }
+        have_data |= csv->cols[i] == BATCH_COL_DATA;
+    }
+    if (!have_data) {
+        cpy_str(errtxt, ERRBUF_SIZE, "Error 219: No 'data' column in header");
+        return ZINT_ERROR_INVALID_DATA;
+    }
+
+    batch_row_init(&csv->base, symbol, rotate_angle);
+
+    return 0;
+}
+
+/* CSV/TSV batch mode - parse `record` into `row`, unquoting its fields into `fields`, which must be at least
+   `BATCH_CSV_FIELDS_SIZE` long. Empty fields take the default settings. Returns 0 on success, else
+   ZINT_ERROR_INVALID_DATA and sets `errtxt` */
+static int batch_csv_row(const struct batch_csv *const csv, const unsigned char *const record, const int length,
+            unsigned char *const fields, struct batch_row *const row, char errtxt[ERRBUF_SIZE]) {
+    int offsets[BATCH_CSV_COLS_MAX];
+    int count;
+    int i;
+
+    *row = csv->base;
+    if (!batch_csv_split(csv->sep, record, length, csv->count, fields, offsets, &count, &row->fields_length,
+                        errtxt)) {
+        return ZINT_ERROR_INVALID_DATA;
+    }
+
+    for (i = 0; i < count; i++) {
+        const char *const field = (const char *) fields + offsets[i];
+        const int len = (i + 1 < count ? offsets[i + 1] : row->fields_length) - offsets[i] - 1;
+        if (!batch_row_field(row, csv->cols[i], field, len, offsets[i])) {
+            sprintf(errtxt, "Error 224: Invalid %.9s value '%.60s'", batch_csv_names[csv->cols[i]], field);
+            return ZINT_ERROR_INVALID_DATA;
+        }
+    }
+
+    return 0;
+}
+
+/* CSV/TSV batch and serve modes - apply settings of `row` to `symbol` */
+static void batch_row_apply(struct zint_symbol *const symbol, const struct batch_row *const row) {
+    symbol->symbology = row->symbology;
+    symbol->option_1 = row->option_1;
+    symbol->option_2 = row->option_2;
+    symbol->option_3 = row->option_3;
+    symbol->scale = row->scale;
+    symbol->height = row->height;
+    cpy_str(symbol->fgcolour, ARRAY_SIZE(symbol->fgcolour), row->fgcolour);
+    cpy_str(symbol->bgcolour, ARRAY_SIZE(symbol->bgcolour), row->bgcolour);
+    cpy_str(symbol->primary, ARRAY_SIZE(symbol->primary), row->primary);
+}
+
+/* CSV/TSV batch mode - set `output_file` from outfile field `outfile`, substituting line number as for "--output"
+   and adding `filetype` extension if none */
+static void batch_csv_outfile(const char *const outfile, const int line_count, const char *const filetype,
+            char *const output_file) {
+    batch_outfile(outfile, line_count, output_file);
+    if (!get_extension(output_file)) {
+        set_extension(output_file, filetype);
+    }
+}
+
+#define BATCH_KEY_SIZE      (ZINT_MAX_DATA_LEN + 512) /* Size of dedupe key, the settings followed by the data */
+#define BATCH_CACHE_MAX     (64 * 1024 * 1024) /* Maximum size of a dedupe cache file */
+
+/* Dedupe batch mode - a distinct key (settings and data) seen in this run */
+struct batch_dedupe_entry {
+    uint64_t hash;          /* FNV-1a hash of `key` */
+    unsigned char *key;     /* The key, followed by the NUL-terminated output filename of the first line with it */
+    int key_len;
+    int ret;                /* Result of the first line, -1 until known */
+    char *errtxt;           /* Its error/warning message if `ret` non-zero */
+};
+
+/* Dedupe batch mode - lines with the same settings and data encoded once, as given by "--dedupe[=DIR]" */
+struct batch_dedupe {
+    char dir[201];          /* Persistent cache directory if any, leaving room for entry names */
+    struct zint_symbol *settings; /* Copy of the settings before any encoding (which may feed back) */
+    struct batch_dedupe_entry *entries;
+    int count;
+    int size;
+    int *table;             /* Open addressing hash table of `entries` indexes + 1, 0 if empty */
+    int table_size;         /* Power of 2, more than twice `count` */
+    unsigned char *key;     /* Key of current line (`BATCH_KEY_SIZE`) */
+    int key_len;
+    uint64_t hash;
+};
+
+/* Dedupe batch mode - message used if no memory to keep a first line's error/warning */
+static char batch_dedupe_nomem[] = "Error 249: Insufficient memory for dedupe";
+
+/* Dedupe batch mode - set up `dedupe` with the settings of `symbol`, creating its cache directory if any,
+   returning non-zero and reporting on failure */
+static int batch_dedupe_open(struct batch_dedupe *const dedupe, const struct zint_symbol *const symbol) {
+    dedupe->count = dedupe->size = 0;
+    dedupe->entries = NULL;
+    dedupe->table_size = 1024;
+    dedupe->table = NULL;
+    dedupe->key = NULL;
+    if (!(dedupe->settings = clone_symbol(symbol))
+            || !(dedupe->table = (int *) calloc(dedupe->table_size, sizeof(int)))
+            || !(dedupe->key = (unsigned char *) malloc(BATCH_KEY_SIZE))) {
+        ZBarcode_Delete(dedupe->settings);
+        free(dedupe->table);
+        dedupe->settings = NULL;
+        dedupe->table = NULL;
+        fprintf(stderr, "%s\n", batch_dedupe_nomem);
+        fflush(stderr);
+        return ZINT_ERROR_MEMORY;
+    }
+#ifdef _WIN32
+    if (dedupe->dir[0] && win_mkdir(dedupe->dir) != 0 && errno != EEXIST) {
+#else
+    if (dedupe->dir[0] && mkdir(dedupe->dir, 0777) != 0 && errno != EEXIST) {
+#endif
+        fprintf(stderr, "Error 246: Unable to create cache directory '%s' (%d: %s)\n", dedupe->dir, errno,
+                strerror(errno));
+        fflush(stderr);
+        ZBarcode_Delete(dedupe->settings);
+        free(dedupe->table);
+        free(dedupe->key);
+        dedupe->settings = NULL;
+        dedupe->table = NULL;
+        dedupe->key = NULL;
+        return ZINT_ERROR_FILE_ACCESS;
+    }
+    return 0;
+}
+
+/* Dedupe batch mode - free `dedupe` */
+static void batch_dedupe_close(struct batch_dedupe *const dedupe) {
+    int i;
+
+    for (i = 0; i < dedupe->count; i++) {
+        free(dedupe->entries[i].key);
+        if (dedupe->entries[i].errtxt != batch_dedupe_nomem) {
+            free(dedupe->entries[i].errtxt);
+        }
+    }
+    ZBarcode_Delete(dedupe->settings);
+    free(dedupe->entries);
+    free(dedupe->table);
+    free(dedupe->key);
+    dedupe->settings = NULL;
+    dedupe->entries = NULL;
+    dedupe->table = NULL;
+    dedupe->key = NULL;
+}
+
+/* Dedupe batch mode - put `n` into key as 4 bytes little-endian, returning updated `k` */
+static unsigned char *batch_key_int(unsigned char *const k, const int n) {
+    batch_le(k, (unsigned long) n, 4);
+    return k + 4;
+}
+
+/* Dedupe batch mode - put float `f` into key, returning updated `k` */
+static unsigned char *batch_key_float(unsigned char *const k, const float f) {
+    memcpy(k, &f, sizeof(float));
+    return k + sizeof(float);
+}
+
+/* Dedupe batch mode - put NUL-terminated `str` into key, returning updated `k` */
+static unsigned char *batch_key_str(unsigned char *const k, const char *const str) {
+    const size_t len = strlen(str) + 1;
+    memcpy(k, str, len);
+    return k + len;
+}
+
+/* Dedupe batch mode - set `dedupe->key` and `dedupe->hash` from everything affecting the output of `data` of
+   `length`, i.e. the settings (overridden by `row` if CSV/TSV), `rotate_angle`, the file type of `outfile` and the
+   Zint version (so as not to use stale cache entries) */
+static void batch_dedupe_key(struct batch_dedupe *const dedupe, const struct batch_row *const row,
+            const int rotate_angle, const char *const outfile, const unsigned char *const data, const int length) {
+    const struct zint_symbol *const symbol = dedupe->settings;
+    const char *const extension = get_extension(outfile);
+    unsigned char *k = dedupe->key;
+    const uint64_t prime = ((uint64_t) 1 << 40) | 0x1B3; /* FNV-1a 64-bit prime */
+    uint64_t hash = ((uint64_t) 0xCBF29CE4 << 32) | 0x84222325; /* FNV-1a 64-bit offset basis */
+    int i;
+
+    k = batch_key_int(k, ZBarcode_Version());
+    k = batch_key_int(k, row ? row->symbology : symbol->symbology);
+    k = batch_key_int(k, row ? row->option_1 : symbol->option_1);
+    k = batch_key_int(k, row ? row->option_2 : symbol->option_2);
+    k = batch_key_int(k, row ? row->option_3 : symbol->option_3);
+    k = batch_key_int(k, row ? row->rotate_angle : rotate_angle);
+    k = batch_key_float(k, row ? row->scale : symbol->scale);
+    k = batch_key_float(k, row ? row->height : symbol->height);
+    k = batch_key_str(k, row ? row->fgcolour : symbol->fgcolour);
+    k = batch_key_str(k, row ? row->bgcolour : symbol->bgcolour);
+    k = batch_key_str(k, row ? row->primary : symbol->primary);
+    k = batch_key_int(k, symbol->whitespace_width);
+    k = batch_key_int(k, symbol->whitespace_height);
+    k = batch_key_int(k, symbol->border_width);
+    k = batch_key_int(k, symbol->output_options);
+    k = batch_key_int(k, symbol->show_hrt);
+    k = batch_key_int(k, symbol->input_mode);
+    k = batch_key_int(k, symbol->eci);
+    k = batch_key_float(k, symbol->dpmm);
+    k = batch_key_float(k, symbol->dot_size);
+    k = batch_key_float(k, symbol->text_gap);
+    k = batch_key_float(k, symbol->guard_descent);
+    k = batch_key_float(k, symbol->fit.aspect);
+    k = batch_key_float(k, symbol->fit.max_width);
+    k = batch_key_float(k, symbol->fit.max_height);
+    k = batch_key_int(k, symbol->structapp.index);
+    k = batch_key_int(k, symbol->structapp.count);
+    k = batch_key_str(k, symbol->structapp.id);
+    k = batch_key_int(k, symbol->warn_level);
+    k = batch_key_int(k, symbol->debug);
+    k = batch_key_str(k, extension ? extension : "");
+    k = batch_key_int(k, length);
+    memcpy(k, data, length);
+    dedupe->key_len = (int) (k - dedupe->key) + length;
+    assert(dedupe->key_len <= BATCH_KEY_SIZE);
+
+    for (i = 0; i < dedupe->key_len; i++) {
+        hash = (hash ^ dedupe->key[i]) * prime;
+    }
+    dedupe->hash = hash;
+}
+
+/* Dedupe batch mode - set `name` to the cache filename of key with `hash` */
+static void batch_dedupe_cache_name(const struct batch_dedupe *const dedupe, const uint64_t hash, char *const name) {
+    sprintf(name, "%s/%08lx%08lx.zdc", dedupe->dir, (unsigned long) (hash >> 32), (unsigned long) (hash & 0xFFFFFFFF));
+}
+
+/* Dedupe batch mode - look for the current key in the cache, returning 1 and setting `*p_data` (`malloc()`ed),
+   `*p_size`, `*p_ret` and `errtxt` if found. A cache file is the 4-byte magic "ZDC1", the return status (32-bit
+   signed), the error/warning message (16-bit length then bytes), the key (32-bit length then bytes) and the output
+   data (rest of file), all little-endian */
+static int batch_dedupe_cache_read(const struct batch_dedupe *const dedupe, unsigned char **p_data,
+            int *const p_size, int *const p_ret, char errtxt[ERRBUF_SIZE]) {
+    char name[BATCH_WRITE_SIZE];
+    unsigned char *buf;
+    long size;
+    int o, errtxt_len, key_len;
+    FILE *fp;
+
+    batch_dedupe_cache_name(dedupe, dedupe->hash, name);
+#ifdef _WIN32
+    fp = win_fopen(name, "rb");
+#else
+    fp = fopen(name, "rb");
+#endif
+    if (!fp) {
+        return 0;
+    }
+    if (fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) < 14 || size > BATCH_CACHE_MAX
+            || fseek(fp, 0, SEEK_SET) != 0 || !(buf = (unsigned char *) malloc(size))) {
+        (void) fclose(fp);
+        return 0;
+    }
+    if (fread(buf, 1, size, fp) != (size_t) size) {
+        (void) fclose(fp);
+        free(buf);
+        return 0;
+    }
+    (void) fclose(fp);
+
+    errtxt_len = buf[8] | (buf[9] << 8);
+    o = 10 + errtxt_len;
+    if (memcmp(buf, "ZDC1", 4) != 0 || errtxt_len >= ERRBUF_SIZE || o + 4 > size) {
+        free(buf);
+        return 0;
+    }
+    key_len = (int) (buf[o] | (buf[o + 1] << 8) | ((unsigned long) buf[o + 2] << 16)
+                        | ((unsigned long) buf[o + 3] << 24));
+    o += 4;
+    /* Collisions (and corruption) rejected by comparing the whole key */
+    if (key_len != dedupe->key_len || o + key_len > size || memcmp(buf + o, dedupe->key, key_len) != 0) {
+        free(buf);
+        return 0;
+    }
+    *p_ret = (int) (buf[4] | (buf[5] << 8) | ((unsigned long) buf[6] << 16) | ((unsigned long) buf[7] << 24));
+    memcpy(errtxt, buf + 10, errtxt_len);
+    errtxt[errtxt_len] = '\0';
+    o += key_len;
+    *p_size = (int) size - o;
+    memmove(buf, buf + o, *p_size);
+    *p_data = buf;
+    return 1;
+}
+
+/* Dedupe batch mode - look up line `line_count` with output `outfile` and `data` of `length`, encoded with the
+   settings (or those of `row` if CSV/TSV) and `rotate_angle`. Returns its entry index, or -1 if memory allocation
+   failed (reported, and line to be encoded as usual). Sets `*p_repeat` to 1 if same as an earlier line (not to be
+   encoded), 2 if found in the cache, setting `*p_data` (`malloc()`ed), `*p_size`, `*p_ret` and `errtxt` (not to be
+   encoded), and 0 otherwise */
+static int batch_dedupe_begin(struct batch_dedupe *const dedupe, const struct batch_row *const row,
+            const int rotate_angle, const char *const outfile,
+            const unsigned char *const data, const int length, const int line_count, int *const p_repeat,
+            unsigned char **p_data, int *const p_size, int *const p_ret, char errtxt[ERRBUF_SIZE]) {
+    struct batch_dedupe_entry *entry;
+    const int outfile_len = (int) strlen(outfile) + 1;
+    int mask = dedupe->table_size - 1;
+    int h, i;
+
+    *p_repeat = 0;
+    batch_dedupe_key(dedupe, row, rotate_angle, outfile, data, length);
+    for (h = (int) (dedupe->hash & mask); dedupe->table[h]; h = (h + 1) & mask) {
+        entry = dedupe->entries + dedupe->table[h] - 1;
+        if (entry->hash == dedupe->hash && entry->key_len == dedupe->key_len
+                && memcmp(entry->key, dedupe->key, dedupe->key_len) == 0) {
+            *p_repeat = 1;
+            return dedupe->table[h] - 1;
+        }
+    }
+
+    /* New key */
+    if (dedupe->count == dedupe->size) {
+        const int size = dedupe->size ? dedupe->size * 2 : 1024;
+        struct batch_dedupe_entry *const entries = (struct batch_dedupe_entry *) realloc(dedupe->entries,
+                                                                        sizeof(struct batch_dedupe_entry) * size);
+        if (!entries) {
+            fprintf(stderr, "On line %d: %s\n", line_count, batch_dedupe_nomem);
+            fflush(stderr);
+            return -1;
+        }
+        dedupe->entries = entries;
+        dedupe->size = size;
+    }
+    if ((dedupe->count + 1) * 2 > dedupe->table_size) {
+        const int table_size = dedupe->table_size * 2;
+        int *const table = (int *) calloc(table_size, sizeof(int));
+        if (!table) {
+            fprintf(stderr, "On line %d: %s\n", line_count, batch_dedupe_nomem);
+            fflush(stderr);
+            return -1;
+        }
+        mask = table_size - 1;
+        for (i = 0; i < dedupe->count; i++) {
+            int j;
+            for (j = (int) (dedupe->entries[i].hash & mask); table[j]; j = (j + 1) & mask);
+            table[j] = i + 1;
+        }
+        free(dedupe->table);
+        dedupe->table = table;
+        dedupe->table_size = table_size;
+        for (h = (int) (dedupe->hash & mask); dedupe->table[h]; h = (h + 1) & mask);
+    }
+    entry = dedupe->entries + dedupe->count;
+    if (!(entry->key = (unsigned char *) malloc(dedupe->key_len + outfile_len))) {
+        fprintf(stderr, "On line %d: %s\n", line_count, batch_dedupe_nomem);
+        fflush(stderr);
+        return -1;
+    }
+    memcpy(entry->key, dedupe->key, dedupe->key_len);
+    memcpy(entry->key + dedupe->key_len, outfile, outfile_len);
+    entry->hash = dedupe->hash;
+    entry->key_len = dedupe->key_len;
+    entry->ret = -1;
+    entry->errtxt = NULL;
+    dedupe->table[h] = ++dedupe->count;
+
+    if (dedupe->dir[0] && batch_dedupe_cache_read(dedupe, p_data, p_size, p_ret, errtxt)) {
+        *p_repeat = 2;
+    }
+    return dedupe->count - 1;
+}
+
+/* Dedupe batch mode - complete output `w` of line with entry `idx` and `repeat` as returned by
+   `batch_dedupe_begin()`. If `repeat` 1 sets `*p_ret` and `errtxt` to those of the first line and if it succeeded
+   `w->link` to its output. Otherwise records `*p_ret` and `errtxt` for any later repeats, and if `repeat` 0, and
+   encoding succeeded and there is a cache directory, sets `w->cache` to the cache entry */
+static void batch_dedupe_end(struct batch_dedupe *const dedupe, const int idx, const int repeat, int *const p_ret,
+            char errtxt[ERRBUF_SIZE], struct batch_write *const w) {
+    struct batch_dedupe_entry *const entry = dedupe->entries + idx;
+
+    if (repeat == 1) {
+        *p_ret = entry->ret;
+        if (entry->ret) {
+            cpy_str(errtxt, ERRBUF_SIZE, entry->errtxt);
+        }
+        if (entry->ret < ZINT_ERROR) {
+            cpy_str(w->link, ARRAY_SIZE(w->link), (const char *) entry->key + entry->key_len);
+        }
+        return;
+    }
+    entry->ret = *p_ret;
+    if (*p_ret) {
+        const size_t len = strlen(errtxt) + 1;
+        if ((entry->errtxt = (char *) malloc(len))) {
+            memcpy(entry->errtxt, errtxt, len);
+        } else {
+            entry->errtxt = batch_dedupe_nomem;
+        }
+    }
+    if (repeat == 0 && dedupe->dir[0] && *p_ret < ZINT_ERROR && w->data) {
+        const int errtxt_len = *p_ret ? (int) strlen(errtxt) : 0;
+        char name[BATCH_WRITE_SIZE];
+        int name_len;
+
+        batch_dedupe_cache_name(dedupe, entry->hash, name);
+        name_len = (int) strlen(name) + 1;
+        w->cache_size = name_len + 14 + errtxt_len + entry->key_len;
+        if ((w->cache = (unsigned char *) malloc(w->cache_size))) {
+            unsigned char *const b = w->cache + name_len;
+            memcpy(w->cache, name, name_len);
+            memcpy(b, "ZDC1", 4);
+            batch_le(b + 4, (unsigned long) *p_ret, 4);
+            batch_le(b + 8, (unsigned long) errtxt_len, 2);
+            memcpy(b + 10, errtxt, errtxt_len);
+            batch_le(b + 10 + errtxt_len, (unsigned long) entry->key_len, 4);
+            memcpy(b + 14 + errtxt_len, entry->key, entry->key_len);
+        } /* Else just not cached */
+    }
+}
+
+#define BATCH_JOBS_MAX      256     /* Maximum number of `--jobs` worker threads */
+#define BATCH_CHUNK_LINES   64      /* Lines per worker read in one go */
+
+/* Batch jobs mode - a line to be encoded by a worker */
+struct batch_job {
+    const unsigned char *data; /* The line's data, a view into the mapped input or into `batch_chunk.data` */
+    size_t offset;          /* Offset of the line's data in `batch_chunk.data` if not mapped */
+    int length;             /* Length of the line's data, -1 if too long */
+    int line_count;         /* Line number */
+    int ret;                /* Return of `ZBarcode_Encode_and_Print()` */
+    char outfile[256];      /* Output filename, same size as `symbol->outfile` */
+    char errtxt[ERRBUF_SIZE]; /* Copy of `symbol->errtxt` if `ret` non-zero */
+    unsigned char *memfile; /* Copy of output if outputting to stdout */
+    int memfile_size;
+    struct batch_row row;   /* Settings of the line if CSV/TSV */
+    int dedupe;             /* Dedupe entry index, -1 if none */
+    int repeat;             /* If non-zero, not to be encoded, see `batch_dedupe_begin()` */
+};
+
+/* Batch jobs mode - a chunk of lines, encoded by the workers while the next chunk is being read */
+struct batch_chunk {
+    struct batch_job *jobs;
+    int count;
+    unsigned char *data;    /* NUL-terminated copies of line data if input not mapped or CSV/TSV */
+    size_t data_len;
+    size_t data_size;
+};
+
+/* Batch jobs mode - a worker thread with its own copy of the symbol */
+struct batch_worker {
+    struct zint_symbol *symbol;
+    const struct batch_chunk *chunk;
+    int idx;                /* Worker encodes jobs `idx`, `idx + stride`, `idx + 2 * stride` etc. */
+    int stride;
+    int rotate_angle;
+    int csv;                /* Whether to apply the settings of each job's row (CSV/TSV) */
+    int started;            /* Whether `thread` started */
+#ifdef _WIN32
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+};
+
+/* Batch jobs mode - return number of online processors for `--jobs=0` */
+static int batch_jobs_auto(void) {
+    int cnt;
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    cnt = (int) info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    const long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+    cnt = ncpus > BATCH_JOBS_MAX ? BATCH_JOBS_MAX : (int) ncpus;
+#else
+    cnt = 1;
+#endif
+    return cnt < 1 ? 1 : cnt > BATCH_JOBS_MAX ? BATCH_JOBS_MAX : cnt;
+}
+
+/* Batch jobs mode - encode and output the worker's share of its chunk */
+static void batch_worker_run(struct batch_worker *const worker) {
+    struct zint_symbol *const symbol = worker->symbol;
+    const struct batch_chunk *const chunk = worker->chunk;
+    const int option_1 = symbol->option_1, option_2 = symbol->option_2, option_3 = symbol->option_3;
+    int i;
+
+    for (i = worker->idx; i < chunk->count; i += worker->stride) {
+        struct batch_job *const job = chunk->jobs + i;
+        if (job->length < 0 || job->repeat) {
+            continue;
+        }
+        if (worker->csv) {
+            batch_row_apply(symbol, &job->row);
+        }
+        cpy_str(symbol->outfile, ARRAY_SIZE(symbol->outfile), job->outfile);
+        job->ret = ZBarcode_Encode_and_Print(symbol, job->data, job->length,
+                                                worker->csv ? job->row.rotate_angle : worker->rotate_angle);
+        if (job->ret != 0) {
+            cpy_str(job->errtxt, ARRAY_SIZE(job->errtxt), symbol->errtxt);
+        }
+        if (job->ret < ZINT_ERROR && symbol->memfile) {
+            /* Copy rather than take ownership so as not to free across library boundary */
+            if ((job->memfile = (unsigned char *) malloc(symbol->memfile_size))) {
+                memcpy(job->memfile, symbol->memfile, symbol->memfile_size);
+                job->memfile_size = symbol->memfile_size;
+            } else {
+                job->ret = ZINT_ERROR_MEMORY;
+                cpy_str(job->errtxt, ARRAY_SIZE(job->errtxt), "Error 206: Insufficient memory for output");
+            }
+        }
+        ZBarcode_Clear(symbol);
+        /* Undo any feedback */
+        symbol->option_1 = option_1;
+        symbol->option_2 = option_2;
+        symbol->option_3 = option_3;
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI batch_worker_thread(LPVOID arg) {
+    batch_worker_run((struct batch_worker *) arg);
+    return 0;
+}
+#else
+static void *batch_worker_thread(void *arg) {
+    batch_worker_run((struct batch_worker *) arg);
+    return NULL;
+}
+#endif
+
+/* Batch jobs mode - start `jobs` workers on `chunk` */
+static void batch_workers_start(struct batch_worker *const workers, const int jobs,
+            const struct batch_chunk *const chunk) {
+    int i;
+
+    for (i = 0; i < jobs; i++) {
+        struct batch_worker *const worker = workers + i;
+        worker->chunk = chunk;
+#ifdef _WIN32
+        worker->started = (worker->thread = CreateThread(NULL, 0, batch_worker_thread, worker, 0, NULL)) != NULL;
+#else
+        worker->started = pthread_create(&worker->thread, NULL, batch_worker_thread, worker) == 0;
+#endif
+    }
+}
+
+/* Batch jobs mode - wait for `jobs` workers to finish, doing the share of any that failed to start */
+static void batch_workers_wait(struct batch_worker *const workers, const int jobs) {
+    int i;
+
+    for (i = 0; i < jobs; i++) {
+        struct batch_worker *const worker = workers + i;
+        if (worker->started) {
+#ifdef _WIN32
+            WaitForSingleObject(worker->thread, INFINITE);
+            CloseHandle(worker->thread);
+#else
+            pthread_join(worker->thread, NULL);
+#endif
+            worker->started = 0;
+        } else {
+            batch_worker_run(worker);
+        }
+    }
+}
+
+/* Batch jobs mode - in line order output any stdout data (or add to `archive` or pass to `writer` if non-NULL)
+   and report any errors/warnings of encoded `chunk`, returning updated `error_number` */
+static int batch_chunk_report(const struct batch_chunk *const chunk, struct batch_archive *const archive,
+            struct batch_writer *const writer, int error_number) {
+    int i;
+
+    for (i = 0; i < chunk->count; i++) {
+        struct batch_job *const job = chunk->jobs + i;
+        if (writer) {
+            struct batch_write w;
+            memset(&w, 0, sizeof(w));
+            cpy_str(w.filename, ARRAY_SIZE(w.filename), job->outfile);
+            w.data = job->memfile;
+            w.size = job->memfile_size;
+            w.line_count = job->line_count;
+            if (job->dedupe >= 0) {
+                batch_dedupe_end(writer->dedupe, job->dedupe, job->repeat, &job->ret, job->errtxt, &w);
+            }
+            if (w.data || w.link[0]) {
+                batch_writer_put(writer, &w);
+                job->memfile = NULL; /* Owned by `writer` */
+            }
+        } else if (job->memfile && !archive) {
+            fwrite(job->memfile, 1, job->memfile_size, stdout);
+            fflush(stdout);
+        }
+        if (job->ret != 0) {
+            fprintf(stderr, "On line %d: %s\n", job->line_count, job->errtxt);
+            fflush(stderr);
+            /* As with serial processing, too long only recorded if no previous error */
+            if (job->ret >= ZINT_ERROR && (job->length >= 0 || error_number == 0)) {
+                error_number = job->ret;
+            }
+        }
+        if (archive) {
+            const int ret = batch_archive_add(archive, job->line_count, job->outfile, job->ret, job->errtxt,
+                                                job->memfile, job->memfile_size);
+            if (ret) {
+                error_number = ret;
+            }
+        }
+        if (job->memfile) {
+            free(job->memfile);
+            job->memfile = NULL;
+        }
+    }
+    return error_number;
+}
+
+/* Batch jobs mode - encode lines using `jobs` worker threads, each with its own copy of `symbol`, reading the next
+   chunk of lines while the workers encode the current one, and reporting in line order. If `csv` given lines are
+   CSV/TSV rows, parsed here and their settings applied by the workers. If `writer` given outputs are passed to it
+   in line order. If `trace` given the workers' trace events are written to it at the end */
+static int batch_jobs_process(struct zint_symbol *const symbol, struct batch_reader *const reader,
+            const int mirror_mode, const char *const filetype, const char *const format_string,
+            char *const output_file, const int mirror_start_o, const int rotate_angle, const int jobs,
+            const struct batch_csv *const csv, struct batch_archive *const archive, struct batch_writer *const writer,
+            struct trace_file *const trace, int *p_line_count) {
+    struct batch_worker *workers;
+    struct batch_chunk chunks[2];
+    const int max_lines = jobs * BATCH_CHUNK_LINES;
+    int error_number = 0;
+    int line_count = *p_line_count;
+    int cur = 0, more = 1, running = 0;
+    int mem_fail = 0; /* 1 if setting up failed, 2 if reading failed */
+    int i;
+
+    memset(chunks, 0, sizeof(chunks));
+    if (!(workers = (struct batch_worker *) calloc(jobs, sizeof(struct batch_worker)))) {
+        mem_fail = 1;
+    } else {
+        for (i = 0; i < 2 && !mem_fail; i++) {
+            mem_fail = !(chunks[i].jobs = (struct batch_job *) malloc(sizeof(struct batch_job) * max_lines));
+            if (!mem_fail && (!reader->mapped || csv)) {
+                chunks[i].data_size = BATCH_CSV_FIELDS_SIZE * 4;
+                mem_fail = !(chunks[i].data = (unsigned char *) malloc(chunks[i].data_size));
+            }
+        }
+        for (i = 0; i < jobs && !mem_fail; i++) {
+            if (!(workers[i].symbol = clone_symbol(symbol))) {
+                mem_fail = 1;
+            } else if (symbol->output_options & BARCODE_STDOUT) {
+                /* Output to memory to be written to stdout in line order */
+                workers[i].symbol->output_options ^= BARCODE_STDOUT | BARCODE_MEMORY_FILE;
+            }
+            workers[i].idx = i;
+            workers[i].stride = jobs;
+            workers[i].rotate_angle = rotate_angle;
+            workers[i].csv = csv != NULL;
+        }
+    }
+    if (mem_fail) {
+        more = 0;
+    }
+#ifdef _WIN32
+    if (!mem_fail && (symbol->output_options & BARCODE_STDOUT)) {
+        (void) _setmode(_fileno(stdout), _O_BINARY);
+    }
+#endif
+
+    while (more) {
+        struct batch_chunk *const chunk = chunks + cur;
+
+        /* Read chunk while workers encode previous one */
+        chunk->count = 0;
+        chunk->data_len = 0;
+        while (chunk->count < max_lines) {
+            struct batch_job *const job = chunk->jobs + chunk->count;
+            const unsigned char *record;
+            int ret;
+            if (line_count >= 2000000000) {
+                more = 0;
+                break;
+            }
+            if ((!reader->mapped || csv) && chunk->data_size - chunk->data_len < BATCH_CSV_FIELDS_SIZE) {
+                unsigned char *const data = (unsigned char *) realloc(chunk->data, chunk->data_size * 2);
+                if (!data) {
+                    mem_fail = 2;
+                    more = 0;
+                    break;
+                }
+                chunk->data = data;
+                chunk->data_size *= 2;
+            }
+            if ((ret = batch_read_line(reader, &record, &job->length)) == 0) {
+                more = 0;
+                break;
+            }
+            job->line_count = line_count++;
+            job->memfile = NULL;
+            job->memfile_size = 0;
+            job->offset = 0;
+            job->dedupe = -1;
+            job->repeat = 0;
+            if (ret < 0) {
+                job->length = -1;
+                job->ret = ZINT_ERROR_TOO_LONG;
+                job->outfile[0] = '\0';
+                cpy_str(job->errtxt, ARRAY_SIZE(job->errtxt), "Error 103: Input data too long");
+            } else if (csv) {
+                /* Unquoted fields copied, data field NUL-terminated */
+                unsigned char *const fields = chunk->data + chunk->data_len;
+                if ((job->ret = batch_csv_row(csv, record, job->length, fields, &job->row, job->errtxt))) {
+                    job->length = -1; /* Not encoded */
+                    job->outfile[0] = '\0';
+                } else {
+                    job->offset = chunk->data_len + job->row.data_offset;
+                    job->length = job->row.data_length;
+                    chunk->data_len += job->row.fields_length;
+                    if (job->row.outfile_offset >= 0) {
+                        batch_csv_outfile((const char *) fields + job->row.outfile_offset, job->line_count,
+                                            filetype, output_file);
+                    } else if (mirror_mode == 0) {
+                        batch_outfile(format_string, job->line_count, output_file);
+                    } else {
+                        mirror_outfile(symbol, fields + job->row.data_offset, job->length, filetype, output_file,
+                                        mirror_start_o);
+                    }
+                    cpy_str(job->outfile, ARRAY_SIZE(job->outfile), output_file);
+                }
+            } else {
+                job->ret = 0;
+                if (reader->mapped) {
+                    job->data = record; /* Valid until input unmapped */
+                } else {
+                    /* View only valid until next read so copy, NUL-terminated in case zero length (`data` set
+                       below as may be realloced) */
+                    job->offset = chunk->data_len;
+                    memcpy(chunk->data + chunk->data_len, record, job->length);
+                    chunk->data[chunk->data_len + job->length] = '\0';
+                    chunk->data_len += job->length + 1;
+                }
+                if (mirror_mode == 0) {
+                    batch_outfile(format_string, job->line_count, output_file);
+                } else {
+                    /* Name the output file from the data being processed */
+                    mirror_outfile(symbol, record, job->length, filetype, output_file, mirror_start_o);
+                }
+                cpy_str(job->outfile, ARRAY_SIZE(job->outfile), output_file);
+            }
+            if (job->length >= 0 && writer && writer->dedupe) {
+                const unsigned char *const data = reader->mapped && !csv ? record : chunk->data + job->offset;
+                job->dedupe = batch_dedupe_begin(writer->dedupe, csv ? &job->row : NULL, rotate_angle, job->outfile,
+                                                data, job->length, job->line_count, &job->repeat, &job->memfile,
+                                                &job->memfile_size, &job->ret, job->errtxt);
+            }
+            chunk->count++;
+        }
+        if (!reader->mapped || csv) {
+            for (i = 0; i < chunk->count; i++) {
+                chunk->jobs[i].data = chunk->data + chunk->jobs[i].offset;
+            }
+        }
+
+        if (running) {
+            batch_workers_wait(workers, jobs);
+            error_number = batch_chunk_report(chunks + !cur, archive, writer, error_number);
+            running = 0;
+        }
+        if (chunk->count) {
+            batch_workers_start(workers, jobs, chunk);
+            running = 1;
+        }
+        cur = !cur;
+    }
+    if (running) {
+        batch_workers_wait(workers, jobs);
+        error_number = batch_chunk_report(chunks + !cur, archive, writer, error_number);
+    }
+    if (mem_fail) {
+        if (mem_fail == 1) {
+            fprintf(stderr, "Error 207: Insufficient memory for batch jobs\n");
+        } else {
+            fprintf(stderr, "On line %d: Error 207: Insufficient memory for batch jobs\n", line_count);
+        }
+        fflush(stderr);
+        error_number = ZINT_ERROR_MEMORY;
+    }
+
+    if (workers) {
+        for (i = 0; i < jobs; i++) {
+            if (workers[i].symbol) {
+                stats_merge(symbol, workers[i].symbol);
+                if (trace) {
+                    trace_write(trace, workers[i].symbol, i + 1 /*tid*/);
+                }
+            }
+            ZBarcode_Delete(workers[i].symbol);
+        }
+        free(workers);
+    }
+    for (i = 0; i < 2; i++) {
+        free(chunks[i].jobs);
+        free(chunks[i].data);
+    }
+    *p_line_count = line_count;
+
+    return error_number;
+}
+
+/* Batch mode - output symbol for each line of text in `filename` (or each NUL-terminated record if `nul_delim`),
+   or if `seq` given for each item of the sequence (`filename` ignored), or if `sheet` given output all symbols on
+   sheet(s). If `csv_sep` non-zero lines are CSV (',') or TSV ('\t') rows with a header row naming the columns. If
+   `jobs` > 1 (and no `sheet`) lines are encoded in parallel by `jobs` worker threads. If `archive` given (and no
+   `sheet`) outputs are written to it rather than to files, or if `writer` given (and no `sheet` or `archive`)
+   outputs are written to files by it. If `trace` given the trace events of any worker or sheet symbols are written
+   to it */
+static int batch_process(struct zint_symbol *const symbol, const char *const filename,
+            const struct batch_sequence *const seq, const int nul_delim, const int csv_sep, const int mirror_mode,
+            const char *const filetype, const int output_given, const int rotate_angle,
+            const struct zint_sheet *const sheet, const int jobs, struct batch_archive *const archive,
+            struct batch_writer *const writer, struct trace_file *const trace) {
+    FILE *file;
+    struct batch_reader reader;
+    const unsigned char *record;
+    int length, ret;
+    struct batch_csv csv;
+    struct batch_row row;
+    unsigned char *fields = NULL;
+    char errtxt[ERRBUF_SIZE];
+    struct batch_write w;
+    int dedupe_idx, repeat;
+    int error_number = 0, warn_number = 0;
+    int line_count = 1;
+    char output_file[ARRAY_SIZE(symbol->outfile)];
+    char format_string[ARRAY_SIZE(symbol->outfile)];
+    int i, mirror_start_o = 0;
+    /* Suppress clang-19 warning clang-analyzer-unix.Stream */
+    const int from_stdin = !seq && strcmp(filename, "-") == 0;
+    const int close_file = !seq && !from_stdin;
+    const int option_1 = symbol->option_1, option_2 = symbol->option_2, option_3 = symbol->option_3;
+    struct zint_symbol **sheet_symbols = NULL;
+    int sheet_cnt = 0, sheet_size = 0;
+
+    if (sheet) {
+        /* Single output file (or base name if multiple pages) */
+        if (symbol->outfile[0] == '\0' || !output_given) {
+            cpycat_str(output_file, ARRAY_SIZE(output_file), "out.", filetype);
+        } else {
+            cpy_str(output_file, ARRAY_SIZE(output_file), symbol->outfile);
+            set_extension(output_file, filetype);
+        }
+    } else if (mirror_mode) {
+        /* Use directory if any from outfile */
+        warn_number = mirror_start(symbol, output_given, &mirror_start_o);
+        if (mirror_start_o) {
+            memcpy(output_file, symbol->outfile, mirror_start_o);
+        }
+    } else {
+        if (symbol->outfile[0] == '\0' || !output_given) {
+            cpy_str(format_string, ARRAY_SIZE(format_string), "~~~~~.");
+            ncpy_str(format_string + 6, ARRAY_SIZE(format_string) - 6, filetype, 3);
+        } else {
+            cpy_str(format_string, ARRAY_SIZE(format_string), symbol->outfile);
+            set_extension(format_string, filetype);
+        }
+    }
+
+    if (seq) {
+        file = NULL;
+    } else if (from_stdin) {
+        file = stdin;
+    } else {
+#ifdef _WIN32
+        file = win_fopen(filename, "rb");
+#else
+        file = fopen(filename, "rb");
+#endif
+        if (!file) {
+            fprintf(stderr, "Error 102: Unable to read input file '%s' (%d: %s)\n", filename, errno, strerror(errno));
+            fflush(stderr);
+            return ZINT_ERROR_INVALID_DATA;
+        }
+    }
+    if (!batch_reader_init(&reader, file, nul_delim ? '\0' : '\n', seq)) {
+        fprintf(stderr, "Error 208: Insufficient memory for input buffer\n");
+        fflush(stderr);
+        if (close_file) {
+            (void) fclose(file);
+        }
+        return ZINT_ERROR_MEMORY;
+    }
+    if (archive) {
+        if (!batch_archive_open(archive)) {
+            batch_reader_free(&reader);
+            if (close_file) {
+                (void) fclose(file);
+            }
+            return ZINT_ERROR_FILE_ACCESS;
+        }
+        /* Output to memory to be added to archive */
+        symbol->output_options = (symbol->output_options & ~BARCODE_STDOUT) | BARCODE_MEMORY_FILE;
+    } else if (writer) {
+        /* Output to memory to be written by writer */
+        symbol->output_options |= BARCODE_MEMORY_FILE;
+        if (writer->dedupe && (ret = batch_dedupe_open(writer->dedupe, symbol))) {
+            batch_reader_free(&reader);
+            if (close_file) {
+                (void) fclose(file);
+            }
+            return ret;
+        }
+        batch_writer_open(writer);
+    }
+    if (csv_sep) {
+        if (!(fields = (unsigned char *) malloc(BATCH_CSV_FIELDS_SIZE))) {
+            fprintf(stderr, "Error 208: Insufficient memory for input buffer\n");
+            fflush(stderr);
+            error_number = ZINT_ERROR_MEMORY;
+        } else if ((ret = batch_read_line(&reader, &record, &length)) < 0) {
+            fprintf(stderr, "On line 1: Error 103: Input data too long\n");
+            fflush(stderr);
+            error_number = ZINT_ERROR_TOO_LONG;
+        } else if (ret && (error_number = batch_csv_header(&csv, csv_sep, symbol, rotate_angle, record, length,
+                                                            fields, errtxt))) {
+            fprintf(stderr, "On line 1: %s\n", errtxt);
+            fflush(stderr);
+        }
+        line_count++;
+    }
+
+    if (error_number) {
+        /* Header row failed */
+    } else if (jobs > 1 && !sheet) {
+        error_number = batch_jobs_process(symbol, &reader, mirror_mode, filetype, format_string, output_file,
+                                            mirror_start_o, rotate_angle, jobs, csv_sep ? &csv : NULL, archive,
+                                            writer, trace, &line_count);
+    } else {
+        while (line_count < 2000000000
+                && (ret = batch_read_line(&reader, &record, &length)) != 0) {
+            if (ret < 0) {
+                fprintf(stderr, "On line %d: Error 103: Input data too long\n", line_count);
+                fflush(stderr);
+                if (error_number == 0) {
+                    error_number = ZINT_ERROR_TOO_LONG;
+                }
+                if (archive && (ret = batch_archive_add(archive, line_count, "", ZINT_ERROR_TOO_LONG,
+                                                        "Error 103: Input data too long", NULL, 0))) {
+                    error_number = ret;
+                }
+                line_count++;
+                continue;
+            }
+            if (csv_sep) {
+                if ((ret = batch_csv_row(&csv, record, length, fields, &row, errtxt))) {
+                    fprintf(stderr, "On line %d: %s\n", line_count, errtxt);
+                    fflush(stderr);
+                    /* As with too long, only recorded if no previous error */
+                    if (error_number == 0) {
+                        error_number = ret;
+                    }
+                    if (archive && (ret = batch_archive_add(archive, line_count, "", ret, errtxt, NULL, 0))) {
+                        error_number = ret;
+                    }
+                    line_count++;
+                    continue;
+                }
+                record = fields + row.data_offset;
+                length = row.data_length;
+            }
+
+            if (sheet) {
+                if (csv_sep) {
+                    batch_row_apply(symbol, &row);
+                }
+                warn_number = batch_sheet_add(symbol, record, length, line_count, &sheet_symbols, &sheet_cnt,
+                                                &sheet_size);
+                if (warn_number >= ZINT_ERROR) {
+                    error_number = warn_number;
+                    if (warn_number == ZINT_ERROR_MEMORY) {
+                        break;
+                    }
+                }
+                line_count++;
+                continue;
+            }
+
+            if (csv_sep && row.outfile_offset >= 0) {
+                batch_csv_outfile((const char *) fields + row.outfile_offset, line_count, filetype, output_file);
+            } else if (mirror_mode == 0) {
+                batch_outfile(format_string, line_count, output_file);
+            } else {
+                /* Name the output file from the data being processed */
+                mirror_outfile(symbol, record, length, filetype, output_file, mirror_start_o);
+            }
+            if (csv_sep) {
+                batch_row_apply(symbol, &row);
+            }
+
+            cpy_str(symbol->outfile, ARRAY_SIZE(symbol->outfile), output_file);
+            if (writer) {
+                memset(&w, 0, sizeof(w));
+                cpy_str(w.filename, ARRAY_SIZE(w.filename), output_file);
+                w.line_count = line_count;
+            }
+            dedupe_idx = -1;
+            repeat = 0;
+            if (writer && writer->dedupe) {
+                dedupe_idx = batch_dedupe_begin(writer->dedupe, csv_sep ? &row : NULL, rotate_angle, output_file,
+                                                record, length, line_count, &repeat, &w.data, &w.size, &warn_number,
+                                                errtxt);
+            }
+            if (!repeat) {
+                warn_number = ZBarcode_Encode_and_Print(symbol, record, length,
+                                                        csv_sep ? row.rotate_angle : rotate_angle);
+                if (warn_number != 0) {
+                    cpy_str(errtxt, ARRAY_SIZE(errtxt), symbol->errtxt);
+                }
+                if (writer && warn_number < ZINT_ERROR && symbol->memfile) {
+                    /* Copy rather than take ownership so as not to free across library boundary */
+                    if ((w.data = (unsigned char *) malloc(symbol->memfile_size))) {
+                        memcpy(w.data, symbol->memfile, symbol->memfile_size);
+                        w.size = symbol->memfile_size;
+                    } else {
+                        fprintf(stderr, "On line %d: Error 206: Insufficient memory for output\n", line_count);
+                        fflush(stderr);
+                        error_number = ZINT_ERROR_MEMORY;
+                    }
+                }
+            }
+            if (dedupe_idx >= 0) {
+                batch_dedupe_end(writer->dedupe, dedupe_idx, repeat, &warn_number, errtxt, &w);
+            }
+            if (warn_number != 0) {
+                fprintf(stderr, "On line %d: %s\n", line_count, errtxt);
+                fflush(stderr);
+                if (warn_number >= ZINT_ERROR) {
+                    error_number = warn_number;
+                }
+            }
+            if (archive && (ret = batch_archive_add(archive, line_count, output_file, warn_number, errtxt,
+                                                    symbol->memfile, symbol->memfile_size))) {
+                error_number = ret;
+            } else if (writer && (w.data || w.link[0])) {
+                batch_writer_put(writer, &w);
+            }
+            ZBarcode_Clear(symbol);
+            /* Undo any feedback so that each line encoded with the same options */
+            symbol->option_1 = option_1;
+            symbol->option_2 = option_2;
+            symbol->option_3 = option_3;
+            line_count++;
+        }
+    }
+
+    if (reader.last_ch != reader.delim) {
+        if (nul_delim) {
+            fprintf(stderr, "Warning 209: No NUL at end of input file, last record **IGNORED**\n");
+        } else {
+            fprintf(stderr, "Warning 104: No newline at end of input file, last line **IGNORED**\n");
+        }
+        fflush(stderr);
+        warn_number = ZINT_WARN_INVALID_OPTION; /* TODO: maybe new warning e.g. ZINT_WARN_INVALID_INPUT? */
+    }
+    batch_reader_free(&reader);
+    free(fields);
+    if (archive && (ret = batch_archive_close(archive))) {
+        error_number = ret;
+    } else if (writer) {
+        if ((ret = batch_writer_close(writer))) {
+            error_number = ret;
+        }
+        if (writer->dedupe) {
+            batch_dedupe_close(writer->dedupe);
+        }
+    }
+
+    if (close_file) {
+        if (fclose(file) != 0) {
+            fprintf(stderr, "Warning 196: Failure on closing input file '%s' (%d: %s)\n", filename, errno,
+                    strerror(errno));
+            fflush(stderr);
+            warn_number = ZINT_WARN_INVALID_OPTION; /* TODO: maybe new warning e.g. ZINT_WARN_INVALID_INPUT? */
+        }
+    }
+
+    if (sheet_symbols) {
+        if (sheet_cnt && error_number != ZINT_ERROR_MEMORY) {
+            cpy_str(sheet_symbols[0]->outfile, ARRAY_SIZE(sheet_symbols[0]->outfile), output_file);
+            ret = ZBarcode_Print_Sheet(sheet_symbols, sheet_cnt, sheet, rotate_angle);
+            if (ret != 0) {
+                fprintf(stderr, "%s\n", sheet_symbols[0]->errtxt);
+                fflush(stderr);
+                if (ret >= ZINT_ERROR) {
+                    error_number = ret;
+                } else {
+                    warn_number = ret;
+                }
+            }
+        }
+        for (i = 0; i < sheet_cnt; i++) {
+            stats_merge(symbol, sheet_symbols[i]);
+            if (trace) {
+                trace_write(trace, sheet_symbols[i], 0 /*tid*/);
+            }
+            ZBarcode_Delete(sheet_symbols[i]);
+        }
+        free(sheet_symbols);
+    }
+
+    return error_number ? error_number : warn_number;
+}
+
+#define SERVE_REQUEST_MAX   (ZINT_MAX_DATA_LEN + 1024) /* Maximum length of a serve request */
+
+/* Serve mode - parse request `payload` of `length` (NUL-terminated at `length`) into `row`, defaulting to `base`.
+   The payload is NUL-terminated "name=value" fields, the names being as for CSV/TSV columns, except that "data"
+   must come last and takes the rest of the payload. Returns 0 on success, else ZINT_ERROR_INVALID_DATA and sets
+   `errtxt` */
+static int serve_request(const struct batch_row *const base, unsigned char *const payload, const int length,
+            struct batch_row *const row, char errtxt[ERRBUF_SIZE]) {
+    int i = 0;
+
+    *row = *base;
+    row->data_offset = length; /* Empty if no data field */
+    row->data_length = 0;
+
+    while (i < length) {
+        const char *const field = (const char *) payload + i;
+        const char *const eq = (const char *) memchr(field, '=', length - i);
+        const int name_len = eq ? (int) (eq - field) : 0;
+        char name[16];
+        int col, value_offset, value_len;
+
+        if (!eq || memchr(field, '\0', name_len)) {
+            sprintf(errtxt, "Error 231: Invalid request field %.60s (no '=')", field);
+            return ZINT_ERROR_INVALID_DATA;
+        }
+        col = -1;
+        if (name_len < ARRAY_SIZE(name)) {
+            ncpy_str(name, ARRAY_SIZE(name), field, name_len);
+            col = batch_col_lookup(name);
+        }
+        if (col < 0) {
+            sprintf(errtxt, "Error 232: Unknown request field '%.*s'", name_len > 60 ? 60 : name_len, field);
+            return ZINT_ERROR_INVALID_DATA;
+        }
+        value_offset = i + name_len + 1;
+        if (col == BATCH_COL_DATA) {
+            value_len = length - value_offset;
+        } else {
+            const unsigned char *const nul = (const unsigned char *) memchr(payload + value_offset, '\0',
+                                                                            length - value_offset);
+            value_len = nul ? (int) (nul - payload) - value_offset : length - value_offset;
+        }
+        if (!batch_row_field(row, col, (const char *) payload + value_offset, value_len, value_offset)) {
+            sprintf(errtxt, "Error 224: Invalid %.9s value '%.60s'", batch_csv_names[col],
+                    (const char *) payload + value_offset);
+            return ZINT_ERROR_INVALID_DATA;
+        }
+        i = value_offset + value_len + 1;
+    }
+
+    return 0;
+}
+
+/* Serve mode - write reply of `ret`, message `errtxt` and output `data` of `size` to `out`, returning 0 on
+   failure */
+static int serve_reply(FILE *const out, const int ret, const char *const errtxt, const unsigned char *const data,
+            const int size) {
+    const int errtxt_len = ret ? (int) strlen(errtxt) : 0;
+    unsigned char b[4];
+
+    batch_le(b, (unsigned long) ret, 4);
+    fwrite(b, 1, 4, out);
+    batch_le(b, (unsigned long) errtxt_len, 2);
+    fwrite(b, 1, 2, out);
+    fwrite(errtxt, 1, errtxt_len, out);
+    batch_le(b, (unsigned long) size, 4);
+    fwrite(b, 1, 4, out);
+    if (size) {
+        fwrite(data, 1, size, out);
+    }
+    return fflush(out) == 0 && !ferror(out);
+}
+
+/* Serve mode - answer requests read from `in` until end of input, writing replies to `out`. Each request is a
+   32-bit little-endian length followed by the payload (see `serve_request()`), and each reply the 32-bit status,
+   16-bit length and message, and 32-bit length and output data. `buf` must be `SERVE_REQUEST_MAX + 1` long.
+   Returns 0 on end of input, else ZINT_ERROR_FILE_ACCESS if truncated or on write failure */
+static int serve_session(struct zint_symbol *const symbol, const struct batch_row *const base,
+            const char *const filetype, FILE *const in, FILE *const out, unsigned char *const buf) {
+    unsigned char b[4];
+    int count = 0;
+    int truncated = 0;
+
+    while (1) {
+        unsigned long length;
+        struct batch_row row;
+        char errtxt[ERRBUF_SIZE];
+        int ret, ok;
+        size_t n;
+
+        count++;
+        if ((n = fread(b, 1, 4, in)) != 4) {
+            truncated = n != 0;
+            break;
+        }
+        length = b[0] | (b[1] << 8) | ((unsigned long) b[2] << 16) | ((unsigned long) b[3] << 24);
+        if (length > SERVE_REQUEST_MAX) {
+            unsigned long left = length;
+            /* Skip payload */
+            while (left && (n = fread(buf, 1, left > SERVE_REQUEST_MAX ? SERVE_REQUEST_MAX : left, in))) {
+                left -= n;
+            }
+            if ((truncated = left != 0)) {
+                break;
+            }
+            sprintf(errtxt, "Error 230: Request too long (%d maximum)", SERVE_REQUEST_MAX);
+            ok = serve_reply(out, ZINT_ERROR_TOO_LONG, errtxt, NULL, 0);
+        } else if (fread(buf, 1, length, in) != length) {
+            truncated = 1;
+            break;
+        } else {
+            buf[length] = '\0';
+            if ((ret = serve_request(base, buf, (int) length, &row, errtxt)) == 0) {
+                if (row.outfile_offset >= 0) {
+                    batch_csv_outfile((const char *) buf + row.outfile_offset, count, filetype, symbol->outfile);
+                } else {
+                    cpycat_str(symbol->outfile, ARRAY_SIZE(symbol->outfile), "out.", filetype);
+                }
+                batch_row_apply(symbol, &row);
+                ret = ZBarcode_Encode_and_Print(symbol, buf + row.data_offset, row.data_length, row.rotate_angle);
+                cpy_str(errtxt, ARRAY_SIZE(errtxt), symbol->errtxt);
+            }
+            ok = serve_reply(out, ret, errtxt, ret < ZINT_ERROR ? symbol->memfile : NULL,
+                                ret < ZINT_ERROR ? symbol->memfile_size : 0);
+            ZBarcode_Clear(symbol);
+        }
+        if (!ok) {
+            fprintf(stderr, "Error 234: Failure writing reply to request %d (%d: %s)\n", count, errno,
+                    strerror(errno));
+            fflush(stderr);
+            return ZINT_ERROR_FILE_ACCESS;
+        }
+    }
+    if (truncated) {
+        fprintf(stderr, "Error 233: Truncated request %d\n", count);
+        fflush(stderr);
+        return ZINT_ERROR_FILE_ACCESS;
+    }
+
+    return 0;
 }
 
-#ifdef _WIN32
-static FILE *win_fopen(const char *const filename, const char *const mode); /* Forward ref */
-#endif
+#ifndef _WIN32
+/* Serve mode - a worker accepting connections on a Unix domain socket, with its own copy of the symbol */
+struct serve_worker {
+    struct zint_symbol *symbol;
+    const struct batch_row *base;
+    const char *filetype;
+    int listen_fd;
+    unsigned char *buf;     /* Request buffer */
+    int started;            /* Whether `thread` started */
+    pthread_t thread;
+};
 
-/* Batch mode - output symbol for each line of text in `filename` */
-static int batch_process(struct zint_symbol *const symbol, const char *const filename, const int mirror_mode,
-            const char *const filetype, const int output_given, const int rotate_angle) {
-    FILE *file;
-    unsigned char buffer[ZINT_MAX_DATA_LEN] = {0}; /* Maximum HanXin input */
-    unsigned char character = 0;
-    int buf_posn = 0;
-    int error_number = 0, warn_number = 0;
-    int line_count = 1;
-    char output_file[ARRAY_SIZE(symbol->outfile)];
-    char format_string[ARRAY_SIZE(symbol->outfile)];
-    int i, mirror_start_o = 0;
-    const int from_stdin = strcmp(filename, "-") == 0; /* Suppress clang-19 warning clang-analyzer-unix.Stream */
+/* Serve mode - accept and serve connections until the listening socket fails or is closed */
+static void serve_worker_run(struct serve_worker *const worker) {
+    while (1) {
+        const int fd = accept(worker->listen_fd, NULL, NULL);
+        FILE *in, *out;
+        int out_fd;
 
-    if (mirror_mode) {
-        /* Use directory if any from outfile */
-        warn_number = mirror_start(symbol, output_given, &mirror_start_o);
-        if (mirror_start_o) {
-            memcpy(output_file, symbol->outfile, mirror_start_o);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            break;
         }
-    } else {
-        if (symbol->outfile[0] == '\0' || !output_given) {
-            cpy_str(format_string, ARRAY_SIZE(format_string), "~~~~~.");
-            ncpy_str(format_string + 6, ARRAY_SIZE(format_string) - 6, filetype, 3);
-        } else {
-            cpy_str(format_string, ARRAY_SIZE(format_string), symbol->outfile);
-            set_extension(format_string, filetype);
+        if ((in = fdopen(fd, "rb")) == NULL) {
+            (void) close(fd);
+            continue;
         }
-    }
-
-    if (from_stdin) {
-        file = stdin;
-    } else {
-#ifdef _WIN32
-        file = win_fopen(filename, "rb");
-#else
-        file = fopen(filename, "rb");
-#endif
-        if (!file) {
-            fprintf(stderr, "Error 102: Unable to read input file '%s' (%d: %s)\n", filename, errno, strerror(errno));
-            fflush(stderr);
-            return ZINT_ERROR_INVALID_DATA;
+        if ((out_fd = dup(fd)) < 0 || (out = fdopen(out_fd, "wb")) == NULL) {
+            if (out_fd >= 0) {
+                (void) close(out_fd);
+            }
+            (void) fclose(in);
+            continue;
         }
+        (void) serve_session(worker->symbol, worker->base, worker->filetype, in, out, worker->buf);
+        (void) fclose(out);
+        (void) fclose(in);
     }
+}
 
-    do {
-        int intChar;
-        intChar = fgetc(file);
-        if (intChar == EOF) {
-            break;
+static void *serve_worker_thread(void *arg) {
+    serve_worker_run((struct serve_worker *) arg);
+    return NULL;
+}
+#endif /* _WIN32 */
+
+/* Serve mode - answer requests over stdin/stdout, or if `socket_path` given over connections to a Unix domain
+   socket, served by `jobs` workers. The settings of `symbol` and `rotate_angle` are the defaults of each request,
+   and output is to memory in `filetype` format unless the request gives an outfile */
+static int serve(struct zint_symbol *const symbol, const char *const socket_path, const char *const filetype,
+            const int rotate_angle, const int jobs) {
+    struct batch_row base;
+    int error_number = 0;
+
+    batch_row_init(&base, symbol, rotate_angle);
+    symbol->output_options = (symbol->output_options & ~BARCODE_STDOUT) | BARCODE_MEMORY_FILE;
+
+    if (!socket_path) {
+        unsigned char *const buf = (unsigned char *) malloc(SERVE_REQUEST_MAX + 1);
+        if (!buf) {
+            fprintf(stderr, "Error 208: Insufficient memory for input buffer\n");
+            fflush(stderr);
+            return ZINT_ERROR_MEMORY;
         }
-        character = (unsigned char) intChar;
-        if (character == '\n') {
-            if (buf_posn > 0 && buffer[buf_posn - 1] == '\r') {
-                /* CR+LF - assume Windows formatting and remove CR */
-                buffer[--buf_posn] = '\0';
-            }
-
-            if (mirror_mode == 0) {
-                char number[12], reverse_number[12];
-                char reversed_string[ARRAY_SIZE(output_file)];
-                char *rs = reversed_string;
-                int inpos = 0;
-                int local_line_count = line_count;
-                const int format_len = (int) strlen(format_string);
-                memset(output_file, 0, ARRAY_SIZE(output_file));
-                do {
-                    number[inpos++] = (local_line_count % 10) + '0';
-                    local_line_count /= 10;
-                } while (local_line_count > 0);
-
-                for (i = 0; i < inpos; i++) {
-                    reverse_number[i] = number[inpos - i - 1];
-                }
-
-                for (i = format_len; i > 0; i--) {
-                    char adjusted;
-
-                    switch (format_string[i - 1]) {
-                        case '#':
-                            if (inpos > 0) {
-                                adjusted = reverse_number[inpos - 1];
-                                inpos--;
-                            } else {
-                                adjusted = ' ';
-                            }
-                            break;
-                        case '~':
-                            if (inpos > 0) {
-                                adjusted = reverse_number[inpos - 1];
-                                inpos--;
-                            } else {
-                                adjusted = '0';
-                            }
-                            break;
-                        case '@':
-                            if (inpos > 0) {
-                                adjusted = reverse_number[inpos - 1];
-                                inpos--;
-                            } else {
-#ifndef _WIN32
-                                adjusted = '*';
-#else
-                                adjusted = '+';
+#ifdef _WIN32
+        (void) _setmode(_fileno(stdin), _O_BINARY);
+        (void) _setmode(_fileno(stdout), _O_BINARY);
 #endif
-                            }
-                            break;
-                        default:
-                            adjusted = format_string[i - 1];
-                            break;
-                    }
-                    *rs++ = adjusted;
-                }
+        error_number = serve_session(symbol, &base, filetype, stdin, stdout, buf);
+        free(buf);
+    } else {
+#ifndef _WIN32
+        struct sockaddr_un addr;
+        struct stat st;
+        struct serve_worker *workers;
+        int listen_fd;
+        int i;
 
-                for (i = 0; i < format_len; i++) {
-                    output_file[i] = reversed_string[format_len - i - 1];
-                }
-            } else {
-                /* Name the output file from the data being processed */
-                mirror_outfile(symbol, buffer, buf_posn, filetype, output_file, mirror_start_o);
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        cpy_str(addr.sun_path, ARRAY_SIZE(addr.sun_path), socket_path);
+        if (stat(socket_path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+            (void) unlink(socket_path); /* Stale socket from previous run */
+        }
+        if ((listen_fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0
+                || bind(listen_fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 || listen(listen_fd, 64) != 0) {
+            fprintf(stderr, "Error 228: Unable to listen on socket '%s' (%d: %s)\n", socket_path, errno,
+                    strerror(errno));
+            fflush(stderr);
+            if (listen_fd >= 0) {
+                (void) close(listen_fd);
             }
+            return ZINT_ERROR_FILE_ACCESS;
+        }
+        (void) signal(SIGPIPE, SIG_IGN); /* Clients going away reported as write failures instead */
 
-            cpy_str(symbol->outfile, ARRAY_SIZE(symbol->outfile), output_file);
-            warn_number = ZBarcode_Encode_and_Print(symbol, buffer, buf_posn, rotate_angle);
-            if (warn_number != 0) {
-                fprintf(stderr, "On line %d: %s\n", line_count, symbol->errtxt);
-                fflush(stderr);
-                if (warn_number >= ZINT_ERROR) {
-                    error_number = warn_number;
+        if (!(workers = (struct serve_worker *) calloc(jobs, sizeof(struct serve_worker)))) {
+            error_number = ZINT_ERROR_MEMORY;
+        } else {
+            for (i = 0; i < jobs && !error_number; i++) {
+                workers[i].base = &base;
+                workers[i].filetype = filetype;
+                workers[i].listen_fd = listen_fd;
+                if (!(workers[i].symbol = clone_symbol(symbol))
+                        || !(workers[i].buf = (unsigned char *) malloc(SERVE_REQUEST_MAX + 1))) {
+                    error_number = ZINT_ERROR_MEMORY;
                 }
             }
-            ZBarcode_Clear(symbol);
-            memset(buffer, 0, ARRAY_SIZE(buffer));
-            buf_posn = 0;
-            line_count++;
-        } else {
-            buffer[buf_posn++] = character;
         }
-        if (buf_posn >= ARRAY_SIZE(buffer)) {
-            fprintf(stderr, "On line %d: Error 103: Input data too long\n", line_count);
+        if (error_number) {
+            fprintf(stderr, "Error 207: Insufficient memory for batch jobs\n");
             fflush(stderr);
-            if (error_number == 0) {
-                error_number = ZINT_ERROR_TOO_LONG;
+        } else {
+            /* First worker runs on this thread */
+            for (i = 1; i < jobs; i++) {
+                workers[i].started = pthread_create(&workers[i].thread, NULL, serve_worker_thread, workers + i)
+                                        == 0;
             }
-            do {
-                if ((intChar = fgetc(file)) == EOF) {
-                    break;
-                }
-                character = (unsigned char) intChar;
-            } while (!feof(file) && character != '\n');
-        }
-    } while (!feof(file) && line_count < 2000000000);
-
-    if (character != '\n') {
-        fprintf(stderr, "Warning 104: No newline at end of input file, last line **IGNORED**\n");
-        fflush(stderr);
-        warn_number = ZINT_WARN_INVALID_OPTION; /* TODO: maybe new warning e.g. ZINT_WARN_INVALID_INPUT? */
-    }
-
-    if (!from_stdin) {
-        if (fclose(file) != 0) {
-            fprintf(stderr, "Warning 196: Failure on closing input file '%s' (%d: %s)\n", filename, errno,
+            serve_worker_run(workers);
+            fprintf(stderr, "Error 229: Failure accepting on socket '%s' (%d: %s)\n", socket_path, errno,
                     strerror(errno));
             fflush(stderr);
-            warn_number = ZINT_WARN_INVALID_OPTION; /* TODO: maybe new warning e.g. ZINT_WARN_INVALID_INPUT? */
+            error_number = ZINT_ERROR_FILE_ACCESS;
         }
+        /* Closing wakes any other workers blocked in `accept()` */
+        (void) shutdown(listen_fd, SHUT_RDWR);
+        (void) close(listen_fd);
+        if (workers) {
+            for (i = 0; i < jobs; i++) {
+                if (workers[i].started) {
+                    pthread_join(workers[i].thread, NULL);
+                }
+                ZBarcode_Delete(workers[i].symbol);
+                free(workers[i].buf);
+            }
+            free(workers);
+        }
+        (void) unlink(socket_path);
+#else
+        (void) jobs;
+        assert(0); /* Rejected when parsing options */
+#endif
     }
-    return error_number ? error_number : warn_number;
+
+    return error_number;
 }
 
 /* Stuff to convert args on Windows command line to UTF-8 */
 #ifdef _WIN32
-#include <windows.h>
 
 #ifndef WC_ERR_INVALID_CHARS
 #define WC_ERR_INVALID_CHARS    0x00000080
@@ -1533,6 +4432,15 @@ static FILE *win_fopen(const char *const filename, const char *const mode) {
 
     return _wfopen(filenameW, modeW);
 }
+
+/* Do `mkdir()` on Windows, assuming `dirname` is UTF-8 encoded */
+static int win_mkdir(const char *const dirname) {
+    wchar_t *dirnameW;
+
+    utf8_to_wide(dirname, dirnameW, -1 /*fail return*/);
+
+    return _wmkdir(dirnameW);
+}
 #endif /* _WIN32 */
 
 /* Helper to delete `symbol` if non-NULL & free Windows args on exit */
@@ -1550,29 +4458,34 @@ static int do_exit(struct zint_symbol *symbol, const int error_number) {
 struct arg_opt { const char *arg; int opt; };
 
 enum options {
-    OPT_ADDONGAP = 128, OPT_AZFULL,
-    OPT_BATCH, OPT_BG, OPT_BINARY, OPT_BIND, OPT_BIND_TOP, OPT_BOLD, OPT_BORDER, OPT_BOX,
+    OPT_ADDONGAP = 128, OPT_ARCHIVE, OPT_ASYNC, OPT_AZFULL,
+    OPT_BATCH, OPT_BATCH0, OPT_BATCHFORMAT, OPT_BG, OPT_BINARY, OPT_BIND, OPT_BIND_TOP, OPT_BOLD, OPT_BORDER, OPT_BOX,
     OPT_CMYK, OPT_COLS, OPT_COMPLIANTHEIGHT,
-    OPT_DIRECT, OPT_DMISO144, OPT_DMRE, OPT_DMB256, OPT_DMC40, OPT_DOTSIZE, OPT_DOTTY, OPT_DUMP,
-    OPT_ECI, OPT_EMBEDFONT, OPT_ESC, OPT_EXTRAESC, OPT_FAST, OPT_FG, OPT_FILETYPE, OPT_FULLMULTIBYTE,
+    OPT_DEDUPE, OPT_DIRECT, OPT_DMISO144, OPT_DMRE, OPT_DMB256, OPT_DMC40, OPT_DMFIT, OPT_DOTSIZE, OPT_DOTTY,
+    OPT_DUMP,
+    OPT_ECI, OPT_EMBEDFONT, OPT_ESC, OPT_EXTRAESC, OPT_FAST, OPT_FG, OPT_FILETYPE, OPT_FSYNC, OPT_FULLMULTIBYTE,
     OPT_GS1, OPT_GS1NOCHECK, OPT_GS1PARENS, OPT_GS1RAW, OPT_GS1STRICT /*GS1SYNTAXENGINE_MODE*/,
     OPT_GSSEP, OPT_GUARDDESCENT, OPT_GUARDWHITESPACE,
     OPT_HEIGHT, OPT_HEIGHTPERROW, OPT_INIT, OPT_MASK, OPT_MIRROR, OPT_MODE,
     OPT_NOBACKGROUND, OPT_NOQUIETZONES, OPT_NOTEXT, OPT_PRIMARY, OPT_QUIETZONES,
     OPT_ROTATE, OPT_ROWS, OPT_SCALE, OPT_SCALEXDIM, OPT_SCMVV, OPT_SECURE,
     OPT_SEG1, OPT_SEG2, OPT_SEG3, OPT_SEG4, OPT_SEG5, OPT_SEG6, OPT_SEG7, OPT_SEG8, OPT_SEG9,
-    OPT_SEPARATOR, OPT_SMALL, OPT_SQUARE, OPT_STRUCTAPP,
+    OPT_SEPARATOR, OPT_SEQUENCE, OPT_SERVE, OPT_SHARD, OPT_SHEET, OPT_SMALL, OPT_SQUARE, OPT_STATS, OPT_STRUCTAPP,
 #ifdef ZINT_TEST
     OPT_TEST,
 #endif
-    OPT_TEXTGAP, OPT_VERBOSE, OPT_VERS, OPT_VWHITESP, OPT_WERROR
+    OPT_TEXTGAP, OPT_TRACE, OPT_VERBOSE, OPT_VERS, OPT_VWHITESP, OPT_WERROR
 };
 
 static const struct option long_options[] = {
     {"addongap", 1, NULL, OPT_ADDONGAP},
+    {"archive", 1, NULL, OPT_ARCHIVE},
+    {"async", 0, NULL, OPT_ASYNC},
     {"azfull", 0, NULL, OPT_AZFULL},
     {"barcode", 1, NULL, 'b'},
     {"batch", 0, NULL, OPT_BATCH},
+    {"batch0", 0, NULL, OPT_BATCH0},
+    {"batchformat", 1, NULL, OPT_BATCHFORMAT},
     {"bg", 1, 0, OPT_BG},
     {"bgcolor", 1, 0, OPT_BG}, /* Synonym */
     {"bgcolour", 1, 0, OPT_BG}, /* Synonym */
@@ -1586,9 +4499,11 @@ static const struct option long_options[] = {
     {"cols", 1, NULL, OPT_COLS},
     {"compliantheight", 0, NULL, OPT_COMPLIANTHEIGHT},
     {"data", 1, NULL, 'd'},
+    {"dedupe", 2, NULL, OPT_DEDUPE},
     {"direct", 0, NULL, OPT_DIRECT},
     {"dmb256", 2, NULL, OPT_DMB256},
     {"dmc40", 2, NULL, OPT_DMC40},
+    {"dmfit", 2, NULL, OPT_DMFIT},
     {"dmiso144", 0, NULL, OPT_DMISO144},
     {"dmre", 0, NULL, OPT_DMRE},
     {"dotsize", 1, NULL, OPT_DOTSIZE},
@@ -1604,6 +4519,7 @@ static const struct option long_options[] = {
     {"fgcolor", 1, 0, OPT_FG}, /* Synonym */
     {"fgcolour", 1, 0, OPT_FG}, /* Synonym */
     {"filetype", 1, NULL, OPT_FILETYPE},
+    {"fsync", 0, NULL, OPT_FSYNC},
     {"fullmultibyte", 0, NULL, OPT_FULLMULTIBYTE},
     {"gs1", 0, 0, OPT_GS1},
     {"gs1nocheck", 0, NULL, OPT_GS1NOCHECK},
@@ -1618,6 +4534,7 @@ static const struct option long_options[] = {
     {"help", 0, NULL, 'h'},
     {"init", 0, NULL, OPT_INIT},
     {"input", 1, NULL, 'i'},
+    {"jobs", 1, NULL, 'j'},
     {"mask", 1, NULL, OPT_MASK},
     {"mirror", 0, NULL, OPT_MIRROR},
     {"mode", 1, NULL, OPT_MODE},
@@ -1644,13 +4561,19 @@ static const struct option long_options[] = {
     {"seg8", 1, NULL, OPT_SEG8},
     {"seg9", 1, NULL, OPT_SEG9},
     {"separator", 1, NULL, OPT_SEPARATOR},
+    {"sequence", 1, NULL, OPT_SEQUENCE},
+    {"serve", 2, NULL, OPT_SERVE},
+    {"shard", 1, NULL, OPT_SHARD},
+    {"sheet", 1, NULL, OPT_SHEET},
     {"small", 0, NULL, OPT_SMALL},
     {"square", 0, NULL, OPT_SQUARE},
+    {"stats", 0, NULL, OPT_STATS},
     {"structapp", 1, NULL, OPT_STRUCTAPP},
 #ifdef ZINT_TEST
     {"test", 0, NULL, OPT_TEST},
 #endif
     {"textgap", 1, NULL, OPT_TEXTGAP},
+    {"trace", 1, NULL, OPT_TRACE},
     {"types", 0, NULL, 't'},
     {"verbose", 0, NULL, OPT_VERBOSE},
     {"vers", 1, NULL, OPT_VERS},
@@ -1728,7 +4651,24 @@ int main(int argc, char **argv) {
     int data_cnt = 0;
     int input_cnt = 0;
     int batch_mode = 0;
+    int csv_sep = 0;
+    int batchformat_given = 0;
+    struct batch_sequence sequence;
+    int sequence_given = 0;
+    int serve_given = 0;
+    int stats_given = 0;
+    double stats_start = 0.0;
+    struct trace_file trace = {0};
+    const char *serve_socket = NULL;
     int mirror_mode = 0;
+    struct zint_sheet sheet = {0};
+    int sheet_given = 0;
+    int jobs = 1;
+    struct batch_archive archive;
+    int archive_given = 0;
+    struct batch_writer writer = {0};
+    int writer_given = 0;
+    struct batch_dedupe dedupe;
     int fullmultibyte = 0;
     int mask = 0;
     int separator = 0;
@@ -1743,6 +4683,7 @@ int main(int argc, char **argv) {
     int data_arg_num = 0;
     int seg_count = 0;
     float x_dim_mm = 0.0f, dpmm = 0.0f;
+    float dmfit_width_mm = 0.0f, dmfit_height_mm = 0.0f;
     float float_opt;
     char errbuf[ERRBUF_SIZE]; /* For `validate_float/()`, `validate_scalexdimdp()` etc. */
     struct arg_opt *const arg_opts = (struct arg_opt *) z_alloca(sizeof(struct arg_opt) * OPT_ARGS_MAX);
@@ -1768,7 +4709,7 @@ int main(int argc, char **argv) {
 
     opterr = 0; /* Disable `getopt_long_only()` printing errors */
     while (1) {
-        const int opt = getopt_long_only(argc, argv, "b:d:ehi:o:rtvw:", long_options, NULL);
+        const int opt = getopt_long_only(argc, argv, "b:d:ehi:j:o:rtvw:", long_options, NULL);
         if (opt == -1) break;
 
         switch (opt) {
@@ -1785,19 +4726,39 @@ int main(int argc, char **argv) {
                     warn_number = ZINT_WARN_INVALID_OPTION;
                 }
                 break;
+            case OPT_ARCHIVE:
+                memset(&archive, 0, sizeof(archive));
+                if (!validate_archive(optarg, &archive, errbuf)) {
+                    fprintf(stderr, "Error 210: %s\n", errbuf);
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                }
+                archive_given = 1;
+                break;
+            case OPT_ASYNC:
+                writer.async = 1;
+                writer_given = 1;
+                break;
             case OPT_AZFULL:
                 my_symbol->option_3 = ZINT_AZTEC_FULL | (my_symbol->option_3 & ~0xFF);
                 break;
             case OPT_BATCH:
+            case OPT_BATCH0:
                 if (data_cnt == 0 && seg_count == 0) {
-                    /* Switch to batch processing mode */
-                    batch_mode = 1;
+                    /* Switch to batch processing mode, records delimited by NUL if `--batch0` */
+                    batch_mode = opt == OPT_BATCH0 ? 2 : 1;
                 } else {
                     fprintf(stderr, "Warning 141: Can't use batch mode if data given, **IGNORED**\n");
                     fflush(stderr);
                     warn_number = ZINT_WARN_INVALID_OPTION;
                 }
                 break;
+            case OPT_BATCHFORMAT:
+                if ((csv_sep = validate_batchformat(optarg)) < 0) {
+                    fprintf(stderr, "Error 216: Invalid batch format (\"lines\", \"csv\" or \"tsv\" only)\n");
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                }
+                batchformat_given = 1;
+                break;
             case OPT_BG:
                 cpy_str(my_symbol->bgcolour, ARRAY_SIZE(my_symbol->bgcolour), optarg);
                 break;
@@ -1849,6 +4810,19 @@ int main(int argc, char **argv) {
             case OPT_COMPLIANTHEIGHT:
                 my_symbol->output_options |= COMPLIANT_HEIGHT;
                 break;
+            case OPT_DEDUPE:
+                memset(&dedupe, 0, sizeof(dedupe));
+                if (optarg) {
+                    if (!optarg[0] || strlen(optarg) >= ARRAY_SIZE(dedupe.dir)) {
+                        fprintf(stderr, "Error 245: Invalid dedupe cache directory (1 to %d characters)\n",
+                                ARRAY_SIZE(dedupe.dir) - 1);
+                        return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                    }
+                    cpy_str(dedupe.dir, ARRAY_SIZE(dedupe.dir), optarg);
+                }
+                writer.dedupe = &dedupe;
+                writer_given = 1;
+                break;
             case OPT_DIRECT:
                 my_symbol->output_options |= BARCODE_STDOUT;
                 break;
@@ -1885,6 +4859,19 @@ int main(int argc, char **argv) {
                 my_symbol->option_1 = val;
                 my_symbol->option_3 = DM_C40_START | (my_symbol->option_3 & ~DM_B256_C40_START_MASK);
                 break;
+            case OPT_DMFIT:
+                if (!validate_dmfit(optarg, &my_symbol->fit.aspect, &dmfit_width_mm, &dmfit_height_mm, errbuf)) {
+                    fprintf(stderr, "Error 257: %s\n", errbuf);
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                }
+                if ((my_symbol->option_3 & DM_SQUARE_DMRE_MASK) == DM_SQUARE
+                        || (my_symbol->option_3 & DM_SQUARE_DMRE_MASK) == DM_DMRE) {
+                    fprintf(stderr, "Warning 258: Previous '--square' or '--dmre' overwritten by '--dmfit'\n");
+                    fflush(stderr);
+                    warn_number = ZINT_WARN_INVALID_OPTION;
+                }
+                my_symbol->option_3 = DM_BEST_FIT | (my_symbol->option_3 & ~DM_SQUARE_DMRE_MASK);
+                break;
             case OPT_DMISO144:
                 my_symbol->option_3 |= DM_ISO_144;
                 break;
@@ -1960,6 +4947,10 @@ int main(int argc, char **argv) {
                     warn_number = ZINT_WARN_INVALID_OPTION;
                 }
                 break;
+            case OPT_FSYNC:
+                writer.sync = 1;
+                writer_given = 1;
+                break;
             case OPT_FULLMULTIBYTE:
                 fullmultibyte = 1;
                 break;
@@ -2213,6 +5204,63 @@ int main(int argc, char **argv) {
                     warn_number = ZINT_WARN_INVALID_OPTION;
                 }
                 break;
+            case OPT_SEQUENCE:
+                if (data_cnt == 0 && seg_count == 0) {
+                    if (!validate_sequence(optarg, &sequence, errbuf)) {
+                        fprintf(stderr, "Error 254: %s\n", errbuf);
+                        return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                    }
+                    /* Switch to batch processing mode, records generated rather than read */
+                    if (batch_mode == 0) {
+                        batch_mode = 1;
+                    }
+                    sequence_given = 1;
+                } else {
+                    fprintf(stderr, "Warning 141: Can't use batch mode if data given, **IGNORED**\n");
+                    fflush(stderr);
+                    warn_number = ZINT_WARN_INVALID_OPTION;
+                }
+                break;
+            case OPT_SERVE:
+                serve_given = 1;
+                serve_socket = NULL;
+                if (optarg) {
+#ifdef _WIN32
+                    fprintf(stderr, "Error 235: Unix domain socket not supported on Windows (use stdio)\n");
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+#else
+                    if (!optarg[0] || strlen(optarg) >= ARRAY_SIZE(((struct sockaddr_un *) NULL)->sun_path)) {
+                        fprintf(stderr, "Error 226: Invalid socket path (1 to %d characters)\n",
+                                (int) ARRAY_SIZE(((struct sockaddr_un *) NULL)->sun_path) - 1);
+                        return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                    }
+                    serve_socket = optarg;
+#endif
+                }
+                break;
+            case OPT_SHARD:
+                if (!validate_int(optarg, -1 /*len*/, &val)) {
+                    fprintf(stderr, "Error 237: Invalid shard value (digits only)\n");
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                }
+                if (val <= BATCH_SHARD_MAX) { /* `val` >= 0 always */
+                    writer.shard = val;
+                    writer_given = 1;
+                } else {
+                    fprintf(stderr, "Warning 238: Shard value '%d' out of range (0 to %d), **IGNORED**\n", val,
+                            BATCH_SHARD_MAX);
+                    fflush(stderr);
+                    warn_number = ZINT_WARN_INVALID_OPTION;
+                }
+                break;
+            case OPT_SHEET:
+                memset(&sheet, 0, sizeof(sheet));
+                if (!validate_sheet(optarg, &sheet, errbuf)) {
+                    fprintf(stderr, "Error 199: %s\n", errbuf);
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                }
+                sheet_given = 1;
+                break;
             case OPT_SMALL:
                 my_symbol->output_options |= SMALL_TEXT;
                 break;
@@ -2225,6 +5273,10 @@ int main(int argc, char **argv) {
                 }
                 my_symbol->option_3 = DM_SQUARE | (my_symbol->option_3 & ~DM_SQUARE_DMRE_MASK);
                 break;
+            case OPT_STATS:
+                my_symbol->debug |= ZINT_DEBUG_STATS;
+                stats_given = 1;
+                break;
             case OPT_STRUCTAPP:
                 memset(&my_symbol->structapp, 0, sizeof(my_symbol->structapp));
                 if (!validate_structapp(optarg, &my_symbol->structapp, errbuf)) {
@@ -2256,8 +5308,16 @@ int main(int argc, char **argv) {
                     warn_number = ZINT_WARN_INVALID_OPTION;
                 }
                 break;
+            case OPT_TRACE:
+                if (!optarg[0]) {
+                    fprintf(stderr, "Error 251: Invalid trace file (empty)\n");
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                }
+                my_symbol->debug |= ZINT_DEBUG_TRACE;
+                trace.filename = optarg;
+                break;
             case OPT_VERBOSE:
-                my_symbol->debug = 1;
+                my_symbol->debug |= ZINT_DEBUG_PRINT;
                 break;
             case OPT_VERS:
                 if (!validate_int(optarg, -1 /*len*/, &val)) {
@@ -2373,6 +5433,21 @@ int main(int argc, char **argv) {
                 }
                 break;
 
+            case 'j':
+                if (!validate_int(optarg, -1 /*len*/, &val)) {
+                    fprintf(stderr, "Error 202: Invalid jobs value (digits only)\n");
+                    return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+                }
+                if (val <= BATCH_JOBS_MAX) { /* `val` >= 0 always */
+                    jobs = val;
+                } else {
+                    fprintf(stderr, "Warning 203: Jobs value '%d' out of range (0 to %d), **IGNORED**\n", val,
+                            BATCH_JOBS_MAX);
+                    fflush(stderr);
+                    warn_number = ZINT_WARN_INVALID_OPTION;
+                }
+                break;
+
             case 'o':
                 cpy_str(my_symbol->outfile, ARRAY_SIZE(my_symbol->outfile), optarg);
                 output_given = 1;
@@ -2432,7 +5507,13 @@ int main(int argc, char **argv) {
         warn_number = ZINT_WARN_INVALID_OPTION;
     }
 
-    if (data_arg_num) {
+    if (trace.filename && data_arg_num && !serve_given && !trace_open(&trace)) {
+        return do_exit(my_symbol, ZINT_ERROR_FILE_ACCESS);
+    }
+    if (stats_given) {
+        stats_start = stats_now();
+    }
+    if (data_arg_num || serve_given || sequence_given) {
         const int symbology = my_symbol->symbology;
         const unsigned int cap = ZBarcode_Cap(symbology, ZINT_CAP_EANUPC | ZINT_CAP_FULL_MULTIBYTE
                                     | ZINT_CAP_MASK | ZINT_CAP_BINDABLE);
@@ -2478,9 +5559,53 @@ int main(int argc, char **argv) {
                 cpy_str(filetype, ARRAY_SIZE(filetype), no_png ? "gif" : "png");
             }
         }
-        if (batch_mode) {
-            /* Take each line of text as a separate data set */
-            if (data_arg_num > 1) {
+        if (dmfit_width_mm > 0.0f || dmfit_height_mm > 0.0f) {
+            /* Convert maximum size from mm to X-dimensions */
+            const float fit_x_dim_mm = x_dim_mm > 0.0f ? x_dim_mm : ZBarcode_Default_Xdim(symbology);
+            my_symbol->fit.max_width = dmfit_width_mm / fit_x_dim_mm;
+            my_symbol->fit.max_height = dmfit_height_mm / fit_x_dim_mm;
+        }
+        if (serve_given) {
+            if (data_arg_num || batch_mode) {
+                fprintf(stderr, "Error 227: Cannot use data, input or batch mode with '--serve'\n");
+                return do_exit(my_symbol, ZINT_ERROR_INVALID_OPTION);
+            }
+            if (sheet_given || archive_given || batchformat_given || mirror_mode || writer_given || stats_given
+                    || trace.filename) {
+                fprintf(stderr, "Warning 236: Batch options not used with '--serve', **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+            }
+            if (dpmm) {
+                /* Allow `x_dim_mm` to be zero */
+                if (x_dim_mm == 0.0f) {
+                    x_dim_mm = ZBarcode_Default_Xdim(symbology);
+                }
+                float_opt = ZBarcode_Scale_From_XdimDp(symbology, x_dim_mm, dpmm, filetype);
+                assert(float_opt > 0.0f); /* Can't fail due to previous checks */
+                my_symbol->scale = float_opt;
+                my_symbol->dpmm = dpmm;
+            }
+            if (jobs == 0) {
+                jobs = batch_jobs_auto();
+            }
+            error_number = serve(my_symbol, serve_socket, filetype, rotate_angle, jobs);
+        } else if (batch_mode) {
+            /* Take each line of text (or each item of sequence) as a separate data set */
+            if (sequence_given) {
+                if (data_arg_num) {
+                    fprintf(stderr, "Warning 255: Input file '%s' not used with '--sequence', **IGNORED**\n",
+                            arg_opts[0].arg);
+                    fflush(stderr);
+                    warn_number = ZINT_WARN_INVALID_OPTION;
+                }
+                if (csv_sep) {
+                    fprintf(stderr, "Warning 256: '--batchformat' not used with '--sequence', **IGNORED**\n");
+                    fflush(stderr);
+                    warn_number = ZINT_WARN_INVALID_OPTION;
+                    csv_sep = 0;
+                }
+            } else if (data_arg_num > 1) {
                 fprintf(stderr,
                         "Warning 144: First input file '%s' only processed, subsequent input files **IGNORED**\n",
                         arg_opts[0].arg);
@@ -2506,9 +5631,66 @@ int main(int argc, char **argv) {
                 fflush(stderr);
                 warn_number = ZINT_WARN_INVALID_OPTION;
             }
-            error_number = batch_process(my_symbol, arg_opts[0].arg, mirror_mode, filetype, output_given,
-                                        rotate_angle);
+            if (sheet_given && mirror_mode) {
+                fprintf(stderr, "Warning 200: '--mirror' not used with '--sheet', **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+                mirror_mode = 0;
+            }
+            if (sheet_given && archive_given) {
+                fprintf(stderr, "Warning 212: '--archive' not used with '--sheet', **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+                archive_given = 0;
+            }
+            if (writer_given && (sheet_given || archive_given || (my_symbol->output_options & BARCODE_STDOUT))) {
+                fprintf(stderr, "Warning 244: '--async', '--dedupe', '--fsync' and '--shard' not used with '--archive',"
+                                " '--direct' or '--sheet', **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+                writer_given = 0;
+            }
+            if (sheet_given && jobs != 1) {
+                fprintf(stderr, "Warning 205: '--jobs' not used with '--sheet', **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+                jobs = 1;
+            } else if (jobs == 0) {
+                jobs = batch_jobs_auto();
+            }
+            error_number = batch_process(my_symbol, sequence_given ? NULL : arg_opts[0].arg,
+                                        sequence_given ? &sequence : NULL, batch_mode == 2 /*nul_delim*/, csv_sep,
+                                        mirror_mode, filetype, output_given, rotate_angle,
+                                        sheet_given ? &sheet : NULL, jobs, archive_given ? &archive : NULL,
+                                        writer_given ? &writer : NULL, trace.fp ? &trace : NULL);
         } else {
+            if (sheet_given) {
+                fprintf(stderr, "Warning 201: '--sheet' given but not batch mode, **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+            }
+            if (jobs != 1) {
+                fprintf(stderr, "Warning 204: '--jobs' given but not batch mode, **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+            }
+            if (archive_given) {
+                fprintf(stderr, "Warning 211: '--archive' given but not batch mode, **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+            }
+            if (batchformat_given) {
+                fprintf(stderr, "Warning 225: '--batchformat' given but not batch mode, **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+            }
+            if (writer_given) {
+                fprintf(stderr,
+                        "Warning 243: '--async', '--dedupe', '--fsync' or '--shard' given but not batch mode,"
+                        " **IGNORED**\n");
+                fflush(stderr);
+                warn_number = ZINT_WARN_INVALID_OPTION;
+            }
             if (seg_count) {
                 if (data_arg_num > 1) {
                     fprintf(stderr, "Error 170: Cannot specify segments and multiple data arguments together\n");
@@ -2604,6 +5786,15 @@ int main(int argc, char **argv) {
         warn_number = ZINT_WARN_INVALID_OPTION;
     }
 
+    if (stats_given && data_arg_num && !serve_given) {
+        stats_print(my_symbol, stats_now() - stats_start);
+    }
+    if (trace.fp) {
+        trace_write(&trace, my_symbol, 0 /*tid*/);
+        if (trace_close(&trace) && error_number < ZINT_ERROR) {
+            error_number = ZINT_ERROR_FILE_WRITE;
+        }
+    }
     ZBarcode_Delete(my_symbol);
 
     return do_exit(NULL /*symbol*/, error_number ? error_number : warn_number);
@@ -2805,6 +5996,11 @@ static int test_supported_filetype(void) {
         /* 10*/ { "TIFF", 0, 0, 1 },
         /* 11*/ { "tIFF", 0, 0, 1 },
         /* 12*/ { "tifff", 0, 0, 0 },
+        /* 13*/ { "PdF", 0, 0, 1 },
+        /* 14*/ { "zpl", 0, 0, 1 },
+        /* 15*/ { "POS", 0, 0, 1 },
+        /* 16*/ { "pbm", 0, 0, 1 },
+        /* 17*/ { "ZMM", 0, 0, 1 },
     };
     int i;
     for (i = 0; i < ARRAY_SIZE(data); i++) {
@@ -2908,6 +6104,12 @@ static int test_is_raster(void) {
         /* 13*/ { "TIFF", 0, 1 },
         /* 14*/ { "tIFF", 0, 1 },
         /* 15*/ { "tifff", 0, 0 },
+        /* 16*/ { "pdf", 0, 0 },
+        /* 17*/ { "PDF", 1, 0 },
+        /* 18*/ { "zpl", 0, 1 },
+        /* 19*/ { "POS", 1, 1 },
+        /* 20*/ { "PBM", 0, 1 },
+        /* 21*/ { "zmm", 0, 0 },
     };
     int i;
     for (i = 0; i < ARRAY_SIZE(data); i++) {
@@ -3090,6 +6292,72 @@ static int test_validate_structapp(void) {
     return 1;
 }
 
+static int test_validate_sequence(void) {
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    static const struct { const char *arg; int ret; const char *start; const char *step; int count; const char *format; const char *errbuf; } data[] = {
+        /*  0*/ { "", 0, "", "", -1, NULL, "Invalid sequence argument, expect \"start,end[,step[,format]]\"" },
+        /*  1*/ { ",1", 0, "", "", -1, NULL, "Invalid sequence start (1 to 18 digits only)" },
+        /*  2*/ { "1234567890123456789,1", 0, "", "", -1, NULL, "Invalid sequence start (1 to 18 digits only)" },
+        /*  3*/ { "1,", 0, "1", "", -1, NULL, "Invalid sequence end (1 to 18 digits only)" },
+        /*  4*/ { "1,2a", 0, "1", "", -1, NULL, "Invalid sequence end (1 to 18 digits only)" },
+        /*  5*/ { "1,2,0", 0, "1", "0", -1, NULL, "Invalid sequence step (1 to 18 digits only, non-zero)" },
+        /*  6*/ { "1,2,,", 0, "1", "1", -1, NULL, "Invalid sequence step (1 to 18 digits only, non-zero)" },
+        /*  7*/ { "2,1", 0, "2", "1", -1, "", "Sequence end less than start" },
+        /*  8*/ { "0,1999999999", 0, "0", "1", -1, "", "Sequence too long (maximum 1999999999 items)" },
+        /*  9*/ { "0,1999999998", 1, "0", "1", 1999999999, "", "" },
+        /* 10*/ { "1,10", 1, "1", "1", 10, "", "" },
+        /* 11*/ { "1,10,3", 1, "1", "3", 4, "", "" },
+        /* 12*/ { "1,10,3,", 1, "1", "3", 4, "", "" },
+        /* 13*/ { "1,10,3,A$$,B", 1, "1", "3", 4, "A$$,B", "" },
+        /* 14*/ { "1,10,1,$", 0, "1", "1", 10, "$", "Sequence item 10 does not fit format '$'" },
+        /* 15*/ { "5,105,20,$$", 0, "5", "20", 6, "$$", "Sequence item 6 does not fit format '$$'" },
+        /* 16*/ { "5,85,20,$$", 1, "5", "20", 5, "$$", "" },
+        /* 17*/ { "1,10,1,?", 0, "1", "1", 10, "?", "Sequence item 1 does not fit format '?'" },
+        /* 18*/ { "1,10,1,##?", 1, "1", "1", 10, "##?", "" },
+        /* 19*/ { "5,15,1,#?#", 0, "5", "1", 11, "#?#", "Sequence item 1 does not fit format '#?#'" },
+        /* 20*/ { "10,15,1,#?#", 1, "10", "1", 6, "#?#", "" },
+        /* 21*/ { "1,10,1,X?", 0, "1", "1", 10, "X?", "Sequence item 1 does not fit format 'X?'" },
+        /* 22*/ { "5,10,1,*?$", 0, "5", "1", 6, "*?$", "Sequence item 1 does not fit format '*?$'" },
+        /* 23*/ { "9,100,1,##$?", 1, "9", "1", 92, "##$?", "" },
+        /* 24*/ { "999999999999999999,999999999999999999", 1, "999999999999999999", "1", 1, "", "" },
+    };
+    int i;
+    for (i = 0; i < ARRAY_SIZE(data); i++) {
+        char errbuf[ERRBUF_SIZE] = {0};
+        struct batch_sequence seq = { "", "", -1, NULL };
+        const int ret = validate_sequence(data[i].arg, &seq, errbuf);
+        if (ret != data[i].ret) {
+            fprintf(stderr, "%d: ret %d != %d\n", i, ret, data[i].ret);
+            assert(0);
+            return 0;
+        }
+        if (strcmp(errbuf, data[i].errbuf) != 0) {
+            fprintf(stderr, "%d: errbuf \"%s\" != \"%s\"\n", i, errbuf, data[i].errbuf);
+            assert(0);
+            return 0;
+        }
+        if (strcmp(seq.start, data[i].start) != 0 || strcmp(seq.step, data[i].step) != 0) {
+            fprintf(stderr, "%d: start/step \"%s\"/\"%s\" != \"%s\"/\"%s\"\n", i, seq.start, seq.step,
+                    data[i].start, data[i].step);
+            assert(0);
+            return 0;
+        }
+        if (seq.count != data[i].count) {
+            fprintf(stderr, "%d: count %d != %d\n", i, seq.count, data[i].count);
+            assert(0);
+            return 0;
+        }
+        if ((seq.format == NULL) != (data[i].format == NULL)
+                || (seq.format && strcmp(seq.format, data[i].format) != 0)) {
+            fprintf(stderr, "%d: format \"%s\" != \"%s\"\n", i, seq.format ? seq.format : "(null)",
+                    data[i].format ? data[i].format : "(null)");
+            assert(0);
+            return 0;
+        }
+    }
+    return 1;
+}
+
 static int test_validate_seg(void) {
     /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
     /* NOLINTNEXTLINE(clang-analyzer-optin.performance.Padding) disable "Excessive padding" warning */
@@ -3303,7 +6571,9 @@ static int test_batch_process(void) {
     printf("++++ Following error expected, ignore: ");
     fflush(stdout);
 
-    ret = batch_process(symbol, filename, mirror_mode, filetype, output_given, rotate_angle);
+    ret = batch_process(symbol, filename, NULL /*seq*/, 0 /*nul_delim*/, 0 /*csv_sep*/, mirror_mode, filetype,
+                        output_given, rotate_angle, NULL /*sheet*/, 1 /*jobs*/, NULL /*archive*/, NULL /*writer*/,
+                        NULL /*trace*/);
 
     if (ret != ZINT_ERROR_INVALID_DATA) {
         fprintf(stderr, "batch_process \"%s\", ret %d != \n", filename, ret);
@@ -3443,6 +6713,7 @@ static int test(void) {
     ret &= test_validate_units();
     ret &= test_validate_scalexdimdp();
     ret &= test_validate_structapp();
+    ret &= test_validate_sequence();
     ret &= test_validate_seg();
     ret &= test_mirror_start();
     ret &= test_mirror_outfile();
@@ -29,7 +29,10 @@
  */
 /* SPDX-License-Identifier: BSD-3-Clause */
 
-#ifndef _WIN32
+#ifdef _WIN32
+#include <windows.h> /* For `rm_cache_dir()` */
+#else
+#include <dirent.h> /* For `rm_cache_dir()` */
 #include <sys/wait.h> /* For WIFEXITED/WEXITSTATUS */
 #endif
 
@@ -812,79 +815,998 @@ static void test_batch_input(const testCtx *const p_ctx) {
     testFinish();
 }
 
-static void test_batch_large(const testCtx *const p_ctx) {
+static void test_batch0_input(const testCtx *const p_ctx) {
     int debug = p_ctx->debug;
 
     struct item {
         int b;
-        int mirror;
-        const char *pattern;
+        const char *input;
         int length;
-        int noeol;
+        const char *opt;
 
         const char *expected;
     };
     /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
     struct item data[] = {
-        /*  0*/ { BARCODE_HANXIN, 0, "1", 7827, 0, "00001.gif" },
-        /*  1*/ { BARCODE_HANXIN, 1, "1", 7827, 0, "11111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111.gif" },
-        /*  2*/ { BARCODE_HANXIN, 0, "1", 7828, 0, NULL },
-        /*  3*/ { BARCODE_HANXIN, 0, "1", ZINT_MAX_DATA_LEN, 0, NULL },
-        /*  4*/ { BARCODE_HANXIN, 0, "1", ZINT_MAX_DATA_LEN + 1, 1, NULL },
+        /*  0*/ { BARCODE_CODE128, "123\000456\000", 8, "", "D3 96 72 F7 65 C9 61 8E B\nD3 97 62 F7 67 49 19 8E B" },
+        /*  1*/ { BARCODE_CODE128, "123\000456\000", 8, " --jobs=2", "D3 96 72 F7 65 C9 61 8E B\nD3 97 62 F7 67 49 19 8E B" },
+        /*  2*/ { BARCODE_CODE128, "12\n3\000", 5, "", "D3 96 73 AF 43 2C B9 EB B1 D6" }, /* Newline part of data */
+        /*  3*/ { BARCODE_CODE128, "123\r\000", 5, "", "D3 96 73 AF 65 CF 75 21 B1 D6" }, /* CR not removed */
+        /*  4*/ { BARCODE_CODE128, "123\000456", 7, "", "D3 96 72 F7 65 C9 61 8E B\nWarning 209: No NUL at end of input file, last record **IGNORED**" },
+        /*  5*/ { BARCODE_CODE128, "\000A\000", 3, "", "On line 1: Error 778: No input data\nD2 14 62 2C 63 AC" },
+        /*  6*/ { BARCODE_CODE128, "", 0, "", "Warning 209: No NUL at end of input file, last record **IGNORED**" },
     };
     int data_size = ARRAY_SIZE(data);
     int i;
 
-    char cmd[16384];
-    char data_buf[ZINT_MAX_DATA_LEN + 4];
-    char buf[16384];
+    char cmd[4096];
+    char buf[4096];
 
-    const char *input_filename = "test_batch_large.txt";
+    const char *input_filename = "test_batch0_input.bin";
+    FILE *fp;
+
+    testStart("test_batch0_input");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --dump --batch0");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+
+        fp = testUtilOpen(input_filename, "wb");
+        assert_nonnull(fp, "i:%d testUtilOpen(%s) NULL\n", i, input_filename);
+        assert_equal((int) fwrite(data[i].input, 1, data[i].length, fp), data[i].length,
+                    "i:%d fwrite(%s) != %d\n", i, input_filename, data[i].length);
+        assert_zero(fclose(fp), "i:%d fclose(%s) != 0\n", i, input_filename);
+        sprintf(cmd + strlen(cmd), " -i \"%s\"", input_filename);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                    i, input_filename, errno, strerror(errno));
+    }
+
+    testFinish();
+}
+
+static void test_batch_format(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        const char *input;
+        const char *opt;
+
+        const char *expected;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { "symbology,data\nCODE128,123\nEAN13,123\n", " --batchformat=csv", "D3 96 72 F7 65 C9 61 8E B\nA3 46 8D 1A 34 6A B9 72 CD B2 15 0A" },
+        /*  1*/ { "symbology,data\nCODE128,123\nEAN13,123\n", " --batchformat=CSV --jobs=2", "D3 96 72 F7 65 C9 61 8E B\nA3 46 8D 1A 34 6A B9 72 CD B2 15 0A" },
+        /*  2*/ { "Data\tSymbology\n123\t\n123\t15\n", " --batchformat=tsv", "D3 96 72 F7 65 C9 61 8E B\nA3 46 8D 1A 34 6A B9 72 CD B2 15 0A" },
+        /*  3*/ { "data\n\"1,2\"\r\n", " --batchformat=csv", "D2 13 9A CE 67 2B C5 8E B" },
+        /*  4*/ { "symbology,data,option_2\nMICROQR,1,\nMICROQR,1,2\n", " --batchformat=csv", "FE A\n82 8\nBA 6\nBA 8\nBA 6\n82 0\nFE 6\n00 A\nC4 6\n5F A\nFF 6\nFE A8\n82 08\nBA 28\nBA F8\nBA 50\n82 48\nFE F0\n00 10\nE2 A0\n27 28\nDF F8\n6D 50\n9A A8" },
+        /*  5*/ { "data,option_2\n1,2\n1,\n", " --batchformat=csv -b MICROQR -j 2", "FE A8\n82 08\nBA 28\nBA F8\nBA 50\n82 48\nFE F0\n00 10\nE2 A0\n27 28\nDF F8\n6D 50\n9A A8\nFE A\n82 8\nBA 6\nBA 8\nBA 6\n82 0\nFE 6\n00 A\nC4 6\n5F A\nFF 6" },
+        /*  6*/ { "data\n123\n", " --batchformat=lines", "D2 10 9A 58 4F 49 61 47 B1 D6\nD3 96 72 F7 65 C9 61 8E B" },
+        /*  7*/ { "data,fred\n123\n", " --batchformat=csv", "On line 1: Error 217: Unknown column 'fred'" },
+        /*  8*/ { "data,DATA\n123\n", " --batchformat=csv", "On line 1: Error 218: Duplicate column 'data'" },
+        /*  9*/ { "scale\n1\n", " --batchformat=csv", "On line 1: Error 219: No 'data' column in header" },
+        /* 10*/ { "data,,,,,,,,,,,,,,,,\n123\n", " --batchformat=csv", "On line 1: Error 220: Too many columns (16 maximum)" },
+        /* 11*/ { "data\n\"123\n456\n", " --batchformat=csv", "On line 2: Error 221: Unterminated quoted field 1\nD3 97 62 F7 67 49 19 8E B" },
+        /* 12*/ { "data\n\"123\"4\n456\n", " --batchformat=csv", "On line 2: Error 222: Invalid character after closing quote of field 1\nD3 97 62 F7 67 49 19 8E B" },
+        /* 13*/ { "data,scale\n123\n456,1\n", " --batchformat=csv", "On line 2: Error 223: Row has 1 fields, header has 2\nD3 97 62 F7 67 49 19 8E B" },
+        /* 14*/ { "data,scale\n123,-1\n456,1\n", " --batchformat=csv --jobs=2", "On line 2: Error 224: Invalid scale value '-1'\nD3 97 62 F7 67 49 19 8E B" },
+        /* 15*/ { "data\tsymbology\n123\tfred\n", " --batchformat=tsv", "On line 2: Error 224: Invalid symbology value 'fred'" },
+        /* 16*/ { "data\tsymbology\n123\t\"20\"\n", " --batchformat=tsv", "On line 2: Error 224: Invalid symbology value '\"20\"'" },
+        /* 17*/ { "data\n123\n", " --batchformat=xml", "Error 216: Invalid batch format (\"lines\", \"csv\" or \"tsv\" only)" },
+        /* 18*/ { NULL, " --batchformat=csv -d 123", "Warning 225: '--batchformat' given but not batch mode, **IGNORED**\nD3 96 72 F7 65 C9 61 8E B" },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+
+    const char *input_filename = "test_batch_format.txt";
     int have_input;
 
-    testStart("test_batch_large");
+    testStart("test_batch_format");
 
-#ifdef _WIN32
-    testSkip("Test not compatible with Windows");
-    return;
-#endif
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --dump");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        if (data[i].input) {
+            strcat(cmd, " --batch");
+        }
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        if (have_input) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
+        }
+    }
+
+    testFinish();
+}
+
+static void test_batch_archive(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *input;
+        const char *opt;
+        const char *archive;
+
+        const char *expected;
+        int expected_size;
+        int expected_o1;
+        const char *expected_bytes1;
+        int expected_bytes1_len;
+        int expected_o2;
+        const char *expected_bytes2;
+        int expected_bytes2_len;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, "123\n", " --archive=tar,test_batch_archive.tar", "test_batch_archive.tar", "", 2048, 0, "x1.txt\000", 7, 512, "D3 96 72 F7 65 C9 61 8E B\n\000", 27 },
+        /*  1*/ { BARCODE_CODE128, "123\n", " --archive=TAR,test_batch_archive.tar --jobs=2", "test_batch_archive.tar", "", 2048, 124, "00000000032\000", 12, 257, "ustar\00000", 8 },
+        /*  2*/ { BARCODE_EAN13, "12\nA\n", " --archive=stream,test_batch_archive.bin", "test_batch_archive.bin", "On line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)", 166, 0, "ZBS1\001\000\000\000\000\000\000\000\006\000x1.txt\000\000$\000\000\000A3 46 8D 1A 34 6A B9 72 E5 9B 64 2A\n", 62, 62, "\002\000\000\000\006\000\000\000\006\000x2.txtR\000Error 284", 27 },
+        /*  3*/ { BARCODE_EAN13, "12\nA\n", " --archive=stream,test_batch_archive.bin -j 2", "test_batch_archive.bin", "On line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)", 166, 0, "ZBS1\001\000\000\000\000\000\000\000\006\000x1.txt\000\000$\000\000\000A3 46 8D 1A 34 6A B9 72 E5 9B 64 2A\n", 62, 62, "\002\000\000\000\006\000\000\000\006\000x2.txtR\000Error 284", 27 },
+        /*  4*/ { BARCODE_CODE128, "123\n", " --archive=zip", NULL, "Error 210: Invalid archive type (\"tar\" or \"stream\" only)", 0, 0, NULL, 0, 0, NULL, 0 },
+        /*  5*/ { BARCODE_CODE128, "123\n", " --archive=tar,", NULL, "Error 210: Invalid archive filename (1 to 255 characters)", 0, 0, NULL, 0, 0, NULL, 0 },
+        /*  6*/ { BARCODE_CODE128, NULL, " --archive=tar -d 1", NULL, "Warning 211: '--archive' given but not batch mode, **IGNORED**", 0, 0, NULL, 0, 0, NULL, 0 },
+        /*  7*/ { BARCODE_CODE128, "123\n", " --archive=tar,test_batch_archive.tar --sheet=2 --filetype=svg", NULL, "Warning 212: '--archive' not used with '--sheet', **IGNORED**", 0, 0, NULL, 0, 0, NULL, 0 },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+    unsigned char archive_buf[4096];
+    int archive_size;
+
+    const char *input_filename = "test_batch_archive.txt";
+    int have_input;
+
+    testStart("test_batch_archive");
 
     for (i = 0; i < data_size; i++) {
 
         if (testContinue(p_ctx, i)) continue;
 
-        strcpy(cmd, "zint --batch --filetype=gif");
+        strcpy(cmd, "zint -o x~.txt --filetype=txt");
         if (debug & ZINT_DEBUG_PRINT) {
             strcat(cmd, " --verbose");
         }
 
         arg_int(cmd, "-b ", data[i].b);
-        arg_bool(cmd, "--mirror", data[i].mirror);
+        if (data[i].input) {
+            strcat(cmd, " --batch");
+        }
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
 
-        testUtilStrCpyRepeat(data_buf, data[i].pattern, data[i].length);
-        if (!data[i].noeol) {
-            strcat(data_buf, "\n");
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        if (data[i].archive) {
+            assert_zero(testUtilReadFile(data[i].archive, archive_buf, sizeof(archive_buf), &archive_size),
+                        "i:%d testUtilReadFile(%s) != 0\n", i, data[i].archive);
+            assert_equal(archive_size, data[i].expected_size, "i:%d archive_size %d != expected_size %d\n",
+                        i, archive_size, data[i].expected_size);
+            assert_zero(memcmp(archive_buf + data[i].expected_o1, data[i].expected_bytes1,
+                                data[i].expected_bytes1_len), "i:%d memcmp bytes1 != 0\n", i);
+            assert_zero(memcmp(archive_buf + data[i].expected_o2, data[i].expected_bytes2,
+                                data[i].expected_bytes2_len), "i:%d memcmp bytes2 != 0\n", i);
+            assert_zero(testUtilRemove(data[i].archive), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].archive, errno, strerror(errno));
+        } else if (strstr(data[i].opt, "--sheet")) {
+            assert_zero(testUtilRemove("x~.svg"), "i:%d testUtilRemove(x~.svg) != 0 (%d: %s)\n",
+                        i, errno, strerror(errno));
+        } else if (!data[i].input) {
+            assert_zero(testUtilRemove("x~.txt"), "i:%d testUtilRemove(x~.txt) != 0 (%d: %s)\n",
+                        i, errno, strerror(errno));
+        }
+        assert_nonzero(testUtilExists("x1.txt") == 0, "i:%d testUtilExists(x1.txt) != 0\n", i);
+
+        if (have_input) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
         }
-        have_input = arg_input(cmd, input_filename, data_buf);
+    }
 
-        if (!data[i].expected) {
-            if (data[i].noeol) {
-                printf("++++ Following error and warning expected, ignore: ");
-            } else {
-                printf("++++ Following error expected, ignore: ");
-            }
-            fflush(stdout);
+    testFinish();
+}
+
+static void test_batch_writer(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *input;
+        const char *opt;
+
+        const char *expected;
+        const char *expected_file1;
+        const char *expected_file2;
+        const char *expected_dir1;
+        const char *expected_dir2;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, "123\n456\n", " --async", "", "x1.txt", "x2.txt", NULL, NULL },
+        /*  1*/ { BARCODE_CODE128, "123\n456\n", " --async --jobs=2", "", "x1.txt", "x2.txt", NULL, NULL },
+        /*  2*/ { BARCODE_CODE128, "123\n456\n", " --fsync", "", "x1.txt", "x2.txt", NULL, NULL },
+        /*  3*/ { BARCODE_CODE128, "123\n456\n", " --shard=2", "", "f7/x1.txt", "92/x2.txt", "f7", "92" },
+        /*  4*/ { BARCODE_CODE128, "123\n456\n", " --shard=1 --async --fsync", "", "f/x1.txt", "9/x2.txt", "f", "9" },
+        /*  5*/ { BARCODE_CODE128, "123\n456\n", " --shard=4 --async -j 2", "", "f794/x1.txt", "928a/x2.txt", "f794", "928a" },
+        /*  6*/ { BARCODE_EAN13, "123\nA\n", " --async --shard=1", "On line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)", "f/x1.txt", NULL, "f", NULL },
+        /*  7*/ { BARCODE_CODE128, "123\n", " --shard=A", "Error 237: Invalid shard value (digits only)", NULL, NULL, NULL, NULL },
+        /*  8*/ { BARCODE_CODE128, "123\n", " --shard=5", "Warning 238: Shard value '5' out of range (0 to 4), **IGNORED**", "x1.txt", NULL, NULL, NULL },
+        /*  9*/ { BARCODE_CODE128, NULL, " --async -d 123", "Warning 243: '--async', '--dedupe', '--fsync' or '--shard' given but not batch mode, **IGNORED**", "x~.txt", NULL, NULL, NULL },
+        /* 10*/ { BARCODE_CODE128, "123\n", " --shard=2 --archive=tar,test_batch_writer.tar", "Warning 244: '--async', '--dedupe', '--fsync' and '--shard' not used with '--archive', '--direct' or '--sheet', **IGNORED**", "test_batch_writer.tar", NULL, NULL, NULL },
+        /* 11*/ { BARCODE_CODE128, "123\n456\n", " --async -o test_batch_writer_dir/x~.txt", "", "test_batch_writer_dir/x1.txt", "test_batch_writer_dir/x2.txt", "test_batch_writer_dir", NULL }, /* Creates directory */
+        /* 12*/ { BARCODE_CODE128, "123\n", " --fsync -o test_batch_writer_dir/sub/x~.txt", "", "test_batch_writer_dir/sub/x1.txt", NULL, "test_batch_writer_dir/sub", "test_batch_writer_dir" },
+        /* 13*/ { BARCODE_CODE128, "123\n", " --shard=1 -o test_batch_writer_dir/x~.txt", "", "test_batch_writer_dir/f/x1.txt", NULL, "test_batch_writer_dir/f", "test_batch_writer_dir" },
+        /* 14*/ { BARCODE_CODE128, "123\n123\n", " --dedupe -o test_batch_writer_dir/x~.txt", "", "test_batch_writer_dir/x1.txt", "test_batch_writer_dir/x2.txt", "test_batch_writer_dir", NULL }, /* 2nd is link */
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+
+    const char *input_filename = "test_batch_writer.txt";
+    int have_input;
+
+    testStart("test_batch_writer");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint -o x~.txt --filetype=txt");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        if (data[i].input) {
+            strcat(cmd, " --batch");
         }
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
         assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
-        if (data[i].expected) {
-            assert_zero(testUtilRemove(data[i].expected), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
-                        i, data[i].expected, errno, strerror(errno));
-        } else {
-            assert_zero(testUtilExists("out.gif"), "i:%d testUtilExists(out.gif) != 0 (%d: %s) (%s)\n",
-                        i, errno, strerror(errno), cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        if (data[i].expected_file1) {
+            assert_zero(testUtilRemove(data[i].expected_file1), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_file1, errno, strerror(errno));
+        }
+        if (data[i].expected_file2) {
+            assert_zero(testUtilRemove(data[i].expected_file2), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_file2, errno, strerror(errno));
+        }
+        if (data[i].expected_dir1) {
+            assert_zero(testUtilRmDir(data[i].expected_dir1), "i:%d testUtilRmDir(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_dir1, errno, strerror(errno));
+        }
+        if (data[i].expected_dir2) {
+            assert_zero(testUtilRmDir(data[i].expected_dir2), "i:%d testUtilRmDir(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_dir2, errno, strerror(errno));
         }
 
-        if (have_input && (p_ctx->index == -1 || data[i].expected)) {
+        if (have_input) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
+        }
+    }
+
+    testFinish();
+}
+
+static void test_batch_sequence(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *opt;
+
+        const char *expected;
+        int num_expected;
+        const char *expected_files;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, " --sequence=1,3", "", 3, "x1.txt\000x2.txt\000x3.txt" },
+        /*  1*/ { BARCODE_CODE128, " --sequence=1,3 --mirror", "", 3, "1.txt\0002.txt\0003.txt" },
+        /*  2*/ { BARCODE_CODE128, " \"--sequence=8,12,2,SN-***\" --mirror -j 2", "", 3, "SN-" TEST_INPUT_ASTERISK TEST_INPUT_ASTERISK "8.txt\000SN-" TEST_INPUT_ASTERISK "10.txt\000SN-" TEST_INPUT_ASTERISK "12.txt" },
+        /*  3*/ { BARCODE_GS1_128, " \"--sequence=1234567890,1234567891,1,[00]1061414##########?\" --mirror", "", 2, "[00]106141412345678908.txt\000[00]106141412345678915.txt" },
+        /*  4*/ { BARCODE_CODE128, " --sequence=1,10,1,#", "Error 254: Sequence item 10 does not fit format '#'", 0, NULL },
+        /*  5*/ { BARCODE_CODE128, " --sequence=2,1", "Error 254: Sequence end less than start", 0, NULL },
+        /*  6*/ { BARCODE_CODE128, " --sequence=1", "Error 254: Invalid sequence argument, expect \"start,end[,step[,format]]\"", 0, NULL },
+        /*  7*/ { BARCODE_CODE128, " -d 1 --sequence=1,2", "Warning 141: Can't use batch mode if data given, **IGNORED**", 1, "x~.txt" },
+        /*  8*/ { BARCODE_CODE128, " --sequence=1,2 -d 3", "Warning 122: Can't define data in batch mode, **IGNORED** '3'", 2, "x1.txt\000x2.txt" },
+        /*  9*/ { BARCODE_CODE128, " --sequence=1,2 --batchformat=csv", "Warning 256: '--batchformat' not used with '--sequence', **IGNORED**", 2, "x1.txt\000x2.txt" },
+        /* 10*/ { BARCODE_CODE128, " --sequence=1,2 -i test_batch_sequence.txt", "Warning 255: Input file 'test_batch_sequence.txt' not used with '--sequence', **IGNORED**", 2, "x1.txt\000x2.txt" },
+        /* 11*/ { BARCODE_CODE128, " --sequence=1,2 --archive=tar,test_batch_sequence.tar", "", 1, "test_batch_sequence.tar" },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i, j;
+
+    char cmd[4096];
+    char buf[4096];
+
+    testStart("test_batch_sequence");
+
+    for (i = 0; i < data_size; i++) {
+        const char *outfile;
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint -o x~.txt --filetype=txt");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        outfile = data[i].expected_files;
+        for (j = 0; j < data[i].num_expected; j++) {
+            assert_zero(testUtilRemove(outfile), "i:%d j:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, j, outfile, errno, strerror(errno));
+            outfile += strlen(outfile) + 1;
+        }
+    }
+
+    testFinish();
+}
+
+/* Return number of lines in `filename`, -1 if can't open */
+static int file_lines(const char *filename) {
+    FILE *fp = testUtilOpen(filename, "rb");
+    int ch, lines = 0;
+
+    if (!fp) {
+        return -1;
+    }
+    while ((ch = fgetc(fp)) != EOF) {
+        if (ch == '\n') {
+            lines++;
+        }
+    }
+    fclose(fp);
+    return lines;
+}
+
+/* Remove dedupe cache directory `dir` and its cache files, returning 0 on success */
+static int rm_cache_dir(const char *dir) {
+    char path[512];
+#ifdef _WIN32
+    WIN32_FIND_DATAA find_data;
+    HANDLE handle;
+
+    sprintf(path, "%s\\*.zdc", dir);
+    if ((handle = FindFirstFileA(path, &find_data)) != INVALID_HANDLE_VALUE) {
+        do {
+            sprintf(path, "%s\\%s", dir, find_data.cFileName);
+            if (testUtilRemove(path) != 0) {
+                FindClose(handle);
+                return -1;
+            }
+        } while (FindNextFileA(handle, &find_data));
+        FindClose(handle);
+    }
+#else
+    DIR *d;
+    struct dirent *entry;
+
+    if (!(d = opendir(dir))) {
+        return -1;
+    }
+    while ((entry = readdir(d)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            sprintf(path, "%s/%s", dir, entry->d_name);
+            if (testUtilRemove(path) != 0) {
+                closedir(d);
+                return -1;
+            }
+        }
+    }
+    closedir(d);
+#endif
+    return testUtilRmDir(dir);
+}
+
+static void test_batch_dedupe(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *input;
+        const char *opt;
+
+        const char *expected;
+        const char *expected_file1;
+        const char *expected_file2;
+        const char *expected_file3;
+        const char *cache_dir; /* Removed after if set */
+        int expected_lines; /* Of `expected_file1`, -1 if not checked */
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, "123\n456\n123\n", " --dedupe", "", "x1.txt", "x2.txt", "x3.txt", NULL, -1 },
+        /*  1*/ { BARCODE_CODE128, "123\n456\n123\n", " --dedupe --jobs=2", "", "x1.txt", "x2.txt", "x3.txt", NULL, -1 },
+        /*  2*/ { BARCODE_CODE128, "123\n456\n123\n", " --dedupe --async --fsync", "", "x1.txt", "x2.txt", "x3.txt", NULL, -1 },
+        /*  3*/ { BARCODE_EAN13, "123\nA\n123\nA\n", " --dedupe", "On line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)\nOn line 4: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)", "x1.txt", NULL, "x3.txt", NULL, -1 },
+        /*  4*/ { BARCODE_EAN13, "123\nA\n123\nA\n", " --dedupe -j 2", "On line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)\nOn line 4: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)", "x1.txt", NULL, "x3.txt", NULL, -1 },
+        /*  5*/ { BARCODE_CODE128, "123\n", " --dedupe=", "Error 245: Invalid dedupe cache directory (1 to 200 characters)", NULL, NULL, NULL, NULL, -1 },
+        /*  6*/ { BARCODE_CODE128, NULL, " --dedupe -d 123", "Warning 243: '--async', '--dedupe', '--fsync' or '--shard' given but not batch mode, **IGNORED**", "x~.txt", NULL, NULL, NULL, -1 },
+        /*  7*/ { BARCODE_DATAMATRIX, "1234567890ABCDEFGHIJ\n", " --dmfit=3 --dedupe=test_batch_dedupe_cache", "", "x1.txt", NULL, NULL, NULL, 12 }, /* Keeps cache for next */
+        /*  8*/ { BARCODE_DATAMATRIX, "1234567890ABCDEFGHIJ\n", " --dmfit=1 --dedupe=test_batch_dedupe_cache", "", "x1.txt", NULL, NULL, "test_batch_dedupe_cache", 18 }, /* Not from cache */
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+
+    const char *input_filename = "test_batch_dedupe.txt";
+    int have_input;
+
+    testStart("test_batch_dedupe");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint -o x~.txt --filetype=txt");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        if (data[i].input) {
+            strcat(cmd, " --batch");
+        }
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        if (data[i].expected_file1 && data[i].expected_file3) {
+            /* Repeated line same as first */
+            assert_zero(testUtilCmpTxts(data[i].expected_file1, data[i].expected_file3),
+                        "i:%d testUtilCmpTxts(%s, %s) != 0\n", i, data[i].expected_file1, data[i].expected_file3);
+        }
+        if (data[i].expected_lines != -1) {
+            const int lines = file_lines(data[i].expected_file1);
+            assert_equal(lines, data[i].expected_lines, "i:%d file_lines(%s) %d != %d\n",
+                        i, data[i].expected_file1, lines, data[i].expected_lines);
+        }
+        if (data[i].expected_file1) {
+            assert_zero(testUtilRemove(data[i].expected_file1), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_file1, errno, strerror(errno));
+        }
+        if (data[i].expected_file2) {
+            assert_zero(testUtilRemove(data[i].expected_file2), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_file2, errno, strerror(errno));
+        }
+        if (data[i].expected_file3) {
+            assert_zero(testUtilRemove(data[i].expected_file3), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_file3, errno, strerror(errno));
+        }
+
+        if (data[i].cache_dir) {
+            assert_zero(rm_cache_dir(data[i].cache_dir), "i:%d rm_cache_dir(%s) != 0 (%d: %s)\n",
+                        i, data[i].cache_dir, errno, strerror(errno));
+        }
+
+        if (have_input) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
+        }
+    }
+
+    testFinish();
+}
+
+static void test_stats(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *data;
+        const char *input;
+        const char *opt;
+
+        const char *expected; /* Prefix */
+        const char *expected_phase;
+        const char *expected_file;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, "123", NULL, " --stats", "Stats: 1 encodes, 1 outputs in ", "\n  encode            1 ", "out.txt" },
+        /*  1*/ { BARCODE_QRCODE, "123", NULL, " --stats", "Stats: 1 encodes, 1 outputs in ", "\n  mask              1 ", "out.txt" },
+        /*  2*/ { BARCODE_DATAMATRIX, NULL, "123\n456\n", " --stats", "Stats: 2 encodes, 2 outputs in ", "\n  place             2 ", "2.txt" },
+        /*  3*/ { BARCODE_DATAMATRIX, NULL, "123\n456\n", " --stats --jobs=2", "Stats: 2 encodes, 2 outputs in ", "\n  ecc               2 ", "2.txt" },
+        /*  4*/ { BARCODE_CODE128, NULL, "123\n456\n", " --stats --sheet=2 --filetype=svg", "Stats: 2 encodes, 1 outputs in ", "\n  encode            2 ", "~.svg" },
+        /*  5*/ { BARCODE_EAN13, NULL, "A\n123\n", " --stats", "On line 1: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)\nStats: 2 encodes, 1 outputs in ", ", 3 bytes in, ", "2.txt" },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+
+    const char *input_filename = "test_stats.txt";
+    int have_input;
+
+    testStart("test_stats");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --filetype=txt");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        if (data[i].data) {
+            arg_data(cmd, "-d ", data[i].data);
+            strcat(cmd, " -o out.txt");
+        } else {
+            strcat(cmd, " --batch -o ~.txt");
+        }
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strncmp(buf, data[i].expected, strlen(data[i].expected)), "i:%d buf (%s) != expected (%s)\n",
+                    i, buf, data[i].expected);
+        assert_nonnull(strstr(buf, data[i].expected_phase), "i:%d strstr(%s, %s) NULL\n",
+                    i, buf, data[i].expected_phase);
+
+        if (data[i].expected_file) {
+            assert_zero(testUtilRemove(data[i].expected_file), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_file, errno, strerror(errno));
+        }
+        if (data[i].input) {
+            (void) testUtilRemove("1.txt");
+        }
+
+        if (have_input) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
+        }
+    }
+
+    testFinish();
+}
+
+static void test_trace(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *data;
+        const char *input;
+        const char *opt;
+
+        const char *expected;
+        const char *expected_trace; /* strstr */
+        const char *expected_trace2; /* strstr */
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_QRCODE, "123", NULL, " --trace=test_trace.json", "", "{\"name\":\"mask\",\"cat\":\"zint\",\"ph\":\"X\",\"pid\":1,\"tid\":0,", "\"args\":{\"symbology\":\"QRCODE\",\"length\":3,\"rows\":21,\"width\":21,\"bytes\":" },
+        /*  1*/ { BARCODE_DATAMATRIX, NULL, "123\n4567\n", " --trace=test_trace.json", "", "\"symbology\":\"DATAMATRIX\",\"length\":4,", "\n]}\n" },
+        /*  2*/ { BARCODE_DATAMATRIX, NULL, "123\n4567\n", " --trace=test_trace.json --jobs=2", "", "\"tid\":2,\"args\":{\"name\":\"worker 2\"}}", "\"tid\":1,\"ts\":" },
+        /*  3*/ { BARCODE_CODE128, NULL, "123\n456\n", " --trace=test_trace.json --sheet=2 --filetype=svg", "", "\"name\":\"encode\",\"cat\":\"zint\",\"ph\":\"X\",\"pid\":1,\"tid\":0,", "\"symbology\":\"CODE128\",\"length\":3," },
+        /*  4*/ { BARCODE_CODE128, "123", NULL, " --trace=", "Error 251: Invalid trace file (empty)", NULL, NULL },
+        /*  5*/ { BARCODE_CODE128, "123", NULL, " --trace=test_nosuch_dir/test_trace.json", "Error 252: Unable to open trace file 'test_nosuch_dir/test_trace.json' (", NULL, NULL },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+    unsigned char trace_buf[32768];
+    int trace_size;
+
+    const char *input_filename = "test_trace.txt";
+    const char *trace_filename = "test_trace.json";
+    int have_input;
+
+    testStart("test_trace");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --filetype=txt");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        if (data[i].data) {
+            arg_data(cmd, "-d ", data[i].data);
+            strcat(cmd, " -o out.txt");
+        } else {
+            strcat(cmd, " --batch -o ~.txt");
+        }
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strncmp(buf, data[i].expected, strlen(data[i].expected)), "i:%d buf (%s) != expected (%s)\n",
+                    i, buf, data[i].expected);
+
+        if (data[i].expected_trace) {
+            assert_zero(testUtilReadFile(trace_filename, trace_buf, sizeof(trace_buf) - 1, &trace_size),
+                        "i:%d testUtilReadFile(%s) != 0\n", i, trace_filename);
+            trace_buf[trace_size] = '\0';
+            assert_zero(strncmp((const char *) trace_buf, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", 40),
+                        "i:%d trace_buf (%.40s) bad start\n", i, trace_buf);
+            assert_nonnull(strstr((const char *) trace_buf, data[i].expected_trace), "i:%d strstr(%s, %s) NULL\n",
+                        i, trace_buf, data[i].expected_trace);
+            assert_nonnull(strstr((const char *) trace_buf, data[i].expected_trace2), "i:%d strstr(%s, %s) NULL\n",
+                        i, trace_buf, data[i].expected_trace2);
+            assert_zero(testUtilRemove(trace_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, trace_filename, errno, strerror(errno));
+        } else {
+            assert_zero(testUtilExists(trace_filename), "i:%d testUtilExists(%s) != 0\n", i, trace_filename);
+        }
+
+        if (data[i].data) {
+            (void) testUtilRemove("out.txt");
+        } else if (strstr(data[i].opt, "--sheet")) {
+            assert_zero(testUtilRemove("~.svg"), "i:%d testUtilRemove(~.svg) != 0 (%d: %s)\n",
+                        i, errno, strerror(errno));
+        } else {
+            assert_zero(testUtilRemove("1.txt"), "i:%d testUtilRemove(1.txt) != 0 (%d: %s)\n",
+                        i, errno, strerror(errno));
+            assert_zero(testUtilRemove("2.txt"), "i:%d testUtilRemove(2.txt) != 0 (%d: %s)\n",
+                        i, errno, strerror(errno));
+        }
+
+        if (have_input) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
+        }
+    }
+
+    testFinish();
+}
+
+static void test_serve(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        const char *input;
+        int length;
+        const char *opt;
+
+        const char *expected;
+        const char *expected_reply;
+        int expected_reply_len;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { "%\000\000\000symbology=EAN13\000outfile=.txt\000data=123", 41, "", "", "\000\000\000\000\000\000$\000\000\000A3 46 8D 1A 34 6A B9 72 CD B2 15 0A\n", 46 },
+        /*  1*/ { "\010\000\000\000data=123", 12, " -b EAN13 --filetype=txt", "", "\000\000\000\000\000\000$\000\000\000A3 46 8D 1A 34 6A B9 72 CD B2 15 0A\n", 46 },
+        /*  2*/ { "\010\000\000\000data=123\010\000\000\000data=456", 24, " --filetype=txt", "", "\000\000\000\000\000\000\032\000\000\000D3 96 72 F7 65 C9 61 8E B\n\000\000\000\000\000\000\032\000\000\000D3 97 62 F7 67 49 19 8E B\n", 72 },
+        /*  3*/ { "\007\000\000\000bogus=1", 11, "", "", "\006\000\000\000(\000Error 232: Unknown request field 'bogus'\000\000\000\000", 50 },
+        /*  4*/ { "\010\000\000\000scale=-1", 12, "", "", "\006\000\000\000#\000Error 224: Invalid scale value '-1'\000\000\000\000", 45 },
+        /*  5*/ { "\005\000\000\000abc", 7, "", "Error 233: Truncated request 1", "", 0 },
+        /*  6*/ { "", 0, " -d 123", "Error 227: Cannot use data, input or batch mode with '--serve'", "", 0 },
+        /*  7*/ { "", 0, " --sheet=2", "Warning 236: Batch options not used with '--serve', **IGNORED**", "", 0 },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+    unsigned char reply_buf[4096];
+    int reply_size;
+
+    const char *input_filename = "test_serve.bin";
+    const char *reply_filename = "test_serve_reply.bin";
+    FILE *fp;
+
+    testStart("test_serve");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --serve");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+        strcat(cmd, data[i].opt);
+
+        fp = testUtilOpen(input_filename, "wb");
+        assert_nonnull(fp, "i:%d testUtilOpen(%s) NULL\n", i, input_filename);
+        assert_equal((int) fwrite(data[i].input, 1, data[i].length, fp), data[i].length,
+                    "i:%d fwrite(%s) != %d\n", i, input_filename, data[i].length);
+        assert_zero(fclose(fp), "i:%d fclose(%s) != 0\n", i, input_filename);
+        sprintf(cmd + strlen(cmd), " < \"%s\" 2>&1 > \"%s\"", input_filename, reply_filename);
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        if (data[i].expected_reply_len) {
+            assert_zero(testUtilReadFile(reply_filename, reply_buf, sizeof(reply_buf), &reply_size),
+                        "i:%d testUtilReadFile(%s) != 0\n", i, reply_filename);
+            assert_equal(reply_size, data[i].expected_reply_len, "i:%d reply_size %d != expected_reply_len %d\n",
+                        i, reply_size, data[i].expected_reply_len);
+            assert_zero(memcmp(reply_buf, data[i].expected_reply, reply_size), "i:%d memcmp reply != 0\n", i);
+        }
+
+        assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                    i, input_filename, errno, strerror(errno));
+        assert_zero(testUtilRemove(reply_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                    i, reply_filename, errno, strerror(errno));
+    }
+
+    testFinish();
+}
+
+static void test_batch_large(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        int mirror;
+        const char *pattern;
+        int length;
+        int noeol;
+
+        const char *expected;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_HANXIN, 0, "1", 7827, 0, "00001.gif" },
+        /*  1*/ { BARCODE_HANXIN, 1, "1", 7827, 0, "11111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111111.gif" },
+        /*  2*/ { BARCODE_HANXIN, 0, "1", 7828, 0, NULL },
+        /*  3*/ { BARCODE_HANXIN, 0, "1", ZINT_MAX_DATA_LEN, 0, NULL },
+        /*  4*/ { BARCODE_HANXIN, 0, "1", ZINT_MAX_DATA_LEN + 1, 1, NULL },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[16384];
+    char data_buf[ZINT_MAX_DATA_LEN + 4];
+    char buf[16384];
+
+    const char *input_filename = "test_batch_large.txt";
+    int have_input;
+
+    testStart("test_batch_large");
+
+#ifdef _WIN32
+    testSkip("Test not compatible with Windows");
+    return;
+#endif
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --batch --filetype=gif");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        arg_bool(cmd, "--mirror", data[i].mirror);
+
+        testUtilStrCpyRepeat(data_buf, data[i].pattern, data[i].length);
+        if (!data[i].noeol) {
+            strcat(data_buf, "\n");
+        }
+        have_input = arg_input(cmd, input_filename, data_buf);
+
+        if (!data[i].expected) {
+            if (data[i].noeol) {
+                printf("++++ Following error and warning expected, ignore: ");
+            } else {
+                printf("++++ Following error expected, ignore: ");
+            }
+            fflush(stdout);
+        }
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        if (data[i].expected) {
+            assert_zero(testUtilRemove(data[i].expected), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected, errno, strerror(errno));
+        } else {
+            assert_zero(testUtilExists("out.gif"), "i:%d testUtilExists(out.gif) != 0 (%d: %s) (%s)\n",
+                        i, errno, strerror(errno), cmd);
+        }
+
+        if (have_input && (p_ctx->index == -1 || data[i].expected)) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
+        }
+    }
+
+    testFinish();
+}
+
+static void test_batch_sheet(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *input;
+        const char *opt;
+        const char *outfile;
+
+        const char *expected;
+        const char *expected_files[3];
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, "123\n456\n", " --sheet=2", "sheet.gif", "", { "sheet.gif", NULL, NULL } },
+        /*  1*/ { BARCODE_QRCODE, "123\n456\n789\n", " --sheet=2x1,4,2", "sheet.svg", "", { "sheet-1.svg", "sheet-2.svg", NULL } },
+        /*  2*/ { BARCODE_QRCODE, "123\n456\n789\n", " --sheet=1x2", "sheet.tif", "", { "sheet.tif", NULL, NULL } },
+        /*  3*/ { BARCODE_EAN13, "123\nA\n456\n", " --sheet=3", "sheet.pdf", "On line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)", { "sheet.pdf", NULL, NULL } },
+        /*  4*/ { BARCODE_CODE128, "123\n", " --sheet=2 --mirror", "sheet.gif", "Warning 200: '--mirror' not used with '--sheet', **IGNORED**", { "sheet.gif", NULL, NULL } },
+        /*  5*/ { BARCODE_CODE128, "123\n", " --sheet=0", "sheet.gif", "Error 199: Invalid sheet columns (digits only, 1 to 1000)", { NULL, NULL, NULL } },
+        /*  6*/ { BARCODE_CODE128, "123\n", " --sheet=1x0", "sheet.gif", "Error 199: Invalid sheet rows (digits only, 1 to 1000)", { NULL, NULL, NULL } },
+        /*  7*/ { BARCODE_CODE128, "123\n", " --sheet=1,A", "sheet.gif", "Error 199: Invalid sheet margin floating point (integer part must be digits only)", { NULL, NULL, NULL } },
+        /*  8*/ { BARCODE_CODE128, "123\n", " --sheet=1,1,1001", "sheet.gif", "Error 199: Sheet margin and gap must be 1000 or less", { NULL, NULL, NULL } },
+        /*  9*/ { BARCODE_CODE128, "123\n", " --sheet=2", "sheet.emf", "Error 912: Sheet output not available for EMF format", { NULL, NULL, NULL } },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i, j;
+
+    char cmd[4096];
+    char buf[4096];
+
+    const char *input_filename = "test_batch_sheet.txt";
+    int have_input;
+
+    testStart("test_batch_sheet");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --batch");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        arg_data(cmd, "-o ", data[i].outfile);
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        for (j = 0; j < ARRAY_SIZE(data[i].expected_files) && data[i].expected_files[j]; j++) {
+            assert_zero(testUtilRemove(data[i].expected_files[j]), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, data[i].expected_files[j], errno, strerror(errno));
+        }
+        if (j == 0) {
+            assert_zero(testUtilExists(data[i].outfile), "i:%d testUtilExists(%s) != 0\n", i, data[i].outfile);
+        }
+
+        if (have_input) {
+            assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
+                        i, input_filename, errno, strerror(errno));
+        }
+    }
+
+    testFinish();
+}
+
+static void test_batch_jobs(const testCtx *const p_ctx) {
+    int debug = p_ctx->debug;
+
+    struct item {
+        int b;
+        const char *input;
+        const char *opt;
+
+        const char *expected;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, "123\n456\n", " --jobs=2", "D3 96 72 F7 65 C9 61 8E B\nD3 97 62 F7 67 49 19 8E B" },
+        /*  1*/ { BARCODE_CODE128, "123\r\n456\n", " -j 3", "D3 96 72 F7 65 C9 61 8E B\nD3 97 62 F7 67 49 19 8E B" },
+        /*  2*/ { BARCODE_CODE128, "123\n456", " --jobs=2", "D3 96 72 F7 65 C9 61 8E B\nWarning 104: No newline at end of input file, last line **IGNORED**" },
+        /*  3*/ { BARCODE_EAN13, "123\nA\n456\n", " --jobs=1", "A3 46 8D 1A 34 6A B9 72 CD B2 15 0A\nOn line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)\nA3 46 8D 1A 34 6A B9 72 B9 3A 84 EA" },
+        /*  4*/ { BARCODE_EAN13, "123\nA\n456\n", " --jobs=2", "A3 46 8D 1A 34 6A B9 72 CD B2 15 0A\nOn line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)\nA3 46 8D 1A 34 6A B9 72 B9 3A 84 EA" },
+        /*  5*/ { BARCODE_EAN13, "123\nA\n456\n", " --jobs=0", "A3 46 8D 1A 34 6A B9 72 CD B2 15 0A\nOn line 2: Error 284: Invalid character at position 1 in input (digits and \"+\" or space only)\nA3 46 8D 1A 34 6A B9 72 B9 3A 84 EA" },
+        /*  6*/ { BARCODE_CODE128, "1\n\n2\n", " --jobs=3", "D2 13 9B 39 63 AC\nOn line 2: Error 778: No input data\nD2 19 CB 2E 63 AC" },
+        /*  7*/ { BARCODE_MICROQR, "1\nAB\n", " --jobs=1", "FE A\n82 8\nBA 6\nBA 8\nBA 6\n82 0\nFE 6\n00 A\nC4 6\n5F A\nFF 6\nFE A8\n82 E0\nBA D8\nBA 60\nBA 78\n82 A8\nFE 30\n00 10\nE7 B0\n1C 98\nBA F8\n31 28\nBD D0" }, /* Feedback from line 1 not used for line 2 */
+        /*  8*/ { BARCODE_MICROQR, "1\nAB\n", " --jobs=2", "FE A\n82 8\nBA 6\nBA 8\nBA 6\n82 0\nFE 6\n00 A\nC4 6\n5F A\nFF 6\nFE A8\n82 E0\nBA D8\nBA 60\nBA 78\n82 A8\nFE 30\n00 10\nE7 B0\n1C 98\nBA F8\n31 28\nBD D0" },
+        /*  9*/ { BARCODE_CODE128, "123\n", " --jobs=A", "Error 202: Invalid jobs value (digits only)" },
+        /* 10*/ { BARCODE_CODE128, "123\n", " --jobs=257", "Warning 203: Jobs value '257' out of range (0 to 256), **IGNORED**\nD3 96 72 F7 65 C9 61 8E B" },
+        /* 11*/ { BARCODE_CODE128, "123\n", " --jobs=2 --sheet=2", "Warning 205: '--jobs' not used with '--sheet', **IGNORED**\nError 912: Sheet output not available for TXT format" },
+        /* 12*/ { BARCODE_CODE128, NULL, " --jobs=2 -d 123", "Warning 204: '--jobs' given but not batch mode, **IGNORED**\nD3 96 72 F7 65 C9 61 8E B" },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    char cmd[4096];
+    char buf[4096];
+
+    const char *input_filename = "test_batch_jobs.txt";
+    int have_input;
+
+    testStart("test_batch_jobs");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (testContinue(p_ctx, i)) continue;
+
+        strcpy(cmd, "zint --dump");
+        if (debug & ZINT_DEBUG_PRINT) {
+            strcat(cmd, " --verbose");
+        }
+
+        arg_int(cmd, "-b ", data[i].b);
+        if (data[i].input) {
+            strcat(cmd, " --batch");
+        }
+        have_input = arg_input(cmd, input_filename, data[i].input);
+        strcat(cmd, data[i].opt);
+
+        strcat(cmd, " 2>&1");
+
+        assert_nonnull(exec(cmd, buf, sizeof(buf) - 1, debug, i, NULL), "i:%d exec(%s) NULL\n", i, cmd);
+        assert_zero(strcmp(buf, data[i].expected), "i:%d buf (%s) != expected (%s)\n", i, buf, data[i].expected);
+
+        if (have_input) {
             assert_zero(testUtilRemove(input_filename), "i:%d testUtilRemove(%s) != 0 (%d: %s)\n",
                         i, input_filename, errno, strerror(errno));
         }
@@ -1204,6 +2126,16 @@ static void test_other_opts(const testCtx *const p_ctx) {
         /* 65*/ { BARCODE_EANX, "501234567890", -1, " --scalexdimdp=", "12,123.45678", "Error 189: scalexdimdp resolution invalid floating point: 7 significant digits maximum", 0 },
         /* 66*/ { BARCODE_EANX, "501234567890", -1, " --scalexdimdp=", "10.1,1000", "Warning 185: scalexdimdp X-dim '10.1' out of range (greater than 10), **IGNORED**", 0 },
         /* 67*/ { BARCODE_EANX, "501234567890", -1, " --scalexdimdp=", "10,1000.1", "Warning 186: scalexdimdp resolution '1000.1' out of range (greater than 1000), **IGNORED**", 0 },
+        /* 68*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit", NULL, "", 0 },
+        /* 69*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", "2", "", 0 },
+        /* 70*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", ",20,10mm", "", 0 },
+        /* 71*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", "1.5,1in,0.5in", "", 0 },
+        /* 72*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", "1,20", "Error 257: dmfit height missing", 0 },
+        /* 73*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", "1,20,10,5", "Error 257: dmfit too many values (maximum 3)", 0 },
+        /* 74*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", "1,,10", "Error 257: dmfit width too short", 0 },
+        /* 75*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", "1,20cm,10", "Error 257: dmfit width unknown units: cm", 0 },
+        /* 76*/ { BARCODE_DATAMATRIX, "1", -1, " --dmfit=", "A", "Error 257: dmfit aspect invalid floating point: integer part must be digits only", 0 },
+        /* 77*/ { BARCODE_DATAMATRIX, "1", -1, " --square --dmfit", NULL, "Warning 258: Previous '--square' or '--dmre' overwritten by '--dmfit'", 0 },
     };
     int data_size = ARRAY_SIZE(data);
     int i;
@@ -1609,7 +2541,18 @@ int main(int argc, char *argv[]) {
         { "test_input", test_input },
         { "test_stdin_input", test_stdin_input },
         { "test_batch_input", test_batch_input },
+        { "test_batch0_input", test_batch0_input },
         { "test_batch_large", test_batch_large },
+        { "test_batch_sheet", test_batch_sheet },
+        { "test_batch_jobs", test_batch_jobs },
+        { "test_batch_archive", test_batch_archive },
+        { "test_batch_format", test_batch_format },
+        { "test_batch_writer", test_batch_writer },
+        { "test_batch_sequence", test_batch_sequence },
+        { "test_batch_dedupe", test_batch_dedupe },
+        { "test_stats", test_stats },
+        { "test_trace", test_trace },
+        { "test_serve", test_serve },
         { "test_checks", test_checks },
         { "test_barcode_symbology", test_barcode_symbology },
         { "test_other_opts", test_other_opts },
@@ -699,19 +699,22 @@ bool MainWindow::save()
     save_dialog.setDirectory(settings.value(QSL("studio/default_dir"),
                 QDir::toNativeSeparators(QDir::homePath())).toString());
 
-    suffixes << QSL("eps") << QSL("gif") << QSL("svg") << QSL("bmp") << QSL("pcx") << QSL("emf") << QSL("tif");
+    suffixes << QSL("eps") << QSL("gif") << QSL("svg") << QSL("bmp") << QSL("pcx") << QSL("emf") << QSL("tif")
+             << QSL("pdf") << QSL("zpl") << QSL("pos") << QSL("pbm");
     if (m_bc.bc.noPng()) {
         suffix = settings.value(QSL("studio/default_suffix"), QSL("gif")).toString();
         save_dialog.setNameFilter(tr(
             "Encapsulated PostScript (*.eps);;Graphics Interchange Format (*.gif)"
             ";;Scalable Vector Graphic (*.svg);;Windows Bitmap (*.bmp);;ZSoft PC Painter Image (*.pcx)"
-            ";;Enhanced Metafile (*.emf);;Tagged Image File Format (*.tif)"));
+            ";;Enhanced Metafile (*.emf);;Tagged Image File Format (*.tif);;Portable Document Format (*.pdf)"
+            ";;Zebra Programming Language (*.zpl);;ESC/POS Raster Commands (*.pos);;Portable Bitmap (*.pbm)"));
     } else {
         suffix = settings.value(QSL("studio/default_suffix"), QSL("png")).toString();
         save_dialog.setNameFilter(tr(
             "Portable Network Graphic (*.png);;Encapsulated PostScript (*.eps);;Graphics Interchange Format (*.gif)"
             ";;Scalable Vector Graphic (*.svg);;Windows Bitmap (*.bmp);;ZSoft PC Painter Image (*.pcx)"
-            ";;Enhanced Metafile (*.emf);;Tagged Image File Format (*.tif)"));
+            ";;Enhanced Metafile (*.emf);;Tagged Image File Format (*.tif);;Portable Document Format (*.pdf)"
+            ";;Zebra Programming Language (*.zpl);;ESC/POS Raster Commands (*.pos);;Portable Bitmap (*.pbm)"));
         suffixes << QSL("png");
     }
 
@@ -731,6 +734,14 @@ bool MainWindow::save()
         save_dialog.selectNameFilter(tr("Enhanced Metafile (*.emf)"));
     else if (QString::compare(suffix, QSL("tif"), Qt::CaseInsensitive) == 0)
         save_dialog.selectNameFilter(tr("Tagged Image File Format (*.tif)"));
+    else if (QString::compare(suffix, QSL("pdf"), Qt::CaseInsensitive) == 0)
+        save_dialog.selectNameFilter(tr("Portable Document Format (*.pdf)"));
+    else if (QString::compare(suffix, QSL("zpl"), Qt::CaseInsensitive) == 0)
+        save_dialog.selectNameFilter(tr("Zebra Programming Language (*.zpl)"));
+    else if (QString::compare(suffix, QSL("pos"), Qt::CaseInsensitive) == 0)
+        save_dialog.selectNameFilter(tr("ESC/POS Raster Commands (*.pos)"));
+    else if (QString::compare(suffix, QSL("pbm"), Qt::CaseInsensitive) == 0)
+        save_dialog.selectNameFilter(tr("Portable Bitmap (*.pbm)"));
 
     if (save_dialog.exec()) {
         pathname = save_dialog.selectedFiles().at(0);
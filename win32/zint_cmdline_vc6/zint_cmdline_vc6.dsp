@@ -184,6 +184,10 @@ SOURCE=..\..\backend\emf.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\backend\escpos.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\backend\filemem.c
 # End Source File
 # Begin Source File
@@ -248,10 +252,18 @@ SOURCE=..\..\backend\output.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\backend\pbm.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\backend\pcx.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\backend\pdf.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\backend\pdf417.c
 # End Source File
 # Begin Source File
@@ -310,6 +322,10 @@ SOURCE=..\..\backend\upcean.c
 
 SOURCE=..\..\backend\vector.c
 # End Source File
+# Begin Source File
+
+SOURCE=..\..\backend\zpl.c
+# End Source File
 # End Group
 # Begin Group "Header Files"
 
@@ -197,6 +197,10 @@ SOURCE=..\..\backend\emf.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\backend\escpos.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\backend\filemem.c
 # End Source File
 # Begin Source File
@@ -253,10 +257,18 @@ SOURCE=..\..\backend\output.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\backend\pbm.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\backend\pcx.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\..\backend\pdf.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\..\backend\pdf417.c
 # End Source File
 # Begin Source File
@@ -315,6 +327,10 @@ SOURCE=..\..\backend\upcean.c
 
 SOURCE=..\..\backend\vector.c
 # End Source File
+# Begin Source File
+
+SOURCE=..\..\backend\zpl.c
+# End Source File
 # End Group
 # Begin Group "Header Files"
 